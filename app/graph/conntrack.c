@@ -0,0 +1,245 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <netinet/in.h>
+
+#include <cmdline_parse.h>
+#include <cmdline_parse_num.h>
+#include <cmdline_parse_string.h>
+#include <cmdline_socket.h>
+#include <rte_bitops.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_node_conntrack4_api.h>
+#include <rte_rcu_qsbr.h>
+
+#include "module_api.h"
+
+static const char
+cmd_conntrack_enable_help[] = "conntrack enable max_flows <nb_flows>";
+
+static const char
+cmd_conntrack_timeout_help[] = "conntrack timeout <tcp_syn|tcp_established|tcp_closing|"
+			       "tcp_closed|udp|udp_stream|icmp> <seconds>";
+
+static const char
+cmd_conntrack_show_help[] = "conntrack show";
+
+static const char
+cmd_nat_snat_help[] = "nat add snat <ip> netmask <mask> to <nat_ip>";
+
+static const char
+cmd_nat_dnat_help[] = "nat add dnat <ip> <tcp|udp> <port> to <nat_ip> <nat_port>";
+
+static const char * const conntrack_timeout_names[] = {
+	[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN] = "tcp_syn",
+	[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_ESTABLISHED] = "tcp_established",
+	[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSING] = "tcp_closing",
+	[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSED] = "tcp_closed",
+	[RTE_NODE_CONNTRACK4_TIMEOUT_UDP] = "udp",
+	[RTE_NODE_CONNTRACK4_TIMEOUT_UDP_STREAM] = "udp_stream",
+	[RTE_NODE_CONNTRACK4_TIMEOUT_ICMP] = "icmp",
+};
+
+static uint32_t conntrack_max_flows;
+static struct rte_rcu_qsbr *conntrack_rcu;
+
+bool
+conntrack_enabled(void)
+{
+	return conntrack_max_flows != 0;
+}
+
+struct rte_rcu_qsbr *
+conntrack_rcu_get(void)
+{
+	return conntrack_rcu;
+}
+
+int
+conntrack_configure(int socket_id)
+{
+	struct rte_node_conntrack4_config cfg;
+	size_t sz;
+	int rc;
+
+	/* Expired connections are reused once all the workers went quiescent */
+	sz = rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE);
+	conntrack_rcu = rte_zmalloc_socket("conntrack_rcu", sz, RTE_CACHE_LINE_SIZE, socket_id);
+	if (conntrack_rcu == NULL)
+		return -ENOMEM;
+
+	rc = rte_rcu_qsbr_init(conntrack_rcu, RTE_MAX_LCORE);
+	if (rc)
+		goto free;
+
+	cfg.max_flows = conntrack_max_flows;
+	cfg.socket_id = socket_id;
+	cfg.v = conntrack_rcu;
+	rc = rte_node_conntrack4_configure(&cfg);
+	if (rc)
+		goto free;
+
+	return 0;
+free:
+	rte_free(conntrack_rcu);
+	conntrack_rcu = NULL;
+	return rc;
+}
+
+void
+conntrack_expire(void)
+{
+	static uint64_t next_expire;
+	uint64_t now;
+
+	if (conntrack_rcu == NULL)
+		return;
+
+	/* Expire the connections of the idle graphs once per second */
+	now = rte_get_timer_cycles();
+	if (now < next_expire)
+		return;
+	next_expire = now + rte_get_timer_hz();
+
+	rte_node_conntrack4_expire();
+}
+
+static void
+conntrack_show(void)
+{
+	struct rte_node_conntrack4_stats stats;
+	uint32_t i;
+	size_t len;
+
+	if (rte_node_conntrack4_stats_get(&stats))
+		return;
+
+	len = strlen(conn->msg_out);
+	conn->msg_out += len;
+	snprintf(conn->msg_out, conn->msg_out_len_max,
+		 "\n%s\n"
+		 "\tmax_flows: %u\n"
+		 "\tactive: %" PRIu64 "\n"
+		 "\tcreated: %" PRIu64 "\n"
+		 "\texpired: %" PRIu64 "\n"
+		 "\tinsert_failed: %" PRIu64 "\n"
+		 "\ttimeouts:\n",
+		 "----------------------------- conntrack -----------------------------",
+		 conntrack_max_flows, stats.active, stats.created, stats.expired,
+		 stats.insert_failed);
+	for (i = 0; i < RTE_DIM(conntrack_timeout_names); i++)
+		snprintf(conn->msg_out + strlen(conn->msg_out), conn->msg_out_len_max,
+			 "\t\t%s: %u s\n", conntrack_timeout_names[i],
+			 rte_node_conntrack4_timeout_get(i));
+
+	len = strlen(conn->msg_out);
+	conn->msg_out_len_max -= len;
+}
+
+void
+cmd_conntrack_enable_max_flows_parsed(void *parsed_result, __rte_unused struct cmdline *cl,
+				      void *data __rte_unused)
+{
+	struct cmd_conntrack_enable_max_flows_result *res = parsed_result;
+
+	if (res->nb_flows == 0) {
+		printf(MSG_ARG_INVALID, "nb_flows");
+		return;
+	}
+
+	conntrack_max_flows = res->nb_flows;
+}
+
+void
+cmd_conntrack_timeout_parsed(void *parsed_result, __rte_unused struct cmdline *cl,
+			     void *data __rte_unused)
+{
+	struct cmd_conntrack_timeout_result *res = parsed_result;
+	uint32_t i;
+
+	for (i = 0; i < RTE_DIM(conntrack_timeout_names); i++) {
+		if (!strcmp(res->name, conntrack_timeout_names[i]))
+			break;
+	}
+
+	if (i == RTE_DIM(conntrack_timeout_names)) {
+		printf(MSG_ARG_INVALID, "name");
+		return;
+	}
+
+	if (rte_node_conntrack4_timeout_set(i, res->seconds))
+		printf(MSG_CMD_FAIL, res->conntrack);
+}
+
+void
+cmd_conntrack_show_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdline *cl,
+			  __rte_unused void *data)
+{
+	conntrack_show();
+}
+
+void
+cmd_nat_add_snat_parsed(void *parsed_result, __rte_unused struct cmdline *cl,
+			void *data __rte_unused)
+{
+	struct cmd_nat_add_snat_result *res = parsed_result;
+	struct rte_node_nat4_rule rule;
+	uint32_t mask;
+
+	mask = rte_be_to_cpu_32(res->mask.addr.ipv4.s_addr);
+
+	memset(&rule, 0, sizeof(rule));
+	rule.type = RTE_NODE_NAT4_SNAT;
+	rule.depth = rte_popcount32(mask);
+	rule.ip = rte_be_to_cpu_32(res->ip.addr.ipv4.s_addr) & mask;
+	rule.nat_ip = rte_be_to_cpu_32(res->nat_ip.addr.ipv4.s_addr);
+
+	if (rte_node_nat4_rule_add(&rule))
+		printf(MSG_CMD_FAIL, res->nat);
+}
+
+void
+cmd_nat_add_dnat_parsed(void *parsed_result, __rte_unused struct cmdline *cl,
+			void *data __rte_unused)
+{
+	struct cmd_nat_add_dnat_result *res = parsed_result;
+	struct rte_node_nat4_rule rule;
+
+	memset(&rule, 0, sizeof(rule));
+	rule.type = RTE_NODE_NAT4_DNAT;
+	rule.ip = rte_be_to_cpu_32(res->ip.addr.ipv4.s_addr);
+	rule.depth = 32;
+	rule.proto = strcmp(res->proto, "tcp") ? IPPROTO_UDP : IPPROTO_TCP;
+	rule.port = res->port;
+	rule.nat_ip = rte_be_to_cpu_32(res->nat_ip.addr.ipv4.s_addr);
+	rule.nat_port = res->nat_port;
+
+	if (rte_node_nat4_rule_add(&rule))
+		printf(MSG_CMD_FAIL, res->nat);
+}
+
+void
+cmd_help_conntrack_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdline *cl,
+			  __rte_unused void *data)
+{
+	size_t len;
+
+	len = strlen(conn->msg_out);
+	conn->msg_out += len;
+	snprintf(conn->msg_out, conn->msg_out_len_max, "\n%s\n%s\n%s\n%s\n%s\n%s\n",
+		 "--------------------------- conntrack command help ---------------------------",
+		 cmd_conntrack_enable_help, cmd_conntrack_timeout_help,
+		 cmd_conntrack_show_help, cmd_nat_snat_help, cmd_nat_dnat_help);
+
+	len = strlen(conn->msg_out);
+	conn->msg_out_len_max -= len;
+}
@@ -0,0 +1,15 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef APP_GRAPH_CONNTRACK_H
+#define APP_GRAPH_CONNTRACK_H
+
+#include <rte_rcu_qsbr.h>
+
+bool conntrack_enabled(void);
+int conntrack_configure(int socket_id);
+void conntrack_expire(void);
+struct rte_rcu_qsbr *conntrack_rcu_get(void);
+
+#endif
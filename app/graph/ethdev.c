@@ -13,6 +13,7 @@
 #include <rte_bitops.h>
 #include <rte_ethdev.h>
 #include <rte_mempool.h>
+#include <rte_node_ip6_api.h>
 
 #include "ethdev_priv.h"
 #include "module_api.h"
@@ -139,6 +140,53 @@ ethdev_portid_by_ip6(struct rte_ipv6_addr *ip, struct rte_ipv6_addr *mask)
 	return -EINVAL;
 }
 
+static int
+ethdev_ip6_local_route_add(const struct rte_ipv6_addr *ip, uint16_t portid)
+{
+	if (ip6_lookup_m == IP6_LOOKUP_FIB)
+		return rte_node_ip6_fib_route_add(ip, RTE_IPV6_MAX_DEPTH, portid,
+				RTE_NODE_IP6_LOOKUP_NEXT_IP6_LOCAL);
+
+	return rte_node_ip6_route_add(ip, RTE_IPV6_MAX_DEPTH, portid,
+			RTE_NODE_IP6_LOOKUP_NEXT_IP6_LOCAL);
+}
+
+int
+ethdev_ip6_local_add_to_lookup(void)
+{
+	struct rte_ipv6_addr solnode;
+	struct ethdev *port;
+	uint16_t portid;
+	int rc;
+
+	TAILQ_FOREACH(port, &eth_node, next) {
+		portid = port->config.port_id;
+		if ((enabled_port_mask & (1 << portid)) == 0 ||
+		    rte_ipv6_addr_is_unspec(&port->ip6_addr.ip))
+			continue;
+
+		/* Answer the neighbor solicitations for the port address */
+		rc = rte_node_ip6_ndp_addr_add(portid, &port->ip6_addr.ip);
+		if (rc < 0)
+			return rc;
+
+		rc = rte_node_ip6_ndp_router_set(portid, true);
+		if (rc < 0)
+			return rc;
+
+		rc = ethdev_ip6_local_route_add(&port->ip6_addr.ip, portid);
+		if (rc < 0)
+			return rc;
+
+		rte_ipv6_solnode_from_addr(&solnode, &port->ip6_addr.ip);
+		rc = ethdev_ip6_local_route_add(&solnode, portid);
+		if (rc < 0)
+			return rc;
+	}
+
+	return 0;
+}
+
 void
 ethdev_list_clean(void)
 {
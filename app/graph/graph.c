@@ -338,6 +338,7 @@ graph_walk_start(void *conf)
 {
 	struct lcore_conf *qconf;
 	struct rte_graph *graph;
+	struct rte_rcu_qsbr *v;
 	uint32_t lcore_id;
 
 	RTE_SET_USED(conf);
@@ -354,8 +355,22 @@ graph_walk_start(void *conf)
 	RTE_LOG(INFO, APP_GRAPH, "Entering main loop on lcore %u, graph %s(%p)\n", lcore_id,
 		qconf->name, graph);
 
-	while (likely(!force_quit))
+	v = conntrack_rcu_get();
+	if (v == NULL) {
+		while (likely(!force_quit))
+			rte_graph_walk(graph);
+		return 0;
+	}
+
+	/* Report quiescent state after each walk for conntrack entries reuse */
+	rte_rcu_qsbr_thread_register(v, lcore_id);
+	rte_rcu_qsbr_thread_online(v, lcore_id);
+	while (likely(!force_quit)) {
 		rte_graph_walk(graph);
+		rte_rcu_qsbr_quiescent(v, lcore_id);
+	}
+	rte_rcu_qsbr_thread_offline(v, lcore_id);
+	rte_rcu_qsbr_thread_unregister(v, lcore_id);
 
 	return 0;
 }
@@ -385,6 +400,7 @@ graph_stats_print(void)
 		printf("%s%s", clr, topLeft);
 		rte_graph_cluster_stats_get(stats, 0);
 		rte_delay_ms(1E3);
+		conntrack_expire();
 		if (app_graph_exit())
 			force_quit = true;
 	}
@@ -14,6 +14,7 @@
 #include <rte_graph.h>
 #include <rte_graph_worker.h>
 #include <rte_lcore.h>
+#include <rte_node_conntrack4_api.h>
 #include <rte_node_eth_api.h>
 #include <rte_node_ip4_api.h>
 #include <rte_node_ip6_api.h>
@@ -99,6 +100,23 @@ l3fwd_pattern_configure(void)
 		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP_FIB, &lpm_n, 1);
 	}
 
+	if (conntrack_enabled()) {
+		const char *lookup_n = ip4_lookup_m == IP4_LOOKUP_FIB ?
+			"ip4_lookup_fib" : "ip4_lookup";
+		const char *ct_n = "conntrack4";
+		rte_node_t pkt_cls, nat;
+
+		rc = conntrack_configure(rte_socket_id());
+		if (rc < 0)
+			rte_exit(EXIT_FAILURE, "Unable to setup conntrack: err=%d\n", rc);
+
+		/* Track the IPv4 connections before the lookup */
+		pkt_cls = rte_node_from_name("pkt_cls");
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP, &ct_n, 1);
+		nat = rte_node_from_name("nat4");
+		rte_node_edge_update(nat, RTE_NODE_NAT4_NEXT_IP4_LOOKUP, &lookup_n, 1);
+	}
+
 	if (ip6_lookup_m == IP6_LOOKUP_FIB) {
 		const char *fib6_n = "ip6_lookup_fib";
 		const char *lpm6_n = "ip6_lookup";
@@ -171,6 +189,10 @@ l3fwd_pattern_configure(void)
 	if (rc < 0)
 		rte_exit(EXIT_FAILURE, "Unable to add v6 route to lookup table\n");
 
+	rc = ethdev_ip6_local_add_to_lookup();
+	if (rc < 0)
+		rte_exit(EXIT_FAILURE, "Unable to add v6 local address to lookup table\n");
+
 	rc = neigh_ip4_add_to_rewrite();
 	if (rc < 0)
 		rte_exit(EXIT_FAILURE, "Unable to add v4 to rewrite node\n");
@@ -237,6 +237,7 @@ main(int argc, char **argv)
 		conn_req_poll(conn);
 
 		conn_msg_poll(conn);
+		conntrack_expire();
 		if (app_graph_exit())
 			force_quit = true;
 	}
@@ -157,6 +157,13 @@ evt_parse_timer_prod_type_burst(struct evt_options *opt,
 	return 0;
 }
 
+static int
+evt_parse_timdev_wheel(struct evt_options *opt, const char *arg __rte_unused)
+{
+	opt->timdev_use_wheel = 1;
+	return 0;
+}
+
 static int
 evt_parse_dma_prod_type(struct evt_options *opt,
 			   const char *arg __rte_unused)
@@ -507,6 +514,8 @@ usage(char *program)
 		"\t--timer_tick_nsec  : timer tick interval in ns.\n"
 		"\t--max_tmo_nsec     : max timeout interval in ns.\n"
 		"\t--expiry_nsec      : event timer expiry ns.\n"
+		"\t--timdev_wheel     : use the timing wheel in the software\n"
+		"\t                     timer adapter.\n"
 		"\t--dma_adptr_mode   : 1 for OP_FORWARD mode (default).\n"
 		"\t--crypto_adptr_mode : 0 for OP_NEW mode (default) and\n"
 		"\t                      1 for OP_FORWARD mode.\n"
@@ -611,6 +620,7 @@ static struct option lgopts[] = {
 	{ EVT_TIMER_TICK_NSEC,     1, 0, 0 },
 	{ EVT_MAX_TMO_NSEC,        1, 0, 0 },
 	{ EVT_EXPIRY_NSEC,         1, 0, 0 },
+	{ EVT_TIMDEV_WHEEL,        0, 0, 0 },
 	{ EVT_MBUF_SZ,             1, 0, 0 },
 	{ EVT_MAX_PKT_SZ,          1, 0, 0 },
 	{ EVT_PROD_ENQ_BURST_SZ,   1, 0, 0 },
@@ -663,6 +673,7 @@ evt_opts_parse_long(int opt_idx, struct evt_options *opt)
 		{ EVT_TIMER_TICK_NSEC, evt_parse_timer_tick_nsec},
 		{ EVT_MAX_TMO_NSEC, evt_parse_max_tmo_nsec},
 		{ EVT_EXPIRY_NSEC, evt_parse_expiry_nsec},
+		{ EVT_TIMDEV_WHEEL, evt_parse_timdev_wheel},
 		{ EVT_MBUF_SZ, evt_parse_mbuf_sz},
 		{ EVT_MAX_PKT_SZ, evt_parse_max_pkt_sz},
 		{ EVT_PROD_ENQ_BURST_SZ, evt_parse_prod_enq_burst_sz},
@@ -50,6 +50,7 @@
 #define EVT_TIMER_TICK_NSEC      ("timer_tick_nsec")
 #define EVT_MAX_TMO_NSEC         ("max_tmo_nsec")
 #define EVT_EXPIRY_NSEC          ("expiry_nsec")
+#define EVT_TIMDEV_WHEEL         ("timdev_wheel")
 #define EVT_MBUF_SZ              ("mbuf_sz")
 #define EVT_MAX_PKT_SZ           ("max_pkt_sz")
 #define EVT_PROD_ENQ_BURST_SZ    ("prod_enq_burst_sz")
@@ -296,6 +297,7 @@ evt_dump_producer_type(struct evt_options *opt)
 			snprintf(name, EVT_PROD_MAX_NAME_LEN,
 				"Event timer adapter producer");
 		evt_dump("nb_timer_adapters", "%d", opt->nb_timer_adptrs);
+		evt_dump("timer_wheel", "%s", EVT_BOOL_FMT(opt->timdev_use_wheel));
 		evt_dump("max_tmo_nsec", "%"PRIu64"", opt->max_tmo_nsec);
 		evt_dump("expiry_nsec", "%"PRIu64"", opt->expiry_nsec);
 		if (opt->optm_timer_tick_nsec)
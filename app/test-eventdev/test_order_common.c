@@ -61,6 +61,18 @@ order_producer(void *arg)
 
 		count++;
 	}
+
+	/* An event device which isn't maintenance free may hold back
+	 * events in the producer port, e.g. for reordering.
+	 */
+	if (!evt_is_maintenance_free(dev_id)) {
+		while (t->err == false && t->result != EVT_TEST_SUCCESS) {
+			rte_event_maintain(dev_id, port,
+					   RTE_EVENT_DEV_MAINT_OP_FLUSH);
+			rte_pause();
+		}
+	}
+
 	return 0;
 }
 
@@ -298,10 +298,13 @@ perf_event_timer_producer(void *arg)
 	}
 	fflush(stdout);
 	rte_delay_ms(1000);
-	printf("%s(): lcore %d Average event timer arm latency = %.3f us\n",
+	printf("%s(): lcore %d Average event timer arm latency = %.3f us, "
+			"arm rate = %.3f Mtimers/s\n",
 			__func__, rte_lcore_id(),
 			count ? (float)(arm_latency / count) /
-			(rte_get_timer_hz() / 1000000) : 0);
+			(rte_get_timer_hz() / 1000000) : 0,
+			arm_latency ? (float)count * rte_get_timer_hz() /
+			arm_latency / 1E6 : 0);
 	return 0;
 }
 
@@ -362,10 +365,13 @@ perf_event_timer_producer_burst(void *arg)
 	}
 	fflush(stdout);
 	rte_delay_ms(1000);
-	printf("%s(): lcore %d Average event timer arm latency = %.3f us\n",
+	printf("%s(): lcore %d Average event timer arm latency = %.3f us, "
+			"arm rate = %.3f Mtimers/s\n",
 			__func__, rte_lcore_id(),
 			count ? (float)(arm_latency / count) /
-			(rte_get_timer_hz() / 1000000) : 0);
+			(rte_get_timer_hz() / 1000000) : 0,
+			arm_latency ? (float)count * rte_get_timer_hz() /
+			arm_latency / 1E6 : 0);
 	return 0;
 }
 
@@ -1001,6 +1007,35 @@ total_latency(struct test_perf *t)
 	return total;
 }
 
+static inline uint64_t
+max_latency(struct test_perf *t)
+{
+	uint8_t i;
+	uint64_t max = 0;
+
+	for (i = 0; i < t->nb_workers; i++)
+		max = RTE_MAX(max, t->worker[i].latency_max);
+
+	return max;
+}
+
+/* Delay between arming an event timer and its expiry */
+static float
+timer_expiry_us(struct evt_options *opt)
+{
+	uint64_t timeout_ticks = opt->expiry_nsec / opt->timer_tick_nsec;
+	uint64_t tick_nsec = opt->timer_tick_nsec;
+
+	if (opt->optm_timer_tick_nsec) {
+		timeout_ticks = ceil((double)(timeout_ticks * opt->timer_tick_nsec) /
+				     opt->optm_timer_tick_nsec);
+		tick_nsec = opt->optm_timer_tick_nsec;
+	}
+	timeout_ticks += timeout_ticks ? 0 : 1;
+
+	return (float)(timeout_ticks * tick_nsec) / 1E3;
+}
+
 static void
 check_work_status(struct test_perf *t, struct evt_options *opt)
 {
@@ -1044,6 +1079,16 @@ check_work_status(struct test_perf *t, struct evt_options *opt)
 					       mpps, total_mpps / samples,
 					       (float)(latency / pkts) / freq_mhz,
 					       fallback_pkts / 1E6);
+				} else if (opt->prod_type == EVT_PROD_TYPE_EVENT_TIMER_ADPTR) {
+					printf(CLGRN
+					       "\r%.3f mpps avg %.3f mpps [avg fwd latency %.3f us] "
+					       "[expiry jitter avg %.3f us max %.3f us] " CLNRM,
+					       mpps, total_mpps / samples,
+					       (float)(latency / pkts) / freq_mhz,
+					       (float)(latency / pkts) / freq_mhz -
+					       timer_expiry_us(opt),
+					       (float)max_latency(t) / freq_mhz -
+					       timer_expiry_us(opt));
 				} else {
 					printf(CLGRN
 					       "\r%.3f mpps avg %.3f mpps [avg fwd latency %.3f us] "
@@ -1193,6 +1238,8 @@ perf_event_timer_adapter_setup(struct test_perf *t)
 
 	if (nb_producers == 1)
 		flags |= RTE_EVENT_TIMER_ADAPTER_F_SP_PUT;
+	if (t->opt->timdev_use_wheel)
+		flags |= RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL;
 
 	for (i = 0; i < t->opt->nb_timer_adptrs; i++) {
 		struct rte_event_timer_adapter_conf config = {
@@ -36,6 +36,7 @@ struct __rte_cache_aligned worker_data {
 	uint64_t processed_pkts;
 	uint64_t processed_vecs;
 	uint64_t latency;
+	uint64_t latency_max;
 	uint8_t dev_id;
 	uint8_t port_id;
 	struct test_perf *t;
@@ -316,6 +317,8 @@ perf_process_last_stage_latency(struct rte_mempool *const pool, enum evt_prod_ty
 
 	latency = rte_get_timer_cycles() - tstamp;
 	w->latency += latency;
+	if (latency > w->latency_max)
+		w->latency_max = latency;
 
 	bufs[count++] = to_free_in_bulk;
 	if (unlikely(count == buf_sz)) {
@@ -46,7 +46,9 @@
 #define FIB_RIB_TYPE		(1 << 3)
 #define FIB_V4_DIR_TYPE		(1 << 4)
 #define FIB_V6_TRIE_TYPE	(1 << 4)
-#define FIB_TYPE_MASK		(FIB_RIB_TYPE|FIB_V4_DIR_TYPE|FIB_V6_TRIE_TYPE)
+#define FIB_V6_POPTRIE_TYPE	(1 << 5)
+#define FIB_TYPE_MASK		(FIB_RIB_TYPE|FIB_V4_DIR_TYPE|FIB_V6_TRIE_TYPE|\
+				FIB_V6_POPTRIE_TYPE)
 #define SHUFFLE_FLAG		(1 << 7)
 #define DRY_RUN_FLAG		(1 << 8)
 
@@ -142,6 +144,8 @@ get_fib_type(void)
 	if (config.flags & IPV6_FLAG) {
 		if ((config.flags & FIB_TYPE_MASK) == FIB_V6_TRIE_TYPE)
 			return RTE_FIB6_TRIE;
+		else if ((config.flags & FIB_TYPE_MASK) == FIB_V6_POPTRIE_TYPE)
+			return RTE_FIB6_POPTRIE;
 		else
 			return RTE_FIB6_DUMMY;
 	} else {
@@ -620,16 +624,18 @@ print_usage(void)
 		"\tavailable options for ipv6:\n"
 		"\t\trib - RIB based FIB\n"
 		"\t\ttrie - TRIE based FIB\n"
+		"\t\tpoptrie - POPTRIE based FIB\n"
 		"defaults are: dir for ipv4 and trie for ipv6\n"
-		"[-e <entry size (valid only for dir and trie fib types): "
+		"[-e <entry size (valid only for dir, trie and poptrie fib types): "
 		"1/2/4/8 (default 4)>]\n"
-		"[-g <number of tbl8's for dir24_8 or trie FIBs>]\n"
+		"[-g <number of tbl8's for dir24_8 or trie FIBs, "
+		"poptrie uses 4 nodes per tbl8>]\n"
 		"[-w <path to the file to dump routing table>]\n"
 		"[-u <path to the file to dump ip's for lookup>]\n"
 		"[-v <type of lookup function:"
 		"\ts1, s2, s3 (3 types of scalar), v (vector) -"
 		" for DIR24_8 based FIB\n"
-		"\ts, v - for TRIE based ipv6 FIB>]\n",
+		"\ts, v - for TRIE and POPTRIE based ipv6 FIB>]\n",
 		config.prgname);
 }
 
@@ -745,6 +751,9 @@ parse_opts(int argc, char **argv)
 			} else if (strcmp(optarg, "trie") == 0) {
 				config.flags &= ~FIB_TYPE_MASK;
 				config.flags |= FIB_V6_TRIE_TYPE;
+			} else if (strcmp(optarg, "poptrie") == 0) {
+				config.flags &= ~FIB_TYPE_MASK;
+				config.flags |= FIB_V6_POPTRIE_TYPE;
 			} else
 				rte_exit(-EINVAL, "Invalid option -b\n");
 			break;
@@ -1052,6 +1061,11 @@ run_v6(void)
 		conf.trie.nh_sz = rte_ctz32(config.ent_sz);
 		conf.trie.num_tbl8 = RTE_MIN(config.tbl8,
 			get_max_nh(conf.trie.nh_sz));
+	} else if (conf.type == RTE_FIB6_POPTRIE) {
+		conf.poptrie.nh_sz = rte_ctz32(config.ent_sz);
+		/* a 256 entries tbl8 spans 4 nodes of 64 slots */
+		conf.poptrie.num_nodes = RTE_MIN(config.tbl8, 1U << 28) * 4;
+		conf.poptrie.num_leaves = conf.poptrie.num_nodes * 2;
 	}
 
 	fib = rte_fib6_create("test", -1, &conf);
@@ -1063,9 +1077,13 @@ run_v6(void)
 	if (config.lookup_fn != 0) {
 		if (config.lookup_fn == 1)
 			ret = rte_fib6_select_lookup(fib,
+				(conf.type == RTE_FIB6_POPTRIE) ?
+				RTE_FIB6_LOOKUP_POPTRIE_SCALAR :
 				RTE_FIB6_LOOKUP_TRIE_SCALAR);
 		else if (config.lookup_fn == 2)
 			ret = rte_fib6_select_lookup(fib,
+				(conf.type == RTE_FIB6_POPTRIE) ?
+				RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX512 :
 				RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512);
 		else
 			ret = -EINVAL;
@@ -1093,8 +1111,9 @@ run_v6(void)
 
 	if (config.flags & CMP_FLAG) {
 		lpm_conf.max_rules = config.nb_routes * 2;
-		lpm_conf.number_tbl8s = RTE_MAX(conf.trie.num_tbl8,
-			config.tbl8);
+		/* conf.trie is only valid for TRIE */
+		lpm_conf.number_tbl8s = (conf.type == RTE_FIB6_TRIE) ?
+			RTE_MAX(conf.trie.num_tbl8, config.tbl8) : config.tbl8;
 
 		lpm = rte_lpm6_create("test_lpm", -1, &lpm_conf);
 		if (lpm == NULL) {
@@ -23,6 +23,7 @@ test_acl(void)
 #else
 #include <rte_acl.h>
 #include <rte_common.h>
+#include <rte_malloc.h>
 
 #include "test_acl.h"
 
@@ -1828,6 +1829,367 @@ test_mem_hook(void)
 	return ret;
 }
 
+#define BUILD_PARAM_RULES	1024
+#define BUILD_PARAM_DATA	256
+
+static struct rte_acl_ipv4vlan_rule build_param_rules[BUILD_PARAM_RULES];
+static struct ipv4_7tuple build_param_data[BUILD_PARAM_DATA];
+
+/*
+ * Generate rules with random prefixes and port ranges, so that they
+ * overlap enough to be split into several tries, and the input data
+ * that hits them.
+ */
+static void
+build_param_gen(void)
+{
+	struct rte_acl_ipv4vlan_rule *r;
+	struct ipv4_7tuple *d;
+	uint32_t i, x;
+	uint16_t a, b;
+
+	/* fixed seed, for the same tries on every run */
+	x = 1;
+	for (i = 0; i != RTE_DIM(build_param_rules); i++) {
+		r = build_param_rules + i;
+		memset(r, 0, sizeof(*r));
+
+		x = x * 1103515245 + 12345;
+		r->src_addr = x;
+		r->src_mask_len = (x >> 8) % (BIT_SIZEOF(r->src_addr) + 1);
+		x = x * 1103515245 + 12345;
+		r->dst_addr = x;
+		r->dst_mask_len = (x >> 8) % (BIT_SIZEOF(r->dst_addr) + 1);
+
+		x = x * 1103515245 + 12345;
+		a = x >> 16;
+		b = x;
+		r->src_port_low = RTE_MIN(a, b);
+		r->src_port_high = RTE_MAX(a, b);
+		x = x * 1103515245 + 12345;
+		a = x >> 16;
+		b = x;
+		r->dst_port_low = RTE_MIN(a, b);
+		r->dst_port_high = RTE_MAX(a, b);
+
+		r->data.category_mask = 1;
+		r->data.priority = i + 1;
+		r->data.userdata = i + 1;
+	}
+
+	for (i = 0; i != RTE_DIM(build_param_data); i++) {
+		r = build_param_rules + i * RTE_DIM(build_param_rules) /
+			RTE_DIM(build_param_data);
+		d = build_param_data + i;
+		memset(d, 0, sizeof(*d));
+		d->ip_src = r->src_addr;
+		d->ip_dst = r->dst_addr;
+		d->port_src = r->src_port_low;
+		d->port_dst = r->dst_port_high;
+	}
+}
+
+/*
+ * Test that the build with several threads gives the same run-time
+ * structures as the build in the calling thread only.
+ */
+static int
+test_build_param(void)
+{
+	struct rte_acl_ctx *acx;
+	struct rte_acl_build_param prm;
+	struct rte_acl_build_info info[2];
+	const uint8_t *data[BUILD_PARAM_DATA];
+	uint32_t results[2][BUILD_PARAM_DATA];
+	uint32_t i, n;
+	int ret;
+
+	acx = rte_acl_create(&acl_param);
+	if (acx == NULL) {
+		printf("Line %i: Error creating ACL context!\n", __LINE__);
+		return -1;
+	}
+
+	ret = rte_acl_get_build_info(acx, info);
+	if (ret != -EINVAL) {
+		printf("Line %i: Build info of a context not built!\n",
+			__LINE__);
+		rte_acl_free(acx);
+		return -1;
+	}
+
+	build_param_gen();
+	bswap_test_data(build_param_data, RTE_DIM(build_param_data), 1);
+	for (i = 0; i != RTE_DIM(build_param_data); i++)
+		data[i] = (uint8_t *)&build_param_data[i];
+
+	for (i = 0; i != RTE_DIM(info); i++) {
+
+		prm.num_threads = (i == 0) ? 1 : 4;
+		ret = rte_acl_set_build_param(acx, &prm);
+		if (ret != 0) {
+			printf("Line %i: Error setting build parameters!\n",
+				__LINE__);
+			break;
+		}
+
+		rte_acl_reset(acx);
+		ret = test_classify_buid(acx, build_param_rules,
+			RTE_DIM(build_param_rules));
+		if (ret != 0)
+			break;
+
+		ret = rte_acl_get_build_info(acx, info + i);
+		if (ret != 0 || info[i].num_tries < 2 ||
+				info[i].mem_size == 0) {
+			printf("Line %i: Error getting build info: %d, "
+				"%u tries!\n", __LINE__, ret, info[i].num_tries);
+			ret = -1;
+			break;
+		}
+
+		/* each trie reads at least one byte and has match nodes */
+		for (n = 0; n != info[i].num_tries; n++) {
+			if (info[i].trie[n].max_depth == 0 ||
+					info[i].trie[n].num_match == 0 ||
+					info[i].trie[n].num_dfa == 0) {
+				printf("Line %i: Error in trie %u build info!\n",
+					__LINE__, n);
+				ret = -1;
+			}
+		}
+		if (ret != 0)
+			break;
+
+		ret = rte_acl_classify(acx, data, results[i],
+			RTE_DIM(build_param_data), 1);
+		if (ret != 0) {
+			printf("Line %i: Classify with %u build threads failed!\n",
+				__LINE__, prm.num_threads);
+			break;
+		}
+
+		/* each input hits at least the rule it was generated from */
+		for (n = 0; n != RTE_DIM(build_param_data); n++) {
+			if (results[i][n] == 0) {
+				printf("Line %i: No match for input %u!\n",
+					__LINE__, n);
+				ret = -1;
+			}
+		}
+		if (ret != 0)
+			break;
+	}
+
+	if (ret == 0 && (info[0].mem_size != info[1].mem_size ||
+			info[0].num_tries != info[1].num_tries ||
+			info[0].node_max != info[1].node_max ||
+			memcmp(info[0].trie, info[1].trie,
+				sizeof(info[0].trie)) != 0)) {
+		printf("Line %i: Build info depends on the number of threads!\n",
+			__LINE__);
+		ret = -1;
+	}
+
+	if (ret == 0 && memcmp(results[0], results[1],
+			sizeof(results[0])) != 0) {
+		printf("Line %i: Results depend on the number of threads!\n",
+			__LINE__);
+		ret = -1;
+	}
+
+	rte_acl_free(acx);
+	return ret;
+}
+
+/*
+ * Test incremental updates: build the context with half of the rules,
+ * add the other half, then delete and re-add the first half,
+ * the classify results must match the ones with all rules built.
+ */
+static int
+test_update_rules(void)
+{
+	struct rte_acl_ctx *acx;
+	struct rte_rcu_qsbr *qsv;
+	struct rte_acl_rcu_config rcu_cfg;
+	struct acl_ipv4vlan_rule rules[RTE_DIM(acl_test_rules)];
+	struct acl_ipv4vlan_rule dup[2];
+	uint32_t userdata[RTE_DIM(acl_test_rules)];
+	uint32_t i, num, half, pending;
+	int ret;
+
+	num = RTE_DIM(acl_test_rules);
+	half = num / 2;
+	for (i = 0; i != num; i++) {
+		acl_ipv4vlan_convert_rule(acl_test_rules + i, rules + i);
+		userdata[i] = acl_test_rules[i].data.userdata;
+	}
+
+	qsv = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(1),
+		RTE_CACHE_LINE_SIZE);
+	if (qsv == NULL || rte_rcu_qsbr_init(qsv, 1) != 0) {
+		printf("Line %i: Error creating RCU QSBR variable!\n",
+			__LINE__);
+		rte_free(qsv);
+		return -1;
+	}
+
+	acx = rte_acl_create(&acl_param);
+	if (acx == NULL) {
+		printf("Line %i: Error creating ACL context!\n", __LINE__);
+		rte_free(qsv);
+		return -1;
+	}
+
+	rcu_cfg.v = qsv;
+	ret = rte_acl_rcu_qsbr_add(acx, &rcu_cfg);
+	if (ret != 0) {
+		printf("Line %i: Error attaching RCU QSBR variable!\n",
+			__LINE__);
+		goto err;
+	}
+
+	/* updates are only allowed on a built context */
+	ret = rte_acl_update_add_rules(acx,
+		(const struct rte_acl_rule *)rules, 1);
+	if (ret != -EINVAL) {
+		printf("Line %i: Update of a context not built succeeded!\n",
+			__LINE__);
+		ret = -1;
+		goto err;
+	}
+
+	ret = test_classify_buid(acx, acl_test_rules, half);
+	if (ret != 0)
+		goto err;
+
+	ret = rte_acl_update_add_rules(acx,
+		(const struct rte_acl_rule *)(rules + half), num - half);
+	if (ret != 0 || rte_acl_update_pending(acx) != num - half) {
+		printf("Line %i: Error adding rules incrementally: %d!\n",
+			__LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	ret = test_classify_run(acx, acl_test_data, RTE_DIM(acl_test_data));
+	if (ret != 0) {
+		printf("Line %i: Classify after rules addition failed!\n",
+			__LINE__);
+		goto err;
+	}
+
+	/* the same rule can't be added twice */
+	ret = rte_acl_update_add_rules(acx,
+		(const struct rte_acl_rule *)rules, 1);
+	if (ret != -EEXIST) {
+		printf("Line %i: Adding a duplicate rule succeeded!\n",
+			__LINE__);
+		ret = -1;
+		goto err;
+	}
+
+	/* delete the built rules one by one and add them back */
+	for (i = 0; i != half; i++) {
+		ret = rte_acl_update_del_rules(acx, userdata + i, 1);
+		if (ret != 0) {
+			printf("Line %i: Error deleting rule %u: %d!\n",
+				__LINE__, userdata[i], ret);
+			goto err;
+		}
+	}
+
+	ret = rte_acl_update_del_rules(acx, userdata, 1);
+	if (ret != -ENOENT) {
+		printf("Line %i: Deleting a missing rule succeeded!\n",
+			__LINE__);
+		ret = -1;
+		goto err;
+	}
+
+	ret = rte_acl_update_add_rules(acx,
+		(const struct rte_acl_rule *)rules, half);
+	if (ret != 0) {
+		printf("Line %i: Error adding rules incrementally: %d!\n",
+			__LINE__, ret);
+		goto err;
+	}
+
+	ret = test_classify_run(acx, acl_test_data, RTE_DIM(acl_test_data));
+	if (ret != 0) {
+		printf("Line %i: Classify after rules deletion failed!\n",
+			__LINE__);
+		goto err;
+	}
+
+	ret = rte_acl_update_merge(acx);
+	if (ret != 0 || rte_acl_update_pending(acx) != 0) {
+		printf("Line %i: Error merging updates: %d!\n",
+			__LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	ret = test_classify_run(acx, acl_test_data, RTE_DIM(acl_test_data));
+	if (ret != 0) {
+		printf("Line %i: Classify after merge failed!\n", __LINE__);
+		goto err;
+	}
+
+	/* a batch with a duplicate userdata is rejected as a whole */
+	ret = rte_acl_update_del_rules(acx, userdata, 2);
+	if (ret != 0) {
+		printf("Line %i: Error deleting rules: %d!\n", __LINE__, ret);
+		goto err;
+	}
+
+	pending = rte_acl_update_pending(acx);
+	dup[0] = rules[0];
+	dup[1] = rules[0];
+	ret = rte_acl_update_add_rules(acx,
+		(const struct rte_acl_rule *)dup, RTE_DIM(dup));
+	if (ret != -EEXIST || rte_acl_update_pending(acx) != pending) {
+		printf("Line %i: Adding duplicate rules succeeded!\n",
+			__LINE__);
+		ret = -1;
+		goto err;
+	}
+
+	ret = rte_acl_update_add_rules(acx,
+		(const struct rte_acl_rule *)rules, 2);
+	if (ret != 0) {
+		printf("Line %i: Error adding rules incrementally: %d!\n",
+			__LINE__, ret);
+		goto err;
+	}
+
+	/* delete all the rules and add them back, in one batch each */
+	ret = rte_acl_update_del_rules(acx, userdata, num);
+	if (ret != 0) {
+		printf("Line %i: Error deleting rules: %d!\n", __LINE__, ret);
+		goto err;
+	}
+
+	ret = rte_acl_update_add_rules(acx,
+		(const struct rte_acl_rule *)rules, num);
+	if (ret != 0) {
+		printf("Line %i: Error adding rules incrementally: %d!\n",
+			__LINE__, ret);
+		goto err;
+	}
+
+	ret = test_classify_run(acx, acl_test_data, RTE_DIM(acl_test_data));
+	if (ret != 0)
+		printf("Line %i: Classify after batch updates failed!\n",
+			__LINE__);
+
+err:
+	rte_acl_free(acx);
+	rte_free(qsv);
+	return ret;
+}
+
 static int
 test_acl(void)
 {
@@ -1851,6 +2213,10 @@ test_acl(void)
 		return -1;
 	if (test_mem_hook() < 0)
 		return -1;
+	if (test_build_param() < 0)
+		return -1;
+	if (test_update_rules() < 0)
+		return -1;
 
 	return 0;
 }
@@ -32,6 +32,7 @@ test_event_eth_rx_intr_adapter_common(void)
 #include <rte_bus_vdev.h>
 
 #include <rte_event_eth_rx_adapter.h>
+#include <rte_service.h>
 
 #define MAX_NUM_RX_QUEUE	64
 #define NB_MBUFS		(8192 * num_ports * MAX_NUM_RX_QUEUE)
@@ -1203,6 +1204,179 @@ adapter_queue_conf(void)
 	return TEST_SUCCESS;
 }
 
+static int
+adapter_queue_vector_adaptive(void)
+{
+	int err;
+	struct rte_event_eth_rx_adapter_queue_conf queue_conf = {0};
+	struct rte_event_eth_rx_adapter_vector_stats vec_stats;
+
+	queue_conf.ev.queue_id = 0;
+	queue_conf.ev.sched_type = RTE_SCHED_TYPE_ATOMIC;
+	queue_conf.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL;
+	queue_conf.servicing_weight = 1;
+
+	/* Case 1: adaptive vectorization without event vectorization */
+	queue_conf.rx_queue_flags =
+		RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+						 TEST_ETHDEV_ID,
+						 0, &queue_conf);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	/* Case 2: vector stats of a queue that is not added */
+	err = rte_event_eth_rx_adapter_vector_stats_get(TEST_INST_ID,
+							TEST_ETHDEV_ID,
+							0, &vec_stats);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	/* Case 3: vector stats of a queue without event vectorization */
+	queue_conf.rx_queue_flags = 0;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+						 TEST_ETHDEV_ID,
+						 0, &queue_conf);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_vector_stats_get(TEST_INST_ID,
+							TEST_ETHDEV_ID,
+							0, &vec_stats);
+	if (default_params.caps & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT)
+		TEST_ASSERT(err == -ENOTSUP, "Expected -ENOTSUP got %d", err);
+	else
+		TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	/* Case 4: NULL vector stats struct */
+	err = rte_event_eth_rx_adapter_vector_stats_get(TEST_INST_ID,
+							TEST_ETHDEV_ID,
+							0, NULL);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_del(TEST_INST_ID,
+						 TEST_ETHDEV_ID,
+						 0);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	return TEST_SUCCESS;
+}
+
+/* Vector size and latency target of the adaptive vectorization test */
+#define ADAPT_VECTOR_SZ		64
+#define ADAPT_VECTOR_NS		1000000
+/* Flushed vectors per adaptation step of the SW adapter */
+#define ADAPT_VECTOR_WINDOW	128
+#define ADAPT_SERVICE_ITER	1024
+
+/*
+ * Full vectors are flushed well within the latency target, so the first
+ * adaptation step relaxes the timeout towards the target and grows the
+ * vector size.
+ */
+static int
+adapter_queue_vector_adapt(void)
+{
+	struct rte_event_eth_rx_adapter_queue_conf queue_conf = {0};
+	struct rte_event_eth_rx_adapter_vector_stats vec_stats;
+	struct rte_mempool *vector_mp;
+	uint64_t timeout_ns;
+	uint32_t service_id;
+	uint16_t vector_sz;
+	int err, i;
+
+	if (default_params.caps & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT) {
+		printf("Adaptive vectorization needs the SW adapter, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	vector_mp = rte_event_vector_pool_create("rxa_adapt_vector_mp",
+						 1024, 0, ADAPT_VECTOR_SZ,
+						 rte_socket_id());
+	TEST_ASSERT(vector_mp != NULL, "Failed to create vector pool");
+
+	queue_conf.ev.queue_id = 0;
+	queue_conf.ev.sched_type = RTE_SCHED_TYPE_ATOMIC;
+	queue_conf.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL;
+	queue_conf.servicing_weight = 1;
+	queue_conf.rx_queue_flags =
+		RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR |
+		RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE;
+	queue_conf.vector_sz = ADAPT_VECTOR_SZ;
+	queue_conf.vector_timeout_ns = ADAPT_VECTOR_NS;
+	queue_conf.vector_mp = vector_mp;
+
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID, TEST_ETHDEV_ID,
+						 TEST_ETH_QUEUE_ID,
+						 &queue_conf);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	/* Start from half of the target and a quarter of the vector size */
+	err = rte_event_eth_rx_adapter_vector_stats_get(TEST_INST_ID,
+							TEST_ETHDEV_ID,
+							TEST_ETH_QUEUE_ID,
+							&vec_stats);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(vec_stats.latency_target_ns == ADAPT_VECTOR_NS,
+		    "Expected target %u got %" PRIu64, ADAPT_VECTOR_NS,
+		    vec_stats.latency_target_ns);
+	TEST_ASSERT(vec_stats.vector_sz == ADAPT_VECTOR_SZ / 4,
+		    "Expected vector size %u got %u", ADAPT_VECTOR_SZ / 4,
+		    vec_stats.vector_sz);
+	timeout_ns = vec_stats.timeout_ns;
+	vector_sz = vec_stats.vector_sz;
+
+	err = rte_event_eth_rx_adapter_start(TEST_INST_ID);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_service_id_get(TEST_INST_ID,
+						      &service_id);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_service_set_runstate_mapped_check(service_id, 0);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	for (i = 0; i < ADAPT_SERVICE_ITER; i++) {
+		rte_service_run_iter_on_app_lcore(service_id, 1);
+		err = rte_event_eth_rx_adapter_vector_stats_get(TEST_INST_ID,
+								TEST_ETHDEV_ID,
+								TEST_ETH_QUEUE_ID,
+								&vec_stats);
+		TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+		if (vec_stats.vectors >= ADAPT_VECTOR_WINDOW)
+			break;
+	}
+
+	rte_service_set_runstate_mapped_check(service_id, 1);
+	err = rte_event_eth_rx_adapter_stop(TEST_INST_ID);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_del(TEST_INST_ID, TEST_ETHDEV_ID,
+						 TEST_ETH_QUEUE_ID);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	rte_mempool_free(vector_mp);
+
+	if (vec_stats.vectors < ADAPT_VECTOR_WINDOW) {
+		printf("Only %" PRIu64 " vectors received, skipping test\n",
+		       vec_stats.vectors);
+		return TEST_SKIPPED;
+	}
+
+	TEST_ASSERT(vec_stats.vectors_full >= ADAPT_VECTOR_WINDOW / 4 * 3,
+		    "Expected full vectors, got %" PRIu64 " of %" PRIu64,
+		    vec_stats.vectors_full, vec_stats.vectors);
+	TEST_ASSERT(vec_stats.timeout_ns > timeout_ns &&
+		    vec_stats.timeout_ns <= ADAPT_VECTOR_NS,
+		    "Timeout did not adapt: %" PRIu64 " ns from %" PRIu64 " ns",
+		    vec_stats.timeout_ns, timeout_ns);
+	TEST_ASSERT(vec_stats.vector_sz > vector_sz &&
+		    vec_stats.vector_sz <= ADAPT_VECTOR_SZ,
+		    "Vector size did not adapt: %u from %u",
+		    vec_stats.vector_sz, vector_sz);
+	TEST_ASSERT(vec_stats.latency_max_ns != 0 ||
+		    vec_stats.latency_hist[0] != 0,
+		    "No vector latency recorded");
+
+	return TEST_SUCCESS;
+}
+
 static int
 adapter_pollq_instance_get(void)
 {
@@ -1532,6 +1706,10 @@ static struct unit_test_suite event_eth_rx_tests = {
 		TEST_CASE_ST(adapter_create, adapter_free, adapter_start_stop),
 		TEST_CASE_ST(adapter_create, adapter_free, adapter_stats),
 		TEST_CASE_ST(adapter_create, adapter_free, adapter_queue_conf),
+		TEST_CASE_ST(adapter_create, adapter_free,
+			     adapter_queue_vector_adaptive),
+		TEST_CASE_ST(adapter_create, adapter_free,
+			     adapter_queue_vector_adapt),
 		TEST_CASE_ST(adapter_create_with_params, adapter_free,
 			     adapter_queue_event_buf_test),
 		TEST_CASE_ST(adapter_create_with_params, adapter_free,
@@ -424,6 +424,16 @@ timdev_setup_sec_periodic(void)
 	return _timdev_setup(180 * NSECPERSEC, NSECPERSEC, flags);
 }
 
+static int
+timdev_setup_msec_wheel(void)
+{
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL;
+
+	/* Max timeout is 3 mins, and bucket interval is 100 ms */
+	return _timdev_setup(180 * NSECPERSEC, NSECPERSEC / 10, flags);
+}
+
 static int
 timdev_setup_sec_multicore(void)
 {
@@ -1734,6 +1744,116 @@ event_timer_cancel(void)
 	return TEST_SUCCESS;
 }
 
+/* Cancel a burst of armed timers with a single call. */
+static int
+event_timer_cancel_burst(void)
+{
+	uint16_t n;
+	int ret, i;
+	struct rte_event_timer_adapter *adapter = timdev;
+	struct rte_event_timer *evtims[BATCH_SIZE];
+	struct rte_event evs[BATCH_SIZE];
+	const struct rte_event_timer init_tim = {
+		.ev.op = RTE_EVENT_OP_NEW,
+		.ev.queue_id = TEST_QUEUE_ID,
+		.ev.sched_type = RTE_SCHED_TYPE_ATOMIC,
+		.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.ev.event_type =  RTE_EVENT_TYPE_TIMER,
+		.state = RTE_EVENT_TIMER_NOT_ARMED,
+	};
+	uint64_t ticks = 10;
+
+	TEST_ASSERT_SUCCESS(rte_mempool_get_bulk(eventdev_test_mempool,
+						 (void **)evtims, BATCH_SIZE),
+			    "mempool alloc failed");
+	for (i = 0; i < BATCH_SIZE; i++) {
+		*evtims[i] = init_tim;
+		evtims[i]->ev.event_ptr = evtims[i];
+		evtims[i]->timeout_ticks = CALC_TICKS(ticks); /**< expire in 1 sec */
+	}
+
+	ret = rte_event_timer_arm_burst(adapter, evtims, BATCH_SIZE);
+	TEST_ASSERT_EQUAL(ret, BATCH_SIZE, "Failed to arm event timers: %s",
+			  rte_strerror(rte_errno));
+	for (i = 0; i < BATCH_SIZE; i++)
+		TEST_ASSERT_EQUAL(evtims[i]->state, RTE_EVENT_TIMER_ARMED,
+				  "evtim %d in incorrect state", i);
+
+	ret = rte_event_timer_cancel_burst(adapter, evtims, BATCH_SIZE);
+	TEST_ASSERT_EQUAL(ret, BATCH_SIZE, "Failed to cancel event timers: %s",
+			  rte_strerror(rte_errno));
+	for (i = 0; i < BATCH_SIZE; i++)
+		TEST_ASSERT_EQUAL(evtims[i]->state, RTE_EVENT_TIMER_CANCELED,
+				  "evtim %d in incorrect state", i);
+
+	/* Check that cancelling the canceled timers fails on the first one */
+	ret = rte_event_timer_cancel_burst(adapter, evtims, BATCH_SIZE);
+	TEST_ASSERT_EQUAL(ret, 0, "Succeeded unexpectedly in canceling "
+			  "canceled timers");
+	TEST_ASSERT_EQUAL(rte_errno, EALREADY, "Unexpected rte_errno value "
+			  "after cancelling canceled timers");
+
+	/* Make sure that no expiry event was generated */
+	n = timeout_event_dequeue(evs, RTE_DIM(evs), WAIT_TICKS(ticks));
+	TEST_ASSERT_EQUAL(n, 0, "Dequeued unexpected timer expiry event");
+
+	rte_mempool_put_bulk(eventdev_test_mempool, (void **)evtims,
+			     BATCH_SIZE);
+
+	return TEST_SUCCESS;
+}
+
+/* Check that the timers of a burst expire in the order of their timeouts. */
+static int
+event_timer_arm_burst_expiry_order(void)
+{
+	uint16_t n;
+	int ret, i;
+	struct rte_event_timer_adapter *adapter = timdev;
+	struct rte_event_timer *evtims[BATCH_SIZE];
+	struct rte_event_timer *evtim;
+	struct rte_event evs[BATCH_SIZE];
+	const struct rte_event_timer init_tim = {
+		.ev.op = RTE_EVENT_OP_NEW,
+		.ev.queue_id = TEST_QUEUE_ID,
+		.ev.sched_type = RTE_SCHED_TYPE_ATOMIC,
+		.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.ev.event_type =  RTE_EVENT_TYPE_TIMER,
+		.state = RTE_EVENT_TIMER_NOT_ARMED,
+	};
+
+	TEST_ASSERT_SUCCESS(rte_mempool_get_bulk(eventdev_test_mempool,
+						 (void **)evtims, BATCH_SIZE),
+			    "mempool alloc failed");
+	/* in reverse order of expiry, one tick apart */
+	for (i = 0; i < BATCH_SIZE; i++) {
+		*evtims[i] = init_tim;
+		evtims[i]->ev.event_ptr = evtims[i];
+		evtims[i]->timeout_ticks = CALC_TICKS(BATCH_SIZE - i);
+	}
+
+	ret = rte_event_timer_arm_burst(adapter, evtims, BATCH_SIZE);
+	TEST_ASSERT_EQUAL(ret, BATCH_SIZE, "Failed to arm event timers: %s",
+			  rte_strerror(rte_errno));
+
+	n = timeout_event_dequeue(evs, RTE_DIM(evs), WAIT_TICKS(BATCH_SIZE));
+	TEST_ASSERT_EQUAL(n, BATCH_SIZE, "Dequeued incorrect number (%d) of "
+			  "timer expiry events", n);
+
+	for (i = 0; i < BATCH_SIZE; i++) {
+		evtim = evs[i].event_ptr;
+		TEST_ASSERT_EQUAL(evtim, evtims[BATCH_SIZE - 1 - i],
+				  "Timer expiry event %d out of order", i);
+		TEST_ASSERT_EQUAL(evtim->state, RTE_EVENT_TIMER_NOT_ARMED,
+				  "Expired evtim %d in incorrect state", i);
+	}
+
+	rte_mempool_put_bulk(eventdev_test_mempool, (void **)evtims,
+			     BATCH_SIZE);
+
+	return TEST_SUCCESS;
+}
+
 static int
 event_timer_cancel_double(void)
 {
@@ -2019,6 +2139,20 @@ static struct unit_test_suite event_timer_adptr_functional_testsuite  = {
 				event_timer_cancel),
 		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
 				event_timer_cancel_double),
+		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
+				event_timer_cancel_burst),
+		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
+				event_timer_arm_burst_expiry_order),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				test_timer_arm_burst),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_arm_expiry),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_cancel),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_cancel_burst),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_arm_burst_expiry_order),
 		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
 				adapter_tick_resolution),
 		TEST_CASE(adapter_create_max),
@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <rte_errno.h>
 #include <rte_ip.h>
 #include <rte_log.h>
 #include <rte_fib.h>
@@ -24,9 +25,12 @@ static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
 static int32_t test_invalid_rcu(void);
 static int32_t test_fib_rcu_sync_rw(void);
+static int32_t test_modify_bulk(void);
+static int32_t test_modify_bulk_rollback(void);
 
 #define MAX_ROUTES	(1 << 16)
 #define MAX_TBL8	(1 << 15)
+#define BULK_ROUTES	1024
 
 /*
  * Check that rte_fib_create fails gracefully for incorrect user input
@@ -588,6 +592,230 @@ test_fib_rcu_sync_rw(void)
 	return status == 0 ? TEST_SUCCESS : TEST_FAILED;
 }
 
+/*
+ * Apply the same route operations one by one to a FIB and as a batch to
+ * another one, then check both return the same next hops.
+ */
+static int
+check_modify_bulk(struct rte_fib *fib, struct rte_fib *fib_ref,
+	struct rte_fib_route_op *ops, uint32_t num)
+{
+	uint32_t ip[BULK_ROUTES];
+	uint64_t nh[BULK_ROUTES], nh_ref[BULK_ROUTES];
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < num; i++) {
+		if (ops[i].op == RTE_FIB_ADD)
+			ret = rte_fib_add(fib_ref, ops[i].ip, ops[i].depth,
+				ops[i].next_hop);
+		else
+			ret = rte_fib_delete(fib_ref, ops[i].ip, ops[i].depth);
+		RTE_TEST_ASSERT(ret == 0, "Failed to modify a route\n");
+	}
+
+	ret = rte_fib_modify_bulk(fib, ops, num);
+	RTE_TEST_ASSERT(ret == (int)num, "Failed to modify routes in bulk\n");
+
+	for (i = 0; i < num; i++) {
+		/* the prefix itself and an address next to its end */
+		ip[i] = (i & 1) ? ops[i].ip + (1ULL << (32 - ops[i].depth)) :
+			ops[i].ip;
+	}
+	ret = rte_fib_lookup_bulk(fib, ip, nh, num);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+	ret = rte_fib_lookup_bulk(fib_ref, ip, nh_ref, num);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+	for (i = 0; i < num; i++)
+		RTE_TEST_ASSERT(nh[i] == nh_ref[i],
+			"Bulk and sequential updates differ\n");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check rte_fib_modify_bulk against rte_fib_add/rte_fib_delete:
+ * - batch of overlapping additions
+ * - batch of next hop changes and deletions
+ * - partial failure of a batch
+ */
+int32_t
+test_modify_bulk(void)
+{
+	struct rte_fib *fib, *fib_ref;
+	struct rte_fib_conf config = { 0 };
+	struct rte_fib_route_op ops[BULK_ROUTES];
+	uint64_t nh;
+	uint32_t i, j, ip;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 100;
+	config.type = RTE_FIB_DIR24_8;
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
+	config.dir24_8.num_tbl8 = MAX_TBL8;
+
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	fib_ref = rte_fib_create("fib_ref", SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib_ref != NULL, "Failed to create FIB\n");
+
+	ret = rte_fib_modify_bulk(NULL, ops, 1);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+	ret = rte_fib_modify_bulk(fib, NULL, 1);
+	RTE_TEST_ASSERT(ret < 0, "Call succeeded with invalid parameters\n");
+
+	/* distinct nested prefixes inside 10.0.0.0/12 */
+	srand(1);
+	for (i = 0; i < BULK_ROUTES; i++) {
+		ops[i].depth = 12 + rand() % (RTE_FIB_MAXDEPTH - 11);
+		ip = RTE_IPV4(10, 0, 0, 0) | (rand() & 0xfffff);
+		ops[i].ip = ip & (uint32_t)(UINT64_MAX <<
+			(RTE_FIB_MAXDEPTH - ops[i].depth));
+		ops[i].op = RTE_FIB_ADD;
+		ops[i].next_hop = rand() % 16;
+		for (j = 0; j < i; j++)
+			if ((ops[j].ip == ops[i].ip) &&
+					(ops[j].depth == ops[i].depth))
+				break;
+		if (j != i)
+			i--;
+	}
+	ret = check_modify_bulk(fib, fib_ref, ops, BULK_ROUTES);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Bulk additions fail\n");
+
+	for (i = 0; i < BULK_ROUTES; i++) {
+		if (i & 1)
+			ops[i].next_hop = rand() % 16;
+		else
+			ops[i].op = RTE_FIB_DEL;
+	}
+	ret = check_modify_bulk(fib, fib_ref, ops, BULK_ROUTES);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Bulk deletions fail\n");
+
+	/* the second operation fails, the first one stays applied */
+	ops[0].ip = RTE_IPV4(192, 0, 2, 0);
+	ops[0].depth = 24;
+	ops[0].op = RTE_FIB_ADD;
+	ops[0].next_hop = 1;
+	ops[1].ip = RTE_IPV4(198, 51, 100, 0);
+	ops[1].depth = 24;
+	ops[1].op = RTE_FIB_DEL;
+	ops[2] = ops[0];
+	ops[2].ip = RTE_IPV4(203, 0, 113, 0);
+	ret = rte_fib_modify_bulk(fib, ops, 3);
+	RTE_TEST_ASSERT((ret == 1) && (rte_errno == ENOENT),
+		"Wrong result of a partially failed batch\n");
+	ip = RTE_IPV4(192, 0, 2, 1);
+	ret = rte_fib_lookup_bulk(fib, &ip, &nh, 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh == 1),
+		"Failed to get proper nexthop\n");
+	ip = RTE_IPV4(203, 0, 113, 1);
+	ret = rte_fib_lookup_bulk(fib, &ip, &nh, 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh == config.default_nh),
+		"Failed to get proper nexthop\n");
+
+	rte_fib_free(fib);
+	rte_fib_free(fib_ref);
+
+	return TEST_SUCCESS;
+}
+
+#define ROLLBACK_TBL8	64
+
+/*
+ * Check that a batch which fails to allocate tbl8 groups is rolled back:
+ * the tbl8 groups released by a previous batch are held by the RCU defer
+ * queue while the reader does not report a quiescent state.
+ */
+int32_t
+test_modify_bulk_rollback(void)
+{
+	struct rte_fib_route_op ops[ROLLBACK_TBL8 + 1];
+	struct rte_fib_rcu_config rcu_cfg = { 0 };
+	struct rte_fib_conf config = { 0 };
+	uint32_t ip[ROLLBACK_TBL8 + 1];
+	uint64_t nh[ROLLBACK_TBL8 + 1];
+	struct rte_rcu_qsbr *qsv;
+	struct rte_fib *fib;
+	uint32_t i;
+	size_t sz;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 100;
+	config.type = RTE_FIB_DIR24_8;
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
+	config.dir24_8.num_tbl8 = ROLLBACK_TBL8;
+
+	/* the function name is too long for the RIB mempool name */
+	fib = rte_fib_create("test_bulk_rollback", SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+
+	sz = rte_rcu_qsbr_get_memsize(1);
+	qsv = rte_zmalloc_socket(NULL, sz, RTE_CACHE_LINE_SIZE, SOCKET_ID_ANY);
+	RTE_TEST_ASSERT(qsv != NULL, "Can not allocate memory for RCU\n");
+	ret = rte_rcu_qsbr_init(qsv, 1);
+	RTE_TEST_ASSERT(ret == 0, "Can not initialize RCU\n");
+	rcu_cfg.v = qsv;
+	rcu_cfg.mode = RTE_FIB_QSBR_MODE_DQ;
+	ret = rte_fib_rcu_qsbr_add(fib, &rcu_cfg);
+	RTE_TEST_ASSERT(ret == 0, "Can not attach RCU to FIB\n");
+	rte_rcu_qsbr_thread_register(qsv, 0);
+	rte_rcu_qsbr_thread_online(qsv, 0);
+
+	/* use all the tbl8 groups, then release them */
+	for (i = 0; i < ROLLBACK_TBL8; i++) {
+		ops[i].ip = RTE_IPV4(10, 0, i, 0);
+		ops[i].depth = 25;
+		ops[i].op = RTE_FIB_ADD;
+		ops[i].next_hop = i;
+	}
+	ret = rte_fib_modify_bulk(fib, ops, ROLLBACK_TBL8);
+	RTE_TEST_ASSERT(ret == ROLLBACK_TBL8, "Failed to add routes in bulk\n");
+	for (i = 0; i < ROLLBACK_TBL8; i++)
+		ops[i].op = RTE_FIB_DEL;
+	ret = rte_fib_modify_bulk(fib, ops, ROLLBACK_TBL8);
+	RTE_TEST_ASSERT(ret == ROLLBACK_TBL8, "Failed to delete routes in bulk\n");
+
+	/* a covering route and routes which need a tbl8 group each */
+	ops[0].ip = RTE_IPV4(10, 1, 0, 0);
+	ops[0].depth = 16;
+	ops[0].op = RTE_FIB_ADD;
+	ops[0].next_hop = 1;
+	for (i = 1; i <= ROLLBACK_TBL8; i++) {
+		ops[i].ip = RTE_IPV4(10, 1, i - 1, 128);
+		ops[i].depth = 25;
+		ops[i].op = RTE_FIB_ADD;
+		ops[i].next_hop = 2;
+		ip[i] = ops[i].ip;
+	}
+	ip[0] = RTE_IPV4(10, 1, 0, 1);
+
+	ret = rte_fib_modify_bulk(fib, ops, ROLLBACK_TBL8 + 1);
+	RTE_TEST_ASSERT(ret < 0, "Batch applied without free tbl8 groups\n");
+	ret = rte_fib_lookup_bulk(fib, ip, nh, ROLLBACK_TBL8 + 1);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+	for (i = 0; i <= ROLLBACK_TBL8; i++)
+		RTE_TEST_ASSERT(nh[i] == config.default_nh,
+			"Failed batch not rolled back\n");
+
+	/* the batch is applied as a whole once the tbl8 groups are reclaimed */
+	rte_rcu_qsbr_quiescent(qsv, 0);
+	ret = rte_fib_modify_bulk(fib, ops, ROLLBACK_TBL8 + 1);
+	RTE_TEST_ASSERT(ret == ROLLBACK_TBL8 + 1, "Failed to apply the batch\n");
+	ret = rte_fib_lookup_bulk(fib, ip, nh, ROLLBACK_TBL8 + 1);
+	RTE_TEST_ASSERT((ret == 0) && (nh[0] == 1) && (nh[1] == 2),
+		"Failed to get proper nexthop\n");
+
+	rte_rcu_qsbr_thread_offline(qsv, 0);
+	rte_rcu_qsbr_thread_unregister(qsv, 0);
+	rte_fib_free(fib);
+	rte_free(qsv);
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite fib_fast_tests = {
 	.suite_name = "fib autotest",
 	.setup = NULL,
@@ -600,6 +828,8 @@ static struct unit_test_suite fib_fast_tests = {
 	TEST_CASE(test_lookup),
 	TEST_CASE(test_invalid_rcu),
 	TEST_CASE(test_fib_rcu_sync_rw),
+	TEST_CASE(test_modify_bulk),
+	TEST_CASE(test_modify_bulk_rollback),
 	TEST_CASES_END()
 	}
 };
@@ -6,12 +6,14 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <rte_memory.h>
 #include <rte_log.h>
 #include <rte_rib6.h>
 #include <rte_fib6.h>
 #include <rte_malloc.h>
+#include <rte_random.h>
 
 #include "test.h"
 
@@ -30,10 +32,14 @@ static int32_t test_drift_compression(void);
 static int32_t test_drift_multilevel(void);
 static int32_t test_drift_stress(void);
 static int32_t test_drift_tight_pool(void);
+static int32_t test_poptrie_random(void);
 
 #define MAX_ROUTES	(1 << 16)
 /** Maximum number of tbl8 for 2-byte entries */
 #define MAX_TBL8	(1 << 15)
+/** Number of poptrie nodes and leaves used by the tests */
+#define MAX_NODES	(1 << 16)
+#define MAX_LEAVES	(1 << 18)
 
 /*
  * Check that rte_fib6_create fails gracefully for incorrect user input
@@ -72,7 +78,7 @@ test_create_invalid(void)
 		"Call succeeded with invalid parameters\n");
 	config.max_routes = MAX_ROUTES;
 
-	config.type = RTE_FIB6_TRIE + 1;
+	config.type = RTE_FIB6_POPTRIE + 1;
 	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib == NULL,
 		"Call succeeded with invalid parameters\n");
@@ -91,6 +97,34 @@ test_create_invalid(void)
 	RTE_TEST_ASSERT(fib == NULL,
 		"Call succeeded with invalid parameters\n");
 
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.num_nodes = MAX_NODES;
+	config.poptrie.num_leaves = MAX_LEAVES;
+
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_8B + 1;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_2B;
+
+	config.poptrie.num_nodes = 0;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.poptrie.num_nodes = MAX_NODES;
+
+	config.poptrie.num_leaves = 0;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+	config.poptrie.num_leaves = MAX_LEAVES;
+
+	/* default next hop does not fit into 2 bytes */
+	config.default_nh = UINT16_MAX + 1;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
 	return TEST_SUCCESS;
 }
 
@@ -392,6 +426,34 @@ test_lookup(void)
 		"Check_fib fails for TRIE_8B type\n");
 	rte_fib6_free(fib);
 
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.num_nodes = MAX_NODES;
+	config.poptrie.num_leaves = MAX_LEAVES;
+
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_2B;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib(fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for POPTRIE_2B type\n");
+	rte_fib6_free(fib);
+
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_4B;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib(fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for POPTRIE_4B type\n");
+	rte_fib6_free(fib);
+
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_8B;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_fib(fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_fib fails for POPTRIE_8B type\n");
+	rte_fib6_free(fib);
+
 	return TEST_SUCCESS;
 }
 
@@ -929,6 +991,147 @@ test_drift_tight_pool(void)
 	return TEST_SUCCESS;
 }
 
+#define POPTRIE_NUM_ROUTES	2048
+#define POPTRIE_NUM_LOOKUPS	4096
+
+/*
+ * Compare both poptrie lookup implementations against the RIB based
+ * DUMMY FIB while random routes, clustered under a few /16 to get deep
+ * and shared nodes, are added and then removed.
+ */
+static int
+poptrie_compare(struct rte_fib6 *ref, struct rte_fib6 *fib,
+	struct rte_ipv6_addr *ips, uint64_t *nh_ref, uint64_t *nh)
+{
+	static const enum rte_fib6_lookup_type types[] = {
+		RTE_FIB6_LOOKUP_POPTRIE_SCALAR,
+		RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX512,
+	};
+	unsigned int i, j;
+	int ret;
+
+	ret = rte_fib6_lookup_bulk(ref, ips, nh_ref, POPTRIE_NUM_LOOKUPS);
+	RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+
+	for (i = 0; i < RTE_DIM(types); i++) {
+		/* vector lookup may be not supported by the platform */
+		if (rte_fib6_select_lookup(fib, types[i]) != 0)
+			continue;
+		ret = rte_fib6_lookup_bulk(fib, ips, nh, POPTRIE_NUM_LOOKUPS);
+		RTE_TEST_ASSERT(ret == 0, "Failed to lookup\n");
+		for (j = 0; j < POPTRIE_NUM_LOOKUPS; j++)
+			RTE_TEST_ASSERT(nh[j] == nh_ref[j],
+				"Wrong next hop %" PRIu64 " for lookup type %d, expected %" PRIu64 "\n",
+				nh[j], types[i], nh_ref[j]);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+poptrie_random_addr(struct rte_ipv6_addr *ip)
+{
+	uint64_t r[2];
+
+	r[0] = rte_rand();
+	r[1] = rte_rand();
+	memcpy(ip, r, sizeof(*ip));
+	/* keep everything under a handful of /16 */
+	ip->a[0] = 0x20;
+	ip->a[1] = r[0] & 0x3;
+}
+
+int32_t
+test_poptrie_random(void)
+{
+	struct rte_fib6_conf config = { 0 };
+	struct rte_fib6 *ref, *fib;
+	struct rte_ipv6_addr *routes, *ips;
+	uint64_t *nh_ref, *nh;
+	uint8_t *depths;
+	unsigned int i;
+	int ret = TEST_FAILED;
+
+	config.max_routes = POPTRIE_NUM_ROUTES;
+	config.default_nh = 0;
+	config.type = RTE_FIB6_DUMMY;
+	ref = rte_fib6_create("poptrie_ref", SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(ref != NULL, "Failed to create FIB\n");
+
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_4B;
+	config.poptrie.num_nodes = MAX_NODES;
+	config.poptrie.num_leaves = MAX_LEAVES;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	if (fib == NULL) {
+		rte_fib6_free(ref);
+		RTE_TEST_ASSERT(0, "Failed to create FIB\n");
+	}
+
+	routes = calloc(POPTRIE_NUM_ROUTES, sizeof(*routes));
+	depths = calloc(POPTRIE_NUM_ROUTES, sizeof(*depths));
+	ips = calloc(POPTRIE_NUM_LOOKUPS, sizeof(*ips));
+	nh_ref = calloc(POPTRIE_NUM_LOOKUPS, sizeof(*nh_ref));
+	nh = calloc(POPTRIE_NUM_LOOKUPS, sizeof(*nh));
+	if (routes == NULL || depths == NULL || ips == NULL ||
+			nh_ref == NULL || nh == NULL) {
+		printf("Failed to allocate memory\n");
+		goto out;
+	}
+
+	for (i = 0; i < POPTRIE_NUM_ROUTES; i++) {
+		poptrie_random_addr(&routes[i]);
+		depths[i] = 8 + rte_rand_max(RTE_IPV6_MAX_DEPTH - 7);
+		rte_ipv6_addr_mask(&routes[i], depths[i]);
+	}
+	/* half of the lookups hit a route address */
+	for (i = 0; i < POPTRIE_NUM_LOOKUPS; i++) {
+		if (i & 1)
+			ips[i] = routes[rte_rand_max(POPTRIE_NUM_ROUTES)];
+		else
+			poptrie_random_addr(&ips[i]);
+	}
+
+	for (i = 0; i < POPTRIE_NUM_ROUTES; i++) {
+		/* few distinct next hops make runs of equal leaves */
+		uint64_t next_hop = rte_rand_max(8) + 1;
+
+		if (rte_fib6_add(ref, &routes[i], depths[i], next_hop) != 0 ||
+				rte_fib6_add(fib, &routes[i], depths[i],
+				next_hop) != 0) {
+			printf("Failed to add a route\n");
+			goto out;
+		}
+		if ((i % (POPTRIE_NUM_ROUTES / 8)) == 0 &&
+				poptrie_compare(ref, fib, ips, nh_ref, nh) !=
+				TEST_SUCCESS)
+			goto out;
+	}
+	if (poptrie_compare(ref, fib, ips, nh_ref, nh) != TEST_SUCCESS)
+		goto out;
+
+	for (i = 0; i < POPTRIE_NUM_ROUTES; i++) {
+		/* duplicates are already gone */
+		rte_fib6_delete(ref, &routes[i], depths[i]);
+		rte_fib6_delete(fib, &routes[i], depths[i]);
+		if ((i % (POPTRIE_NUM_ROUTES / 8)) == 0 &&
+				poptrie_compare(ref, fib, ips, nh_ref, nh) !=
+				TEST_SUCCESS)
+			goto out;
+	}
+	ret = poptrie_compare(ref, fib, ips, nh_ref, nh);
+
+out:
+	free(routes);
+	free(depths);
+	free(ips);
+	free(nh_ref);
+	free(nh);
+	rte_fib6_free(fib);
+	rte_fib6_free(ref);
+	return ret;
+}
+
 static struct unit_test_suite fib6_fast_tests = {
 	.suite_name = "fib6 autotest",
 	.setup = NULL,
@@ -946,6 +1149,7 @@ static struct unit_test_suite fib6_fast_tests = {
 	TEST_CASE(test_drift_multilevel),
 	TEST_CASE(test_drift_stress),
 	TEST_CASE(test_drift_tight_pool),
+	TEST_CASE(test_poptrie_random),
 	TEST_CASES_END()
 	}
 };
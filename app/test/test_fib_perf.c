@@ -13,6 +13,7 @@
 #include <rte_branch_prediction.h>
 #include <rte_ip.h>
 #include <rte_fib.h>
+#include <rte_malloc.h>
 
 #include "test.h"
 #include "test_xmmt_ops.h"
@@ -321,6 +322,7 @@ test_fib_perf(void)
 {
 	struct rte_fib *fib = NULL;
 	struct rte_fib_conf config = { 0 };
+	struct rte_fib_route_op *ops;
 
 	config.max_routes = 2000000;
 	config.rib_ext_sz = 0;
@@ -402,6 +404,43 @@ test_fib_perf(void)
 	printf("Average FIB Delete: %g cycles\n",
 			(double)total_time / NUM_ROUTE_ENTRIES);
 
+	/* Measure batched add and delete */
+	ops = rte_malloc(NULL, sizeof(*ops) * NUM_ROUTE_ENTRIES, 0);
+	TEST_FIB_ASSERT(ops != NULL);
+	for (i = 0; i < NUM_ROUTE_ENTRIES; i++) {
+		ops[i].ip = large_route_table[i].ip;
+		ops[i].depth = large_route_table[i].depth;
+		ops[i].op = RTE_FIB_ADD;
+		ops[i].next_hop = next_hop_add;
+	}
+
+	/* the table may contain duplicates, skip the failed operations */
+	begin = rte_rdtsc();
+	for (i = 0; i < NUM_ROUTE_ENTRIES; i += status + 1) {
+		status = rte_fib_modify_bulk(fib, &ops[i],
+			NUM_ROUTE_ENTRIES - i);
+		TEST_FIB_ASSERT(status >= 0);
+	}
+	total_time = rte_rdtsc() - begin;
+
+	printf("Average FIB Bulk Add: %g cycles\n",
+			(double)total_time / NUM_ROUTE_ENTRIES);
+
+	for (i = 0; i < NUM_ROUTE_ENTRIES; i++)
+		ops[i].op = RTE_FIB_DEL;
+
+	begin = rte_rdtsc();
+	for (i = 0; i < NUM_ROUTE_ENTRIES; i += status + 1) {
+		status = rte_fib_modify_bulk(fib, &ops[i],
+			NUM_ROUTE_ENTRIES - i);
+		TEST_FIB_ASSERT(status >= 0);
+	}
+	total_time = rte_rdtsc() - begin;
+
+	printf("Average FIB Bulk Delete: %g cycles\n",
+			(double)total_time / NUM_ROUTE_ENTRIES);
+
+	rte_free(ops);
 	rte_fib_free(fib);
 
 	return 0;
@@ -168,6 +168,49 @@ static struct rte_node_register test_node0 = {
 };
 RTE_NODE_REGISTER(test_node0);
 
+static uint64_t coalesce_calls;
+static uint64_t coalesce_objs;
+
+static uint16_t
+test_coalesce_source_worker(struct rte_graph *graph, struct rte_node *node,
+			    void **objs, uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	/* One object per walk */
+	rte_node_enqueue_x1(graph, node, 0, &mbuf[0][0]);
+	return 1;
+}
+
+static uint16_t
+test_coalesce_sink_worker(struct rte_graph *graph, struct rte_node *node,
+			  void **objs, uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	coalesce_calls++;
+	coalesce_objs += nb_objs;
+	return nb_objs;
+}
+
+static struct rte_node_register test_coalesce_source = {
+	.name = "test_coalesce_source",
+	.process = test_coalesce_source_worker,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"test_coalesce_sink"},
+};
+RTE_NODE_REGISTER(test_coalesce_source);
+
+static struct rte_node_register test_coalesce_sink = {
+	.name = "test_coalesce_sink",
+	.process = test_coalesce_sink_worker,
+};
+RTE_NODE_REGISTER(test_coalesce_sink);
+
 uint16_t
 test_node_worker_source(struct rte_graph *graph, struct rte_node *node,
 			void **objs, uint16_t nb_objs)
@@ -906,6 +949,95 @@ test_graph_model_mcore_dispatch_core_bind_unbind(void)
 	return ret;
 }
 
+static int
+test_graph_model_mcore_dispatch_steal(void)
+{
+	static const char *patterns[] = {
+		"test_coalesce_source", "test_coalesce_sink",
+	};
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = 2,
+		.node_patterns = patterns,
+	};
+	rte_graph_t parent_id = RTE_GRAPH_ID_INVALID;
+	rte_graph_t id_a = RTE_GRAPH_ID_INVALID;
+	rte_graph_t id_b = RTE_GRAPH_ID_INVALID;
+	struct rte_graph_param graph_conf = {0};
+	unsigned int lcore_a, lcore_b;
+	struct rte_graph *graph;
+	struct rte_node *node;
+	int ret = -1;
+
+	lcore_a = rte_get_next_lcore(-1, 0, 0);
+	lcore_b = rte_get_next_lcore(lcore_a, 0, 0);
+	if (lcore_b >= RTE_MAX_LCORE) {
+		printf("At least 2 lcores are needed, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	/* Streams of the sink are scheduled to lcore a, produced on lcore b */
+	if (rte_graph_model_mcore_dispatch_node_lcore_affinity_set("test_coalesce_source",
+								   lcore_b) ||
+	    rte_graph_model_mcore_dispatch_node_lcore_affinity_set("test_coalesce_sink",
+								   lcore_a) ||
+	    rte_graph_model_mcore_dispatch_node_steal_set("test_coalesce_sink", true)) {
+		printf("Node affinity setup failed\n");
+		goto fail;
+	}
+
+	parent_id = rte_graph_create("steal", &gconf);
+	if (parent_id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		goto fail;
+	}
+	if (rte_graph_worker_model_set(RTE_GRAPH_MODEL_MCORE_DISPATCH)) {
+		printf("Set graph mcore dispatch model failed\n");
+		goto fail;
+	}
+	id_a = rte_graph_clone(parent_id, "a", &graph_conf);
+	id_b = rte_graph_clone(parent_id, "b", &graph_conf);
+	if (id_a == RTE_GRAPH_ID_INVALID || id_b == RTE_GRAPH_ID_INVALID) {
+		printf("Graph clone failed with error = %d\n", rte_errno);
+		goto fail;
+	}
+	if (rte_graph_model_mcore_dispatch_core_bind(id_a, lcore_a) ||
+	    rte_graph_model_mcore_dispatch_core_bind(id_b, lcore_b)) {
+		printf("Graph bind failed\n");
+		goto fail;
+	}
+
+	graph = rte_graph_lookup("steal-b");
+	node = rte_graph_node_get(id_b, test_coalesce_sink.id);
+	if (graph == NULL || node == NULL) {
+		printf("Graph lookup failed\n");
+		goto fail;
+	}
+
+	coalesce_calls = 0;
+
+	/* Graph a does not walk, graph b steals the stream it scheduled to a */
+	rte_graph_walk(graph);
+	if (coalesce_calls != 0 || node->dispatch.total_sched_objs != 1) {
+		printf("Stream not scheduled to lcore %u\n", lcore_a);
+		goto fail;
+	}
+	rte_graph_walk(graph);
+	if (coalesce_calls != 1 || node->dispatch.total_stolen_objs != 1) {
+		printf("Stream not stolen by lcore %u\n", lcore_b);
+		goto fail;
+	}
+
+	ret = 0;
+fail:
+	rte_graph_model_mcore_dispatch_node_steal_set("test_coalesce_sink", false);
+	rte_graph_destroy(id_b);
+	rte_graph_destroy(id_a);
+	rte_graph_destroy(parent_id);
+
+	return ret;
+}
+
 static int
 test_graph_worker_model_set_get(void)
 {
@@ -949,6 +1081,87 @@ test_graph_walk(void)
 	return 0;
 }
 
+static int
+test_graph_walk_coalesce(void)
+{
+	static const char *patterns[] = {
+		"test_coalesce_source", "test_coalesce_sink",
+	};
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = 2,
+		.node_patterns = patterns,
+	};
+	uint64_t delay = rte_get_tsc_hz() / 10;
+	struct rte_graph *graph;
+	struct rte_node *node;
+	rte_graph_t id;
+	int ret = -1;
+	int i;
+
+	if (rte_node_batch_coalesce_set(test_coalesce_source.id, 4, delay) !=
+	    -EINVAL) {
+		printf("Source node batching accepted\n");
+		return -1;
+	}
+	if (rte_node_batch_coalesce_set(test_coalesce_sink.id, 4, delay)) {
+		printf("Node batching setup failed\n");
+		return -1;
+	}
+
+	id = rte_graph_create("coalesce", &gconf);
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		goto reset;
+	}
+	graph = rte_graph_lookup("coalesce");
+	node = rte_graph_node_get(id, test_coalesce_sink.id);
+	if (graph == NULL || node == NULL) {
+		printf("Graph lookup failed\n");
+		goto fail;
+	}
+
+	coalesce_calls = 0;
+	coalesce_objs = 0;
+
+	/* Under-filled stream is deferred until the minimum batch is reached */
+	for (i = 0; i < 3; i++)
+		rte_graph_walk(graph);
+	if (coalesce_calls != 0) {
+		printf("Under-filled stream processed\n");
+		goto fail;
+	}
+	rte_graph_walk(graph);
+	if (coalesce_calls != 1 || coalesce_objs != 4) {
+		printf("Expected 1 call with 4 objs, got %" PRIu64 " calls with %"
+		       PRIu64 " objs\n", coalesce_calls, coalesce_objs);
+		goto fail;
+	}
+
+	/* Under-filled stream is processed once the maximum delay elapsed */
+	rte_graph_walk(graph);
+	rte_delay_us_block(2 * delay * US_PER_S / rte_get_tsc_hz());
+	rte_graph_walk(graph);
+	if (coalesce_calls != 2 || coalesce_objs != 6) {
+		printf("Expected 2 calls with 6 objs, got %" PRIu64 " calls with %"
+		       PRIu64 " objs\n", coalesce_calls, coalesce_objs);
+		goto fail;
+	}
+
+	if (rte_graph_has_stats_feature() &&
+	    (node->batch_hist[2] != 1 || node->batch_hist[3] != 1)) {
+		printf("Batch size histogram mismatch\n");
+		goto fail;
+	}
+
+	ret = 0;
+fail:
+	rte_graph_destroy(id);
+reset:
+	rte_node_batch_coalesce_set(test_coalesce_sink.id, 0, 0);
+	return ret;
+}
+
 static int
 test_graph_lookup_functions(void)
 {
@@ -1139,6 +1352,8 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_worker_model_set_get),
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
+		TEST_CASE(test_graph_walk_coalesce),
+		TEST_CASE(test_graph_model_mcore_dispatch_steal),
 		TEST_CASE(test_print_stats),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
@@ -0,0 +1,711 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_geneve.h>
+#include <rte_gre.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "test.h"
+
+/* Internal headers, to find flows which collide in the flow hash index */
+#include "gro_flow_hash.h"
+#include "gro_tcp6.h"
+
+#define NB_MBUFS 256
+#define MBUF_DATA_SIZE (RTE_PKTMBUF_HEADROOM + 256)
+#define PAYLOAD_LEN 64
+#define IP_DEFTTL 64
+
+/* Flows and items of the test context: a single item per flow */
+#define TEST_FLOWS 16
+/* Number of buckets of the flow hash index of the test context */
+#define TEST_BUCKETS (TEST_FLOWS * 2 / GRO_FLOW_HASH_BUCKET_ENTRIES)
+
+#define TEST_SRC_PORT 1024
+#define TEST_DST_PORT 5201
+
+/* Tunnels of the tunnel TCP/IPv4 GRO types */
+enum test_tunnel {
+	TEST_TUNNEL_GENEVE,
+	TEST_TUNNEL_GRE,
+	TEST_TUNNEL_NVGRE,
+	TEST_TUNNEL_VXLAN6,
+};
+
+static struct rte_mempool *pkt_pool;
+static void *gro_ctx;
+
+/*
+ * Build a TCP/IPv6 ACK packet of the flow with the given source port,
+ * carrying the payload bytes starting at 'seq'.
+ */
+static struct rte_mbuf *
+build_tcp6(uint16_t src_port, uint32_t seq, uint8_t tc)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m;
+	char *hdr;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+	hdr = rte_pktmbuf_append(m, sizeof(*eth) + sizeof(*ip6) +
+			sizeof(*tcp) + PAYLOAD_LEN);
+	if (hdr == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(hdr, 0, m->data_len);
+
+	eth = (struct rte_ether_hdr *)hdr;
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+	ip6 = (struct rte_ipv6_hdr *)(eth + 1);
+	ip6->vtc_flow = rte_cpu_to_be_32(6 << 28 | (uint32_t)tc << 20);
+	ip6->payload_len = rte_cpu_to_be_16(sizeof(*tcp) + PAYLOAD_LEN);
+	ip6->proto = IPPROTO_TCP;
+	ip6->hop_limits = IP_DEFTTL;
+	/* 2001:0200::/48 is reserved for IPv6 benchmarking (RFC5180) */
+	ip6->src_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 2);
+	ip6->dst_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+
+	tcp = (struct rte_tcp_hdr *)(ip6 + 1);
+	tcp->src_port = rte_cpu_to_be_16(src_port);
+	tcp->dst_port = rte_cpu_to_be_16(TEST_DST_PORT);
+	tcp->sent_seq = rte_cpu_to_be_32(seq);
+	tcp->data_off = (sizeof(struct rte_tcp_hdr) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+
+	m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV6 |
+		RTE_PTYPE_L4_TCP;
+	m->l2_len = sizeof(*eth);
+	m->l3_len = sizeof(*ip6);
+	m->l4_len = sizeof(*tcp);
+
+	return m;
+}
+
+/*
+ * Pass a single packet to the GRO context. Return 0 if it is stored in
+ * the context, 1 if it is given back (and freed), or -1 on failure.
+ */
+static int
+reassemble_one(uint16_t src_port, uint32_t seq, uint8_t tc)
+{
+	struct rte_mbuf *m;
+
+	m = build_tcp6(src_port, seq, tc);
+	if (m == NULL) {
+		printf("Failed to build packet\n");
+		return -1;
+	}
+	if (rte_gro_reassemble(&m, 1, gro_ctx) == 0)
+		return 0;
+
+	rte_pktmbuf_free(m);
+	return 1;
+}
+
+/* Flush the packets of the context, and check their number and lengths. */
+static int
+flush_check(uint64_t timeout_cycles, uint16_t nb_pkts, uint16_t nb_segs)
+{
+	struct rte_mbuf *out[TEST_FLOWS + 1];
+	uint16_t i, n;
+	int ret = 0;
+
+	n = rte_gro_timeout_flush(gro_ctx, timeout_cycles, RTE_GRO_TCP_IPV6,
+			out, RTE_DIM(out));
+	if (n != nb_pkts) {
+		printf("Flushed %u packets instead of %u\n", n, nb_pkts);
+		ret = -1;
+	}
+	for (i = 0; i < n; i++) {
+		if (out[i]->nb_segs != nb_segs ||
+				out[i]->pkt_len != sizeof(struct rte_ether_hdr) +
+				sizeof(struct rte_ipv6_hdr) +
+				sizeof(struct rte_tcp_hdr) +
+				nb_segs * PAYLOAD_LEN) {
+			printf("Packet %u has %u segments and %u bytes\n", i,
+			       out[i]->nb_segs, out[i]->pkt_len);
+			ret = -1;
+		}
+	}
+	rte_pktmbuf_free_bulk(out, n);
+
+	return ret;
+}
+
+/* Flush and free all packets of the context. */
+static void
+flush_all(void)
+{
+	struct rte_mbuf *out[TEST_FLOWS];
+	uint16_t n;
+
+	do {
+		n = rte_gro_timeout_flush(gro_ctx, 0, RTE_GRO_TCP_IPV6, out,
+				RTE_DIM(out));
+		rte_pktmbuf_free_bulk(out, n);
+	} while (n > 0);
+}
+
+/* Hash of the flow key of the packets built by build_tcp6() */
+static uint32_t
+tcp6_flow_hash(uint16_t src_port)
+{
+	struct tcp6_flow_key key;
+
+	memset(&key, 0, sizeof(key));
+	key.src_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 2);
+	key.dst_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+	key.cmn_key.src_port = rte_cpu_to_be_16(src_port);
+	key.cmn_key.dst_port = rte_cpu_to_be_16(TEST_DST_PORT);
+	key.vtc_flow = rte_cpu_to_be_32(6 << 28);
+
+	return gro_flow_hash_key(&key, sizeof(key));
+}
+
+/*
+ * Build a tunnel packet carrying a TCP/IPv4 ACK packet, whose payload
+ * bytes start at 'seq'. The tunnel has 'opt_len' GENEVE option words,
+ * and 'id' is the value of these options, the GRE key or the VNI.
+ */
+static struct rte_mbuf *
+build_tunnel_tcp4(enum test_tunnel tunnel, uint8_t opt_len, uint32_t id,
+		uint32_t seq)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_udp_hdr *udp;
+	struct rte_geneve_hdr *geneve;
+	struct rte_gre_hdr *gre;
+	struct rte_vxlan_hdr *vxlan;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m;
+	uint16_t len;
+	char *hdr;
+	uint8_t i;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+
+	m->outer_l2_len = sizeof(*eth);
+	m->l3_len = sizeof(*ip4);
+	m->l4_len = sizeof(*tcp);
+	m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_INNER_L2_ETHER |
+		RTE_PTYPE_INNER_L3_IPV4 | RTE_PTYPE_INNER_L4_TCP;
+	switch (tunnel) {
+	case TEST_TUNNEL_GENEVE:
+		m->outer_l3_len = sizeof(*ip4);
+		m->l2_len = sizeof(*udp) + sizeof(*geneve) + opt_len * 4;
+		m->packet_type |= RTE_PTYPE_L3_IPV4 | RTE_PTYPE_L4_UDP |
+			RTE_PTYPE_TUNNEL_GENEVE;
+		break;
+	case TEST_TUNNEL_GRE:
+	case TEST_TUNNEL_NVGRE:
+		m->outer_l3_len = sizeof(*ip4);
+		m->l2_len = sizeof(*gre) + sizeof(struct rte_gre_hdr_opt_key);
+		m->packet_type |= RTE_PTYPE_L3_IPV4 |
+			(tunnel == TEST_TUNNEL_GRE ? RTE_PTYPE_TUNNEL_GRE :
+			 RTE_PTYPE_TUNNEL_NVGRE);
+		break;
+	case TEST_TUNNEL_VXLAN6:
+		m->outer_l3_len = sizeof(*ip6);
+		m->l2_len = sizeof(*udp) + sizeof(*vxlan);
+		m->packet_type |= RTE_PTYPE_L3_IPV6 | RTE_PTYPE_L4_UDP |
+			RTE_PTYPE_TUNNEL_VXLAN;
+		break;
+	}
+	m->l2_len += sizeof(*eth);
+
+	len = m->outer_l2_len + m->outer_l3_len + m->l2_len + m->l3_len +
+		m->l4_len + PAYLOAD_LEN;
+	hdr = rte_pktmbuf_append(m, len);
+	if (hdr == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(hdr, 0, len);
+
+	/* Outer L2 and L3 headers, the outer IPv4 header has DF set */
+	eth = (struct rte_ether_hdr *)hdr;
+	hdr += m->outer_l2_len;
+	len -= m->outer_l2_len;
+	if (tunnel == TEST_TUNNEL_VXLAN6) {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+		ip6 = (struct rte_ipv6_hdr *)hdr;
+		ip6->vtc_flow = rte_cpu_to_be_32(6 << 28);
+		ip6->payload_len = rte_cpu_to_be_16(len - sizeof(*ip6));
+		ip6->proto = IPPROTO_UDP;
+		ip6->hop_limits = IP_DEFTTL;
+		ip6->src_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 2);
+		ip6->dst_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+	} else {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		ip4 = (struct rte_ipv4_hdr *)hdr;
+		ip4->version_ihl = RTE_IPV4_VHL_DEF;
+		ip4->total_length = rte_cpu_to_be_16(len);
+		ip4->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+		ip4->time_to_live = IP_DEFTTL;
+		ip4->next_proto_id = tunnel == TEST_TUNNEL_GENEVE ?
+			IPPROTO_UDP : IPPROTO_GRE;
+		/* 198.18.0.0/15 is reserved for benchmarking (RFC2544) */
+		ip4->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 2));
+		ip4->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+	}
+	hdr += m->outer_l3_len;
+	len -= m->outer_l3_len;
+
+	/* Tunnel header */
+	switch (tunnel) {
+	case TEST_TUNNEL_GENEVE:
+		udp = (struct rte_udp_hdr *)hdr;
+		udp->src_port = rte_cpu_to_be_16(TEST_SRC_PORT);
+		udp->dst_port = rte_cpu_to_be_16(RTE_GENEVE_DEFAULT_PORT);
+		udp->dgram_len = rte_cpu_to_be_16(len);
+		geneve = (struct rte_geneve_hdr *)(udp + 1);
+		geneve->opt_len = opt_len;
+		geneve->proto = rte_cpu_to_be_16(RTE_GENEVE_TYPE_ETH);
+		geneve->vni[2] = 1;
+		for (i = 0; i < opt_len; i++)
+			geneve->opts[i] = rte_cpu_to_be_32(id);
+		break;
+	case TEST_TUNNEL_GRE:
+	case TEST_TUNNEL_NVGRE:
+		gre = (struct rte_gre_hdr *)hdr;
+		gre->k = 1;
+		gre->proto = rte_cpu_to_be_16(RTE_ETHER_TYPE_TEB);
+		/* The NVGRE key is the virtual subnet ID and a flow ID */
+		((struct rte_gre_hdr_opt_key *)(gre + 1))->key =
+			rte_cpu_to_be_32(tunnel == TEST_TUNNEL_GRE ? id : id << 8);
+		break;
+	case TEST_TUNNEL_VXLAN6:
+		udp = (struct rte_udp_hdr *)hdr;
+		udp->src_port = rte_cpu_to_be_16(TEST_SRC_PORT);
+		udp->dst_port = rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT);
+		udp->dgram_len = rte_cpu_to_be_16(len);
+		vxlan = (struct rte_vxlan_hdr *)(udp + 1);
+		vxlan->flag_i = 1;
+		vxlan->vx_vni = rte_cpu_to_be_32(id << 8);
+		break;
+	}
+	hdr += m->l2_len;
+	len -= m->l2_len;
+
+	/* Inner packet, with DF set */
+	eth = (struct rte_ether_hdr *)(hdr - sizeof(*eth));
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+	ip4 = (struct rte_ipv4_hdr *)hdr;
+	ip4->version_ihl = RTE_IPV4_VHL_DEF;
+	ip4->total_length = rte_cpu_to_be_16(len);
+	ip4->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+	ip4->time_to_live = IP_DEFTTL;
+	ip4->next_proto_id = IPPROTO_TCP;
+	ip4->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 19, 0, 2));
+	ip4->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 19, 0, 1));
+
+	tcp = (struct rte_tcp_hdr *)(ip4 + 1);
+	tcp->src_port = rte_cpu_to_be_16(TEST_SRC_PORT);
+	tcp->dst_port = rte_cpu_to_be_16(TEST_DST_PORT);
+	tcp->sent_seq = rte_cpu_to_be_32(seq);
+	tcp->data_off = (sizeof(struct rte_tcp_hdr) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+
+	return m;
+}
+
+/* Check the length fields of the headers of a merged tunnel packet. */
+static int
+tunnel_len_check(struct rte_mbuf *m, enum test_tunnel tunnel)
+{
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_udp_hdr *udp;
+	uint16_t len;
+	char *hdr;
+
+	hdr = rte_pktmbuf_mtod_offset(m, char *, m->outer_l2_len);
+	len = m->pkt_len - m->outer_l2_len;
+	if (tunnel == TEST_TUNNEL_VXLAN6) {
+		ip6 = (struct rte_ipv6_hdr *)hdr;
+		if (rte_be_to_cpu_16(ip6->payload_len) != len - sizeof(*ip6)) {
+			printf("Outer IPv6 payload length %u instead of %zu\n",
+			       rte_be_to_cpu_16(ip6->payload_len),
+			       len - sizeof(*ip6));
+			return -1;
+		}
+	} else {
+		ip4 = (struct rte_ipv4_hdr *)hdr;
+		if (rte_be_to_cpu_16(ip4->total_length) != len) {
+			printf("Outer IPv4 length %u instead of %u\n",
+			       rte_be_to_cpu_16(ip4->total_length), len);
+			return -1;
+		}
+	}
+
+	hdr += m->outer_l3_len;
+	len -= m->outer_l3_len;
+	if (tunnel == TEST_TUNNEL_GENEVE || tunnel == TEST_TUNNEL_VXLAN6) {
+		udp = (struct rte_udp_hdr *)hdr;
+		if (rte_be_to_cpu_16(udp->dgram_len) != len) {
+			printf("Outer UDP length %u instead of %u\n",
+			       rte_be_to_cpu_16(udp->dgram_len), len);
+			return -1;
+		}
+	}
+
+	hdr += m->l2_len;
+	len -= m->l2_len;
+	ip4 = (struct rte_ipv4_hdr *)hdr;
+	if (rte_be_to_cpu_16(ip4->total_length) != len) {
+		printf("Inner IPv4 length %u instead of %u\n",
+		       rte_be_to_cpu_16(ip4->total_length), len);
+		return -1;
+	}
+
+	return 0;
+}
+
+static uint64_t
+tunnel_gro_type(enum test_tunnel tunnel)
+{
+	switch (tunnel) {
+	case TEST_TUNNEL_GENEVE:
+		return RTE_GRO_IPV4_GENEVE_TCP_IPV4;
+	case TEST_TUNNEL_GRE:
+	case TEST_TUNNEL_NVGRE:
+		return RTE_GRO_IPV4_GRE_TCP_IPV4;
+	case TEST_TUNNEL_VXLAN6:
+		return RTE_GRO_IPV6_VXLAN_TCP_IPV4;
+	}
+
+	return 0;
+}
+
+/*
+ * Pass a burst of two consecutive tunnel packets, with the tunnel values
+ * 'id0' and 'id1', and check that they are merged into a packet with
+ * updated lengths only if these values are the same.
+ */
+static int
+tunnel_merge_check(enum test_tunnel tunnel, uint8_t opt_len, uint32_t id0,
+		uint32_t id1)
+{
+	struct rte_gro_param param = {
+		.gro_types = tunnel_gro_type(tunnel),
+		.max_flow_num = TEST_FLOWS,
+		.max_item_per_flow = 1,
+	};
+	struct rte_mbuf *pkts[2];
+	uint16_t nb_pkts;
+	uint32_t hdr_len;
+	int ret = 0;
+
+	pkts[0] = build_tunnel_tcp4(tunnel, opt_len, id0, 0);
+	pkts[1] = build_tunnel_tcp4(tunnel, opt_len, id1, PAYLOAD_LEN);
+	if (pkts[0] == NULL || pkts[1] == NULL) {
+		printf("Failed to build packets\n");
+		rte_pktmbuf_free(pkts[0]);
+		rte_pktmbuf_free(pkts[1]);
+		return -1;
+	}
+	hdr_len = pkts[0]->pkt_len - PAYLOAD_LEN;
+
+	nb_pkts = rte_gro_reassemble_burst(pkts, RTE_DIM(pkts), &param);
+	if (id0 != id1) {
+		if (nb_pkts != 2) {
+			printf("Packets of different tunnels merged\n");
+			ret = -1;
+		}
+	} else if (nb_pkts != 1) {
+		printf("Packets not merged\n");
+		ret = -1;
+	} else if (pkts[0]->nb_segs != 2 ||
+			pkts[0]->pkt_len != hdr_len + 2 * PAYLOAD_LEN) {
+		printf("Packet has %u segments and %u bytes\n",
+		       pkts[0]->nb_segs, pkts[0]->pkt_len);
+		ret = -1;
+	} else {
+		ret = tunnel_len_check(pkts[0], tunnel);
+	}
+	rte_pktmbuf_free_bulk(pkts, nb_pkts);
+
+	return ret;
+}
+
+static int
+test_gro_setup(void)
+{
+	pkt_pool = rte_pktmbuf_pool_create("test_gro_pool", NB_MBUFS, 0, 0,
+			MBUF_DATA_SIZE, SOCKET_ID_ANY);
+	if (pkt_pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_gro_teardown(void)
+{
+	rte_mempool_free(pkt_pool);
+	pkt_pool = NULL;
+}
+
+static int
+test_gro_ctx_setup(void)
+{
+	struct rte_gro_param param = {
+		.gro_types = RTE_GRO_TCP_IPV6,
+		.max_flow_num = TEST_FLOWS,
+		.max_item_per_flow = 1,
+		.socket_id = rte_socket_id(),
+	};
+
+	gro_ctx = rte_gro_ctx_create(&param);
+	if (gro_ctx == NULL) {
+		printf("Failed to create GRO context\n");
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_gro_ctx_teardown(void)
+{
+	flush_all();
+	rte_gro_ctx_destroy(gro_ctx);
+	gro_ctx = NULL;
+}
+
+/* Packets which differ in their Traffic Class only are merged. */
+static int
+test_gro_tcp6_traffic_class(void)
+{
+	TEST_ASSERT_EQUAL(reassemble_one(TEST_SRC_PORT, 0, 0), 0,
+			  "First packet not stored");
+	TEST_ASSERT_EQUAL(reassemble_one(TEST_SRC_PORT, PAYLOAD_LEN, 0x2e), 0,
+			  "Packet with another Traffic Class not merged");
+	TEST_ASSERT_EQUAL(rte_gro_get_pkt_count(gro_ctx), 1,
+			  "Unexpected number of packets in the context");
+	TEST_ASSERT_SUCCESS(flush_check(0, 1, 2), "Unexpected flushed packets");
+
+	return TEST_SUCCESS;
+}
+
+/* Only the packets which are older than the timeout are flushed. */
+static int
+test_gro_tcp6_timeout_flush(void)
+{
+	uint64_t hz = rte_get_tsc_hz();
+
+	TEST_ASSERT_EQUAL(reassemble_one(TEST_SRC_PORT, 0, 0), 0,
+			  "Packet not stored");
+	TEST_ASSERT_SUCCESS(flush_check(hz, 0, 0),
+			    "Packet flushed before its timeout");
+	TEST_ASSERT_EQUAL(rte_gro_get_pkt_count(gro_ctx), 1,
+			  "Packet not kept in the context");
+
+	rte_delay_ms(10);
+	TEST_ASSERT_SUCCESS(flush_check(hz / 1000, 1, 1),
+			    "Packet not flushed after its timeout");
+	TEST_ASSERT_EQUAL(rte_gro_get_pkt_count(gro_ctx), 0,
+			  "Packet left in the context");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Fill the context several times, so that the flows and items which are
+ * freed by a flush are reused.
+ */
+static int
+test_gro_tcp6_reuse(void)
+{
+	uint16_t ports[TEST_FLOWS];
+	uint16_t round, i, port = TEST_SRC_PORT;
+
+	for (round = 0; round < 4; round++) {
+		/* Spread the flows evenly, so that no bucket gets full */
+		for (i = 0; i < TEST_FLOWS; i++) {
+			while ((tcp6_flow_hash(port) & (TEST_BUCKETS - 1)) !=
+					i % TEST_BUCKETS)
+				port++;
+			ports[i] = port++;
+		}
+
+		for (i = 0; i < TEST_FLOWS; i++)
+			TEST_ASSERT_EQUAL(reassemble_one(ports[i], 0, 0), 0,
+					  "Round %u: flow %u not stored",
+					  round, i);
+		/* The context is full */
+		TEST_ASSERT_EQUAL(reassemble_one(port, 0, 0), 1,
+				  "Round %u: packet stored in full context",
+				  round);
+		/* Items are still merged into the stored flows */
+		for (i = 0; i < TEST_FLOWS; i++)
+			TEST_ASSERT_EQUAL(reassemble_one(ports[i], PAYLOAD_LEN,
+							 0), 0,
+					  "Round %u: flow %u not merged",
+					  round, i);
+		TEST_ASSERT_EQUAL(rte_gro_get_pkt_count(gro_ctx), TEST_FLOWS,
+				  "Round %u: unexpected number of packets",
+				  round);
+		TEST_ASSERT_SUCCESS(flush_check(0, TEST_FLOWS, 2),
+				    "Round %u: unexpected flushed packets",
+				    round);
+	}
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * A new flow whose buckets are both full is not stored, while the flows
+ * which are already stored are still merged.
+ */
+static int
+test_gro_tcp6_bucket_full(void)
+{
+	uint16_t ports[GRO_FLOW_HASH_BUCKET_ENTRIES + 1];
+	uint16_t others[TEST_FLOWS - GRO_FLOW_HASH_BUCKET_ENTRIES];
+	uint16_t port, i, n = 0, m = 0;
+	uint32_t h;
+
+	RTE_BUILD_BUG_ON(TEST_BUCKETS < 2 ||
+			 !RTE_IS_POWER_OF_2(TEST_BUCKETS));
+
+	/*
+	 * Find flows whose primary and secondary buckets are bucket 0, and
+	 * flows whose primary bucket is another one.
+	 */
+	for (port = TEST_SRC_PORT; port != 0 &&
+			(n < RTE_DIM(ports) || m < RTE_DIM(others)); port++) {
+		h = tcp6_flow_hash(port);
+		if ((h & (TEST_BUCKETS - 1)) != 0) {
+			if (m < RTE_DIM(others))
+				others[m++] = port;
+		} else if ((gro_flow_hash_sig(h) & (TEST_BUCKETS - 1)) == 0) {
+			if (n < RTE_DIM(ports))
+				ports[n++] = port;
+		}
+	}
+	TEST_ASSERT_EQUAL(n, RTE_DIM(ports), "Not enough colliding flows");
+
+	for (i = 0; i < GRO_FLOW_HASH_BUCKET_ENTRIES; i++)
+		TEST_ASSERT_EQUAL(reassemble_one(ports[i], 0, 0), 0,
+				  "Flow %u not stored", i);
+	TEST_ASSERT_EQUAL(reassemble_one(ports[i], 0, 0), 1,
+			  "Flow stored in a full bucket");
+	TEST_ASSERT_EQUAL(rte_gro_get_pkt_count(gro_ctx),
+			  GRO_FLOW_HASH_BUCKET_ENTRIES,
+			  "Unexpected number of packets in the context");
+
+	/* The stored flows are still merged. */
+	TEST_ASSERT_EQUAL(reassemble_one(ports[0], PAYLOAD_LEN, 0), 0,
+			  "Stored flow not merged");
+
+	/* The flow and the item of the failed insertion are given back. */
+	for (i = 0; i < RTE_DIM(others); i++)
+		TEST_ASSERT_EQUAL(reassemble_one(others[i], 0, 0), 0,
+				  "Flow %u of another bucket not stored", i);
+	TEST_ASSERT_EQUAL(rte_gro_get_pkt_count(gro_ctx), TEST_FLOWS,
+			  "Unexpected number of packets in the context");
+
+	flush_all();
+
+	/* The bucket has room again. */
+	TEST_ASSERT_EQUAL(reassemble_one(ports[GRO_FLOW_HASH_BUCKET_ENTRIES],
+					 0, 0), 0,
+			  "Flow not stored after flush");
+
+	return TEST_SUCCESS;
+}
+
+/* GENEVE packets are merged only if their options are the same. */
+static int
+test_gro_geneve_tcp4(void)
+{
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_GENEVE, 0, 1, 1),
+			    "GENEVE packets without options not merged");
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_GENEVE, 2, 1, 1),
+			    "GENEVE packets with options not merged");
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_GENEVE, 2, 1, 2),
+			    "GENEVE packets with other options merged");
+
+	return TEST_SUCCESS;
+}
+
+/* GRE and NVGRE packets are merged only if their keys are the same. */
+static int
+test_gro_gre_tcp4(void)
+{
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_GRE, 0, 1, 1),
+			    "GRE packets not merged");
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_GRE, 0, 1, 2),
+			    "GRE packets with another key merged");
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_NVGRE, 0, 1, 1),
+			    "NVGRE packets not merged");
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_NVGRE, 0, 1, 2),
+			    "NVGRE packets of another subnet merged");
+
+	return TEST_SUCCESS;
+}
+
+/* VxLAN packets with an outer IPv6 header are merged. */
+static int
+test_gro_vxlan6_tcp4(void)
+{
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_VXLAN6, 0, 1, 1),
+			    "VxLAN/IPv6 packets not merged");
+	TEST_ASSERT_SUCCESS(tunnel_merge_check(TEST_TUNNEL_VXLAN6, 0, 1, 2),
+			    "VxLAN/IPv6 packets of another VNI merged");
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite gro_testsuite = {
+	.suite_name = "GRO autotest",
+	.setup = test_gro_setup,
+	.teardown = test_gro_teardown,
+	.unit_test_cases = {
+		TEST_CASE_ST(test_gro_ctx_setup, test_gro_ctx_teardown,
+			     test_gro_tcp6_traffic_class),
+		TEST_CASE_ST(test_gro_ctx_setup, test_gro_ctx_teardown,
+			     test_gro_tcp6_timeout_flush),
+		TEST_CASE_ST(test_gro_ctx_setup, test_gro_ctx_teardown,
+			     test_gro_tcp6_reuse),
+		TEST_CASE_ST(test_gro_ctx_setup, test_gro_ctx_teardown,
+			     test_gro_tcp6_bucket_full),
+		TEST_CASE(test_gro_geneve_tcp4),
+		TEST_CASE(test_gro_gre_tcp4),
+		TEST_CASE(test_gro_vxlan6_tcp4),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_gro(void)
+{
+	return unit_test_suite_runner(&gro_testsuite);
+}
+
+REGISTER_FAST_TEST(gro_autotest, NOHUGE_OK, ASAN_OK, test_gro);
@@ -0,0 +1,238 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_random.h>
+#include <rte_tcp.h>
+
+#include "test.h"
+
+#define BURST_SIZE 32
+#define NB_PKTS (1U << 20)
+#define PAYLOAD_LEN 64
+#define PKTS_PER_FLOW 4
+#define MAX_FLOWS 4096
+#define NB_MBUFS (MAX_FLOWS * PKTS_PER_FLOW * 2)
+#define MBUF_DATA_SIZE (RTE_PKTMBUF_HEADROOM + 256)
+
+#define IP_DEFTTL 64
+
+static const struct {
+	const char *desc;
+	uint64_t gro_type;
+} gro_perf_types[] = {
+	{ "TCP/IPv4", RTE_GRO_TCP_IPV4 },
+	{ "TCP/IPv6", RTE_GRO_TCP_IPV6 },
+};
+
+/* Numbers of concurrent flows */
+static const uint16_t flow_nums[] = { 1, 16, 256, 1024, MAX_FLOWS };
+
+static struct rte_mempool *pkt_pool;
+
+/* Next TCP sequence number of each flow */
+static uint32_t flow_seq[MAX_FLOWS];
+
+/*
+ * Build an ACK packet of the given flow. Flows differ in their source
+ * address and port.
+ */
+static int
+build_packet(struct rte_mbuf *m, uint64_t gro_type, uint16_t flow)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_tcp_hdr *tcp;
+	uint16_t l3_len;
+	char *hdr;
+
+	l3_len = gro_type == RTE_GRO_TCP_IPV4 ? sizeof(struct rte_ipv4_hdr) :
+		sizeof(struct rte_ipv6_hdr);
+	hdr = rte_pktmbuf_append(m, sizeof(*eth) + l3_len + sizeof(*tcp) +
+			PAYLOAD_LEN);
+	if (hdr == NULL)
+		return -1;
+	memset(hdr, 0, m->data_len);
+
+	eth = (struct rte_ether_hdr *)hdr;
+	if (gro_type == RTE_GRO_TCP_IPV4) {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		ip4 = (struct rte_ipv4_hdr *)(eth + 1);
+		ip4->version_ihl = RTE_IPV4_VHL_DEF;
+		ip4->total_length = rte_cpu_to_be_16(l3_len + sizeof(*tcp) +
+				PAYLOAD_LEN);
+		/* DF is set, so that IPv4 IDs are ignored */
+		ip4->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+		ip4->time_to_live = IP_DEFTTL;
+		ip4->next_proto_id = IPPROTO_TCP;
+		ip4->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 1, 0) + flow);
+		ip4->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+		m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4 |
+			RTE_PTYPE_L4_TCP;
+	} else {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+		ip6 = (struct rte_ipv6_hdr *)(eth + 1);
+		ip6->vtc_flow = rte_cpu_to_be_32(6 << 28);
+		ip6->payload_len = rte_cpu_to_be_16(sizeof(*tcp) + PAYLOAD_LEN);
+		ip6->proto = IPPROTO_TCP;
+		ip6->hop_limits = IP_DEFTTL;
+		/* 2001:0200::/48 is reserved for IPv6 benchmarking (RFC5180) */
+		ip6->src_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 1, flow);
+		ip6->dst_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+		m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV6 |
+			RTE_PTYPE_L4_TCP;
+	}
+
+	tcp = (struct rte_tcp_hdr *)(hdr + sizeof(*eth) + l3_len);
+	tcp->src_port = rte_cpu_to_be_16(1024 + flow);
+	tcp->dst_port = rte_cpu_to_be_16(5201);
+	tcp->sent_seq = rte_cpu_to_be_32(flow_seq[flow]);
+	tcp->data_off = (sizeof(struct rte_tcp_hdr) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+	flow_seq[flow] += PAYLOAD_LEN;
+
+	m->l2_len = sizeof(*eth);
+	m->l3_len = l3_len;
+	m->l4_len = sizeof(*tcp);
+
+	return 0;
+}
+
+/* Flush all packets of the context, and return the number of packets. */
+static uint32_t
+flush_all(void *ctx, uint64_t gro_type, uint64_t *cycles)
+{
+	struct rte_mbuf *out[BURST_SIZE];
+	uint32_t nb_out = 0;
+	uint64_t start;
+	uint16_t n, i;
+
+	do {
+		start = rte_rdtsc_precise();
+		n = rte_gro_timeout_flush(ctx, 0, gro_type, out, BURST_SIZE);
+		*cycles += rte_rdtsc_precise() - start;
+
+		for (i = 0; i < n; i++)
+			rte_pktmbuf_free(out[i]);
+		nb_out += n;
+	} while (n > 0);
+
+	return nb_out;
+}
+
+static int
+test_gro_perf_flows(unsigned int t, uint16_t nb_flows)
+{
+	struct rte_gro_param param = {
+		.gro_types = gro_perf_types[t].gro_type,
+		.max_flow_num = nb_flows,
+		.max_item_per_flow = PKTS_PER_FLOW,
+		.socket_id = rte_socket_id(),
+	};
+	struct rte_mbuf *pkts[BURST_SIZE];
+	uint64_t start, cycles = 0, nb_out = 0;
+	uint32_t nb_in = 0, nb_stored = 0;
+	uint16_t i, n;
+	void *ctx;
+
+	ctx = rte_gro_ctx_create(&param);
+	if (ctx == NULL) {
+		printf("Failed to create GRO context\n");
+		return TEST_FAILED;
+	}
+	memset(flow_seq, 0, sizeof(flow_seq));
+
+	while (nb_in < NB_PKTS) {
+		if (rte_pktmbuf_alloc_bulk(pkt_pool, pkts, BURST_SIZE) != 0) {
+			printf("Failed to allocate packets\n");
+			goto fail;
+		}
+		for (i = 0; i < BURST_SIZE; i++) {
+			if (build_packet(pkts[i], gro_perf_types[t].gro_type,
+					rte_rand_max(nb_flows)) != 0) {
+				printf("Failed to build %s packet\n",
+				       gro_perf_types[t].desc);
+				rte_pktmbuf_free_bulk(pkts, BURST_SIZE);
+				goto fail;
+			}
+		}
+
+		start = rte_rdtsc_precise();
+		n = rte_gro_reassemble(pkts, BURST_SIZE, ctx);
+		cycles += rte_rdtsc_precise() - start;
+
+		/* Packets which are not stored in the table */
+		rte_pktmbuf_free_bulk(pkts, n);
+		nb_out += n;
+		nb_in += BURST_SIZE;
+		nb_stored += BURST_SIZE - n;
+
+		/* Flush once each flow has got a few packets on average */
+		if (nb_stored >= (uint32_t)nb_flows * PKTS_PER_FLOW) {
+			nb_out += flush_all(ctx, gro_perf_types[t].gro_type,
+					&cycles);
+			nb_stored = 0;
+		}
+	}
+	nb_out += flush_all(ctx, gro_perf_types[t].gro_type, &cycles);
+
+	printf("| %-10s| %6u | %10.1f | %7.2f | %10.2f |\n",
+	       gro_perf_types[t].desc, nb_flows, (double)cycles / nb_in,
+	       (double)nb_in / nb_out,
+	       (double)nb_in * rte_get_tsc_hz() / cycles / 1E6);
+
+	rte_gro_ctx_destroy(ctx);
+
+	return TEST_SUCCESS;
+
+fail:
+	flush_all(ctx, gro_perf_types[t].gro_type, &cycles);
+	rte_gro_ctx_destroy(ctx);
+	return TEST_FAILED;
+}
+
+static int
+test_gro_perf(void)
+{
+	unsigned int f, t;
+	int ret = TEST_SUCCESS;
+
+	pkt_pool = rte_pktmbuf_pool_create("gro_perf_pool", NB_MBUFS,
+					   BURST_SIZE, 0, MBUF_DATA_SIZE,
+					   SOCKET_ID_ANY);
+	if (pkt_pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	printf("%u-byte payloads, %u packets in bursts of %u\n",
+	       PAYLOAD_LEN, NB_PKTS, BURST_SIZE);
+	printf("| %-10s| %6s | %10s | %7s | %10s |\n",
+	       "Type", "Flows", "Cycles/pkt", "Ratio", "Mpps");
+
+	for (t = 0; t < RTE_DIM(gro_perf_types); t++) {
+		for (f = 0; f < RTE_DIM(flow_nums); f++) {
+			ret = test_gro_perf_flows(t, flow_nums[f]);
+			if (ret != TEST_SUCCESS)
+				goto out;
+		}
+	}
+
+out:
+	rte_mempool_free(pkt_pool);
+
+	return ret;
+}
+
+REGISTER_PERF_TEST(gro_perf_autotest, test_gro_perf);
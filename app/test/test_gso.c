@@ -0,0 +1,614 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_geneve.h>
+#include <rte_gso.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "test.h"
+
+#define NB_MBUFS 1024
+#define MAX_SEGS_OUT 64
+#define MAX_PKT_LEN 2048
+#define GSO_SIZE 1400
+#define IP_DEFTTL 64
+
+#define TEST_SRC_PORT 1024
+#define TEST_DST_PORT 5201
+#define TEST_SEQ 0xfffff000
+#define TEST_IP_ID 0x1234
+#define TEST_VNI 0x123456
+
+/* Length of an IPv6 hop-by-hop options header with one PadN option */
+#define HOPOPTS_LEN 8
+
+enum test_tunnel {
+	TEST_TUNNEL_NONE,
+	TEST_TUNNEL_VXLAN6,
+	TEST_TUNNEL_GENEVE6,
+};
+
+/* Packet to segment */
+struct test_pkt {
+	enum test_tunnel tunnel;
+	bool inner_ipv4; /* IPv4 or IPv6 header of the L4 header. */
+	uint8_t proto;   /* IPPROTO_TCP or IPPROTO_UDP. */
+	bool hopopts;    /* IPv6 hop-by-hop options header. */
+	bool frag;       /* IPv6 fragment header. */
+};
+
+/* Payload sizes of the packets to segment, with a partial last segment */
+static const uint32_t payload_sizes[] = { 1500, 4000, 9000 };
+
+static struct rte_mempool *direct_pool;
+static struct rte_mempool *indirect_pool;
+
+/* the mbuf pools are set at setup */
+static struct rte_gso_ctx gso_ctx = {
+	.gso_types = RTE_ETH_TX_OFFLOAD_TCP_TSO |
+		RTE_ETH_TX_OFFLOAD_UDP_TSO |
+		RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO |
+		RTE_ETH_TX_OFFLOAD_GENEVE_TNL_TSO,
+	.gso_size = GSO_SIZE,
+	.flag = 0,
+};
+
+static void
+fill_ipv4_hdr(struct rte_ipv4_hdr *ip, uint8_t proto, uint16_t len)
+{
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(len);
+	ip->packet_id = rte_cpu_to_be_16(TEST_IP_ID);
+	ip->time_to_live = IP_DEFTTL;
+	ip->next_proto_id = proto;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 2));
+}
+
+static void
+fill_ipv6_hdr(struct rte_ipv6_hdr *ip, uint8_t proto, uint16_t len)
+{
+	ip->vtc_flow = rte_cpu_to_be_32(6 << 28);
+	ip->payload_len = rte_cpu_to_be_16(len - sizeof(*ip));
+	ip->proto = proto;
+	ip->hop_limits = IP_DEFTTL;
+	/* 2001:0200::/48 is reserved for IPv6 benchmarking (RFC5180) */
+	ip->src_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+	ip->dst_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 2);
+}
+
+static void
+fill_eth_hdr(struct rte_ether_hdr *eth, uint16_t ether_type)
+{
+	eth->ether_type = rte_cpu_to_be_16(ether_type);
+	eth->src_addr.addr_bytes[5] = 1;
+	eth->dst_addr.addr_bytes[5] = 2;
+}
+
+/*
+ * Write the IPv6 extension headers of the packet at ext, and return the
+ * protocol of the first one.
+ */
+static uint8_t
+fill_ipv6_ext(const struct test_pkt *t, uint8_t *ext)
+{
+	struct rte_ipv6_fragment_ext *frag;
+	uint8_t proto = t->proto;
+
+	if (t->frag) {
+		frag = (struct rte_ipv6_fragment_ext *)
+			(ext + (t->hopopts ? HOPOPTS_LEN : 0));
+		frag->next_header = proto;
+		frag->frag_data = rte_cpu_to_be_16(RTE_IPV6_SET_FRAG_DATA(0, 1));
+		frag->id = rte_cpu_to_be_32(TEST_IP_ID);
+		proto = IPPROTO_FRAGMENT;
+	}
+
+	if (t->hopopts) {
+		/* a PadN option filling the header */
+		ext[0] = proto;
+		ext[1] = 0;
+		ext[2] = 1;
+		ext[3] = HOPOPTS_LEN - 4;
+		proto = IPPROTO_HOPOPTS;
+	}
+
+	return proto;
+}
+
+/*
+ * Build the packet, with its headers in the first mbuf and the payload
+ * spread over the following ones, and set its Tx offload flags and
+ * header lengths.
+ */
+static struct rte_mbuf *
+build_packet(const struct test_pkt *t, uint32_t payload_len)
+{
+	struct rte_vxlan_hdr *vxlan;
+	struct rte_geneve_hdr *geneve;
+	struct rte_udp_hdr *udp;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m, *seg;
+	uint16_t ext_len, hdr_len, len, off;
+	uint32_t i, j, n;
+	uint8_t *hdr, *data, proto;
+
+	m = rte_pktmbuf_alloc(direct_pool);
+	if (m == NULL)
+		return NULL;
+
+	ext_len = (t->hopopts ? HOPOPTS_LEN : 0) +
+		(t->frag ? RTE_IPV6_FRAG_HDR_SIZE : 0);
+
+	m->l4_len = (t->proto == IPPROTO_TCP) ? sizeof(*tcp) : sizeof(*udp);
+	m->l3_len = t->inner_ipv4 ? sizeof(struct rte_ipv4_hdr) :
+		sizeof(struct rte_ipv6_hdr) + ext_len;
+	m->ol_flags = (t->inner_ipv4 ? RTE_MBUF_F_TX_IPV4 : RTE_MBUF_F_TX_IPV6) |
+		(t->proto == IPPROTO_TCP ? RTE_MBUF_F_TX_TCP_SEG :
+		 RTE_MBUF_F_TX_UDP_SEG);
+
+	if (t->tunnel != TEST_TUNNEL_NONE) {
+		m->outer_l2_len = sizeof(struct rte_ether_hdr);
+		m->outer_l3_len = sizeof(struct rte_ipv6_hdr);
+		m->l2_len = sizeof(*udp) + sizeof(struct rte_ether_hdr) +
+			(t->tunnel == TEST_TUNNEL_VXLAN6 ? sizeof(*vxlan) :
+			 sizeof(*geneve));
+		m->ol_flags |= RTE_MBUF_F_TX_OUTER_IPV6 |
+			(t->tunnel == TEST_TUNNEL_VXLAN6 ?
+			 RTE_MBUF_F_TX_TUNNEL_VXLAN :
+			 RTE_MBUF_F_TX_TUNNEL_GENEVE);
+	} else {
+		m->l2_len = sizeof(struct rte_ether_hdr);
+	}
+
+	hdr_len = m->outer_l2_len + m->outer_l3_len + m->l2_len + m->l3_len +
+		m->l4_len;
+	hdr = (uint8_t *)rte_pktmbuf_append(m, hdr_len);
+	if (hdr == NULL)
+		goto fail;
+	memset(hdr, 0, hdr_len);
+	len = hdr_len + payload_len;
+
+	off = 0;
+	if (t->tunnel != TEST_TUNNEL_NONE) {
+		fill_eth_hdr((void *)hdr, RTE_ETHER_TYPE_IPV6);
+		off += m->outer_l2_len;
+		fill_ipv6_hdr((void *)(hdr + off), IPPROTO_UDP, len - off);
+		off += m->outer_l3_len;
+
+		udp = (struct rte_udp_hdr *)(hdr + off);
+		udp->src_port = rte_cpu_to_be_16(TEST_SRC_PORT);
+		udp->dgram_len = rte_cpu_to_be_16(len - off);
+		off += sizeof(*udp);
+
+		if (t->tunnel == TEST_TUNNEL_VXLAN6) {
+			udp->dst_port = rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT);
+			vxlan = (struct rte_vxlan_hdr *)(hdr + off);
+			vxlan->vx_flags = rte_cpu_to_be_32(0x08000000);
+			vxlan->vx_vni = rte_cpu_to_be_32(TEST_VNI << 8);
+			off += sizeof(*vxlan);
+		} else {
+			udp->dst_port = rte_cpu_to_be_16(RTE_GENEVE_DEFAULT_PORT);
+			geneve = (struct rte_geneve_hdr *)(hdr + off);
+			geneve->proto = rte_cpu_to_be_16(RTE_GENEVE_TYPE_ETH);
+			geneve->vni[0] = (TEST_VNI >> 16) & 0xff;
+			geneve->vni[1] = (TEST_VNI >> 8) & 0xff;
+			geneve->vni[2] = TEST_VNI & 0xff;
+			off += sizeof(*geneve);
+		}
+	}
+
+	fill_eth_hdr((void *)(hdr + off), t->inner_ipv4 ?
+		RTE_ETHER_TYPE_IPV4 : RTE_ETHER_TYPE_IPV6);
+	off += sizeof(struct rte_ether_hdr);
+
+	if (t->inner_ipv4) {
+		fill_ipv4_hdr((void *)(hdr + off), t->proto, len - off);
+	} else {
+		proto = fill_ipv6_ext(t, hdr + off + sizeof(struct rte_ipv6_hdr));
+		fill_ipv6_hdr((void *)(hdr + off), proto, len - off);
+	}
+	off += m->l3_len;
+
+	if (t->proto == IPPROTO_TCP) {
+		tcp = (struct rte_tcp_hdr *)(hdr + off);
+		tcp->src_port = rte_cpu_to_be_16(TEST_SRC_PORT);
+		tcp->dst_port = rte_cpu_to_be_16(TEST_DST_PORT);
+		tcp->sent_seq = rte_cpu_to_be_32(TEST_SEQ);
+		tcp->data_off = (sizeof(*tcp) / 4) << 4;
+		tcp->tcp_flags = RTE_TCP_ACK_FLAG | RTE_TCP_PSH_FLAG |
+			RTE_TCP_FIN_FLAG;
+		tcp->rx_win = rte_cpu_to_be_16(UINT16_MAX);
+	} else {
+		udp = (struct rte_udp_hdr *)(hdr + off);
+		udp->src_port = rte_cpu_to_be_16(TEST_SRC_PORT);
+		udp->dst_port = rte_cpu_to_be_16(TEST_DST_PORT);
+		udp->dgram_len = rte_cpu_to_be_16(len - off);
+	}
+
+	/* a payload pattern which does not repeat on segment boundaries */
+	for (i = 0; i < payload_len; i += n) {
+		seg = rte_pktmbuf_alloc(direct_pool);
+		if (seg == NULL)
+			goto fail;
+		n = RTE_MIN(payload_len - i,
+			(uint32_t)rte_pktmbuf_tailroom(seg));
+		data = (uint8_t *)rte_pktmbuf_append(seg, n);
+		for (j = 0; j < n; j++)
+			data[j] = (i + j) * 7 + 1;
+		if (rte_pktmbuf_chain(m, seg) != 0) {
+			rte_pktmbuf_free(seg);
+			goto fail;
+		}
+	}
+
+	return m;
+
+fail:
+	rte_pktmbuf_free(m);
+	return NULL;
+}
+
+static void
+set_l4_cksum(void *l4, uint8_t proto, uint16_t cksum)
+{
+	if (proto == IPPROTO_TCP)
+		((struct rte_tcp_hdr *)l4)->cksum = cksum;
+	else
+		((struct rte_udp_hdr *)l4)->dgram_cksum = cksum;
+}
+
+/*
+ * Compute the L4 checksums of a segment as a checksum offload does,
+ * and verify them as the receiver does.
+ */
+static int
+check_segment_cksum(const struct rte_mbuf *pkt, bool inner_frag, uint8_t *seg)
+{
+	struct rte_ipv6_hdr *outer_ip6, *ip6;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_udp_hdr *outer_udp;
+	uint16_t ip_off, l4_off;
+	void *l4;
+
+	ip_off = pkt->outer_l2_len + pkt->outer_l3_len + pkt->l2_len;
+	l4_off = ip_off + pkt->l3_len;
+	l4 = seg + l4_off;
+
+	if (!inner_frag) {
+		if (pkt->ol_flags & RTE_MBUF_F_TX_IPV4) {
+			ip4 = (struct rte_ipv4_hdr *)(seg + ip_off);
+			set_l4_cksum(l4, ip4->next_proto_id, 0);
+			set_l4_cksum(l4, ip4->next_proto_id,
+				rte_ipv4_udptcp_cksum(ip4, l4));
+			TEST_ASSERT_SUCCESS(rte_ipv4_udptcp_cksum_verify(ip4, l4),
+				"Bad inner L4 checksum");
+		} else {
+			ip6 = (struct rte_ipv6_hdr *)(seg + ip_off);
+			set_l4_cksum(l4, ip6->proto, 0);
+			set_l4_cksum(l4, ip6->proto,
+				rte_ipv6_udptcp_cksum(ip6, l4));
+			TEST_ASSERT_SUCCESS(rte_ipv6_udptcp_cksum_verify(ip6, l4),
+				"Bad L4 checksum");
+		}
+	}
+
+	if (pkt->outer_l3_len != 0) {
+		outer_ip6 = (struct rte_ipv6_hdr *)(seg + pkt->outer_l2_len);
+		outer_udp = (struct rte_udp_hdr *)(outer_ip6 + 1);
+		outer_udp->dgram_cksum = 0;
+		outer_udp->dgram_cksum = rte_ipv6_udptcp_cksum(outer_ip6,
+			outer_udp);
+		TEST_ASSERT_SUCCESS(rte_ipv6_udptcp_cksum_verify(outer_ip6,
+			outer_udp), "Bad outer UDP checksum");
+	}
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Check the segments of a packet: each one must have the headers of the
+ * packet with updated lengths, sequence number, IPv4 ID and fragment
+ * offset, followed by the next bytes of the payload.
+ */
+static int
+check_segments(const struct test_pkt *t, const struct rte_mbuf *pkt,
+	const uint8_t *orig, struct rte_mbuf **segs, int nb_segs)
+{
+	static uint8_t seg[MAX_PKT_LEN];
+	static uint8_t exp[MAX_PKT_LEN];
+	const void *data;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_udp_hdr *udp;
+	struct rte_tcp_hdr *tcp;
+	uint16_t ip_off, l4_off, hdr_len, unit, len;
+	uint32_t off, payload_len;
+	bool inner_frag;
+	int i;
+
+	/* inner UDP/IPv4 packets of a tunnel are split into IP fragments */
+	inner_frag = t->tunnel != TEST_TUNNEL_NONE && t->inner_ipv4 &&
+		t->proto == IPPROTO_UDP;
+
+	ip_off = pkt->outer_l2_len + pkt->outer_l3_len + pkt->l2_len;
+	l4_off = ip_off + pkt->l3_len;
+	hdr_len = inner_frag ? l4_off : l4_off + pkt->l4_len;
+	unit = GSO_SIZE - hdr_len;
+	if (inner_frag)
+		unit &= ~7U;
+	payload_len = pkt->pkt_len - hdr_len;
+
+	TEST_ASSERT_EQUAL(nb_segs, (int)((payload_len + unit - 1) / unit),
+		"Wrong number of segments: %d", nb_segs);
+
+	for (i = 0, off = 0; i < nb_segs; i++, off += len) {
+
+		len = RTE_MIN(payload_len - off, (uint32_t)unit);
+		TEST_ASSERT_EQUAL(segs[i]->pkt_len, (uint32_t)hdr_len + len,
+			"Wrong length of segment %d: %u", i, segs[i]->pkt_len);
+		data = rte_pktmbuf_read(segs[i], 0, segs[i]->pkt_len, seg);
+		TEST_ASSERT_NOT_NULL(data, "Cannot read segment %d", i);
+		/* the checksums are written in a copy */
+		if (data != seg)
+			memcpy(seg, data, segs[i]->pkt_len);
+
+		TEST_ASSERT_BUFFERS_ARE_EQUAL(seg + hdr_len,
+			orig + hdr_len + off, len,
+			"Wrong payload in segment %d", i);
+
+		/* the expected headers */
+		memcpy(exp, orig, hdr_len);
+		if (t->tunnel != TEST_TUNNEL_NONE) {
+			ip6 = (struct rte_ipv6_hdr *)(exp + pkt->outer_l2_len);
+			ip6->payload_len = rte_cpu_to_be_16(hdr_len + len -
+				pkt->outer_l2_len - sizeof(*ip6));
+			udp = (struct rte_udp_hdr *)(ip6 + 1);
+			udp->dgram_len = rte_cpu_to_be_16(hdr_len + len -
+				pkt->outer_l2_len - pkt->outer_l3_len);
+		}
+
+		if (t->inner_ipv4) {
+			ip4 = (struct rte_ipv4_hdr *)(exp + ip_off);
+			ip4->total_length = rte_cpu_to_be_16(hdr_len + len -
+				ip_off);
+			if (inner_frag)
+				ip4->fragment_offset = rte_cpu_to_be_16(
+					(off >> 3) | (i < nb_segs - 1 ?
+					RTE_IPV4_HDR_MF_FLAG : 0));
+			else
+				ip4->packet_id = rte_cpu_to_be_16(TEST_IP_ID + i);
+		} else {
+			ip6 = (struct rte_ipv6_hdr *)(exp + ip_off);
+			ip6->payload_len = rte_cpu_to_be_16(hdr_len + len -
+				ip_off - sizeof(*ip6));
+		}
+
+		if (t->proto == IPPROTO_TCP) {
+			tcp = (struct rte_tcp_hdr *)(exp + l4_off);
+			tcp->sent_seq = rte_cpu_to_be_32(TEST_SEQ + off);
+			if (i < nb_segs - 1)
+				tcp->tcp_flags &= ~(RTE_TCP_PSH_FLAG |
+					RTE_TCP_FIN_FLAG);
+		} else if (!inner_frag) {
+			udp = (struct rte_udp_hdr *)(exp + l4_off);
+			udp->dgram_len = rte_cpu_to_be_16(hdr_len + len -
+				l4_off);
+		}
+
+		TEST_ASSERT_BUFFERS_ARE_EQUAL(seg, exp, hdr_len,
+			"Wrong headers in segment %d", i);
+
+		/* the checksum helpers do not skip extension headers */
+		if (!t->hopopts && check_segment_cksum(pkt, inner_frag,
+				seg) != TEST_SUCCESS)
+			return TEST_FAILED;
+	}
+
+	TEST_ASSERT_EQUAL(off, payload_len, "Payload not fully segmented");
+
+	return TEST_SUCCESS;
+}
+
+/* Segment a packet of each payload size, and check the segments. */
+static int
+segment_check(const struct test_pkt *t)
+{
+	static uint8_t buf[UINT16_MAX];
+	struct rte_mbuf *segs[MAX_SEGS_OUT];
+	struct rte_mbuf *pkt;
+	const uint8_t *orig;
+	unsigned int s;
+	int i, nb_segs, ret;
+
+	for (s = 0; s < RTE_DIM(payload_sizes); s++) {
+
+		pkt = build_packet(t, payload_sizes[s]);
+		TEST_ASSERT_NOT_NULL(pkt, "Cannot build packet");
+
+		/* the input packet is left unchanged by the segmentation */
+		orig = rte_pktmbuf_read(pkt, 0, pkt->pkt_len, buf);
+
+		nb_segs = rte_gso_segment(pkt, &gso_ctx, segs, RTE_DIM(segs));
+		if (nb_segs > 0) {
+			ret = check_segments(t, pkt, orig, segs, nb_segs);
+			for (i = 0; i < nb_segs; i++)
+				rte_pktmbuf_free(segs[i]);
+		} else {
+			printf("Packet not segmented: %d\n", nb_segs);
+			ret = TEST_FAILED;
+		}
+		rte_pktmbuf_free(pkt);
+
+		TEST_ASSERT_SUCCESS(ret, "Packet of %u payload bytes",
+			payload_sizes[s]);
+	}
+
+	return TEST_SUCCESS;
+}
+
+/* A fragment is not segmented, whatever extension headers precede it. */
+static int
+fragment_check(const struct test_pkt *t)
+{
+	struct rte_mbuf *segs[MAX_SEGS_OUT];
+	struct rte_mbuf *pkt;
+	int ret;
+
+	pkt = build_packet(t, payload_sizes[RTE_DIM(payload_sizes) - 1]);
+	TEST_ASSERT_NOT_NULL(pkt, "Cannot build packet");
+
+	ret = rte_gso_segment(pkt, &gso_ctx, segs, RTE_DIM(segs));
+	rte_pktmbuf_free(pkt);
+	TEST_ASSERT_EQUAL(ret, 0, "IPv6 fragment segmented: %d", ret);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gso_tcp6(void)
+{
+	const struct test_pkt t = { .proto = IPPROTO_TCP };
+
+	return segment_check(&t);
+}
+
+static int
+test_gso_udp6(void)
+{
+	const struct test_pkt t = { .proto = IPPROTO_UDP };
+
+	return segment_check(&t);
+}
+
+static int
+test_gso_tunnel_tcp6(void)
+{
+	const struct test_pkt t[] = {
+		{ .tunnel = TEST_TUNNEL_VXLAN6, .proto = IPPROTO_TCP },
+		{ .tunnel = TEST_TUNNEL_VXLAN6, .inner_ipv4 = true,
+		  .proto = IPPROTO_TCP },
+		{ .tunnel = TEST_TUNNEL_GENEVE6, .proto = IPPROTO_TCP },
+	};
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(t); i++)
+		TEST_ASSERT_SUCCESS(segment_check(&t[i]),
+			"Tunnel TCP packet type %u", i);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gso_tunnel_udp6(void)
+{
+	const struct test_pkt t[] = {
+		{ .tunnel = TEST_TUNNEL_VXLAN6, .proto = IPPROTO_UDP },
+		{ .tunnel = TEST_TUNNEL_VXLAN6, .inner_ipv4 = true,
+		  .proto = IPPROTO_UDP },
+		{ .tunnel = TEST_TUNNEL_GENEVE6, .proto = IPPROTO_UDP },
+	};
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(t); i++)
+		TEST_ASSERT_SUCCESS(segment_check(&t[i]),
+			"Tunnel UDP packet type %u", i);
+
+	return TEST_SUCCESS;
+}
+
+/* Extension headers are segmented, unless one is a fragment header. */
+static int
+test_gso_ipv6_ext(void)
+{
+	const struct test_pkt ext[] = {
+		{ .proto = IPPROTO_TCP, .hopopts = true },
+		{ .proto = IPPROTO_UDP, .hopopts = true },
+		{ .tunnel = TEST_TUNNEL_VXLAN6, .proto = IPPROTO_TCP,
+		  .hopopts = true },
+	};
+	const struct test_pkt frag[] = {
+		{ .proto = IPPROTO_TCP, .frag = true },
+		{ .proto = IPPROTO_TCP, .hopopts = true, .frag = true },
+		{ .proto = IPPROTO_UDP, .hopopts = true, .frag = true },
+		{ .tunnel = TEST_TUNNEL_VXLAN6, .proto = IPPROTO_TCP,
+		  .hopopts = true, .frag = true },
+		{ .tunnel = TEST_TUNNEL_GENEVE6, .proto = IPPROTO_UDP,
+		  .hopopts = true, .frag = true },
+	};
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(ext); i++)
+		TEST_ASSERT_SUCCESS(segment_check(&ext[i]),
+			"Extension headers packet type %u", i);
+
+	for (i = 0; i < RTE_DIM(frag); i++)
+		TEST_ASSERT_SUCCESS(fragment_check(&frag[i]),
+			"Fragment packet type %u", i);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gso_setup(void)
+{
+	direct_pool = rte_pktmbuf_pool_create("gso_test_direct", NB_MBUFS, 0,
+					      0, RTE_MBUF_DEFAULT_BUF_SIZE,
+					      SOCKET_ID_ANY);
+	indirect_pool = rte_pktmbuf_pool_create("gso_test_indirect", NB_MBUFS,
+						0, 0, 0, SOCKET_ID_ANY);
+	if (direct_pool == NULL || indirect_pool == NULL) {
+		printf("Failed to create mbuf pools\n");
+		rte_mempool_free(indirect_pool);
+		rte_mempool_free(direct_pool);
+		return TEST_FAILED;
+	}
+
+	gso_ctx.direct_pool = direct_pool;
+	gso_ctx.indirect_pool = indirect_pool;
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_gso_teardown(void)
+{
+	rte_mempool_free(indirect_pool);
+	rte_mempool_free(direct_pool);
+	indirect_pool = NULL;
+	direct_pool = NULL;
+}
+
+static struct unit_test_suite gso_testsuite = {
+	.suite_name = "GSO autotest",
+	.setup = test_gso_setup,
+	.teardown = test_gso_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_gso_tcp6),
+		TEST_CASE(test_gso_udp6),
+		TEST_CASE(test_gso_tunnel_tcp6),
+		TEST_CASE(test_gso_tunnel_udp6),
+		TEST_CASE(test_gso_ipv6_ext),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_gso(void)
+{
+	return unit_test_suite_runner(&gso_testsuite);
+}
+
+REGISTER_FAST_TEST(gso_autotest, NOHUGE_OK, ASAN_OK, test_gso);
@@ -0,0 +1,301 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_gso.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#include "test.h"
+
+#define NB_MBUFS 8192
+#define MAX_SEGS_OUT 128
+#define ITERATIONS 20000
+#define GSO_SIZE 1514
+
+#define VXLAN_HDR_LEN 8
+#define GENEVE_HDR_LEN 8
+#define IP_DEFTTL 64
+
+enum gso_perf_type {
+	GSO_PERF_TCP4,
+	GSO_PERF_TCP6,
+	GSO_PERF_UDP4,
+	GSO_PERF_UDP6,
+	GSO_PERF_VXLAN4_TCP4,
+	GSO_PERF_VXLAN6_TCP4,
+	GSO_PERF_VXLAN6_TCP6,
+	GSO_PERF_GENEVE6_TCP6,
+};
+
+static const struct {
+	const char *desc;
+	enum gso_perf_type type;
+} gso_perf_types[] = {
+	{ "TCP/IPv4", GSO_PERF_TCP4 },
+	{ "TCP/IPv6", GSO_PERF_TCP6 },
+	{ "UDP/IPv4", GSO_PERF_UDP4 },
+	{ "UDP/IPv6", GSO_PERF_UDP6 },
+	{ "VXLAN/IPv4 TCP/IPv4", GSO_PERF_VXLAN4_TCP4 },
+	{ "VXLAN/IPv6 TCP/IPv4", GSO_PERF_VXLAN6_TCP4 },
+	{ "VXLAN/IPv6 TCP/IPv6", GSO_PERF_VXLAN6_TCP6 },
+	{ "GENEVE/IPv6 TCP/IPv6", GSO_PERF_GENEVE6_TCP6 },
+};
+
+/* Payload sizes of the packets to segment */
+static const uint32_t payload_sizes[] = { 4096, 16384, 65000 };
+
+static struct rte_mempool *direct_pool;
+static struct rte_mempool *indirect_pool;
+
+static void
+fill_ipv4_hdr(struct rte_ipv4_hdr *ip, uint8_t proto)
+{
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->time_to_live = IP_DEFTTL;
+	ip->next_proto_id = proto;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 2));
+}
+
+static void
+fill_ipv6_hdr(struct rte_ipv6_hdr *ip, uint8_t proto)
+{
+	ip->vtc_flow = rte_cpu_to_be_32(6 << 28);
+	ip->proto = proto;
+	ip->hop_limits = IP_DEFTTL;
+	/* 2001:0200::/48 is reserved for IPv6 benchmarking (RFC5180) */
+	ip->src_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 1);
+	ip->dst_addr = (struct rte_ipv6_addr)RTE_IPV6(0x2001, 0x0200, 0, 0, 0, 0, 0, 2);
+}
+
+/*
+ * Build the headers of a packet of the given type at the start of m, and
+ * set the matching Tx offload flags and header lengths.
+ */
+static void
+build_headers(struct rte_mbuf *m, enum gso_perf_type type)
+{
+	bool inner_ipv4, outer_ipv4 = false, udp = false;
+	uint16_t tunnel_len = 0, off = 0;
+	struct rte_tcp_hdr *tcp;
+	char *hdr;
+
+	inner_ipv4 = type == GSO_PERF_TCP4 || type == GSO_PERF_UDP4 ||
+		type == GSO_PERF_VXLAN4_TCP4 || type == GSO_PERF_VXLAN6_TCP4;
+	udp = type == GSO_PERF_UDP4 || type == GSO_PERF_UDP6;
+
+	switch (type) {
+	case GSO_PERF_VXLAN4_TCP4:
+		outer_ipv4 = true;
+		/* fallthrough */
+	case GSO_PERF_VXLAN6_TCP4:
+	case GSO_PERF_VXLAN6_TCP6:
+		tunnel_len = VXLAN_HDR_LEN;
+		m->ol_flags = RTE_MBUF_F_TX_TUNNEL_VXLAN;
+		break;
+	case GSO_PERF_GENEVE6_TCP6:
+		tunnel_len = GENEVE_HDR_LEN;
+		m->ol_flags = RTE_MBUF_F_TX_TUNNEL_GENEVE;
+		break;
+	default:
+		m->ol_flags = 0;
+		break;
+	}
+
+	hdr = rte_pktmbuf_mtod(m, char *);
+	memset(hdr, 0, m->data_len);
+
+	if (tunnel_len != 0) {
+		m->outer_l2_len = sizeof(struct rte_ether_hdr);
+		if (outer_ipv4) {
+			fill_ipv4_hdr((void *)(hdr + m->outer_l2_len), IPPROTO_UDP);
+			m->outer_l3_len = sizeof(struct rte_ipv4_hdr);
+			m->ol_flags |= RTE_MBUF_F_TX_OUTER_IPV4;
+		} else {
+			fill_ipv6_hdr((void *)(hdr + m->outer_l2_len), IPPROTO_UDP);
+			m->outer_l3_len = sizeof(struct rte_ipv6_hdr);
+			m->ol_flags |= RTE_MBUF_F_TX_OUTER_IPV6;
+		}
+		off = m->outer_l2_len + m->outer_l3_len;
+		m->l2_len = sizeof(struct rte_udp_hdr) + tunnel_len +
+			sizeof(struct rte_ether_hdr);
+	} else {
+		m->outer_l2_len = 0;
+		m->outer_l3_len = 0;
+		m->l2_len = sizeof(struct rte_ether_hdr);
+	}
+
+	off += m->l2_len;
+	if (inner_ipv4) {
+		fill_ipv4_hdr((void *)(hdr + off),
+			      udp ? IPPROTO_UDP : IPPROTO_TCP);
+		m->l3_len = sizeof(struct rte_ipv4_hdr);
+		m->ol_flags |= RTE_MBUF_F_TX_IPV4;
+	} else {
+		fill_ipv6_hdr((void *)(hdr + off),
+			      udp ? IPPROTO_UDP : IPPROTO_TCP);
+		m->l3_len = sizeof(struct rte_ipv6_hdr);
+		m->ol_flags |= RTE_MBUF_F_TX_IPV6;
+	}
+
+	off += m->l3_len;
+	if (udp) {
+		m->l4_len = sizeof(struct rte_udp_hdr);
+		m->ol_flags |= RTE_MBUF_F_TX_UDP_SEG;
+	} else {
+		tcp = (struct rte_tcp_hdr *)(hdr + off);
+		tcp->data_off = (sizeof(struct rte_tcp_hdr) / 4) << 4;
+		tcp->tcp_flags = RTE_TCP_ACK_FLAG | RTE_TCP_PSH_FLAG;
+		m->l4_len = sizeof(struct rte_tcp_hdr);
+		m->ol_flags |= RTE_MBUF_F_TX_TCP_SEG;
+	}
+}
+
+/* Build a multi-segment packet, as received from a virtio device. */
+static struct rte_mbuf *
+build_packet(enum gso_perf_type type, uint32_t payload_len)
+{
+	struct rte_mbuf *m, *seg;
+	uint16_t hdr_len, len;
+
+	m = rte_pktmbuf_alloc(direct_pool);
+	if (m == NULL)
+		return NULL;
+
+	/* the headers of the longest packet type */
+	if (rte_pktmbuf_append(m, 256) == NULL)
+		goto fail;
+	build_headers(m, type);
+	hdr_len = m->outer_l2_len + m->outer_l3_len + m->l2_len + m->l3_len +
+		m->l4_len;
+	rte_pktmbuf_trim(m, m->data_len - hdr_len);
+
+	while (payload_len > 0) {
+		seg = rte_pktmbuf_alloc(direct_pool);
+		if (seg == NULL)
+			goto fail;
+		len = RTE_MIN(payload_len, rte_pktmbuf_tailroom(seg));
+		memset(rte_pktmbuf_append(seg, len), 0xa5, len);
+		if (rte_pktmbuf_chain(m, seg) != 0) {
+			rte_pktmbuf_free(seg);
+			goto fail;
+		}
+		payload_len -= len;
+	}
+
+	return m;
+
+fail:
+	rte_pktmbuf_free(m);
+	return NULL;
+}
+
+static int
+test_gso_perf_type(unsigned int t, uint32_t payload_len)
+{
+	struct rte_mbuf *segs[MAX_SEGS_OUT];
+	struct rte_gso_ctx ctx = {
+		.direct_pool = direct_pool,
+		.indirect_pool = indirect_pool,
+		.flag = 0,
+		.gso_types = RTE_ETH_TX_OFFLOAD_TCP_TSO |
+			RTE_ETH_TX_OFFLOAD_UDP_TSO |
+			RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO |
+			RTE_ETH_TX_OFFLOAD_GENEVE_TNL_TSO,
+		.gso_size = GSO_SIZE,
+	};
+	uint64_t start, cycles = 0, nb_segs = 0;
+	struct rte_mbuf *pkt;
+	uint64_t ol_flags;
+	unsigned int i;
+	int ret, j;
+
+	pkt = build_packet(gso_perf_types[t].type, payload_len);
+	if (pkt == NULL) {
+		printf("Failed to build %s packet\n", gso_perf_types[t].desc);
+		return TEST_FAILED;
+	}
+	ol_flags = pkt->ol_flags;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		/* rte_gso_segment() clears the segmentation flags */
+		pkt->ol_flags = ol_flags;
+
+		start = rte_rdtsc_precise();
+		ret = rte_gso_segment(pkt, &ctx, segs, MAX_SEGS_OUT);
+		cycles += rte_rdtsc_precise() - start;
+
+		if (ret <= 0) {
+			printf("Failed to segment %s packet: %d\n",
+			       gso_perf_types[t].desc, ret);
+			rte_pktmbuf_free(pkt);
+			return TEST_FAILED;
+		}
+		nb_segs += ret;
+
+		for (j = 0; j < ret; j++)
+			rte_pktmbuf_free(segs[j]);
+	}
+
+	printf("| %-22s| %8u | %8u | %12.1f | %11.1f | %10.2f |\n",
+	       gso_perf_types[t].desc, pkt->pkt_len,
+	       (unsigned int)(nb_segs / ITERATIONS),
+	       (double)cycles / ITERATIONS, (double)cycles / nb_segs,
+	       (double)pkt->pkt_len * CHAR_BIT * ITERATIONS *
+	       rte_get_tsc_hz() / cycles / 1E9);
+
+	rte_pktmbuf_free(pkt);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gso_perf(void)
+{
+	unsigned int s, t;
+	int ret = TEST_SUCCESS;
+
+	direct_pool = rte_pktmbuf_pool_create("gso_perf_direct", NB_MBUFS, 0,
+					      0, RTE_MBUF_DEFAULT_BUF_SIZE,
+					      SOCKET_ID_ANY);
+	indirect_pool = rte_pktmbuf_pool_create("gso_perf_indirect", NB_MBUFS,
+						0, 0, 0, SOCKET_ID_ANY);
+	if (direct_pool == NULL || indirect_pool == NULL) {
+		printf("Failed to create mbuf pools\n");
+		ret = TEST_FAILED;
+		goto out;
+	}
+
+	printf("Segment size %u bytes, average of %u packets\n",
+	       GSO_SIZE, ITERATIONS);
+	printf("| %-22s| %8s | %8s | %12s | %11s | %10s |\n",
+	       "Packet type", "Length", "Segments", "Cycles/pkt",
+	       "Cycles/seg", "Gbit/s");
+
+	for (s = 0; s < RTE_DIM(payload_sizes); s++) {
+		for (t = 0; t < RTE_DIM(gso_perf_types); t++) {
+			ret = test_gso_perf_type(t, payload_sizes[s]);
+			if (ret != TEST_SUCCESS)
+				goto out;
+		}
+	}
+
+out:
+	rte_mempool_free(indirect_pool);
+	rte_mempool_free(direct_pool);
+
+	return ret;
+}
+
+REGISTER_PERF_TEST(gso_perf_autotest, test_gso_perf);
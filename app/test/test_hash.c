@@ -1061,6 +1061,185 @@ static int test_extendable_bucket(void)
 	return 0;
 }
 
+/*
+ * Resize a table while it is in use:
+ * - Grow a table holding keys, check lookups while buckets are migrated
+ * - Add and delete keys in the middle of the migration
+ * - Shrink the table back and check all the keys are still found
+ */
+#define RESIZE_TEST_KEYS 512
+static int test_hash_resize(void)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_resize",
+		.entries = RESIZE_TEST_KEYS * 2,
+		.key_len = sizeof(uint32_t),
+		.hash_func = NULL,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+	};
+	struct rte_hash *handle;
+	uint32_t resize_keys[RESIZE_TEST_KEYS * 4];
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
+	unsigned int i, j;
+	int ret;
+
+	for (i = 0; i < RTE_DIM(resize_keys); i++)
+		resize_keys[i] = i;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < RESIZE_TEST_KEYS; i++) {
+		ret = rte_hash_add_key(handle, &resize_keys[i]);
+		RETURN_IF_ERROR(ret < 0, "failed to add key %u", i);
+	}
+
+	ret = rte_hash_resize(handle, RESIZE_TEST_KEYS / 2);
+	RETURN_IF_ERROR(ret != -ENOSPC,
+			"resize below the number of keys should fail");
+
+	/* Grow the table, migrating only a few buckets */
+	ret = rte_hash_resize(handle, RESIZE_TEST_KEYS * 8);
+	RETURN_IF_ERROR(ret != 0, "failed to start growing table");
+	ret = rte_hash_resize(handle, RESIZE_TEST_KEYS * 4);
+	RETURN_IF_ERROR(ret != -EBUSY,
+			"resize should fail while one is in progress");
+	ret = rte_hash_resize_step(handle, 16);
+	RETURN_IF_ERROR(ret <= 0, "resize completed too early (%d)", ret);
+
+	for (i = 0; i < RESIZE_TEST_KEYS; i++) {
+		ret = rte_hash_lookup(handle, &resize_keys[i]);
+		RETURN_IF_ERROR(ret < 0,
+			"failed to find key %u during migration", i);
+	}
+	for (i = 0; i < RESIZE_TEST_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++)
+			key_ptrs[j] = &resize_keys[i + j];
+		ret = rte_hash_lookup_bulk(handle, key_ptrs,
+				RTE_HASH_LOOKUP_BULK_MAX, positions);
+		RETURN_IF_ERROR(ret != 0, "bulk lookup failed");
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++)
+			RETURN_IF_ERROR(positions[j] < 0,
+				"failed to bulk find key %u during migration",
+				i + j);
+	}
+
+	/* Update the table while buckets are being migrated */
+	for (i = RESIZE_TEST_KEYS; i < RESIZE_TEST_KEYS * 4; i++) {
+		ret = rte_hash_add_key(handle, &resize_keys[i]);
+		RETURN_IF_ERROR(ret < 0, "failed to add key %u", i);
+	}
+	for (i = 0; i < RESIZE_TEST_KEYS * 4; i += 2) {
+		ret = rte_hash_del_key(handle, &resize_keys[i]);
+		RETURN_IF_ERROR(ret < 0, "failed to delete key %u", i);
+	}
+
+	do {
+		ret = rte_hash_resize_step(handle, 64);
+	} while (ret > 0);
+	RETURN_IF_ERROR(ret != 0, "failed to complete growing table (%d)", ret);
+	RETURN_IF_ERROR(rte_hash_max_key_id(handle) < RESIZE_TEST_KEYS * 8,
+			"table capacity not increased");
+	RETURN_IF_ERROR(rte_hash_count(handle) != RESIZE_TEST_KEYS * 2,
+			"wrong number of keys after growing table");
+
+	/* Shrink the table back */
+	ret = rte_hash_resize(handle, RESIZE_TEST_KEYS * 3);
+	RETURN_IF_ERROR(ret != 0, "failed to start shrinking table");
+	for (i = 0; i < RESIZE_TEST_KEYS * 4; i++) {
+		ret = rte_hash_lookup(handle, &resize_keys[i]);
+		RETURN_IF_ERROR((i & 1) ? ret < 0 : ret != -ENOENT,
+			"wrong lookup result for key %u during migration", i);
+	}
+	do {
+		ret = rte_hash_resize_step(handle, 64);
+	} while (ret > 0);
+	RETURN_IF_ERROR(ret != 0, "failed to complete shrinking table (%d)",
+			ret);
+	RETURN_IF_ERROR(rte_hash_count(handle) != RESIZE_TEST_KEYS * 2,
+			"wrong number of keys after shrinking table");
+
+	for (i = 0; i < RESIZE_TEST_KEYS * 4; i++) {
+		ret = rte_hash_lookup(handle, &resize_keys[i]);
+		RETURN_IF_ERROR((i & 1) ? ret < 0 : ret != -ENOENT,
+			"wrong lookup result for key %u after shrinking", i);
+		RETURN_IF_ERROR((i & 1) &&
+				ret >= rte_hash_max_key_id(handle),
+			"key %u beyond table capacity", i);
+	}
+
+	rte_hash_free(handle);
+	return 0;
+}
+
+/*
+ * Pipelined bulk lookup:
+ * - Add half of the keys, then look up all of them with every group size
+ * - Check hits and data match the regular bulk lookup
+ */
+#define PIPELINE_TEST_KEYS 256
+static int test_hash_lookup_pipeline(void)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_pipeline",
+		.entries = PIPELINE_TEST_KEYS,
+		.key_len = sizeof(uint32_t),
+		.hash_func = NULL,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+	};
+	struct rte_hash *handle;
+	uint32_t pipeline_keys[PIPELINE_TEST_KEYS];
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	void *expected_data[RTE_HASH_LOOKUP_BULK_MAX];
+	uint64_t hit_mask, expected_hit_mask;
+	unsigned int i, j, group_size;
+	int ret, expected;
+
+	for (i = 0; i < RTE_DIM(pipeline_keys); i++)
+		pipeline_keys[i] = i * 7;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < PIPELINE_TEST_KEYS; i += 2) {
+		ret = rte_hash_add_key_data(handle, &pipeline_keys[i],
+				(void *)(uintptr_t)(i + 1));
+		RETURN_IF_ERROR(ret < 0, "failed to add key %u", i);
+	}
+
+	for (i = 0; i < PIPELINE_TEST_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++)
+			key_ptrs[j] = &pipeline_keys[i + j];
+		expected = rte_hash_lookup_bulk_data(handle, key_ptrs,
+				RTE_HASH_LOOKUP_BULK_MAX, &expected_hit_mask,
+				expected_data);
+		RETURN_IF_ERROR(expected != RTE_HASH_LOOKUP_BULK_MAX / 2,
+				"bulk lookup found %d keys", expected);
+
+		for (group_size = 0; group_size <= RTE_HASH_LOOKUP_BULK_MAX;
+				group_size++) {
+			ret = rte_hash_lookup_bulk_data_pipeline(handle,
+					key_ptrs, RTE_HASH_LOOKUP_BULK_MAX,
+					group_size, &hit_mask, data);
+			RETURN_IF_ERROR(ret != expected ||
+					hit_mask != expected_hit_mask,
+				"pipelined lookup with group size %u found %d keys",
+				group_size, ret);
+			for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++)
+				RETURN_IF_ERROR((hit_mask & (1ULL << j)) &&
+						data[j] != expected_data[j],
+					"wrong data for key %u", i + j);
+		}
+	}
+
+	rte_hash_free(handle);
+	return 0;
+}
+
 /******************************************************************************/
 static int
 fbk_hash_unit_test(void)
@@ -2558,6 +2737,178 @@ test_hash_rcu_qsbr_replace_auto_free(void)
 	return ret;
 }
 
+#define RESIZE_RCU_STABLE_KEYS 256
+#define RESIZE_RCU_CHURN_KEYS 512
+#define RESIZE_RCU_ROUNDS 4
+static uint32_t resize_rcu_keys[RESIZE_RCU_STABLE_KEYS + RESIZE_RCU_CHURN_KEYS];
+static volatile uint8_t resize_rcu_reader_failed;
+
+/*
+ * Reader thread of the resize test, which looks up keys never deleted by
+ * the writer and keys it keeps adding and deleting.
+ */
+static int
+test_hash_resize_rcu_reader(void *arg)
+{
+	unsigned int i;
+
+	RTE_SET_USED(arg);
+	(void)rte_rcu_qsbr_thread_register(g_qsv, 0);
+	rte_rcu_qsbr_thread_online(g_qsv, 0);
+
+	do {
+		for (i = 0; i < RTE_DIM(resize_rcu_keys); i++) {
+			if (rte_hash_lookup(g_handle, &resize_rcu_keys[i]) < 0 &&
+					i < RESIZE_RCU_STABLE_KEYS)
+				resize_rcu_reader_failed = 1;
+		}
+
+		rte_rcu_qsbr_quiescent(g_qsv, 0);
+	} while (!writer_done);
+
+	rte_rcu_qsbr_thread_offline(g_qsv, 0);
+	(void)rte_rcu_qsbr_thread_unregister(g_qsv, 0);
+
+	return 0;
+}
+
+/*
+ * Resize a lock free table with RCU in defer queue mode:
+ * - A reader thread keeps looking up keys while the table is resized
+ * - The writer deletes and adds keys while buckets are migrated, so that
+ *   keys stored in retired slots are pending in the defer queue when a
+ *   shrink completes
+ */
+static int
+test_hash_resize_rcu_dq(void)
+{
+	struct rte_hash_parameters params = {
+		.name = "test_resize_rcu_dq",
+		.entries = RESIZE_RCU_STABLE_KEYS + RESIZE_RCU_CHURN_KEYS,
+		.key_len = sizeof(uint32_t),
+		.hash_func = NULL,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF,
+	};
+	struct rte_hash_rcu_config rcu_cfg = {0};
+	uint8_t present[RESIZE_RCU_CHURN_KEYS];
+	unsigned int i, round, next = 0, reader_lcore;
+	uint32_t *churn_key;
+	int ret = -1, step;
+	size_t sz;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough lcores for resize RCU test\n");
+		return TEST_SKIPPED;
+	}
+
+	printf("\n# Running resize test with RCU QSBR DQ mode\n");
+
+	for (i = 0; i < RTE_DIM(resize_rcu_keys); i++)
+		resize_rcu_keys[i] = i;
+	resize_rcu_reader_failed = 0;
+	writer_done = 0;
+	reader_lcore = RTE_MAX_LCORE;
+
+	g_handle = rte_hash_create(&params);
+	sz = rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE);
+	g_qsv = rte_zmalloc_socket(NULL, sz, RTE_CACHE_LINE_SIZE,
+			SOCKET_ID_ANY);
+	if (g_handle == NULL || g_qsv == NULL ||
+			rte_rcu_qsbr_init(g_qsv, RTE_MAX_LCORE) != 0) {
+		printf("hash or RCU QSBR variable creation failed\n");
+		goto end;
+	}
+
+	rcu_cfg.v = g_qsv;
+	rcu_cfg.mode = RTE_HASH_QSBR_MODE_DQ;
+	if (rte_hash_rcu_qsbr_add(g_handle, &rcu_cfg) != 0) {
+		printf("Attach RCU QSBR to hash table failed\n");
+		goto end;
+	}
+
+	/* Add the stable keys and half of the others */
+	for (i = 0; i < RTE_DIM(resize_rcu_keys); i++) {
+		if (i >= RESIZE_RCU_STABLE_KEYS) {
+			present[i - RESIZE_RCU_STABLE_KEYS] = i & 1;
+			if ((i & 1) == 0)
+				continue;
+		}
+		if (rte_hash_add_key(g_handle, &resize_rcu_keys[i]) < 0) {
+			printf("failed to add key %u\n", i);
+			goto end;
+		}
+	}
+
+	reader_lcore = rte_get_next_lcore(-1, 1, 0);
+	rte_eal_remote_launch(test_hash_resize_rcu_reader, NULL, reader_lcore);
+
+	for (round = 0; round < RESIZE_RCU_ROUNDS * 2; round++) {
+		/* Grow to twice the size, then shrink back */
+		ret = rte_hash_resize(g_handle, (round & 1) ? params.entries :
+				params.entries * 2);
+		if (ret != 0) {
+			printf("failed to start resize %u (%d)\n", round, ret);
+			goto end;
+		}
+
+		do {
+			/* Add or delete a key for each migration step */
+			for (i = 0; i < 4; i++) {
+				churn_key = &resize_rcu_keys[
+					RESIZE_RCU_STABLE_KEYS + next];
+				if (present[next])
+					ret = rte_hash_del_key(g_handle, churn_key);
+				else
+					ret = rte_hash_add_key(g_handle, churn_key);
+				if (ret < 0) {
+					printf("failed to %s key %u (%d)\n",
+					       present[next] ? "delete" : "add",
+					       *churn_key, ret);
+					goto end;
+				}
+				present[next] ^= 1;
+				next = (next + 1) % RESIZE_RCU_CHURN_KEYS;
+			}
+
+			step = rte_hash_resize_step(g_handle, 8);
+		} while (step > 0);
+		if (step != 0) {
+			printf("failed to complete resize %u (%d)\n", round, step);
+			ret = -1;
+			goto end;
+		}
+	}
+
+	for (i = 0; i < RESIZE_RCU_CHURN_KEYS; i++) {
+		ret = rte_hash_lookup(g_handle,
+				&resize_rcu_keys[RESIZE_RCU_STABLE_KEYS + i]);
+		if (present[i] ? ret < 0 : ret != -ENOENT) {
+			printf("wrong lookup result for key %u (%d)\n",
+			       RESIZE_RCU_STABLE_KEYS + i, ret);
+			ret = -1;
+			goto end;
+		}
+	}
+	ret = 0;
+
+end:
+	writer_done = 1;
+	if (reader_lcore != RTE_MAX_LCORE)
+		rte_eal_wait_lcore(reader_lcore);
+	if (ret == 0 && resize_rcu_reader_failed) {
+		printf("reader failed to find a key during resize\n");
+		ret = -1;
+	}
+	rte_hash_free(g_handle);
+	rte_free(g_qsv);
+	g_handle = NULL;
+	g_qsv = NULL;
+
+	return ret;
+}
+
 /*
  * Wrapper functions for tests that take parameters.
  */
@@ -2636,6 +2987,8 @@ static struct unit_test_suite hash_test_suite = {
 		TEST_CASE(test_five_keys),
 		TEST_CASE(test_full_bucket),
 		TEST_CASE(test_extendable_bucket),
+		TEST_CASE(test_hash_resize),
+		TEST_CASE(test_hash_lookup_pipeline),
 		TEST_CASE(test_fbk_hash_find_existing),
 		TEST_CASE(fbk_hash_unit_test),
 		TEST_CASE(test_hash_creation_with_bad_parameters),
@@ -2654,6 +3007,7 @@ static struct unit_test_suite hash_test_suite = {
 		TEST_CASE(test_hash_rcu_qsbr_sync_mode_ext),
 		TEST_CASE(test_hash_rcu_qsbr_dq_reclaim),
 		TEST_CASE(test_hash_rcu_qsbr_replace_auto_free),
+		TEST_CASE(test_hash_resize_rcu_dq),
 		TEST_CASES_END()
 	}
 };
@@ -723,6 +723,142 @@ fbk_hash_perf_test(void)
 	return 0;
 }
 
+/* Control operation of the pipelined bulk lookup performance test. */
+#define PIPELINE_MIN_ENTRIES (1 << 10)	/* Smallest table size. */
+#define PIPELINE_MAX_ENTRIES (1 << 26)	/* Largest table size. */
+#define PIPELINE_LOOKUPS (1 << 22)	/* How many lookups to time. */
+#define PIPELINE_BURST RTE_HASH_LOOKUP_BULK_MAX
+
+/* Group sizes to compare, 0 is the regular bulk lookup. */
+static const uint32_t pipeline_group_sizes[] = { 0, 4, 8, 16, 32 };
+
+static int
+timed_lookups_pipeline(const struct rte_hash *handle, const uint64_t *tbl_keys,
+		const uint32_t *indexes, uint32_t group_size, double *mpps)
+{
+	const void *keys_burst[PIPELINE_BURST];
+	void *ret_data[PIPELINE_BURST];
+	uint64_t hit_mask;
+	uint64_t hits = 0;
+	unsigned int i, k;
+	int ret;
+
+	const uint64_t start_tsc = rte_rdtsc();
+
+	for (i = 0; i < PIPELINE_LOOKUPS; i += PIPELINE_BURST) {
+		for (k = 0; k < PIPELINE_BURST; k++)
+			keys_burst[k] = &tbl_keys[indexes[i + k]];
+		if (group_size == 0)
+			ret = rte_hash_lookup_bulk_data(handle, keys_burst,
+					PIPELINE_BURST, &hit_mask, ret_data);
+		else
+			ret = rte_hash_lookup_bulk_data_pipeline(handle,
+					keys_burst, PIPELINE_BURST, group_size,
+					&hit_mask, ret_data);
+		if (ret < 0) {
+			printf("Bulk lookup failed with %d\n", ret);
+			return -1;
+		}
+		hits += ret;
+	}
+
+	const uint64_t end_tsc = rte_rdtsc();
+
+	if (hits != PIPELINE_LOOKUPS) {
+		printf("Expect to find %u keys, but found %" PRIu64 "\n",
+			PIPELINE_LOOKUPS, hits);
+		return -1;
+	}
+
+	*mpps = (double)PIPELINE_LOOKUPS * rte_get_tsc_hz() /
+		(end_tsc - start_tsc) / 1000000;
+	return 0;
+}
+
+static int
+bulk_lookup_pipeline_perf_test(void)
+{
+	struct rte_hash_parameters params = {
+		.name = "pipeline_perf",
+		.key_len = sizeof(uint64_t),
+		.hash_func = rte_hash_crc,
+		.hash_func_init_val = 0,
+		.socket_id = rte_socket_id(),
+	};
+	const uint32_t max_keys = PIPELINE_MAX_ENTRIES * ADD_PERCENT;
+	struct rte_hash *handle;
+	uint64_t *tbl_keys = NULL;
+	uint32_t *indexes = NULL;
+	uint32_t entries, added, i;
+	double mpps;
+	int ret = -1;
+
+	tbl_keys = rte_malloc(NULL, max_keys * sizeof(*tbl_keys), 0);
+	indexes = rte_malloc(NULL, PIPELINE_LOOKUPS * sizeof(*indexes), 0);
+	if (tbl_keys == NULL || indexes == NULL) {
+		printf("Memory allocation for keys failed\n");
+		goto exit;
+	}
+
+	for (i = 0; i < max_keys; i++)
+		tbl_keys[i] = rte_rand();
+
+	printf("\n\n *** Pipelined bulk lookup performance test results ***\n");
+	printf("Burst of %u keys, Mpps per group size (0 = rte_hash_lookup_bulk_data)\n",
+		PIPELINE_BURST);
+	printf("%-10s", "Entries");
+	for (i = 0; i < RTE_DIM(pipeline_group_sizes); i++)
+		printf("%10u", pipeline_group_sizes[i]);
+	printf("\n");
+
+	for (entries = PIPELINE_MIN_ENTRIES; entries <= PIPELINE_MAX_ENTRIES;
+			entries <<= 2) {
+		params.entries = entries;
+		handle = rte_hash_create(&params);
+		if (handle == NULL) {
+			printf("%-10u not enough memory, stopping\n", entries);
+			break;
+		}
+
+		for (added = 0; added < entries * ADD_PERCENT; added++) {
+			if (rte_hash_add_key_data(handle, &tbl_keys[added],
+					(void *)(uintptr_t)added) < 0)
+				break;
+		}
+
+		for (i = 0; i < PIPELINE_LOOKUPS; i++)
+			indexes[i] = rte_rand_max(added);
+
+		printf("%-10u", entries);
+		for (i = 0; i < RTE_DIM(pipeline_group_sizes); i++) {
+			if (timed_lookups_pipeline(handle, tbl_keys, indexes,
+					pipeline_group_sizes[i], &mpps) < 0) {
+				rte_hash_free(handle);
+				goto exit;
+			}
+			printf("%10.2f", mpps);
+		}
+		printf("\n");
+
+		rte_hash_free(handle);
+	}
+
+	ret = 0;
+exit:
+	rte_free(indexes);
+	rte_free(tbl_keys);
+	return ret;
+}
+
+static int
+test_hash_lookup_pipeline_perf(void)
+{
+	if (RTE_EXEC_ENV_IS_WINDOWS)
+		return TEST_SKIPPED;
+
+	return bulk_lookup_pipeline_perf_test();
+}
+
 static int
 test_hash_perf(void)
 {
@@ -758,3 +894,5 @@ test_hash_perf(void)
 }
 
 REGISTER_PERF_TEST(hash_perf_autotest, test_hash_perf);
+REGISTER_PERF_TEST(hash_lookup_pipeline_perf_autotest,
+	test_hash_lookup_pipeline_perf);
@@ -140,6 +140,35 @@ test_mempool_basic(struct rte_mempool *mp, int use_external_cache)
 	rte_mempool_generic_put(mp, &obj2, 1, cache);
 	rte_mempool_dump(stdout, mp);
 
+	if (cache != NULL) {
+		void **cache_objs;
+
+		printf("zero-copy get 2 objects\n");
+		cache_objs = rte_mempool_cache_zc_get_bulk(cache, mp, 2);
+		if (cache_objs == NULL)
+			GOTO_ERR(ret, out);
+		obj = cache_objs[0];
+		obj2 = cache_objs[1];
+
+		printf("zero-copy put the objects back\n");
+		cache_objs = rte_mempool_cache_zc_put_bulk(cache, mp, 3);
+		if (cache_objs != NULL) {
+			cache_objs[0] = obj;
+			cache_objs[1] = obj2;
+			rte_mempool_cache_zc_put_rewind(cache, 1);
+		} else {
+			/* Not supported with the mempool debug. */
+			rte_mempool_generic_put(mp, &obj, 1, cache);
+			rte_mempool_generic_put(mp, &obj2, 1, cache);
+		}
+		rte_mempool_dump(stdout, mp);
+
+		printf("zero-copy get too many objects\n");
+		if (rte_mempool_cache_zc_get_bulk(cache, mp,
+				cache->size / 2 + cache->len + 1) != NULL)
+			GOTO_ERR(ret, out);
+	}
+
 	/*
 	 * get many objects: we cannot get them all because the cache
 	 * on other cores may not be empty.
@@ -435,6 +464,96 @@ test_mempool_basic_ex(struct rte_mempool *mp)
 	return ret;
 }
 
+/*
+ * The cache of an adaptive mempool grows when objects bounce through the
+ * common pool, also with the zero-copy API, and shrinks when the lcore
+ * only puts objects.
+ */
+#define ADAPT_CACHE_SIZE 64
+#define ADAPT_BULK 8
+#define ADAPT_KEEP (ADAPT_CACHE_SIZE * 2)
+#define ADAPT_ROUNDS (RTE_MEMPOOL_CACHE_ADAPT_PERIOD * 64)
+
+static int
+test_mempool_cache_adaptive(void)
+{
+	struct rte_mempool_cache *cache;
+	struct rte_mempool *mp;
+	void *objs[ADAPT_KEEP];
+	void **zc_objs;
+	unsigned int i, j;
+	uint32_t grows;
+	int ret = -1;
+
+	mp = rte_mempool_create("test_cache_adaptive", ADAPT_KEEP * 8,
+		MEMPOOL_ELT_SIZE, ADAPT_CACHE_SIZE, 0,
+		NULL, NULL, NULL, NULL,
+		rte_socket_id(), RTE_MEMPOOL_F_CACHE_ADAPTIVE);
+	if (mp == NULL)
+		RET_ERR();
+
+	cache = rte_mempool_default_cache(mp, rte_lcore_id());
+	if (cache == NULL)
+		GOTO_ERR(ret, out);
+
+	printf("bounce objects through the common pool\n");
+	for (i = 0; i < ADAPT_ROUNDS; i++) {
+		for (j = 0; j < ADAPT_KEEP; j += ADAPT_BULK)
+			if (rte_mempool_get_bulk(mp, &objs[j], ADAPT_BULK) < 0)
+				GOTO_ERR(ret, out);
+		for (j = 0; j < ADAPT_KEEP; j += ADAPT_BULK)
+			rte_mempool_put_bulk(mp, &objs[j], ADAPT_BULK);
+	}
+	rte_mempool_dump(stdout, mp);
+	if (cache->grows == 0 || cache->size <= ADAPT_CACHE_SIZE)
+		GOTO_ERR(ret, out);
+
+	printf("only put objects\n");
+	for (i = 0; i < ADAPT_ROUNDS; i++) {
+		if (rte_mempool_generic_get(mp, objs, ADAPT_BULK, NULL) < 0)
+			GOTO_ERR(ret, out);
+		rte_mempool_put_bulk(mp, objs, ADAPT_BULK);
+		if (cache->len > cache->size)
+			GOTO_ERR(ret, out);
+	}
+	rte_mempool_dump(stdout, mp);
+	if (cache->shrinks == 0 || cache->size >= ADAPT_CACHE_SIZE)
+		GOTO_ERR(ret, out);
+
+	printf("bounce objects with the zero-copy API\n");
+	grows = cache->grows;
+	for (i = 0; i < ADAPT_ROUNDS; i++) {
+		for (j = 0; j < ADAPT_KEEP; j += ADAPT_BULK) {
+			zc_objs = rte_mempool_cache_zc_get_bulk(cache, mp,
+					ADAPT_BULK);
+			if (zc_objs == NULL)
+				GOTO_ERR(ret, out);
+			rte_memcpy(&objs[j], zc_objs, sizeof(void *) * ADAPT_BULK);
+		}
+		for (j = 0; j < ADAPT_KEEP; j += ADAPT_BULK) {
+			zc_objs = rte_mempool_cache_zc_put_bulk(cache, mp,
+					ADAPT_BULK);
+			if (zc_objs == NULL)
+				GOTO_ERR(ret, out);
+			rte_memcpy(zc_objs, &objs[j], sizeof(void *) * ADAPT_BULK);
+			if (cache->len > cache->size)
+				GOTO_ERR(ret, out);
+		}
+	}
+	rte_mempool_dump(stdout, mp);
+	if (cache->grows == grows)
+		GOTO_ERR(ret, out);
+
+	rte_mempool_cache_flush(cache, mp);
+	if (rte_mempool_avail_count(mp) != mp->size)
+		GOTO_ERR(ret, out);
+
+	ret = 0;
+out:
+	rte_mempool_free(mp);
+	return ret;
+}
+
 static int
 test_mempool_same_name_twice_creation(void)
 {
@@ -1078,6 +1197,9 @@ test_mempool(void)
 	if (test_mempool_creation_with_invalid_flags() < 0)
 		GOTO_ERR(ret, err);
 
+	if (test_mempool_cache_adaptive() < 0)
+		GOTO_ERR(ret, err);
+
 	if (test_mempool_same_name_twice_creation() < 0)
 		GOTO_ERR(ret, err);
 
@@ -25,7 +25,9 @@
 #include <rte_mempool.h>
 #include <rte_spinlock.h>
 #include <rte_malloc.h>
+#include <rte_mbuf.h>
 #include <rte_mbuf_pool_ops.h>
+#include <rte_ring.h>
 
 #include "test.h"
 
@@ -78,6 +80,29 @@
  *      - 2048
  *      - 8192
  *      - 32768
+ *
+ * Zero-copy mbuf performance
+ * =======
+ *
+ *    One core allocates *ZC_KEEP* mbufs by bursts of *n_bulk* and frees them
+ *    back by bursts of the same size, comparing:
+ *
+ *    - the mempool API copying the object pointers into a table, with the
+ *      mbufs released into a local table first as done by the PMDs;
+ *    - rte_mempool_cache_zc_get_bulk() and rte_pktmbuf_free_bulk(), which
+ *      go straight from and into the mempool cache.
+ *
+ * Cross-socket performance
+ * =======
+ *
+ *    The worker lcores are split in pairs: one lcore of the first socket
+ *    gets objects per bulk of *XS_BULK* and passes them through a ring to
+ *    an lcore of another socket, which puts them back in the pool.
+ *    Without several sockets, the first half of the workers gets objects
+ *    and the second half puts them back.
+ *
+ *    This is done during TIME_S seconds, with the ring_mp_mc and the shard
+ *    mempool drivers, without cache and with a cache of *XS_CACHE_SIZE*.
  */
 
 #define TIME_S 1
@@ -559,6 +584,299 @@ do_all_mempool_perf_tests(unsigned int cores)
 	return ret;
 }
 
+/* number of mbufs allocated before freeing them back */
+#define ZC_KEEP 512
+#define ZC_NB_MBUF (ZC_KEEP + RTE_MEMPOOL_CACHE_MAX_SIZE * 2)
+#define ZC_ITERATIONS 20000
+
+static __rte_always_inline int
+zc_alloc(struct rte_mempool *mp, struct rte_mbuf **mbufs,
+	unsigned int n_bulk, int zero_copy)
+{
+	struct rte_mempool_cache *cache;
+	unsigned int idx, i;
+	void **objs;
+
+	cache = rte_mempool_default_cache(mp, rte_lcore_id());
+	for (idx = 0; idx < ZC_KEEP; idx += n_bulk) {
+		if (zero_copy) {
+			/* fill the table straight from the cache, as a Rx refill */
+			objs = rte_mempool_cache_zc_get_bulk(cache, mp, n_bulk);
+			if (objs == NULL)
+				return -1;
+			for (i = 0; i < n_bulk; i++)
+				mbufs[idx + i] = objs[n_bulk - 1 - i];
+		} else if (rte_mempool_generic_get(mp, (void **)&mbufs[idx],
+				n_bulk, cache) != 0) {
+			return -1;
+		}
+		rte_mbuf_raw_reset_bulk(mp, &mbufs[idx], n_bulk);
+	}
+
+	return 0;
+}
+
+static __rte_always_inline void
+zc_free(struct rte_mempool *mp, struct rte_mbuf **mbufs,
+	unsigned int n_bulk, int zero_copy)
+{
+	struct rte_mbuf *m, *free[RTE_MEMPOOL_CACHE_MAX_SIZE];
+	unsigned int idx, i, nb_free;
+
+	for (idx = 0; idx < ZC_KEEP; idx += n_bulk) {
+		if (zero_copy) {
+			rte_pktmbuf_free_bulk(&mbufs[idx], n_bulk);
+			continue;
+		}
+		/* release into a local table first, as a Tx completion */
+		nb_free = 0;
+		for (i = 0; i < n_bulk; i++) {
+			m = rte_pktmbuf_prefree_seg(mbufs[idx + i]);
+			if (m != NULL)
+				free[nb_free++] = m;
+		}
+		rte_mbuf_raw_free_bulk(mp, free, nb_free);
+	}
+}
+
+static int
+zc_run(struct rte_mempool *mp, unsigned int n_bulk, int zero_copy,
+	uint64_t *alloc_cycles, uint64_t *free_cycles)
+{
+	alignas(RTE_CACHE_LINE_SIZE) struct rte_mbuf *mbufs[ZC_KEEP];
+	uint64_t start;
+	unsigned int i;
+	int ret;
+
+	*alloc_cycles = 0;
+	*free_cycles = 0;
+	for (i = 0; i < ZC_ITERATIONS; i++) {
+		start = rte_rdtsc_precise();
+		/* constant burst sizes let the compiler unroll the copies */
+		if (n_bulk == 32)
+			ret = zc_alloc(mp, mbufs, 32, zero_copy);
+		else
+			ret = zc_alloc(mp, mbufs, n_bulk, zero_copy);
+		if (ret != 0)
+			return ret;
+		*alloc_cycles += rte_rdtsc_precise() - start;
+
+		start = rte_rdtsc_precise();
+		if (n_bulk == 32)
+			zc_free(mp, mbufs, 32, zero_copy);
+		else
+			zc_free(mp, mbufs, n_bulk, zero_copy);
+		*free_cycles += rte_rdtsc_precise() - start;
+	}
+
+	return 0;
+}
+
+/* Compare the copying and the zero-copy mbuf bulk alloc/free paths */
+static int
+test_mempool_zc_perf(void)
+{
+	static const unsigned int bulk_tab[] = { 1, 4, CACHE_LINE_BURST, 32,
+		64, 128 };
+	const double nb_mbufs = (double)ZC_ITERATIONS * ZC_KEEP;
+	uint64_t alloc_copy, free_copy, alloc_zc, free_zc;
+	struct rte_mempool *mp;
+	unsigned int i;
+	int ret = -1;
+
+	mp = rte_pktmbuf_pool_create("perf_test_zc", ZC_NB_MBUF,
+		RTE_MEMPOOL_CACHE_MAX_SIZE, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+		SOCKET_ID_ANY);
+	if (mp == NULL) {
+		printf("cannot allocate mbuf pool\n");
+		return -1;
+	}
+
+	printf("mbuf cycles per mbuf, keep=%u\n", ZC_KEEP);
+	for (i = 0; i < RTE_DIM(bulk_tab); i++) {
+		if (zc_run(mp, bulk_tab[i], 0, &alloc_copy, &free_copy) != 0 ||
+				zc_run(mp, bulk_tab[i], 1, &alloc_zc,
+					&free_zc) != 0)
+			GOTO_ERR(ret, err);
+		printf("n_bulk=%3u alloc: copy=%6.2f zero-copy=%6.2f "
+			"free: copy=%6.2f zero-copy=%6.2f\n", bulk_tab[i],
+			alloc_copy / nb_mbufs, alloc_zc / nb_mbufs,
+			free_copy / nb_mbufs, free_zc / nb_mbufs);
+	}
+	ret = 0;
+
+err:
+	rte_mempool_free(mp);
+	return ret;
+}
+
+/* number of objects passed at once from an lcore to another */
+#define XS_BULK 32
+#define XS_RING_SIZE 1024
+#define XS_CACHE_SIZE 64
+#define XS_ELT_SIZE 64
+
+/* role of an lcore in the cross-socket test */
+struct __rte_cache_aligned xs_lcore {
+	struct rte_ring *r;	/* ring to the peer lcore */
+	bool put;		/* put the objects received from the ring */
+	uint64_t count;		/* objects put back */
+	RTE_CACHE_GUARD;
+};
+
+static struct xs_lcore xs_lcores[RTE_MAX_LCORE];
+static RTE_ATOMIC(uint32_t) xs_stop;
+
+static int
+xs_lcore_loop(void *arg)
+{
+	struct rte_mempool *mp = arg;
+	struct xs_lcore *xl = &xs_lcores[rte_lcore_id()];
+	void *objs[XS_BULK];
+	unsigned int n;
+
+	while (rte_atomic_load_explicit(&xs_stop,
+			rte_memory_order_relaxed) == 0) {
+		if (xl->put) {
+			n = rte_ring_sc_dequeue_burst(xl->r, objs, XS_BULK,
+				NULL);
+			if (n == 0) {
+				rte_pause();
+				continue;
+			}
+			rte_mempool_put_bulk(mp, objs, n);
+			xl->count += n;
+		} else {
+			if (rte_mempool_get_bulk(mp, objs, XS_BULK) < 0) {
+				rte_pause();
+				continue;
+			}
+			while (rte_ring_sp_enqueue_bulk(xl->r, objs, XS_BULK,
+					NULL) == 0) {
+				if (rte_atomic_load_explicit(&xs_stop,
+						rte_memory_order_relaxed) != 0) {
+					rte_mempool_put_bulk(mp, objs,
+						XS_BULK);
+					return 0;
+				}
+				rte_pause();
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+xs_run(const char *ops, unsigned int cache_size, unsigned int *getters,
+	unsigned int *putters, unsigned int nb_pairs)
+{
+	char name[RTE_RING_NAMESIZE];
+	struct rte_mempool *mp;
+	uint64_t count;
+	unsigned int i;
+	void *obj;
+	int ret = -1;
+
+	mp = rte_mempool_create_empty("perf_test_xs",
+		nb_pairs * (XS_RING_SIZE + XS_BULK + cache_size * 3),
+		XS_ELT_SIZE, cache_size, 0, SOCKET_ID_ANY, 0);
+	if (mp == NULL) {
+		printf("cannot allocate mempool\n");
+		return -1;
+	}
+	if (rte_mempool_set_ops_byname(mp, ops, NULL) < 0) {
+		printf("cannot set %s handler\n", ops);
+		goto err;
+	}
+	if (rte_mempool_populate_default(mp) < 0) {
+		printf("cannot populate %s mempool\n", ops);
+		goto err;
+	}
+
+	memset(xs_lcores, 0, sizeof(xs_lcores));
+	for (i = 0; i < nb_pairs; i++) {
+		snprintf(name, sizeof(name), "perf_test_xs_%u", i);
+		xs_lcores[getters[i]].r = rte_ring_create(name, XS_RING_SIZE,
+			rte_lcore_to_socket_id(putters[i]),
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+		if (xs_lcores[getters[i]].r == NULL)
+			GOTO_ERR(ret, out);
+		xs_lcores[putters[i]].r = xs_lcores[getters[i]].r;
+		xs_lcores[putters[i]].put = true;
+	}
+
+	rte_atomic_store_explicit(&xs_stop, 0, rte_memory_order_relaxed);
+	for (i = 0; i < nb_pairs; i++) {
+		rte_eal_remote_launch(xs_lcore_loop, mp, putters[i]);
+		rte_eal_remote_launch(xs_lcore_loop, mp, getters[i]);
+	}
+	rte_delay_ms(TIME_S * 1000);
+	rte_atomic_store_explicit(&xs_stop, 1, rte_memory_order_relaxed);
+	rte_eal_mp_wait_lcore();
+
+	count = 0;
+	for (i = 0; i < nb_pairs; i++) {
+		count += xs_lcores[putters[i]].count;
+		while (rte_ring_dequeue(xs_lcores[getters[i]].r, &obj) == 0)
+			rte_mempool_put(mp, obj);
+	}
+	printf("mempool_xs_autotest ops=%-10s cache=%3u pairs=%2u "
+		"rate_persec=%10" PRIu64 "\n", ops, cache_size, nb_pairs,
+		count / TIME_S);
+
+	ret = 0;
+out:
+	for (i = 0; i < nb_pairs; i++)
+		rte_ring_free(xs_lcores[getters[i]].r);
+err:
+	rte_mempool_free(mp);
+	return ret;
+}
+
+/* Compare the ring and shard drivers with objects freed on another socket */
+static int
+test_mempool_xs_perf(void)
+{
+	static const char * const ops_tab[] = { "ring_mp_mc", "shard" };
+	static const unsigned int cache_tab[] = { 0, XS_CACHE_SIZE };
+	unsigned int getters[RTE_MAX_LCORE], putters[RTE_MAX_LCORE];
+	unsigned int nb_getters = 0, nb_putters = 0, nb_pairs;
+	unsigned int lcore_id, i, j;
+	int first_socket = -1;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (first_socket == -1)
+			first_socket = rte_lcore_to_socket_id(lcore_id);
+		if ((int)rte_lcore_to_socket_id(lcore_id) == first_socket)
+			getters[nb_getters++] = lcore_id;
+		else
+			putters[nb_putters++] = lcore_id;
+	}
+	if (nb_putters == 0) {
+		/* Single socket, split the workers. */
+		nb_putters = nb_getters / 2;
+		nb_getters -= nb_putters;
+		memcpy(putters, &getters[nb_getters],
+			nb_putters * sizeof(putters[0]));
+	}
+	nb_pairs = RTE_MIN(nb_getters, nb_putters);
+	if (nb_pairs == 0) {
+		printf("not enough lcores\n");
+		return TEST_SKIPPED;
+	}
+
+	for (i = 0; i < RTE_DIM(ops_tab); i++) {
+		for (j = 0; j < RTE_DIM(cache_tab); j++) {
+			if (xs_run(ops_tab[i], cache_tab[j], getters, putters,
+					nb_pairs) < 0)
+				return -1;
+		}
+	}
+
+	return 0;
+}
+
 static int
 test_mempool_perf_1core(void)
 {
@@ -611,3 +929,5 @@ REGISTER_PERF_TEST(mempool_perf_autotest, test_mempool_perf);
 REGISTER_PERF_TEST(mempool_perf_autotest_1core, test_mempool_perf_1core);
 REGISTER_PERF_TEST(mempool_perf_autotest_2cores, test_mempool_perf_2cores);
 REGISTER_PERF_TEST(mempool_perf_autotest_allcores, test_mempool_perf_allcores);
+REGISTER_PERF_TEST(mempool_zc_perf_autotest, test_mempool_zc_perf);
+REGISTER_PERF_TEST(mempool_xs_perf_autotest, test_mempool_xs_perf);
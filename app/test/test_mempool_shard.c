@@ -0,0 +1,253 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mempool.h>
+#include <rte_mempool_shard.h>
+
+#include "test.h"
+
+#define SHARD_TEST_SIZE 256
+#define SHARD_TEST_ELT_SIZE 64
+
+static void *objs[SHARD_TEST_SIZE + 1];
+
+/* Create a shard pool with a shard per lcore, so with several shards. */
+static struct rte_mempool *
+shard_pool_create(const char *name, unsigned int flags)
+{
+	struct rte_mempool_shard_config cfg = {
+		.lcores_per_shard = 1,
+	};
+	struct rte_mempool *mp;
+
+	mp = rte_mempool_create_empty(name, SHARD_TEST_SIZE,
+		SHARD_TEST_ELT_SIZE, 0, 0, SOCKET_ID_ANY, flags);
+	if (mp == NULL) {
+		printf("Cannot create mempool %s\n", name);
+		return NULL;
+	}
+	if (rte_mempool_set_ops_byname(mp, "shard", &cfg) < 0 ||
+			rte_mempool_populate_default(mp) < 0) {
+		printf("Cannot populate mempool %s\n", name);
+		rte_mempool_free(mp);
+		return NULL;
+	}
+
+	return mp;
+}
+
+static int
+ptr_cmp(const void *a, const void *b)
+{
+	uintptr_t pa = (uintptr_t)*(void * const *)a;
+	uintptr_t pb = (uintptr_t)*(void * const *)b;
+
+	return pa < pb ? -1 : pa > pb;
+}
+
+/* Get all objects at once, and check that they are all different. */
+static int
+shard_get_all(void *arg)
+{
+	struct rte_mempool *mp = arg;
+	unsigned int i;
+	int ret;
+
+	ret = rte_mempool_get_bulk(mp, objs, SHARD_TEST_SIZE);
+	if (ret != 0) {
+		printf("Lcore %u cannot get all objects: %d\n", rte_lcore_id(),
+		       ret);
+		return -1;
+	}
+	if (rte_mempool_avail_count(mp) != 0) {
+		printf("Objects left after getting all of them\n");
+		ret = -1;
+	}
+
+	qsort(objs, SHARD_TEST_SIZE, sizeof(objs[0]), ptr_cmp);
+	for (i = 1; i < SHARD_TEST_SIZE; i++) {
+		if (objs[i] == objs[i - 1]) {
+			printf("Object %p got twice\n", objs[i]);
+			ret = -1;
+		}
+	}
+	rte_mempool_put_bulk(mp, objs, SHARD_TEST_SIZE);
+
+	return ret;
+}
+
+/*
+ * The objects of a pool are spread over the shards of all lcores, so
+ * getting all of them from any lcore steals from the other shards.
+ */
+static int
+test_mempool_shard_steal(void)
+{
+	struct rte_mempool *mp;
+	unsigned int lcore_id;
+	int ret = TEST_SUCCESS;
+
+	if (rte_lcore_count() < 2) {
+		printf("Not enough lcores, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	mp = shard_pool_create("test_shard_steal", 0);
+	TEST_ASSERT_NOT_NULL(mp, "Cannot create shard mempool");
+
+	if (shard_get_all(mp) != 0)
+		ret = TEST_FAILED;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (rte_eal_remote_launch(shard_get_all, mp, lcore_id) != 0 ||
+				rte_eal_wait_lcore(lcore_id) != 0)
+			ret = TEST_FAILED;
+	}
+
+	if (rte_mempool_avail_count(mp) != SHARD_TEST_SIZE) {
+		printf("%u objects available instead of %u\n",
+		       rte_mempool_avail_count(mp), SHARD_TEST_SIZE);
+		ret = TEST_FAILED;
+	}
+	rte_mempool_free(mp);
+
+	return ret;
+}
+
+/*
+ * A get which cannot be satisfied fails without losing the objects it
+ * has already taken from the shards.
+ */
+static int
+shard_get_fail(unsigned int flags)
+{
+	struct rte_mempool *mp;
+	int ret = TEST_FAILED;
+	unsigned int i;
+
+	mp = shard_pool_create("test_shard_fail", flags);
+	TEST_ASSERT_NOT_NULL(mp, "Cannot create shard mempool");
+
+	for (i = 0; i < 2; i++) {
+		if (rte_mempool_get_bulk(mp, objs, SHARD_TEST_SIZE + 1) !=
+				-ENOBUFS) {
+			printf("Get of too many objects did not fail\n");
+			goto out;
+		}
+		if (rte_mempool_avail_count(mp) != SHARD_TEST_SIZE) {
+			printf("%u objects available after failed get\n",
+			       rte_mempool_avail_count(mp));
+			goto out;
+		}
+	}
+
+	/* The given back objects can be got again. */
+	if (shard_get_all(mp) != 0)
+		goto out;
+
+	ret = TEST_SUCCESS;
+out:
+	rte_mempool_free(mp);
+	return ret;
+}
+
+static int
+test_mempool_shard_get_fail(void)
+{
+	return shard_get_fail(0);
+}
+
+/* With a single producer, the objects of a failed get are stashed. */
+static int
+test_mempool_shard_get_fail_sp_sc(void)
+{
+	return shard_get_fail(RTE_MEMPOOL_F_SP_PUT | RTE_MEMPOOL_F_SC_GET);
+}
+
+static void
+shard_chunk_free(struct rte_mempool_memhdr *memhdr, void *opaque)
+{
+	RTE_SET_USED(memhdr);
+	rte_free(opaque);
+}
+
+/*
+ * A pool populated with several memory chunks grows the rings of its
+ * shards for the objects of each chunk, keeping the objects stored.
+ */
+static int
+test_mempool_shard_chunks(void)
+{
+	struct rte_mempool *mp;
+	size_t total_elt_sz, len;
+	int ret = TEST_FAILED;
+	unsigned int i;
+	char *addr;
+
+	mp = rte_mempool_create_empty("test_shard_chunks", SHARD_TEST_SIZE,
+		SHARD_TEST_ELT_SIZE, 0, 0, SOCKET_ID_ANY, 0);
+	TEST_ASSERT_NOT_NULL(mp, "Cannot create mempool");
+	if (rte_mempool_set_ops_byname(mp, "shard", NULL) < 0) {
+		printf("Cannot set shard ops\n");
+		goto out;
+	}
+
+	/* Half of the objects, and a page of slack, in each chunk */
+	total_elt_sz = mp->header_size + mp->elt_size + mp->trailer_size;
+	len = total_elt_sz * SHARD_TEST_SIZE / 2 + 4096;
+	for (i = 0; i < 2; i++) {
+		addr = rte_malloc(NULL, len, 4096);
+		if (addr == NULL) {
+			printf("Cannot allocate chunk %u\n", i);
+			goto out;
+		}
+		if (rte_mempool_populate_iova(mp, addr, RTE_BAD_IOVA, len,
+				shard_chunk_free, addr) <= 0) {
+			printf("Cannot populate chunk %u\n", i);
+			rte_free(addr);
+			goto out;
+		}
+	}
+	if (mp->nb_mem_chunks != 2 ||
+			rte_mempool_avail_count(mp) != SHARD_TEST_SIZE) {
+		printf("%u objects available in %u chunks\n",
+		       rte_mempool_avail_count(mp), mp->nb_mem_chunks);
+		goto out;
+	}
+
+	if (shard_get_all(mp) != 0)
+		goto out;
+
+	ret = TEST_SUCCESS;
+out:
+	rte_mempool_free(mp);
+	return ret;
+}
+
+static struct unit_test_suite mempool_shard_testsuite = {
+	.suite_name = "Shard mempool driver unit test suite",
+	.unit_test_cases = {
+		TEST_CASE(test_mempool_shard_steal),
+		TEST_CASE(test_mempool_shard_get_fail),
+		TEST_CASE(test_mempool_shard_get_fail_sp_sc),
+		TEST_CASE(test_mempool_shard_chunks),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_mempool_shard(void)
+{
+	return unit_test_suite_runner(&mempool_shard_testsuite);
+}
+
+REGISTER_FAST_TEST(mempool_shard_autotest, NOHUGE_OK, ASAN_OK, test_mempool_shard);
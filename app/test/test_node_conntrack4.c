@@ -0,0 +1,514 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_conntrack4(void)
+{
+	printf("node_conntrack4 not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_node_conntrack4_api.h>
+#include <rte_node_mbuf_dynfield.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#define CT4_TEST_BURST 8
+#define CT4_TEST_NB_MBUFS 64
+#define CT4_TEST_MAX_FLOWS 4
+
+#define CT4_TEST_CLIENT RTE_IPV4(192, 0, 2, 1)
+#define CT4_TEST_SERVER RTE_IPV4(198, 51, 100, 1)
+
+static struct rte_mempool *ct4_pool;
+static struct rte_rcu_qsbr *ct4_rcu;
+static int ct4_dyn = -1;
+
+/* Packets injected by the source node on its next walk */
+static struct rte_mbuf *src_pkts[CT4_TEST_BURST];
+static uint16_t src_nb_pkts;
+
+/* Packets received by the sink node */
+static struct rte_mbuf *sink_pkts[CT4_TEST_BURST];
+static uint16_t sink_nb_pkts;
+
+static uint16_t
+test_ct4_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	uint16_t i, n = src_nb_pkts;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	for (i = 0; i < n; i++)
+		rte_node_enqueue_x1(graph, node, 0, src_pkts[i]);
+	src_nb_pkts = 0;
+
+	return n;
+}
+
+static uint16_t
+test_ct4_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+	      uint16_t nb_objs)
+{
+	uint16_t i;
+
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	for (i = 0; i < nb_objs && sink_nb_pkts < CT4_TEST_BURST; i++)
+		sink_pkts[sink_nb_pkts++] = objs[i];
+	for (; i < nb_objs; i++)
+		rte_pktmbuf_free(objs[i]);
+
+	return nb_objs;
+}
+
+static struct rte_node_register test_ct4_source_node = {
+	.name = "test_ct4_source",
+	.process = test_ct4_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"conntrack4"},
+};
+RTE_NODE_REGISTER(test_ct4_source_node);
+
+static struct rte_node_register test_ct4_sink_node = {
+	.name = "test_ct4_sink",
+	.process = test_ct4_sink,
+};
+RTE_NODE_REGISTER(test_ct4_sink_node);
+
+/* Build a packet from or to the server port of a client port. */
+static struct rte_mbuf *
+ct4_pkt(uint8_t proto, uint16_t client_port, bool reply, uint8_t tcp_flags)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_tcp_hdr *tcp;
+	struct rte_udp_hdr *udp;
+	struct rte_mbuf *m;
+	uint16_t l4_len;
+
+	l4_len = proto == IPPROTO_TCP ? sizeof(*tcp) : sizeof(*udp);
+	m = rte_pktmbuf_alloc(ct4_pool);
+	if (m == NULL)
+		return NULL;
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m,
+			sizeof(*eth) + sizeof(*ip) + l4_len);
+	if (eth == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(eth, 0, m->data_len);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + l4_len);
+	ip->time_to_live = 64;
+	ip->next_proto_id = proto;
+	ip->src_addr = rte_cpu_to_be_32(reply ? CT4_TEST_SERVER : CT4_TEST_CLIENT);
+	ip->dst_addr = rte_cpu_to_be_32(reply ? CT4_TEST_CLIENT : CT4_TEST_SERVER);
+
+	/* Ports are at the same place in the TCP and UDP headers */
+	udp = (struct rte_udp_hdr *)(ip + 1);
+	udp->src_port = rte_cpu_to_be_16(reply ? 80 : client_port);
+	udp->dst_port = rte_cpu_to_be_16(reply ? client_port : 80);
+	if (proto == IPPROTO_TCP) {
+		tcp = (struct rte_tcp_hdr *)(ip + 1);
+		tcp->data_off = (sizeof(*tcp) / 4) << 4;
+		tcp->tcp_flags = tcp_flags;
+	} else {
+		udp->dgram_len = rte_cpu_to_be_16(sizeof(*udp));
+	}
+
+	return m;
+}
+
+/*
+ * Walk the graph with one packet, and return the connection of the packet
+ * with its direction in the lowest bit, or UINT32_MAX if it was dropped.
+ */
+static uint32_t
+ct4_walk(struct rte_graph *graph, struct rte_mbuf *m)
+{
+	rte_node_mbuf_overload_fields_t *f;
+	uint32_t flow;
+
+	if (m == NULL)
+		return UINT32_MAX;
+
+	src_pkts[0] = m;
+	src_nb_pkts = 1;
+	sink_nb_pkts = 0;
+	rte_graph_walk(graph);
+	if (ct4_rcu != NULL)
+		rte_rcu_qsbr_quiescent(ct4_rcu, 0);
+
+	if (sink_nb_pkts != 1)
+		return UINT32_MAX;
+
+	f = rte_node_mbuf_overload_fields_get(sink_pkts[0], ct4_dyn);
+	flow = (f->flow_id << 1) | f->flow_dir;
+	rte_pktmbuf_free(sink_pkts[0]);
+	sink_nb_pkts = 0;
+
+	return flow;
+}
+
+/* Wait until the connections with a timeout of a second are expired. */
+static void
+ct4_wait_expiry(void)
+{
+	/* The connections are expired on the second tick after their packet */
+	rte_delay_ms(2100);
+}
+
+static rte_graph_t
+ct4_graph_create(const char *name)
+{
+	static const char *patterns[] = {"test_ct4_source"};
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+	};
+
+	return rte_graph_create(name, &gconf);
+}
+
+static int
+ct4_configure(struct rte_rcu_qsbr *v, uint32_t max_flows)
+{
+	struct rte_node_conntrack4_config cfg = {
+		.max_flows = max_flows,
+		.socket_id = SOCKET_ID_ANY,
+		.v = v,
+	};
+
+	/* Free the entries of the destroyed graphs */
+	if (ct4_rcu != NULL)
+		rte_rcu_qsbr_quiescent(ct4_rcu, 0);
+
+	return rte_node_conntrack4_configure(&cfg);
+}
+
+static int
+ct4_testsuite_setup(void)
+{
+	const char *sink = "test_ct4_sink";
+	size_t sz;
+
+	ct4_dyn = rte_node_mbuf_dynfield_register();
+	if (ct4_dyn < 0) {
+		printf("Failed to register node dynfield\n");
+		return TEST_FAILED;
+	}
+
+	ct4_pool = rte_pktmbuf_pool_create("test_ct4_pool", CT4_TEST_NB_MBUFS, 0, 0,
+					   RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (ct4_pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	sz = rte_rcu_qsbr_get_memsize(1);
+	ct4_rcu = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (ct4_rcu == NULL || rte_rcu_qsbr_init(ct4_rcu, 1) != 0) {
+		printf("Failed to create RCU QSBR variable\n");
+		goto fail;
+	}
+	rte_rcu_qsbr_thread_register(ct4_rcu, 0);
+	rte_rcu_qsbr_thread_online(ct4_rcu, 0);
+
+	/* The tracked packets are received by the sink instead of nat4 */
+	if (rte_node_edge_update(rte_node_from_name("conntrack4"),
+				 RTE_NODE_CONNTRACK4_NEXT_NAT4, &sink, 1) ==
+	    RTE_EDGE_ID_INVALID) {
+		printf("Failed to update conntrack4 edges\n");
+		goto fail;
+	}
+
+	return TEST_SUCCESS;
+fail:
+	rte_free(ct4_rcu);
+	ct4_rcu = NULL;
+	rte_mempool_free(ct4_pool);
+	return TEST_FAILED;
+}
+
+static void
+ct4_testsuite_teardown(void)
+{
+	const char *nat = "nat4";
+
+	rte_node_edge_update(rte_node_from_name("conntrack4"),
+			     RTE_NODE_CONNTRACK4_NEXT_NAT4, &nat, 1);
+
+	/* Release the table referencing the RCU QSBR variable */
+	ct4_configure(NULL, CT4_TEST_MAX_FLOWS);
+	rte_rcu_qsbr_thread_offline(ct4_rcu, 0);
+	rte_rcu_qsbr_thread_unregister(ct4_rcu, 0);
+	rte_free(ct4_rcu);
+	ct4_rcu = NULL;
+	rte_mempool_free(ct4_pool);
+}
+
+static void
+ct4_timeouts_reset(void)
+{
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN, 120);
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSED, 10);
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_UDP, 30);
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_UDP_STREAM, 120);
+}
+
+/*
+ * Track connections in both directions, and check that the connections
+ * of an idle graph are expired according to their state.
+ */
+static int
+test_conntrack4_track_expire(void)
+{
+	struct rte_node_conntrack4_stats stats;
+	uint32_t udp, tcp, closed, flow;
+	struct rte_graph *graph;
+	rte_graph_t id;
+	int ret = TEST_FAILED;
+
+	TEST_ASSERT_SUCCESS(ct4_configure(ct4_rcu, CT4_TEST_MAX_FLOWS),
+			    "Failed to configure conntrack");
+	/* Connections are not re-armed earlier when their timeout shrinks */
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN, 1);
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSED, 1);
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_UDP, 1);
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_UDP_STREAM, 1);
+
+	id = ct4_graph_create("ct4_track");
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		goto reset;
+	}
+	graph = rte_graph_lookup("ct4_track");
+
+	/* UDP flow with a reply */
+	udp = ct4_walk(graph, ct4_pkt(IPPROTO_UDP, 1000, false, 0));
+	flow = ct4_walk(graph, ct4_pkt(IPPROTO_UDP, 1000, true, 0));
+	if (udp == UINT32_MAX || (udp & 1) != 0 || flow != (udp | 1)) {
+		printf("UDP reply not tracked: %#x %#x\n", udp, flow);
+		goto fail;
+	}
+
+	/* TCP connection established */
+	tcp = ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1001, false, RTE_TCP_SYN_FLAG));
+	ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1001, true,
+				RTE_TCP_SYN_FLAG | RTE_TCP_ACK_FLAG));
+	flow = ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1001, false, RTE_TCP_ACK_FLAG));
+	if (tcp == UINT32_MAX || tcp == udp || flow != tcp) {
+		printf("TCP connection not tracked: %#x %#x\n", tcp, flow);
+		goto fail;
+	}
+
+	/* TCP connection closed from both sides */
+	closed = ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1002, false, RTE_TCP_SYN_FLAG));
+	ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1002, true,
+				RTE_TCP_SYN_FLAG | RTE_TCP_ACK_FLAG));
+	ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1002, false, RTE_TCP_ACK_FLAG));
+	ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1002, false,
+				RTE_TCP_FIN_FLAG | RTE_TCP_ACK_FLAG));
+	flow = ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1002, true,
+				       RTE_TCP_FIN_FLAG | RTE_TCP_ACK_FLAG));
+	if (closed == UINT32_MAX || flow != (closed | 1)) {
+		printf("TCP connection close not tracked: %#x %#x\n", closed, flow);
+		goto fail;
+	}
+
+	/* The graph does not walk, only the UDP and closed connections expire */
+	ct4_wait_expiry();
+	if (rte_node_conntrack4_expire() != 2) {
+		printf("Idle connections not expired\n");
+		goto fail;
+	}
+	rte_node_conntrack4_stats_get(&stats);
+	if (stats.created != 3 || stats.expired != 2 || stats.active != 1) {
+		printf("Unexpected stats: created %" PRIu64 " expired %" PRIu64
+		       " active %" PRIu64 "\n", stats.created, stats.expired,
+		       stats.active);
+		goto fail;
+	}
+
+	/* The established connection is still tracked */
+	flow = ct4_walk(graph, ct4_pkt(IPPROTO_TCP, 1001, true, RTE_TCP_ACK_FLAG));
+	if (flow != (tcp | 1)) {
+		printf("Established connection lost: %#x %#x\n", tcp, flow);
+		goto fail;
+	}
+
+	/* The expired flow is tracked as a new connection */
+	flow = ct4_walk(graph, ct4_pkt(IPPROTO_UDP, 1000, false, 0));
+	rte_node_conntrack4_stats_get(&stats);
+	if (flow == UINT32_MAX || (flow & 1) != 0 || stats.created != 4) {
+		printf("Expired flow not tracked again: %#x\n", flow);
+		goto fail;
+	}
+
+	ret = TEST_SUCCESS;
+fail:
+	rte_graph_destroy(id);
+reset:
+	ct4_timeouts_reset();
+	return ret;
+}
+
+/*
+ * Fill the table, and check that the entries of the expired connections
+ * are reused once the lcores went through a quiescent state.
+ */
+static int
+test_conntrack4_reuse(void)
+{
+	struct rte_node_conntrack4_stats stats;
+	struct rte_graph *graph;
+	uint32_t flow;
+	rte_graph_t id;
+	int ret = TEST_FAILED;
+	uint16_t i;
+
+	TEST_ASSERT_SUCCESS(ct4_configure(ct4_rcu, CT4_TEST_MAX_FLOWS),
+			    "Failed to configure conntrack");
+	rte_node_conntrack4_timeout_set(RTE_NODE_CONNTRACK4_TIMEOUT_UDP, 1);
+
+	id = ct4_graph_create("ct4_reuse");
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		goto reset;
+	}
+	graph = rte_graph_lookup("ct4_reuse");
+
+	for (i = 0; i < CT4_TEST_MAX_FLOWS; i++) {
+		if (ct4_walk(graph, ct4_pkt(IPPROTO_UDP, 2000 + i, false, 0)) ==
+		    UINT32_MAX) {
+			printf("Flow %u not tracked\n", i);
+			goto fail;
+		}
+	}
+
+	/* Table is full */
+	if (ct4_walk(graph, ct4_pkt(IPPROTO_UDP, 3000, false, 0)) != UINT32_MAX) {
+		printf("Flow tracked in a full table\n");
+		goto fail;
+	}
+	rte_node_conntrack4_stats_get(&stats);
+	if (stats.insert_failed != 1) {
+		printf("Insert failure not counted\n");
+		goto fail;
+	}
+
+	/*
+	 * The graph expires its connections when it walks again,
+	 * their entries are reused after it reported a quiescent state.
+	 */
+	ct4_wait_expiry();
+	if (ct4_walk(graph, ct4_pkt(IPPROTO_UDP, 3000, false, 0)) != UINT32_MAX) {
+		printf("Expired entry reused during its grace period\n");
+		goto fail;
+	}
+	for (i = 0; i < CT4_TEST_MAX_FLOWS; i++) {
+		flow = ct4_walk(graph, ct4_pkt(IPPROTO_UDP, 3001 + i, false, 0));
+		if (flow == UINT32_MAX || (flow >> 1) >= CT4_TEST_MAX_FLOWS) {
+			printf("Expired entry not reused for flow %u\n", i);
+			goto fail;
+		}
+	}
+	rte_node_conntrack4_stats_get(&stats);
+	if (stats.expired != CT4_TEST_MAX_FLOWS || stats.active != CT4_TEST_MAX_FLOWS) {
+		printf("Unexpected stats: expired %" PRIu64 " active %" PRIu64 "\n",
+		       stats.expired, stats.active);
+		goto fail;
+	}
+
+	ret = TEST_SUCCESS;
+fail:
+	rte_graph_destroy(id);
+reset:
+	ct4_timeouts_reset();
+	return ret;
+}
+
+/* Without RCU QSBR variable, only one graph may track connections. */
+static int
+test_conntrack4_single_graph(void)
+{
+	rte_graph_t id, id2 = RTE_GRAPH_ID_INVALID;
+	int ret = TEST_FAILED;
+
+	TEST_ASSERT_SUCCESS(ct4_configure(NULL, CT4_TEST_MAX_FLOWS),
+			    "Failed to configure conntrack");
+
+	id = ct4_graph_create("ct4_single0");
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		return TEST_FAILED;
+	}
+
+	id2 = ct4_graph_create("ct4_single1");
+	if (id2 != RTE_GRAPH_ID_INVALID) {
+		printf("Second graph created without RCU\n");
+		goto fail;
+	}
+
+	if (rte_node_conntrack4_expire() != -ENOTSUP) {
+		printf("Connections expired without RCU\n");
+		goto fail;
+	}
+
+	ret = TEST_SUCCESS;
+fail:
+	if (id2 != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(id2);
+	rte_graph_destroy(id);
+	return ret;
+}
+
+static struct unit_test_suite conntrack4_testsuite = {
+	.suite_name = "IPv4 conntrack node test suite",
+	.setup = ct4_testsuite_setup,
+	.teardown = ct4_testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_conntrack4_track_expire),
+		TEST_CASE(test_conntrack4_reuse),
+		TEST_CASE(test_conntrack4_single_graph),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_conntrack4(void)
+{
+	return unit_test_suite_runner(&conntrack4_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_conntrack4_autotest, NOHUGE_OK, ASAN_OK, test_node_conntrack4);
@@ -0,0 +1,608 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_ip6_local(void)
+{
+	printf("node_ip6_local not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_errno.h>
+#include <rte_eth_ring.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_icmp.h>
+#include <rte_ip6.h>
+#include <rte_mbuf.h>
+#include <rte_node_eth_api.h>
+#include <rte_node_ip6_api.h>
+#include <rte_node_udp6_input_api.h>
+#include <rte_ring.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#define IP6_TEST_BURST 8
+#define IP6_TEST_NB_MBUFS 64
+#define IP6_TEST_UDP_PORT 4789
+
+#define NDP_TYPE_NS 135
+#define NDP_TYPE_NA 136
+#define NDP_OPT_SLLA 1
+#define NDP_OPT_TLLA 2
+
+#define NDP_NA_F_ROUTER RTE_BE32(0x80000000)
+#define NDP_NA_F_SOLICITED RTE_BE32(0x40000000)
+#define NDP_NA_F_OVERRIDE RTE_BE32(0x20000000)
+
+/* Neighbor solicitation or advertisement with a link-layer address option */
+struct ndp_msg {
+	struct rte_icmp_base_hdr base;
+	rte_be32_t flags;
+	struct rte_ipv6_addr target;
+	uint8_t opt_type;
+	uint8_t opt_len;
+	struct rte_ether_addr opt_mac;
+};
+
+/* Documentation addresses (RFC 3849) */
+static const struct rte_ipv6_addr local_ip = RTE_IPV6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 1);
+static const struct rte_ipv6_addr remote_ip = RTE_IPV6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 2);
+static const struct rte_ether_addr remote_mac = {
+	.addr_bytes = {0x02, 0x00, 0x00, 0x00, 0x00, 0x02} };
+
+static struct rte_mempool *ip6_pool;
+static struct rte_ring *ip6_ring;
+static struct rte_ether_addr port_mac;
+static rte_graph_t ip6_graph_id = RTE_GRAPH_ID_INVALID;
+static struct rte_graph *ip6_graph;
+static rte_edge_t ndp_tx_edge;
+static uint16_t ip6_port;
+
+/* Packets injected by the source node on its next walk */
+static struct rte_mbuf *src_pkts[IP6_TEST_BURST];
+static uint16_t src_nb_pkts;
+
+/* Packets received by the UDP user node and sent out by ip6_ndp */
+static struct rte_mbuf *udp_pkts[IP6_TEST_BURST];
+static uint16_t udp_nb_pkts;
+static struct rte_mbuf *tx_pkts[IP6_TEST_BURST];
+static uint16_t tx_nb_pkts;
+
+static uint16_t
+test_ip6_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	uint16_t i, n = src_nb_pkts;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	for (i = 0; i < n; i++)
+		rte_node_enqueue_x1(graph, node, 0, src_pkts[i]);
+	src_nb_pkts = 0;
+
+	return n;
+}
+
+static uint16_t
+test_ip6_sink(struct rte_mbuf **pkts, uint16_t *nb_pkts, void **objs,
+	      uint16_t nb_objs)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_objs && *nb_pkts < IP6_TEST_BURST; i++)
+		pkts[(*nb_pkts)++] = objs[i];
+	for (; i < nb_objs; i++)
+		rte_pktmbuf_free(objs[i]);
+
+	return nb_objs;
+}
+
+static uint16_t
+test_ip6_udp_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+		  uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return test_ip6_sink(udp_pkts, &udp_nb_pkts, objs, nb_objs);
+}
+
+static uint16_t
+test_ip6_tx_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return test_ip6_sink(tx_pkts, &tx_nb_pkts, objs, nb_objs);
+}
+
+static struct rte_node_register test_ip6_source_node = {
+	.name = "test_ip6_source",
+	.process = test_ip6_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"ip6_local"},
+};
+RTE_NODE_REGISTER(test_ip6_source_node);
+
+static struct rte_node_register test_ip6_udp_sink_node = {
+	.name = "test_ip6_udp_sink",
+	.process = test_ip6_udp_sink,
+};
+RTE_NODE_REGISTER(test_ip6_udp_sink_node);
+
+static struct rte_node_register test_ip6_tx_sink_node = {
+	.name = "test_ip6_tx_sink",
+	.process = test_ip6_tx_sink,
+};
+RTE_NODE_REGISTER(test_ip6_tx_sink_node);
+
+/* Build an IPv6 packet received on the test port, with an empty payload. */
+static struct rte_mbuf *
+ip6_pkt(const struct rte_ipv6_addr *src, const struct rte_ipv6_addr *dst,
+	uint8_t proto, uint16_t payload_len)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv6_hdr *ip;
+	struct rte_mbuf *m;
+
+	m = rte_pktmbuf_alloc(ip6_pool);
+	if (m == NULL)
+		return NULL;
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m,
+			sizeof(*eth) + sizeof(*ip) + payload_len);
+	if (eth == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(eth, 0, m->data_len);
+	rte_ether_addr_copy(&remote_mac, &eth->src_addr);
+	rte_ether_addr_copy(&port_mac, &eth->dst_addr);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+
+	ip = (struct rte_ipv6_hdr *)(eth + 1);
+	ip->vtc_flow = RTE_BE32(6 << 28);
+	ip->payload_len = rte_cpu_to_be_16(payload_len);
+	ip->proto = proto;
+	ip->hop_limits = 64;
+	ip->src_addr = *src;
+	ip->dst_addr = *dst;
+	m->port = ip6_port;
+
+	return m;
+}
+
+static struct rte_mbuf *
+udp6_pkt(uint16_t dst_port)
+{
+	struct rte_udp_hdr *udp;
+	struct rte_mbuf *m;
+
+	m = ip6_pkt(&remote_ip, &local_ip, IPPROTO_UDP, sizeof(*udp));
+	if (m == NULL)
+		return NULL;
+	udp = rte_pktmbuf_mtod_offset(m, struct rte_udp_hdr *,
+			sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv6_hdr));
+	udp->src_port = rte_cpu_to_be_16(1024);
+	udp->dst_port = rte_cpu_to_be_16(dst_port);
+	udp->dgram_len = rte_cpu_to_be_16(sizeof(*udp));
+
+	return m;
+}
+
+/*
+ * Build a neighbor solicitation for 'target', with a source link-layer
+ * address option if 'slla' is set.
+ */
+static struct rte_mbuf *
+ns_pkt(const struct rte_ipv6_addr *src, const struct rte_ipv6_addr *dst,
+       const struct rte_ipv6_addr *target, bool slla)
+{
+	struct rte_ipv6_hdr *ip;
+	struct ndp_msg *msg;
+	struct rte_mbuf *m;
+	uint16_t len;
+
+	len = slla ? sizeof(*msg) : offsetof(struct ndp_msg, opt_type);
+	m = ip6_pkt(src, dst, IPPROTO_ICMPV6, len);
+	if (m == NULL)
+		return NULL;
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *,
+			sizeof(struct rte_ether_hdr));
+	ip->hop_limits = 255;
+	msg = (struct ndp_msg *)(ip + 1);
+	msg->base.type = NDP_TYPE_NS;
+	msg->target = *target;
+	if (slla) {
+		msg->opt_type = NDP_OPT_SLLA;
+		msg->opt_len = 1;
+		rte_ether_addr_copy(&remote_mac, &msg->opt_mac);
+	}
+	msg->base.checksum = rte_ipv6_udptcp_cksum(ip, msg);
+
+	return m;
+}
+
+/* Walk the graph with one packet. */
+static void
+ip6_walk(struct rte_mbuf *m)
+{
+	udp_nb_pkts = 0;
+	tx_nb_pkts = 0;
+	if (m == NULL)
+		return;
+
+	src_pkts[0] = m;
+	src_nb_pkts = 1;
+	rte_graph_walk(ip6_graph);
+}
+
+static void
+ip6_sinks_free(void)
+{
+	rte_pktmbuf_free_bulk(udp_pkts, udp_nb_pkts);
+	udp_nb_pkts = 0;
+	rte_pktmbuf_free_bulk(tx_pkts, tx_nb_pkts);
+	tx_nb_pkts = 0;
+}
+
+/*
+ * Check the advertisement sent by ip6_ndp for 'target', to 'dst' and with
+ * the given flags.
+ */
+static int
+na_check(const struct rte_ipv6_addr *target, const struct rte_ipv6_addr *dst,
+	 rte_be32_t flags)
+{
+	struct rte_ether_addr dst_mac;
+	struct rte_ether_hdr *eth;
+	struct rte_ipv6_hdr *ip;
+	struct ndp_msg *msg;
+	struct rte_mbuf *m;
+
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 1,
+			  "Solicitation not answered");
+	TEST_ASSERT_EQUAL(tx_nb_pkts, 1, "Advertisement not sent out");
+	m = tx_pkts[0];
+	TEST_ASSERT_EQUAL(m->data_len, sizeof(*eth) + sizeof(*ip) + sizeof(*msg),
+			  "Unexpected advertisement length %u", m->data_len);
+
+	eth = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
+	ip = (struct rte_ipv6_hdr *)(eth + 1);
+	msg = (struct ndp_msg *)(ip + 1);
+
+	if (rte_ipv6_addr_is_mcast(dst))
+		rte_ether_mcast_from_ipv6(&dst_mac, dst);
+	else
+		rte_ether_addr_copy(&remote_mac, &dst_mac);
+	TEST_ASSERT(rte_is_same_ether_addr(&eth->dst_addr, &dst_mac),
+		    "Unexpected destination MAC address");
+	TEST_ASSERT(rte_is_same_ether_addr(&eth->src_addr, &port_mac),
+		    "Unexpected source MAC address");
+
+	TEST_ASSERT(rte_ipv6_addr_eq(&ip->src_addr, target),
+		    "Unexpected source address");
+	TEST_ASSERT(rte_ipv6_addr_eq(&ip->dst_addr, dst),
+		    "Unexpected destination address");
+	TEST_ASSERT_EQUAL(ip->hop_limits, 255, "Unexpected hop limit");
+	TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip->payload_len), sizeof(*msg),
+			  "Unexpected payload length");
+	TEST_ASSERT_SUCCESS(rte_ipv6_udptcp_cksum_verify(ip, msg),
+			    "Invalid checksum");
+
+	TEST_ASSERT_EQUAL(msg->base.type, NDP_TYPE_NA, "Not an advertisement");
+	TEST_ASSERT_EQUAL(msg->flags, flags, "Unexpected flags %#x",
+			  rte_be_to_cpu_32(msg->flags));
+	TEST_ASSERT(rte_ipv6_addr_eq(&msg->target, target),
+		    "Unexpected target address");
+	TEST_ASSERT_EQUAL(msg->opt_type, NDP_OPT_TLLA,
+			  "No target link-layer address option");
+	TEST_ASSERT_EQUAL(msg->opt_len, 1, "Unexpected option length");
+	TEST_ASSERT(rte_is_same_ether_addr(&msg->opt_mac, &port_mac),
+		    "Unexpected target link-layer address");
+
+	return TEST_SUCCESS;
+}
+
+static int
+ip6_local_testsuite_setup(void)
+{
+	static const char *patterns[] = {"test_ip6_source"};
+	/* The udp6_input node uses the hash table of the graph socket */
+	struct rte_graph_param gconf = {
+		.socket_id = rte_socket_id(),
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+	};
+	struct rte_node_ethdev_config conf = {
+		.num_tx_queues = 1,
+	};
+	const char *tx_sink = "test_ip6_tx_sink";
+	char name[RTE_NODE_NAMESIZE];
+	rte_node_t nb_edges, ndp;
+	char **edges;
+	int udp_edge;
+	int ret;
+
+	ip6_pool = rte_pktmbuf_pool_create("test_ip6_pool", IP6_TEST_NB_MBUFS, 0, 0,
+					   RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (ip6_pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	/* Port for the ethdev_tx node of the advertisements */
+	ip6_ring = rte_ring_create("test_ip6_ring", IP6_TEST_BURST, SOCKET_ID_ANY,
+				   RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (ip6_ring == NULL) {
+		printf("Failed to create ring\n");
+		goto fail;
+	}
+	ret = rte_eth_from_rings("net_ring_test_ip6", &ip6_ring, 1, &ip6_ring, 1,
+				 SOCKET_ID_ANY);
+	if (ret < 0) {
+		printf("Failed to create ring port\n");
+		goto fail;
+	}
+	ip6_port = ret;
+	rte_eth_macaddr_get(ip6_port, &port_mac);
+
+	/* The ethdev_tx node of the port is left by a previous run */
+	snprintf(name, sizeof(name), "ethdev_tx-%u", ip6_port);
+	if (rte_node_from_name(name) == RTE_NODE_ID_INVALID) {
+		conf.port_id = ip6_port;
+		ret = rte_node_eth_config(&conf, 1, 1);
+		if (ret < 0) {
+			printf("Failed to configure ethdev nodes: %d\n", ret);
+			goto close;
+		}
+	}
+
+	/* The advertisements are received by the sink instead of ethdev_tx */
+	ndp = rte_node_from_name("ip6_ndp");
+	nb_edges = rte_node_edge_get(ndp, NULL);
+	edges = malloc(nb_edges);
+	if (edges == NULL)
+		goto close;
+	rte_node_edge_get(ndp, edges);
+	for (ndp_tx_edge = 0; ndp_tx_edge < nb_edges / sizeof(char *); ndp_tx_edge++)
+		if (strcmp(edges[ndp_tx_edge], name) == 0)
+			break;
+	free(edges);
+	if (rte_node_edge_update(ndp, ndp_tx_edge, &tx_sink, 1) ==
+	    RTE_EDGE_ID_INVALID) {
+		printf("Failed to update ip6_ndp edges\n");
+		goto close;
+	}
+
+	ret = rte_node_ip6_ndp_addr_add(ip6_port, &local_ip);
+	if (ret < 0) {
+		printf("Failed to add local address: %d\n", ret);
+		goto close;
+	}
+
+	udp_edge = rte_node_udp6_usr_node_add("test_ip6_udp_sink");
+	if (udp_edge <= 0) {
+		printf("Failed to add UDP user node\n");
+		goto close;
+	}
+
+	ip6_graph_id = rte_graph_create("test_ip6_local", &gconf);
+	if (ip6_graph_id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		goto close;
+	}
+	ip6_graph = rte_graph_lookup("test_ip6_local");
+
+	/* The hash table of the destination ports is created with the graph */
+	ret = rte_node_udp6_dst_port_add(IP6_TEST_UDP_PORT, udp_edge);
+	if (ret < 0) {
+		printf("Failed to add UDP port: %d\n", ret);
+		goto destroy;
+	}
+
+	return TEST_SUCCESS;
+destroy:
+	rte_graph_destroy(ip6_graph_id);
+	ip6_graph_id = RTE_GRAPH_ID_INVALID;
+close:
+	rte_eth_dev_close(ip6_port);
+fail:
+	rte_ring_free(ip6_ring);
+	ip6_ring = NULL;
+	rte_mempool_free(ip6_pool);
+	return TEST_FAILED;
+}
+
+static void
+ip6_local_testsuite_teardown(void)
+{
+	char name[RTE_NODE_NAMESIZE];
+	const char *tx = name;
+
+	rte_graph_destroy(ip6_graph_id);
+	ip6_graph_id = RTE_GRAPH_ID_INVALID;
+
+	snprintf(name, sizeof(name), "ethdev_tx-%u", ip6_port);
+	rte_node_edge_update(rte_node_from_name("ip6_ndp"), ndp_tx_edge, &tx, 1);
+	rte_eth_dev_close(ip6_port);
+	rte_ring_free(ip6_ring);
+	ip6_ring = NULL;
+	rte_mempool_free(ip6_pool);
+}
+
+/* UDP packets go to udp6_input, ICMPv6 to ip6_ndp, others are dropped. */
+static int
+test_ip6_local_dispatch(void)
+{
+	struct rte_ipv6_addr solnode;
+
+	ip6_walk(udp6_pkt(IP6_TEST_UDP_PORT));
+	TEST_ASSERT_EQUAL(udp_nb_pkts, 1, "UDP packet not received");
+	ip6_sinks_free();
+
+	ip6_walk(udp6_pkt(IP6_TEST_UDP_PORT + 1));
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "UDP packet to unknown port not dropped");
+
+	ip6_walk(ip6_pkt(&remote_ip, &local_ip, IPPROTO_TCP,
+			 sizeof(struct rte_tcp_hdr)));
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0, "TCP packet not dropped");
+
+	rte_ipv6_solnode_from_addr(&solnode, &local_ip);
+	ip6_walk(ns_pkt(&remote_ip, &solnode, &local_ip, true));
+	TEST_ASSERT_EQUAL(tx_nb_pkts, 1, "Solicitation not answered");
+	ip6_sinks_free();
+
+	return TEST_SUCCESS;
+}
+
+/* Solicitations are answered with the router flag of the port only. */
+static int
+test_ip6_ndp_reply(void)
+{
+	struct rte_ipv6_addr solnode;
+	int ret;
+
+	rte_ipv6_solnode_from_addr(&solnode, &local_ip);
+
+	ip6_walk(ns_pkt(&remote_ip, &solnode, &local_ip, true));
+	ret = na_check(&local_ip, &remote_ip,
+		       NDP_NA_F_SOLICITED | NDP_NA_F_OVERRIDE);
+	ip6_sinks_free();
+	TEST_ASSERT_SUCCESS(ret, "Unexpected advertisement");
+
+	/* Unicast solicitation, to verify the neighbor reachability */
+	TEST_ASSERT_SUCCESS(rte_node_ip6_ndp_router_set(ip6_port, true),
+			    "Failed to set port as router");
+	ip6_walk(ns_pkt(&remote_ip, &local_ip, &local_ip, false));
+	ret = na_check(&local_ip, &remote_ip, NDP_NA_F_ROUTER |
+		       NDP_NA_F_SOLICITED | NDP_NA_F_OVERRIDE);
+	ip6_sinks_free();
+	rte_node_ip6_ndp_router_set(ip6_port, false);
+	TEST_ASSERT_SUCCESS(ret, "Unexpected router advertisement");
+
+	return TEST_SUCCESS;
+}
+
+/* Duplicate address detection probes are answered to all nodes. */
+static int
+test_ip6_ndp_dad(void)
+{
+	const struct rte_ipv6_addr allnodes = RTE_IPV6_ADDR_ALLNODES_LINK_LOCAL;
+	const struct rte_ipv6_addr unspec = RTE_IPV6_ADDR_UNSPEC;
+	struct rte_ipv6_addr solnode;
+	int ret;
+
+	rte_ipv6_solnode_from_addr(&solnode, &local_ip);
+
+	ip6_walk(ns_pkt(&unspec, &solnode, &local_ip, false));
+	ret = na_check(&local_ip, &allnodes, NDP_NA_F_OVERRIDE);
+	ip6_sinks_free();
+	TEST_ASSERT_SUCCESS(ret, "Unexpected advertisement");
+
+	/* Probes do not carry a source link-layer address */
+	ip6_walk(ns_pkt(&unspec, &solnode, &local_ip, true));
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "Probe with source link-layer address answered");
+
+	/* Probes are sent to the solicited-node multicast address */
+	ip6_walk(ns_pkt(&unspec, &local_ip, &local_ip, false));
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "Probe to unicast address answered");
+	ip6_walk(ns_pkt(&unspec, &allnodes, &local_ip, false));
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "Probe to all nodes answered");
+
+	return TEST_SUCCESS;
+}
+
+/* Invalid solicitations, and solicitations for other targets are dropped. */
+static int
+test_ip6_ndp_invalid(void)
+{
+	struct rte_ipv6_addr solnode;
+	struct rte_ipv6_hdr *ip;
+	struct ndp_msg *msg;
+	struct rte_mbuf *m;
+
+	rte_ipv6_solnode_from_addr(&solnode, &remote_ip);
+	ip6_walk(ns_pkt(&remote_ip, &solnode, &remote_ip, true));
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "Solicitation for another target answered");
+
+	rte_ipv6_solnode_from_addr(&solnode, &local_ip);
+
+	/* Hop limit lower than 255: sent from another link */
+	m = ns_pkt(&remote_ip, &solnode, &local_ip, true);
+	TEST_ASSERT_NOT_NULL(m, "Failed to build packet");
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *,
+			sizeof(struct rte_ether_hdr));
+	ip->hop_limits = 254;
+	ip6_walk(m);
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "Solicitation from another link answered");
+
+	/* Bad checksum */
+	m = ns_pkt(&remote_ip, &solnode, &local_ip, true);
+	TEST_ASSERT_NOT_NULL(m, "Failed to build packet");
+	msg = rte_pktmbuf_mtod_offset(m, struct ndp_msg *,
+			sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv6_hdr));
+	msg->base.checksum ^= 1;
+	ip6_walk(m);
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "Solicitation with bad checksum answered");
+
+	/* Option of length zero */
+	m = ns_pkt(&remote_ip, &solnode, &local_ip, true);
+	TEST_ASSERT_NOT_NULL(m, "Failed to build packet");
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *,
+			sizeof(struct rte_ether_hdr));
+	msg = (struct ndp_msg *)(ip + 1);
+	msg->opt_len = 0;
+	msg->base.checksum = 0;
+	msg->base.checksum = rte_ipv6_udptcp_cksum(ip, msg);
+	ip6_walk(m);
+	TEST_ASSERT_EQUAL(udp_nb_pkts + tx_nb_pkts, 0,
+			  "Solicitation with empty option answered");
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite node_ip6_local_testsuite = {
+	.suite_name = "Node IPv6 local input unit test suite",
+	.setup = ip6_local_testsuite_setup,
+	.teardown = ip6_local_testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_ip6_local_dispatch),
+		TEST_CASE(test_ip6_ndp_reply),
+		TEST_CASE(test_ip6_ndp_dad),
+		TEST_CASE(test_ip6_ndp_invalid),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_ip6_local(void)
+{
+	return unit_test_suite_runner(&node_ip6_local_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_ip6_local_autotest, NOHUGE_OK, ASAN_OK, test_node_ip6_local);
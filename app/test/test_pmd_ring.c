@@ -544,6 +544,55 @@ test_command_line_ring_port(void)
 	return TEST_SUCCESS;
 }
 
+static int
+test_send_ptr_compress_packets(void)
+{
+	struct rte_mbuf *bufs[RING_SIZE / 2];
+	struct rte_mbuf *pbufs[RING_SIZE];
+	struct rte_mbuf foreign;
+	struct rte_ring *r;
+	int port, ret, i;
+
+	printf("Testing send and receive through a compressed pointer ring\n");
+
+	r = rte_ring_create_elem("RC", sizeof(uint32_t), RING_SIZE, SOCKET0,
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+	TEST_ASSERT_NOT_NULL(r, "rte_ring_create_elem RC failed");
+
+	port = rte_eth_from_rings_ptr_compress("net_ringf", &r, 1, &r, 1,
+			SOCKET0, mp);
+	TEST_ASSERT(port >= 0, "rte_eth_from_rings_ptr_compress failed");
+	TEST_ASSERT(test_ethdev_configure_port(port) == 0,
+			"test ethdev configure port %d failed", port);
+
+	ret = rte_pktmbuf_alloc_bulk(mp, bufs, RTE_DIM(bufs));
+	TEST_ASSERT(ret == 0, "mbuf allocation failed");
+
+	/* an mbuf out of the mempool is not sent */
+	memcpy(pbufs, bufs, sizeof(bufs));
+	pbufs[RTE_DIM(bufs) - 1] = &foreign;
+	ret = rte_eth_tx_burst(port, 0, pbufs, RTE_DIM(bufs));
+	TEST_ASSERT(ret == (int)RTE_DIM(bufs) - 1,
+			"unexpected number of packets sent: %d", ret);
+	ret = rte_eth_tx_burst(port, 0, &bufs[RTE_DIM(bufs) - 1], 1);
+	TEST_ASSERT(ret == 1, "failed to send the last packet");
+
+	ret = rte_eth_rx_burst(port, 0, pbufs, RING_SIZE);
+	TEST_ASSERT(ret == (int)RTE_DIM(bufs),
+			"unexpected number of packets received: %d", ret);
+	for (i = 0; i < ret; i++)
+		TEST_ASSERT(pbufs[i] == bufs[i],
+				"received data does not match that transmitted");
+
+	rte_pktmbuf_free_bulk(bufs, RTE_DIM(bufs));
+	TEST_ASSERT(rte_eth_dev_stop(port) == 0, "failed to stop port %d",
+			port);
+	rte_vdev_uninit("net_ring_net_ringf");
+	rte_ring_free(r);
+
+	return TEST_SUCCESS;
+}
+
 static int
 test_ethdev_configure_ports(void)
 {
@@ -583,6 +632,7 @@ unit_test_suite test_pmd_ring_suite  = {
 		TEST_CASE(test_stats_reset_for_port),
 		TEST_CASE(test_pmd_ring_pair_create_attach),
 		TEST_CASE(test_command_line_ring_port),
+		TEST_CASE(test_send_ptr_compress_packets),
 		TEST_CASES_END()
 	}
 };
@@ -0,0 +1,331 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_launch.h>
+#include <rte_pause.h>
+#include <rte_pqueue.h>
+#include <rte_random.h>
+
+#include "test.h"
+
+#define PQ_NAME "test_pqueue"
+#define PQ_SIZE 1024
+#define PQ_PRIO 8
+#define MAX_BULK 32
+#define MT_OBJS_PER_LCORE 100000
+
+struct pq_obj {
+	uint32_t prio;
+	uint32_t seq;
+};
+
+static const struct {
+	const char *desc;
+	unsigned int flags;
+} sync_modes[] = {
+	{ "MP/MC", 0 },
+	{ "SP/SC", RING_F_SP_ENQ | RING_F_SC_DEQ },
+	{ "MP_RTS/MC_RTS", RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ },
+	{ "MP_HTS/MC_HTS", RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ },
+};
+
+static int
+test_pqueue_basic(void)
+{
+	struct rte_pqueue *pq, *pq2;
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE,
+			       0, rte_socket_id(), 0);
+	TEST_ASSERT(pq == NULL && rte_errno == EINVAL,
+		    "Created a priority queue without priority levels");
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE,
+			       RTE_PQUEUE_PRIO_MAX + 1, rte_socket_id(), 0);
+	TEST_ASSERT(pq == NULL && rte_errno == EINVAL,
+		    "Created a priority queue with too many levels");
+
+	pq = rte_pqueue_create(PQ_NAME, 6, PQ_SIZE, PQ_PRIO,
+			       rte_socket_id(), 0);
+	TEST_ASSERT(pq == NULL && rte_errno == EINVAL,
+		    "Created a priority queue with an invalid object size");
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE + 1,
+			       PQ_PRIO, rte_socket_id(), 0);
+	TEST_ASSERT(pq == NULL && rte_errno == EINVAL,
+		    "Created a priority queue with an invalid size");
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE,
+			       PQ_PRIO, rte_socket_id(), RTE_BIT32(31));
+	TEST_ASSERT(pq == NULL && rte_errno == EINVAL,
+		    "Created a priority queue with invalid flags");
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE,
+			       PQ_PRIO, rte_socket_id(), RING_F_EXACT_SZ);
+	TEST_ASSERT_NOT_NULL(pq, "Failed to create the priority queue");
+	TEST_ASSERT_EQUAL(pq->capacity, PQ_SIZE, "Unexpected capacity %u",
+			  pq->capacity);
+
+	pq2 = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE,
+				PQ_PRIO, rte_socket_id(), 0);
+	TEST_ASSERT(pq2 == NULL && rte_errno == EEXIST,
+		    "Created two priority queues with the same name");
+
+	TEST_ASSERT(rte_pqueue_lookup(PQ_NAME) == pq,
+		    "Failed to lookup the priority queue");
+	TEST_ASSERT(rte_pqueue_lookup("none") == NULL && rte_errno == ENOENT,
+		    "Found a priority queue which does not exist");
+
+	rte_pqueue_free(pq);
+	TEST_ASSERT(rte_pqueue_lookup(PQ_NAME) == NULL,
+		    "Found a freed priority queue");
+
+	return TEST_SUCCESS;
+}
+
+/* Enqueue at random priorities, check the dequeue order */
+static int
+test_pqueue_order(unsigned int flags)
+{
+	struct pq_obj objs[MAX_BULK], out[PQ_SIZE];
+	uint32_t seq[PQ_PRIO] = {0}, next[PQ_PRIO] = {0};
+	struct rte_pqueue *pq;
+	unsigned int i, n, prio, total = 0, deq = 0;
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE,
+			       PQ_PRIO, rte_socket_id(), flags);
+	TEST_ASSERT_NOT_NULL(pq, "Failed to create the priority queue");
+
+	while (total < PQ_SIZE / 2) {
+		prio = rte_rand_max(PQ_PRIO);
+		n = 1 + rte_rand_max(MAX_BULK);
+		for (i = 0; i < n; i++) {
+			objs[i].prio = prio;
+			objs[i].seq = seq[prio] + i;
+		}
+		n = rte_pqueue_enqueue_bulk_elem(pq, objs, sizeof(objs[0]), n,
+						 prio, NULL);
+		seq[prio] += n;
+		total += n;
+	}
+	TEST_ASSERT_EQUAL(rte_pqueue_count(pq), total,
+			  "Unexpected count %u", rte_pqueue_count(pq));
+
+	while (!rte_pqueue_empty(pq)) {
+		n = rte_pqueue_dequeue_burst_elem(pq, &out[deq],
+						  sizeof(out[0]),
+						  1 + rte_rand_max(MAX_BULK),
+						  NULL);
+		deq += n;
+	}
+	TEST_ASSERT_EQUAL(deq, total, "Dequeued %u of %u objects", deq, total);
+
+	for (i = 0; i < deq; i++) {
+		TEST_ASSERT(i == 0 || out[i].prio >= out[i - 1].prio,
+			    "Object %u of priority %u after priority %u",
+			    i, out[i].prio, out[i - 1].prio);
+		TEST_ASSERT_EQUAL(out[i].seq, next[out[i].prio]++,
+				  "Object %u out of order", i);
+	}
+
+	rte_pqueue_free(pq);
+
+	return TEST_SUCCESS;
+}
+
+/* Bulk operations are all or nothing, and a bulk dequeue does not mix levels */
+static int
+test_pqueue_bulk(unsigned int flags)
+{
+	void *objs[MAX_BULK], *out[MAX_BULK];
+	struct rte_pqueue *pq;
+	unsigned int i, n, prio, avail;
+
+	for (i = 0; i < MAX_BULK; i++)
+		objs[i] = (void *)(uintptr_t)(i + 1);
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(void *), MAX_BULK, PQ_PRIO,
+			       rte_socket_id(), flags | RING_F_EXACT_SZ);
+	TEST_ASSERT_NOT_NULL(pq, "Failed to create the priority queue");
+
+	n = rte_pqueue_enqueue_bulk(pq, objs, MAX_BULK, PQ_PRIO - 1, NULL);
+	TEST_ASSERT_EQUAL(n, MAX_BULK, "Failed to fill the lowest level");
+	n = rte_pqueue_enqueue_bulk(pq, objs, 1, PQ_PRIO - 1, NULL);
+	TEST_ASSERT_EQUAL(n, 0, "Enqueued to a full level");
+	n = rte_pqueue_enqueue_burst(pq, objs, 1, PQ_PRIO - 1, NULL);
+	TEST_ASSERT_EQUAL(n, 0, "Enqueued to a full level");
+	TEST_ASSERT_EQUAL(rte_pqueue_prio_free_count(pq, PQ_PRIO - 1), 0,
+			  "Full level has free entries");
+
+	n = rte_pqueue_enqueue_bulk(pq, objs, 2, 1, NULL);
+	TEST_ASSERT_EQUAL(n, 2, "Failed to enqueue at priority 1");
+
+	/* Only two objects at the highest non-empty level */
+	n = rte_pqueue_dequeue_bulk(pq, out, 4, &prio);
+	TEST_ASSERT_EQUAL(n, 0, "Bulk dequeue mixed priority levels");
+	n = rte_pqueue_dequeue_bulk(pq, out, 2, &prio);
+	TEST_ASSERT(n == 2 && prio == 1 && out[0] == objs[0] &&
+		    out[1] == objs[1], "Unexpected bulk dequeue");
+
+	n = rte_pqueue_dequeue_bulk(pq, out, 4, &prio);
+	TEST_ASSERT(n == 4 && prio == PQ_PRIO - 1,
+		    "Failed to bulk dequeue from the lowest level");
+	n = rte_pqueue_dequeue_burst(pq, out, MAX_BULK, &avail);
+	TEST_ASSERT(n == MAX_BULK - 4 && avail == 0 && out[0] == objs[4],
+		    "Unexpected burst dequeue");
+	TEST_ASSERT(rte_pqueue_empty(pq), "Priority queue not empty");
+
+	n = rte_pqueue_dequeue_burst(pq, out, MAX_BULK, NULL);
+	TEST_ASSERT_EQUAL(n, 0, "Dequeued from an empty priority queue");
+
+	rte_pqueue_free(pq);
+
+	return TEST_SUCCESS;
+}
+
+struct mt_args {
+	struct rte_pqueue *pq;
+	uint64_t sum;
+	unsigned int count;
+};
+
+static RTE_ATOMIC(uint32_t) mt_producers;
+
+static int
+mt_producer(void *arg)
+{
+	struct mt_args *args = arg;
+	struct pq_obj objs[MAX_BULK];
+	unsigned int i, n, prio, done = 0;
+
+	while (done < MT_OBJS_PER_LCORE) {
+		prio = rte_rand_max(PQ_PRIO);
+		n = RTE_MIN(1 + rte_rand_max(MAX_BULK),
+			    MT_OBJS_PER_LCORE - done);
+		for (i = 0; i < n; i++) {
+			objs[i].prio = prio;
+			objs[i].seq = done + i;
+		}
+		n = rte_pqueue_enqueue_burst_elem(args->pq, objs,
+						  sizeof(objs[0]), n, prio,
+						  NULL);
+		for (i = 0; i < n; i++)
+			args->sum += objs[i].seq;
+		done += n;
+		if (n == 0)
+			rte_pause();
+	}
+
+	rte_atomic_fetch_sub_explicit(&mt_producers, 1,
+				      rte_memory_order_release);
+
+	return 0;
+}
+
+static int
+mt_consumer(void *arg)
+{
+	struct mt_args *args = arg;
+	struct pq_obj objs[MAX_BULK];
+	unsigned int i, n;
+
+	for (;;) {
+		n = rte_pqueue_dequeue_burst_elem(args->pq, objs,
+						  sizeof(objs[0]), MAX_BULK,
+						  NULL);
+		for (i = 0; i < n; i++)
+			args->sum += objs[i].seq;
+		args->count += n;
+		if (n != 0)
+			continue;
+		if (rte_atomic_load_explicit(&mt_producers,
+					     rte_memory_order_acquire) == 0 &&
+		    rte_pqueue_empty(args->pq))
+			break;
+		rte_pause();
+	}
+
+	return 0;
+}
+
+/* Concurrent producers and consumers must not lose or duplicate objects */
+static int
+test_pqueue_mt(unsigned int flags)
+{
+	struct mt_args args[RTE_MAX_LCORE];
+	unsigned int lcore_id, nb_prod = 0, nb = 0;
+	uint64_t prod_sum = 0, cons_sum = 0, cons_count = 0;
+	struct rte_pqueue *pq;
+
+	if (rte_lcore_count() < 3)
+		return TEST_SKIPPED;
+
+	pq = rte_pqueue_create(PQ_NAME, sizeof(struct pq_obj), PQ_SIZE,
+			       PQ_PRIO, rte_socket_id(), flags);
+	TEST_ASSERT_NOT_NULL(pq, "Failed to create the priority queue");
+
+	memset(args, 0, sizeof(args));
+	/* Single producer/consumer modes get one thread on each side */
+	nb_prod = (flags & RING_F_SP_ENQ) ? 1 : (rte_lcore_count() - 1) / 2;
+	rte_atomic_store_explicit(&mt_producers, nb_prod,
+				  rte_memory_order_relaxed);
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		args[lcore_id].pq = pq;
+		if (nb < nb_prod)
+			rte_eal_remote_launch(mt_producer, &args[lcore_id],
+					      lcore_id);
+		else if (nb == nb_prod || !(flags & RING_F_SC_DEQ))
+			rte_eal_remote_launch(mt_consumer, &args[lcore_id],
+					      lcore_id);
+		else
+			break;
+		nb++;
+	}
+	rte_eal_mp_wait_lcore();
+
+	nb = 0;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (nb < nb_prod)
+			prod_sum += args[lcore_id].sum;
+		else {
+			cons_sum += args[lcore_id].sum;
+			cons_count += args[lcore_id].count;
+		}
+		nb++;
+	}
+
+	rte_pqueue_free(pq);
+
+	TEST_ASSERT_EQUAL(cons_count, (uint64_t)nb_prod * MT_OBJS_PER_LCORE,
+			  "Dequeued %" PRIu64 " objects", cons_count);
+	TEST_ASSERT_EQUAL(cons_sum, prod_sum, "Objects lost or duplicated");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_pqueue(void)
+{
+	unsigned int i;
+
+	if (test_pqueue_basic() != TEST_SUCCESS)
+		return TEST_FAILED;
+
+	for (i = 0; i < RTE_DIM(sync_modes); i++) {
+		printf("Testing %s priority queue\n", sync_modes[i].desc);
+		if (test_pqueue_order(sync_modes[i].flags) != TEST_SUCCESS ||
+		    test_pqueue_bulk(sync_modes[i].flags) != TEST_SUCCESS ||
+		    test_pqueue_mt(sync_modes[i].flags) == TEST_FAILED)
+			return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+REGISTER_FAST_TEST(pqueue_autotest, NOHUGE_SKIP, ASAN_OK, test_pqueue);
@@ -0,0 +1,223 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <rte_cycles.h>
+#include <rte_launch.h>
+#include <rte_pause.h>
+#include <rte_pqueue.h>
+#include <rte_random.h>
+
+#include "test.h"
+
+#define PQ_NAME "PQUEUE_PERF"
+#define MAX_BURST 32
+#define PQ_SIZE 4096
+
+/*
+ * Enqueue/dequeue bulk sizes, marked volatile so they aren't treated as
+ * compile-time constants.
+ */
+static volatile unsigned int bulk_sizes[] = {1, 8, MAX_BURST};
+
+/* Number of priority levels, to show the cost of scanning the levels. */
+static const unsigned int prio_levels[] = {1, 8, RTE_PQUEUE_PRIO_MAX};
+
+static const struct {
+	const char *desc;
+	unsigned int flags;
+} sync_modes[] = {
+	{ "MP/MC", 0 },
+	{ "SP/SC", RING_F_SP_ENQ | RING_F_SC_DEQ },
+	{ "MP_RTS/MC_RTS", RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ },
+	{ "MP_HTS/MC_HTS", RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ },
+};
+
+static RTE_ATOMIC(uint32_t) lcore_barrier;
+
+/* Measure the cycle cost of dequeuing from an empty priority queue. */
+static void
+test_empty_dequeue(struct rte_pqueue *pq)
+{
+	unsigned int iterations = 10000000;
+	void *objs[MAX_BURST];
+	unsigned int i;
+
+	uint64_t start = rte_rdtsc();
+
+	for (i = 0; i < iterations; i++)
+		rte_pqueue_dequeue_burst(pq, objs, bulk_sizes[0], NULL);
+
+	uint64_t end = rte_rdtsc();
+
+	printf("Empty dequeue: %.2F\n", (double)(end - start) / iterations);
+}
+
+/*
+ * Measure the cost of bulk enqueue and dequeue on a single lcore, the
+ * objects being enqueued at the lowest priority level so that a dequeue
+ * has to scan all levels.
+ */
+static void
+test_bulk_enqueue_dequeue(struct rte_pqueue *pq)
+{
+	unsigned int iterations = 4000000;
+	unsigned int prio = pq->nb_prio - 1;
+	void *objs[MAX_BURST] = {0};
+	unsigned int sz, i;
+
+	for (sz = 0; sz < RTE_DIM(bulk_sizes); sz++) {
+		uint64_t start = rte_rdtsc();
+
+		for (i = 0; i < iterations; i++) {
+			rte_pqueue_enqueue_bulk(pq, objs, bulk_sizes[sz], prio,
+						NULL);
+			rte_pqueue_dequeue_bulk(pq, objs, bulk_sizes[sz],
+						NULL);
+		}
+
+		uint64_t end = rte_rdtsc();
+
+		printf("Average cycles per object enqueue/dequeue (bulk size: %u): %.2F\n",
+		       bulk_sizes[sz],
+		       (double)(end - start) / (iterations * bulk_sizes[sz]));
+	}
+}
+
+struct thread_args {
+	struct rte_pqueue *pq;
+	unsigned int sz;
+	double avg;
+};
+
+/*
+ * Measure the average per-object cycle cost of enqueue and dequeue at
+ * random priorities, with all lcores working on the priority queue.
+ */
+static int
+bulk_enqueue_dequeue(void *p)
+{
+	unsigned int iterations = 1000000;
+	struct thread_args *args = p;
+	void *objs[MAX_BURST] = {0};
+	struct rte_pqueue *pq;
+	unsigned int size, i, n;
+
+	pq = args->pq;
+	size = args->sz;
+
+	rte_atomic_fetch_sub_explicit(&lcore_barrier, 1, rte_memory_order_relaxed);
+	rte_wait_until_equal_32((uint32_t *)(uintptr_t)&lcore_barrier, 0,
+				rte_memory_order_relaxed);
+
+	uint64_t start = rte_rdtsc();
+
+	for (i = 0; i < iterations; i++) {
+		rte_pqueue_enqueue_burst(pq, objs, size,
+					 rte_rand_max(pq->nb_prio), NULL);
+		n = 0;
+		while (n == 0)
+			n = rte_pqueue_dequeue_burst(pq, objs, size, NULL);
+	}
+
+	uint64_t end = rte_rdtsc();
+
+	args->avg = ((double)(end - start)) / (iterations * size);
+
+	return 0;
+}
+
+/* Run bulk_enqueue_dequeue() simultaneously on n lcores. */
+static void
+run_on_n_cores(struct rte_pqueue *pq, lcore_function_t fn, unsigned int n)
+{
+	struct thread_args args[RTE_MAX_LCORE];
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(bulk_sizes); i++) {
+		unsigned int lcore_id;
+		unsigned int cnt = 0;
+		double avg;
+
+		rte_atomic_store_explicit(&lcore_barrier, n, rte_memory_order_relaxed);
+
+		RTE_LCORE_FOREACH_WORKER(lcore_id) {
+			if (++cnt >= n)
+				break;
+
+			args[lcore_id].pq = pq;
+			args[lcore_id].sz = bulk_sizes[i];
+
+			if (rte_eal_remote_launch(fn, &args[lcore_id],
+						  lcore_id))
+				rte_panic("Failed to launch lcore %d\n",
+					  lcore_id);
+		}
+
+		lcore_id = rte_lcore_id();
+
+		args[lcore_id].pq = pq;
+		args[lcore_id].sz = bulk_sizes[i];
+
+		fn(&args[lcore_id]);
+
+		rte_eal_mp_wait_lcore();
+
+		avg = args[rte_lcore_id()].avg;
+
+		cnt = 0;
+		RTE_LCORE_FOREACH_WORKER(lcore_id) {
+			if (++cnt >= n)
+				break;
+			avg += args[lcore_id].avg;
+		}
+
+		printf("Average cycles per object enqueue/dequeue (bulk size: %u): %.2F\n",
+		       bulk_sizes[i], avg / n);
+	}
+}
+
+static int
+test_pqueue_perf(void)
+{
+	struct rte_pqueue *pq;
+	unsigned int m, p;
+
+	for (m = 0; m < RTE_DIM(sync_modes); m++) {
+		for (p = 0; p < RTE_DIM(prio_levels); p++) {
+			pq = rte_pqueue_create(PQ_NAME, sizeof(void *),
+					       PQ_SIZE, prio_levels[p],
+					       rte_socket_id(),
+					       sync_modes[m].flags);
+			if (pq == NULL) {
+				printf("[%s():%u] failed to create a priority queue\n",
+				       __func__, __LINE__);
+				return -1;
+			}
+
+			printf("\n### %s, %u priority levels ###\n",
+			       sync_modes[m].desc, prio_levels[p]);
+
+			test_empty_dequeue(pq);
+			test_bulk_enqueue_dequeue(pq);
+
+			/* Single producer/consumer modes stay on one lcore */
+			if (!(sync_modes[m].flags &
+			      (RING_F_SP_ENQ | RING_F_SC_DEQ))) {
+				printf("Testing on all %u lcores\n",
+				       rte_lcore_count());
+				run_on_n_cores(pq, bulk_enqueue_dequeue,
+					       rte_lcore_count());
+			}
+
+			rte_pqueue_free(pq);
+		}
+	}
+
+	return 0;
+}
+
+REGISTER_PERF_TEST(pqueue_perf_autotest, test_pqueue_perf);
@@ -24,6 +24,7 @@
 #include <rte_malloc.h>
 #include <rte_ring.h>
 #include <rte_ring_elem.h>
+#include <rte_ring_ptr_compress.h>
 #include <rte_random.h>
 #include <rte_errno.h>
 #include <rte_hexdump.h>
@@ -1197,6 +1198,105 @@ test_ring_with_exact_size(void)
 	return -1;
 }
 
+/*
+ * Pass pointers through rings of compressed pointers, of every sync type.
+ */
+#define PTR_COMPRESS_RING_SIZE	64
+#define PTR_COMPRESS_NB_OBJS	256
+#define PTR_COMPRESS_MAX_BULK	48
+
+static int
+test_ring_ptr_compress(void)
+{
+	static const unsigned int flags[] = {
+		RING_F_SP_ENQ | RING_F_SC_DEQ,
+		0,
+		RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ,
+		RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ,
+	};
+	static alignas(RTE_CACHE_LINE_SIZE)
+		uint8_t objs[PTR_COMPRESS_NB_OBJS][RTE_CACHE_LINE_SIZE];
+	const uint8_t shift =
+		RTE_PTR_COMPRESS_BIT_SHIFT_FROM_ALIGNMENT(RTE_CACHE_LINE_SIZE);
+	void *src[PTR_COMPRESS_MAX_BULK];
+	void *dst[PTR_COMPRESS_MAX_BULK];
+	struct rte_ring *r;
+	unsigned int i, j, n, ret, free_space, avail;
+
+	printf("Test compressed pointer ring\n");
+
+	for (i = 0; i < RTE_DIM(flags); i++) {
+		r = rte_ring_create_elem("ptr_compress", sizeof(uint32_t),
+				PTR_COMPRESS_RING_SIZE, SOCKET_ID_ANY, flags[i]);
+		if (r == NULL) {
+			printf("%s: error, can't create ring\n", __func__);
+			return -1;
+		}
+
+		/* odd sizes, so that the ring storage wraps around */
+		for (n = 1; n <= PTR_COMPRESS_MAX_BULK; n += 7) {
+			for (j = 0; j < n; j++)
+				src[j] = objs[rte_rand_max(PTR_COMPRESS_NB_OBJS)];
+
+			ret = rte_ring_enqueue_bulk_ptr_compress(r, src, n,
+					objs, shift, &free_space);
+			TEST_RING_VERIFY(ret == n, r, goto test_fail);
+			TEST_RING_VERIFY(free_space == rte_ring_free_count(r),
+					r, goto test_fail);
+
+			memset(dst, 0, sizeof(dst));
+			ret = rte_ring_dequeue_bulk_ptr_compress(r, dst, n,
+					objs, shift, &avail);
+			TEST_RING_VERIFY(ret == n, r, goto test_fail);
+			TEST_RING_VERIFY(avail == 0, r, goto test_fail);
+			TEST_RING_VERIFY(memcmp(src, dst, n * sizeof(src[0])) == 0,
+					r, goto test_fail);
+		}
+
+		/* fill the ring: bulk fails, burst is partial */
+		for (j = 0; j < PTR_COMPRESS_MAX_BULK; j++)
+			src[j] = objs[j];
+		ret = rte_ring_enqueue_burst_ptr_compress(r, src,
+				PTR_COMPRESS_MAX_BULK, objs, shift, NULL);
+		TEST_RING_VERIFY(ret == PTR_COMPRESS_MAX_BULK, r,
+				goto test_fail);
+		ret = rte_ring_enqueue_bulk_ptr_compress(r, src,
+				PTR_COMPRESS_MAX_BULK, objs, shift, NULL);
+		TEST_RING_VERIFY(ret == 0, r, goto test_fail);
+		ret = rte_ring_enqueue_burst_ptr_compress(r, src,
+				PTR_COMPRESS_MAX_BULK, objs, shift, &free_space);
+		TEST_RING_VERIFY(ret == rte_ring_get_capacity(r) -
+				PTR_COMPRESS_MAX_BULK, r, goto test_fail);
+		TEST_RING_VERIFY(free_space == 0, r, goto test_fail);
+
+		/* drain it: bulk fails, burst is partial */
+		ret = rte_ring_dequeue_burst_ptr_compress(r, dst,
+				PTR_COMPRESS_MAX_BULK, objs, shift, NULL);
+		TEST_RING_VERIFY(ret == PTR_COMPRESS_MAX_BULK, r,
+				goto test_fail);
+		TEST_RING_VERIFY(memcmp(src, dst, ret * sizeof(src[0])) == 0,
+				r, goto test_fail);
+		ret = rte_ring_dequeue_bulk_ptr_compress(r, dst,
+				PTR_COMPRESS_MAX_BULK, objs, shift, NULL);
+		TEST_RING_VERIFY(ret == 0, r, goto test_fail);
+		ret = rte_ring_dequeue_burst_ptr_compress(r, dst,
+				PTR_COMPRESS_MAX_BULK, objs, shift, &avail);
+		TEST_RING_VERIFY(ret == rte_ring_get_capacity(r) -
+				PTR_COMPRESS_MAX_BULK, r, goto test_fail);
+		TEST_RING_VERIFY(avail == 0, r, goto test_fail);
+		TEST_RING_VERIFY(memcmp(src, dst, ret * sizeof(src[0])) == 0,
+				r, goto test_fail);
+
+		rte_ring_free(r);
+	}
+
+	return 0;
+
+test_fail:
+	rte_ring_free(r);
+	return -1;
+}
+
 static int
 test_ring(void)
 {
@@ -1214,6 +1314,9 @@ test_ring(void)
 	if (test_ring_with_exact_size() < 0)
 		goto test_fail;
 
+	if (test_ring_ptr_compress() < 0)
+		goto test_fail;
+
 	/* Burst and bulk operations with sp/sc, mp/mc and default.
 	 * The test cases are split into smaller test cases to
 	 * help clang compile faster.
@@ -83,6 +83,23 @@
  *      - At initialization, timer3 is loaded by the main core, on
  *        another core in "periodical" mode (time = 1 second).
  *      - It is stopped at t=25s by timer2.
+ *
+ * #. Timer wheel test.
+ *
+ *    This test checks the timing wheel backend of a timer data instance
+ *    allocated with rte_timer_data_alloc_type(), on the main lcore only.
+ *    Each callback checks that the timer does not fire before its expiry.
+ *
+ *    - Half of a set of timers is stopped before expiry, only the other
+ *      half fires, once.
+ *    - A periodical timer fires at each period, until its callback stops it.
+ *    - Timers placed in the first three levels of the wheel are cascaded
+ *      down and fire once, in expiry order.
+ *    - Timers with random expiries fire once.
+ *    - A burst of timers armed with rte_timer_alt_reset_burst() fires once,
+ *      in expiry order, and the timers stopped with
+ *      rte_timer_alt_stop_burst() do not fire. These two cases also run
+ *      with the skiplist backend.
  */
 
 #include <stdio.h>
@@ -602,3 +619,334 @@ test_timer(void)
 }
 
 REGISTER_FAST_TEST(timer_autotest, NOHUGE_SKIP, ASAN_OK, test_timer);
+
+#define WHEEL_NB_TIMER 256
+
+struct wheel_timer_info {
+	struct rte_timer tim;
+	unsigned int count;
+	unsigned int max_count; /* stop a periodical timer after that */
+	unsigned int order; /* order of the first expiry */
+	unsigned int early;
+};
+
+static struct wheel_timer_info wheel_tims[WHEEL_NB_TIMER];
+static uint32_t wheel_data_id;
+static unsigned int wheel_order;
+
+static void
+wheel_timer_cb(struct rte_timer *tim)
+{
+	struct wheel_timer_info *info = tim->arg;
+
+	if (rte_get_timer_cycles() < tim->expire)
+		info->early++;
+	if (info->count++ == 0)
+		info->order = ++wheel_order;
+	if (info->max_count != 0 && info->count == info->max_count)
+		rte_timer_alt_stop(wheel_data_id, tim);
+}
+
+static void
+wheel_timer_arm(struct wheel_timer_info *info, uint64_t ticks,
+		enum rte_timer_type type)
+{
+	info->count = 0;
+	info->order = 0;
+	info->early = 0;
+	rte_timer_alt_reset(wheel_data_id, &info->tim, ticks, type,
+			    rte_lcore_id(), NULL, info);
+}
+
+/* run the expired timers until the given delay from now */
+static void
+wheel_manage(uint64_t ticks)
+{
+	uint64_t end = rte_get_timer_cycles() + ticks;
+	unsigned int lcore_id = rte_lcore_id();
+
+	while (rte_get_timer_cycles() < end) {
+		rte_timer_alt_manage(wheel_data_id, &lcore_id, 1,
+				     wheel_timer_cb);
+		rte_delay_us(3);
+	}
+}
+
+static int
+timer_data_setup(enum rte_timer_data_type type)
+{
+	unsigned int i;
+	int ret;
+
+	ret = rte_timer_data_alloc_type(&wheel_data_id, type);
+	if (ret < 0) {
+		printf("Cannot allocate timer data: %d\n", ret);
+		return TEST_FAILED;
+	}
+
+	memset(wheel_tims, 0, sizeof(wheel_tims));
+	for (i = 0; i < WHEEL_NB_TIMER; i++)
+		rte_timer_init(&wheel_tims[i].tim);
+	wheel_order = 0;
+
+	return TEST_SUCCESS;
+}
+
+static int
+timer_wheel_setup(void)
+{
+	return timer_data_setup(RTE_TIMER_DATA_WHEEL);
+}
+
+static int
+timer_skiplist_setup(void)
+{
+	return timer_data_setup(RTE_TIMER_DATA_SKIPLIST);
+}
+
+static void
+timer_wheel_teardown(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < WHEEL_NB_TIMER; i++)
+		rte_timer_alt_stop(wheel_data_id, &wheel_tims[i].tim);
+	rte_timer_data_dealloc(wheel_data_id);
+}
+
+static int
+test_timer_wheel_cancel(void)
+{
+	uint64_t us = rte_get_timer_hz() / US_PER_S;
+	unsigned int i;
+
+	/* within the first two levels of the wheel, up to 2.5 ms */
+	for (i = 0; i < WHEEL_NB_TIMER; i++)
+		wheel_timer_arm(&wheel_tims[i], (i + 1) * 10 * us, SINGLE);
+	for (i = 1; i < WHEEL_NB_TIMER; i += 2) {
+		TEST_ASSERT_SUCCESS(rte_timer_alt_stop(wheel_data_id,
+						       &wheel_tims[i].tim),
+				    "Cannot stop timer %u", i);
+		TEST_ASSERT(!rte_timer_pending(&wheel_tims[i].tim),
+			    "Stopped timer %u still pending", i);
+	}
+
+	wheel_manage(WHEEL_NB_TIMER * 10 * us + 1000 * us);
+
+	for (i = 0; i < WHEEL_NB_TIMER; i++) {
+		TEST_ASSERT_EQUAL(wheel_tims[i].count, (i % 2) ? 0u : 1u,
+				  "Timer %u fired %u times", i,
+				  wheel_tims[i].count);
+		TEST_ASSERT_EQUAL(wheel_tims[i].early, 0u,
+				  "Timer %u fired early", i);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_timer_wheel_periodic(void)
+{
+	uint64_t us = rte_get_timer_hz() / US_PER_S;
+	struct wheel_timer_info *info = &wheel_tims[0];
+	const unsigned int nb_periods = 10;
+
+	/* a period of a level 0 and of a level 1 slot */
+	info->max_count = nb_periods;
+	wheel_timer_arm(info, 100 * us, PERIODICAL);
+	wheel_tims[1].max_count = nb_periods;
+	wheel_timer_arm(&wheel_tims[1], 1000 * us, PERIODICAL);
+
+	wheel_manage(nb_periods * 1000 * us + 2000 * us);
+
+	TEST_ASSERT_EQUAL(info->count, nb_periods,
+			  "Periodical timer fired %u times", info->count);
+	TEST_ASSERT_EQUAL(wheel_tims[1].count, nb_periods,
+			  "Periodical timer fired %u times",
+			  wheel_tims[1].count);
+	TEST_ASSERT(!rte_timer_pending(&info->tim) &&
+		    !rte_timer_pending(&wheel_tims[1].tim),
+		    "Periodical timer still pending after stop");
+	TEST_ASSERT(info->early == 0 && wheel_tims[1].early == 0,
+		    "Periodical timer fired early");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_timer_wheel_cascade(void)
+{
+	uint64_t us = rte_get_timer_hz() / US_PER_S;
+	/*
+	 * With a tick of 1 to 2 us, level 0 covers 256 ticks, level 1
+	 * 65536 ticks and level 2 beyond.
+	 */
+	static const unsigned int delay_us[] = {
+		50, 300, 1000, 20000, 80000, 400000,
+	};
+	unsigned int i;
+
+	/* arm in reverse order of expiry */
+	for (i = 0; i < RTE_DIM(delay_us); i++)
+		wheel_timer_arm(&wheel_tims[i],
+				delay_us[RTE_DIM(delay_us) - 1 - i] * us,
+				SINGLE);
+
+	wheel_manage(delay_us[RTE_DIM(delay_us) - 1] * us + 10000 * us);
+
+	for (i = 0; i < RTE_DIM(delay_us); i++) {
+		TEST_ASSERT_EQUAL(wheel_tims[i].count, 1u,
+				  "Timer of %u us fired %u times",
+				  delay_us[RTE_DIM(delay_us) - 1 - i],
+				  wheel_tims[i].count);
+		TEST_ASSERT_EQUAL(wheel_tims[i].order, RTE_DIM(delay_us) - i,
+				  "Timer of %u us fired out of order",
+				  delay_us[RTE_DIM(delay_us) - 1 - i]);
+		TEST_ASSERT_EQUAL(wheel_tims[i].early, 0u,
+				  "Timer of %u us fired early",
+				  delay_us[RTE_DIM(delay_us) - 1 - i]);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_timer_wheel_random(void)
+{
+	uint64_t max_ticks = 3000 * rte_get_timer_hz() / US_PER_S;
+	unsigned int i;
+
+	/* expiries not aligned on the wheel ticks */
+	for (i = 0; i < WHEEL_NB_TIMER; i++)
+		wheel_timer_arm(&wheel_tims[i], rte_rand_max(max_ticks), SINGLE);
+
+	wheel_manage(max_ticks + max_ticks / 2);
+
+	for (i = 0; i < WHEEL_NB_TIMER; i++) {
+		TEST_ASSERT_EQUAL(wheel_tims[i].count, 1u,
+				  "Timer %u fired %u times", i,
+				  wheel_tims[i].count);
+		TEST_ASSERT_EQUAL(wheel_tims[i].early, 0u,
+				  "Timer %u fired early", i);
+	}
+
+	return TEST_SUCCESS;
+}
+
+/* arm all the timers in reverse order of expiry, with a single call */
+static int
+wheel_timer_arm_burst(uint64_t step)
+{
+	struct rte_timer *tims[WHEEL_NB_TIMER];
+	uint64_t ticks[WHEEL_NB_TIMER];
+	void *args[WHEEL_NB_TIMER];
+	unsigned int i;
+
+	for (i = 0; i < WHEEL_NB_TIMER; i++) {
+		tims[i] = &wheel_tims[i].tim;
+		ticks[i] = (WHEEL_NB_TIMER - i) * step;
+		args[i] = &wheel_tims[i];
+	}
+
+	return rte_timer_alt_reset_burst(wheel_data_id, tims, ticks,
+					 WHEEL_NB_TIMER, SINGLE, rte_lcore_id(),
+					 NULL, args);
+}
+
+static int
+test_timer_burst_arm(void)
+{
+	uint64_t us = rte_get_timer_hz() / US_PER_S;
+	unsigned int i;
+
+	TEST_ASSERT_EQUAL(wheel_timer_arm_burst(10 * us), WHEEL_NB_TIMER,
+			  "Cannot arm a burst of timers");
+	for (i = 0; i < WHEEL_NB_TIMER; i++)
+		TEST_ASSERT(rte_timer_pending(&wheel_tims[i].tim),
+			    "Timer %u of the burst not pending", i);
+
+	wheel_manage(WHEEL_NB_TIMER * 10 * us + 1000 * us);
+
+	for (i = 0; i < WHEEL_NB_TIMER; i++) {
+		TEST_ASSERT_EQUAL(wheel_tims[i].count, 1u,
+				  "Timer %u fired %u times", i,
+				  wheel_tims[i].count);
+		TEST_ASSERT_EQUAL(wheel_tims[i].order, WHEEL_NB_TIMER - i,
+				  "Timer %u fired out of order", i);
+		TEST_ASSERT_EQUAL(wheel_tims[i].early, 0u,
+				  "Timer %u fired early", i);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_timer_burst_cancel(void)
+{
+	uint64_t us = rte_get_timer_hz() / US_PER_S;
+	struct rte_timer *tims[WHEEL_NB_TIMER / 2];
+	unsigned int i;
+
+	TEST_ASSERT_EQUAL(wheel_timer_arm_burst(10 * us), WHEEL_NB_TIMER,
+			  "Cannot arm a burst of timers");
+	for (i = 0; i < WHEEL_NB_TIMER / 2; i++)
+		tims[i] = &wheel_tims[2 * i + 1].tim;
+	TEST_ASSERT_EQUAL(rte_timer_alt_stop_burst(wheel_data_id, tims,
+						   RTE_DIM(tims)),
+			  (int)RTE_DIM(tims), "Cannot stop a burst of timers");
+	for (i = 1; i < WHEEL_NB_TIMER; i += 2)
+		TEST_ASSERT(!rte_timer_pending(&wheel_tims[i].tim),
+			    "Stopped timer %u still pending", i);
+
+	/* stopping stopped timers is allowed */
+	TEST_ASSERT_EQUAL(rte_timer_alt_stop_burst(wheel_data_id, tims,
+						   RTE_DIM(tims)),
+			  (int)RTE_DIM(tims), "Cannot stop stopped timers");
+
+	wheel_manage(WHEEL_NB_TIMER * 10 * us + 1000 * us);
+
+	for (i = 0; i < WHEEL_NB_TIMER; i++) {
+		TEST_ASSERT_EQUAL(wheel_tims[i].count, (i % 2) ? 0u : 1u,
+				  "Timer %u fired %u times", i,
+				  wheel_tims[i].count);
+		TEST_ASSERT_EQUAL(wheel_tims[i].early, 0u,
+				  "Timer %u fired early", i);
+	}
+	/* the even timers fire in reverse order of their index */
+	for (i = 2; i < WHEEL_NB_TIMER; i += 2)
+		TEST_ASSERT(wheel_tims[i].order < wheel_tims[i - 2].order,
+			    "Timer %u fired out of order", i);
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite timer_wheel_testsuite = {
+	.suite_name = "timer wheel autotest",
+	.unit_test_cases = {
+		TEST_CASE_ST(timer_wheel_setup, timer_wheel_teardown,
+			     test_timer_wheel_cancel),
+		TEST_CASE_ST(timer_wheel_setup, timer_wheel_teardown,
+			     test_timer_wheel_periodic),
+		TEST_CASE_ST(timer_wheel_setup, timer_wheel_teardown,
+			     test_timer_wheel_cascade),
+		TEST_CASE_ST(timer_wheel_setup, timer_wheel_teardown,
+			     test_timer_wheel_random),
+		TEST_CASE_ST(timer_wheel_setup, timer_wheel_teardown,
+			     test_timer_burst_arm),
+		TEST_CASE_ST(timer_wheel_setup, timer_wheel_teardown,
+			     test_timer_burst_cancel),
+		TEST_CASE_ST(timer_skiplist_setup, timer_wheel_teardown,
+			     test_timer_burst_arm),
+		TEST_CASE_ST(timer_skiplist_setup, timer_wheel_teardown,
+			     test_timer_burst_cancel),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_timer_wheel(void)
+{
+	return unit_test_suite_runner(&timer_wheel_testsuite);
+}
+
+REGISTER_FAST_TEST(timer_wheel_autotest, NOHUGE_OK, ASAN_OK, test_timer_wheel);
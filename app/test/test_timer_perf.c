@@ -132,3 +132,124 @@ test_timer_perf(void)
 }
 
 REGISTER_PERF_TEST(timer_perf_autotest, test_timer_perf);
+
+#define WHEEL_PERF_TIMERS 10000000
+
+static unsigned int backend_outstanding;
+
+static void
+backend_timer_cb(struct rte_timer *t __rte_unused)
+{
+	backend_outstanding--;
+}
+
+static int
+timer_backend_perf(struct rte_timer *tms, unsigned int nb_timers,
+		   enum rte_timer_data_type type, const char *name)
+{
+	const uint64_t ticks = rte_get_timer_hz() * DELAY_SECONDS;
+	unsigned int lcore_id = rte_lcore_id();
+	uint64_t start_tsc, end_tsc, delay_start;
+	uint64_t manage_max = 0, manage_tsc;
+	unsigned int i, nb_calls = 0;
+	uint32_t timer_data_id;
+	int ret;
+
+	ret = rte_timer_data_alloc_type(&timer_data_id, type);
+	if (ret < 0) {
+		printf("Cannot allocate %s timer data: %d\n", name, ret);
+		return ret;
+	}
+
+	for (i = 0; i < nb_timers; i++)
+		rte_timer_init(&tms[i]);
+
+	start_tsc = rte_rdtsc();
+	for (i = 0; i < nb_timers; i++)
+		rte_timer_alt_reset(timer_data_id, &tms[i], rte_rand() % ticks,
+				    SINGLE, lcore_id, NULL, NULL);
+	end_tsc = rte_rdtsc();
+	printf("%s: arm %u timers: %"PRIu64" cycles per timer\n", name,
+	       nb_timers, (end_tsc - start_tsc) / nb_timers);
+
+	start_tsc = rte_rdtsc();
+	for (i = 0; i < nb_timers; i += 2)
+		rte_timer_alt_stop(timer_data_id, &tms[i]);
+	end_tsc = rte_rdtsc();
+	printf("%s: cancel %u timers: %"PRIu64" cycles per timer\n", name,
+	       nb_timers / 2, (end_tsc - start_tsc) / (nb_timers / 2));
+
+	backend_outstanding = nb_timers / 2;
+	delay_start = rte_get_timer_cycles();
+	while (rte_get_timer_cycles() < delay_start + ticks)
+		do_delay();
+
+	start_tsc = rte_rdtsc();
+	while (backend_outstanding != 0) {
+		manage_tsc = rte_rdtsc();
+		rte_timer_alt_manage(timer_data_id, &lcore_id, 1,
+				     backend_timer_cb);
+		manage_max = RTE_MAX(manage_max, rte_rdtsc() - manage_tsc);
+		nb_calls++;
+	}
+	end_tsc = rte_rdtsc();
+	printf("%s: expire %u timers: %"PRIu64" cycles per callback, "
+	       "%u manage calls, longest %"PRIu64" cycles\n", name,
+	       nb_timers / 2, (end_tsc - start_tsc) / (nb_timers / 2),
+	       nb_calls, manage_max);
+
+	/* staggered expiry, as seen by a polling lcore */
+	for (i = 0; i < nb_timers; i++)
+		rte_timer_alt_reset(timer_data_id, &tms[i], rte_rand() % ticks,
+				    SINGLE, lcore_id, NULL, NULL);
+	backend_outstanding = nb_timers;
+	manage_max = 0;
+	nb_calls = 0;
+	start_tsc = rte_rdtsc();
+	while (backend_outstanding != 0) {
+		manage_tsc = rte_rdtsc();
+		rte_timer_alt_manage(timer_data_id, &lcore_id, 1,
+				     backend_timer_cb);
+		manage_max = RTE_MAX(manage_max, rte_rdtsc() - manage_tsc);
+		nb_calls++;
+	}
+	end_tsc = rte_rdtsc();
+	printf("%s: poll %u timers over %us: %u manage calls, "
+	       "%"PRIu64" cycles per call, longest %"PRIu64" cycles\n\n",
+	       name, nb_timers, DELAY_SECONDS, nb_calls,
+	       (end_tsc - start_tsc) / nb_calls, manage_max);
+
+	rte_timer_data_dealloc(timer_data_id);
+	return 0;
+}
+
+static int
+test_timer_wheel_perf(void)
+{
+	unsigned int nb_timers = WHEEL_PERF_TIMERS;
+	struct rte_timer *tms;
+
+	/* use as many timers as the memory allows */
+	do {
+		tms = rte_malloc(NULL, sizeof(*tms) * nb_timers, 0);
+		if (tms == NULL)
+			nb_timers /= 2;
+	} while (tms == NULL && nb_timers >= 1000);
+	if (tms == NULL) {
+		printf("Cannot allocate timers\n");
+		return TEST_FAILED;
+	}
+
+	if (timer_backend_perf(tms, nb_timers, RTE_TIMER_DATA_SKIPLIST,
+			       "skiplist") < 0 ||
+	    timer_backend_perf(tms, nb_timers, RTE_TIMER_DATA_WHEEL,
+			       "wheel") < 0) {
+		rte_free(tms);
+		return TEST_FAILED;
+	}
+
+	rte_free(tms);
+	return TEST_SUCCESS;
+}
+
+REGISTER_PERF_TEST(timer_wheel_perf_autotest, test_timer_wheel_perf);
@@ -22,21 +22,27 @@ dsw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 	struct dsw_port *port;
 	struct rte_event_ring *in_ring;
 	struct rte_ring *ctl_in_ring;
+	struct rte_ring *order_in_ring;
 	char ring_name[RTE_RING_NAMESIZE];
 	bool implicit_release;
+	bool independent_enq;
 
 	port = &dsw->ports[port_id];
 
 	implicit_release =
 	    !(conf->event_port_cfg & RTE_EVENT_PORT_CFG_DISABLE_IMPL_REL);
 
+	independent_enq =
+	    !!(conf->event_port_cfg & RTE_EVENT_PORT_CFG_INDEPENDENT_ENQ);
+
 	*port = (struct dsw_port) {
 		.id = port_id,
 		.dsw = dsw,
 		.dequeue_depth = conf->dequeue_depth,
 		.enqueue_depth = conf->enqueue_depth,
 		.new_event_threshold = conf->new_event_threshold,
-		.implicit_release = implicit_release
+		.implicit_release = implicit_release,
+		.independent_enq = independent_enq
 	};
 
 	snprintf(ring_name, sizeof(ring_name), "dsw%d_p%u", dev->data->dev_id,
@@ -63,8 +69,25 @@ dsw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 		return -ENOMEM;
 	}
 
+	snprintf(ring_name, sizeof(ring_name), "dsword%d_p%u",
+		 dev->data->dev_id, port_id);
+
+	/* There is at most one message per reorder window slot. */
+	order_in_ring = rte_ring_create_elem(ring_name,
+					     sizeof(struct dsw_order_msg),
+					     DSW_MAX_ORDERED,
+					     dev->data->socket_id,
+					     RING_F_SC_DEQ|RING_F_EXACT_SZ);
+
+	if (order_in_ring == NULL) {
+		rte_ring_free(ctl_in_ring);
+		rte_event_ring_free(in_ring);
+		return -ENOMEM;
+	}
+
 	port->in_ring = in_ring;
 	port->ctl_in_ring = ctl_in_ring;
+	port->order_in_ring = order_in_ring;
 
 	port->load_update_interval =
 		(DSW_LOAD_UPDATE_INTERVAL * rte_get_timer_hz()) / US_PER_S;
@@ -96,6 +119,7 @@ dsw_port_release(void *p)
 
 	rte_event_ring_free(port->in_ring);
 	rte_ring_free(port->ctl_in_ring);
+	rte_ring_free(port->order_in_ring);
 }
 
 static int
@@ -116,12 +140,8 @@ dsw_queue_setup(struct rte_eventdev *dev, uint8_t queue_id,
 	 */
 	if (RTE_EVENT_QUEUE_CFG_SINGLE_LINK & conf->event_queue_cfg)
 		queue->schedule_type = RTE_SCHED_TYPE_ATOMIC;
-	else {
-		if (conf->schedule_type == RTE_SCHED_TYPE_ORDERED)
-			return -ENOTSUP;
-		/* atomic or parallel */
+	else /* atomic, ordered or parallel */
 		queue->schedule_type = conf->schedule_type;
-	}
 
 	rte_bitset_init(queue->serving_ports, DSW_MAX_PORTS);
 	queue->num_serving_ports = 0;
@@ -222,6 +242,7 @@ dsw_info_get(struct rte_eventdev *dev __rte_unused,
 		.max_profiles_per_port = 1,
 		.event_dev_cap = RTE_EVENT_DEV_CAP_BURST_MODE|
 		RTE_EVENT_DEV_CAP_ATOMIC |
+		RTE_EVENT_DEV_CAP_ORDERED |
 		RTE_EVENT_DEV_CAP_PARALLEL |
 		RTE_EVENT_DEV_CAP_DISTRIBUTED_SCHED|
 		RTE_EVENT_DEV_CAP_IMPLICIT_RELEASE_DISABLE|
@@ -279,6 +300,38 @@ initial_flow_to_port_assignment(struct dsw_evdev *dsw)
 	}
 }
 
+static bool
+dsw_has_ordered_queues(struct dsw_evdev *dsw)
+{
+	uint8_t queue_id;
+
+	for (queue_id = 0; queue_id < dsw->num_queues; queue_id++)
+		if (dsw->queues[queue_id].schedule_type ==
+		    RTE_SCHED_TYPE_ORDERED)
+			return true;
+
+	return false;
+}
+
+static void
+dsw_port_order_reset(struct dsw_port *port)
+{
+	uint16_t i;
+
+	port->order_head = 0;
+	port->order_len = 0;
+
+	for (i = 0; i < DSW_MAX_PORTS; i++) {
+		port->order_first[i] = DSW_ORDER_NONE;
+		port->order_last[i] = DSW_ORDER_NONE;
+	}
+
+	port->order_hist_start = 0;
+	port->order_hist_len = 0;
+
+	rte_ring_reset(port->order_in_ring);
+}
+
 static int
 dsw_start(struct rte_eventdev *dev)
 {
@@ -286,6 +339,20 @@ dsw_start(struct rte_eventdev *dev)
 	uint16_t i;
 	uint64_t now;
 
+	dsw->has_ordered_queues = dsw_has_ordered_queues(dsw);
+
+	/* The reorder windows rely on a port forwarding and releasing
+	 * events in the order they were dequeued.
+	 */
+	for (i = 0; i < dsw->num_ports; i++)
+		if (dsw->has_ordered_queues && dsw->ports[i].independent_enq) {
+			DSW_LOG_LINE(ERR, "Port %d is configured for "
+				     "independent enqueue, which is not "
+				     "supported in combination with ordered "
+				     "queues.", i);
+			return -ENOTSUP;
+		}
+
 	dsw->credits_on_loan = 0;
 
 	initial_flow_to_port_assignment(dsw);
@@ -294,6 +361,7 @@ dsw_start(struct rte_eventdev *dev)
 	for (i = 0; i < dsw->num_ports; i++) {
 		dsw->ports[i].measurement_start = now;
 		dsw->ports[i].busy_start = now;
+		dsw_port_order_reset(&dsw->ports[i]);
 	}
 
 	return 0;
@@ -340,6 +408,27 @@ dsw_port_drain_in_ring(uint8_t dev_id, struct dsw_port *port,
 		flush(dev_id, ev, flush_arg);
 }
 
+static void
+dsw_port_drain_order(uint8_t dev_id, struct dsw_port *port,
+		     eventdev_stop_flush_t flush, void *flush_arg)
+{
+	struct dsw_order_msg msg;
+	uint16_t i;
+
+	for (i = 0; i < port->order_len; i++) {
+		uint16_t idx = (port->order_head + i) & DSW_ORDERED_MASK;
+		struct dsw_order_slot *slot = &port->order_slots[idx];
+
+		if (slot->state == DSW_ORDER_STATE_FORWARDED)
+			flush(dev_id, slot->event, flush_arg);
+	}
+
+	while (rte_ring_dequeue_elem(port->order_in_ring, &msg,
+				     sizeof(msg)) == 0)
+		if (!msg.released)
+			flush(dev_id, msg.event, flush_arg);
+}
+
 static void
 dsw_drain(uint8_t dev_id, struct dsw_evdev *dsw,
 	  eventdev_stop_flush_t flush, void *flush_arg)
@@ -355,6 +444,7 @@ dsw_drain(uint8_t dev_id, struct dsw_evdev *dsw,
 		dsw_port_drain_out(dev_id, dsw, port, flush, flush_arg);
 		dsw_port_drain_paused(dev_id, port, flush, flush_arg);
 		dsw_port_drain_in_ring(dev_id, port, flush, flush_arg);
+		dsw_port_drain_order(dev_id, port, flush, flush_arg);
 	}
 }
 
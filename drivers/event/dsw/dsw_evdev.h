@@ -50,6 +50,25 @@
  */
 #define DSW_PARALLEL_FLOWS (1024)
 
+/* RTE_SCHED_TYPE_ORDERED is implemented without a central
+ * reorder point. The port enqueuing an event to an ordered queue
+ * acts as the event's 'sequencer'. It allocates a slot in its reorder
+ * window, and then distributes the event as if it was parallel. The
+ * worker port returns the forwarded (or released) event to the
+ * sequencer, which in turn sends it on only when all events ahead
+ * of it in the window have been returned. DSW_MAX_ORDERED is the
+ * size of the reorder window of each port, and must be a power of
+ * two.
+ */
+#define DSW_MAX_ORDERED (4096)
+#define DSW_ORDERED_MASK (DSW_MAX_ORDERED-1)
+
+/* Marks the end of a list of reorder window slots. */
+#define DSW_ORDER_NONE (UINT16_MAX)
+
+/* Marks a dequeued event not originating from an ordered queue. */
+#define DSW_ORDER_NO_SEQUENCER (UINT8_MAX)
+
 /* 'Background tasks' are polling the control rings for *
  *  migration-related messages, or flush the output buffer (so
  *  buffered events doesn't linger too long). Shouldn't be too low,
@@ -133,6 +152,20 @@ enum dsw_migration_state {
 	DSW_MIGRATION_STATE_UNPAUSING
 };
 
+enum dsw_order_state {
+	DSW_ORDER_STATE_IN_FLIGHT,
+	DSW_ORDER_STATE_FORWARDED,
+	DSW_ORDER_STATE_RELEASED
+};
+
+struct dsw_order_slot {
+	/* The event as forwarded by the worker port. */
+	struct rte_event event;
+	/* Next slot scheduled to the same worker port. */
+	uint16_t next;
+	uint8_t state;
+};
+
 struct __rte_cache_aligned dsw_port {
 	uint16_t id;
 
@@ -152,6 +185,8 @@ struct __rte_cache_aligned dsw_port {
 
 	bool implicit_release;
 
+	bool independent_enq;
+
 	uint16_t pending_releases;
 
 	uint16_t next_parallel_flow_id;
@@ -226,10 +261,37 @@ struct __rte_cache_aligned dsw_port {
 	 */
 	struct rte_event in_buffer[DSW_MAX_EVENTS];
 
+	/* Sequencer state for events this port has enqueued on
+	 * ordered queues. The slots between order_head and
+	 * order_head + order_len are in use, and are also linked
+	 * into per-worker port lists, in the order the events were
+	 * sent to that port.
+	 */
+	uint16_t order_head;
+	uint16_t order_len;
+	uint16_t order_first[DSW_MAX_PORTS];
+	uint16_t order_last[DSW_MAX_PORTS];
+	struct dsw_order_slot order_slots[DSW_MAX_ORDERED];
+
+	/* The sequencer port ids of the events dequeued, but not yet
+	 * forwarded or released, in dequeue order. Only maintained
+	 * in case the device has ordered queues.
+	 */
+	uint16_t order_hist_start;
+	uint16_t order_hist_len;
+	uint8_t order_hist[DSW_MAX_EVENTS];
+
+	uint64_t reordered;
+
 	alignas(RTE_CACHE_LINE_SIZE) struct rte_event_ring *in_ring;
 
 	alignas(RTE_CACHE_LINE_SIZE) struct rte_ring *ctl_in_ring;
 
+	/* Forwarded and released events of which this port is the
+	 * sequencer.
+	 */
+	alignas(RTE_CACHE_LINE_SIZE) struct rte_ring *order_in_ring;
+
 	/* Estimate of current port load. */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int16_t) load;
 	/* Estimate of flows currently migrating to this port. */
@@ -254,6 +316,7 @@ struct dsw_evdev {
 	uint16_t num_ports;
 	struct dsw_queue queues[DSW_MAX_QUEUES];
 	uint8_t num_queues;
+	bool has_ordered_queues;
 	int32_t max_inflight;
 
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) credits_on_loan;
@@ -270,6 +333,12 @@ struct __rte_aligned(4) dsw_ctl_msg {
 	struct dsw_queue_flow qfs[DSW_MAX_FLOWS_PER_MIGRATION];
 };
 
+struct dsw_order_msg {
+	struct rte_event event;
+	uint8_t worker_port_id;
+	uint8_t released;
+};
+
 uint16_t dsw_event_enqueue_burst(void *port,
 				 const struct rte_event events[],
 				 uint16_t events_len);
@@ -303,6 +372,8 @@ dsw_pmd_priv(const struct rte_eventdev *eventdev)
 
 extern int event_dsw_logtype;
 #define RTE_LOGTYPE_EVENT_DSW event_dsw_logtype
+#define DSW_LOG_LINE(level, fmt, ...)				\
+	RTE_LOG_LINE(level, EVENT_DSW, fmt, ## __VA_ARGS__)
 #define DSW_LOG_DP_LINE(level, fmt, ...)				\
 	RTE_LOG_DP_LINE(level, EVENT_DSW, "%s() line %u: " fmt,		\
 		   __func__, __LINE__, ## __VA_ARGS__)
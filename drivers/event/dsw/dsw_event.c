@@ -491,6 +491,14 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 					     qf->queue_id, qf->flow_hash))
 			continue;
 
+		/* Ordered events are spread by their sequencer port,
+		 * and a worker port must return them in the order the
+		 * sequencer sent them, so there is nothing to migrate.
+		 */
+		if (dsw->queues[qf->queue_id].schedule_type ==
+		    RTE_SCHED_TYPE_ORDERED)
+			continue;
+
 		flow_load = dsw_flow_load(burst->count, source_port_load);
 
 		for (port_id = 0; port_id < num_ports; port_id++) {
@@ -676,19 +684,65 @@ dsw_port_buffer_parallel(struct dsw_evdev *dsw, struct dsw_port *source_port,
 	dsw_port_buffer_non_paused(dsw, source_port, dest_port_id, &event);
 }
 
+static void
+dsw_port_buffer_ordered(struct dsw_evdev *dsw, struct dsw_port *source_port,
+			struct rte_event event)
+{
+	uint16_t idx;
+	uint16_t last;
+	uint8_t dest_port_id;
+	struct dsw_order_slot *slot;
+
+	/* The enqueue function has made sure there is room in the
+	 * reorder window.
+	 */
+	RTE_ASSERT(source_port->order_len < DSW_MAX_ORDERED);
+
+	idx = (source_port->order_head + source_port->order_len) &
+		DSW_ORDERED_MASK;
+	source_port->order_len++;
+
+	/* Ordered events are spread across the serving ports in the
+	 * same manner as parallel events, but the application's flow
+	 * id is kept.
+	 */
+	dest_port_id = dsw_schedule(dsw, event.queue_id,
+		dsw_flow_id_hash(dsw_port_get_parallel_flow_id(source_port)));
+
+	slot = &source_port->order_slots[idx];
+	slot->state = DSW_ORDER_STATE_IN_FLIGHT;
+	slot->next = DSW_ORDER_NONE;
+
+	last = source_port->order_last[dest_port_id];
+	if (last == DSW_ORDER_NONE)
+		source_port->order_first[dest_port_id] = idx;
+	else
+		source_port->order_slots[last].next = idx;
+	source_port->order_last[dest_port_id] = idx;
+
+	event.impl_opaque = source_port->id;
+
+	dsw_port_buffer_non_paused(dsw, source_port, dest_port_id, &event);
+}
+
 static void
 dsw_port_buffer_event(struct dsw_evdev *dsw, struct dsw_port *source_port,
 		      const struct rte_event *event)
 {
+	uint8_t schedule_type = dsw->queues[event->queue_id].schedule_type;
 	uint16_t flow_hash;
 	uint8_t dest_port_id;
 
-	if (unlikely(dsw->queues[event->queue_id].schedule_type ==
-		     RTE_SCHED_TYPE_PARALLEL)) {
+	if (unlikely(schedule_type == RTE_SCHED_TYPE_PARALLEL)) {
 		dsw_port_buffer_parallel(dsw, source_port, *event);
 		return;
 	}
 
+	if (unlikely(schedule_type == RTE_SCHED_TYPE_ORDERED)) {
+		dsw_port_buffer_ordered(dsw, source_port, *event);
+		return;
+	}
+
 	flow_hash = dsw_flow_id_hash(event->flow_id);
 
 	if (unlikely(dsw_port_is_flow_paused(source_port, event->queue_id,
@@ -1243,6 +1297,170 @@ dsw_port_handle_confirm(struct dsw_evdev *dsw, struct dsw_port *port)
 	}
 }
 
+static void
+dsw_port_order_drain(struct dsw_evdev *dsw, struct dsw_port *port)
+{
+	while (port->order_len > 0) {
+		struct dsw_order_slot *slot =
+			&port->order_slots[port->order_head];
+		uint8_t state = slot->state;
+		struct rte_event event;
+
+		if (state == DSW_ORDER_STATE_IN_FLIGHT)
+			break;
+
+		event = slot->event;
+
+		/* Free the slot before sending the event on, since
+		 * the event may well be destined for another ordered
+		 * queue, and thus need a slot of its own.
+		 */
+		port->order_head = (port->order_head + 1) & DSW_ORDERED_MASK;
+		port->order_len--;
+
+		if (state == DSW_ORDER_STATE_FORWARDED)
+			dsw_port_buffer_event(dsw, port, &event);
+	}
+}
+
+static void
+dsw_port_order_complete(struct dsw_evdev *dsw, struct dsw_port *port,
+			const struct dsw_order_msg *msg)
+{
+	uint8_t worker_port_id = msg->worker_port_id;
+	uint16_t idx = port->order_first[worker_port_id];
+	struct dsw_order_slot *slot;
+
+	/* A worker port returns the events in the order they were
+	 * sent to it, so the oldest slot sent to the worker port is
+	 * the one completed.
+	 */
+	RTE_VERIFY(idx != DSW_ORDER_NONE);
+
+	slot = &port->order_slots[idx];
+
+	port->order_first[worker_port_id] = slot->next;
+	if (slot->next == DSW_ORDER_NONE)
+		port->order_last[worker_port_id] = DSW_ORDER_NONE;
+
+	if (msg->released)
+		slot->state = DSW_ORDER_STATE_RELEASED;
+	else {
+		slot->event = msg->event;
+		slot->state = DSW_ORDER_STATE_FORWARDED;
+	}
+
+	if (idx != port->order_head) {
+		port->reordered += !msg->released;
+		return;
+	}
+
+	dsw_port_order_drain(dsw, port);
+}
+
+#define DSW_ORDER_DEQUEUE_BURST_SIZE (32)
+
+static void
+dsw_port_order_process(struct dsw_evdev *dsw, struct dsw_port *port)
+{
+	struct dsw_order_msg msgs[DSW_ORDER_DEQUEUE_BURST_SIZE];
+	unsigned int n;
+	unsigned int i;
+
+	/* There can only be messages on the ring in case this port
+	 * has events in its reorder window.
+	 */
+	while (port->order_len > 0) {
+		n = rte_ring_dequeue_burst_elem(port->order_in_ring, msgs,
+						sizeof(msgs[0]),
+						DSW_ORDER_DEQUEUE_BURST_SIZE,
+						NULL);
+
+		for (i = 0; i < n; i++)
+			dsw_port_order_complete(dsw, port, &msgs[i]);
+
+		if (n < DSW_ORDER_DEQUEUE_BURST_SIZE)
+			break;
+	}
+}
+
+static void
+dsw_port_order_return(struct dsw_evdev *dsw, struct dsw_port *port,
+		      uint8_t sequencer_port_id, const struct rte_event *event,
+		      bool released)
+{
+	struct dsw_order_msg msg = {
+		.worker_port_id = port->id,
+		.released = released
+	};
+
+	if (!released)
+		msg.event = *event;
+
+	if (sequencer_port_id == port->id) {
+		dsw_port_order_complete(dsw, port, &msg);
+		return;
+	}
+
+	/* There's always room on the ring, since there is at most
+	 * one message per reorder window slot.
+	 */
+	while (rte_ring_enqueue_elem(dsw->ports[sequencer_port_id].order_in_ring,
+				     &msg, sizeof(msg)) != 0)
+		rte_pause();
+}
+
+static void
+dsw_port_order_record(struct dsw_evdev *dsw, struct dsw_port *port,
+		      const struct rte_event *events, uint16_t num)
+{
+	uint16_t i;
+
+	for (i = 0; i < num; i++) {
+		const struct rte_event *event = &events[i];
+		uint16_t idx = (port->order_hist_start + port->order_hist_len) %
+			DSW_MAX_EVENTS;
+
+		if (dsw->queues[event->queue_id].schedule_type ==
+		    RTE_SCHED_TYPE_ORDERED)
+			port->order_hist[idx] = event->impl_opaque;
+		else
+			port->order_hist[idx] = DSW_ORDER_NO_SEQUENCER;
+
+		port->order_hist_len++;
+	}
+}
+
+static uint8_t
+dsw_port_order_hist_peek(struct dsw_port *port, uint16_t offset)
+{
+	return port->order_hist[(port->order_hist_start + offset) %
+				DSW_MAX_EVENTS];
+}
+
+static uint8_t
+dsw_port_order_hist_pop(struct dsw_port *port)
+{
+	uint8_t sequencer_port_id = dsw_port_order_hist_peek(port, 0);
+
+	port->order_hist_start = (port->order_hist_start + 1) % DSW_MAX_EVENTS;
+	port->order_hist_len--;
+
+	return sequencer_port_id;
+}
+
+static void
+dsw_port_order_release_pending(struct dsw_evdev *dsw, struct dsw_port *port)
+{
+	while (port->order_hist_len > 0) {
+		uint8_t sequencer_port_id = dsw_port_order_hist_pop(port);
+
+		if (sequencer_port_id != DSW_ORDER_NO_SEQUENCER)
+			dsw_port_order_return(dsw, port, sequencer_port_id,
+					      NULL, true);
+	}
+}
+
 static void
 dsw_port_ctl_process(struct dsw_evdev *dsw, struct dsw_port *port)
 {
@@ -1282,6 +1500,12 @@ dsw_port_bg_process(struct dsw_evdev *dsw, struct dsw_port *port)
 	 */
 	dsw_port_ctl_process(dsw, port);
 
+	/* Sending on events which have made it back in order frees
+	 * up reorder window slots, and may unblock other ports'
+	 * ordered events, so this is also done on every iteration.
+	 */
+	dsw_port_order_process(dsw, port);
+
 	/* Always check if a migration is waiting for pending releases
 	 * to arrive, to minimize the amount of time dequeuing events
 	 * from the port is disabled.
@@ -1322,6 +1546,81 @@ dsw_port_flush_out_buffers(struct dsw_evdev *dsw, struct dsw_port *source_port)
 		dsw_port_transmit_buffered(dsw, source_port, dest_port_id);
 }
 
+static __rte_always_inline uint8_t
+dsw_event_op(const struct rte_event *event, bool op_types_known,
+	     uint16_t num_new)
+{
+	if (op_types_known)
+		return num_new > 0 ? RTE_EVENT_OP_NEW : RTE_EVENT_OP_FORWARD;
+
+	return event->op;
+}
+
+/* Check if there is room in the port's reorder window for all
+ * events in the burst which are enqueued on an ordered queue, and
+ * which are not themselves forwarded ordered events (which are
+ * sequenced by their original port).
+ */
+static bool
+dsw_port_order_window_check(struct dsw_evdev *dsw, struct dsw_port *port,
+			    const struct rte_event events[],
+			    uint16_t events_len, bool op_types_known,
+			    uint16_t num_new)
+{
+	uint16_t hist_offset = 0;
+	uint16_t needed = 0;
+	uint16_t i;
+
+	for (i = 0; i < events_len; i++) {
+		const struct rte_event *event = &events[i];
+		uint8_t op = dsw_event_op(event, op_types_known, num_new);
+		bool sequenced = false;
+
+		if (op != RTE_EVENT_OP_NEW) {
+			sequenced = dsw_port_order_hist_peek(port, hist_offset)
+				!= DSW_ORDER_NO_SEQUENCER;
+			hist_offset++;
+		}
+
+		if (op == RTE_EVENT_OP_RELEASE || sequenced)
+			continue;
+
+		if (dsw->queues[event->queue_id].schedule_type ==
+		    RTE_SCHED_TYPE_ORDERED)
+			needed++;
+	}
+
+	return port->order_len + needed <= DSW_MAX_ORDERED;
+}
+
+static void
+dsw_port_buffer_events_ordered(struct dsw_evdev *dsw,
+			       struct dsw_port *source_port,
+			       const struct rte_event events[],
+			       uint16_t events_len, bool op_types_known,
+			       uint16_t num_new)
+{
+	uint16_t i;
+
+	for (i = 0; i < events_len; i++) {
+		const struct rte_event *event = &events[i];
+		uint8_t op = dsw_event_op(event, op_types_known, num_new);
+		uint8_t sequencer_port_id = DSW_ORDER_NO_SEQUENCER;
+
+		if (op != RTE_EVENT_OP_NEW)
+			sequencer_port_id = dsw_port_order_hist_pop(source_port);
+
+		if (sequencer_port_id != DSW_ORDER_NO_SEQUENCER)
+			dsw_port_order_return(dsw, source_port,
+					      sequencer_port_id, event,
+					      op == RTE_EVENT_OP_RELEASE);
+		else if (op != RTE_EVENT_OP_RELEASE)
+			dsw_port_buffer_event(dsw, source_port, event);
+
+		dsw_port_queue_enqueue_stats(source_port, event->queue_id);
+	}
+}
+
 static __rte_always_inline uint16_t
 dsw_event_enqueue_burst_generic(struct dsw_port *source_port,
 				const struct rte_event events[],
@@ -1384,6 +1683,12 @@ dsw_event_enqueue_burst_generic(struct dsw_port *source_port,
 		     source_port->new_event_threshold))
 		return 0;
 
+	if (unlikely(dsw->has_ordered_queues &&
+		     !dsw_port_order_window_check(dsw, source_port, events,
+						  events_len, op_types_known,
+						  num_new)))
+		return 0;
+
 	enough_credits = dsw_port_acquire_credits(dsw, source_port, num_new);
 	if (unlikely(!enough_credits))
 		return 0;
@@ -1399,6 +1704,13 @@ dsw_event_enqueue_burst_generic(struct dsw_port *source_port,
 
 	dsw_port_enqueue_stats(source_port, num_new, num_forward, num_release);
 
+	if (unlikely(dsw->has_ordered_queues)) {
+		dsw_port_buffer_events_ordered(dsw, source_port, events,
+					       events_len, op_types_known,
+					       num_new);
+		goto out;
+	}
+
 	for (i = 0; i < events_len; i++) {
 		const struct rte_event *event = &events[i];
 
@@ -1408,6 +1720,7 @@ dsw_event_enqueue_burst_generic(struct dsw_port *source_port,
 		dsw_port_queue_enqueue_stats(source_port, event->queue_id);
 	}
 
+out:
 	DSW_LOG_DP_PORT_LINE(DEBUG, source_port->id, "%d non-release events "
 			"accepted.", num_new + num_forward);
 
@@ -1549,6 +1862,9 @@ dsw_event_dequeue_burst(void *port, struct rte_event *events, uint16_t num,
 	uint16_t dequeued;
 
 	if (source_port->implicit_release) {
+		if (unlikely(dsw->has_ordered_queues))
+			dsw_port_order_release_pending(dsw, source_port);
+
 		dsw_port_return_credits(dsw, port,
 					source_port->pending_releases);
 
@@ -1587,9 +1903,17 @@ dsw_event_dequeue_burst(void *port, struct rte_event *events, uint16_t num,
 		dsw_port_flush_out_buffers(dsw, port);
 
 #ifdef DSW_SORT_DEQUEUED
-	dsw_stable_sort(events, dequeued, sizeof(events[0]), dsw_cmp_event);
+	/* Ordered events must be returned to their sequencer port in
+	 * the order they were sent.
+	 */
+	if (!dsw->has_ordered_queues)
+		dsw_stable_sort(events, dequeued, sizeof(events[0]),
+				dsw_cmp_event);
 #endif
 
+	if (unlikely(dsw->has_ordered_queues))
+		dsw_port_order_record(dsw, source_port, events, dequeued);
+
 	return dequeued;
 }
 
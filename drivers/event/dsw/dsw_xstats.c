@@ -133,6 +133,10 @@ dsw_xstats_port_get_load(struct dsw_evdev *dsw, uint8_t port_id,
 
 DSW_GEN_PORT_ACCESS_FN(last_bg)
 
+DSW_GEN_PORT_ACCESS_FN(reordered)
+
+DSW_GEN_PORT_ACCESS_FN(order_len)
+
 static struct dsw_xstats_port dsw_port_xstats[] = {
 	{ "port_%u_new_enqueued", dsw_xstats_port_get_new_enqueued,
 	  false },
@@ -163,6 +167,10 @@ static struct dsw_xstats_port dsw_port_xstats[] = {
 	{ "port_%u_load", dsw_xstats_port_get_load,
 	  false },
 	{ "port_%u_last_bg", dsw_xstats_port_get_last_bg,
+	  false },
+	{ "port_%u_reordered", dsw_xstats_port_get_reordered,
+	  false },
+	{ "port_%u_reorder_window", dsw_xstats_port_get_order_len,
 	  false }
 };
 
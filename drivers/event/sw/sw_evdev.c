@@ -24,6 +24,7 @@
 #define MIN_BURST_SIZE_ARG "min_burst"
 #define DEQ_BURST_SIZE_ARG "deq_burst"
 #define REFIL_ONCE_ARG "refill_once"
+#define SCHED_INSTANCES_ARG "sched_instances"
 
 static void
 sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info);
@@ -61,6 +62,12 @@ sw_port_link(struct rte_eventdev *dev, void *port, const uint8_t queues[],
 		if (j < q->cq_num_mapped_cqs)
 			continue;
 
+		/* a running port can only take QIDs of its own scheduler */
+		if (sw->started && p->sched_id != q->sched_id) {
+			rte_errno = EINVAL;
+			break;
+		}
+
 		if (q->type == SW_SCHED_TYPE_DIRECT) {
 			/* check directed qids only map to one port */
 			if (p->num_qids_mapped > 0) {
@@ -359,7 +366,7 @@ sw_init_qid_iqs(struct sw_evdev *sw)
 			continue;
 
 		for (j = 0; j < SW_IQS_MAX; j++)
-			iq_init(sw, &qid->iq[j]);
+			iq_init(&sw->sched[qid->sched_id], &qid->iq[j]);
 	}
 }
 
@@ -375,6 +382,13 @@ sw_qids_empty(struct sw_evdev *sw)
 		}
 	}
 
+	/* events handed over between schedulers are still queued */
+	for (i = 0; i < sw->sched_count; i++) {
+		if (sw->sched[i].handoff_ring != NULL &&
+		    rte_event_ring_count(sw->sched[i].handoff_ring))
+			return 0;
+	}
+
 	return 1;
 }
 
@@ -419,9 +433,9 @@ sw_drain_ports(struct rte_eventdev *dev)
 }
 
 static void
-sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
+sw_drain_queue(struct rte_eventdev *dev, struct sw_sched *sched,
+		struct sw_iq *iq)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
 	eventdev_stop_flush_t flush;
 	uint8_t dev_id;
 	void *arg;
@@ -433,7 +447,7 @@ sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
 	while (iq_count(iq) > 0) {
 		struct rte_event ev;
 
-		iq_dequeue_burst(sw, iq, &ev, 1);
+		iq_dequeue_burst(sched, iq, &ev, 1);
 
 		if (flush)
 			flush(dev_id, ev, arg);
@@ -447,8 +461,11 @@ sw_drain_queues(struct rte_eventdev *dev)
 	unsigned int i, j;
 
 	for (i = 0; i < sw->qid_count; i++) {
+		struct sw_qid *qid = &sw->qids[i];
+
 		for (j = 0; j < SW_IQS_MAX; j++)
-			sw_drain_queue(dev, &sw->qids[i].iq[j]);
+			sw_drain_queue(dev, &sw->sched[qid->sched_id],
+					&qid->iq[j]);
 	}
 }
 
@@ -465,7 +482,8 @@ sw_clean_qid_iqs(struct rte_eventdev *dev)
 		for (j = 0; j < SW_IQS_MAX; j++) {
 			if (!qid->iq[j].head)
 				continue;
-			iq_free_chunk_list(sw, qid->iq[j].head);
+			iq_free_chunk_list(&sw->sched[qid->sched_id],
+					qid->iq[j].head);
 			qid->iq[j].head = NULL;
 		}
 	}
@@ -507,14 +525,18 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 	const struct rte_eventdev_data *data = dev->data;
 	const struct rte_event_dev_config *conf = &data->dev_conf;
+	char buf[RTE_RING_NAMESIZE];
 	int num_chunks, i;
+	uint32_t s;
 
 	sw->qid_count = conf->nb_event_queues;
 	sw->port_count = conf->nb_event_ports;
 	sw->nb_events_limit = conf->nb_events_limit;
 	rte_atomic32_set(&sw->inflights, 0);
 
-	/* Number of chunks sized for worst-case spread of events across IQs */
+	/* Number of chunks sized for worst-case spread of events across IQs,
+	 * for each scheduler instance.
+	 */
 	num_chunks = ((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
 			sw->qid_count*SW_IQS_MAX*2;
 
@@ -526,15 +548,39 @@ sw_dev_configure(const struct rte_eventdev *dev)
 
 	sw->chunks = rte_malloc_socket(NULL,
 				       sizeof(struct sw_queue_chunk) *
-				       num_chunks,
+				       num_chunks * sw->sched_count,
 				       0,
 				       sw->data->socket_id);
 	if (!sw->chunks)
 		return -ENOMEM;
 
-	sw->chunk_list_head = NULL;
-	for (i = 0; i < num_chunks; i++)
-		iq_free_chunk(sw, &sw->chunks[i]);
+	for (s = 0; s < sw->sched_count; s++) {
+		struct sw_sched *sched = &sw->sched[s];
+
+		sched->chunk_list_head = NULL;
+		for (i = 0; i < num_chunks; i++)
+			iq_free_chunk(sched,
+				      &sw->chunks[s * num_chunks + i]);
+
+		/* a single scheduler never hands events over */
+		if (sw->sched_count == 1)
+			continue;
+
+		/* may exist from a previous configuration, see port setup */
+		snprintf(buf, sizeof(buf), "sw%d_s%u_handoff",
+				data->dev_id, s);
+		rte_event_ring_free(rte_event_ring_lookup(buf));
+
+		/* sized to hold every inflight event, so enqueue can't fail */
+		sched->handoff_ring = rte_event_ring_create(buf,
+				SW_INFLIGHT_EVENTS_TOTAL, data->socket_id,
+				RING_F_SC_DEQ | RING_F_EXACT_SZ);
+		if (sched->handoff_ring == NULL) {
+			SW_LOG_ERR("Error creating handoff ring for scheduler %u",
+					s);
+			return -ENOMEM;
+		}
+	}
 
 	if (conf->event_dev_cfg & RTE_EVENT_DEV_CFG_PER_DEQUEUE_TIMEOUT)
 		return -ENOTSUP;
@@ -623,16 +669,43 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	static const char * const q_type_strings[] = {
 			"Ordered", "Atomic", "Parallel", "Directed"
 	};
+	struct sw_point_stats stats = {0};
+	uint64_t sched_called = 0, sched_cq_qid_called = 0;
+	uint64_t sched_no_iq_enqueues = 0, sched_no_cq_enqueues = 0;
 	uint32_t i;
 	fprintf(f, "EventDev %s: ports %d, qids %d\n",
 		dev->data->name, sw->port_count, sw->qid_count);
 
+	for (i = 0; i < sw->sched_count; i++) {
+		const struct sw_sched *sched = &sw->sched[i];
+
+		stats.rx_pkts += sched->stats.rx_pkts;
+		stats.rx_dropped += sched->stats.rx_dropped;
+		stats.tx_pkts += sched->stats.tx_pkts;
+		sched_called += sched->sched_called;
+		sched_cq_qid_called += sched->sched_cq_qid_called;
+		sched_no_iq_enqueues += sched->sched_no_iq_enqueues;
+		sched_no_cq_enqueues += sched->sched_no_cq_enqueues;
+	}
+
 	fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64"\n",
-		sw->stats.rx_pkts, sw->stats.rx_dropped, sw->stats.tx_pkts);
-	fprintf(f, "\tsched calls: %"PRIu64"\n", sw->sched_called);
-	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sw->sched_cq_qid_called);
-	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sw->sched_no_iq_enqueues);
-	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sw->sched_no_cq_enqueues);
+		stats.rx_pkts, stats.rx_dropped, stats.tx_pkts);
+	fprintf(f, "\tsched calls: %"PRIu64"\n", sched_called);
+	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sched_cq_qid_called);
+	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sched_no_iq_enqueues);
+	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sched_no_cq_enqueues);
+	if (sw->sched_count > 1) {
+		for (i = 0; i < sw->sched_count; i++) {
+			const struct sw_sched *sched = &sw->sched[i];
+
+			fprintf(f, "\tsched %u: ports %u, qids %u, rx %"PRIu64
+				", tx %"PRIu64", handoff %"PRIu64
+				", load %"PRIu64"%%\n", i, sched->port_count,
+				sched->qid_count, sched->stats.rx_pkts,
+				sched->stats.tx_pkts, sched->handoff_enqueues,
+				sw_sched_load(sched));
+		}
+	}
 	uint32_t inflights = rte_atomic32_read(&sw->inflights);
 	uint32_t credits = sw->nb_events_limit - inflights;
 	fprintf(f, "\tinflight %d, credits: %d\n", inflights, credits);
@@ -762,19 +835,128 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	}
 }
 
+static uint32_t
+sw_link_group(uint32_t *group, uint32_t node)
+{
+	while (group[node] != node)
+		node = group[node] = group[group[node]];
+	return node;
+}
+
+/* Split the ports and QIDs over the scheduler instances. A port and the QIDs
+ * linked to it are always scheduled by the same instance, as the history
+ * list, flow pinning and reorder state is shared between them. Groups of
+ * linked ports and QIDs are spread over the instances, largest group first.
+ */
+static void
+sw_assign_scheds(struct sw_evdev *sw)
+{
+	/* port i is node i, QID i is node port_count + i */
+	const uint32_t nb_nodes = sw->port_count + sw->qid_count;
+	uint32_t group[SW_PORTS_MAX + RTE_EVENT_MAX_QUEUES_PER_DEV];
+	uint32_t weight[SW_PORTS_MAX + RTE_EVENT_MAX_QUEUES_PER_DEV];
+	uint8_t group_sched[SW_PORTS_MAX + RTE_EVENT_MAX_QUEUES_PER_DEV];
+	uint32_t load[SW_SCHED_MAX] = {0};
+	uint32_t nb_prio[SW_SCHED_MAX] = {0};
+	unsigned int i, j;
+
+	for (i = 0; i < nb_nodes; i++) {
+		group[i] = i;
+		weight[i] = 0;
+	}
+
+	for (i = 0; i < sw->qid_count; i++) {
+		const struct sw_qid *qid = &sw->qids[i];
+
+		for (j = 0; j < qid->cq_num_mapped_cqs; j++) {
+			uint32_t a = sw_link_group(group, sw->port_count + i);
+			uint32_t b = sw_link_group(group, qid->cq_map[j]);
+
+			group[a] = b;
+		}
+	}
+
+	for (i = 0; i < nb_nodes; i++)
+		weight[sw_link_group(group, i)]++;
+
+	for (;;) {
+		uint32_t heaviest = nb_nodes;
+		uint32_t target = 0;
+
+		for (i = 0; i < nb_nodes; i++)
+			if (weight[i] != 0 && (heaviest == nb_nodes ||
+					weight[i] > weight[heaviest]))
+				heaviest = i;
+		if (heaviest == nb_nodes)
+			break;
+
+		for (j = 1; j < sw->sched_count; j++)
+			if (load[j] < load[target])
+				target = j;
+
+		load[target] += weight[heaviest];
+		weight[heaviest] = 0;
+		group_sched[heaviest] = target;
+	}
+
+	for (i = 0; i < sw->sched_count; i++) {
+		sw->sched[i].port_count = 0;
+		sw->sched[i].qid_count = 0;
+	}
+
+	for (i = 0; i < sw->port_count; i++) {
+		struct sw_port *p = &sw->ports[i];
+		struct sw_sched *sched;
+
+		p->sched_id = group_sched[sw_link_group(group, i)];
+		sched = &sw->sched[p->sched_id];
+		sched->port_ids[sched->port_count++] = i;
+	}
+
+	for (i = 0; i < sw->qid_count; i++) {
+		struct sw_qid *qid = &sw->qids[i];
+		struct sw_sched *sched;
+
+		qid->sched_id = group_sched[sw_link_group(group,
+				sw->port_count + i)];
+		sched = &sw->sched[qid->sched_id];
+		sched->qid_ids[sched->qid_count++] = i;
+	}
+
+	/* build up our prioritized array of qids */
+	/* We don't use qsort here, as if all/multiple entries have the same
+	 * priority, the result is non-deterministic. From "man 3 qsort":
+	 * "If two members compare as equal, their order in the sorted
+	 * array is undefined."
+	 */
+	for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
+		for (i = 0; i < sw->qid_count; i++) {
+			struct sw_qid *qid = &sw->qids[i];
+
+			if (qid->priority == j)
+				sw->sched[qid->sched_id].qids_prioritized[
+					nb_prio[qid->sched_id]++] = qid;
+		}
+	}
+}
+
 static int
 sw_start(struct rte_eventdev *dev)
 {
-	unsigned int i, j;
+	unsigned int i;
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 
-	rte_service_component_runstate_set(sw->service_id, 1);
+	for (i = 0; i < sw->sched_count; i++) {
+		struct sw_sched *sched = &sw->sched[i];
+
+		rte_service_component_runstate_set(sched->service_id, 1);
 
-	/* check a service core is mapped to this service */
-	if (!rte_service_runstate_get(sw->service_id)) {
-		SW_LOG_ERR("Warning: No Service core enabled on service %s",
-				sw->service_name);
-		return -ENOENT;
+		/* check a service core is mapped to this service */
+		if (!rte_service_runstate_get(sched->service_id)) {
+			SW_LOG_ERR("Warning: No Service core enabled on service %s",
+					sched->service_name);
+			return -ENOENT;
+		}
 	}
 
 	/* check all ports are set up */
@@ -792,21 +974,7 @@ sw_start(struct rte_eventdev *dev)
 			return -ENOLINK;
 		}
 
-	/* build up our prioritized array of qids */
-	/* We don't use qsort here, as if all/multiple entries have the same
-	 * priority, the result is non-deterministic. From "man 3 qsort":
-	 * "If two members compare as equal, their order in the sorted
-	 * array is undefined."
-	 */
-	uint32_t qidx = 0;
-	for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
-		for (i = 0; i < sw->qid_count; i++) {
-			if (sw->qids[i].priority == j) {
-				sw->qids_prioritized[qidx] = &sw->qids[i];
-				qidx++;
-			}
-		}
-	}
+	sw_assign_scheds(sw);
 
 	sw_init_qid_iqs(sw);
 
@@ -823,15 +991,19 @@ static void
 sw_stop(struct rte_eventdev *dev)
 {
 	struct sw_evdev *sw = sw_pmd_priv(dev);
-	int32_t runstate;
+	int32_t runstate[SW_SCHED_MAX];
+	uint32_t i;
 
-	/* Stop the scheduler if it's running */
-	runstate = rte_service_runstate_get(sw->service_id);
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 0);
+	/* Stop the schedulers if they're running */
+	for (i = 0; i < sw->sched_count; i++) {
+		runstate[i] = rte_service_runstate_get(sw->sched[i].service_id);
+		if (runstate[i] == 1)
+			rte_service_runstate_set(sw->sched[i].service_id, 0);
+	}
 
-	while (rte_service_may_be_active(sw->service_id))
-		rte_pause();
+	for (i = 0; i < sw->sched_count; i++)
+		while (rte_service_may_be_active(sw->sched[i].service_id))
+			rte_pause();
 
 	/* Flush all events out of the device */
 	while (!(sw_qids_empty(sw) && sw_ports_empty(sw))) {
@@ -845,8 +1017,9 @@ sw_stop(struct rte_eventdev *dev)
 	sw->started = 0;
 	rte_smp_wmb();
 
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 1);
+	for (i = 0; i < sw->sched_count; i++)
+		if (runstate[i] == 1)
+			rte_service_runstate_set(sw->sched[i].service_id, 1);
 }
 
 static int
@@ -863,11 +1036,21 @@ sw_close(struct rte_eventdev *dev)
 		sw_port_release(&sw->ports[i]);
 	sw->port_count = 0;
 
-	memset(&sw->stats, 0, sizeof(sw->stats));
-	sw->sched_called = 0;
-	sw->sched_no_iq_enqueues = 0;
-	sw->sched_no_cq_enqueues = 0;
-	sw->sched_cq_qid_called = 0;
+	for (i = 0; i < sw->sched_count; i++) {
+		struct sw_sched *sched = &sw->sched[i];
+
+		rte_event_ring_free(sched->handoff_ring);
+		sched->handoff_ring = NULL;
+
+		memset(&sched->stats, 0, sizeof(sched->stats));
+		sched->sched_called = 0;
+		sched->sched_no_iq_enqueues = 0;
+		sched->sched_no_cq_enqueues = 0;
+		sched->sched_cq_qid_called = 0;
+		sched->handoff_enqueues = 0;
+		sched->busy_cycles = 0;
+		sched->idle_cycles = 0;
+	}
 
 	return 0;
 }
@@ -932,10 +1115,21 @@ set_refill_once(const char *key __rte_unused, const char *value, void *opaque)
 	return 0;
 }
 
+static int
+set_sched_instances(const char *key __rte_unused, const char *value,
+		void *opaque)
+{
+	int *sched_instances = opaque;
+	*sched_instances = atoi(value);
+	if (*sched_instances < 1 || *sched_instances > SW_SCHED_MAX)
+		return -1;
+	return 0;
+}
+
 static int32_t sw_sched_service_func(void *args)
 {
-	struct rte_eventdev *dev = args;
-	return sw_event_schedule(dev);
+	struct sw_sched *sched = args;
+	return sw_sched_schedule(sched);
 }
 
 static int
@@ -980,6 +1174,7 @@ sw_probe(struct rte_vdev_device *vdev)
 		MIN_BURST_SIZE_ARG,
 		DEQ_BURST_SIZE_ARG,
 		REFIL_ONCE_ARG,
+		SCHED_INSTANCES_ARG,
 		NULL
 	};
 	const char *name;
@@ -992,6 +1187,8 @@ sw_probe(struct rte_vdev_device *vdev)
 	int min_burst_size = 1;
 	int deq_burst_size = SCHED_DEQUEUE_DEFAULT_BURST_SIZE;
 	int refill_once = 0;
+	int sched_instances = 1;
+	uint32_t i;
 
 	name = rte_vdev_device_name(vdev);
 	params = rte_vdev_device_args(vdev);
@@ -1063,6 +1260,16 @@ sw_probe(struct rte_vdev_device *vdev)
 				return ret;
 			}
 
+			ret = rte_kvargs_process(kvlist, SCHED_INSTANCES_ARG,
+					set_sched_instances, &sched_instances);
+			if (ret != 0) {
+				SW_LOG_ERR(
+					"%s: Error parsing scheduler instances parameter",
+					name);
+				rte_kvargs_free(kvlist);
+				return ret;
+			}
+
 			rte_kvargs_free(kvlist);
 		}
 	}
@@ -1070,9 +1277,11 @@ sw_probe(struct rte_vdev_device *vdev)
 	SW_LOG_INFO(
 			"Creating eventdev sw device %s, numa_node=%d, "
 			"sched_quanta=%d, credit_quanta=%d "
-			"min_burst=%d, deq_burst=%d, refill_once=%d",
+			"min_burst=%d, deq_burst=%d, refill_once=%d, "
+			"sched_instances=%d",
 			name, socket_id, sched_quanta, credit_quanta,
-			min_burst_size, deq_burst_size, refill_once);
+			min_burst_size, deq_burst_size, refill_once,
+			sched_instances);
 
 	dev = rte_event_pmd_vdev_init(name,
 			sizeof(struct sw_evdev), socket_id, vdev);
@@ -1098,25 +1307,43 @@ sw_probe(struct rte_vdev_device *vdev)
 	sw->sched_min_burst_size = min_burst_size;
 	sw->sched_deq_burst_size = deq_burst_size;
 	sw->refill_once_per_iter = refill_once;
+	sw->sched_count = sched_instances;
 
-	/* register service with EAL */
-	struct rte_service_spec service;
-	memset(&service, 0, sizeof(struct rte_service_spec));
-	snprintf(service.name, sizeof(service.name), "%s_service", name);
-	snprintf(sw->service_name, sizeof(sw->service_name), "%s_service",
-			name);
-	service.socket_id = socket_id;
-	service.callback = sw_sched_service_func;
-	service.callback_userdata = (void *)dev;
-
-	int32_t ret = rte_service_component_register(&service, &sw->service_id);
-	if (ret) {
-		SW_LOG_ERR("service register() failed");
-		return -ENOEXEC;
+	/* register a service with EAL for each scheduler instance, the
+	 * first one being the service of the eventdev
+	 */
+	for (i = 0; i < sw->sched_count; i++) {
+		struct sw_sched *sched = &sw->sched[i];
+		struct rte_service_spec service;
+
+		sched->sw = sw;
+		sched->id = i;
+
+		memset(&service, 0, sizeof(struct rte_service_spec));
+		if (i == 0)
+			snprintf(sched->service_name,
+					sizeof(sched->service_name),
+					"%s_service", name);
+		else
+			snprintf(sched->service_name,
+					sizeof(sched->service_name),
+					"%s_service_%u", name, i);
+		snprintf(service.name, sizeof(service.name), "%s",
+				sched->service_name);
+		service.socket_id = socket_id;
+		service.callback = sw_sched_service_func;
+		service.callback_userdata = sched;
+
+		int32_t ret = rte_service_component_register(&service,
+				&sched->service_id);
+		if (ret) {
+			SW_LOG_ERR("service register() failed");
+			return -ENOEXEC;
+		}
 	}
 
 	dev->data->service_inited = 1;
-	dev->data->service_id = sw->service_id;
+	dev->data->service_id = sw->sched[0].service_id;
 
 	event_dev_probing_finish(dev);
 
@@ -1146,5 +1373,5 @@ RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_SW_PMD, evdev_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(event_sw, NUMA_NODE_ARG "=<int> "
 		SCHED_QUANTA_ARG "=<int>" CREDIT_QUANTA_ARG "=<int>"
 		MIN_BURST_SIZE_ARG "=<int>" DEQ_BURST_SIZE_ARG "=<int>"
-		REFIL_ONCE_ARG "=<int>");
+		REFIL_ONCE_ARG "=<int>" SCHED_INSTANCES_ARG "=<int>");
 RTE_LOG_REGISTER_DEFAULT(eventdev_sw_log_level, NOTICE);
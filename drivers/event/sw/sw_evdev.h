@@ -48,6 +48,9 @@
 
 #define SW_NUM_POLL_BUCKETS (MAX_SW_CONS_Q_DEPTH >> SW_DEQ_STAT_BUCKET_SHIFT)
 
+/* max number of scheduler instances the queues and ports can be split over */
+#define SW_SCHED_MAX 8
+
 enum {
 	QE_FLAG_VALID_SHIFT = 0,
 	QE_FLAG_COMPLETE_SHIFT,
@@ -133,6 +136,9 @@ struct sw_qid {
 	uint32_t window_size;          /* Used to wrap reorder_buffer_index */
 
 	uint8_t priority;
+
+	/* scheduler instance owning this QID, assigned at start */
+	uint8_t sched_id;
 };
 
 struct sw_hist_list_entry {
@@ -207,6 +213,53 @@ struct sw_port {
 	struct rte_event cq_buf[MAX_SW_CONS_Q_DEPTH];
 
 	uint8_t num_qids_mapped;
+
+	/* scheduler instance pulling from and pushing to this port */
+	uint8_t sched_id;
+};
+
+/*
+ * A scheduler instance. The ports and QIDs of the device are split into
+ * groups which share no port-to-QID link, and each group is scheduled by one
+ * instance running in its own service. Events enqueued to a QID owned by
+ * another instance are handed over through that instance's handoff ring.
+ */
+struct sw_sched {
+	struct sw_evdev *sw;
+	uint8_t id;
+
+	/* ports and QIDs scheduled by this instance, in id order */
+	uint32_t port_count;
+	uint32_t qid_count;
+	uint8_t port_ids[SW_PORTS_MAX];
+	uint8_t qid_ids[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	/* Array of pointers to load-balanced QIDs sorted by priority level */
+	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+
+	/* Free IQ chunks of the QIDs owned by this instance */
+	struct sw_queue_chunk *chunk_list_head;
+
+	/* MPSC ring of events sent to this instance's QIDs by the others */
+	struct rte_event_ring *handoff_ring;
+
+	/* Current values */
+	uint32_t sched_flush_count;
+	uint32_t sched_min_burst;
+
+	/* Stats */
+	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
+	uint64_t sched_called;
+	uint64_t sched_no_iq_enqueues;
+	uint64_t sched_no_cq_enqueues;
+	uint64_t sched_cq_qid_called;
+	uint64_t sched_last_iter_bitmask;
+	uint8_t sched_progress_last_iter;
+	uint64_t handoff_enqueues;
+	uint64_t busy_cycles;
+	uint64_t idle_cycles;
+
+	uint32_t service_id;
+	char service_name[SW_PMD_NAME_MAX];
 };
 
 struct sw_evdev {
@@ -226,9 +279,8 @@ struct sw_evdev {
 	uint32_t sched_deq_burst_size;
 	/* Refill pp buffers only once per scheduler call*/
 	uint32_t refill_once_per_iter;
-	/* Current values */
-	uint32_t sched_flush_count;
-	uint32_t sched_min_burst;
+	/* Number of scheduler instances */
+	uint32_t sched_count;
 
 	/* Contains all ports - load balanced and directed */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_port ports[SW_PORTS_MAX];
@@ -243,25 +295,15 @@ struct sw_evdev {
 
 	/* Internal queues - one per logical queue */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_qid qids[RTE_EVENT_MAX_QUEUES_PER_DEV];
-	struct sw_queue_chunk *chunk_list_head;
 	struct sw_queue_chunk *chunks;
 
 	/* Cache how many packets are in each cq */
 	alignas(RTE_CACHE_LINE_SIZE) uint16_t cq_ring_space[SW_PORTS_MAX];
 
-	/* Array of pointers to load-balanced QIDs sorted by priority level */
-	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	/* Scheduler instances, the first sched_count are in use */
+	alignas(RTE_CACHE_LINE_SIZE) struct sw_sched sched[SW_SCHED_MAX];
 
-	/* Stats */
-	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
-	uint64_t sched_called;
 	int32_t sched_quanta;
-	uint64_t sched_no_iq_enqueues;
-	uint64_t sched_no_cq_enqueues;
-	uint64_t sched_cq_qid_called;
-	uint64_t sched_last_iter_bitmask;
-	uint8_t sched_progress_last_iter;
-
 	uint8_t started;
 	uint32_t credit_update_quanta;
 
@@ -271,11 +313,17 @@ struct sw_evdev {
 	/* store num stats and offset of the stats for each queue */
 	uint16_t xstats_count_per_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
 	uint16_t xstats_offset_for_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
-
-	uint32_t service_id;
-	char service_name[SW_PMD_NAME_MAX];
 };
 
+/* percentage of the time a scheduler instance spent doing work */
+static inline uint64_t
+sw_sched_load(const struct sw_sched *sched)
+{
+	const uint64_t total = sched->busy_cycles + sched->idle_cycles;
+
+	return total ? sched->busy_cycles * 100 / total : 0;
+}
+
 static inline struct sw_evdev *
 sw_pmd_priv(const struct rte_eventdev *eventdev)
 {
@@ -294,6 +342,7 @@ uint16_t sw_event_enqueue_burst(void *port, const struct rte_event ev[],
 uint16_t sw_event_dequeue_burst(void *port, struct rte_event *ev, uint16_t num,
 			uint64_t wait);
 int32_t sw_event_schedule(struct rte_eventdev *dev);
+int32_t sw_sched_schedule(struct sw_sched *sched);
 int sw_xstats_init(struct sw_evdev *dev);
 int sw_xstats_uninit(struct sw_evdev *dev);
 int sw_xstats_get_names(const struct rte_eventdev *dev,
@@ -3086,6 +3086,125 @@ ordered_atomic_hist_completion(struct test *t)
 	return 0;
 }
 
+static int
+sched_instances_handoff(struct test *t)
+{
+	const char *eventdev_name = "event_sw_sched2";
+	const int main_evdev = evdev;
+	uint32_t service_id[2];
+	uint64_t handoffs;
+	unsigned int i;
+	int err, ret = -1;
+
+	/* Second device, with its queues split over two scheduler services */
+	evdev = rte_event_dev_get_dev_id(eventdev_name);
+	if (evdev < 0) {
+		if (rte_vdev_init(eventdev_name, "sched_instances=2") < 0) {
+			printf("%d: Error creating eventdev\n", __LINE__);
+			goto out;
+		}
+		evdev = rte_event_dev_get_dev_id(eventdev_name);
+		if (evdev < 0) {
+			printf("%d: Error finding eventdev\n", __LINE__);
+			goto out;
+		}
+	}
+
+	if (rte_service_get_by_name("event_sw_sched2_service",
+				&service_id[0]) < 0 ||
+			rte_service_get_by_name("event_sw_sched2_service_1",
+				&service_id[1]) < 0) {
+		printf("%d: Error finding scheduler services\n", __LINE__);
+		goto out;
+	}
+	for (i = 0; i < RTE_DIM(service_id); i++) {
+		rte_service_runstate_set(service_id[i], 1);
+		rte_service_set_runstate_mapped_check(service_id[i], 0);
+	}
+
+	/* Two ports each linked to their own QID, which end up on different
+	 * scheduler instances, and an unlinked producer port.
+	 */
+	if (init(t, 2, 3) < 0 ||
+			create_ports(t, 3) < 0 ||
+			create_atomic_qids(t, 2) < 0) {
+		printf("%d: Error initializing device\n", __LINE__);
+		goto out;
+	}
+	for (i = 0; i < 2; i++) {
+		if (rte_event_port_link(evdev, t->port[i], &t->qid[i],
+					NULL, 1) != 1) {
+			printf("%d: error mapping qid %u\n", __LINE__, i);
+			goto out_cleanup;
+		}
+	}
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		goto out_cleanup;
+	}
+
+	/* a running port can't be linked to the QID of another instance */
+	if (rte_event_port_link(evdev, t->port[0], &t->qid[1], NULL, 1) != 0) {
+		printf("%d: cross-instance link succeeded\n", __LINE__);
+		goto out_cleanup;
+	}
+
+	/* The producer port belongs to one of the instances, so one of these
+	 * events is handed over to the other instance.
+	 */
+	for (i = 0; i < 2; i++) {
+		struct rte_event ev = {
+			.op = RTE_EVENT_OP_NEW,
+			.queue_id = t->qid[i],
+			.event_type = RTE_EVENT_TYPE_CPU,
+			.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+			.u64 = i,
+		};
+
+		err = rte_event_enqueue_burst(evdev, t->port[2], &ev, 1);
+		if (err != 1) {
+			printf("%d: Failed to enqueue\n", __LINE__);
+			goto out_cleanup;
+		}
+	}
+
+	for (i = 0; i < 4; i++)
+		rte_service_run_iter_on_app_lcore(service_id[i & 1], 1);
+
+	for (i = 0; i < 2; i++) {
+		struct rte_event ev;
+
+		if (rte_event_dequeue_burst(evdev, t->port[i], &ev, 1, 0) != 1 ||
+				ev.u64 != i) {
+			printf("%d: port %u did not get its event\n",
+					__LINE__, i);
+			rte_event_dev_dump(evdev, stdout);
+			goto out_cleanup;
+		}
+		rte_event_enqueue_burst(evdev, t->port[i], &release_ev, 1);
+	}
+
+	handoffs = rte_event_dev_xstats_by_name_get(evdev,
+			"dev_sched_0_handoff_enq", NULL) +
+		rte_event_dev_xstats_by_name_get(evdev,
+			"dev_sched_1_handoff_enq", NULL);
+	if (handoffs != 1) {
+		printf("%d: expected 1 handoff, got %"PRIu64"\n", __LINE__,
+				handoffs);
+		goto out_cleanup;
+	}
+
+	for (i = 0; i < 2; i++)
+		rte_service_run_iter_on_app_lcore(service_id[i], 1);
+
+	ret = 0;
+out_cleanup:
+	cleanup(t);
+out:
+	evdev = main_evdev;
+	return ret;
+}
+
 static int
 worker_loopback_worker_fn(void *arg)
 {
@@ -3521,6 +3640,12 @@ test_sw_eventdev(void)
 		printf("ERROR - Ordered & Atomic hist-list test FAILED.\n");
 		goto test_fail;
 	}
+	printf("*** Running Scheduler Instances Handoff test...\n");
+	ret = sched_instances_handoff(t);
+	if (ret != 0) {
+		printf("ERROR - Scheduler Instances Handoff test FAILED.\n");
+		goto test_fail;
+	}
 	if (rte_lcore_count() >= 3) {
 		printf("*** Running Worker loopback test...\n");
 		ret = worker_loopback(t, 0);
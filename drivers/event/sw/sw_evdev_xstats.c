@@ -19,6 +19,11 @@ enum xstats_type {
 	no_cq_enq,
 	sched_last_iter_bitmask,
 	sched_progress_last_iter,
+	/* scheduler instance specific */
+	handoff_enq,
+	busy_cycles,
+	idle_cycles,
+	load,
 	/* port_specific */
 	rx_used,
 	rx_free,
@@ -49,23 +54,59 @@ struct sw_xstats_entry {
 };
 
 static uint64_t
-get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
+get_sched_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg __rte_unused)
 {
-	switch (type) {
-	case rx: return sw->stats.rx_pkts;
-	case tx: return sw->stats.tx_pkts;
-	case dropped: return sw->stats.rx_dropped;
-	case calls: return sw->sched_called;
-	case no_iq_enq: return sw->sched_no_iq_enqueues;
-	case no_cq_enq: return sw->sched_no_cq_enqueues;
-	case sched_last_iter_bitmask: return sw->sched_last_iter_bitmask;
-	case sched_progress_last_iter: return sw->sched_progress_last_iter;
+	const struct sw_sched *sched = &sw->sched[obj_idx];
 
+	switch (type) {
+	case rx: return sched->stats.rx_pkts;
+	case tx: return sched->stats.tx_pkts;
+	case dropped: return sched->stats.rx_dropped;
+	case calls: return sched->sched_called;
+	case no_iq_enq: return sched->sched_no_iq_enqueues;
+	case no_cq_enq: return sched->sched_no_cq_enqueues;
+	case sched_last_iter_bitmask: return sched->sched_last_iter_bitmask;
+	case sched_progress_last_iter: return sched->sched_progress_last_iter;
+	case handoff_enq: return sched->handoff_enqueues;
+	case busy_cycles: return sched->busy_cycles;
+	case idle_cycles: return sched->idle_cycles;
+	case load: return sw_sched_load(sched);
 	default: return -1;
 	}
 }
 
+static uint64_t
+get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
+		enum xstats_type type, int extra_arg __rte_unused)
+{
+	uint64_t val = 0;
+	uint32_t i;
+
+	/* device stats are the sum over the scheduler instances, except for
+	 * the last iteration ones which tell if any instance made progress
+	 */
+	for (i = 0; i < sw->sched_count; i++) {
+		switch (type) {
+		case rx:
+		case tx:
+		case dropped:
+		case calls:
+		case no_iq_enq:
+		case no_cq_enq:
+			val += get_sched_stat(sw, i, type, 0);
+			break;
+		case sched_last_iter_bitmask:
+		case sched_progress_last_iter:
+			val |= get_sched_stat(sw, i, type, 0);
+			break;
+		default: return -1;
+		}
+	}
+
+	return val;
+}
+
 static uint64_t
 get_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg __rte_unused)
@@ -169,6 +210,7 @@ sw_xstats_init(struct sw_evdev *sw)
 	 * xstats array
 	 * There are multiple set of stats:
 	 *   - device-level,
+	 *   - per-scheduler-instance, when there is more than one,
 	 *   - per-port,
 	 *   - per-port-dequeue-burst-sizes
 	 *   - per-qid,
@@ -190,6 +232,19 @@ sw_xstats_init(struct sw_evdev *sw)
 	};
 	/* all device stats are allowed to be reset */
 
+	static const char * const sched_stats[] = { "rx", "tx", "drop",
+			"calls", "no_iq_enq", "no_cq_enq", "handoff_enq",
+			"busy_cycles", "idle_cycles", "load",
+	};
+	static const enum xstats_type sched_types[] = { rx, tx, dropped,
+			calls, no_iq_enq, no_cq_enq, handoff_enq,
+			busy_cycles, idle_cycles, load,
+	};
+	static const uint8_t sched_reset_allowed[] = {1, 1, 1,
+			1, 1, 1, 1,
+			1, 1, 0,
+	};
+
 	static const char * const port_stats[] = {"rx", "tx", "drop",
 			"inflight", "avg_pkt_cycles", "credits",
 			"rx_ring_used", "rx_ring_free",
@@ -238,6 +293,7 @@ sw_xstats_init(struct sw_evdev *sw)
 	 * joined by the compiler.
 	 */
 	RTE_BUILD_BUG_ON(RTE_DIM(dev_stats) != RTE_DIM(dev_types));
+	RTE_BUILD_BUG_ON(RTE_DIM(sched_stats) != RTE_DIM(sched_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(port_stats) != RTE_DIM(port_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_stats) != RTE_DIM(qid_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_iq_stats) != RTE_DIM(qid_iq_types));
@@ -245,13 +301,16 @@ sw_xstats_init(struct sw_evdev *sw)
 	RTE_BUILD_BUG_ON(RTE_DIM(port_bucket_stats) !=
 			RTE_DIM(port_bucket_types));
 
+	RTE_BUILD_BUG_ON(RTE_DIM(sched_stats) != RTE_DIM(sched_reset_allowed));
 	RTE_BUILD_BUG_ON(RTE_DIM(port_stats) != RTE_DIM(port_reset_allowed));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_stats) != RTE_DIM(qid_reset_allowed));
 
 	/* other vars */
 	const uint32_t cons_bkt_shift =
 		(MAX_SW_CONS_Q_DEPTH >> SW_DEQ_STAT_BUCKET_SHIFT);
+	const uint32_t nb_sched = sw->sched_count > 1 ? sw->sched_count : 0;
 	const unsigned int count = RTE_DIM(dev_stats) +
+			nb_sched * RTE_DIM(sched_stats) +
 			sw->port_count * RTE_DIM(port_stats) +
 			sw->port_count * RTE_DIM(port_bucket_stats) *
 				(cons_bkt_shift + 1) +
@@ -259,7 +318,7 @@ sw_xstats_init(struct sw_evdev *sw)
 			sw->qid_count * SW_IQS_MAX * RTE_DIM(qid_iq_stats) +
 			sw->qid_count * sw->port_count *
 				RTE_DIM(qid_port_stats);
-	unsigned int i, port, qid, iq, bkt, stat = 0;
+	unsigned int i, sched, port, qid, iq, bkt, stat = 0;
 
 	sw->xstats = rte_zmalloc_socket(NULL, sizeof(sw->xstats[0]) * count, 0,
 			sw->data->socket_id);
@@ -276,6 +335,20 @@ sw_xstats_init(struct sw_evdev *sw)
 		};
 		snprintf(sname, sizeof(sname), "dev_%s", dev_stats[i]);
 	}
+
+	for (sched = 0; sched < nb_sched; sched++) {
+		for (i = 0; i < RTE_DIM(sched_stats); i++, stat++) {
+			sw->xstats[stat] = (struct sw_xstats_entry){
+				.fn = get_sched_stat,
+				.obj_idx = sched,
+				.stat = sched_types[i],
+				.mode = RTE_EVENT_DEV_XSTATS_DEVICE,
+				.reset_allowed = sched_reset_allowed[i],
+			};
+			snprintf(sname, sizeof(sname), "dev_sched_%u_%s",
+					sched, sched_stats[i]);
+		}
+	}
 	sw->xstats_count_mode_dev = stat;
 
 	for (port = 0; port < sw->port_count; port++) {
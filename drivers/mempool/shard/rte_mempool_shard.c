@@ -0,0 +1,475 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_memory.h>
+#include <rte_mempool.h>
+#include <rte_ring.h>
+
+#include "rte_mempool_shard.h"
+
+/*
+ * The shard mempool driver splits the common pool into several rings,
+ * one per group of lcores of a NUMA socket, each ring being allocated on
+ * the socket of its lcores.
+ * Every object has a home shard on the socket of its memory, where it is
+ * always enqueued back. An lcore dequeues objects from the shard of its
+ * group, and steals from the other shards of its socket, then from the
+ * remote ones, only when its own is empty.
+ * So the lcores of a group only contend with each other, and with the
+ * lcores giving back the objects they received from this group.
+ */
+
+/* Default maximum number of lcores sharing a shard. */
+#define SHARD_GROUP_LCORES 16
+/* Maximum number of shards. */
+#define SHARD_MAX 16
+/* Number of objects buffered per shard before being enqueued. */
+#define SHARD_BURST 32
+/* No shard assigned to an lcore. */
+#define SHARD_NONE UINT8_MAX
+
+/* Memory chunk of the pool, split between the shards of its socket. */
+struct shard_chunk {
+	uintptr_t start;
+	uintptr_t len;
+	uint8_t first; /**< First shard of the chunk */
+	uint8_t nb;    /**< Number of shards of the chunk */
+};
+
+struct shard_data {
+	unsigned int nb_shards;
+	/** Backing store of each shard, NULL if it has no object */
+	struct rte_ring *rings[SHARD_MAX];
+	unsigned int nb_objs[SHARD_MAX]; /**< Objects homed on each shard */
+	/** Objects of failed gets with RTE_MEMPOOL_F_SP_PUT, or NULL */
+	struct rte_ring *stash;
+	unsigned int rg_flags; /**< Flags of the shard rings */
+	int socket_id[SHARD_MAX]; /**< Socket of each shard */
+	uint8_t lcore_shard[RTE_MAX_LCORE]; /**< Shard of each lcore */
+	/** While populating, count the homed objects instead of storing them */
+	bool counting;
+	unsigned int nb_chunks;
+	struct shard_chunk *chunks;
+};
+
+/* Home shard of an object, among the shards of the socket of its chunk. */
+static __rte_always_inline unsigned int
+shard_home(const struct shard_data *sd, const void *obj)
+{
+	const struct shard_chunk *chunk;
+	uintptr_t off;
+	unsigned int i;
+
+	for (i = 0; i < sd->nb_chunks; i++) {
+		chunk = &sd->chunks[i];
+		off = (uintptr_t)obj - chunk->start;
+		if (off >= chunk->len)
+			continue;
+		if (likely(chunk->nb == 1))
+			return chunk->first;
+		return chunk->first + (uint64_t)off * chunk->nb / chunk->len;
+	}
+	return 0;
+}
+
+/* Shard of the calling thread. */
+static __rte_always_inline unsigned int
+shard_local(const struct shard_data *sd)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int i;
+	int socket_id;
+
+	if (likely(lcore_id < RTE_MAX_LCORE &&
+			sd->lcore_shard[lcore_id] != SHARD_NONE))
+		return sd->lcore_shard[lcore_id];
+
+	/* Non-EAL thread, or lcore registered after the pool creation. */
+	socket_id = (int)rte_socket_id();
+	for (i = 0; i < sd->nb_shards; i++) {
+		if (sd->socket_id[i] == socket_id)
+			return i;
+	}
+	return 0;
+}
+
+static int
+shard_enqueue(struct rte_mempool *mp, void * const *obj_table,
+	unsigned int n)
+{
+	struct shard_data *sd = mp->pool_data;
+	void *objs[SHARD_MAX][SHARD_BURST];
+	unsigned int len[SHARD_MAX];
+	unsigned int i, s;
+
+	if (unlikely(sd->counting)) {
+		for (i = 0; i < n; i++)
+			sd->nb_objs[shard_home(sd, obj_table[i])]++;
+		return 0;
+	}
+
+	/* Each ring can hold all its homed objects, enqueue never fails. */
+	if (sd->nb_shards == 1) {
+		rte_ring_enqueue_bulk(sd->rings[0], obj_table, n, NULL);
+		return 0;
+	}
+
+	memset(len, 0, sizeof(len));
+	for (i = 0; i < n; i++) {
+		s = shard_home(sd, obj_table[i]);
+		objs[s][len[s]++] = obj_table[i];
+		if (unlikely(len[s] == SHARD_BURST)) {
+			rte_ring_enqueue_bulk(sd->rings[s], objs[s],
+				SHARD_BURST, NULL);
+			len[s] = 0;
+		}
+	}
+
+	for (s = 0; s < sd->nb_shards; s++) {
+		if (len[s] != 0)
+			rte_ring_enqueue_bulk(sd->rings[s], objs[s], len[s],
+				NULL);
+	}
+
+	return 0;
+}
+
+static int
+shard_dequeue(struct rte_mempool *mp, void **obj_table, unsigned int n)
+{
+	struct shard_data *sd = mp->pool_data;
+	unsigned int local, got = 0, pass, i, s;
+	bool same_socket;
+
+	local = shard_local(sd);
+	if (likely(sd->rings[local] != NULL)) {
+		got = rte_ring_dequeue_burst(sd->rings[local], obj_table, n,
+			NULL);
+		if (likely(got == n))
+			return 0;
+	}
+
+	/*
+	 * Steal the missing objects from the other shards of the socket,
+	 * then from the remote shards.
+	 */
+	for (pass = 0; pass < 2 && got < n; pass++) {
+		for (i = 1; i < sd->nb_shards && got < n; i++) {
+			s = (local + i) % sd->nb_shards;
+			same_socket = sd->socket_id[s] == sd->socket_id[local];
+			if (sd->rings[s] == NULL || same_socket != (pass == 0))
+				continue;
+			got += rte_ring_dequeue_burst(sd->rings[s],
+				&obj_table[got], n - got, NULL);
+		}
+	}
+	if (unlikely(sd->stash != NULL) && got < n)
+		got += rte_ring_dequeue_burst(sd->stash, &obj_table[got],
+			n - got, NULL);
+	if (got == n)
+		return 0;
+
+	/*
+	 * Not enough objects, give back the partial request. With
+	 * RTE_MEMPOOL_F_SP_PUT, the thread putting objects is the only
+	 * producer of the shards, so the objects are kept in the stash
+	 * for a later get instead.
+	 */
+	if (got != 0) {
+		if (sd->stash != NULL)
+			rte_ring_enqueue_bulk(sd->stash, obj_table, got, NULL);
+		else
+			shard_enqueue(mp, obj_table, got);
+	}
+
+	return -ENOBUFS;
+}
+
+static unsigned int
+shard_get_count(const struct rte_mempool *mp)
+{
+	const struct shard_data *sd = mp->pool_data;
+	unsigned int i, count = 0;
+
+	for (i = 0; i < sd->nb_shards; i++) {
+		if (sd->rings[i] != NULL)
+			count += rte_ring_count(sd->rings[i]);
+	}
+	if (sd->stash != NULL)
+		count += rte_ring_count(sd->stash);
+
+	return count;
+}
+
+/*
+ * Split the lcores of each socket in groups of at most 'group_lcores'
+ * lcores, one shard per group.
+ */
+static void
+shard_assign_lcores(struct shard_data *sd, unsigned int group_lcores)
+{
+	unsigned int idx, lcore_id, nb_lcores, nb_groups, first, k;
+	int socket_id;
+
+	memset(sd->lcore_shard, SHARD_NONE, sizeof(sd->lcore_shard));
+
+	for (idx = 0; idx < rte_socket_count(); idx++) {
+		socket_id = rte_socket_id_by_idx(idx);
+
+		nb_lcores = 0;
+		RTE_LCORE_FOREACH(lcore_id) {
+			if ((int)rte_lcore_to_socket_id(lcore_id) == socket_id)
+				nb_lcores++;
+		}
+		if (nb_lcores == 0 || sd->nb_shards == SHARD_MAX)
+			continue;
+
+		nb_groups = RTE_MIN((nb_lcores + group_lcores - 1) /
+			group_lcores, SHARD_MAX - sd->nb_shards);
+		first = sd->nb_shards;
+		for (k = 0; k < nb_groups; k++)
+			sd->socket_id[sd->nb_shards++] = socket_id;
+
+		k = 0;
+		RTE_LCORE_FOREACH(lcore_id) {
+			if ((int)rte_lcore_to_socket_id(lcore_id) != socket_id)
+				continue;
+			sd->lcore_shard[lcore_id] = first +
+				k * nb_groups / nb_lcores;
+			k++;
+		}
+	}
+
+	/* No lcore found, keep a single shard. */
+	if (sd->nb_shards == 0)
+		sd->socket_id[sd->nb_shards++] = SOCKET_ID_ANY;
+}
+
+static void
+shard_free(struct rte_mempool *mp)
+{
+	struct shard_data *sd = mp->pool_data;
+	unsigned int i;
+
+	if (sd == NULL)
+		return;
+
+	for (i = 0; i < sd->nb_shards; i++)
+		rte_free(sd->rings[i]);
+	rte_ring_free(sd->stash);
+	rte_free(sd->chunks);
+	rte_free(sd);
+	mp->pool_data = NULL;
+}
+
+static int
+shard_alloc(struct rte_mempool *mp)
+{
+	const struct rte_mempool_shard_config *cfg = mp->pool_config;
+	unsigned int group_lcores = SHARD_GROUP_LCORES;
+	char rg_name[RTE_RING_NAMESIZE];
+	struct shard_data *sd;
+	int ret;
+
+	sd = rte_zmalloc_socket("mempool_shard", sizeof(*sd),
+		RTE_CACHE_LINE_SIZE, mp->socket_id);
+	if (sd == NULL) {
+		rte_errno = ENOMEM;
+		return -rte_errno;
+	}
+	mp->pool_data = sd;
+
+	if (cfg != NULL && cfg->lcores_per_shard != 0)
+		group_lcores = cfg->lcores_per_shard;
+	shard_assign_lcores(sd, group_lcores);
+
+	/* The shard rings are created when populating, see shard_populate(). */
+	sd->rg_flags = RING_F_EXACT_SZ;
+	if (mp->flags & RTE_MEMPOOL_F_SP_PUT)
+		sd->rg_flags |= RING_F_SP_ENQ;
+	if (mp->flags & RTE_MEMPOOL_F_SC_GET)
+		sd->rg_flags |= RING_F_SC_DEQ;
+
+	/* The getters are the producers and consumers of the stash. */
+	if (mp->flags & RTE_MEMPOOL_F_SP_PUT) {
+		ret = snprintf(rg_name, sizeof(rg_name),
+			RTE_MEMPOOL_MZ_FORMAT ".st", mp->name);
+		if (ret < 0 || ret >= (int)sizeof(rg_name)) {
+			rte_errno = ENAMETOOLONG;
+			goto error;
+		}
+		sd->stash = rte_ring_create(rg_name,
+			rte_align32pow2(mp->size + 1), mp->socket_id,
+			(mp->flags & RTE_MEMPOOL_F_SC_GET) ?
+			RING_F_SP_ENQ | RING_F_SC_DEQ : 0);
+		if (sd->stash == NULL)
+			goto error;
+	}
+
+	return 0;
+
+error:
+	ret = -rte_errno;
+	shard_free(mp);
+	return ret;
+}
+
+/*
+ * Grow the ring of a shard to the number of objects homed on it, moving
+ * the objects of the previous ring. The pool is not used while populated.
+ */
+static int
+shard_ring_resize(struct rte_mempool *mp, struct shard_data *sd,
+	unsigned int s)
+{
+	char rg_name[RTE_RING_NAMESIZE];
+	struct rte_ring *r, *old = sd->rings[s];
+	void **objs = NULL;
+	unsigned int count = 0;
+	ssize_t size;
+	int socket_id;
+	int ret;
+
+	if (old != NULL && rte_ring_get_capacity(old) >= sd->nb_objs[s])
+		return 0;
+
+	ret = snprintf(rg_name, sizeof(rg_name),
+		RTE_MEMPOOL_MZ_FORMAT ".s%u", mp->name, s);
+	if (ret < 0 || ret >= (int)sizeof(rg_name))
+		return -ENAMETOOLONG;
+
+	size = rte_ring_get_memsize(rte_align32pow2(sd->nb_objs[s] + 1));
+	if (size < 0)
+		return size;
+	socket_id = sd->socket_id[s];
+	if (socket_id == SOCKET_ID_ANY)
+		socket_id = mp->socket_id;
+	r = rte_zmalloc_socket(rg_name, size, RTE_CACHE_LINE_SIZE, socket_id);
+	if (r == NULL && socket_id != mp->socket_id) {
+		/* No memory on the socket of the lcores. */
+		r = rte_zmalloc_socket(rg_name, size, RTE_CACHE_LINE_SIZE,
+			mp->socket_id);
+	}
+	if (r == NULL)
+		return -ENOMEM;
+	ret = rte_ring_init(r, rg_name, sd->nb_objs[s], sd->rg_flags);
+	if (ret < 0)
+		goto error;
+
+	if (old != NULL) {
+		count = rte_ring_count(old);
+		objs = malloc(sizeof(*objs) * RTE_MAX(count, 1U));
+		if (objs == NULL) {
+			ret = -ENOMEM;
+			goto error;
+		}
+		rte_ring_dequeue_bulk(old, objs, count, NULL);
+		rte_ring_enqueue_bulk(r, objs, count, NULL);
+		free(objs);
+		rte_free(old);
+	}
+	sd->rings[s] = r;
+
+	return 0;
+
+error:
+	rte_free(r);
+	return ret;
+}
+
+static void
+shard_count_obj(struct rte_mempool *mp, void *opaque, void *vaddr,
+	rte_iova_t iova)
+{
+	RTE_SET_USED(mp);
+	RTE_SET_USED(opaque);
+	RTE_SET_USED(vaddr);
+	RTE_SET_USED(iova);
+}
+
+/*
+ * The objects of a chunk are homed on the shards of the socket of its
+ * memory, or on all the shards if there is no lcore on this socket.
+ * They are counted by a first pass, so that the rings of their shards
+ * are sized for them before they are stored by a second pass.
+ */
+static int
+shard_populate(struct rte_mempool *mp, unsigned int max_objs,
+	void *vaddr, rte_iova_t iova, size_t len,
+	rte_mempool_populate_obj_cb_t *obj_cb, void *obj_cb_arg)
+{
+	struct shard_data *sd = mp->pool_data;
+	unsigned int nb_objs[SHARD_MAX];
+	const struct rte_memseg *ms;
+	struct shard_chunk *chunk;
+	unsigned int i;
+	int socket_id;
+	int ret;
+
+	chunk = rte_realloc(sd->chunks, sizeof(*chunk) * (sd->nb_chunks + 1),
+		0);
+	if (chunk == NULL)
+		return -ENOMEM;
+	sd->chunks = chunk;
+	chunk = &sd->chunks[sd->nb_chunks];
+
+	ms = rte_mem_virt2memseg(vaddr, NULL);
+	socket_id = ms != NULL ? ms->socket_id : mp->socket_id;
+	chunk->start = (uintptr_t)vaddr;
+	chunk->len = len;
+	chunk->first = 0;
+	chunk->nb = 0;
+	for (i = 0; i < sd->nb_shards; i++) {
+		if (sd->socket_id[i] != socket_id)
+			continue;
+		if (chunk->nb == 0)
+			chunk->first = i;
+		chunk->nb++;
+	}
+	if (chunk->nb == 0)
+		chunk->nb = sd->nb_shards;
+	sd->nb_chunks++;
+
+	memcpy(nb_objs, sd->nb_objs, sizeof(nb_objs));
+	sd->counting = true;
+	ret = rte_mempool_op_populate_default(mp, max_objs, vaddr, iova, len,
+		shard_count_obj, NULL);
+	sd->counting = false;
+	if (ret <= 0)
+		goto error;
+
+	for (i = chunk->first; i < chunk->first + chunk->nb; i++) {
+		ret = shard_ring_resize(mp, sd, i);
+		if (ret < 0)
+			goto error;
+	}
+
+	return rte_mempool_op_populate_default(mp, max_objs, vaddr, iova, len,
+		obj_cb, obj_cb_arg);
+
+error:
+	memcpy(sd->nb_objs, nb_objs, sizeof(nb_objs));
+	sd->nb_chunks--;
+	return ret;
+}
+
+static const struct rte_mempool_ops ops_shard = {
+	.name = "shard",
+	.alloc = shard_alloc,
+	.free = shard_free,
+	.enqueue = shard_enqueue,
+	.dequeue = shard_dequeue,
+	.get_count = shard_get_count,
+	.populate = shard_populate,
+};
+
+RTE_MEMPOOL_REGISTER_OPS(ops_shard);
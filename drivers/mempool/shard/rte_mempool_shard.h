@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_MEMPOOL_SHARD_H_
+#define _RTE_MEMPOOL_SHARD_H_
+
+/**
+ * @file rte_mempool_shard.h
+ * Shard mempool driver configuration.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Optional configuration of a shard mempool, given as the pool_config
+ * parameter of rte_mempool_set_ops_byname().
+ */
+struct rte_mempool_shard_config {
+	/**
+	 * Maximum number of lcores of a socket sharing a shard,
+	 * 0 for the default of 16 lcores.
+	 */
+	unsigned int lcores_per_shard;
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMPOOL_SHARD_H_ */
@@ -39,9 +39,13 @@
 #define ETH_AF_PACKET_FRAMECOUNT_ARG	"framecnt"
 #define ETH_AF_PACKET_QDISC_BYPASS_ARG	"qdisc_bypass"
 #define ETH_AF_PACKET_FANOUT_MODE_ARG	"fanout_mode"
+#define ETH_AF_PACKET_TPACKET_V3_ARG	"tpacket_v3"
+#define ETH_AF_PACKET_BLOCK_TOV_ARG	"block_tov"
+#define ETH_AF_PACKET_RX_ZERO_COPY_ARG	"rx_zero_copy"
 
 #define DFLT_FRAME_SIZE		(1 << 11)
 #define DFLT_FRAME_COUNT	(1 << 9)
+#define DFLT_BLOCK_TOV		1 /* ms */
 
 static uint64_t timestamp_dynflag;
 static int timestamp_dynfield_offset = -1;
@@ -54,6 +58,15 @@ struct __rte_cache_aligned pkt_rx_queue {
 	unsigned int framecount;
 	unsigned int framenum;
 
+	/* TPACKET_V3 ring: rd holds the blocks, walked one packet at a time */
+	unsigned int blockcount;
+	unsigned int blocknum;
+	uint32_t blk_pkts_left;
+	uint64_t blk_seq;
+	struct tpacket3_hdr *blk_ppd;
+	/* per-block refcount of the zero-copy mbufs, NULL when copying */
+	struct rte_mbuf_ext_shared_info *blk_shinfo;
+
 	struct rte_mempool *mb_pool;
 	uint16_t in_port;
 	uint8_t vlan_strip;
@@ -88,6 +101,7 @@ struct pmd_internals {
 	struct rte_ether_addr eth_addr;
 
 	struct tpacket_req req;
+	uint8_t tpacket_v3;
 
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
@@ -103,6 +117,9 @@ static const char *valid_arguments[] = {
 	ETH_AF_PACKET_FRAMECOUNT_ARG,
 	ETH_AF_PACKET_QDISC_BYPASS_ARG,
 	ETH_AF_PACKET_FANOUT_MODE_ARG,
+	ETH_AF_PACKET_TPACKET_V3_ARG,
+	ETH_AF_PACKET_BLOCK_TOV_ARG,
+	ETH_AF_PACKET_RX_ZERO_COPY_ARG,
 	NULL
 };
 
@@ -161,6 +178,68 @@ eth_af_packet_rx_scatter(struct rte_mempool *mb_pool, struct rte_mbuf *mbuf,
 	return 0;
 }
 
+/*
+ * Copy a received frame into an mbuf, chained when scatter is enabled.
+ * On failure the mbuf is freed, the drop accounted and -1 returned.
+ */
+static inline int
+eth_af_packet_rx_copy(struct pkt_rx_queue *pkt_q, struct rte_mbuf *mbuf,
+		const uint8_t *pbuf, uint32_t pkt_len)
+{
+	if (pkt_len <= rte_pktmbuf_tailroom(mbuf)) {
+		/* packet fits in a single mbuf */
+		memcpy(rte_pktmbuf_mtod(mbuf, void *), pbuf, pkt_len);
+		rte_pktmbuf_data_len(mbuf) = pkt_len;
+	} else if (pkt_q->scatter_enabled) {
+		/* scatter into chained mbufs */
+		if (unlikely(eth_af_packet_rx_scatter(pkt_q->mb_pool,
+				mbuf, pbuf, pkt_len) < 0)) {
+			rte_pktmbuf_free(mbuf);
+			pkt_q->rx_nombuf++;
+			return -1;
+		}
+	} else {
+		/* oversized and no scatter - drop */
+		rte_pktmbuf_free(mbuf);
+		pkt_q->rx_dropped_pkts++;
+		return -1;
+	}
+
+	rte_pktmbuf_pkt_len(mbuf) = pkt_len;
+	return 0;
+}
+
+/*
+ * Fill in the mbuf metadata from the frame header fields, which are
+ * the same for TPACKET_V2 and TPACKET_V3 but at different offsets.
+ */
+static inline void
+eth_af_packet_rx_meta(struct pkt_rx_queue *pkt_q, struct rte_mbuf *mbuf,
+		uint32_t tp_status, uint16_t vlan_tci,
+		uint32_t tp_sec, uint32_t tp_nsec)
+{
+	/* check for vlan info */
+	if (tp_status & TP_STATUS_VLAN_VALID) {
+		mbuf->vlan_tci = vlan_tci;
+		mbuf->ol_flags |= (RTE_MBUF_F_RX_VLAN | RTE_MBUF_F_RX_VLAN_STRIPPED);
+
+		if (!pkt_q->vlan_strip && rte_vlan_insert(&mbuf))
+			PMD_LOG(ERR, "Failed to reinsert VLAN tag");
+	}
+
+	/* add kernel provided timestamp when offloading is enabled */
+	if (pkt_q->timestamp_offloading) {
+		/* since TPACKET_V2/V3 timestamps are provided in nanoseconds resolution */
+		*RTE_MBUF_DYNFIELD(mbuf, timestamp_dynfield_offset,
+			rte_mbuf_timestamp_t *) =
+				(uint64_t)tp_sec * 1000000000 + tp_nsec;
+
+		mbuf->ol_flags |= timestamp_dynflag;
+	}
+
+	mbuf->port = pkt_q->in_port;
+}
+
 static uint16_t
 eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -199,47 +278,12 @@ eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		pkt_len = ppd->tp_snaplen;
 		pbuf = (uint8_t *)ppd + ppd->tp_mac;
 
-		if (pkt_len <= rte_pktmbuf_tailroom(mbuf)) {
-			/* packet fits in a single mbuf */
-			memcpy(rte_pktmbuf_mtod(mbuf, void *), pbuf, pkt_len);
-			rte_pktmbuf_data_len(mbuf) = pkt_len;
-		} else if (pkt_q->scatter_enabled) {
-			/* scatter into chained mbufs */
-			if (unlikely(eth_af_packet_rx_scatter(pkt_q->mb_pool,
-					mbuf, pbuf, pkt_len) < 0)) {
-				rte_pktmbuf_free(mbuf);
-				pkt_q->rx_nombuf++;
-				goto release_frame;
-			}
-		} else {
-			/* oversized and no scatter - drop */
-			rte_pktmbuf_free(mbuf);
-			pkt_q->rx_dropped_pkts++;
+		if (eth_af_packet_rx_copy(pkt_q, mbuf, pbuf, pkt_len) < 0)
 			goto release_frame;
-		}
-
-		rte_pktmbuf_pkt_len(mbuf) = pkt_len;
-
-		/* check for vlan info */
-		if (ppd->tp_status & TP_STATUS_VLAN_VALID) {
-			mbuf->vlan_tci = ppd->tp_vlan_tci;
-			mbuf->ol_flags |= (RTE_MBUF_F_RX_VLAN | RTE_MBUF_F_RX_VLAN_STRIPPED);
-
-			if (!pkt_q->vlan_strip && rte_vlan_insert(&mbuf))
-				PMD_LOG(ERR, "Failed to reinsert VLAN tag");
-		}
-
-		/* add kernel provided timestamp when offloading is enabled */
-		if (pkt_q->timestamp_offloading) {
-			/* since TPACKET_V2 timestamps are provided in nanoseconds resolution */
-			*RTE_MBUF_DYNFIELD(mbuf, timestamp_dynfield_offset,
-				rte_mbuf_timestamp_t *) =
-					(uint64_t)ppd->tp_sec * 1000000000 + ppd->tp_nsec;
-
-			mbuf->ol_flags |= timestamp_dynflag;
-		}
 
-		mbuf->port = pkt_q->in_port;
+		eth_af_packet_rx_meta(pkt_q, mbuf, ppd->tp_status,
+				      ppd->tp_vlan_tci, ppd->tp_sec,
+				      ppd->tp_nsec);
 
 		/* account for the receive frame */
 		bufs[num_rx] = mbuf;
@@ -258,6 +302,150 @@ eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return num_rx;
 }
 
+/*
+ * Hand a TPACKET_V3 block back to the kernel. Also the free callback of
+ * the zero-copy mbufs, run when the last mbuf of the block is freed.
+ */
+static void
+eth_af_packet_rx_block_release(void *addr __rte_unused, void *opaque)
+{
+	struct tpacket_block_desc *pbd = opaque;
+
+	/* complete all reads of the block before the kernel refills it */
+	rte_atomic_thread_fence(rte_memory_order_release);
+	pbd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+}
+
+/*
+ * Point an mbuf at a frame inside a TPACKET_V3 block instead of copying
+ * it. PACKET_RESERVE keeps RTE_PKTMBUF_HEADROOM bytes free before the
+ * frame data, and the block stays owned by the application until all
+ * of its mbufs are freed.
+ */
+static inline void
+eth_af_packet_rx_attach(struct rte_mbuf_ext_shared_info *shinfo,
+		struct rte_mbuf *mbuf, uint8_t *pbuf, uint32_t pkt_len)
+{
+	rte_mbuf_ext_refcnt_update(shinfo, 1);
+	/* the ring is not DMA mapped, no IOVA for the external buffer */
+	rte_pktmbuf_attach_extbuf(mbuf, pbuf - RTE_PKTMBUF_HEADROOM,
+				  RTE_BAD_IOVA, RTE_PKTMBUF_HEADROOM + pkt_len,
+				  shinfo);
+	mbuf->data_off = RTE_PKTMBUF_HEADROOM;
+	rte_pktmbuf_data_len(mbuf) = pkt_len;
+	rte_pktmbuf_pkt_len(mbuf) = pkt_len;
+}
+
+/*
+ * Receive from a TPACKET_V3 ring, where the kernel fills whole blocks of
+ * variable-size frames and retires them when full or on timeout. Blocks
+ * are walked frame by frame, mbufs being allocated in bulk for the frames
+ * left in the current block, and a block is released once fully walked
+ * (or, in zero-copy mode, once all mbufs pointing into it are freed).
+ */
+static uint16_t
+eth_af_packet_rx_v3(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct pkt_rx_queue *pkt_q = queue;
+	struct rte_mbuf_ext_shared_info *shinfo = NULL;
+	struct tpacket_block_desc *pbd;
+	struct tpacket3_hdr *ppd;
+	struct rte_mbuf *mbuf;
+	unsigned int blockcount, blocknum;
+	uint32_t pkts_left, pkt_len;
+	uint16_t num_rx = 0;
+	unsigned long num_rx_bytes = 0;
+	uint16_t i, n, out;
+	uint8_t *pbuf;
+
+	blockcount = pkt_q->blockcount;
+	blocknum = pkt_q->blocknum;
+	pkts_left = pkt_q->blk_pkts_left;
+	ppd = pkt_q->blk_ppd;
+
+	while (num_rx < nb_pkts) {
+		pbd = (struct tpacket_block_desc *)pkt_q->rd[blocknum].iov_base;
+		if (pkt_q->blk_shinfo != NULL)
+			shinfo = &pkt_q->blk_shinfo[blocknum];
+
+		if (pkts_left == 0) {
+			/* wait for the kernel to retire the next block */
+			if ((pbd->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+				break;
+			rte_atomic_thread_fence(rte_memory_order_acquire);
+
+			/*
+			 * A block still referenced by zero-copy mbufs keeps
+			 * the user status: only walk the block retired right
+			 * after the last one walked.
+			 */
+			if (pkt_q->blk_seq != 0 &&
+			    pbd->hdr.bh1.seq_num != pkt_q->blk_seq + 1)
+				break;
+			pkt_q->blk_seq = pbd->hdr.bh1.seq_num;
+
+			pkts_left = pbd->hdr.bh1.num_pkts;
+			ppd = RTE_PTR_ADD(pbd, pbd->hdr.bh1.offset_to_first_pkt);
+			/* the Rx path holds a reference while walking the block */
+			if (shinfo != NULL)
+				rte_mbuf_ext_refcnt_set(shinfo, 1);
+		}
+
+		n = RTE_MIN(pkts_left, (uint32_t)(nb_pkts - num_rx));
+		if (n != 0 && unlikely(rte_pktmbuf_alloc_bulk(pkt_q->mb_pool,
+						&bufs[num_rx], n) != 0)) {
+			pkt_q->rx_nombuf++;
+			break;
+		}
+
+		out = num_rx;
+		for (i = 0; i < n; i++) {
+			mbuf = bufs[num_rx + i];
+			pkt_len = ppd->tp_snaplen;
+			pbuf = (uint8_t *)ppd + ppd->tp_mac;
+
+			/* copy when the VLAN tag has to be reinserted */
+			if (shinfo != NULL &&
+			    RTE_PKTMBUF_HEADROOM + pkt_len <= UINT16_MAX &&
+			    (pkt_q->vlan_strip ||
+			     !(ppd->tp_status & TP_STATUS_VLAN_VALID)))
+				eth_af_packet_rx_attach(shinfo, mbuf, pbuf,
+							pkt_len);
+			else if (eth_af_packet_rx_copy(pkt_q, mbuf, pbuf,
+						       pkt_len) < 0)
+				goto next_frame;
+
+			eth_af_packet_rx_meta(pkt_q, mbuf, ppd->tp_status,
+					      ppd->hv1.tp_vlan_tci,
+					      ppd->tp_sec, ppd->tp_nsec);
+
+			/* account for the receive frame */
+			bufs[out++] = mbuf;
+			num_rx_bytes += mbuf->pkt_len;
+
+next_frame:
+			ppd = RTE_PTR_ADD(ppd, ppd->tp_next_offset);
+		}
+		num_rx = out;
+		pkts_left -= n;
+
+		if (pkts_left == 0) {
+			/* release the walked block and advance ring buffer */
+			if (shinfo == NULL ||
+			    rte_mbuf_ext_refcnt_update(shinfo, -1) == 0)
+				eth_af_packet_rx_block_release(NULL, pbd);
+			if (++blocknum >= blockcount)
+				blocknum = 0;
+		}
+	}
+	pkt_q->blocknum = blocknum;
+	pkt_q->blk_pkts_left = pkts_left;
+	pkt_q->blk_ppd = ppd;
+	pkt_q->rx_pkts += num_rx;
+	pkt_q->rx_bytes += num_rx_bytes;
+	return num_rx;
+}
+
 /*
  * Check if there is an available frame in the ring
  */
@@ -557,11 +745,36 @@ eth_stats_reset(struct rte_eth_dev *dev)
 	return 0;
 }
 
+/*
+ * Unmap the rings of a queue pair: a single mapping holding the Rx and Tx
+ * rings of the shared socket for TPACKET_V2, one mapping per socket for
+ * TPACKET_V3.
+ */
+static void
+eth_af_packet_unmap(struct pmd_internals *internals, unsigned int q)
+{
+	struct pkt_rx_queue *rx_queue = &internals->rx_queue[q];
+	struct pkt_tx_queue *tx_queue = &internals->tx_queue[q];
+	size_t ring_size = (size_t)internals->req.tp_block_size *
+		internals->req.tp_block_nr;
+
+	if (internals->tpacket_v3) {
+		if (rx_queue->map != MAP_FAILED)
+			munmap(rx_queue->map, ring_size);
+		if (tx_queue->map != MAP_FAILED)
+			munmap(tx_queue->map, ring_size);
+	} else if (rx_queue->map != MAP_FAILED) {
+		munmap(rx_queue->map, 2 * ring_size);
+	}
+
+	rx_queue->map = MAP_FAILED;
+	tx_queue->map = MAP_FAILED;
+}
+
 static int
 eth_dev_close(struct rte_eth_dev *dev)
 {
 	struct pmd_internals *internals;
-	struct tpacket_req *req;
 	unsigned int q;
 	int sockfd;
 
@@ -572,7 +785,6 @@ eth_dev_close(struct rte_eth_dev *dev)
 		rte_socket_id());
 
 	internals = dev->data->dev_private;
-	req = &internals->req;
 	for (q = 0; q < internals->nb_queues; q++) {
 		sockfd = internals->rx_queue[q].sockfd;
 		if (sockfd != -1)
@@ -588,9 +800,9 @@ eth_dev_close(struct rte_eth_dev *dev)
 		internals->rx_queue[q].sockfd = -1;
 		internals->tx_queue[q].sockfd = -1;
 
-		munmap(internals->rx_queue[q].map,
-			2 * req->tp_block_size * req->tp_block_nr);
+		eth_af_packet_unmap(internals, q);
 		rte_free(internals->rx_queue[q].rd);
+		rte_free(internals->rx_queue[q].blk_shinfo);
 		rte_free(internals->tx_queue[q].rd);
 	}
 	rte_free(internals->if_name);
@@ -854,6 +1066,166 @@ get_fanout(const char *fanout_mode, int if_index)
 		return PACKET_FANOUT_INVALID;
 }
 
+/*
+ * Opens an AF_PACKET socket for a queue using the given TPACKET version
+ */
+static int
+open_queue_socket(const char *name, const char *iface, int tpver,
+		  unsigned int qdisc_bypass)
+{
+	int sockfd, discard, rc;
+
+	sockfd = socket(AF_PACKET, SOCK_RAW, 0);
+	if (sockfd == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not open AF_PACKET socket",
+			name);
+		return -1;
+	}
+
+	rc = setsockopt(sockfd, SOL_PACKET, PACKET_VERSION,
+			&tpver, sizeof(tpver));
+	if (rc == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not set PACKET_VERSION on AF_PACKET socket for %s",
+			name, iface);
+		goto error;
+	}
+
+	discard = 1;
+	rc = setsockopt(sockfd, SOL_PACKET, PACKET_LOSS,
+			&discard, sizeof(discard));
+	if (rc == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not set PACKET_LOSS on AF_PACKET socket for %s",
+			name, iface);
+		goto error;
+	}
+
+	if (qdisc_bypass) {
+#if defined(PACKET_QDISC_BYPASS)
+		rc = setsockopt(sockfd, SOL_PACKET, PACKET_QDISC_BYPASS,
+				&qdisc_bypass, sizeof(qdisc_bypass));
+		if (rc == -1) {
+			PMD_LOG_ERRNO(ERR,
+				"%s: could not set PACKET_QDISC_BYPASS on AF_PACKET socket for %s",
+				name, iface);
+			goto error;
+		}
+#endif
+	}
+
+	return sockfd;
+
+error:
+	close(sockfd);
+	return -1;
+}
+
+/*
+ * Stops an Rx socket from receiving the packets sent on the interface
+ */
+static int
+rx_queue_ignore_outgoing(const char *name, const char *iface, int sockfd)
+{
+#if defined(PACKET_IGNORE_OUTGOING)
+	int ignore = 1;
+
+	if (setsockopt(sockfd, SOL_PACKET, PACKET_IGNORE_OUTGOING,
+		       &ignore, sizeof(ignore)) == 0)
+		return 0;
+	PMD_LOG_ERRNO(ERR,
+		"%s: could not set PACKET_IGNORE_OUTGOING on AF_PACKET socket for %s",
+		name, iface);
+#else
+	RTE_SET_USED(sockfd);
+	PMD_LOG(ERR,
+		"%s: tpacket_v3 requires qdisc_bypass=1 for %s",
+		name, iface);
+#endif
+	return -1;
+}
+
+/*
+ * Sets up the TPACKET_V3 block ring of an Rx queue, the frame geometry of
+ * req giving the block size and count.
+ */
+static int
+rx_queue_v3_setup(const char *name, const char *iface,
+		  struct pkt_rx_queue *rx_queue, const struct tpacket_req *req,
+		  unsigned int block_tov, unsigned int rx_zero_copy,
+		  unsigned int numa_node)
+{
+	struct tpacket_req3 req3 = {
+		.tp_block_size = req->tp_block_size,
+		.tp_block_nr = req->tp_block_nr,
+		.tp_frame_size = req->tp_frame_size,
+		.tp_frame_nr = req->tp_frame_nr,
+		.tp_retire_blk_tov = block_tov,
+	};
+	unsigned int reserve, i;
+	int rc;
+
+	if (rx_zero_copy) {
+		/* leave room for the mbuf headroom in front of each frame */
+		reserve = RTE_PKTMBUF_HEADROOM;
+		rc = setsockopt(rx_queue->sockfd, SOL_PACKET, PACKET_RESERVE,
+				&reserve, sizeof(reserve));
+		if (rc == -1) {
+			PMD_LOG_ERRNO(ERR,
+				"%s: could not set PACKET_RESERVE on AF_PACKET socket for %s",
+				name, iface);
+			return -1;
+		}
+	}
+
+	rc = setsockopt(rx_queue->sockfd, SOL_PACKET, PACKET_RX_RING,
+			&req3, sizeof(req3));
+	if (rc == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
+			name, iface);
+		return -1;
+	}
+
+	rx_queue->map = mmap(NULL, (size_t)req3.tp_block_size * req3.tp_block_nr,
+			     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
+			     rx_queue->sockfd, 0);
+	if (rx_queue->map == MAP_FAILED) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: call to mmap failed on AF_PACKET socket for %s",
+			name, iface);
+		return -1;
+	}
+
+	rx_queue->blockcount = req3.tp_block_nr;
+	rx_queue->rd = rte_zmalloc_socket(name,
+			req3.tp_block_nr * sizeof(*(rx_queue->rd)), 0, numa_node);
+	if (rx_queue->rd == NULL)
+		return -1;
+	for (i = 0; i < req3.tp_block_nr; ++i) {
+		rx_queue->rd[i].iov_base = rx_queue->map +
+			(size_t)i * req3.tp_block_size;
+		rx_queue->rd[i].iov_len = req3.tp_block_size;
+	}
+
+	if (!rx_zero_copy)
+		return 0;
+
+	rx_queue->blk_shinfo = rte_zmalloc_socket(name,
+			req3.tp_block_nr * sizeof(*(rx_queue->blk_shinfo)),
+			0, numa_node);
+	if (rx_queue->blk_shinfo == NULL)
+		return -1;
+	for (i = 0; i < req3.tp_block_nr; ++i) {
+		rx_queue->blk_shinfo[i].free_cb = eth_af_packet_rx_block_release;
+		rx_queue->blk_shinfo[i].fcb_opaque = rx_queue->rd[i].iov_base;
+		rte_mbuf_ext_refcnt_set(&rx_queue->blk_shinfo[i], 0);
+	}
+
+	return 0;
+}
+
 static int
 rte_pmd_init_internals(struct rte_vdev_device *dev,
 		       const int sockfd,
@@ -864,6 +1236,9 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 		       unsigned int framecnt,
 		       unsigned int qdisc_bypass,
 		       const char *fanout_mode,
+		       unsigned int tpacket_v3,
+		       unsigned int block_tov,
+		       unsigned int rx_zero_copy,
 		       struct pmd_internals **internals,
 		       struct rte_eth_dev **eth_dev,
 		       struct rte_kvargs *kvlist)
@@ -879,9 +1254,10 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	struct tpacket_req *req;
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
-	int rc, tpver, discard;
+	int rc;
 	int qsockfd = -1;
 	unsigned int i, q, rdsize;
+	size_t ring_size;
 	int fanout_arg;
 
 	for (k_idx = 0; k_idx < kvlist->count; k_idx++) {
@@ -931,6 +1307,11 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	req->tp_block_nr = blockcnt;
 	req->tp_frame_size = framesize;
 	req->tp_frame_nr = framecnt;
+	(*internals)->tpacket_v3 = !!tpacket_v3;
+
+	ring_size = (size_t)req->tp_block_size * req->tp_block_nr;
+	/* rdsize is same for both Tx and Rx frame rings */
+	rdsize = req->tp_frame_nr * sizeof(struct iovec);
 
 	ifnamelen = strlen(pair->value);
 	if (ifnamelen < sizeof(ifr.ifr_name)) {
@@ -970,97 +1351,112 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	}
 
 	for (q = 0; q < nb_queues; q++) {
+		rx_queue = &((*internals)->rx_queue[q]);
+		tx_queue = &((*internals)->tx_queue[q]);
+
 		/* Open an AF_PACKET socket for this queue... */
-		qsockfd = socket(AF_PACKET, SOCK_RAW, 0);
-		if (qsockfd == -1) {
-			PMD_LOG_ERRNO(ERR,
-				"%s: could not open AF_PACKET socket",
-				name);
+		qsockfd = open_queue_socket(name, pair->value,
+					    tpacket_v3 ? TPACKET_V3 : TPACKET_V2,
+					    qdisc_bypass);
+		if (qsockfd == -1)
 			goto error;
-		}
+		rx_queue->sockfd = qsockfd;
+		tx_queue->sockfd = qsockfd;
 
-		tpver = TPACKET_V2;
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_VERSION,
-				&tpver, sizeof(tpver));
-		if (rc == -1) {
-			PMD_LOG_ERRNO(ERR,
-				"%s: could not set PACKET_VERSION on AF_PACKET socket for %s",
-				name, pair->value);
-			goto error;
-		}
+		if (tpacket_v3) {
+			/*
+			 * Tx keeps the TPACKET_V2 frame ring, on a socket of
+			 * its own since the version is per socket.
+			 */
+			tx_queue->sockfd = open_queue_socket(name, pair->value,
+							     TPACKET_V2,
+							     qdisc_bypass);
+			if (tx_queue->sockfd == -1)
+				goto error;
 
-		discard = 1;
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_LOSS,
-				&discard, sizeof(discard));
-		if (rc == -1) {
-			PMD_LOG_ERRNO(ERR,
-				"%s: could not set PACKET_LOSS on AF_PACKET socket for %s",
-				name, pair->value);
-			goto error;
-		}
+			/*
+			 * Without the qdisc bypass, the kernel loops the
+			 * packets sent on the Tx socket back to the other
+			 * sockets of the interface, this Rx one included.
+			 */
+			if (!qdisc_bypass &&
+			    rx_queue_ignore_outgoing(name, pair->value,
+						     qsockfd) < 0)
+				goto error;
 
-		if (qdisc_bypass) {
-#if defined(PACKET_QDISC_BYPASS)
-			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_QDISC_BYPASS,
-					&qdisc_bypass, sizeof(qdisc_bypass));
+			if (rx_queue_v3_setup(name, pair->value, rx_queue,
+					      req, block_tov, rx_zero_copy,
+					      numa_node) < 0)
+				goto error;
+
+			rc = setsockopt(tx_queue->sockfd, SOL_PACKET,
+					PACKET_TX_RING, req, sizeof(*req));
 			if (rc == -1) {
 				PMD_LOG_ERRNO(ERR,
-					"%s: could not set PACKET_QDISC_BYPASS on AF_PACKET socket for %s",
-					name, pair->value);
+					"%s: could not set PACKET_TX_RING on AF_PACKET "
+					"socket for %s", name, pair->value);
 				goto error;
 			}
-#endif
-		}
 
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING, req, sizeof(*req));
-		if (rc == -1) {
-			PMD_LOG_ERRNO(ERR,
-				"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
-				name, pair->value);
-			goto error;
-		}
+			tx_queue->map = mmap(NULL, ring_size,
+					     PROT_READ | PROT_WRITE,
+					     MAP_SHARED | MAP_LOCKED,
+					     tx_queue->sockfd, 0);
+			if (tx_queue->map == MAP_FAILED) {
+				PMD_LOG_ERRNO(ERR,
+					"%s: call to mmap failed on AF_PACKET socket for %s",
+					name, pair->value);
+				goto error;
+			}
+		} else {
+			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING,
+					req, sizeof(*req));
+			if (rc == -1) {
+				PMD_LOG_ERRNO(ERR,
+					"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
+					name, pair->value);
+				goto error;
+			}
 
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_TX_RING, req, sizeof(*req));
-		if (rc == -1) {
-			PMD_LOG_ERRNO(ERR,
-				"%s: could not set PACKET_TX_RING on AF_PACKET "
-				"socket for %s", name, pair->value);
-			goto error;
-		}
+			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_TX_RING,
+					req, sizeof(*req));
+			if (rc == -1) {
+				PMD_LOG_ERRNO(ERR,
+					"%s: could not set PACKET_TX_RING on AF_PACKET "
+					"socket for %s", name, pair->value);
+				goto error;
+			}
 
-		rx_queue = &((*internals)->rx_queue[q]);
-		rx_queue->framecount = req->tp_frame_nr;
+			rx_queue->framecount = req->tp_frame_nr;
 
-		rx_queue->map = mmap(NULL, 2 * req->tp_block_size * req->tp_block_nr,
-				    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
-				    qsockfd, 0);
-		if (rx_queue->map == MAP_FAILED) {
-			PMD_LOG_ERRNO(ERR,
-				"%s: call to mmap failed on AF_PACKET socket for %s",
-				name, pair->value);
-			goto error;
-		}
+			rx_queue->map = mmap(NULL, 2 * ring_size,
+					     PROT_READ | PROT_WRITE,
+					     MAP_SHARED | MAP_LOCKED,
+					     qsockfd, 0);
+			if (rx_queue->map == MAP_FAILED) {
+				PMD_LOG_ERRNO(ERR,
+					"%s: call to mmap failed on AF_PACKET socket for %s",
+					name, pair->value);
+				goto error;
+			}
 
-		/* rdsize is same for both Tx and Rx */
-		rdsize = req->tp_frame_nr * sizeof(*(rx_queue->rd));
+			rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0,
+							  numa_node);
+			if (rx_queue->rd == NULL)
+				goto error;
+			for (i = 0; i < req->tp_frame_nr; ++i) {
+				rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
+				rx_queue->rd[i].iov_len = req->tp_frame_size;
+			}
 
-		rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
-		if (rx_queue->rd == NULL)
-			goto error;
-		for (i = 0; i < req->tp_frame_nr; ++i) {
-			rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
-			rx_queue->rd[i].iov_len = req->tp_frame_size;
+			tx_queue->map = rx_queue->map + ring_size;
 		}
-		rx_queue->sockfd = qsockfd;
 
-		tx_queue = &((*internals)->tx_queue[q]);
 		tx_queue->framecount = req->tp_frame_nr;
 		tx_queue->frame_data_size = req->tp_frame_size;
 		tx_queue->frame_data_size -= TPACKET2_HDRLEN -
 			sizeof(struct sockaddr_ll);
 
-		tx_queue->map = rx_queue->map + req->tp_block_size * req->tp_block_nr;
-
 		tx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
 		if (tx_queue->rd == NULL)
 			goto error;
@@ -1068,7 +1464,6 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			tx_queue->rd[i].iov_base = tx_queue->map + (i * framesize);
 			tx_queue->rd[i].iov_len = req->tp_frame_size;
 		}
-		tx_queue->sockfd = qsockfd;
 
 		rc = bind(qsockfd, (const struct sockaddr*)&sockaddr, sizeof(sockaddr));
 		if (rc == -1) {
@@ -1078,6 +1473,22 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
+		if (tx_queue->sockfd != qsockfd) {
+			/* protocol 0: the Tx only socket receives nothing */
+			struct sockaddr_ll tx_sockaddr = sockaddr;
+
+			tx_sockaddr.sll_protocol = 0;
+			rc = bind(tx_queue->sockfd,
+				  (const struct sockaddr *)&tx_sockaddr,
+				  sizeof(tx_sockaddr));
+			if (rc == -1) {
+				PMD_LOG_ERRNO(ERR,
+					"%s: could not bind AF_PACKET Tx socket to %s",
+					name, pair->value);
+				goto error;
+			}
+		}
+
 		if (nb_queues > 1) {
 			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_FANOUT,
 					&fanout_arg, sizeof(fanout_arg));
@@ -1119,18 +1530,19 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	return 0;
 
 error:
-	if (qsockfd != -1)
-		close(qsockfd);
 	for (q = 0; q < nb_queues; q++) {
-		if ((*internals)->rx_queue[q].map != MAP_FAILED)
-			munmap((*internals)->rx_queue[q].map,
-			       2 * req->tp_block_size * req->tp_block_nr);
-
-		rte_free((*internals)->rx_queue[q].rd);
-		rte_free((*internals)->tx_queue[q].rd);
-		if (((*internals)->rx_queue[q].sockfd >= 0) &&
-			((*internals)->rx_queue[q].sockfd != qsockfd))
-			close((*internals)->rx_queue[q].sockfd);
+		rx_queue = &((*internals)->rx_queue[q]);
+		tx_queue = &((*internals)->tx_queue[q]);
+
+		eth_af_packet_unmap(*internals, q);
+
+		rte_free(rx_queue->rd);
+		rte_free(rx_queue->blk_shinfo);
+		rte_free(tx_queue->rd);
+		if (tx_queue->sockfd >= 0 && tx_queue->sockfd != rx_queue->sockfd)
+			close(tx_queue->sockfd);
+		if (rx_queue->sockfd >= 0)
+			close(rx_queue->sockfd);
 	}
 free_internals:
 	rte_free((*internals)->rx_queue);
@@ -1193,6 +1605,10 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 	unsigned int qpairs = 1;
 	unsigned int qdisc_bypass = 1;
 	const char *fanout_mode = NULL;
+	unsigned int tpacket_v3 = 0;
+	unsigned int block_tov = DFLT_BLOCK_TOV;
+	unsigned int rx_zero_copy = 0;
+	bool block_tov_set = false;
 
 	/* do some parameter checking */
 	if (*sockfd < 0)
@@ -1259,6 +1675,29 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 			fanout_mode = pair->value;
 			continue;
 		}
+		if (strstr(pair->key, ETH_AF_PACKET_TPACKET_V3_ARG) != NULL) {
+			if (parse_uint(pair->key, pair->value, &tpacket_v3, 1) < 0)
+				return -1;
+			continue;
+		}
+		if (strstr(pair->key, ETH_AF_PACKET_BLOCK_TOV_ARG) != NULL) {
+			if (parse_uint(pair->key, pair->value, &block_tov, UINT_MAX) < 0)
+				return -1;
+			block_tov_set = true;
+			continue;
+		}
+		if (strstr(pair->key, ETH_AF_PACKET_RX_ZERO_COPY_ARG) != NULL) {
+			if (parse_uint(pair->key, pair->value, &rx_zero_copy, 1) < 0)
+				return -1;
+			continue;
+		}
+	}
+
+	if (!tpacket_v3 && (block_tov_set || rx_zero_copy)) {
+		PMD_LOG(ERR,
+			"%s: block_tov and rx_zero_copy require tpacket_v3=1",
+			name);
+		return -1;
 	}
 
 	if (framesize > blocksize) {
@@ -1281,6 +1720,11 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 	PMD_LOG(DEBUG, "%s:\tframe size %d", name, framesize);
 	PMD_LOG(DEBUG, "%s:\tframe count %d", name, framecount);
 	PMD_LOG(DEBUG, "%s:\tqdisc bypass %d", name, qdisc_bypass);
+	PMD_LOG(DEBUG, "%s:\tTPACKET_V3 Rx %d", name, tpacket_v3);
+	if (tpacket_v3) {
+		PMD_LOG(DEBUG, "%s:\tblock timeout %u ms", name, block_tov);
+		PMD_LOG(DEBUG, "%s:\tRx zero-copy %d", name, rx_zero_copy);
+	}
 	if (fanout_mode)
 		PMD_LOG(DEBUG, "%s:\tfanout mode %s", name, fanout_mode);
 	else
@@ -1291,11 +1735,15 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 				   framesize, framecount,
 				   qdisc_bypass,
 				   fanout_mode,
+				   tpacket_v3, block_tov, rx_zero_copy,
 				   &internals, &eth_dev,
 				   kvlist) < 0)
 		return -1;
 
-	eth_dev->rx_pkt_burst = eth_af_packet_rx;
+	if (tpacket_v3)
+		eth_dev->rx_pkt_burst = eth_af_packet_rx_v3;
+	else
+		eth_dev->rx_pkt_burst = eth_af_packet_rx;
 	eth_dev->tx_pkt_burst = eth_af_packet_tx;
 
 	rte_eth_dev_probing_finish(eth_dev);
@@ -1388,4 +1836,7 @@ RTE_PMD_REGISTER_PARAM_STRING(net_af_packet,
 	"framesz=<int> "
 	"framecnt=<int> "
 	"qdisc_bypass=<0|1> "
-	"fanout_mode=<hash|lb|cpu|rollover|rnd|qm>");
+	"fanout_mode=<hash|lb|cpu|rollover|rnd|qm> "
+	"tpacket_v3=<0|1> "
+	"block_tov=<int> "
+	"rx_zero_copy=<0|1>");
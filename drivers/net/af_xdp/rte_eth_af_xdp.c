@@ -78,6 +78,10 @@ RTE_LOG_REGISTER_DEFAULT(af_xdp_logtype, NOTICE);
 
 #define ETH_AF_XDP_RX_BATCH_SIZE	XSK_RING_CONS__DEFAULT_NUM_DESCS
 #define ETH_AF_XDP_TX_BATCH_SIZE	XSK_RING_CONS__DEFAULT_NUM_DESCS
+/* Fill queue slots freed by Rx before they are replenished from the mempool */
+#define ETH_AF_XDP_RX_REFILL_THRESH	64
+/* Rx mbufs recycling ring, covering the fill queue size */
+#define ETH_AF_XDP_RECYCLE_RING_SIZE	(ETH_AF_XDP_DFLT_NUM_DESCS * 2)
 
 #define ETH_AF_XDP_ETH_OVERHEAD		(RTE_ETHER_HDR_LEN + RTE_ETHER_CRC_LEN)
 
@@ -144,6 +148,16 @@ struct pkt_rx_queue {
 	struct pollfd fds[1];
 	int xsk_queue_idx;
 	int busy_budget;
+
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	/*
+	 * Fill queue slots freed by Rx run from refill_head to receive_tail,
+	 * recycled Tx mbufs being staged in recycle_ring at refill_head.
+	 */
+	uint16_t receive_tail;
+	uint16_t refill_head;
+	struct rte_mbuf *recycle_ring[ETH_AF_XDP_RECYCLE_RING_SIZE];
+#endif
 };
 
 struct tx_stats {
@@ -160,6 +174,10 @@ struct pkt_tx_queue {
 
 	struct pkt_rx_queue *pair;
 	int xsk_queue_idx;
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	/* set once rte_eth_recycle_mbufs() takes the Tx completions */
+	uint8_t recycle;
+#endif
 };
 
 struct pmd_internals {
@@ -331,6 +349,38 @@ reserve_fill_queue(struct xsk_umem_info *umem, uint16_t reserve_size,
 }
 
 #if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+/*
+ * Replenish the fill queue slots freed by Rx from the mempool, once enough
+ * of them are pending. Slots are refilled with recycled Tx mbufs first
+ * when the application uses rte_eth_recycle_mbufs().
+ */
+static inline void
+af_xdp_rx_refill(struct pkt_rx_queue *rxq)
+{
+	struct rte_mbuf *fq_bufs[ETH_AF_XDP_RX_BATCH_SIZE];
+	struct rte_eth_dev *dev;
+	uint16_t nb_refill;
+
+	nb_refill = (rxq->receive_tail - rxq->refill_head) &
+		(ETH_AF_XDP_RECYCLE_RING_SIZE - 1);
+	if (nb_refill < ETH_AF_XDP_RX_REFILL_THRESH)
+		return;
+	nb_refill = RTE_MIN(nb_refill, ETH_AF_XDP_RX_BATCH_SIZE);
+
+	if (unlikely(rte_pktmbuf_alloc_bulk(rxq->umem->mb_pool, fq_bufs,
+					    nb_refill))) {
+		AF_XDP_LOG_LINE(DEBUG,
+			"Failed to get enough buffers for fq.");
+		dev = &rte_eth_devices[rxq->port];
+		dev->data->rx_mbuf_alloc_failed += nb_refill;
+		return;
+	}
+
+	if (reserve_fill_queue(rxq->umem, nb_refill, fq_bufs, &rxq->fq) == 0)
+		rxq->refill_head = (rxq->refill_head + nb_refill) &
+			(ETH_AF_XDP_RECYCLE_RING_SIZE - 1);
+}
+
 static uint16_t
 af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -341,12 +391,12 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	uint32_t idx_rx = 0;
 	unsigned long rx_bytes = 0;
 	int i;
-	struct rte_mbuf *fq_bufs[ETH_AF_XDP_RX_BATCH_SIZE];
-	struct rte_eth_dev *dev = &rte_eth_devices[rxq->port];
 
 	nb_pkts = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
 
 	if (nb_pkts == 0) {
+		af_xdp_rx_refill(rxq);
+
 		/* we can assume a kernel >= 5.11 is in use if busy polling is
 		 * enabled and thus we can safely use the recvfrom() syscall
 		 * which is only supported for AF_XDP sockets in kernels >=
@@ -362,19 +412,6 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		return 0;
 	}
 
-	/* allocate bufs for fill queue replenishment after rx */
-	if (rte_pktmbuf_alloc_bulk(umem->mb_pool, fq_bufs, nb_pkts)) {
-		AF_XDP_LOG_LINE(DEBUG,
-			"Failed to get enough buffers for fq.");
-		/* rollback cached_cons which is added by
-		 * xsk_ring_cons__peek
-		 */
-		rx->cached_cons -= nb_pkts;
-		dev->data->rx_mbuf_alloc_failed += nb_pkts;
-
-		return 0;
-	}
-
 	for (i = 0; i < nb_pkts; i++) {
 		const struct xdp_desc *desc;
 		uint64_t addr;
@@ -402,7 +439,10 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	}
 
 	xsk_ring_cons__release(rx, nb_pkts);
-	(void)reserve_fill_queue(umem, nb_pkts, fq_bufs, fq);
+
+	rxq->receive_tail = (rxq->receive_tail + nb_pkts) &
+		(ETH_AF_XDP_RECYCLE_RING_SIZE - 1);
+	af_xdp_rx_refill(rxq);
 
 	/* statistics */
 	rxq->stats.rx_pkts += nb_pkts;
@@ -540,8 +580,15 @@ static void
 kick_tx(struct pkt_tx_queue *txq, struct xsk_ring_cons *cq)
 {
 	struct xsk_umem_info *umem = txq->umem;
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	uint32_t free_thresh = cq->size >> 1;
 
+	/* leave completions to mbufs recycling until the queue is half full */
+	if (!txq->recycle || xsk_cons_nb_avail(cq, free_thresh) >= free_thresh)
+		pull_umem_cq(umem, XSK_RING_CONS__DEFAULT_NUM_DESCS, cq);
+#else
 	pull_umem_cq(umem, XSK_RING_CONS__DEFAULT_NUM_DESCS, cq);
+#endif
 
 	if (tx_syscall_needed(&txq->tx))
 		while (send(xsk_socket__fd(txq->pair->xsk), NULL,
@@ -738,6 +785,114 @@ eth_af_xdp_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 #endif
 }
 
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+/*
+ * Move the mbufs of completed Tx frames to the recycle ring of an Rx queue
+ * sharing the UMEM, so that they go back to its fill queue without a round
+ * trip through the mempool.
+ */
+static uint16_t
+af_xdp_recycle_tx_mbufs_reuse(void *tx_queue,
+			      struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct pkt_tx_queue *txq = tx_queue;
+	struct xsk_umem_info *umem = txq->umem;
+	struct xsk_ring_cons *cq = &txq->pair->cq;
+	uint16_t size = recycle_rxq_info->mbuf_ring_size;
+	uint16_t refill_head = *recycle_rxq_info->refill_head;
+	uint16_t receive_tail = *recycle_rxq_info->receive_tail;
+	uint16_t refill_requirement = recycle_rxq_info->refill_requirement;
+	struct rte_mbuf **rxep, *mbuf;
+	uint16_t avail, n, i, nb_recycle = 0;
+	uint32_t idx_cq = 0;
+	uint64_t addr;
+
+	/* frames of another UMEM cannot be put on the Rx fill queue */
+	if (recycle_rxq_info->mp != umem->mb_pool)
+		return 0;
+	txq->recycle = 1;
+
+	/* Rx ring entries waiting to be refilled */
+	avail = (size - (refill_head - receive_tail)) & (size - 1);
+
+	if (refill_requirement != 0) {
+		if (avail < refill_requirement)
+			return 0;
+		n = refill_requirement;
+	} else {
+		/* the Rx refill does not wrap around the ring */
+		n = RTE_MIN(avail, (uint16_t)(size - refill_head));
+		if (n == 0)
+			return 0;
+	}
+
+	n = xsk_ring_cons__peek(cq, n, &idx_cq);
+	if (n == 0 || (refill_requirement != 0 && n != refill_requirement)) {
+		/* rollback cached_cons which is added by xsk_ring_cons__peek */
+		cq->cached_cons -= n;
+		return 0;
+	}
+
+	rxep = recycle_rxq_info->mbuf_ring + refill_head;
+	for (i = 0; i < n; i++) {
+		addr = *xsk_ring_cons__comp_addr(cq, idx_cq++);
+		addr = xsk_umem__extract_addr(addr);
+		mbuf = xsk_umem__get_data(umem->buffer,
+					  addr + umem->mb_pool->header_size);
+		if (unlikely(mbuf->next != NULL)) {
+			rte_pktmbuf_free(mbuf);
+			continue;
+		}
+		/* mbufs still referenced elsewhere only drop a reference */
+		mbuf = rte_pktmbuf_prefree_seg(mbuf);
+		if (mbuf != NULL)
+			rxep[nb_recycle++] = mbuf;
+	}
+
+	xsk_ring_cons__release(cq, n);
+
+	/* Rx queues refilling in fixed batches take complete batches only */
+	if (refill_requirement != 0 && nb_recycle != refill_requirement) {
+		if (nb_recycle != 0)
+			rte_mempool_put_bulk(umem->mb_pool, (void **)rxep,
+					     nb_recycle);
+		return 0;
+	}
+
+	return nb_recycle;
+}
+
+static void
+af_xdp_recycle_rx_descriptors_refill(void *rx_queue, uint16_t nb_mbufs)
+{
+	struct pkt_rx_queue *rxq = rx_queue;
+	struct rte_mbuf **rxep = &rxq->recycle_ring[rxq->refill_head];
+	uint16_t i;
+
+	/* recycled mbufs keep the metadata of the packet they carried */
+	for (i = 0; i < nb_mbufs; i++)
+		rte_pktmbuf_reset(rxep[i]);
+
+	if (reserve_fill_queue(rxq->umem, nb_mbufs, rxep, &rxq->fq) == 0)
+		rxq->refill_head = (rxq->refill_head + nb_mbufs) &
+			(ETH_AF_XDP_RECYCLE_RING_SIZE - 1);
+}
+
+static void
+eth_af_xdp_recycle_rxq_info_get(struct rte_eth_dev *dev, uint16_t queue_id,
+				struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct pkt_rx_queue *rxq = dev->data->rx_queues[queue_id];
+
+	recycle_rxq_info->mbuf_ring = rxq->recycle_ring;
+	recycle_rxq_info->mp = rxq->umem->mb_pool;
+	recycle_rxq_info->mbuf_ring_size = ETH_AF_XDP_RECYCLE_RING_SIZE;
+	recycle_rxq_info->refill_head = &rxq->refill_head;
+	recycle_rxq_info->receive_tail = &rxq->receive_tail;
+	recycle_rxq_info->refill_requirement = 0;
+}
+#endif
+
 static int
 eth_dev_start(struct rte_eth_dev *dev)
 {
@@ -1693,11 +1848,14 @@ xsk_configure(struct pmd_internals *internals, struct pkt_rx_queue *rxq,
 			rte_memory_order_acquire) <= 1;
 
 #if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	txq->recycle = 0;
 	ret = rte_pktmbuf_alloc_bulk(rxq->umem->mb_pool, fq_bufs, reserve_size);
 	if (ret) {
 		AF_XDP_LOG_LINE(DEBUG, "Failed to get enough buffers for fq.");
 		goto out_umem;
 	}
+	rxq->receive_tail = 0;
+	rxq->refill_head = 0;
 #endif
 
 	/* reserve fill queue of queues not (yet) sharing UMEM */
@@ -1974,6 +2132,9 @@ static const struct eth_dev_ops ops = {
 	.stats_get = eth_stats_get,
 	.stats_reset = eth_stats_reset,
 	.get_monitor_addr = eth_get_monitor_addr,
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	.recycle_rxq_info_get = eth_af_xdp_recycle_rxq_info_get,
+#endif
 };
 
 /* AF_XDP Device Plugin option works in unprivileged
@@ -1995,6 +2156,9 @@ static const struct eth_dev_ops ops_afxdp_dp = {
 	.stats_get = eth_stats_get,
 	.stats_reset = eth_stats_reset,
 	.get_monitor_addr = eth_get_monitor_addr,
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	.recycle_rxq_info_get = eth_af_xdp_recycle_rxq_info_get,
+#endif
 };
 
 /** parse busy_budget argument */
@@ -2346,6 +2510,11 @@ init_internals(struct rte_vdev_device *dev, const char *if_name,
 
 	eth_dev->rx_pkt_burst = eth_af_xdp_rx;
 	eth_dev->tx_pkt_burst = eth_af_xdp_tx;
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	eth_dev->recycle_tx_mbufs_reuse = af_xdp_recycle_tx_mbufs_reuse;
+	eth_dev->recycle_rx_descriptors_refill =
+		af_xdp_recycle_rx_descriptors_refill;
+#endif
 	eth_dev->process_private = process_private;
 
 	for (i = 0; i < queue_cnt; i++)
@@ -7,6 +7,7 @@
 #include <eal_export.h>
 #include "rte_eth_ring.h"
 #include <rte_mbuf.h>
+#include <rte_ring_ptr_compress.h>
 #include <ethdev_driver.h>
 #include <rte_malloc.h>
 #include <rte_memcpy.h>
@@ -35,6 +36,7 @@ struct ring_internal_args {
 	struct rte_ring * const *tx_queues;
 	const unsigned int nb_tx_queues;
 	const unsigned int numa_node;
+	struct rte_mempool *mp; /* pool of compressed mbufs, if any */
 	void *addr; /* self addr for sanity check */
 };
 
@@ -46,6 +48,9 @@ enum dev_action {
 struct ring_queue {
 	struct rte_ring *rng;
 	uint16_t in_port;
+	uint8_t shift; /* shift of compressed mbuf pointers */
+	void *base; /* base of compressed mbuf pointers */
+	size_t len; /* length of the compressed mbuf range */
 	RTE_ATOMIC(uint64_t) rx_pkts;
 	RTE_ATOMIC(uint64_t) tx_pkts;
 };
@@ -59,6 +64,7 @@ struct pmd_internals {
 
 	struct rte_ether_addr address;
 	enum dev_action action;
+	bool ptr_compress; /* rings of compressed mbuf pointers */
 };
 
 static struct rte_eth_link pmd_link = {
@@ -74,20 +80,37 @@ RTE_LOG_REGISTER_DEFAULT(eth_ring_logtype, NOTICE);
 #define PMD_LOG(level, ...) \
 	RTE_LOG_LINE_PREFIX(level, ETH_RING, "%s(): ", __func__, __VA_ARGS__)
 
-static uint16_t
-eth_ring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+static __rte_always_inline void
+eth_ring_rx_finish(struct ring_queue *r, struct rte_mbuf **bufs,
+		uint16_t nb_rx)
 {
 	unsigned int i;
-	void **ptrs = (void *)&bufs[0];
-	struct ring_queue *r = q;
-	const uint16_t nb_rx = (uint16_t)rte_ring_dequeue_burst(r->rng,
-			ptrs, nb_bufs, NULL);
+
 	for (i = 0; i < nb_rx; i++)
 		bufs[i]->port = r->in_port;
 	if (r->rng->flags & RING_F_SC_DEQ)
 		r->rx_pkts += nb_rx;
 	else
 		rte_atomic_fetch_add_explicit(&r->rx_pkts, nb_rx, rte_memory_order_relaxed);
+}
+
+static __rte_always_inline void
+eth_ring_tx_finish(struct ring_queue *r, uint16_t nb_tx)
+{
+	if (r->rng->flags & RING_F_SP_ENQ)
+		r->tx_pkts += nb_tx;
+	else
+		rte_atomic_fetch_add_explicit(&r->tx_pkts, nb_tx, rte_memory_order_relaxed);
+}
+
+static uint16_t
+eth_ring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	void **ptrs = (void *)&bufs[0];
+	struct ring_queue *r = q;
+	const uint16_t nb_rx = (uint16_t)rte_ring_dequeue_burst(r->rng,
+			ptrs, nb_bufs, NULL);
+	eth_ring_rx_finish(r, bufs, nb_rx);
 	return nb_rx;
 }
 
@@ -98,13 +121,54 @@ eth_ring_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 	struct ring_queue *r = q;
 	const uint16_t nb_tx = (uint16_t)rte_ring_enqueue_burst(r->rng,
 			ptrs, nb_bufs, NULL);
-	if (r->rng->flags & RING_F_SP_ENQ)
-		r->tx_pkts += nb_tx;
-	else
-		rte_atomic_fetch_add_explicit(&r->tx_pkts, nb_tx, rte_memory_order_relaxed);
+	eth_ring_tx_finish(r, nb_tx);
+	return nb_tx;
+}
+
+static uint16_t
+eth_ring_rx_ptr_compress(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	void **ptrs = (void *)&bufs[0];
+	struct ring_queue *r = q;
+	const uint16_t nb_rx = (uint16_t)rte_ring_dequeue_burst_ptr_compress(
+			r->rng, ptrs, nb_bufs, r->base, r->shift, NULL);
+	eth_ring_rx_finish(r, bufs, nb_rx);
+	return nb_rx;
+}
+
+static uint16_t
+eth_ring_tx_ptr_compress(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	void **ptrs = (void *)&bufs[0];
+	struct ring_queue *r = q;
+	uint16_t nb_tx, i;
+
+	/* mbufs from another mempool cannot be compressed, stop there */
+	for (i = 0; i < nb_bufs; i++) {
+		if (unlikely(RTE_PTR_DIFF(bufs[i], r->base) >= r->len))
+			break;
+	}
+
+	nb_tx = (uint16_t)rte_ring_enqueue_burst_ptr_compress(r->rng,
+			ptrs, i, r->base, r->shift, NULL);
+	eth_ring_tx_finish(r, nb_tx);
 	return nb_tx;
 }
 
+static void
+eth_ring_set_burst(struct rte_eth_dev *eth_dev)
+{
+	const struct pmd_internals *internals = eth_dev->data->dev_private;
+
+	if (internals->ptr_compress) {
+		eth_dev->rx_pkt_burst = eth_ring_rx_ptr_compress;
+		eth_dev->tx_pkt_burst = eth_ring_tx_ptr_compress;
+	} else {
+		eth_dev->rx_pkt_burst = eth_ring_rx;
+		eth_dev->tx_pkt_burst = eth_ring_tx;
+	}
+}
+
 static int
 eth_dev_configure(struct rte_eth_dev *dev __rte_unused) { return 0; }
 
@@ -356,6 +420,31 @@ static const struct eth_dev_ops ops = {
 	.get_monitor_addr = eth_get_monitor_addr,
 };
 
+/*
+ * Compress the mbuf pointers against the start of the mempool memory,
+ * dropping the bits given by the object alignment.
+ */
+static int
+eth_ring_ptr_compress_params(struct rte_mempool *mp, void **base,
+		size_t *len, uint8_t *shift)
+{
+	struct rte_mempool_mem_range_info range;
+	size_t align;
+
+	if (rte_mempool_get_mem_range(mp, &range) != 0)
+		return -1;
+
+	align = rte_mempool_get_obj_alignment(mp);
+	*base = RTE_PTR_ALIGN_FLOOR(range.start, align);
+	*len = range.length + RTE_PTR_DIFF(range.start, *base);
+	*shift = RTE_PTR_COMPRESS_BIT_SHIFT_FROM_ALIGNMENT(align);
+
+	if (!RTE_PTR_COMPRESS_CAN_COMPRESS_32_SHIFT(*len, align))
+		return -1;
+
+	return 0;
+}
+
 static int
 do_eth_dev_ring_create(const char *name,
 		struct rte_vdev_device *vdev,
@@ -363,19 +452,30 @@ do_eth_dev_ring_create(const char *name,
 		const unsigned int nb_rx_queues,
 		struct rte_ring *const tx_queues[],
 		const unsigned int nb_tx_queues,
-		const unsigned int numa_node, enum dev_action action,
-		struct rte_eth_dev **eth_dev_p)
+		const unsigned int numa_node, struct rte_mempool *mp,
+		enum dev_action action, struct rte_eth_dev **eth_dev_p)
 {
 	struct rte_eth_dev_data *data = NULL;
 	struct pmd_internals *internals = NULL;
 	struct rte_eth_dev *eth_dev = NULL;
 	void **rx_queues_local = NULL;
 	void **tx_queues_local = NULL;
+	void *base = NULL;
+	size_t len = 0;
+	uint8_t shift = 0;
 	unsigned int i;
 
 	PMD_LOG(INFO, "Creating rings-backed ethdev on numa socket %u",
 			numa_node);
 
+	if (mp != NULL &&
+			eth_ring_ptr_compress_params(mp, &base, &len, &shift) != 0) {
+		PMD_LOG(ERR, "Cannot compress pointers of mempool %s",
+				mp->name);
+		rte_errno = EINVAL;
+		return -1;
+	}
+
 	rx_queues_local = rte_calloc_socket(name, nb_rx_queues,
 					    sizeof(void *), 0, numa_node);
 	if (rx_queues_local == NULL) {
@@ -420,14 +520,21 @@ do_eth_dev_ring_create(const char *name,
 	internals->action = action;
 	internals->max_rx_queues = nb_rx_queues;
 	internals->max_tx_queues = nb_tx_queues;
+	internals->ptr_compress = mp != NULL;
 	for (i = 0; i < nb_rx_queues; i++) {
 		internals->rx_ring_queues[i].rng = rx_queues[i];
 		internals->rx_ring_queues[i].in_port = -1;
+		internals->rx_ring_queues[i].base = base;
+		internals->rx_ring_queues[i].len = len;
+		internals->rx_ring_queues[i].shift = shift;
 		data->rx_queues[i] = &internals->rx_ring_queues[i];
 	}
 	for (i = 0; i < nb_tx_queues; i++) {
 		internals->tx_ring_queues[i].rng = tx_queues[i];
 		internals->tx_ring_queues[i].in_port = -1;
+		internals->tx_ring_queues[i].base = base;
+		internals->tx_ring_queues[i].len = len;
+		internals->tx_ring_queues[i].shift = shift;
 		data->tx_queues[i] = &internals->tx_ring_queues[i];
 	}
 
@@ -444,8 +551,7 @@ do_eth_dev_ring_create(const char *name,
 	data->numa_node = numa_node;
 
 	/* finally assign rx and tx ops */
-	eth_dev->rx_pkt_burst = eth_ring_rx;
-	eth_dev->tx_pkt_burst = eth_ring_tx;
+	eth_ring_set_burst(eth_dev);
 
 	rte_eth_dev_probing_finish(eth_dev);
 	*eth_dev_p = eth_dev;
@@ -460,13 +566,12 @@ do_eth_dev_ring_create(const char *name,
 	return -1;
 }
 
-RTE_EXPORT_SYMBOL(rte_eth_from_rings)
-int
-rte_eth_from_rings(const char *name, struct rte_ring *const rx_queues[],
+static int
+eth_from_rings(const char *name, struct rte_ring *const rx_queues[],
 		const unsigned int nb_rx_queues,
 		struct rte_ring *const tx_queues[],
 		const unsigned int nb_tx_queues,
-		const unsigned int numa_node)
+		const unsigned int numa_node, struct rte_mempool *mp)
 {
 	struct ring_internal_args args = {
 		.rx_queues = rx_queues,
@@ -474,6 +579,7 @@ rte_eth_from_rings(const char *name, struct rte_ring *const rx_queues[],
 		.tx_queues = tx_queues,
 		.nb_tx_queues = nb_tx_queues,
 		.numa_node = numa_node,
+		.mp = mp,
 		.addr = &args,
 	};
 	char args_str[32];
@@ -519,6 +625,36 @@ rte_eth_from_rings(const char *name, struct rte_ring *const rx_queues[],
 	return port_id;
 }
 
+RTE_EXPORT_SYMBOL(rte_eth_from_rings)
+int
+rte_eth_from_rings(const char *name, struct rte_ring *const rx_queues[],
+		const unsigned int nb_rx_queues,
+		struct rte_ring *const tx_queues[],
+		const unsigned int nb_tx_queues,
+		const unsigned int numa_node)
+{
+	return eth_from_rings(name, rx_queues, nb_rx_queues, tx_queues,
+			nb_tx_queues, numa_node, NULL);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_from_rings_ptr_compress, 26.11)
+int
+rte_eth_from_rings_ptr_compress(const char *name,
+		struct rte_ring *const rx_queues[],
+		const unsigned int nb_rx_queues,
+		struct rte_ring *const tx_queues[],
+		const unsigned int nb_tx_queues,
+		const unsigned int numa_node, struct rte_mempool *mp)
+{
+	if (mp == NULL) {
+		rte_errno = EINVAL;
+		return -1;
+	}
+
+	return eth_from_rings(name, rx_queues, nb_rx_queues, tx_queues,
+			nb_tx_queues, numa_node, mp);
+}
+
 RTE_EXPORT_SYMBOL(rte_eth_from_ring)
 int
 rte_eth_from_ring(struct rte_ring *r)
@@ -561,7 +697,7 @@ eth_dev_ring_create(const char *name,
 	}
 
 	if (do_eth_dev_ring_create(name, vdev, rxtx, num_rings, rxtx, num_rings,
-		numa_node, action, eth_dev) < 0)
+		numa_node, NULL, action, eth_dev) < 0)
 		return -1;
 
 	return 0;
@@ -703,8 +839,7 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 		eth_dev->dev_ops = &ops;
 		eth_dev->device = &dev->device;
 
-		eth_dev->rx_pkt_burst = eth_ring_rx;
-		eth_dev->tx_pkt_burst = eth_ring_tx;
+		eth_ring_set_burst(eth_dev);
 
 		rte_eth_dev_probing_finish(eth_dev);
 
@@ -752,6 +887,7 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 				internal_args->tx_queues,
 				internal_args->nb_tx_queues,
 				internal_args->numa_node,
+				internal_args->mp,
 				DEV_ATTACH,
 				&eth_dev);
 			if (ret >= 0)
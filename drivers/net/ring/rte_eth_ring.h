@@ -5,6 +5,7 @@
 #ifndef _RTE_ETH_RING_H_
 #define _RTE_ETH_RING_H_
 
+#include <rte_compat.h>
 #include <rte_ring.h>
 
 #ifdef __cplusplus
@@ -50,6 +51,47 @@ int rte_eth_from_rings(const char *name,
  */
 int rte_eth_from_ring(struct rte_ring *r);
 
+struct rte_mempool;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a new ethdev port from a set of rings of compressed mbuf pointers.
+ *
+ * The mbufs are stored in the rings as 32-bit offsets from the start of
+ * the memory of a mempool, halving the ring memory used per packet.
+ * The rings must be created with rte_ring_create_elem() and an element
+ * size of sizeof(uint32_t). Ports sharing rings must use the same mempool.
+ * The transmit function stops at the first mbuf not allocated
+ * from this mempool, leaving it to the application.
+ *
+ * @param name
+ *    name to be given to the new ethdev port
+ * @param rx_queues
+ *    pointer to array of rte_rings to be used as RX queues
+ * @param nb_rx_queues
+ *    number of elements in the rx_queues array
+ * @param tx_queues
+ *    pointer to array of rte_rings to be used as TX queues
+ * @param nb_tx_queues
+ *    number of elements in the tx_queues array
+ * @param numa_node
+ *    the numa node on which the memory for this port is to be allocated
+ * @param mp
+ *    the populated mempool of the mbufs passed through the rings
+ * @return
+ *    the port number of the newly created the ethdev or -1 on error.
+ */
+__rte_experimental
+int rte_eth_from_rings_ptr_compress(const char *name,
+		struct rte_ring * const rx_queues[],
+		const unsigned int nb_rx_queues,
+		struct rte_ring *const tx_queues[],
+		const unsigned int nb_tx_queues,
+		const unsigned int numa_node,
+		struct rte_mempool *mp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1398,6 +1398,40 @@ main(int argc, char **argv)
 	}
 	/* >8 End of adding routes and rewrite data to graph infa. */
 
+	/* Answer neighbor solicitations for the link-local addresses. 8< */
+	RTE_ETH_FOREACH_DEV(portid) {
+		struct rte_ipv6_addr llocal, solnode;
+
+		if ((enabled_port_mask & (1 << portid)) == 0)
+			continue;
+
+		rte_ipv6_llocal_from_ethernet(&llocal, &ports_eth_addr[portid]);
+		rte_ipv6_solnode_from_addr(&solnode, &llocal);
+
+		ret = rte_node_ip6_ndp_addr_add(portid, &llocal);
+		if (ret < 0)
+			rte_exit(EXIT_FAILURE,
+				 "Unable to add local address of port %u\n",
+				 portid);
+
+		ret = rte_node_ip6_ndp_router_set(portid, true);
+		if (ret < 0)
+			rte_exit(EXIT_FAILURE,
+				 "Unable to set port %u as router\n", portid);
+
+		/* Next hop id is unused by ip6_local */
+		ret = rte_node_ip6_route_add(&llocal, RTE_IPV6_MAX_DEPTH, portid,
+			RTE_NODE_IP6_LOOKUP_NEXT_IP6_LOCAL);
+		if (ret == 0)
+			ret = rte_node_ip6_route_add(&solnode, RTE_IPV6_MAX_DEPTH,
+				portid, RTE_NODE_IP6_LOOKUP_NEXT_IP6_LOCAL);
+		if (ret < 0)
+			rte_exit(EXIT_FAILURE,
+				 "Unable to add local routes of port %u\n",
+				 portid);
+	}
+	/* >8 End of adding local addresses. */
+
 	/* Launch per-lcore init on every worker lcore */
 	rte_eal_mp_remote_launch(graph_main_loop, NULL, SKIP_MAIN);
 
@@ -119,6 +119,8 @@ struct rte_acl_node {
 	int32_t                 fanout;
 	/* number of ranges (transitions w/ consecutive bits) */
 	int32_t                 id;
+	uint32_t                height;
+	/* max number of transitions to a match node */
 	struct rte_acl_match_results *mrt; /* only valid when match_flag != 0 */
 	union {
 		char            transitions[RTE_ACL_QUAD_SIZE];
@@ -144,9 +146,6 @@ enum {
 };
 
 
-/** MAX number of tries per one ACL context.*/
-#define RTE_ACL_MAX_TRIES	8
-
 /** Max number of characters in PM name.*/
 #define RTE_ACL_NAMESIZE	32
 
@@ -157,12 +156,41 @@ struct rte_acl_trie {
 	uint32_t        root_index;
 	const uint32_t *data_index;
 	uint32_t        num_data_indexes;
+	struct rte_acl_trie_info info;
 };
 
 struct rte_acl_bld_trie {
 	struct rte_acl_node *trie;
 };
 
+/* Priority of a rule, looked up by userdata when merging results. */
+struct acl_update_prio {
+	uint32_t userdata;
+	int32_t  priority;
+};
+
+/* Set of rules with its run-time structures. */
+struct acl_update_set {
+	struct rte_acl_ctx     *ctx;
+	/* context to classify with, NULL for the parent context. */
+	uint32_t                num_prio;
+	struct acl_update_prio *prio; /* sorted by userdata. */
+};
+
+/*
+ * View of the rules used by classify while incremental updates are
+ * pending: the merged rules, minus the deleted ones, plus the delta.
+ * It is never modified once published, updates publish a new one.
+ */
+struct acl_update_snapshot {
+	const struct acl_update_set *base;
+	const struct acl_update_set *delta; /* NULL if empty. */
+	uint32_t                     num_del;
+	const uint32_t              *del; /* sorted userdata of deleted rules. */
+};
+
+struct acl_update;
+
 struct rte_acl_ctx {
 	char                name[RTE_ACL_NAMESIZE];
 	/** Name of the ACL context. */
@@ -175,6 +203,9 @@ struct rte_acl_ctx {
 	uint32_t            rule_sz;
 	uint32_t            num_rules;
 	struct rte_acl_mem_hook mem_hook;
+	struct rte_rcu_qsbr *rcu;
+	/** RCU QSBR variable used by incremental updates. */
+	struct rte_acl_build_param bld_param; /* build parameters. */
 	uint32_t            num_categories;
 	uint32_t            num_tries;
 	uint32_t            match_index;
@@ -186,6 +217,11 @@ struct rte_acl_ctx {
 	void               *mem;
 	size_t              mem_sz;
 	struct rte_acl_config config; /* copy of build config. */
+	uint32_t            num_built_rules; /* rules in the RT structures. */
+	uint32_t            node_max; /* node limit used to split the tries. */
+	struct acl_update  *upd; /* incremental update state. */
+	RTE_ATOMIC(struct acl_update_snapshot *) upd_snap;
+	/* rules used by classify, NULL when no update is pending. */
 };
 
 int rte_acl_gen(struct rte_acl_ctx *ctx, struct rte_acl_trie *trie,
@@ -195,6 +231,17 @@ int rte_acl_gen(struct rte_acl_ctx *ctx, struct rte_acl_trie *trie,
 typedef int (*rte_acl_classify_t)
 (const struct rte_acl_ctx *, const uint8_t **, uint32_t *, uint32_t, uint32_t);
 
+int acl_check_rule(const struct rte_acl_rule_data *rd);
+
+void acl_update_free(struct rte_acl_ctx *ctx);
+
+void acl_update_reset_rules(struct rte_acl_ctx *ctx);
+
+int acl_update_classify(const struct rte_acl_ctx *ctx,
+	const struct acl_update_snapshot *snap, rte_acl_classify_t fn,
+	const uint8_t **data, uint32_t *results, uint32_t num,
+	uint32_t categories);
+
 /*
  * Different implementations of ACL classify.
  */
@@ -5,6 +5,7 @@
 #include <eal_export.h>
 #include <rte_acl.h>
 #include <rte_log.h>
+#include <rte_thread.h>
 
 #include "tb_mem.h"
 #include "acl.h"
@@ -23,6 +24,9 @@
 #define NODE_MAX	0x4000
 #define NODE_MIN	0x800
 
+/* lowest node limit tried to fit the tries into a memory budget */
+#define NODE_MIN_BUDGET	0x200
+
 /* TALLY are statistics per field */
 enum {
 	TALLY_0 = 0,        /* number of rules that are 0% or more wild. */
@@ -69,6 +73,8 @@ struct rte_acl_build_rule {
 	uint32_t                    *wildness;
 };
 
+struct acl_build_worker;
+
 /* Context for build phase */
 struct acl_build_context {
 	const struct rte_acl_ctx *acx;
@@ -84,6 +90,10 @@ struct acl_build_context {
 	uint32_t                  src_mask;
 	uint32_t                  num_build_rules;
 	uint32_t                  num_tries;
+	uint32_t                  num_threads;
+	uint32_t                  num_workers;
+	uint32_t                  num_joined;
+	struct acl_build_worker   *workers[RTE_ACL_MAX_TRIES];
 	struct tb_mem_pool        pool;
 	struct rte_acl_trie       tries[RTE_ACL_MAX_TRIES];
 	struct rte_acl_bld_trie   bld_tries[RTE_ACL_MAX_TRIES];
@@ -94,6 +104,16 @@ struct acl_build_context {
 	struct rte_acl_node       *node_free_list;
 };
 
+/* Generation of one trie of a split rule set, in its own build context. */
+struct acl_build_worker {
+	struct acl_build_context   bcx;
+	struct rte_acl_build_rule *rules;
+	uint32_t                   trie;
+	int32_t                    rc;
+	int32_t                    started;
+	rte_thread_t               tid;
+};
+
 static int acl_merge_trie(struct acl_build_context *context,
 	struct rte_acl_node *node_a, struct rte_acl_node *node_b,
 	uint32_t level, struct rte_acl_node **node_c);
@@ -779,6 +799,7 @@ acl_merge_trie(struct acl_build_context *context,
 static void
 acl_build_reset(struct rte_acl_ctx *ctx)
 {
+	acl_update_free(ctx);
 	ctx->mem_hook.free(ctx->mem, ctx->mem_hook.udata);
 	memset(&ctx->num_categories, 0,
 		sizeof(*ctx) - offsetof(struct rte_acl_ctx, num_categories));
@@ -1345,6 +1366,128 @@ build_one_trie(struct acl_build_context *context,
 	return last;
 }
 
+static void
+acl_build_init(struct acl_build_context *bcx, const struct rte_acl_ctx *ctx,
+	const struct rte_acl_config *cfg, uint32_t node_max)
+{
+	memset(bcx, 0, sizeof(*bcx));
+	bcx->acx = ctx;
+	bcx->pool.alignment = ACL_POOL_ALIGN;
+	bcx->pool.min_alloc = ACL_POOL_ALLOC_MIN;
+	bcx->cfg = *cfg;
+	bcx->category_mask = RTE_LEN2MASK(bcx->cfg.num_categories,
+		typeof(bcx->category_mask));
+	bcx->node_max = node_max;
+	bcx->num_threads = ctx->bld_param.num_threads;
+}
+
+static uint32_t
+acl_build_worker_main(void *arg)
+{
+	struct acl_build_worker *wrk;
+	struct rte_acl_build_rule *last;
+	struct rte_acl_build_rule *rule_sets[RTE_ACL_MAX_TRIES];
+
+	wrk = arg;
+
+	/* build phase runs out of memory. */
+	wrk->rc = sigsetjmp(wrk->bcx.pool.fail, 0);
+	if (wrk->rc != 0)
+		return 0;
+
+	rule_sets[wrk->trie] = wrk->rules;
+	last = build_one_trie(&wrk->bcx, rule_sets, wrk->trie, INT32_MAX);
+	if (wrk->bcx.bld_tries[wrk->trie].trie == NULL || last != NULL) {
+		ACL_LOG(ERR, "Build of %u-th trie failed", wrk->trie);
+		wrk->rc = -ENOMEM;
+	}
+
+	return 0;
+}
+
+/*
+ * Wait for the oldest worker and move its trie into the build context.
+ */
+static void
+acl_build_worker_join(struct acl_build_context *context)
+{
+	struct acl_build_worker *wrk;
+	uint32_t n;
+
+	wrk = context->workers[context->num_joined++];
+	if (wrk->started != 0)
+		rte_thread_join(wrk->tid, NULL);
+
+	n = wrk->trie;
+	context->tries[n] = wrk->bcx.tries[n];
+	memcpy(context->data_indexes[n], wrk->bcx.data_indexes[n],
+		sizeof(context->data_indexes[n]));
+	context->tries[n].data_index = context->data_indexes[n];
+	context->bld_tries[n] = wrk->bcx.bld_tries[n];
+	context->num_nodes += wrk->bcx.num_nodes;
+}
+
+/*
+ * Generate the trie for the given rules in a separate thread,
+ * or in the calling one if no thread can be started.
+ * Nodes of each trie never reference nodes of another one,
+ * so that the tries are built independently, each with its own pool.
+ */
+static void
+acl_build_worker_start(struct acl_build_context *context,
+	struct rte_acl_build_rule *rules, uint32_t n)
+{
+	struct acl_build_worker *wrk;
+	char name[RTE_THREAD_INTERNAL_NAME_SIZE];
+
+	/* the calling thread counts as one of the build threads */
+	if (context->num_workers - context->num_joined + 1 >=
+			context->num_threads)
+		acl_build_worker_join(context);
+
+	wrk = tb_alloc(&context->pool, sizeof(*wrk));
+	acl_build_init(&wrk->bcx, context->acx, &context->cfg,
+		context->node_max);
+	wrk->rules = rules;
+	wrk->trie = n;
+	context->workers[context->num_workers++] = wrk;
+
+	snprintf(name, sizeof(name), "acl-bld-%u", n);
+	if (rte_thread_create_internal_control(&wrk->tid, name,
+			acl_build_worker_main, wrk) == 0)
+		wrk->started = 1;
+	else
+		acl_build_worker_main(wrk);
+}
+
+/*
+ * Wait for all the workers, return the first error.
+ */
+static int
+acl_build_wait(struct acl_build_context *context)
+{
+	uint32_t i;
+
+	while (context->num_joined != context->num_workers)
+		acl_build_worker_join(context);
+
+	for (i = 0; i != context->num_workers; i++) {
+		if (context->workers[i]->rc != 0)
+			return context->workers[i]->rc;
+	}
+	return 0;
+}
+
+static void
+acl_build_fini(struct acl_build_context *context)
+{
+	uint32_t i;
+
+	for (i = 0; i != context->num_workers; i++)
+		tb_free_pool(&context->workers[i]->bcx.pool);
+	tb_free_pool(&context->pool);
+}
+
 static int
 acl_build_tries(struct acl_build_context *context,
 	struct rte_acl_build_rule *head)
@@ -1376,6 +1519,7 @@ acl_build_tries(struct acl_build_context *context,
 		last = build_one_trie(context, rule_sets, n, context->node_max);
 		if (context->bld_tries[n].trie == NULL) {
 			ACL_LOG(ERR, "Build of %u-th trie failed", n);
+			acl_build_wait(context);
 			return -ENOMEM;
 		}
 
@@ -1387,6 +1531,7 @@ acl_build_tries(struct acl_build_context *context,
 			ACL_LOG(ERR,
 				"Exceeded max number of tries: %u",
 				num_tries);
+			acl_build_wait(context);
 			return -ENOMEM;
 		}
 
@@ -1407,7 +1552,14 @@ acl_build_tries(struct acl_build_context *context,
 		/*
 		 * Rebuild the trie for the reduced rule-set.
 		 * Don't try to split it any further.
+		 * That can go in parallel with splitting the remaining rules.
 		 */
+		if (context->num_threads > 1) {
+			context->bld_tries[n].trie = NULL;
+			acl_build_worker_start(context, rule_sets[n], n);
+			continue;
+		}
+
 		last = build_one_trie(context, rule_sets, n, INT32_MAX);
 		if (context->bld_tries[n].trie == NULL || last != NULL) {
 			ACL_LOG(ERR, "Build of %u-th trie failed", n);
@@ -1417,13 +1569,18 @@ acl_build_tries(struct acl_build_context *context,
 	}
 
 	context->num_tries = num_tries;
-	return 0;
+	return acl_build_wait(context);
 }
 
 static void
 acl_build_log(const struct acl_build_context *ctx)
 {
 	uint32_t n;
+	size_t alloc;
+
+	alloc = ctx->pool.alloc;
+	for (n = 0; n != ctx->num_workers; n++)
+		alloc += ctx->workers[n]->bcx.pool.alloc;
 
 	RTE_LOG(DEBUG, ACL, "Build phase for ACL \"%s\":\n"
 		"node limit for tree split: %u\n"
@@ -1432,7 +1589,7 @@ acl_build_log(const struct acl_build_context *ctx)
 		ctx->acx->name,
 		ctx->node_max,
 		ctx->num_nodes,
-		ctx->pool.alloc);
+		alloc);
 
 	for (n = 0; n < RTE_DIM(ctx->tries); n++) {
 		if (ctx->tries[n].count != 0)
@@ -1514,19 +1671,13 @@ acl_bld(struct acl_build_context *bcx, struct rte_acl_ctx *ctx,
 	int32_t rc;
 
 	/* setup build context. */
-	memset(bcx, 0, sizeof(*bcx));
-	bcx->acx = ctx;
-	bcx->pool.alignment = ACL_POOL_ALIGN;
-	bcx->pool.min_alloc = ACL_POOL_ALLOC_MIN;
-	bcx->cfg = *cfg;
-	bcx->category_mask = RTE_LEN2MASK(bcx->cfg.num_categories,
-		typeof(bcx->category_mask));
-	bcx->node_max = node_max;
+	acl_build_init(bcx, ctx, cfg, node_max);
 
 	rc = sigsetjmp(bcx->pool.fail, 0);
 
 	/* build phase runs out of memory. */
 	if (rc != 0) {
+		acl_build_wait(bcx);
 		ACL_LOG(ERR,
 			"ACL context: %s, %s() failed with error code: %d",
 			bcx->acx->name, __func__, rc);
@@ -1627,7 +1778,7 @@ int
 rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 {
 	int32_t rc;
-	uint32_t n;
+	uint32_t n, n_min;
 	size_t max_size;
 	struct acl_build_context bcx;
 
@@ -1637,15 +1788,22 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 
 	acl_build_reset(ctx);
 
+	/*
+	 * With a memory budget, start with the highest node limit,
+	 * which gives the fewest tries, then lower it until
+	 * the RT structures fit.
+	 */
 	if (cfg->max_size == 0) {
 		n = NODE_MIN;
+		n_min = NODE_MIN;
 		max_size = SIZE_MAX;
 	} else {
 		n = NODE_MAX;
+		n_min = NODE_MIN_BUDGET;
 		max_size = cfg->max_size;
 	}
 
-	for (rc = -ERANGE; n >= NODE_MIN && rc == -ERANGE; n /= 2) {
+	for (rc = -ERANGE; n >= n_min && rc == -ERANGE; n /= 2) {
 
 		/* perform build phase. */
 		rc = acl_bld(&bcx, ctx, cfg, n);
@@ -1665,13 +1823,26 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 
 				/* copy in build config. */
 				ctx->config = *cfg;
+
+				/* rules covered by the RT structures. */
+				ctx->num_built_rules = ctx->num_rules;
+				ctx->node_max = n;
 			}
 		}
 
 		acl_build_log(&bcx);
 
 		/* cleanup after build. */
-		tb_free_pool(&bcx.pool);
+		acl_build_fini(&bcx);
+
+		/*
+		 * Below the default node limit, running out of tries
+		 * means that the budget can't be met.
+		 */
+		if (rc != 0 && rc != -ERANGE && n < NODE_MIN) {
+			rc = -ERANGE;
+			break;
+		}
 	}
 
 	return rc;
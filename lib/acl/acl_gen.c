@@ -229,6 +229,7 @@ acl_count_trie_types(struct acl_node_counters *counts,
 	if (node->node_type != (uint32_t)RTE_ACL_NODE_UNDEFINED)
 		return;
 
+	node->height = 0;
 	if (node->match_flag != 0 || node->num_ptrs == 0) {
 		counts->match++;
 		node->node_type = RTE_ACL_NODE_MATCH;
@@ -268,9 +269,12 @@ acl_count_trie_types(struct acl_node_counters *counts,
 	 * recursively count the types of all children
 	 */
 	for (n = 0; n < node->num_ptrs; n++) {
-		if (node->ptrs[n].ptr != NULL)
+		if (node->ptrs[n].ptr != NULL) {
 			acl_count_trie_types(counts, node->ptrs[n].ptr,
 				no_match, 0);
+			node->height = RTE_MAX(node->height,
+				node->ptrs[n].ptr->height + 1);
+		}
 	}
 }
 
@@ -417,19 +421,34 @@ acl_gen_node(struct rte_acl_node *node, uint64_t *node_array,
 
 static void
 acl_calc_counts_indices(struct acl_node_counters *counts,
-	struct rte_acl_indices *indices,
+	struct rte_acl_indices *indices, struct rte_acl_trie *trie,
 	struct rte_acl_bld_trie *node_bld_trie, uint32_t num_tries,
 	uint64_t no_match)
 {
 	uint32_t n;
+	struct acl_node_counters tc;
 
 	memset(indices, 0, sizeof(*indices));
 	memset(counts, 0, sizeof(*counts));
 
-	/* Get stats on nodes */
+	/* Get stats on nodes, for each trie and in total */
 	for (n = 0; n < num_tries; n++) {
-		acl_count_trie_types(counts, node_bld_trie[n].trie,
+		memset(&tc, 0, sizeof(tc));
+		acl_count_trie_types(&tc, node_bld_trie[n].trie,
 			no_match, 1);
+
+		trie[n].info.num_dfa = tc.dfa;
+		trie[n].info.num_quad = tc.quad;
+		trie[n].info.num_single = tc.single;
+		trie[n].info.num_match = tc.match;
+		trie[n].info.max_depth = node_bld_trie[n].trie->height;
+
+		counts->match += tc.match;
+		counts->single += tc.single;
+		counts->quad += tc.quad;
+		counts->quad_vectors += tc.quad_vectors;
+		counts->dfa += tc.dfa;
+		counts->dfa_gr64 += tc.dfa_gr64;
 	}
 
 	indices->dfa_index = RTE_ACL_DFA_SIZE + 1;
@@ -461,7 +480,7 @@ rte_acl_gen(struct rte_acl_ctx *ctx, struct rte_acl_trie *trie,
 	no_match = RTE_ACL_NODE_MATCH;
 
 	/* Fill counts and indices arrays from the nodes. */
-	acl_calc_counts_indices(&counts, &indices,
+	acl_calc_counts_indices(&counts, &indices, trie,
 		node_bld_trie, num_tries, no_match);
 
 	/* Allocate runtime memory (align to cache boundary) */
@@ -0,0 +1,921 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_acl.h>
+#include <rte_malloc.h>
+#include <rte_string_fns.h>
+
+#include "acl.h"
+#include "acl_log.h"
+
+/*
+ * Incremental updates of a built ACL context.
+ *
+ * The rule store of the context is kept with the rules covered by the
+ * base RT structures (from the last build or merge) first, followed by
+ * the rules added since. The delta RT structures are built from the added
+ * rules, plus copies of the base rules overlapping a deleted base rule
+ * with a lower or equal priority: those are the only rules that can become
+ * the best match of an input data previously matching the deleted rule.
+ * Classify searches both the base and the delta RT structures, masks out
+ * the deleted base rules, and keeps the result with the highest priority.
+ */
+
+/* max number of input data buffers classified at once with the delta. */
+#define ACL_UPDATE_BURST	64
+
+/* flag of the rules being deleted in the store index. */
+#define ACL_UPDATE_IDX_DEL	(UINT32_C(1) << 31)
+
+/* Position of a rule by userdata, in open addressing hash tables. */
+struct acl_update_idx {
+	uint32_t userdata; /* zero for an empty slot. */
+	uint32_t pos;
+};
+
+/* Incremental update state, only used by the writer. */
+struct acl_update {
+	struct acl_update_set      *base;  /* rules of the last build/merge. */
+	struct acl_update_set      *delta; /* rules changed since, or NULL. */
+	struct acl_update_snapshot *snap;  /* published snapshot. */
+	uint32_t                    num_base; /* base rules in the store. */
+	uint32_t                    num_copy; /* base rules copied to delta. */
+	uint32_t                    num_del;  /* base rules deleted. */
+	uint32_t                    num_idx;  /* store rules in the index. */
+	uint32_t                    idx_mask; /* index slots - 1. */
+	uint8_t                    *copy; /* copies of base rules. */
+	uint32_t                   *del;  /* userdata of deleted base rules. */
+	struct acl_update_idx      *idx;  /* store rules by userdata. */
+	struct acl_update_idx      *cidx; /* copies by userdata. */
+};
+
+static inline struct rte_acl_rule *
+acl_update_rule(const struct rte_acl_ctx *ctx, const void *rules, uint32_t idx)
+{
+	return (struct rte_acl_rule *)((uintptr_t)rules +
+		(size_t)idx * ctx->rule_sz);
+}
+
+/*
+ * Rules are indexed by userdata, which is unique and non-zero,
+ * with linear probing in tables at most half full.
+ */
+static inline struct acl_update_idx *
+acl_update_idx_slot(const struct acl_update *upd, struct acl_update_idx *tbl,
+	uint32_t userdata)
+{
+	uint32_t h;
+
+	h = userdata * UINT32_C(0x9e3779b1);
+	h = (h ^ (h >> 16)) & upd->idx_mask;
+	while (tbl[h].userdata != 0 && tbl[h].userdata != userdata)
+		h = (h + 1) & upd->idx_mask;
+	return tbl + h;
+}
+
+static inline struct acl_update_idx *
+acl_update_idx_get(const struct acl_update *upd, struct acl_update_idx *tbl,
+	uint32_t userdata)
+{
+	struct acl_update_idx *e;
+
+	e = acl_update_idx_slot(upd, tbl, userdata);
+	return (e->userdata != 0) ? e : NULL;
+}
+
+static inline void
+acl_update_idx_set(const struct acl_update *upd, struct acl_update_idx *tbl,
+	uint32_t userdata, uint32_t pos)
+{
+	struct acl_update_idx *e;
+
+	e = acl_update_idx_slot(upd, tbl, userdata);
+	e->userdata = userdata;
+	e->pos = pos;
+}
+
+static void
+acl_update_idx_del(const struct acl_update *upd, struct acl_update_idx *tbl,
+	uint32_t userdata)
+{
+	uint32_t h, i, j;
+
+	i = acl_update_idx_slot(upd, tbl, userdata) - tbl;
+	if (tbl[i].userdata == 0)
+		return;
+
+	/* shift back the following entries which probed past the slot */
+	for (j = (i + 1) & upd->idx_mask; tbl[j].userdata != 0;
+			j = (j + 1) & upd->idx_mask) {
+		h = tbl[j].userdata * UINT32_C(0x9e3779b1);
+		h = (h ^ (h >> 16)) & upd->idx_mask;
+		if (((j - h) & upd->idx_mask) >= ((j - i) & upd->idx_mask)) {
+			tbl[i] = tbl[j];
+			i = j;
+		}
+	}
+	tbl[i].userdata = 0;
+}
+
+/* Check if a rule is being deleted by the current update. */
+static inline int
+acl_update_idx_deleted(const struct acl_update *upd, uint32_t userdata)
+{
+	const struct acl_update_idx *e;
+
+	e = acl_update_idx_get(upd, upd->idx, userdata);
+	return e != NULL && (e->pos & ACL_UPDATE_IDX_DEL) != 0;
+}
+
+/* Index the rules added to the store with rte_acl_add_rules(). */
+static void
+acl_update_idx_sync(struct rte_acl_ctx *ctx)
+{
+	struct acl_update *upd;
+	uint32_t userdata;
+
+	upd = ctx->upd;
+	for (; upd->num_idx < ctx->num_rules; upd->num_idx++) {
+		userdata = acl_update_rule(ctx, ctx->rules,
+			upd->num_idx)->data.userdata;
+		if (userdata != 0 &&
+				acl_update_idx_get(upd, upd->idx, userdata) == NULL)
+			acl_update_idx_set(upd, upd->idx, userdata,
+				upd->num_idx);
+	}
+}
+
+static int
+acl_update_prio_cmp(const void *a, const void *b)
+{
+	const struct acl_update_prio *pa = a;
+	const struct acl_update_prio *pb = b;
+
+	return (pa->userdata > pb->userdata) - (pa->userdata < pb->userdata);
+}
+
+static int
+acl_update_userdata_cmp(const void *a, const void *b)
+{
+	const uint32_t *ua = a;
+	const uint32_t *ub = b;
+
+	return (*ua > *ub) - (*ua < *ub);
+}
+
+static inline const struct acl_update_prio *
+acl_update_prio_find(const struct acl_update_set *set, uint32_t userdata)
+{
+	uint32_t lo, hi, mid;
+
+	lo = 0;
+	hi = set->num_prio;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (set->prio[mid].userdata < userdata)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo != set->num_prio && set->prio[lo].userdata == userdata)
+		return set->prio + lo;
+	return NULL;
+}
+
+static inline int
+acl_update_deleted(const struct acl_update_snapshot *snap, uint32_t userdata)
+{
+	uint32_t lo, hi, mid;
+
+	lo = 0;
+	hi = snap->num_del;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (snap->del[mid] < userdata)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo != snap->num_del && snap->del[lo] == userdata;
+}
+
+int
+acl_update_classify(const struct rte_acl_ctx *ctx,
+	const struct acl_update_snapshot *snap, rte_acl_classify_t fn,
+	const uint8_t **data, uint32_t *results, uint32_t num,
+	uint32_t categories)
+{
+	const struct acl_update_prio *pb, *pd;
+	const struct rte_acl_ctx *base;
+	uint32_t dres[ACL_UPDATE_BURST * RTE_ACL_MAX_CATEGORIES];
+	uint32_t *res;
+	uint32_t d, i, j, n, r;
+	int32_t rc;
+
+	base = (snap->base->ctx != NULL) ? snap->base->ctx : ctx;
+	rc = fn(base, data, results, num, categories);
+	if (rc != 0 || (snap->delta == NULL && snap->num_del == 0))
+		return rc;
+
+	for (i = 0; i < num; i += n) {
+
+		n = RTE_MIN(num - i, (uint32_t)ACL_UPDATE_BURST);
+		res = results + i * categories;
+
+		if (snap->delta != NULL) {
+			rc = fn(snap->delta->ctx, data + i, dres, n,
+				categories);
+			if (rc != 0)
+				return rc;
+		}
+
+		for (j = 0; j != n * categories; j++) {
+
+			r = res[j];
+			if (r != 0 && snap->num_del != 0 &&
+					acl_update_deleted(snap, r))
+				r = 0;
+
+			d = (snap->delta != NULL) ? dres[j] : 0;
+			if (d != 0) {
+				/* keep the match with the highest priority */
+				pb = (r != 0) ?
+					acl_update_prio_find(snap->base, r) :
+					NULL;
+				pd = acl_update_prio_find(snap->delta, d);
+				if (pb == NULL || (pd != NULL &&
+						pd->priority > pb->priority))
+					r = d;
+			}
+
+			res[j] = r;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Check if two rules can match the same input data in a common category.
+ */
+static uint64_t
+acl_update_field_value(const union rte_acl_field_types *v, uint8_t size)
+{
+	switch (size) {
+	case sizeof(uint8_t):
+		return v->u8;
+	case sizeof(uint16_t):
+		return v->u16;
+	case sizeof(uint32_t):
+		return v->u32;
+	default:
+		return v->u64;
+	}
+}
+
+static int
+acl_update_rule_overlap(const struct rte_acl_config *cfg,
+	const struct rte_acl_rule *a, const struct rte_acl_rule *b)
+{
+	const struct rte_acl_field *fa, *fb;
+	uint64_t ma, mb, va, vb;
+	uint32_t i, len;
+	uint8_t size;
+
+	if ((a->data.category_mask & b->data.category_mask) == 0)
+		return 0;
+
+	for (i = 0; i != cfg->num_fields; i++) {
+
+		size = cfg->defs[i].size;
+		fa = a->field + cfg->defs[i].field_index;
+		fb = b->field + cfg->defs[i].field_index;
+		va = acl_update_field_value(&fa->value, size);
+		vb = acl_update_field_value(&fb->value, size);
+
+		switch (cfg->defs[i].type) {
+		case RTE_ACL_FIELD_TYPE_MASK:
+			/* prefixes overlap if equal on the shortest one */
+			len = RTE_MIN(fa->mask_range.u32, fb->mask_range.u32);
+			ma = RTE_ACL_MASKLEN_TO_BITMASK((uint64_t)len, size);
+			if (((va ^ vb) & ma) != 0)
+				return 0;
+			break;
+		case RTE_ACL_FIELD_TYPE_RANGE:
+			ma = acl_update_field_value(&fa->mask_range, size);
+			mb = acl_update_field_value(&fb->mask_range, size);
+			if (va > mb || vb > ma)
+				return 0;
+			break;
+		case RTE_ACL_FIELD_TYPE_BITMASK:
+			ma = acl_update_field_value(&fa->mask_range, size);
+			mb = acl_update_field_value(&fb->mask_range, size);
+			if (((va ^ vb) & ma & mb) != 0)
+				return 0;
+			break;
+		}
+	}
+
+	return 1;
+}
+
+static struct rte_acl_ctx *
+acl_update_ctx_create(const struct rte_acl_ctx *ctx, uint32_t num)
+{
+	struct rte_acl_ctx *acx;
+
+	acx = rte_zmalloc_socket(ctx->name, sizeof(*acx) +
+		(size_t)num * ctx->rule_sz, RTE_CACHE_LINE_SIZE,
+		ctx->socket_id);
+	if (acx == NULL) {
+		ACL_LOG(ERR, "%s(%s): allocation of %u rules failed",
+			__func__, ctx->name, num);
+		return NULL;
+	}
+
+	acx->rules = acx + 1;
+	acx->max_rules = num;
+	acx->rule_sz = ctx->rule_sz;
+	acx->socket_id = ctx->socket_id;
+	acx->alg = ctx->alg;
+	acx->mem_hook = ctx->mem_hook;
+	acx->bld_param = ctx->bld_param;
+	strlcpy(acx->name, ctx->name, sizeof(acx->name));
+	return acx;
+}
+
+static void
+acl_update_set_free(struct acl_update_set *set)
+{
+	if (set == NULL)
+		return;
+
+	if (set->ctx != NULL) {
+		set->ctx->mem_hook.free(set->ctx->mem,
+			set->ctx->mem_hook.udata);
+		rte_free(set->ctx);
+	}
+	rte_free(set);
+}
+
+/*
+ * Allocate a set of up to num rules,
+ * with its own RT structures if build is set.
+ */
+static struct acl_update_set *
+acl_update_set_create(const struct rte_acl_ctx *ctx, uint32_t num,
+	int build)
+{
+	struct acl_update_set *set;
+
+	set = rte_zmalloc_socket(NULL, sizeof(*set) +
+		(size_t)num * sizeof(set->prio[0]), 0, ctx->socket_id);
+	if (set == NULL)
+		return NULL;
+
+	set->prio = (struct acl_update_prio *)(set + 1);
+
+	if (build != 0) {
+		set->ctx = acl_update_ctx_create(ctx, num);
+		if (set->ctx == NULL) {
+			rte_free(set);
+			return NULL;
+		}
+	}
+
+	return set;
+}
+
+static void
+acl_update_set_add(struct acl_update_set *set, const struct rte_acl_ctx *ctx,
+	const void *rules, uint32_t num)
+{
+	const struct rte_acl_rule *rule;
+	uint32_t i;
+
+	for (i = 0; i != num; i++) {
+		rule = acl_update_rule(ctx, rules, i);
+		set->prio[set->num_prio].userdata = rule->data.userdata;
+		set->prio[set->num_prio].priority = rule->data.priority;
+		set->num_prio++;
+	}
+
+	if (set->ctx != NULL) {
+		memcpy(acl_update_rule(ctx, set->ctx->rules,
+			set->ctx->num_rules), rules, (size_t)num * ctx->rule_sz);
+		set->ctx->num_rules += num;
+	}
+}
+
+static int
+acl_update_set_build(struct acl_update_set *set, const struct rte_acl_ctx *ctx)
+{
+	qsort(set->prio, set->num_prio, sizeof(set->prio[0]),
+		acl_update_prio_cmp);
+
+	if (set->ctx == NULL)
+		return 0;
+
+	return rte_acl_build(set->ctx, &ctx->config);
+}
+
+static struct acl_update_snapshot *
+acl_update_snapshot_create(const struct rte_acl_ctx *ctx,
+	const struct acl_update_set *base, const struct acl_update_set *delta,
+	const uint32_t *del, uint32_t num_del)
+{
+	struct acl_update_snapshot *snap;
+	uint32_t *sdel;
+
+	snap = rte_zmalloc_socket(NULL, sizeof(*snap) +
+		(size_t)num_del * sizeof(sdel[0]), RTE_CACHE_LINE_SIZE,
+		ctx->socket_id);
+	if (snap == NULL)
+		return NULL;
+
+	sdel = (uint32_t *)(snap + 1);
+	memcpy(sdel, del, (size_t)num_del * sizeof(sdel[0]));
+	qsort(sdel, num_del, sizeof(sdel[0]), acl_update_userdata_cmp);
+
+	snap->base = base;
+	snap->delta = delta;
+	snap->num_del = num_del;
+	snap->del = sdel;
+	return snap;
+}
+
+/*
+ * Make classify use the new snapshot, then release the previous one
+ * and the given sets once no classify can use them anymore.
+ */
+static void
+acl_update_publish(struct rte_acl_ctx *ctx, struct acl_update_snapshot *snap,
+	struct acl_update_set *old_base, struct acl_update_set *old_delta)
+{
+	struct acl_update_snapshot *old;
+
+	old = ctx->upd->snap;
+	ctx->upd->snap = snap;
+	rte_atomic_store_explicit(&ctx->upd_snap, snap,
+		rte_memory_order_release);
+
+	if (ctx->rcu != NULL)
+		rte_rcu_qsbr_synchronize(ctx->rcu, RTE_QSBR_THRID_INVALID);
+
+	rte_free(old);
+	acl_update_set_free(old_base);
+	acl_update_set_free(old_delta);
+}
+
+/*
+ * Build the delta from the rules changed since the last build or merge,
+ * and publish it. The first num_copy copies and num_del deleted rules
+ * are used, which can include the pending ones of a deletion,
+ * and the rules flagged as being deleted in the index are skipped.
+ * Nothing is changed on failure.
+ */
+static int
+acl_update_commit(struct rte_acl_ctx *ctx, uint32_t num_copy, uint32_t num_del)
+{
+	struct acl_update *upd;
+	struct acl_update_set *delta;
+	struct acl_update_snapshot *snap;
+	const struct rte_acl_rule *rule;
+	uint32_t i, num;
+	int32_t rc;
+
+	upd = ctx->upd;
+
+	num = 0;
+	for (i = upd->num_base; i != ctx->num_rules; i++) {
+		rule = acl_update_rule(ctx, ctx->rules, i);
+		num += !acl_update_idx_deleted(upd, rule->data.userdata);
+	}
+	for (i = 0; i != num_copy; i++) {
+		rule = acl_update_rule(ctx, upd->copy, i);
+		num += !acl_update_idx_deleted(upd, rule->data.userdata);
+	}
+
+	delta = NULL;
+	if (num != 0) {
+		delta = acl_update_set_create(ctx, num, 1);
+		if (delta == NULL)
+			return -ENOMEM;
+
+		for (i = upd->num_base; i != ctx->num_rules; i++) {
+			rule = acl_update_rule(ctx, ctx->rules, i);
+			if (!acl_update_idx_deleted(upd, rule->data.userdata))
+				acl_update_set_add(delta, ctx, rule, 1);
+		}
+		for (i = 0; i != num_copy; i++) {
+			rule = acl_update_rule(ctx, upd->copy, i);
+			if (!acl_update_idx_deleted(upd, rule->data.userdata))
+				acl_update_set_add(delta, ctx, rule, 1);
+		}
+
+		rc = acl_update_set_build(delta, ctx);
+		if (rc != 0) {
+			acl_update_set_free(delta);
+			return rc;
+		}
+	}
+
+	snap = acl_update_snapshot_create(ctx, upd->base, delta, upd->del,
+		num_del);
+	if (snap == NULL) {
+		acl_update_set_free(delta);
+		return -ENOMEM;
+	}
+
+	acl_update_publish(ctx, snap, NULL, upd->delta);
+	upd->delta = delta;
+	return 0;
+}
+
+static int
+acl_update_init(struct rte_acl_ctx *ctx)
+{
+	struct acl_update *upd;
+	uint32_t num_idx;
+
+	if (ctx->upd != NULL)
+		return 0;
+
+	/* updates apply on top of built RT structures */
+	if (ctx->trans_table == NULL)
+		return -EINVAL;
+
+	num_idx = rte_align32pow2(2 * RTE_MAX(ctx->max_rules, 1U));
+
+	upd = rte_zmalloc_socket(NULL, sizeof(*upd) +
+		(size_t)num_idx * 2 * sizeof(upd->idx[0]) +
+		(size_t)ctx->max_rules * (sizeof(upd->del[0]) + ctx->rule_sz),
+		RTE_CACHE_LINE_SIZE, ctx->socket_id);
+	if (upd == NULL)
+		return -ENOMEM;
+
+	upd->idx = (struct acl_update_idx *)(upd + 1);
+	upd->cidx = upd->idx + num_idx;
+	upd->idx_mask = num_idx - 1;
+	upd->del = (uint32_t *)(upd->cidx + num_idx);
+	upd->copy = (uint8_t *)(upd->del + ctx->max_rules);
+	upd->num_base = RTE_MIN(ctx->num_built_rules, ctx->num_rules);
+
+	/* base rules are classified with the context own RT structures */
+	upd->base = acl_update_set_create(ctx, upd->num_base, 0);
+	if (upd->base == NULL) {
+		rte_free(upd);
+		return -ENOMEM;
+	}
+	acl_update_set_add(upd->base, ctx, ctx->rules, upd->num_base);
+	acl_update_set_build(upd->base, ctx);
+
+	ctx->upd = upd;
+	acl_update_idx_sync(ctx);
+	return 0;
+}
+
+void
+acl_update_free(struct rte_acl_ctx *ctx)
+{
+	struct acl_update *upd;
+
+	upd = ctx->upd;
+	if (upd == NULL)
+		return;
+
+	rte_atomic_store_explicit(&ctx->upd_snap, NULL,
+		rte_memory_order_relaxed);
+	rte_free(upd->snap);
+	acl_update_set_free(upd->delta);
+	acl_update_set_free(upd->base);
+	rte_free(upd);
+	ctx->upd = NULL;
+}
+
+void
+acl_update_reset_rules(struct rte_acl_ctx *ctx)
+{
+	struct acl_update *upd;
+
+	ctx->num_built_rules = 0;
+
+	upd = ctx->upd;
+	if (upd != NULL) {
+		upd->num_base = 0;
+		upd->num_idx = 0;
+		memset(upd->idx, 0, (upd->idx_mask + 1) * sizeof(upd->idx[0]));
+	}
+}
+
+/*
+ * Prepare the deletion of the base rule at index idx of the rule store,
+ * flagged in the index: the lower priority base rules which can match
+ * instead are copied, and the rule is appended to the deleted ones,
+ * after the num_copy and num_del already used.
+ */
+static void
+acl_update_del_base(struct rte_acl_ctx *ctx, uint32_t idx,
+	uint32_t *num_copy, uint32_t *num_del)
+{
+	struct acl_update *upd;
+	const struct rte_acl_rule *del, *rule;
+	uint32_t i;
+
+	upd = ctx->upd;
+	del = acl_update_rule(ctx, ctx->rules, idx);
+
+	for (i = 0; i != upd->num_base; i++) {
+		rule = acl_update_rule(ctx, ctx->rules, i);
+		if (rule->data.priority > del->data.priority ||
+				acl_update_idx_deleted(upd,
+					rule->data.userdata) ||
+				acl_update_rule_overlap(&ctx->config,
+					del, rule) == 0 ||
+				acl_update_idx_get(upd, upd->cidx,
+					rule->data.userdata) != NULL)
+			continue;
+		memcpy(acl_update_rule(ctx, upd->copy, *num_copy), rule,
+			ctx->rule_sz);
+		acl_update_idx_set(upd, upd->cidx, rule->data.userdata,
+			*num_copy);
+		(*num_copy)++;
+	}
+
+	upd->del[(*num_del)++] = del->data.userdata;
+}
+
+/*
+ * Move the rule at index src of the rule store to index dst.
+ */
+static void
+acl_update_move(struct rte_acl_ctx *ctx, uint32_t dst, uint32_t src)
+{
+	struct acl_update_idx *e;
+	struct rte_acl_rule *rule;
+
+	rule = acl_update_rule(ctx, ctx->rules, src);
+	e = acl_update_idx_get(ctx->upd, ctx->upd->idx, rule->data.userdata);
+	if (e != NULL && (e->pos & ~ACL_UPDATE_IDX_DEL) == src)
+		e->pos = dst | (e->pos & ACL_UPDATE_IDX_DEL);
+	memcpy(acl_update_rule(ctx, ctx->rules, dst), rule, ctx->rule_sz);
+}
+
+/*
+ * Remove the deleted rules from the copies and the rule store,
+ * once the delta without them is published.
+ */
+static void
+acl_update_del_apply(struct rte_acl_ctx *ctx, const uint32_t *userdata,
+	uint32_t num, uint32_t num_copy, uint32_t num_del)
+{
+	struct acl_update *upd;
+	struct acl_update_idx *e;
+	const struct rte_acl_rule *rule;
+	uint32_t i, idx, last, n;
+
+	upd = ctx->upd;
+
+	/* the deleted rules might have been copied for previous deletions */
+	for (i = 0, n = 0; i != num_copy; i++) {
+		rule = acl_update_rule(ctx, upd->copy, i);
+		if (acl_update_idx_deleted(upd, rule->data.userdata)) {
+			acl_update_idx_del(upd, upd->cidx, rule->data.userdata);
+			continue;
+		}
+		if (n != i) {
+			memcpy(acl_update_rule(ctx, upd->copy, n), rule,
+				ctx->rule_sz);
+			acl_update_idx_set(upd, upd->cidx,
+				rule->data.userdata, n);
+		}
+		n++;
+	}
+	upd->num_copy = n;
+	upd->num_del = num_del;
+
+	for (i = 0; i != num; i++) {
+		e = acl_update_idx_get(upd, upd->idx, userdata[i]);
+		if (e == NULL)
+			continue;
+		idx = e->pos & ~ACL_UPDATE_IDX_DEL;
+		acl_update_idx_del(upd, upd->idx, userdata[i]);
+
+		/* keep base rules first */
+		if (idx < upd->num_base) {
+			last = upd->num_base - 1;
+			if (idx != last)
+				acl_update_move(ctx, idx, last);
+			idx = last;
+			upd->num_base--;
+		}
+
+		last = ctx->num_rules - 1;
+		if (idx != last)
+			acl_update_move(ctx, idx, last);
+		ctx->num_rules--;
+	}
+	upd->num_idx = ctx->num_rules;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_update_add_rules, 26.11)
+int
+rte_acl_update_add_rules(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rule *rules, uint32_t num)
+{
+	struct acl_update *upd;
+	const struct rte_acl_rule *rv;
+	uint32_t i;
+	int32_t rc;
+
+	if (ctx == NULL || rules == NULL || num == 0 || ctx->rule_sz == 0)
+		return -EINVAL;
+
+	for (i = 0; i != num; i++) {
+		rv = acl_update_rule(ctx, rules, i);
+		if (acl_check_rule(&rv->data) != 0 || rv->data.userdata == 0) {
+			ACL_LOG(ERR, "%s(%s): rule #%u is invalid",
+				__func__, ctx->name, i + 1);
+			return -EINVAL;
+		}
+	}
+
+	rc = acl_update_init(ctx);
+	if (rc != 0)
+		return rc;
+
+	if (num + ctx->num_rules > ctx->max_rules)
+		return -ENOMEM;
+
+	upd = ctx->upd;
+	acl_update_idx_sync(ctx);
+
+	/* index the new rules, which also finds duplicates in the batch */
+	for (i = 0; i != num; i++) {
+		rv = acl_update_rule(ctx, rules, i);
+		if (acl_update_idx_get(upd, upd->idx,
+				rv->data.userdata) != NULL) {
+			ACL_LOG(ERR, "%s(%s): rule #%u userdata %u already exists",
+				__func__, ctx->name, i + 1, rv->data.userdata);
+			while (i-- != 0)
+				acl_update_idx_del(upd, upd->idx,
+					acl_update_rule(ctx, rules,
+						i)->data.userdata);
+			return -EEXIST;
+		}
+		acl_update_idx_set(upd, upd->idx, rv->data.userdata,
+			ctx->num_rules + i);
+	}
+
+	memcpy(acl_update_rule(ctx, ctx->rules, ctx->num_rules), rules,
+		(size_t)num * ctx->rule_sz);
+	ctx->num_rules += num;
+
+	rc = acl_update_commit(ctx, upd->num_copy, upd->num_del);
+	if (rc != 0) {
+		ctx->num_rules -= num;
+		for (i = 0; i != num; i++)
+			acl_update_idx_del(upd, upd->idx,
+				acl_update_rule(ctx, rules, i)->data.userdata);
+		return rc;
+	}
+
+	upd->num_idx = ctx->num_rules;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_update_del_rules, 26.11)
+int
+rte_acl_update_del_rules(struct rte_acl_ctx *ctx, const uint32_t *userdata,
+	uint32_t num)
+{
+	struct acl_update *upd;
+	struct acl_update_idx *e;
+	const struct rte_acl_rule *rule;
+	uint32_t i, idx, num_copy, num_del;
+	int32_t rc;
+
+	if (ctx == NULL || userdata == NULL || num == 0 || ctx->rule_sz == 0)
+		return -EINVAL;
+
+	rc = acl_update_init(ctx);
+	if (rc != 0)
+		return rc;
+
+	upd = ctx->upd;
+	acl_update_idx_sync(ctx);
+
+	for (i = 0; i != num; i++) {
+		if (acl_update_idx_get(upd, upd->idx, userdata[i]) == NULL)
+			return -ENOENT;
+	}
+
+	/*
+	 * Flag the rules and prepare the copies first: the store is only
+	 * changed once the delta without the rules is published,
+	 * so that a failure leaves the context as it was.
+	 */
+	num_copy = upd->num_copy;
+	num_del = upd->num_del;
+	for (i = 0; i != num; i++) {
+		e = acl_update_idx_get(upd, upd->idx, userdata[i]);
+		if ((e->pos & ACL_UPDATE_IDX_DEL) != 0)
+			continue;
+		e->pos |= ACL_UPDATE_IDX_DEL;
+		idx = e->pos & ~ACL_UPDATE_IDX_DEL;
+		if (idx < upd->num_base)
+			acl_update_del_base(ctx, idx, &num_copy, &num_del);
+	}
+
+	rc = acl_update_commit(ctx, num_copy, num_del);
+	if (rc != 0) {
+		for (i = upd->num_copy; i != num_copy; i++) {
+			rule = acl_update_rule(ctx, upd->copy, i);
+			acl_update_idx_del(upd, upd->cidx, rule->data.userdata);
+		}
+		for (i = 0; i != num; i++)
+			acl_update_idx_get(upd, upd->idx, userdata[i])->pos &=
+				~ACL_UPDATE_IDX_DEL;
+		return rc;
+	}
+
+	acl_update_del_apply(ctx, userdata, num, num_copy, num_del);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_update_pending, 26.11)
+uint32_t
+rte_acl_update_pending(const struct rte_acl_ctx *ctx)
+{
+	const struct acl_update *upd;
+
+	if (ctx == NULL || ctx->upd == NULL)
+		return 0;
+
+	upd = ctx->upd;
+	return ctx->num_rules - upd->num_base + upd->num_copy + upd->num_del;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_update_merge, 26.11)
+int
+rte_acl_update_merge(struct rte_acl_ctx *ctx)
+{
+	struct acl_update *upd;
+	struct acl_update_set *base;
+	struct acl_update_snapshot *snap;
+	int32_t rc;
+
+	if (ctx == NULL)
+		return -EINVAL;
+
+	if (ctx->upd == NULL)
+		return (ctx->trans_table == NULL) ? -EINVAL : 0;
+
+	if (rte_acl_update_pending(ctx) == 0)
+		return 0;
+
+	if (ctx->num_rules == 0)
+		return -EINVAL;
+
+	base = acl_update_set_create(ctx, ctx->num_rules, 1);
+	if (base == NULL)
+		return -ENOMEM;
+
+	acl_update_set_add(base, ctx, ctx->rules, ctx->num_rules);
+	rc = acl_update_set_build(base, ctx);
+	if (rc != 0) {
+		acl_update_set_free(base);
+		return rc;
+	}
+
+	snap = acl_update_snapshot_create(ctx, base, NULL, NULL, 0);
+	if (snap == NULL) {
+		acl_update_set_free(base);
+		return -ENOMEM;
+	}
+
+	upd = ctx->upd;
+	acl_update_publish(ctx, snap, upd->base, upd->delta);
+
+	/* the context own RT structures are not used anymore */
+	if (ctx->mem != NULL) {
+		ctx->mem_hook.free(ctx->mem, ctx->mem_hook.udata);
+		ctx->mem = NULL;
+		ctx->mem_sz = 0;
+		ctx->trans_table = NULL;
+		ctx->data_indexes = NULL;
+	}
+
+	upd->base = base;
+	upd->delta = NULL;
+	upd->num_base = ctx->num_rules;
+	upd->num_copy = 0;
+	upd->num_del = 0;
+	memset(upd->cidx, 0, (upd->idx_mask + 1) * sizeof(upd->cidx[0]));
+	return 0;
+}
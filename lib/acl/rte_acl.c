@@ -341,10 +341,19 @@ rte_acl_classify_alg(const struct rte_acl_ctx *ctx, const uint8_t **data,
 	uint32_t *results, uint32_t num, uint32_t categories,
 	enum rte_acl_classify_alg alg)
 {
+	const struct acl_update_snapshot *snap;
+
 	if (categories != 1 &&
 			((RTE_ACL_RESULTS_MULTIPLIER - 1) & categories) != 0)
 		return -EINVAL;
 
+	/* merge in the incremental updates, if any */
+	snap = rte_atomic_load_explicit(&ctx->upd_snap,
+		rte_memory_order_acquire);
+	if (unlikely(snap != NULL))
+		return acl_update_classify(ctx, snap, classify_fns[alg],
+			data, results, num, categories);
+
 	return classify_fns[alg](ctx, data, results, num, categories);
 }
 
@@ -410,6 +419,7 @@ rte_acl_free(struct rte_acl_ctx *ctx)
 
 	rte_mcfg_tailq_write_unlock();
 
+	acl_update_free(ctx);
 	ctx->mem_hook.free(ctx->mem, ctx->mem_hook.udata);
 	rte_free(ctx);
 	rte_free(te);
@@ -504,7 +514,7 @@ acl_add_rules(struct rte_acl_ctx *ctx, const void *rules, uint32_t num)
 	return 0;
 }
 
-static int
+int
 acl_check_rule(const struct rte_acl_rule_data *rd)
 {
 	if ((RTE_LEN2MASK(RTE_ACL_MAX_CATEGORIES, typeof(rd->category_mask)) &
@@ -549,8 +559,10 @@ RTE_EXPORT_SYMBOL(rte_acl_reset_rules)
 void
 rte_acl_reset_rules(struct rte_acl_ctx *ctx)
 {
-	if (ctx != NULL)
+	if (ctx != NULL) {
 		ctx->num_rules = 0;
+		acl_update_reset_rules(ctx);
+	}
 }
 
 /*
@@ -632,3 +644,66 @@ rte_acl_get_mem_hook(const struct rte_acl_ctx *acl, struct rte_acl_mem_hook *mho
 	memcpy(mhook, &acl->mem_hook, sizeof(struct rte_acl_mem_hook));
 	return 0;
 }
+
+/*
+ * Set the build parameters of an ACL context.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_set_build_param, 26.11)
+int
+rte_acl_set_build_param(struct rte_acl_ctx *acl,
+	const struct rte_acl_build_param *prm)
+{
+	if (acl == NULL || prm == NULL)
+		return -EINVAL;
+
+	acl->bld_param = *prm;
+	return 0;
+}
+
+/*
+ * Retrieve information about the RT structures of an ACL context.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_get_build_info, 26.11)
+int
+rte_acl_get_build_info(const struct rte_acl_ctx *acl,
+	struct rte_acl_build_info *info)
+{
+	const struct acl_update_snapshot *snap;
+	uint32_t i;
+
+	if (acl == NULL || info == NULL)
+		return -EINVAL;
+
+	/* after a merge of incremental updates, report the merged rules */
+	snap = rte_atomic_load_explicit(&acl->upd_snap,
+		rte_memory_order_relaxed);
+	if (snap != NULL && snap->base->ctx != NULL)
+		acl = snap->base->ctx;
+
+	if (acl->trans_table == NULL)
+		return -EINVAL;
+
+	memset(info, 0, sizeof(*info));
+	info->mem_size = acl->mem_sz;
+	info->num_tries = acl->num_tries;
+	info->node_max = acl->node_max;
+	for (i = 0; i != acl->num_tries; i++)
+		info->trie[i] = acl->trie[i].info;
+	return 0;
+}
+
+/*
+ * Associate RCU QSBR variable with an ACL context.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_rcu_qsbr_add, 26.11)
+int
+rte_acl_rcu_qsbr_add(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rcu_config *cfg)
+{
+	if (ctx == NULL || cfg == NULL || cfg->v == NULL)
+		return -EINVAL;
+	if (ctx->rcu != NULL)
+		return -EEXIST;
+	ctx->rcu = cfg->v;
+	return 0;
+}
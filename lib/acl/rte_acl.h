@@ -13,6 +13,7 @@
 
 #include <rte_common.h>
 #include <rte_acl_osdep.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,9 @@ extern "C" {
 #define RTE_ACL_MAX_LEVELS 64
 #define RTE_ACL_MAX_FIELDS 64
 
+/** MAX number of tries per one ACL context.*/
+#define RTE_ACL_MAX_TRIES	8
+
 union rte_acl_field_types {
 	uint8_t  u8;
 	uint16_t u16;
@@ -191,6 +195,94 @@ int rte_acl_set_mem_hook(struct rte_acl_ctx *acl, const struct rte_acl_mem_hook
 __rte_experimental
 int rte_acl_get_mem_hook(const struct rte_acl_ctx *acl, struct rte_acl_mem_hook *mhook);
 
+/**
+ * Parameters of the build phase of an ACL context.
+ */
+struct rte_acl_build_param {
+	/**
+	 * Max number of threads generating the tries, including the caller.
+	 * Zero or one generates all the tries in the calling thread.
+	 */
+	uint32_t num_threads;
+};
+
+/**
+ * Information about one trie of the run-time structures.
+ */
+struct rte_acl_trie_info {
+	uint32_t num_dfa;    /**< Nodes with a 256 entries transition table. */
+	uint32_t num_quad;   /**< Nodes with up to 5 ranges of input values. */
+	uint32_t num_single; /**< Nodes with a single transition. */
+	uint32_t num_match;  /**< Match nodes. */
+	/**
+	 * Max number of transitions from the root to a match node,
+	 * one per input byte.
+	 */
+	uint32_t max_depth;
+};
+
+/**
+ * Information about the run-time structures of the last build.
+ */
+struct rte_acl_build_info {
+	size_t   mem_size;    /**< Size of the run-time structures, in bytes. */
+	uint32_t num_tries;   /**< Number of tries the rules are split into. */
+	uint32_t node_max;    /**< Node limit used to split the rules. */
+	/** Nodes and depth of each of the num_tries tries. */
+	struct rte_acl_trie_info trie[RTE_ACL_MAX_TRIES];
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the build parameters of a given ACL context.
+ *
+ * The rules are split into independent tries when building them as a
+ * single trie would use too much memory. When more than one thread is
+ * allowed, the generation of the tries is spread over control threads.
+ * The resulting run-time structures do not depend on the number of threads.
+ *
+ * This function must be called before rte_acl_build().
+ *
+ * @param acl
+ *   The ACL context.
+ * @param prm
+ *   Pointer to the build parameters.
+ *
+ * @return
+ *   0 on success.
+ *   -EINVAL if parameters are invalid.
+ */
+__rte_experimental
+int rte_acl_set_build_param(struct rte_acl_ctx *acl,
+	const struct rte_acl_build_param *prm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Retrieve information about the run-time structures of an ACL context.
+ *
+ * When rte_acl_config.max_size is set, rte_acl_build() looks for the
+ * node limit giving the fewest tries which fits in this memory budget.
+ * The number of tries, their depth and their nodes reported here allow
+ * to compare the classify cost of different budgets for the same rules:
+ * classify walks each trie, and the DFA nodes are the fastest to walk.
+ *
+ * @param acl
+ *   The ACL context, built with rte_acl_build().
+ * @param info
+ *   Output location for the build information.
+ *
+ * @return
+ *   0 on success.
+ *   -EINVAL if parameters are invalid or the context is not built.
+ */
+__rte_experimental
+int rte_acl_get_build_info(const struct rte_acl_ctx *acl,
+	struct rte_acl_build_info *info);
+
 /**
  * De-allocate all memory used by ACL context.
  *
@@ -291,6 +383,143 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg);
 void
 rte_acl_reset(struct rte_acl_ctx *ctx);
 
+/** RCU reclamation configuration of an ACL context. */
+struct rte_acl_rcu_config {
+	struct rte_rcu_qsbr *v; /**< RCU QSBR variable. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Associate RCU QSBR variable with an ACL context.
+ *
+ * Once attached, incremental updates wait for the classify threads
+ * reporting to this variable to go through a quiescent state before
+ * releasing run-time structures, so that they can run concurrently
+ * with rte_acl_classify().
+ *
+ * @param ctx
+ *   ACL context to configure.
+ * @param cfg
+ *   RCU QSBR configuration.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - -EEXIST if an RCU QSBR variable is already attached.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_rcu_qsbr_add(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rcu_config *cfg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add rules to a built ACL context without a full rebuild.
+ *
+ * The rules are added to the context and to a small delta set of rules,
+ * which is rebuilt and searched by rte_acl_classify() alongside the rules
+ * of the last build or merge, until rte_acl_update_merge() is called.
+ * Rules handled by incremental updates are identified by their userdata,
+ * which must be unique and non-zero in the context.
+ *
+ * Updates are not multi-thread safe with each other.
+ * They can run concurrently with rte_acl_classify() only if an RCU QSBR
+ * variable is attached with rte_acl_rcu_qsbr_add().
+ *
+ * @param ctx
+ *   ACL context built with rte_acl_build().
+ * @param rules
+ *   Array of rules to add, in the same format as for rte_acl_add_rules().
+ * @param num
+ *   Number of elements in the input array of rules.
+ * @return
+ *   - -EINVAL if the parameters are invalid or the context is not built.
+ *   - -EEXIST if a rule with the same userdata is already in the context.
+ *   - -ENOMEM if there is no space in the ACL context for these rules,
+ *     or if the delta could not be built.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_update_add_rules(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rule *rules, uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Delete rules from a built ACL context without a full rebuild.
+ *
+ * Deleted rules are masked out of the classify results.
+ * The rules with a lower priority overlapping a deleted rule
+ * are copied to the delta set, so that they are still found
+ * for the input data matching the deleted rule.
+ * See rte_acl_update_add_rules() for the threading constraints.
+ *
+ * @param ctx
+ *   ACL context built with rte_acl_build().
+ * @param userdata
+ *   Array of userdata identifying the rules to delete.
+ * @param num
+ *   Number of elements in the input array.
+ * @return
+ *   - -EINVAL if the parameters are invalid or the context is not built.
+ *   - -ENOENT if no rule with one of the userdata is in the context,
+ *     no rule is deleted in that case.
+ *   - -ENOMEM if the delta could not be built, no rule is deleted
+ *     in that case.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_update_del_rules(struct rte_acl_ctx *ctx, const uint32_t *userdata,
+	uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the number of pending incremental updates of an ACL context,
+ * to decide when to merge them.
+ *
+ * @param ctx
+ *   ACL context.
+ * @return
+ *   Number of rules in the delta set plus number of deleted rules.
+ */
+__rte_experimental
+uint32_t
+rte_acl_update_pending(const struct rte_acl_ctx *ctx);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Merge the pending incremental updates of an ACL context.
+ *
+ * All the rules of the context are built into new run-time structures,
+ * with the configuration of the last rte_acl_build(), which then replace
+ * the previous ones and the delta set.
+ * With an RCU QSBR variable attached, classify keeps using the previous
+ * structures while they are built, so this can be called from a
+ * background thread, serialized with the other updates.
+ *
+ * @param ctx
+ *   ACL context built with rte_acl_build().
+ * @return
+ *   - -EINVAL if the parameters are invalid, the context is not built,
+ *     or it has no rule left.
+ *   - Negative error code of rte_acl_build() if the build failed,
+ *     the pending updates are kept in that case.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_update_merge(struct rte_acl_ctx *ctx);
+
 /**
  *  Available implementations of ACL classify.
  */
@@ -38,6 +38,13 @@
 #define MAX_VECTOR_NS		1E9
 #define MIN_VECTOR_NS		1E5
 
+/* Flushed vectors per adaptation step of an adaptive vector queue */
+#define RXA_VECTOR_ADAPT_WINDOW	128
+/* Vectors of a window allowed above the latency target, i.e. p99 */
+#define RXA_VECTOR_ADAPT_OVER	(RXA_VECTOR_ADAPT_WINDOW / 100)
+/* Lowest timeout of an adaptive queue as a fraction of the target */
+#define RXA_VECTOR_MIN_TMO_SHIFT	4
+
 #define RXA_NB_RX_WORK_DEFAULT 128
 
 #define ETH_RX_ADAPTER_SERVICE_NAME_LEN	32
@@ -73,16 +80,41 @@ struct eth_rx_poll_entry {
 	uint16_t eth_rx_qid;
 };
 
+enum rxa_vector_flush {
+	RXA_VECTOR_FLUSH_FULL,
+	RXA_VECTOR_FLUSH_TIMEOUT,
+	RXA_VECTOR_FLUSH_EARLY,
+};
+
 struct __rte_cache_aligned eth_rx_vector_data {
 	TAILQ_ENTRY(eth_rx_vector_data) next;
 	uint16_t port;
 	uint16_t queue;
 	uint16_t max_vector_count;
+	/* Size at which the vector is flushed, below max_vector_count
+	 * when the vector size adapts to the load
+	 */
+	uint16_t cur_vector_count;
+	uint8_t adaptive;
 	uint64_t event;
 	uint64_t ts;
 	uint64_t vector_timeout_ticks;
 	struct rte_mempool *vector_pool;
 	struct rte_event_vector *vector_ev;
+	/* Arrival of the first mbuf of the vector being built */
+	uint64_t first_ts;
+	uint64_t ticks_per_us;
+	/* p99 latency target of an adaptive queue */
+	uint64_t target_ticks;
+	/* Moving average of the mbuf inter-arrival time */
+	uint64_t gap_ticks;
+	uint64_t last_rx_ts;
+	/* Current adaptation window */
+	uint16_t win_count;
+	uint16_t win_over;
+	uint16_t win_full;
+	uint64_t max_lat_ticks;
+	struct rte_event_eth_rx_adapter_vector_stats stats;
 };
 
 TAILQ_HEAD(eth_rx_vector_data_list, eth_rx_vector_data);
@@ -865,6 +897,93 @@ rxa_init_vector(struct event_eth_rx_adapter *rx_adapter,
 	TAILQ_INSERT_TAIL(&rx_adapter->vector_list, vec, next);
 }
 
+/* Adjust the size and the timeout of an adaptive vector queue once per
+ * window: back off multiplicatively when more than 1% of the vectors miss
+ * the latency target, grow the vector while the load keeps filling it and
+ * relax the timeout back towards the target while there is headroom.
+ */
+static void
+rxa_vector_adapt(struct event_eth_rx_adapter *rx_adapter,
+		 struct eth_rx_vector_data *vec)
+{
+	uint64_t min_tmo = (vec->target_ticks >> RXA_VECTOR_MIN_TMO_SHIFT) + 1;
+	uint16_t min_sz = RTE_MIN(MIN_VECTOR_SIZE, vec->max_vector_count);
+	uint16_t sz = vec->cur_vector_count;
+
+	if (vec->win_over > RXA_VECTOR_ADAPT_OVER) {
+		vec->vector_timeout_ticks -= vec->vector_timeout_ticks >> 2;
+		sz -= sz >> 2;
+	} else if (vec->win_over == 0) {
+		if (vec->win_full >= RXA_VECTOR_ADAPT_WINDOW / 4 * 3)
+			sz += (sz >> 2) + 1;
+		vec->vector_timeout_ticks +=
+			(vec->target_ticks - vec->vector_timeout_ticks) >> 2;
+	}
+
+	sz = RTE_MIN(sz, vec->max_vector_count);
+	vec->cur_vector_count = RTE_MAX(sz, min_sz);
+	vec->vector_timeout_ticks = RTE_MAX(vec->vector_timeout_ticks, min_tmo);
+	/* Scan for expired vectors often enough for the shorter timeout */
+	if ((vec->vector_timeout_ticks >> 1) < rx_adapter->vector_tmo_ticks)
+		rx_adapter->vector_tmo_ticks = vec->vector_timeout_ticks >> 1;
+	vec->win_count = 0;
+	vec->win_over = 0;
+	vec->win_full = 0;
+}
+
+/* Account a vector handed over to the event buffer */
+static inline void
+rxa_vector_flushed(struct event_eth_rx_adapter *rx_adapter,
+		   struct eth_rx_vector_data *vec, uint16_t nb_elem,
+		   uint64_t now, enum rxa_vector_flush reason)
+{
+	struct rte_event_eth_rx_adapter_vector_stats *stats = &vec->stats;
+	uint64_t lat, us;
+	uint32_t b;
+
+	stats->vectors++;
+	stats->vector_pkts += nb_elem;
+	if (reason == RXA_VECTOR_FLUSH_FULL)
+		stats->vectors_full++;
+	else if (reason == RXA_VECTOR_FLUSH_TIMEOUT)
+		stats->vectors_timeout++;
+	else
+		stats->vectors_early++;
+
+	/* Only adaptive queues pay for the latency tracking */
+	if (!vec->adaptive)
+		return;
+
+	lat = now - vec->first_ts;
+	us = lat / vec->ticks_per_us;
+	b = us ? rte_fls_u64(us) : 0;
+	b = RTE_MIN(b, RTE_EVENT_ETH_RX_ADAPTER_VECTOR_LAT_BUCKETS - 1u);
+	stats->latency_hist[b]++;
+	if (lat > vec->max_lat_ticks)
+		vec->max_lat_ticks = lat;
+
+	vec->win_count++;
+	vec->win_over += lat > vec->target_ticks;
+	vec->win_full += reason == RXA_VECTOR_FLUSH_FULL;
+	if (vec->win_count == RXA_VECTOR_ADAPT_WINDOW)
+		rxa_vector_adapt(rx_adapter, vec);
+}
+
+/* Track the mbuf arrival rate of an adaptive vector queue */
+static inline void
+rxa_vector_rate_update(struct eth_rx_vector_data *vec, uint64_t now,
+		       uint16_t num)
+{
+	uint64_t gap;
+
+	if (likely(vec->last_rx_ts != 0)) {
+		gap = (now - vec->last_rx_ts) / num;
+		vec->gap_ticks = vec->gap_ticks - (vec->gap_ticks >> 3) +
+				 (gap >> 3);
+	}
+	vec->last_rx_ts = now;
+}
+
 static inline uint16_t
 rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 			struct eth_rx_queue_info *queue_info,
@@ -874,9 +993,14 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 	struct rte_event *ev = &buf->events[buf->count];
 	struct eth_rx_vector_data *vec;
 	uint16_t filled, space, sz;
+	uint64_t now;
 
 	filled = 0;
 	vec = &queue_info->vector_data;
+	now = rte_rdtsc();
+
+	if (vec->adaptive)
+		rxa_vector_rate_update(vec, now, num);
 
 	if (vec->vector_ev == NULL) {
 		if (rte_mempool_get(vec->vector_pool,
@@ -887,12 +1011,15 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 		rxa_init_vector(rx_adapter, vec);
 	}
 	while (num) {
-		if (vec->vector_ev->nb_elem == vec->max_vector_count) {
+		if (vec->vector_ev->nb_elem == vec->cur_vector_count) {
 			/* Event ready. */
 			ev->event = vec->event;
 			ev->vec = vec->vector_ev;
 			ev++;
 			filled++;
+			rxa_vector_flushed(rx_adapter, vec,
+					   vec->vector_ev->nb_elem, now,
+					   RXA_VECTOR_FLUSH_FULL);
 			vec->vector_ev = NULL;
 			TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
 			if (rte_mempool_get(vec->vector_pool,
@@ -903,21 +1030,29 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 			rxa_init_vector(rx_adapter, vec);
 		}
 
-		space = vec->max_vector_count - vec->vector_ev->nb_elem;
+		if (vec->vector_ev->nb_elem == 0) {
+			vec->first_ts = now;
+			vec->ts = now;
+		}
+		space = vec->cur_vector_count - vec->vector_ev->nb_elem;
 		sz = num > space ? space : num;
 		memcpy(vec->vector_ev->mbufs + vec->vector_ev->nb_elem, mbufs,
 		       sizeof(void *) * sz);
 		vec->vector_ev->nb_elem += sz;
 		num -= sz;
 		mbufs += sz;
-		vec->ts = rte_rdtsc();
+		/* An adaptive vector times out relative to its first mbuf */
+		if (!vec->adaptive)
+			vec->ts = now;
 	}
 
-	if (vec->vector_ev->nb_elem == vec->max_vector_count) {
+	if (vec->vector_ev->nb_elem == vec->cur_vector_count) {
 		ev->event = vec->event;
 		ev->vec = vec->vector_ev;
 		ev++;
 		filled++;
+		rxa_vector_flushed(rx_adapter, vec, vec->vector_ev->nb_elem,
+				   now, RXA_VECTOR_FLUSH_FULL);
 		vec->vector_ev = NULL;
 		TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
 	}
@@ -925,6 +1060,39 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 	return filled;
 }
 
+/* Flush the partial vector of an adaptive queue whose Rx queue ran empty
+ * if, at the current arrival rate, no further mbuf is expected before the
+ * vector times out; waiting would only add latency.
+ */
+static inline uint16_t
+rxa_vector_quiet(struct event_eth_rx_adapter *rx_adapter,
+		 struct eth_rx_vector_data *vec,
+		 struct eth_event_enqueue_buffer *buf)
+{
+	struct rte_event *ev;
+	uint16_t nb_elem;
+	uint64_t now;
+
+	if (vec->vector_ev == NULL || vec->vector_ev->nb_elem == 0)
+		return 0;
+
+	now = rte_rdtsc();
+	nb_elem = vec->vector_ev->nb_elem;
+	if (now - vec->first_ts + vec->gap_ticks < vec->vector_timeout_ticks)
+		return 0;
+
+	ev = &buf->events[buf->count];
+	ev->event = vec->event;
+	ev->vec = vec->vector_ev;
+	rxa_vector_flushed(rx_adapter, vec, nb_elem, now,
+			   RXA_VECTOR_FLUSH_EARLY);
+	vec->vector_ev = NULL;
+	vec->ts = 0;
+	TAILQ_REMOVE(&rx_adapter->vector_list, vec, next);
+
+	return 1;
+}
+
 static inline void
 rxa_buffer_mbufs(struct event_eth_rx_adapter *rx_adapter, uint16_t eth_dev_id,
 		 uint16_t rx_queue_id, struct rte_mbuf **mbufs, uint16_t num,
@@ -1027,6 +1195,22 @@ rxa_pkt_buf_available(struct eth_event_enqueue_buffer *buf)
 	return nb_req <= buf->head;
 }
 
+static inline void
+rxa_eth_rx_quiet(struct event_eth_rx_adapter *rx_adapter, uint16_t port_id,
+		 uint16_t queue_id, struct eth_event_enqueue_buffer *buf)
+{
+	struct eth_rx_vector_data *vec;
+	uint16_t n;
+
+	vec = &rx_adapter->eth_devices[port_id].rx_queue[queue_id].vector_data;
+	if (!vec->adaptive)
+		return;
+
+	n = rxa_vector_quiet(rx_adapter, vec, buf);
+	buf->count += n;
+	buf->tail += n;
+}
+
 /* Enqueue packets from  <port, q>  to event buffer */
 static inline uint32_t
 rxa_eth_rx(struct event_eth_rx_adapter *rx_adapter, uint16_t port_id,
@@ -1054,6 +1238,7 @@ rxa_eth_rx(struct event_eth_rx_adapter *rx_adapter, uint16_t port_id,
 		if (unlikely(!n)) {
 			if (rxq_empty)
 				*rxq_empty = 1;
+			rxa_eth_rx_quiet(rx_adapter, port_id, queue_id, buf);
 			break;
 		}
 		rxa_buffer_mbufs(rx_adapter, port_id, queue_id, mbufs, n, buf,
@@ -1402,6 +1587,8 @@ rxa_vector_expire(struct eth_rx_vector_data *vec, void *arg)
 	ev->event = vec->event;
 	ev->vec = vec->vector_ev;
 	buf->count++;
+	rxa_vector_flushed(rx_adapter, vec, vec->vector_ev->nb_elem,
+			   rte_rdtsc(), RXA_VECTOR_FLUSH_TIMEOUT);
 
 	vec->vector_ev = NULL;
 	vec->ts = 0;
@@ -1984,7 +2171,7 @@ rxa_update_queue(struct event_eth_rx_adapter *rx_adapter,
 static void
 rxa_set_vector_data(struct eth_rx_queue_info *queue_info, uint16_t vector_count,
 		    uint64_t vector_ns, struct rte_mempool *mp, uint32_t qid,
-		    uint16_t port_id)
+		    uint16_t port_id, bool adaptive)
 {
 #define NSEC2TICK(__ns, __freq) (((__ns) * (__freq)) / 1E9)
 	struct eth_rx_vector_data *vector_data;
@@ -1998,6 +2185,30 @@ rxa_set_vector_data(struct eth_rx_queue_info *queue_info, uint16_t vector_count,
 	vector_data->vector_timeout_ticks =
 		NSEC2TICK(vector_ns, rte_get_timer_hz());
 	vector_data->ts = 0;
+	vector_data->first_ts = 0;
+	vector_data->ticks_per_us = RTE_MAX(rte_get_timer_hz() / US_PER_S,
+					     UINT64_C(1));
+	vector_data->adaptive = adaptive;
+	vector_data->cur_vector_count = vector_count;
+	vector_data->target_ticks = 0;
+	vector_data->gap_ticks = 0;
+	vector_data->last_rx_ts = 0;
+	vector_data->win_count = 0;
+	vector_data->win_over = 0;
+	vector_data->win_full = 0;
+	vector_data->max_lat_ticks = 0;
+	memset(&vector_data->stats, 0, sizeof(vector_data->stats));
+	if (adaptive) {
+		/* Start with small vectors and half of the latency budget,
+		 * the load decides how far both grow.
+		 */
+		vector_data->target_ticks = vector_data->vector_timeout_ticks;
+		vector_data->vector_timeout_ticks >>= 1;
+		vector_data->cur_vector_count = vector_count >> 2;
+		if (vector_data->cur_vector_count < MIN_VECTOR_SIZE)
+			vector_data->cur_vector_count =
+				RTE_MIN(MIN_VECTOR_SIZE, vector_count);
+	}
 	flow_id = queue_info->event & 0xFFFFF;
 	flow_id =
 		flow_id == 0 ? (qid & 0xFFF) | (port_id & 0xFF) << 12 : flow_id;
@@ -2109,7 +2320,9 @@ rxa_add_queue(struct event_eth_rx_adapter *rx_adapter,
 		qi_ev->event_type = RTE_EVENT_TYPE_ETH_RX_ADAPTER_VECTOR;
 		rxa_set_vector_data(queue_info, conf->vector_sz,
 				    conf->vector_timeout_ns, conf->vector_mp,
-				    rx_queue_id, dev_info->dev->data->port_id);
+				    rx_queue_id, dev_info->dev->data->port_id,
+				    conf->rx_queue_flags &
+				    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE);
 		rx_adapter->ena_vector = 1;
 		rx_adapter->vector_tmo_ticks =
 			rx_adapter->vector_tmo_ticks ?
@@ -2119,6 +2332,8 @@ rxa_add_queue(struct event_eth_rx_adapter *rx_adapter,
 					rx_adapter->vector_tmo_ticks) :
 				queue_info->vector_data.vector_timeout_ticks >>
 					1;
+	} else {
+		queue_info->vector_data.adaptive = 0;
 	}
 
 	rxa_update_queue(rx_adapter, dev_info, rx_queue_id, 1);
@@ -2727,6 +2942,18 @@ rte_event_eth_rx_adapter_queue_add(uint8_t id,
 		}
 	}
 
+	if ((queue_conf->rx_queue_flags &
+	     RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE) &&
+	    (!(queue_conf->rx_queue_flags &
+	       RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR) ||
+	     (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT))) {
+		RTE_EDEV_LOG_ERR("Adaptive event vectorization is not supported,"
+				 " eth port: %" PRIu16
+				 " adapter id: %" PRIu8,
+				 eth_dev_id, id);
+		return -EINVAL;
+	}
+
 	if ((cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_MULTI_EVENTQ) == 0 &&
 		(rx_queue_id != -1)) {
 		RTE_EDEV_LOG_ERR("Rx queues can only be connected to single "
@@ -2897,6 +3124,16 @@ rte_event_eth_rx_adapter_queues_add(uint8_t id, uint16_t eth_dev_id, int32_t rx_
 			}
 		}
 
+		if ((conf->rx_queue_flags & RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE) &&
+		    (!(conf->rx_queue_flags & RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR) ||
+		     (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT))) {
+			RTE_EDEV_LOG_ERR(
+				"Adaptive event vectorization is unsupported in queue_conf[%" PRIu32
+				"], eth port: %" PRIu16 " adapter id: %" PRIu8,
+				i, eth_dev_id, id);
+			return -EINVAL;
+		}
+
 		if ((rx_adapter->use_queue_event_buf && conf->event_buf_size == 0) ||
 		    (!rx_adapter->use_queue_event_buf && conf->event_buf_size != 0)) {
 			RTE_EDEV_LOG_ERR("Invalid Event buffer size in queue_conf[%" PRIu32 "]", i);
@@ -3164,6 +3401,20 @@ rxa_queue_stats_reset(struct eth_rx_queue_info *queue_info)
 	memset(q_stats, 0, sizeof(*q_stats));
 }
 
+static inline void
+rxa_queue_vector_stats_reset(struct eth_rx_queue_info *queue_info)
+{
+	struct eth_rx_vector_data *vec = &queue_info->vector_data;
+
+	memset(vec->stats.latency_hist, 0, sizeof(vec->stats.latency_hist));
+	vec->stats.vectors = 0;
+	vec->stats.vector_pkts = 0;
+	vec->stats.vectors_full = 0;
+	vec->stats.vectors_timeout = 0;
+	vec->stats.vectors_early = 0;
+	vec->max_lat_ticks = 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_event_eth_rx_adapter_stats_get)
 int
 rte_event_eth_rx_adapter_stats_get(uint8_t id,
@@ -3330,14 +3581,16 @@ rte_event_eth_rx_adapter_stats_reset(uint8_t id)
 	RTE_ETH_FOREACH_DEV(i) {
 		dev_info = &rx_adapter->eth_devices[i];
 
-		if (rx_adapter->use_queue_event_buf  && dev_info->rx_queue) {
+		if (dev_info->internal_event_port == 0 && dev_info->rx_queue) {
 
 			for (j = 0; j < dev_info->dev->data->nb_rx_queues;
 						j++) {
 				queue_info = &dev_info->rx_queue[j];
 				if (!queue_info->queue_enabled)
 					continue;
-				rxa_queue_stats_reset(queue_info);
+				rxa_queue_vector_stats_reset(queue_info);
+				if (rx_adapter->use_queue_event_buf)
+					rxa_queue_stats_reset(queue_info);
 			}
 		}
 
@@ -3395,6 +3648,7 @@ rte_event_eth_rx_adapter_queue_stats_reset(uint8_t id,
 	if (dev_info->internal_event_port == 0) {
 		queue_info = &dev_info->rx_queue[rx_queue_id];
 		rxa_queue_stats_reset(queue_info);
+		rxa_queue_vector_stats_reset(queue_info);
 	}
 
 	dev = &rte_eventdevs[rx_adapter->eventdev_id];
@@ -3407,6 +3661,76 @@ rte_event_eth_rx_adapter_queue_stats_reset(uint8_t id,
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_eth_rx_adapter_vector_stats_get, 26.11)
+int
+rte_event_eth_rx_adapter_vector_stats_get(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id,
+		struct rte_event_eth_rx_adapter_vector_stats *stats)
+{
+#define TICK2NSEC(_ticks, _freq) (((_ticks) * (1E9)) / (_freq))
+	struct event_eth_rx_adapter *rx_adapter;
+	struct eth_device_info *dev_info;
+	struct eth_rx_queue_info *queue_info;
+	struct eth_rx_vector_data *vec;
+	uint64_t hz = rte_get_timer_hz();
+	uint64_t p99_cnt, cnt;
+	uint32_t b;
+
+	if (rxa_memzone_lookup())
+		return -ENOMEM;
+
+	RTE_EVENT_ETH_RX_ADAPTER_ID_VALID_OR_ERR_RET(id, -EINVAL);
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(eth_dev_id, -EINVAL);
+
+	rx_adapter = rxa_id_to_adapter(id);
+	if (rx_adapter == NULL || stats == NULL)
+		return -EINVAL;
+
+	if (rx_queue_id >= rte_eth_devices[eth_dev_id].data->nb_rx_queues) {
+		RTE_EDEV_LOG_ERR("Invalid rx queue_id %" PRIu16, rx_queue_id);
+		return -EINVAL;
+	}
+
+	dev_info = &rx_adapter->eth_devices[eth_dev_id];
+	if (dev_info->rx_queue == NULL ||
+	    !dev_info->rx_queue[rx_queue_id].queue_enabled) {
+		RTE_EDEV_LOG_ERR("Rx queue %u not added", rx_queue_id);
+		return -EINVAL;
+	}
+
+	if (dev_info->internal_event_port)
+		return -ENOTSUP;
+
+	queue_info = &dev_info->rx_queue[rx_queue_id];
+	if (!queue_info->ena_vector)
+		return -EINVAL;
+
+	vec = &queue_info->vector_data;
+	*stats = vec->stats;
+	stats->latency_max_ns = TICK2NSEC(vec->max_lat_ticks, hz);
+	stats->latency_target_ns = TICK2NSEC(vec->target_ticks, hz);
+	stats->timeout_ns = TICK2NSEC(vec->vector_timeout_ticks, hz);
+	stats->vector_sz = vec->cur_vector_count;
+
+	/* Upper bound of the bucket holding the 99th percentile */
+	stats->latency_p99_ns = 0;
+	p99_cnt = stats->vectors - stats->vectors / 100;
+	cnt = 0;
+	for (b = 0; b < RTE_EVENT_ETH_RX_ADAPTER_VECTOR_LAT_BUCKETS &&
+		    stats->vectors != 0; b++) {
+		cnt += stats->latency_hist[b];
+		if (cnt >= p99_cnt) {
+			stats->latency_p99_ns = RTE_MIN((UINT64_C(1) << b) *
+							NS_PER_S / US_PER_S,
+							stats->latency_max_ns);
+			break;
+		}
+	}
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_event_eth_rx_adapter_service_id_get)
 int
 rte_event_eth_rx_adapter_service_id_get(uint8_t id, uint32_t *service_id)
@@ -3562,6 +3886,14 @@ rte_event_eth_rx_adapter_queue_conf_get(uint8_t id,
 	/* need to be converted from ticks to ns */
 	queue_conf->vector_timeout_ns = TICK2NSEC(
 		queue_info->vector_data.vector_timeout_ticks, rte_get_timer_hz());
+	if (queue_info->vector_data.adaptive) {
+		queue_conf->rx_queue_flags |=
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR |
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE;
+		queue_conf->vector_timeout_ns = TICK2NSEC(
+			queue_info->vector_data.target_ticks,
+			rte_get_timer_hz());
+	}
 
 	if (queue_info->event_buf != NULL)
 		queue_conf->event_buf_size = queue_info->event_buf->events_size;
@@ -3961,6 +4293,92 @@ handle_rxa_get_queue_stats(const char *cmd __rte_unused,
 	return ret;
 }
 
+static int
+handle_rxa_get_queue_vector_stats(const char *cmd __rte_unused,
+			   const char *params,
+			   struct rte_tel_data *d)
+{
+	unsigned long rx_adapter_id, rx_queue_id, eth_dev_id;
+	int ret = -1;
+	char *token, *l_params, *saveptr = NULL;
+	struct rte_event_eth_rx_adapter_vector_stats v_stats;
+	struct rte_tel_data *hist;
+	uint32_t b;
+
+	if (params == NULL || strlen(params) == 0 || !isdigit((unsigned char)*params))
+		return -1;
+
+	/* Get Rx adapter ID from parameter string */
+	l_params = strdup(params);
+	if (l_params == NULL)
+		return -ENOMEM;
+	token = strtok_r(l_params, ",", &saveptr);
+	RTE_EVENT_ETH_RX_ADAPTER_TOKEN_VALID_OR_GOTO_ERR_RET(token, -1);
+	rx_adapter_id = strtoul(token, NULL, 10);
+	RTE_EVENT_ETH_RX_ADAPTER_ID_VALID_OR_GOTO_ERR_RET(rx_adapter_id, -EINVAL);
+
+	token = strtok_r(NULL, ",", &saveptr);
+	RTE_EVENT_ETH_RX_ADAPTER_TOKEN_VALID_OR_GOTO_ERR_RET(token, -1);
+
+	/* Get device ID from parameter string */
+	eth_dev_id = strtoul(token, NULL, 10);
+	RTE_EVENT_ETH_RX_ADAPTER_PORTID_VALID_OR_GOTO_ERR_RET(eth_dev_id, -EINVAL);
+
+	token = strtok_r(NULL, ",", &saveptr);
+	RTE_EVENT_ETH_RX_ADAPTER_TOKEN_VALID_OR_GOTO_ERR_RET(token, -1);
+
+	/* Get Rx queue ID from parameter string */
+	rx_queue_id = strtoul(token, NULL, 10);
+	if (rx_queue_id >= rte_eth_devices[eth_dev_id].data->nb_rx_queues) {
+		RTE_EDEV_LOG_ERR("Invalid rx queue_id %lu", rx_queue_id);
+		ret = -EINVAL;
+		goto error;
+	}
+
+	token = strtok_r(NULL, "\0", &saveptr);
+	if (token != NULL)
+		RTE_EDEV_LOG_ERR("Extra parameters passed to eventdev"
+				 " telemetry command, ignoring");
+	/* Parsing parameter finished */
+	free(l_params);
+
+	if (rte_event_eth_rx_adapter_vector_stats_get(rx_adapter_id,
+						      eth_dev_id, rx_queue_id,
+						      &v_stats)) {
+		RTE_EDEV_LOG_ERR("Failed to get Rx adapter queue vector stats");
+		return -1;
+	}
+
+	hist = rte_tel_data_alloc();
+	if (hist == NULL)
+		return -ENOMEM;
+	rte_tel_data_start_array(hist, RTE_TEL_UINT_VAL);
+	for (b = 0; b < RTE_EVENT_ETH_RX_ADAPTER_VECTOR_LAT_BUCKETS; b++)
+		rte_tel_data_add_array_uint(hist, v_stats.latency_hist[b]);
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "rx_adapter_id", rx_adapter_id);
+	rte_tel_data_add_dict_uint(d, "eth_dev_id", eth_dev_id);
+	rte_tel_data_add_dict_uint(d, "rx_queue_id", rx_queue_id);
+	RXA_ADD_DICT(v_stats, vectors);
+	RXA_ADD_DICT(v_stats, vector_pkts);
+	RXA_ADD_DICT(v_stats, vectors_full);
+	RXA_ADD_DICT(v_stats, vectors_timeout);
+	RXA_ADD_DICT(v_stats, vectors_early);
+	RXA_ADD_DICT(v_stats, latency_max_ns);
+	RXA_ADD_DICT(v_stats, latency_p99_ns);
+	RXA_ADD_DICT(v_stats, latency_target_ns);
+	RXA_ADD_DICT(v_stats, timeout_ns);
+	RXA_ADD_DICT(v_stats, vector_sz);
+	rte_tel_data_add_dict_container(d, "latency_hist_us", hist, 0);
+
+	return 0;
+
+error:
+	free(l_params);
+	return ret;
+}
+
 static int
 handle_rxa_queue_stats_reset(const char *cmd __rte_unused,
 			     const char *params,
@@ -4101,6 +4519,10 @@ RTE_INIT(rxa_init_telemetry)
 		handle_rxa_get_queue_stats,
 		"Returns Rx queue stats. Parameter: rxa_id, dev_id, queue_id");
 
+	rte_telemetry_register_cmd("/eventdev/rxa_queue_vector_stats",
+		handle_rxa_get_queue_vector_stats,
+		"Returns Rx queue event vector stats. Parameter: rxa_id, dev_id, queue_id");
+
 	rte_telemetry_register_cmd("/eventdev/rxa_queue_stats_reset",
 		handle_rxa_queue_stats_reset,
 		"Reset Rx queue stats. Parameter: rxa_id, dev_id, queue_id");
@@ -109,6 +109,18 @@ extern "C" {
 /**< This flag indicates that mbufs arriving on the queue need to be vectorized
  * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
  */
+#define RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE	0x4
+/**< This flag indicates that the vector size and flush timeout of the queue
+ * adapt to the load so that the 99th percentile of the time spent by mbufs
+ * waiting for a vector to complete stays below
+ * rte_event_eth_rx_adapter_queue_conf::vector_timeout_ns. Vectors grow up to
+ * rte_event_eth_rx_adapter_queue_conf::vector_sz under load and are flushed
+ * early when the Rx queue goes quiet. Requires
+ * RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR and is only supported by the
+ * SW adapter, i.e. without RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT.
+ * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
+ * @see rte_event_eth_rx_adapter_vector_stats_get()
+ */
 
 /**
  * Adapter configuration structure that the adapter configuration callback
@@ -202,6 +214,8 @@ struct rte_event_eth_rx_adapter_queue_conf {
 	 * @see rte_event_eth_rx_adapter_vector_limits::max_vector_ns
 	 * Valid when RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR flag is set in
 	 * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
+	 * When RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE is set, this
+	 * is the p99 latency target rather than a fixed timeout.
 	 */
 	struct rte_mempool *vector_mp;
 	/**<
@@ -266,6 +280,47 @@ struct rte_event_eth_rx_adapter_stats {
 	/**< Rx event buffer size */
 };
 
+/** Number of buckets in the event vector latency histogram. */
+#define RTE_EVENT_ETH_RX_ADAPTER_VECTOR_LAT_BUCKETS 24
+
+/**
+ * A structure used to retrieve event vectorization statistics for an
+ * eth rx adapter queue.
+ */
+struct rte_event_eth_rx_adapter_vector_stats {
+	uint64_t vectors;
+	/**< Event vectors enqueued */
+	uint64_t vector_pkts;
+	/**< Packets carried by the enqueued event vectors */
+	uint64_t vectors_full;
+	/**< Event vectors flushed because they reached the vector size */
+	uint64_t vectors_timeout;
+	/**< Event vectors flushed on timeout */
+	uint64_t vectors_early;
+	/**< Event vectors flushed early because the Rx queue went quiet */
+	uint64_t latency_max_ns;
+	/**< Longest time an mbuf waited for its vector to be flushed,
+	 * for an adaptive queue
+	 */
+	uint64_t latency_p99_ns;
+	/**< 99th percentile of the vector latency, as resolved by the
+	 * latency histogram, for an adaptive queue
+	 */
+	uint64_t latency_target_ns;
+	/**< Latency target of an adaptive queue, 0 otherwise */
+	uint64_t timeout_ns;
+	/**< Current vector flush timeout */
+	uint16_t vector_sz;
+	/**< Current vector size */
+	uint64_t latency_hist[RTE_EVENT_ETH_RX_ADAPTER_VECTOR_LAT_BUCKETS];
+	/**< Vector latency histogram, i.e. the time from the first mbuf
+	 * being added to a vector until the vector is flushed. Bucket 0
+	 * counts vectors below 1 us, bucket n counts vectors in
+	 * [2^(n-1), 2^n) us and the last bucket counts all longer ones.
+	 * Only filled for an adaptive queue.
+	 */
+};
+
 /**
  * A structure used to retrieve eth rx adapter vector limits.
  */
@@ -704,6 +759,40 @@ int rte_event_eth_rx_adapter_cb_register(uint8_t id, uint16_t eth_dev_id,
 					 rte_event_eth_rx_adapter_cb_fn cb_fn,
 					 void *cb_arg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Retrieve event vectorization statistics of an Rx queue of the SW adapter.
+ * The statistics are reset by rte_event_eth_rx_adapter_stats_reset() and
+ * rte_event_eth_rx_adapter_queue_stats_reset().
+ *
+ * @param id
+ *  Adapter identifier.
+ *
+ * @param eth_dev_id
+ *  Port identifier of Ethernet device.
+ *
+ * @param rx_queue_id
+ *  Ethernet device receive queue index.
+ *
+ * @param[out] stats
+ *  A pointer to structure used to retrieve the vector statistics.
+ *
+ * @return
+ *  - 0: Success, vector statistics retrieved successfully.
+ *  - -EINVAL: Invalid parameters, or the queue does not use event vectors.
+ *  - -ENOTSUP: The queue is not serviced by the SW adapter.
+ *
+ * @see RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE
+ */
+__rte_experimental
+int
+rte_event_eth_rx_adapter_vector_stats_get(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id,
+		struct rte_event_eth_rx_adapter_vector_stats *stats);
+
 /**
  * Retrieve vector limits for a given event dev and eth dev pair.
  * @see rte_event_eth_rx_adapter_vector_limits
@@ -979,7 +979,11 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 		}
 	}
 
-	ret = rte_timer_data_alloc(&sw->timer_data_id);
+	if (adapter->data->conf.flags & RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL)
+		ret = rte_timer_data_alloc_type(&sw->timer_data_id,
+						RTE_TIMER_DATA_WHEEL);
+	else
+		ret = rte_timer_data_alloc(&sw->timer_data_id);
 	if (ret < 0) {
 		EVTIM_LOG_ERR("failed to allocate timer data instance");
 		rte_errno = -ret;
@@ -1185,11 +1189,12 @@ __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 		struct rte_event_timer **evtims,
 		uint16_t nb_evtims)
 {
-	int i, ret;
+	int i, j, n, ret;
 	struct swtim *sw = swtim_pmd_priv(adapter);
 	uint32_t lcore_id = rte_lcore_id();
-	struct rte_timer *tim, *tims[nb_evtims];
-	uint64_t cycles;
+	struct rte_timer *tims[nb_evtims];
+	uint64_t cycles[nb_evtims];
+	enum rte_event_timer_state prev_state[nb_evtims];
 	int n_lcores;
 	/* Timer list for this lcore is not in use. */
 	uint16_t exp_state = 0;
@@ -1256,14 +1261,14 @@ __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 			rte_errno = EINVAL;
 			break;
 		}
+		prev_state[i] = n_state;
 
-		tim = tims[i];
-		rte_timer_init(tim);
+		rte_timer_init(tims[i]);
 
-		evtims[i]->impl_opaque[0] = (uintptr_t)tim;
+		evtims[i]->impl_opaque[0] = (uintptr_t)tims[i];
 		evtims[i]->impl_opaque[1] = (uintptr_t)adapter;
 
-		ret = get_timeout_cycles(evtims[i], adapter, &cycles);
+		ret = get_timeout_cycles(evtims[i], adapter, &cycles[i]);
 		if (unlikely(ret == -1)) {
 			rte_atomic_store_explicit(&evtims[i]->state,
 					RTE_EVENT_TIMER_ERROR_TOOLATE,
@@ -1277,25 +1282,35 @@ __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 			rte_errno = EINVAL;
 			break;
 		}
+	}
 
-		ret = rte_timer_alt_reset(sw->timer_data_id, tim, cycles,
-					  type, lcore_id, NULL, evtims[i]);
-		if (ret < 0) {
-			/* tim was in RUNNING or CONFIG state */
-			rte_atomic_store_explicit(&evtims[i]->state,
-					RTE_EVENT_TIMER_ERROR,
-					rte_memory_order_release);
-			break;
-		}
+	/* The timers may expire as soon as they are inserted, so their state
+	 * is set before. RELEASE ordering guarantees the adapter specific
+	 * value changes observed before the update of state.
+	 */
+	for (n = 0; n < i; n++)
+		rte_atomic_store_explicit(&evtims[n]->state, RTE_EVENT_TIMER_ARMED,
+				rte_memory_order_release);
 
-		EVTIM_LOG_DBG("armed an event timer");
-		/* RELEASE ordering guarantees the adapter specific value
-		 * changes observed before the update of state.
-		 */
-		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_ARMED,
+	/* Insert the valid timers in the list of this lcore in one go */
+	n = rte_timer_alt_reset_burst(sw->timer_data_id, tims, cycles, i,
+				      type, lcore_id, NULL, (void **)evtims);
+	if (n < 0)
+		n = 0;
+	if (n < i) {
+		/* tims[n] was in RUNNING or CONFIG state */
+		rte_atomic_store_explicit(&evtims[n]->state,
+				RTE_EVENT_TIMER_ERROR,
 				rte_memory_order_release);
+		for (j = n + 1; j < i; j++)
+			rte_atomic_store_explicit(&evtims[j]->state,
+					prev_state[j],
+					rte_memory_order_release);
+		i = n;
 	}
 
+	EVTIM_LOG_DBG("armed %d event timers", i);
+
 	if (i < nb_evtims)
 		rte_mempool_put_bulk(sw->tim_pool,
 				     (void **)&tims[i], nb_evtims - i);
@@ -1316,8 +1331,8 @@ swtim_cancel_burst(const struct rte_event_timer_adapter *adapter,
 		   struct rte_event_timer **evtims,
 		   uint16_t nb_evtims)
 {
-	int i, ret;
-	struct rte_timer *timp;
+	int i, n;
+	struct rte_timer *tims[nb_evtims];
 	uint64_t opaque;
 	struct swtim *sw = swtim_pmd_priv(adapter);
 	enum rte_event_timer_state n_state;
@@ -1345,25 +1360,29 @@ swtim_cancel_burst(const struct rte_event_timer_adapter *adapter,
 		}
 
 		opaque = evtims[i]->impl_opaque[0];
-		timp = (struct rte_timer *)(uintptr_t)opaque;
-		RTE_ASSERT(timp != NULL);
+		tims[i] = (struct rte_timer *)(uintptr_t)opaque;
+		RTE_ASSERT(tims[i] != NULL);
+	}
 
-		ret = rte_timer_alt_stop(sw->timer_data_id, timp);
-		if (ret < 0) {
-			/* Timer is running or being configured */
-			rte_errno = EAGAIN;
-			break;
-		}
+	/* Stop the timers with one lock of each timer list */
+	n = rte_timer_alt_stop_burst(sw->timer_data_id, tims, i);
+	if (n < 0)
+		n = 0;
+	if (n < i) {
+		/* Timer is running or being configured */
+		rte_errno = EAGAIN;
+		i = n;
+	}
 
-		rte_mempool_put(sw->tim_pool, (void **)timp);
+	rte_mempool_put_bulk(sw->tim_pool, (void **)tims, i);
 
-		/* The RELEASE ordering here pairs with atomic ordering
-		 * to make sure the state update data observed between
-		 * threads.
-		 */
-		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_CANCELED,
+	/* The RELEASE ordering here pairs with atomic ordering
+	 * to make sure the state update data observed between
+	 * threads.
+	 */
+	for (n = 0; n < i; n++)
+		rte_atomic_store_explicit(&evtims[n]->state, RTE_EVENT_TIMER_CANCELED,
 				rte_memory_order_release);
-	}
 
 	return i;
 }
@@ -157,6 +157,14 @@ enum rte_event_timer_adapter_clk_src {
  * @see struct rte_event_timer_adapter_conf::flags
  */
 
+#define RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL	(1ULL << 3)
+/**< Flag to keep the armed timers of the software event timer adapter in a
+ * hierarchical timing wheel instead of a skiplist, arming and cancelling
+ * them in constant time. Ignored by the adapters with an internal port.
+ *
+ * @see struct rte_event_timer_adapter_conf::flags
+ */
+
 /**
  * Timer adapter configuration structure
  */
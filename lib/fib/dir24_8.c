@@ -5,6 +5,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <rte_debug.h>
 #include <rte_malloc.h>
@@ -31,6 +32,33 @@
 
 #define ROUNDUP(x, y)	 RTE_ALIGN_CEIL(x, (1 << (32 - y)))
 
+/*
+ * tbl8 groups which may become unused during a batch update.
+ * They are checked and released all at once when the batch is done,
+ * or when it runs out of tbl8s, so that only one RCU grace period
+ * is usually needed for the whole batch.
+ */
+struct dir24_8_bulk {
+	uint32_t	num;	/**< Number of pending tbl8s */
+	uint64_t	*pending; /**< bitmap of pending tbl8 idxes */
+	struct {
+		uint32_t	tbl24_idx;
+		uint32_t	tbl8_idx;
+	} ent[];
+};
+
+/* Route changed by a batch update, with its state before the change. */
+struct dir24_8_bulk_route {
+	uint32_t	ip;
+	uint8_t		depth;
+	bool		existed;	/**< Route was in the RIB */
+	uint32_t	seq;		/**< Order of the change in the batch */
+	uint64_t	nh;		/**< Next hop if the route existed */
+};
+
+static uint32_t
+bulk_flush(struct dir24_8_tbl *dp);
+
 static inline rte_fib_lookup_fn_t
 get_scalar_fn(enum rte_fib_dir24_8_nh_sz nh_sz, bool be_addr)
 {
@@ -190,6 +218,9 @@ tbl8_get_idx(struct dir24_8_tbl *dp)
 		dp->tbl8_idxes[i] |= (1ULL << bit_idx);
 		return (i << BITMAP_SLAB_BIT_SIZE_LOG2) + bit_idx;
 	}
+	/* Inside a batch, release the tbl8s it has freed so far and retry. */
+	if (dp->bulk != NULL && bulk_flush(dp) != 0)
+		return tbl8_get_idx(dp);
 	return -ENOSPC;
 }
 
@@ -245,8 +276,12 @@ __rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
 	tbl8_cleanup_and_free(dp, tbl8_idx);
 }
 
-static void
-tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
+/*
+ * Replace tbl8 group with a single tbl24 entry
+ * if all the entries of the group have the same next hop.
+ */
+static bool
+tbl8_fold(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 {
 	uint32_t i;
 	uint64_t nh;
@@ -262,7 +297,7 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr8;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr8[i])
-				return;
+				return false;
 		}
 		((uint8_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
@@ -273,7 +308,7 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr16;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr16[i])
-				return;
+				return false;
 		}
 		((uint16_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
@@ -284,7 +319,7 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr32;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr32[i])
-				return;
+				return false;
 		}
 		((uint32_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
@@ -295,12 +330,88 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr64;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr64[i])
-				return;
+				return false;
 		}
 		((uint64_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
 		break;
 	}
+	return true;
+}
+
+static void
+bulk_defer(struct dir24_8_tbl *dp, uint32_t tbl24_idx, uint32_t tbl8_idx)
+{
+	struct dir24_8_bulk *bulk = dp->bulk;
+	uint64_t bit = 1ULL << (tbl8_idx & BITMAP_SLAB_BITMASK);
+
+	if (bulk->pending[tbl8_idx >> BITMAP_SLAB_BIT_SIZE_LOG2] & bit)
+		return;
+	bulk->pending[tbl8_idx >> BITMAP_SLAB_BIT_SIZE_LOG2] |= bit;
+	bulk->ent[bulk->num].tbl24_idx = tbl24_idx;
+	bulk->ent[bulk->num].tbl8_idx = tbl8_idx;
+	bulk->num++;
+}
+
+/*
+ * Release the pending tbl8 groups which are not referenced anymore,
+ * or can be folded back into tbl24. The others stay pending, as they
+ * may still be orphaned by the rest of the batch.
+ * Returns the number of released tbl8 groups.
+ */
+static uint32_t
+bulk_flush(struct dir24_8_tbl *dp)
+{
+	struct dir24_8_bulk *bulk = dp->bulk;
+	uint32_t tbl24_idx;
+	uint64_t tbl8_idx;
+	uint32_t i, k, n;
+
+	/* released ones are marked with an invalid tbl24 index */
+	for (i = 0, n = 0; i != bulk->num; i++) {
+		tbl24_idx = bulk->ent[i].tbl24_idx;
+		tbl8_idx = bulk->ent[i].tbl8_idx;
+		if (get_tbl24(dp, tbl24_idx << 8, dp->nh_sz) ==
+				((tbl8_idx << 1) | DIR24_8_EXT_ENT) &&
+				!tbl8_fold(dp, tbl24_idx << 8, tbl8_idx))
+			continue;
+		bulk->ent[i].tbl24_idx = UINT32_MAX;
+		n++;
+	}
+
+	if (n == 0)
+		return 0;
+
+	if (dp->v != NULL && dp->rcu_mode == RTE_FIB_QSBR_MODE_SYNC)
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+
+	for (i = 0, k = 0; i != bulk->num; i++) {
+		tbl8_idx = bulk->ent[i].tbl8_idx;
+		if (bulk->ent[i].tbl24_idx != UINT32_MAX) {
+			bulk->ent[k++] = bulk->ent[i];
+			continue;
+		}
+		bulk->pending[tbl8_idx >> BITMAP_SLAB_BIT_SIZE_LOG2] &=
+			~(1ULL << (tbl8_idx & BITMAP_SLAB_BITMASK));
+		if (dp->v == NULL || dp->rcu_mode == RTE_FIB_QSBR_MODE_SYNC)
+			tbl8_cleanup_and_free(dp, tbl8_idx);
+		else if (rte_rcu_qsbr_dq_enqueue(dp->dq, &tbl8_idx))
+			FIB_LOG(ERR, "Failed to push QSBR FIFO");
+	}
+	bulk->num = k;
+	return n;
+}
+
+static void
+tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
+{
+	if (dp->bulk != NULL) {
+		bulk_defer(dp, ip >> 8, tbl8_idx);
+		return;
+	}
+
+	if (!tbl8_fold(dp, ip, tbl8_idx))
+		return;
 
 	if (dp->v == NULL) {
 		tbl8_cleanup_and_free(dp, tbl8_idx);
@@ -555,6 +666,277 @@ dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 	return -EINVAL;
 }
 
+/*
+ * Apply a single route operation of a batch to the RIB only.
+ * Returns 1 if the RIB was changed, 0 if not, negative errno on failure.
+ */
+static int
+bulk_rib_modify(struct dir24_8_tbl *dp, struct rte_rib *rib,
+	const struct rte_fib_route_op *rop, struct dir24_8_bulk_route *route)
+{
+	struct rte_rib_node *tmp = NULL;
+	struct rte_rib_node *node;
+	uint64_t tbl24_ent;
+	uint32_t ip;
+
+	if (rop->depth > RTE_FIB_MAXDEPTH)
+		return -EINVAL;
+
+	ip = rop->ip & rte_rib_depth_to_mask(rop->depth);
+	route->ip = ip;
+	route->depth = rop->depth;
+
+	node = rte_rib_lookup_exact(rib, ip, rop->depth);
+	route->existed = node != NULL;
+	if (node != NULL)
+		rte_rib_get_nh(node, &route->nh);
+	switch (rop->op) {
+	case RTE_FIB_ADD:
+		if (rop->next_hop > get_max_nh(dp->nh_sz))
+			return -EINVAL;
+		if (node != NULL) {
+			if (route->nh == rop->next_hop)
+				return 0;
+			rte_rib_set_nh(node, rop->next_hop);
+			return 1;
+		}
+		if (rop->depth > 24) {
+			tmp = rte_rib_get_nxt(rib, ip, 24, NULL,
+				RTE_RIB_GET_NXT_COVER);
+			if ((tmp == NULL) &&
+					(dp->rsvd_tbl8s >= dp->number_tbl8s))
+				return -ENOSPC;
+		}
+		node = rte_rib_insert(rib, ip, rop->depth);
+		if (node == NULL)
+			return -rte_errno;
+		rte_rib_set_nh(node, rop->next_hop);
+		if ((rop->depth > 24) && (tmp == NULL))
+			dp->rsvd_tbl8s++;
+		return 1;
+	case RTE_FIB_DEL:
+		if (node == NULL)
+			return -ENOENT;
+		rte_rib_remove(rib, ip, rop->depth);
+		if (rop->depth > 24) {
+			tmp = rte_rib_get_nxt(rib, ip, 24, NULL,
+				RTE_RIB_GET_NXT_COVER);
+			if (tmp == NULL) {
+				dp->rsvd_tbl8s--;
+				/*
+				 * tbl8 is not needed anymore, it will be
+				 * either folded or overwritten in tbl24.
+				 */
+				tbl24_ent = get_tbl24(dp, ip, dp->nh_sz);
+				if (tbl24_ent & DIR24_8_EXT_ENT)
+					bulk_defer(dp, ip >> 8, tbl24_ent >> 1);
+			}
+		}
+		return 1;
+	default:
+		break;
+	}
+	return -EINVAL;
+}
+
+static int
+bulk_route_cmp(const void *p1, const void *p2)
+{
+	const struct dir24_8_bulk_route *r1 = p1;
+	const struct dir24_8_bulk_route *r2 = p2;
+
+	if (r1->ip != r2->ip)
+		return (r1->ip < r2->ip) ? -1 : 1;
+	if (r1->depth != r2->depth)
+		return (int)r1->depth - (int)r2->depth;
+	return (r1->seq < r2->seq) ? -1 : (r1->seq > r2->seq);
+}
+
+/*
+ * Restore the routes changed by a batch as they were before it.
+ * The routes are sorted, so the first change of each prefix holds
+ * its original state.
+ */
+static void
+bulk_rib_restore(struct dir24_8_tbl *dp, struct rte_rib *rib,
+	const struct dir24_8_bulk_route *routes, uint32_t num)
+{
+	struct rte_rib_node *tmp, *node;
+	uint64_t tbl24_ent;
+	uint32_t i;
+
+	for (i = 0; i != num; i++) {
+		if ((i != 0) && (routes[i].ip == routes[i - 1].ip) &&
+				(routes[i].depth == routes[i - 1].depth))
+			continue;
+
+		tmp = NULL;
+		node = rte_rib_lookup_exact(rib, routes[i].ip,
+			routes[i].depth);
+		if (routes[i].existed) {
+			if (node == NULL) {
+				if (routes[i].depth > 24)
+					tmp = rte_rib_get_nxt(rib, routes[i].ip,
+						24, NULL, RTE_RIB_GET_NXT_COVER);
+				node = rte_rib_insert(rib, routes[i].ip,
+					routes[i].depth);
+				if (node == NULL) {
+					FIB_LOG(ERR, "Failed to restore route");
+					continue;
+				}
+				if ((routes[i].depth > 24) && (tmp == NULL))
+					dp->rsvd_tbl8s++;
+			}
+			rte_rib_set_nh(node, routes[i].nh);
+		} else if (node != NULL) {
+			rte_rib_remove(rib, routes[i].ip, routes[i].depth);
+			if (routes[i].depth <= 24)
+				continue;
+			tmp = rte_rib_get_nxt(rib, routes[i].ip, 24, NULL,
+				RTE_RIB_GET_NXT_COVER);
+			if (tmp == NULL) {
+				dp->rsvd_tbl8s--;
+				tbl24_ent = get_tbl24(dp, routes[i].ip,
+					dp->nh_sz);
+				if (tbl24_ent & DIR24_8_EXT_ENT)
+					bulk_defer(dp, routes[i].ip >> 8,
+						tbl24_ent >> 1);
+			}
+		}
+	}
+}
+
+static inline bool
+bulk_route_covers(const struct dir24_8_bulk_route *r1,
+	const struct dir24_8_bulk_route *r2)
+{
+	return (r1->depth <= r2->depth) &&
+		(((r1->ip ^ r2->ip) & rte_rib_depth_to_mask(r1->depth)) == 0);
+}
+
+/*
+ * Rewrite the dataplane for all the routes changed by a batch.
+ * Routes are visited in address order, so a prefix whose range has already
+ * been rewritten by a changed covering prefix is skipped.
+ */
+static int
+bulk_fib_modify(struct dir24_8_tbl *dp, struct rte_rib *rib,
+	struct dir24_8_bulk_route *routes, uint32_t num)
+{
+	struct dir24_8_bulk_route done[RTE_FIB_MAXDEPTH + 1];
+	struct rte_rib_node *node;
+	uint32_t i, top;
+	uint64_t nh;
+	int cover_depth;
+	uint8_t depth;
+	int ret;
+
+	qsort(routes, num, sizeof(routes[0]), bulk_route_cmp);
+
+	for (i = 0, top = 0; i != num; i++) {
+		if ((i != 0) && (routes[i].ip == routes[i - 1].ip) &&
+				(routes[i].depth == routes[i - 1].depth))
+			continue;
+
+		/* keep only the already rewritten prefixes covering this one */
+		while ((top != 0) && !bulk_route_covers(&done[top - 1],
+				&routes[i]))
+			top--;
+
+		node = rte_rib_lookup_exact(rib, routes[i].ip,
+			routes[i].depth);
+		if (node != NULL)
+			rte_rib_get_nh(node, &nh);
+		else {
+			/* deleted route, its range falls to the covering one */
+			nh = dp->def_nh;
+			cover_depth = -1;
+			node = rte_rib_lookup(rib, routes[i].ip);
+			while (node != NULL) {
+				rte_rib_get_depth(node, &depth);
+				if (depth < routes[i].depth) {
+					rte_rib_get_nh(node, &nh);
+					cover_depth = depth;
+					break;
+				}
+				node = rte_rib_lookup_parent(node);
+			}
+			if ((top != 0) && (cover_depth <= done[top - 1].depth))
+				continue;
+		}
+
+		ret = modify_fib(dp, rib, routes[i].ip, routes[i].depth, nh);
+		if (ret != 0)
+			return ret;
+		done[top++] = routes[i];
+	}
+
+	return 0;
+}
+
+int
+dir24_8_modify_bulk(struct rte_fib *fib, const struct rte_fib_route_op *ops,
+	uint32_t num)
+{
+	struct dir24_8_tbl *dp;
+	struct rte_rib *rib;
+	struct dir24_8_bulk_route *routes;
+	struct dir24_8_bulk *bulk;
+	uint32_t i, nb_routes;
+	size_t sz;
+	int ret, err = 0;
+
+	if ((fib == NULL) || ((ops == NULL) && (num != 0)))
+		return -EINVAL;
+
+	dp = rte_fib_get_dp(fib);
+	rib = rte_fib_get_rib(fib);
+	RTE_ASSERT((dp != NULL) && (rib != NULL));
+
+	if (num == 0)
+		return 0;
+
+	/* allocate everything before touching the RIB */
+	sz = sizeof(*bulk) + dp->number_tbl8s * sizeof(bulk->ent[0]);
+	bulk = rte_zmalloc(NULL, sz + (dp->number_tbl8s >> 3),
+		RTE_CACHE_LINE_SIZE);
+	routes = rte_malloc(NULL, num * sizeof(*routes), 0);
+	if ((bulk == NULL) || (routes == NULL)) {
+		rte_free(bulk);
+		rte_free(routes);
+		return -ENOMEM;
+	}
+	bulk->pending = (uint64_t *)((uint8_t *)bulk + sz);
+	dp->bulk = bulk;
+
+	for (i = 0, nb_routes = 0; i != num; i++) {
+		routes[nb_routes].seq = nb_routes;
+		err = bulk_rib_modify(dp, rib, &ops[i], &routes[nb_routes]);
+		if (err < 0)
+			break;
+		nb_routes += err;
+	}
+
+	ret = bulk_fib_modify(dp, rib, routes, nb_routes);
+	if (ret != 0) {
+		/* roll the whole batch back, as dir24_8_modify() does */
+		bulk_rib_restore(dp, rib, routes, nb_routes);
+		if (bulk_fib_modify(dp, rib, routes, nb_routes) != 0)
+			FIB_LOG(ERR, "Failed to restore dataplane");
+	}
+	bulk_flush(dp);
+	dp->bulk = NULL;
+
+	rte_free(routes);
+	rte_free(bulk);
+
+	if (ret != 0)
+		return ret;
+	if (i != num)
+		rte_errno = -err;
+	return i;
+}
+
 void *
 dir24_8_create(const char *name, int socket_id, struct rte_fib_conf *fib_conf)
 {
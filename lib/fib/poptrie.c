@@ -0,0 +1,1091 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rte_debug.h>
+#include <rte_malloc.h>
+#include <rte_cpuflags.h>
+#include <rte_errno.h>
+#include <rte_stdatomic.h>
+
+#include <rte_rib6.h>
+#include <rte_fib6.h>
+#include <rib6_internal.h>
+#include "fib_log.h"
+#include "poptrie.h"
+
+#ifdef CC_AVX512_SUPPORT
+
+#include "poptrie_avx512.h"
+
+#endif /* CC_AVX512_SUPPORT */
+
+#define POPTRIE_NAMESIZE	64
+#define POPTRIE_POOL_NIL	UINT32_MAX
+#define POPTRIE_POOL_BUSY	UINT8_MAX
+#define POPTRIE_MAX_POOL_SZ	(1U << 31)
+
+/* Descriptor of a node or leaf block, used to defer its release. */
+#define POPTRIE_BLK_LEAF	(1ULL << 63)
+#define POPTRIE_BLK_NUM_SHIFT	32
+
+struct poptrie_blk_list {
+	uint64_t	*blk;
+	uint32_t	num;
+	uint32_t	sz;
+};
+
+/* Next hop of a route absent from a version of the trie. */
+#define POPTRIE_NO_ROUTE	UINT64_MAX
+
+/* Versions of the trie during an update. */
+enum poptrie_ver {
+	POPTRIE_OLD,
+	POPTRIE_NEW,
+	POPTRIE_NUM_VER
+};
+
+/* State of a single route update. */
+struct poptrie_update {
+	struct rte_poptrie_tbl	*dp;
+	struct rte_rib6		*rib;
+	/* Modified route, it is in the RIB during the update. */
+	struct rte_rib6_node	*node;
+	uint64_t		nh[POPTRIE_NUM_VER];
+	struct rte_ipv6_addr	ip;
+	uint8_t			depth;
+	struct poptrie_blk_list	new_blk; /* blocks of the new version */
+	struct poptrie_blk_list	old_blk; /* blocks to release on success */
+};
+
+static inline rte_fib6_lookup_fn_t
+get_scalar_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_poptrie_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_poptrie_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_poptrie_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+}
+
+static inline rte_fib6_lookup_fn_t
+get_vector_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+#ifdef CC_AVX512_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) <= 0 ||
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512DQ) <= 0 ||
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) <= 0 ||
+			rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_512)
+		return NULL;
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_poptrie_vec_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_poptrie_vec_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_poptrie_vec_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+#endif
+	return NULL;
+}
+
+rte_fib6_lookup_fn_t
+poptrie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type)
+{
+	enum rte_fib_trie_nh_sz nh_sz;
+	rte_fib6_lookup_fn_t ret_fn;
+	struct rte_poptrie_tbl *dp = p;
+
+	if (dp == NULL)
+		return NULL;
+
+	nh_sz = dp->nh_sz;
+
+	switch (type) {
+	case RTE_FIB6_LOOKUP_POPTRIE_SCALAR:
+		return get_scalar_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX512:
+		return get_vector_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_DEFAULT:
+		ret_fn = get_vector_fn(nh_sz);
+		return (ret_fn != NULL) ? ret_fn : get_scalar_fn(nh_sz);
+	default:
+		return NULL;
+	}
+	return NULL;
+}
+
+static inline uint64_t
+get_max_nh(uint8_t nh_sz)
+{
+	return (1ULL << (8 * (1 << nh_sz) - 1)) - 1;
+}
+
+static inline uint32_t
+get_dir_idx(const struct rte_ipv6_addr *ip)
+{
+	return ip->a[0] << 8 | ip->a[1];
+}
+
+static inline uint32_t
+addr_get_bits(const struct rte_ipv6_addr *ip, uint32_t off)
+{
+	uint64_t hi, lo;
+
+	poptrie_addr_load(ip, &hi, &lo);
+	return poptrie_get_bits(hi, lo, off);
+}
+
+/* Set the node slot of the level starting at bit offset off. */
+static void
+addr_set_bits(struct rte_ipv6_addr *ip, uint32_t off, uint32_t val)
+{
+	uint32_t i, bit;
+
+	for (i = 0; i < POPTRIE_STRIDE; i++) {
+		bit = off + i;
+		if (bit >= RTE_IPV6_MAX_DEPTH)
+			break;
+		if (val & (1 << (POPTRIE_STRIDE - 1 - i)))
+			ip->a[bit >> 3] |= 0x80 >> (bit & 7);
+		else
+			ip->a[bit >> 3] &= ~(0x80 >> (bit & 7));
+	}
+}
+
+static inline uint32_t
+pool_order(uint32_t num)
+{
+	return num <= 1 ? 0 : 32 - rte_clz32(num - 1);
+}
+
+static void
+pool_push(struct poptrie_pool *pool, uint32_t idx, uint32_t order)
+{
+	uint32_t head = pool->head[order];
+
+	pool->order[idx] = order;
+	pool->prev[idx] = POPTRIE_POOL_NIL;
+	pool->next[idx] = head;
+	if (head != POPTRIE_POOL_NIL)
+		pool->prev[head] = idx;
+	pool->head[order] = idx;
+}
+
+static void
+pool_unlink(struct poptrie_pool *pool, uint32_t idx)
+{
+	uint32_t order = pool->order[idx];
+
+	if (pool->prev[idx] != POPTRIE_POOL_NIL)
+		pool->next[pool->prev[idx]] = pool->next[idx];
+	else
+		pool->head[order] = pool->next[idx];
+	if (pool->next[idx] != POPTRIE_POOL_NIL)
+		pool->prev[pool->next[idx]] = pool->prev[idx];
+	pool->order[idx] = POPTRIE_POOL_BUSY;
+}
+
+static int
+pool_init(struct poptrie_pool *pool, uint32_t num, int socket_id)
+{
+	char mem_name[POPTRIE_NAMESIZE];
+	uint32_t i;
+
+	snprintf(mem_name, sizeof(mem_name), "POPTRIE_POOL_%p", pool);
+	pool->next = rte_malloc_socket(mem_name, num * (2 * sizeof(uint32_t) +
+		sizeof(uint8_t)), RTE_CACHE_LINE_SIZE, socket_id);
+	if (pool->next == NULL)
+		return -ENOMEM;
+	pool->prev = pool->next + num;
+	pool->order = (uint8_t *)(pool->prev + num);
+	memset(pool->order, POPTRIE_POOL_BUSY, num);
+
+	pool->num = num;
+	pool->used = 0;
+	for (i = 0; i < POPTRIE_POOL_ORDERS; i++)
+		pool->head[i] = POPTRIE_POOL_NIL;
+	for (i = num; i != 0; i -= POPTRIE_NODE_NUM_ENT)
+		pool_push(pool, i - POPTRIE_NODE_NUM_ENT, POPTRIE_STRIDE);
+
+	return 0;
+}
+
+static int64_t
+pool_alloc(struct poptrie_pool *pool, uint32_t num)
+{
+	uint32_t order, cur, idx;
+
+	order = pool_order(num);
+	for (cur = order; cur < POPTRIE_POOL_ORDERS; cur++)
+		if (pool->head[cur] != POPTRIE_POOL_NIL)
+			break;
+	if (cur == POPTRIE_POOL_ORDERS)
+		return -ENOSPC;
+
+	idx = pool->head[cur];
+	pool_unlink(pool, idx);
+	/* split the block, keeping the lower half */
+	while (cur != order) {
+		cur--;
+		pool_push(pool, idx + (1 << cur), cur);
+	}
+	pool->used += 1 << order;
+
+	return idx;
+}
+
+static void
+pool_free(struct poptrie_pool *pool, uint32_t idx, uint32_t num)
+{
+	uint32_t order, buddy;
+
+	order = pool_order(num);
+	pool->used -= 1 << order;
+	/* merge with the free buddies */
+	while (order < POPTRIE_STRIDE) {
+		buddy = idx ^ (1 << order);
+		if (pool->order[buddy] != order)
+			break;
+		pool_unlink(pool, buddy);
+		idx &= ~(1 << order);
+		order++;
+	}
+	pool_push(pool, idx, order);
+}
+
+static inline uint64_t
+blk_desc(uint32_t idx, uint32_t num, bool leaf)
+{
+	return (leaf ? POPTRIE_BLK_LEAF : 0) |
+		((uint64_t)num << POPTRIE_BLK_NUM_SHIFT) | idx;
+}
+
+static void
+blk_free(struct rte_poptrie_tbl *dp, uint64_t desc)
+{
+	uint32_t idx = (uint32_t)desc;
+	uint32_t num = (desc & ~POPTRIE_BLK_LEAF) >> POPTRIE_BLK_NUM_SHIFT;
+
+	if (desc & POPTRIE_BLK_LEAF)
+		pool_free(&dp->leaf_pool, idx, num);
+	else
+		pool_free(&dp->node_pool, idx, num);
+}
+
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
+{
+	blk_free(p, *(uint64_t *)data);
+}
+
+static int
+blk_list_add(struct poptrie_blk_list *list, uint64_t desc)
+{
+	uint64_t *blk;
+	uint32_t sz;
+
+	if (list->num == list->sz) {
+		sz = RTE_MAX(2 * list->sz, (uint32_t)POPTRIE_NODE_NUM_ENT);
+		blk = rte_realloc(list->blk, sz * sizeof(*blk), 0);
+		if (blk == NULL)
+			return -ENOMEM;
+		list->blk = blk;
+		list->sz = sz;
+	}
+	list->blk[list->num++] = desc;
+	return 0;
+}
+
+/*
+ * Allocate a block for the new version of the trie.
+ * Blocks waiting in the defer queue are reclaimed if the pool is exhausted.
+ */
+static int64_t
+blk_alloc(struct poptrie_update *u, uint32_t num, bool leaf)
+{
+	struct rte_poptrie_tbl *dp = u->dp;
+	struct poptrie_pool *pool = leaf ? &dp->leaf_pool : &dp->node_pool;
+	unsigned int freed;
+	int64_t idx;
+
+	while ((idx = pool_alloc(pool, num)) < 0) {
+		freed = 0;
+		if (dp->dq == NULL || rte_rcu_qsbr_dq_reclaim(dp->dq,
+				RTE_FIB6_RCU_DQ_RECLAIM_MAX, &freed,
+				NULL, NULL) != 0 || freed == 0)
+			return -ENOSPC;
+	}
+
+	if (blk_list_add(&u->new_blk, blk_desc(idx, num, leaf)) != 0) {
+		pool_free(pool, idx, num);
+		return -ENOMEM;
+	}
+	return idx;
+}
+
+static void
+write_leaves(struct rte_poptrie_tbl *dp, uint32_t idx, const uint64_t *val,
+	uint32_t n)
+{
+	uint16_t *ptr16 = (uint16_t *)dp->leaves + idx;
+	uint32_t *ptr32 = (uint32_t *)dp->leaves + idx;
+	uint64_t *ptr64 = (uint64_t *)dp->leaves + idx;
+	uint32_t i;
+
+	switch (dp->nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		for (i = 0; i < n; i++)
+			ptr16[i] = (uint16_t)val[i];
+		break;
+	case RTE_FIB6_TRIE_4B:
+		for (i = 0; i < n; i++)
+			ptr32[i] = (uint32_t)val[i];
+		break;
+	case RTE_FIB6_TRIE_8B:
+		for (i = 0; i < n; i++)
+			ptr64[i] = val[i];
+		break;
+	}
+}
+
+/* Queue all the blocks of the subtree rooted at node for release. */
+static int
+release_subtree(struct poptrie_update *u, const struct poptrie_node *node)
+{
+	uint32_t i, num_child, num_leaf;
+	int ret;
+
+	num_child = rte_popcount64(node->vector);
+	num_leaf = rte_popcount64(node->leafvec);
+	for (i = 0; i < num_child; i++) {
+		ret = release_subtree(u, &u->dp->nodes[node->base1 + i]);
+		if (ret != 0)
+			return ret;
+	}
+	if (num_child != 0) {
+		ret = blk_list_add(&u->old_blk,
+			blk_desc(node->base1, num_child, false));
+		if (ret != 0)
+			return ret;
+	}
+	if (num_leaf != 0)
+		return blk_list_add(&u->old_blk,
+			blk_desc(node->base0, num_leaf, true));
+	return 0;
+}
+
+/* Next hop of a route in the given version of the trie. */
+static inline bool
+route_get_nh(struct poptrie_update *u, const struct rte_rib6_node *node,
+	enum poptrie_ver ver, uint64_t *nh)
+{
+	if (node == u->node) {
+		*nh = u->nh[ver];
+		return *nh != POPTRIE_NO_ROUTE;
+	}
+	if (!rte_rib6_node_is_valid(node))
+		return false;
+	rte_rib6_get_nh(node, nh);
+	return true;
+}
+
+/* The RIB subtree holds a route in the new version of the trie. */
+static inline bool
+has_routes(struct poptrie_update *u, const struct rte_rib6_node *node)
+{
+	/* RIB leaves are always valid routes */
+	return node != u->node || u->nh[POPTRIE_NEW] != POPTRIE_NO_ROUTE ||
+		rte_rib6_node_has_children(node);
+}
+
+/*
+ * Paint the routes of the RIB subtree into the slots of the node
+ * at the given level. Subtrees longer than the node stride mark
+ * their slot as pointing to a child node.
+ */
+static void
+paint_subtree(struct poptrie_update *u, const struct rte_rib6_node *node,
+	uint32_t level, enum poptrie_ver ver, uint64_t *val, uint64_t *ext)
+{
+	struct rte_ipv6_addr ip;
+	uint64_t nh;
+	uint32_t i, slot;
+	uint8_t depth;
+
+	if (node == NULL)
+		return;
+
+	rte_rib6_get_ip(node, &ip);
+	rte_rib6_get_depth(node, &depth);
+	slot = addr_get_bits(&ip, level);
+	if (depth > level + POPTRIE_STRIDE) {
+		if ((ext != NULL) && has_routes(u, node))
+			*ext |= 1ULL << slot;
+		return;
+	}
+
+	/* a route covering the whole node is part of the inherited value */
+	if ((depth > level) && route_get_nh(u, node, ver, &nh)) {
+		for (i = 0; i < 1U << (level + POPTRIE_STRIDE - depth); i++)
+			val[slot + i] = nh;
+	}
+	paint_subtree(u, rte_rib6_get_child(node, false), level, ver, val, ext);
+	paint_subtree(u, rte_rib6_get_child(node, true), level, ver, val, ext);
+}
+
+/*
+ * Next hop of the longest route of at most depth bits covering
+ * the region ip/depth, in both versions of the trie.
+ */
+static void
+get_inherit(struct poptrie_update *u, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint64_t *inherit)
+{
+	struct rte_rib6_node *node;
+	uint8_t node_depth;
+	int ver, found = 0;
+
+	inherit[POPTRIE_OLD] = POPTRIE_NO_ROUTE;
+	inherit[POPTRIE_NEW] = POPTRIE_NO_ROUTE;
+	node = rte_rib6_lookup(u->rib, ip);
+	for (; (node != NULL) && (found != POPTRIE_NUM_VER);
+			node = rte_rib6_lookup_parent(node)) {
+		rte_rib6_get_depth(node, &node_depth);
+		if (node_depth > depth)
+			continue;
+		for (ver = 0; ver < POPTRIE_NUM_VER; ver++)
+			if ((inherit[ver] == POPTRIE_NO_ROUTE) &&
+					route_get_nh(u, node, ver,
+					&inherit[ver]))
+				found++;
+	}
+	for (ver = 0; ver < POPTRIE_NUM_VER; ver++)
+		if (inherit[ver] == POPTRIE_NO_ROUTE)
+			inherit[ver] = u->dp->def_nh;
+}
+
+/* The region holds routes longer than depth. */
+static bool
+has_cover(struct poptrie_update *u, const struct rte_ipv6_addr *ip,
+	uint8_t depth)
+{
+	struct rte_rib6_node *node, *child;
+	uint8_t node_depth;
+
+	node = rte_rib6_get_subtree(u->rib, ip, depth);
+	if (node == NULL)
+		return false;
+
+	rte_rib6_get_depth(node, &node_depth);
+	if (node_depth > depth)
+		return has_routes(u, node);
+
+	child = rte_rib6_get_child(node, false);
+	if ((child != NULL) && has_routes(u, child))
+		return true;
+	child = rte_rib6_get_child(node, true);
+	return (child != NULL) && has_routes(u, child);
+}
+
+static inline uint64_t
+slot_msk(uint32_t slot)
+{
+	return (2ULL << slot) - 1;
+}
+
+static inline const struct poptrie_node *
+get_child(const struct rte_poptrie_tbl *dp, const struct poptrie_node *node,
+	uint32_t slot)
+{
+	return &dp->nodes[node->base1 +
+		rte_popcount64(node->vector & slot_msk(slot)) - 1];
+}
+
+static inline uint64_t
+get_leaf(const struct rte_poptrie_tbl *dp, const struct poptrie_node *node,
+	uint32_t slot)
+{
+	uint32_t idx = node->base0 +
+		rte_popcount64(node->leafvec & slot_msk(slot)) - 1;
+
+	switch (dp->nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return ((const uint16_t *)dp->leaves)[idx];
+	case RTE_FIB6_TRIE_4B:
+		return ((const uint32_t *)dp->leaves)[idx];
+	default:
+		return ((const uint64_t *)dp->leaves)[idx];
+	}
+}
+
+/*
+ * Allocate and fill the leaves of a node from the slot values,
+ * runs of identical values are stored once. Child slots do not
+ * break a run.
+ */
+static int
+build_leaves(struct poptrie_update *u, struct poptrie_node *node,
+	const uint64_t *val)
+{
+	uint64_t leaves[POPTRIE_NODE_NUM_ENT];
+	uint32_t i, num_leaf = 0;
+	int64_t idx;
+
+	node->leafvec = 0;
+	node->base0 = 0;
+	for (i = 0; i < POPTRIE_NODE_NUM_ENT; i++) {
+		if (node->vector & (1ULL << i))
+			continue;
+		if (num_leaf == 0 || val[i] != leaves[num_leaf - 1]) {
+			node->leafvec |= 1ULL << i;
+			leaves[num_leaf++] = val[i];
+		}
+	}
+	if (num_leaf == 0)
+		return 0;
+
+	idx = blk_alloc(u, num_leaf, true);
+	if (idx < 0)
+		return idx;
+	node->base0 = idx;
+	write_leaves(u->dp, idx, leaves, num_leaf);
+	return 0;
+}
+
+static int
+build_node(struct poptrie_update *u, const struct rte_ipv6_addr *ip,
+	uint32_t level, const uint64_t *inherit,
+	const struct poptrie_node *old_p, struct poptrie_node *dst);
+
+/*
+ * The modified prefix is longer than the node stride, so it only
+ * affects a single slot: the slot values are kept, the slot may switch
+ * between a leaf and a child node, and the child node is rebuilt.
+ */
+static int
+update_node(struct poptrie_update *u, const struct rte_ipv6_addr *ip,
+	uint32_t level, const struct poptrie_node *old_p,
+	struct poptrie_node *dst)
+{
+	struct rte_poptrie_tbl *dp = u->dp;
+	struct poptrie_node old = *old_p;
+	struct poptrie_node node = old;
+	struct rte_ipv6_addr child_ip;
+	const struct poptrie_node *old_child = NULL;
+	uint64_t val[POPTRIE_NODE_NUM_ENT];
+	uint64_t inherit[POPTRIE_NUM_VER];
+	uint64_t vector, bit;
+	uint32_t i, slot, child_slot;
+	int64_t idx;
+	bool ext;
+	int ret;
+
+	slot = addr_get_bits(&u->ip, level);
+	bit = 1ULL << slot;
+	child_ip = *ip;
+	addr_set_bits(&child_ip, level, slot);
+	ext = has_cover(u, &child_ip, level + POPTRIE_STRIDE);
+	get_inherit(u, &child_ip, level + POPTRIE_STRIDE, inherit);
+	if (old.vector & bit)
+		old_child = get_child(dp, &old, slot);
+
+	if (ext != ((old.vector & bit) != 0)) {
+		for (i = 0; i < POPTRIE_NODE_NUM_ENT; i++)
+			if ((old.vector & (1ULL << i)) == 0)
+				val[i] = get_leaf(dp, &old, i);
+		if (!ext)
+			val[slot] = inherit[POPTRIE_NEW];
+		node.vector ^= bit;
+		ret = build_leaves(u, &node, val);
+		if (ret != 0)
+			return ret;
+		if (old.leafvec != 0) {
+			ret = blk_list_add(&u->old_blk, blk_desc(old.base0,
+				rte_popcount64(old.leafvec), true));
+			if (ret != 0)
+				return ret;
+		}
+	}
+
+	if (node.vector != 0) {
+		idx = blk_alloc(u, rte_popcount64(node.vector), false);
+		if (idx < 0)
+			return idx;
+		node.base1 = idx;
+	}
+	vector = node.vector;
+	for (i = 0; vector != 0; vector &= vector - 1, i++) {
+		child_slot = rte_ctz64(vector);
+		if (child_slot != slot) {
+			dp->nodes[node.base1 + i] = *get_child(dp, &old,
+				child_slot);
+			continue;
+		}
+		ret = build_node(u, &child_ip, level + POPTRIE_STRIDE, inherit,
+			old_child, &dp->nodes[node.base1 + i]);
+		if (ret != 0)
+			return ret;
+	}
+
+	if (!ext && old_child != NULL) {
+		ret = release_subtree(u, old_child);
+		if (ret != 0)
+			return ret;
+	}
+	if (old.vector != 0) {
+		ret = blk_list_add(&u->old_blk, blk_desc(old.base1,
+			rte_popcount64(old.vector), false));
+		if (ret != 0)
+			return ret;
+	}
+
+	*dst = node;
+	return 0;
+}
+
+/*
+ * Build the node for the region ip/level into dst.
+ * The routes inside a child region do not change, so children of the
+ * previous version of the node inheriting the same next hop are shared
+ * with the new one.
+ */
+static int
+build_node(struct poptrie_update *u, const struct rte_ipv6_addr *ip,
+	uint32_t level, const uint64_t *inherit,
+	const struct poptrie_node *old_p, struct poptrie_node *dst)
+{
+	struct rte_poptrie_tbl *dp = u->dp;
+	struct poptrie_node old = {0};
+	struct poptrie_node node = {0};
+	struct rte_ipv6_addr child_ip;
+	uint64_t val[POPTRIE_NUM_VER][POPTRIE_NODE_NUM_ENT];
+	uint64_t vector, old_child_msk;
+	uint32_t i, slot, ver;
+	const struct poptrie_node *old_child;
+	const struct rte_rib6_node *subtree;
+	uint64_t child_inherit[POPTRIE_NUM_VER];
+	int64_t idx;
+	int ret;
+
+	if (old_p != NULL) {
+		if (u->depth > level + POPTRIE_STRIDE)
+			return update_node(u, ip, level, old_p, dst);
+		old = *old_p;
+	}
+
+	for (ver = 0; ver < POPTRIE_NUM_VER; ver++)
+		for (i = 0; i < POPTRIE_NODE_NUM_ENT; i++)
+			val[ver][i] = inherit[ver];
+	subtree = rte_rib6_get_subtree(u->rib, ip, level);
+	paint_subtree(u, subtree, level, POPTRIE_NEW, val[POPTRIE_NEW],
+		&node.vector);
+	if (old_p != NULL)
+		paint_subtree(u, subtree, level, POPTRIE_OLD, val[POPTRIE_OLD],
+			NULL);
+
+	ret = build_leaves(u, &node, val[POPTRIE_NEW]);
+	if (ret != 0)
+		return ret;
+	if (node.vector != 0) {
+		idx = blk_alloc(u, rte_popcount64(node.vector), false);
+		if (idx < 0)
+			return idx;
+		node.base1 = idx;
+	}
+
+	old_child_msk = 0;
+	vector = node.vector;
+	for (i = 0; vector != 0; vector &= vector - 1, i++) {
+		slot = rte_ctz64(vector);
+		child_ip = *ip;
+		addr_set_bits(&child_ip, level, slot);
+
+		old_child = NULL;
+		if (old.vector & (1ULL << slot)) {
+			old_child_msk |= 1ULL << slot;
+			old_child = get_child(dp, &old, slot);
+			if (val[POPTRIE_OLD][slot] == val[POPTRIE_NEW][slot]) {
+				dp->nodes[node.base1 + i] = *old_child;
+				continue;
+			}
+		}
+		child_inherit[POPTRIE_OLD] = val[POPTRIE_OLD][slot];
+		child_inherit[POPTRIE_NEW] = val[POPTRIE_NEW][slot];
+		ret = build_node(u, &child_ip, level + POPTRIE_STRIDE,
+			child_inherit, old_child, &dp->nodes[node.base1 + i]);
+		if (ret != 0)
+			return ret;
+	}
+
+	if (old_p != NULL) {
+		/* children gone from the new version */
+		vector = old.vector & ~old_child_msk;
+		for (; vector != 0; vector &= vector - 1) {
+			ret = release_subtree(u,
+				get_child(dp, &old, rte_ctz64(vector)));
+			if (ret != 0)
+				return ret;
+		}
+		if (old.vector != 0) {
+			ret = blk_list_add(&u->old_blk, blk_desc(old.base1,
+				rte_popcount64(old.vector), false));
+			if (ret != 0)
+				return ret;
+		}
+		if (old.leafvec != 0) {
+			ret = blk_list_add(&u->old_blk, blk_desc(old.base0,
+				rte_popcount64(old.leafvec), true));
+			if (ret != 0)
+				return ret;
+		}
+	}
+
+	*dst = node;
+	return 0;
+}
+
+static int
+build_dir_ent(struct poptrie_update *u, uint32_t dir_idx, uint64_t *ent)
+{
+	struct rte_poptrie_tbl *dp = u->dp;
+	struct rte_ipv6_addr ip = RTE_IPV6_ADDR_UNSPEC;
+	uint64_t old = dp->dir[dir_idx];
+	uint64_t inherit[POPTRIE_NUM_VER];
+	int64_t root;
+	int ret;
+
+	ip.a[0] = dir_idx >> 8;
+	ip.a[1] = dir_idx & UINT8_MAX;
+	get_inherit(u, &ip, POPTRIE_DIR_BITS, inherit);
+
+	if (!has_cover(u, &ip, POPTRIE_DIR_BITS)) {
+		*ent = inherit[POPTRIE_NEW] << 1;
+		if (!poptrie_is_ext(old))
+			return 0;
+		ret = release_subtree(u, &dp->nodes[old >> 1]);
+	} else if (poptrie_is_ext(old) && (u->depth <= POPTRIE_DIR_BITS) &&
+			(inherit[POPTRIE_OLD] == inherit[POPTRIE_NEW])) {
+		/* the modified route is shadowed by longer ones */
+		*ent = old;
+		return 0;
+	} else {
+		root = blk_alloc(u, 1, false);
+		if (root < 0)
+			return root;
+		ret = build_node(u, &ip, POPTRIE_DIR_BITS, inherit,
+			poptrie_is_ext(old) ? &dp->nodes[old >> 1] : NULL,
+			&dp->nodes[root]);
+		*ent = ((uint64_t)root << 1) | POPTRIE_EXT_ENT;
+		if (ret != 0 || !poptrie_is_ext(old))
+			return ret;
+	}
+	if (ret != 0)
+		return ret;
+
+	return blk_list_add(&u->old_blk, blk_desc(old >> 1, 1, false));
+}
+
+static void
+release_old(struct rte_poptrie_tbl *dp, struct poptrie_blk_list *list)
+{
+	uint32_t i;
+
+	if (dp->v == NULL) {
+		for (i = 0; i < list->num; i++)
+			blk_free(dp, list->blk[i]);
+	} else if (dp->rcu_mode == RTE_FIB6_QSBR_MODE_SYNC) {
+		/* Wait for quiescent state change. */
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+		for (i = 0; i < list->num; i++)
+			blk_free(dp, list->blk[i]);
+	} else if (dp->rcu_mode == RTE_FIB6_QSBR_MODE_DQ) {
+		/* Push into QSBR FIFO. */
+		for (i = 0; i < list->num; i++)
+			if (rte_rcu_qsbr_dq_enqueue(dp->dq, &list->blk[i]) != 0)
+				FIB_LOG(ERR, "Failed to push QSBR FIFO");
+	}
+}
+
+/*
+ * Rebuild the part of the trie covered by ip/depth from the RIB.
+ * The new version is written aside and published by updating
+ * the direct table entries, then the old blocks are released.
+ */
+static int
+modify_dp(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t depth,
+	struct rte_rib6_node *node, uint64_t old_nh, uint64_t new_nh)
+{
+	struct poptrie_update u = {
+		.dp = dp,
+		.rib = rib,
+		.node = node,
+		.nh = { old_nh, new_nh },
+		.ip = *ip,
+		.depth = depth,
+	};
+	uint64_t ent, *ents;
+	uint32_t i, first, num;
+	int ret = 0;
+
+	first = get_dir_idx(ip);
+	num = (depth < POPTRIE_DIR_BITS) ?
+		1 << (POPTRIE_DIR_BITS - depth) : 1;
+	ents = &ent;
+	if (num > 1) {
+		ents = rte_malloc(NULL, num * sizeof(*ents), 0);
+		if (ents == NULL)
+			return -ENOMEM;
+	}
+
+	for (i = 0; i < num; i++) {
+		ret = build_dir_ent(&u, first + i, &ents[i]);
+		if (ret != 0)
+			break;
+	}
+
+	if (ret != 0) {
+		/* nothing was published, the new blocks can go right away */
+		for (i = 0; i < u.new_blk.num; i++)
+			blk_free(dp, u.new_blk.blk[i]);
+	} else {
+		rte_atomic_thread_fence(rte_memory_order_release);
+		for (i = 0; i < num; i++)
+			dp->dir[first + i] = ents[i];
+		release_old(dp, &u.old_blk);
+	}
+
+	if (ents != &ent)
+		rte_free(ents);
+	rte_free(u.new_blk.blk);
+	rte_free(u.old_blk.blk);
+
+	return ret;
+}
+
+int
+poptrie_modify(struct rte_fib6 *fib, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint64_t next_hop, int op)
+{
+	struct rte_poptrie_tbl *dp;
+	struct rte_rib6 *rib;
+	struct rte_rib6_node *node;
+	struct rte_rib6_node *parent;
+	struct rte_ipv6_addr ip_masked;
+	int ret = 0;
+	uint64_t par_nh, node_nh;
+
+	if ((fib == NULL) || (ip == NULL) || (depth > RTE_IPV6_MAX_DEPTH))
+		return -EINVAL;
+
+	dp = rte_fib6_get_dp(fib);
+	RTE_ASSERT(dp);
+	rib = rte_fib6_get_rib(fib);
+	RTE_ASSERT(rib);
+
+	if ((op == RTE_FIB6_ADD) && (next_hop > get_max_nh(dp->nh_sz)))
+		return -EINVAL;
+
+	ip_masked = *ip;
+	rte_ipv6_addr_mask(&ip_masked, depth);
+
+	node = rte_rib6_lookup_exact(rib, &ip_masked, depth);
+	switch (op) {
+	case RTE_FIB6_ADD:
+		if (node != NULL) {
+			rte_rib6_get_nh(node, &node_nh);
+			if (node_nh == next_hop)
+				return 0;
+			rte_rib6_set_nh(node, next_hop);
+			ret = modify_dp(dp, rib, &ip_masked, depth, node,
+				node_nh, next_hop);
+			if (ret != 0)
+				rte_rib6_set_nh(node, node_nh);
+
+			return ret;
+		}
+
+		node = rte_rib6_insert(rib, &ip_masked, depth);
+		if (node == NULL)
+			return -rte_errno;
+
+		rte_rib6_set_nh(node, next_hop);
+		parent = rte_rib6_lookup_parent(node);
+		if (parent != NULL) {
+			rte_rib6_get_nh(parent, &par_nh);
+			if (par_nh == next_hop)
+				return 0;
+		}
+		ret = modify_dp(dp, rib, &ip_masked, depth, node,
+			POPTRIE_NO_ROUTE, next_hop);
+		if (ret != 0)
+			rte_rib6_remove(rib, &ip_masked, depth);
+
+		return ret;
+	case RTE_FIB6_DEL:
+		if (node == NULL)
+			return -ENOENT;
+
+		parent = rte_rib6_lookup_parent(node);
+		rte_rib6_get_nh(node, &node_nh);
+		par_nh = dp->def_nh;
+		if (parent != NULL)
+			rte_rib6_get_nh(parent, &par_nh);
+		if (par_nh != node_nh)
+			ret = modify_dp(dp, rib, &ip_masked, depth, node,
+				node_nh, POPTRIE_NO_ROUTE);
+
+		if (ret != 0)
+			return ret;
+
+		rte_rib6_remove(rib, &ip_masked, depth);
+
+		return 0;
+	default:
+		break;
+	}
+	return -EINVAL;
+}
+
+void *
+poptrie_create(const char *name, int socket_id,
+	struct rte_fib6_conf *conf)
+{
+	char mem_name[POPTRIE_NAMESIZE];
+	struct rte_poptrie_tbl *dp = NULL;
+	uint64_t	def_nh;
+	uint32_t	num_nodes, num_leaves, i;
+	enum rte_fib_trie_nh_sz	nh_sz;
+
+	if ((name == NULL) || (conf == NULL) ||
+			(conf->poptrie.nh_sz < RTE_FIB6_TRIE_2B) ||
+			(conf->poptrie.nh_sz > RTE_FIB6_TRIE_8B) ||
+			(conf->poptrie.num_nodes == 0) ||
+			(conf->poptrie.num_nodes > POPTRIE_MAX_POOL_SZ) ||
+			(conf->poptrie.num_leaves == 0) ||
+			(conf->poptrie.num_leaves > POPTRIE_MAX_POOL_SZ) ||
+			(conf->default_nh >
+			get_max_nh(conf->poptrie.nh_sz))) {
+
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	def_nh = conf->default_nh;
+	nh_sz = conf->poptrie.nh_sz;
+	num_nodes = RTE_ALIGN_CEIL(conf->poptrie.num_nodes,
+		POPTRIE_NODE_NUM_ENT);
+	num_leaves = RTE_ALIGN_CEIL(conf->poptrie.num_leaves,
+		POPTRIE_NODE_NUM_ENT);
+
+	snprintf(mem_name, sizeof(mem_name), "DP_%s", name);
+	dp = rte_zmalloc_socket(mem_name, sizeof(struct rte_poptrie_tbl) +
+		POPTRIE_DIR_NUM_ENT * sizeof(uint64_t),
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp == NULL) {
+		rte_errno = ENOMEM;
+		return dp;
+	}
+
+	for (i = 0; i < POPTRIE_DIR_NUM_ENT; i++)
+		dp->dir[i] = def_nh << 1;
+	dp->def_nh = def_nh;
+	dp->nh_sz = nh_sz;
+
+	snprintf(mem_name, sizeof(mem_name), "NODES_%p", dp);
+	dp->nodes = rte_zmalloc_socket(mem_name,
+		sizeof(struct poptrie_node) * num_nodes,
+		RTE_CACHE_LINE_SIZE, socket_id);
+	/* vector lookup loads 8 bytes for every leaf */
+	snprintf(mem_name, sizeof(mem_name), "LEAVES_%p", dp);
+	dp->leaves = rte_zmalloc_socket(mem_name,
+		((size_t)num_leaves << nh_sz) + sizeof(uint64_t),
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if ((dp->nodes == NULL) || (dp->leaves == NULL) ||
+			(pool_init(&dp->node_pool, num_nodes, socket_id) != 0) ||
+			(pool_init(&dp->leaf_pool, num_leaves, socket_id) != 0)) {
+		rte_errno = ENOMEM;
+		rte_free(dp->node_pool.next);
+		rte_free(dp->leaves);
+		rte_free(dp->nodes);
+		rte_free(dp);
+		return NULL;
+	}
+
+	return dp;
+}
+
+void
+poptrie_free(void *p)
+{
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;
+
+	rte_rcu_qsbr_dq_delete(dp->dq);
+	rte_free(dp->leaf_pool.next);
+	rte_free(dp->node_pool.next);
+	rte_free(dp->leaves);
+	rte_free(dp->nodes);
+	rte_free(dp);
+}
+
+int
+poptrie_rcu_qsbr_add(struct rte_poptrie_tbl *dp,
+	struct rte_fib6_rcu_config *cfg, const char *name)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+
+	if (dp == NULL || cfg == NULL)
+		return -EINVAL;
+
+	if (dp->v != NULL)
+		return -EEXIST;
+
+	switch (cfg->mode) {
+	case RTE_FIB6_QSBR_MODE_DQ:
+		/* Init QSBR defer queue. */
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+			"FIB_RCU_%s", name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = RTE_FIB6_RCU_DQ_RECLAIM_SZ;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = cfg->reclaim_max;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_FIB6_RCU_DQ_RECLAIM_MAX;
+		params.esize = sizeof(uint64_t);
+		params.free_fn = __rcu_qsbr_free_resource;
+		params.p = dp;
+		params.v = cfg->v;
+		dp->dq = rte_rcu_qsbr_dq_create(&params);
+		if (dp->dq == NULL) {
+			FIB_LOG(ERR, "FIB6 defer queue creation failed");
+			return -ENOMEM;
+		}
+		break;
+	case RTE_FIB6_QSBR_MODE_SYNC:
+		/* No other things to do. */
+		break;
+	default:
+		return -EINVAL;
+	}
+	dp->rcu_mode = cfg->mode;
+	dp->v = cfg->v;
+
+	return 0;
+}
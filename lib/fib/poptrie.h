@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _POPTRIE_H_
+#define _POPTRIE_H_
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <rte_bitops.h>
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_fib6.h>
+
+/**
+ * @file
+ * RTE IPv6 Longest Prefix Match (LPM) using a poptrie.
+ *
+ * The first 16 bits of the address index a direct table. Every other
+ * level consumes 6 bits and is represented by a node holding two 64-bit
+ * bitmaps: one marking the slots pointing to a child node and one marking
+ * the slots starting a run of identical next hops. Children and leaves of
+ * a node are stored contiguously, so the position of an entry is found
+ * with a popcount of the corresponding bitmap.
+ */
+
+/* @internal Number of bits resolved by the direct table. */
+#define POPTRIE_DIR_BITS	16
+/* @internal Total number of direct table entries. */
+#define POPTRIE_DIR_NUM_ENT	(1 << POPTRIE_DIR_BITS)
+/* @internal Number of bits resolved by a node. */
+#define POPTRIE_STRIDE		6
+/* @internal Number of slots in a node. */
+#define POPTRIE_NODE_NUM_ENT	(1 << POPTRIE_STRIDE)
+/* @internal Direct table entry points to a node. */
+#define POPTRIE_EXT_ENT		1
+/* @internal Number of addresses walked together by the scalar lookup. */
+#define POPTRIE_LOOKUP_GRP	8
+/* @internal Number of block sizes handled by the node and leaf pools. */
+#define POPTRIE_POOL_ORDERS	(POPTRIE_STRIDE + 1)
+
+struct poptrie_node {
+	uint64_t	vector;	/**< Slots pointing to a child node */
+	uint64_t	leafvec; /**< Slots starting a run of leaves */
+	uint32_t	base0;	/**< Index of the first leaf */
+	uint32_t	base1;	/**< Index of the first child node */
+};
+
+/* Buddy allocator for node and leaf blocks of up to 64 entries. */
+struct poptrie_pool {
+	uint32_t	*next;	/**< Next free block of the same order */
+	uint32_t	*prev;	/**< Previous free block of the same order */
+	uint8_t		*order;	/**< Order of a free block, UINT8_MAX if busy */
+	uint32_t	head[POPTRIE_POOL_ORDERS]; /**< Free lists */
+	uint32_t	num;	/**< Total number of entries */
+	uint32_t	used;	/**< Number of allocated entries */
+};
+
+struct rte_poptrie_tbl {
+	uint64_t	def_nh;		/**< Default next hop */
+	enum rte_fib_trie_nh_sz	nh_sz;	/**< Size of nexthop entry */
+	struct poptrie_node	*nodes;	/**< Node table */
+	void		*leaves;	/**< Leaf table */
+	struct poptrie_pool	node_pool;
+	struct poptrie_pool	leaf_pool;
+	/* RCU config. */
+	enum rte_fib6_qsbr_mode rcu_mode; /**< Blocking, defer queue. */
+	struct rte_rcu_qsbr *v; /**< RCU QSBR variable. */
+	struct rte_rcu_qsbr_dq *dq; /**< RCU QSBR defer queue. */
+	/* Direct table. */
+	alignas(RTE_CACHE_LINE_SIZE) uint64_t	dir[];
+};
+
+static inline void
+poptrie_addr_load(const struct rte_ipv6_addr *ip, uint64_t *hi, uint64_t *lo)
+{
+	rte_be64_t tmp[2];
+
+	memcpy(tmp, ip, sizeof(tmp));
+	*hi = rte_be_to_cpu_64(tmp[0]);
+	*lo = rte_be_to_cpu_64(tmp[1]);
+}
+
+/*
+ * Get the node slot for the level starting at bit offset off.
+ * Levels never straddle the two halves of the address, the last one
+ * only has 4 significant bits.
+ */
+static inline uint32_t
+poptrie_get_bits(uint64_t hi, uint64_t lo, uint32_t off)
+{
+	if (off <= 64 - POPTRIE_STRIDE)
+		return (hi >> (64 - POPTRIE_STRIDE - off)) &
+			(POPTRIE_NODE_NUM_ENT - 1);
+	if (off <= 128 - POPTRIE_STRIDE)
+		return (lo >> (128 - POPTRIE_STRIDE - off)) &
+			(POPTRIE_NODE_NUM_ENT - 1);
+	return (lo << (off - (128 - POPTRIE_STRIDE))) &
+		(POPTRIE_NODE_NUM_ENT - 1);
+}
+
+static inline int
+poptrie_is_ext(uint64_t ent)
+{
+	return (ent & POPTRIE_EXT_ENT) == POPTRIE_EXT_ENT;
+}
+
+/*
+ * The scalar lookup walks the tries of a group of addresses level by
+ * level, so that the loads of the nodes of the different walks overlap
+ * instead of each walk waiting for its previous level.
+ */
+#define POPTRIE_LOOKUP_FUNC(suffix, type)				\
+static inline void rte_poptrie_lookup_bulk_##suffix(void *p,		\
+	const struct rte_ipv6_addr *ips,				\
+	uint64_t *next_hops, const unsigned int n)			\
+{									\
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;	\
+	const struct poptrie_node *node[POPTRIE_LOOKUP_GRP];		\
+	uint64_t hi[POPTRIE_LOOKUP_GRP], lo[POPTRIE_LOOKUP_GRP];	\
+	uint64_t ent, msk;						\
+	uint32_t i, j, cnt, off, v, active;				\
+									\
+	for (i = 0; i < n; i += cnt) {					\
+		cnt = RTE_MIN(n - i, (uint32_t)POPTRIE_LOOKUP_GRP);	\
+		active = 0;						\
+		for (j = 0; j < cnt; j++) {				\
+			poptrie_addr_load(&ips[i + j], &hi[j], &lo[j]);	\
+			ent = dp->dir[hi[j] >> (64 - POPTRIE_DIR_BITS)];\
+			if (!poptrie_is_ext(ent)) {			\
+				next_hops[i + j] = ent >> 1;		\
+				continue;				\
+			}						\
+			node[j] = &dp->nodes[ent >> 1];			\
+			active |= 1U << j;				\
+		}							\
+		for (off = POPTRIE_DIR_BITS; active != 0;		\
+				off += POPTRIE_STRIDE) {		\
+			for (j = 0; j < cnt; j++) {			\
+				if ((active & (1U << j)) == 0)		\
+					continue;			\
+				v = poptrie_get_bits(hi[j], lo[j], off);\
+				msk = (2ULL << v) - 1;			\
+				if (node[j]->vector & (1ULL << v)) {	\
+					node[j] = &dp->nodes[		\
+						node[j]->base1 +	\
+						rte_popcount64(		\
+						node[j]->vector & msk) - 1]; \
+					continue;			\
+				}					\
+				next_hops[i + j] = ((const type *)	\
+					dp->leaves)[node[j]->base0 +	\
+					rte_popcount64(			\
+					node[j]->leafvec & msk) - 1];	\
+				active &= ~(1U << j);			\
+			}						\
+		}							\
+	}								\
+}
+POPTRIE_LOOKUP_FUNC(2b, uint16_t)
+POPTRIE_LOOKUP_FUNC(4b, uint32_t)
+POPTRIE_LOOKUP_FUNC(8b, uint64_t)
+
+void
+poptrie_free(void *p);
+
+void *
+poptrie_create(const char *name, int socket_id, struct rte_fib6_conf *conf)
+	__rte_malloc __rte_dealloc(poptrie_free, 1);
+
+rte_fib6_lookup_fn_t
+poptrie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type);
+
+int
+poptrie_modify(struct rte_fib6 *fib, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint64_t next_hop, int op);
+
+int
+poptrie_rcu_qsbr_add(struct rte_poptrie_tbl *dp,
+	struct rte_fib6_rcu_config *cfg, const char *name);
+
+#endif /* _POPTRIE_H_ */
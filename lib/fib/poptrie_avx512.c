@@ -0,0 +1,221 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "poptrie.h"
+#include "poptrie_avx512.h"
+
+static __rte_always_inline void
+transpose_x8(const struct rte_ipv6_addr *ips,
+	__m512i *first, __m512i *second)
+{
+	__m512i tmp1, tmp2, tmp3, tmp4;
+	const __rte_x86_zmm_t perm_idxes = {
+		.u64 = { 0, 2, 4, 6, 1, 3, 5, 7
+		},
+	};
+
+	tmp1 = _mm512_loadu_si512(&ips[0]);
+	tmp2 = _mm512_loadu_si512(&ips[4]);
+
+	tmp3 = _mm512_unpacklo_epi64(tmp1, tmp2);
+	*first = _mm512_permutexvar_epi64(perm_idxes.z, tmp3);
+	tmp4 = _mm512_unpackhi_epi64(tmp1, tmp2);
+	*second = _mm512_permutexvar_epi64(perm_idxes.z, tmp4);
+}
+
+/* popcount of every epi64, AVX512BW only */
+static __rte_always_inline __m512i
+popcnt_epi64(__m512i x)
+{
+	const __m512i lut = _mm512_set4_epi32(0x04030302, 0x03020201,
+		0x03020201, 0x02010100);
+	const __m512i low_nibble = _mm512_set1_epi8(0x0f);
+	__m512i lo, hi;
+
+	lo = _mm512_and_si512(x, low_nibble);
+	hi = _mm512_and_si512(_mm512_srli_epi16(x, 4), low_nibble);
+	lo = _mm512_add_epi8(_mm512_shuffle_epi8(lut, lo),
+		_mm512_shuffle_epi8(lut, hi));
+	return _mm512_sad_epu8(lo, _mm512_setzero_si512());
+}
+
+/* Lookup state of 8 addresses */
+struct poptrie_vec_state {
+	__m512i	hi;	/**< First 64 bits of the addresses */
+	__m512i	lo;	/**< Last 64 bits of the addresses */
+	__m512i	res;	/**< Next hops */
+	__m512i	idxes;	/**< Byte offsets of the current nodes */
+	__mmask8 msk_ext; /**< Lanes pointing to a node */
+};
+
+static __rte_always_inline void
+poptrie_vec_init_x8(struct rte_poptrie_tbl *dp, const struct rte_ipv6_addr *ips,
+	struct poptrie_vec_state *st)
+{
+	const __m512i lsb = _mm512_set1_epi64(1);
+	const __m512i node_sz = _mm512_set1_epi64(sizeof(struct poptrie_node));
+	const __rte_x86_zmm_t bswap = {
+		.u8 = { 7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8,
+			7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8,
+			7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8,
+			7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8
+			},
+	};
+	__m512i idxes;
+
+	transpose_x8(ips, &st->hi, &st->lo);
+	st->hi = _mm512_shuffle_epi8(st->hi, bswap.z);
+	st->lo = _mm512_shuffle_epi8(st->lo, bswap.z);
+
+	/* lookup in the direct table */
+	idxes = _mm512_srli_epi64(st->hi, 64 - POPTRIE_DIR_BITS);
+	st->res = _mm512_i64gather_epi64(idxes, (const void *)dp->dir, 8);
+	st->msk_ext = _mm512_test_epi64_mask(st->res, lsb);
+	st->res = _mm512_srli_epi64(st->res, 1);
+	/* byte offsets of the nodes */
+	st->idxes = _mm512_mullo_epi64(st->res, node_sz);
+}
+
+/* Resolve the level starting at bit offset off */
+static __rte_always_inline void
+poptrie_vec_step_x8(struct rte_poptrie_tbl *dp, struct poptrie_vec_state *st,
+	uint32_t off, int size)
+{
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i lsb = _mm512_set1_epi64(1);
+	const __m512i two = _mm512_set1_epi64(2);
+	const __m512i slot_msk = _mm512_set1_epi64(POPTRIE_NODE_NUM_ENT - 1);
+	const __m512i low32_msk = _mm512_set1_epi64(UINT32_MAX);
+	const __m512i node_sz = _mm512_set1_epi64(sizeof(struct poptrie_node));
+	/* used to mask gather values for 16 and 32 bit next hops */
+	const __m512i res_msk = _mm512_set1_epi64((size == sizeof(uint64_t)) ?
+		UINT64_MAX : (1ULL << (size * 8)) - 1);
+	const uint8_t *nodes = (const uint8_t *)dp->nodes;
+	__m512i slots, vec, leafvec, bases, bit, msk, tmp;
+	__mmask8 msk_child, msk_leaf;
+
+	if (st->msk_ext == 0)
+		return;
+
+	if (off <= 64 - POPTRIE_STRIDE)
+		slots = _mm512_srl_epi64(st->hi,
+			_mm_cvtsi32_si128(64 - POPTRIE_STRIDE - off));
+	else if (off <= 128 - POPTRIE_STRIDE)
+		slots = _mm512_srl_epi64(st->lo,
+			_mm_cvtsi32_si128(128 - POPTRIE_STRIDE - off));
+	else
+		slots = _mm512_sll_epi64(st->lo,
+			_mm_cvtsi32_si128(off - (128 - POPTRIE_STRIDE)));
+	slots = _mm512_and_si512(slots, slot_msk);
+
+	vec = _mm512_mask_i64gather_epi64(zero, st->msk_ext, st->idxes,
+		(const void *)nodes, 1);
+	leafvec = _mm512_mask_i64gather_epi64(zero, st->msk_ext, st->idxes,
+		(const void *)(nodes + offsetof(struct poptrie_node, leafvec)),
+		1);
+	bases = _mm512_mask_i64gather_epi64(zero, st->msk_ext, st->idxes,
+		(const void *)(nodes + offsetof(struct poptrie_node, base0)),
+		1);
+
+	bit = _mm512_sllv_epi64(lsb, slots);
+	msk = _mm512_sub_epi64(_mm512_sllv_epi64(two, slots), lsb);
+	msk_child = _mm512_mask_test_epi64_mask(st->msk_ext, vec, bit);
+	msk_leaf = st->msk_ext & ~msk_child;
+
+	/* base1 + popcount(vector & msk) - 1 */
+	tmp = popcnt_epi64(_mm512_and_si512(vec, msk));
+	tmp = _mm512_add_epi64(_mm512_srli_epi64(bases, 32), tmp);
+	tmp = _mm512_sub_epi64(tmp, lsb);
+	st->idxes = _mm512_mask_mullo_epi64(st->idxes, msk_child, tmp,
+		node_sz);
+
+	if (msk_leaf != 0) {
+		/* base0 + popcount(leafvec & msk) - 1 */
+		tmp = popcnt_epi64(_mm512_and_si512(leafvec, msk));
+		tmp = _mm512_add_epi64(_mm512_and_si512(bases, low32_msk),
+			tmp);
+		tmp = _mm512_sub_epi64(tmp, lsb);
+		/* Put it inside branch to make compiler happy with -O0 */
+		if (size == sizeof(uint16_t))
+			tmp = _mm512_mask_i64gather_epi64(zero, msk_leaf, tmp,
+				(const void *)dp->leaves, 2);
+		else if (size == sizeof(uint32_t))
+			tmp = _mm512_mask_i64gather_epi64(zero, msk_leaf, tmp,
+				(const void *)dp->leaves, 4);
+		else
+			tmp = _mm512_mask_i64gather_epi64(zero, msk_leaf, tmp,
+				(const void *)dp->leaves, 8);
+		st->res = _mm512_mask_and_epi64(st->res, msk_leaf, tmp,
+			res_msk);
+	}
+	st->msk_ext = msk_child;
+}
+
+static __rte_always_inline void
+poptrie_vec_lookup_x8x2(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, int size)
+{
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;
+	struct poptrie_vec_state st_1, st_2;
+	uint32_t off;
+
+	poptrie_vec_init_x8(dp, ips, &st_1);
+	poptrie_vec_init_x8(dp, ips + 8, &st_2);
+
+	/* traverse down the trie */
+	for (off = POPTRIE_DIR_BITS; (st_1.msk_ext | st_2.msk_ext) != 0;
+			off += POPTRIE_STRIDE) {
+		poptrie_vec_step_x8(dp, &st_1, off, size);
+		poptrie_vec_step_x8(dp, &st_2, off, size);
+	}
+
+	_mm512_storeu_si512(next_hops, st_1.res);
+	_mm512_storeu_si512(next_hops + 8, st_2.res);
+}
+
+void
+rte_poptrie_vec_lookup_bulk_2b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 16); i++) {
+		poptrie_vec_lookup_x8x2(p, &ips[i * 16],
+				next_hops + i * 16, sizeof(uint16_t));
+	}
+	rte_poptrie_lookup_bulk_2b(p, &ips[i * 16],
+			next_hops + i * 16, n - i * 16);
+}
+
+void
+rte_poptrie_vec_lookup_bulk_4b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 16); i++) {
+		poptrie_vec_lookup_x8x2(p, &ips[i * 16],
+				next_hops + i * 16, sizeof(uint32_t));
+	}
+	rte_poptrie_lookup_bulk_4b(p, &ips[i * 16],
+			next_hops + i * 16, n - i * 16);
+}
+
+void
+rte_poptrie_vec_lookup_bulk_8b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	uint32_t i;
+	for (i = 0; i < (n / 16); i++) {
+		poptrie_vec_lookup_x8x2(p, &ips[i * 16],
+				next_hops + i * 16, sizeof(uint64_t));
+	}
+	rte_poptrie_lookup_bulk_8b(p, &ips[i * 16],
+			next_hops + i * 16, n - i * 16);
+}
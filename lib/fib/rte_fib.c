@@ -45,6 +45,7 @@ struct rte_fib {
 	void			*dp;	/**< pointer to the dataplane struct*/
 	rte_fib_lookup_fn_t	lookup;	/**< FIB lookup function */
 	rte_fib_modify_fn_t	modify; /**< modify FIB datastructure */
+	rte_fib_modify_bulk_fn_t modify_bulk; /**< batched modify, optional */
 	uint64_t		def_nh;
 };
 
@@ -111,6 +112,7 @@ init_dataplane(struct rte_fib *fib, __rte_unused int socket_id,
 		fib->lookup = dir24_8_get_lookup_fn(fib->dp,
 			RTE_FIB_LOOKUP_DEFAULT, !!(fib->flags & RTE_FIB_F_LOOKUP_NETWORK_ORDER));
 		fib->modify = dir24_8_modify;
+		fib->modify_bulk = dir24_8_modify_bulk;
 		return 0;
 	default:
 		return -EINVAL;
@@ -138,6 +140,34 @@ rte_fib_delete(struct rte_fib *fib, uint32_t ip, uint8_t depth)
 	return fib->modify(fib, ip, depth, 0, RTE_FIB_DEL);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib_modify_bulk, 26.11)
+int
+rte_fib_modify_bulk(struct rte_fib *fib, const struct rte_fib_route_op *ops,
+	uint32_t num)
+{
+	uint32_t i;
+	int ret;
+
+	if ((fib == NULL) || (fib->modify == NULL) ||
+			((ops == NULL) && (num != 0)) || (num > INT32_MAX))
+		return -EINVAL;
+
+	if (fib->modify_bulk != NULL)
+		return fib->modify_bulk(fib, ops, num);
+
+	/* no batched version for this dataplane, apply one by one */
+	for (i = 0; i != num; i++) {
+		ret = (ops[i].depth > RTE_FIB_MAXDEPTH) ? -EINVAL :
+			fib->modify(fib, ops[i].ip, ops[i].depth,
+				ops[i].next_hop, ops[i].op);
+		if (ret != 0) {
+			rte_errno = -ret;
+			break;
+		}
+	}
+	return i;
+}
+
 RTE_EXPORT_SYMBOL(rte_fib_lookup_bulk)
 int
 rte_fib_lookup_bulk(struct rte_fib *fib, uint32_t *ips,
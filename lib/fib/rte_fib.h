@@ -64,6 +64,18 @@ enum rte_fib_op {
 	RTE_FIB_DEL,
 };
 
+/** Route operation for rte_fib_modify_bulk() */
+struct rte_fib_route_op {
+	uint32_t ip;		/**< IPv4 prefix address */
+	uint8_t depth;		/**< Prefix length */
+	uint8_t op;		/**< Operation, see enum rte_fib_op */
+	uint64_t next_hop;	/**< Next hop, for RTE_FIB_ADD only */
+};
+
+/** Modify FIB function for a batch of route operations */
+typedef int (*rte_fib_modify_bulk_fn_t)(struct rte_fib *fib,
+	const struct rte_fib_route_op *ops, uint32_t num);
+
 /** Size of nexthop (1 << nh_sz) bits for DIR24_8 based FIB */
 enum rte_fib_dir24_8_nh_sz {
 	RTE_FIB_DIR24_8_1B,
@@ -204,6 +216,39 @@ rte_fib_add(struct rte_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_hop);
 int
 rte_fib_delete(struct rte_fib *fib, uint32_t ip, uint8_t depth);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Apply a batch of route additions and deletions to the FIB.
+ *
+ * The operations are applied in order to the RIB first,
+ * then the dataplane is updated once for the whole batch:
+ * each changed prefix is written once, and a deleted prefix is not written
+ * when a changed covering prefix of the batch already rewrote its range.
+ * The tbl8 groups released by the batch are reclaimed
+ * after a single RCU grace period, if an RCU QSBR variable is attached.
+ * Lookups running concurrently may see any subset of the batch applied.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param ops
+ *   Array of route operations
+ * @param num
+ *   Number of elements in ops array
+ * @return
+ *   Number of operations applied on success.
+ *   If it is less than num, rte_errno is set to the error of the
+ *   operation which failed, and the following ones are not applied.
+ *   Negative value if the dataplane could not be updated,
+ *   in which case the batch is rolled back and none of the operations
+ *   is applied.
+ */
+__rte_experimental
+int
+rte_fib_modify_bulk(struct rte_fib *fib, const struct rte_fib_route_op *ops,
+	uint32_t num);
+
 /**
  * Lookup multiple IP addresses in the FIB.
  *
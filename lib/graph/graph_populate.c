@@ -105,8 +105,14 @@ graph_nodes_populate(struct graph *_graph)
 		node->id = graph_node->node->id;
 		node->parent_id = pid;
 		node->dispatch.lcore_id = graph_node->node->lcore_id;
+		node->dispatch.stealable =
+			!!(graph_node->node->flags & RTE_NODE_STEALABLE_F);
 		nb_edges = graph_node->node->nb_edges;
 		node->nb_edges = nb_edges;
+		node->batch_min = graph_node->node->batch_min;
+		node->batch_delay = graph_node->node->batch_delay;
+		if (node->batch_min != 0)
+			graph->coalesce = 1;
 		off += sizeof(struct rte_node);
 		/* Copy the name in first pass to replace with rte_node* later*/
 		for (count = 0; count < nb_edges; count++)
@@ -57,6 +57,8 @@ struct node {
 	rte_node_t id;		      /**< Allocated identifier for the node. */
 	rte_node_t parent_id;	      /**< Parent node identifier. */
 	rte_edge_t nb_edges;	      /**< Number of edges from this node. */
+	uint16_t batch_min;	      /**< Minimum number of objects to process. */
+	uint64_t batch_delay;	      /**< Maximum deferral, in TSC ticks. */
 	struct rte_node_xstats *xstats;	      /**< Node specific xstats. */
 	char next_nodes[][RTE_NODE_NAMESIZE]; /**< Names of next nodes. */
 };
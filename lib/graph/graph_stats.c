@@ -44,7 +44,7 @@ struct __rte_cache_aligned rte_graph_cluster_stats {
 #define boarder_model_dispatch()                                                              \
 	fprintf(f, "+-------------------------------+---------------+--------" \
 		   "-------+---------------+---------------+---------------+" \
-		   "---------------+---------------+-" \
+		   "---------------+---------------+---------------+-" \
 		   "----------+\n")
 
 #define boarder()                                                              \
@@ -66,9 +66,9 @@ static inline void
 print_banner_dispatch(FILE *f)
 {
 	boarder_model_dispatch();
-	fprintf(f, "%-32s%-16s%-16s%-16s%-16s%-16s%-16s%-16s%-16s\n",
+	fprintf(f, "%-32s%-16s%-16s%-16s%-16s%-16s%-16s%-16s%-16s%-16s\n",
 		"|Node", "|calls",
-		"|objs", "|sched objs", "|sched fail",
+		"|objs", "|sched objs", "|sched fail", "|stolen objs",
 		"|realloc_count", "|objs/call", "|objs/sec(10E6)",
 		"|cycles/call|");
 	boarder_model_dispatch();
@@ -107,10 +107,11 @@ print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispat
 	if (dispatch) {
 		fprintf(f,
 			"|%-31s|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
-			"|%-15" PRIu64 "|%-15" PRIu64
+			"|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
 			"|%-15.3f|%-15.6f|%-11.4f|\n",
 			stat->name, calls, objs, stat->dispatch.sched_objs,
-			stat->dispatch.sched_fail, stat->realloc_count, objs_per_call,
+			stat->dispatch.sched_fail, stat->dispatch.stolen_objs,
+			stat->realloc_count, objs_per_call,
 			objs_per_sec, cycles_per_call);
 	} else {
 		fprintf(f,
@@ -129,9 +130,9 @@ print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispa
 	if (dispatch) {
 		for (i = 0; i < stat->xstat_cntrs; i++)
 			fprintf(f,
-				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
+				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
 				stat->xstat_desc[i], "", stat->xstat_count[i], "", "", "", "", "",
-				"");
+				"", "");
 	} else {
 		for (i = 0; i < stat->xstat_cntrs; i++)
 			fprintf(f,
@@ -140,6 +141,33 @@ print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispa
 	}
 }
 
+static inline void
+print_batch_hist(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispatch)
+{
+	char desc[RTE_NODE_XSTAT_DESC_SIZE];
+	int i;
+
+	for (i = 0; i < RTE_NODE_BATCH_HIST_SZ; i++) {
+		if (stat->batch_hist[i] == 0)
+			continue;
+		if (i < 2)
+			snprintf(desc, sizeof(desc), "batch %d", i);
+		else if (i == RTE_NODE_BATCH_HIST_SZ - 1)
+			snprintf(desc, sizeof(desc), "batch %d+", 1 << (i - 1));
+		else
+			snprintf(desc, sizeof(desc), "batch %d-%d", 1 << (i - 1),
+				 (1 << i) - 1);
+		if (dispatch)
+			fprintf(f,
+				"|\t%-24s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
+				desc, stat->batch_hist[i], "", "", "", "", "", "", "", "");
+		else
+			fprintf(f,
+				"|\t%-24s|%-15" PRIu64 "|%15s|%15s|%15.3s|%15.6s|%11.4s|\n",
+				desc, stat->batch_hist[i], "", "", "", "", "");
+	}
+}
+
 static int
 graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		       const struct rte_graph_cluster_node_stats *stat)
@@ -152,6 +180,7 @@ graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		print_node(f, stat, dispatch);
 		if (stat->xstat_cntrs)
 			print_xstat(f, stat, dispatch);
+		print_batch_hist(f, stat, dispatch);
 	}
 	if (unlikely(is_last)) {
 		if (dispatch)
@@ -478,7 +507,7 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 {
 	uint64_t calls = 0, cycles = 0, objs = 0, realloc_count = 0;
 	struct rte_graph_cluster_node_stats *stat = &cluster->stat;
-	uint64_t sched_objs = 0, sched_fail = 0;
+	uint64_t sched_objs = 0, sched_fail = 0, stolen_objs = 0;
 	struct rte_node *node;
 	rte_node_t count;
 	uint64_t *xstat;
@@ -486,18 +515,22 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 
 	if (stat->xstat_cntrs != 0)
 		memset(stat->xstat_count, 0, sizeof(uint64_t) * stat->xstat_cntrs);
+	memset(stat->batch_hist, 0, sizeof(stat->batch_hist));
 	for (count = 0; count < cluster->nb_nodes; count++) {
 		node = cluster->nodes[count];
 
 		if (dispatch) {
 			sched_objs += node->dispatch.total_sched_objs;
 			sched_fail += node->dispatch.total_sched_fail;
+			stolen_objs += node->dispatch.total_stolen_objs;
 		}
 
 		calls += node->total_calls;
 		objs += node->total_objs;
 		cycles += node->total_cycles;
 		realloc_count += node->realloc_count;
+		for (i = 0; i < RTE_NODE_BATCH_HIST_SZ; i++)
+			stat->batch_hist[i] += node->batch_hist[i];
 
 		if (node->xstat_off == 0)
 			continue;
@@ -513,6 +546,7 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 	if (dispatch) {
 		stat->dispatch.sched_objs = sched_objs;
 		stat->dispatch.sched_fail = sched_fail;
+		stat->dispatch.stolen_objs = stolen_objs;
 	}
 
 	stat->ts = rte_get_timer_cycles();
@@ -574,6 +608,7 @@ rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat)
 		node->prev_objs = 0;
 		node->prev_cycles = 0;
 		node->realloc_count = 0;
+		memset(node->batch_hist, 0, sizeof(node->batch_hist));
 		for (i = 0; i < node->xstat_cntrs; i++)
 			node->xstat_count[i] = 0;
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
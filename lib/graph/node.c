@@ -186,6 +186,7 @@ node_clone(struct node *node, const char *name)
 {
 	rte_node_t rc = RTE_NODE_ID_INVALID;
 	struct rte_node_register *reg;
+	struct node *clone;
 	rte_edge_t i;
 
 	/* Don't allow cloning a node from a cloned node */
@@ -230,6 +231,12 @@ node_clone(struct node *node, const char *name)
 		goto free_xstat;
 
 	rc = __rte_node_register(reg);
+	if (rc != RTE_NODE_ID_INVALID) {
+		/* Clones are coalesced like their parent */
+		clone = node_from_id(rc);
+		clone->batch_min = node->batch_min;
+		clone->batch_delay = node->batch_delay;
+	}
 free_xstat:
 	free(reg->xstats);
 free:
@@ -546,3 +553,27 @@ rte_node_free(rte_node_t id)
 fail:
 	return rc;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_batch_coalesce_set, 26.11)
+int
+rte_node_batch_coalesce_set(rte_node_t id, uint16_t min_batch,
+			    uint64_t max_delay)
+{
+	struct node *node;
+	int rc = -EINVAL;
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(node, &node_list, next) {
+		if (id == node->id) {
+			if (node->flags & RTE_NODE_SOURCE_F)
+				break;
+			node->batch_min = min_batch > 1 ? min_batch : 0;
+			node->batch_delay = max_delay;
+			rc = 0;
+			break;
+		}
+	}
+	graph_spinlock_unlock();
+
+	return rc;
+}
@@ -31,6 +31,12 @@ extern "C" {
 #define RTE_GRAPH_NAMESIZE 64 /**< Max length of graph name. */
 #define RTE_NODE_NAMESIZE 64  /**< Max length of node name. */
 #define RTE_NODE_XSTAT_DESC_SIZE 64  /**< Max length of node xstat description. */
+/**
+ * Number of buckets of the node batch size histogram.
+ * Bucket 0 counts the calls with no object, bucket i the calls with
+ * 2^(i-1) to 2^i - 1 objects, and the last bucket all the larger calls.
+ */
+#define RTE_NODE_BATCH_HIST_SZ 8
 #define RTE_GRAPH_PCAP_FILE_SZ 64 /**< Max length of pcap file name. */
 #define RTE_GRAPH_OFF_INVALID UINT32_MAX /**< Invalid graph offset. */
 #define RTE_NODE_ID_INVALID UINT32_MAX   /**< Invalid node id. */
@@ -231,11 +237,16 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 			/**< Previous number of scheduled objs for dispatch model. */
 			uint64_t sched_fail;
 			/**< Previous number of failed schedule objs for dispatch model. */
+			uint64_t stolen_objs;
+			/**< Number of objs processed by a stealing lcore for dispatch model. */
 		} dispatch;
 	};
 
 	uint64_t realloc_count; /**< Realloc count. */
 
+	/** Number of calls per number of objects, see RTE_NODE_BATCH_HIST_SZ. */
+	uint64_t batch_hist[RTE_NODE_BATCH_HIST_SZ];
+
 	uint8_t xstat_cntrs;			      /**< Number of Node xstat counters. */
 	char (*xstat_desc)[RTE_NODE_XSTAT_DESC_SIZE]; /**< Names of the Node xstat counters. */
 	uint64_t *xstat_count;			      /**< Total stat count per each xstat. */
@@ -496,6 +507,8 @@ struct rte_node_register {
 	char name[RTE_NODE_NAMESIZE]; /**< Name of the node. */
 	uint64_t flags;		      /**< Node configuration flag. */
 #define RTE_NODE_SOURCE_F (1ULL << 0) /**< Node type is source. */
+#define RTE_NODE_STEALABLE_F (1ULL << 1)
+/**< Node is stateless, see rte_graph_model_mcore_dispatch_node_steal_set(). */
 	rte_node_process_t process; /**< Node process function. */
 	rte_node_init_t init;       /**< Node init function. */
 	rte_node_fini_t fini;       /**< Node fini function. */
@@ -688,6 +701,33 @@ rte_node_is_invalid(rte_node_t id)
 __rte_experimental
 int rte_node_free(rte_node_t id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the batching thresholds of a node for the RTC graph walk.
+ *
+ * When the pending stream of the node has less than min_batch objects,
+ * the walk defers it to a next walk, so that more objects accumulate.
+ * A stream is deferred for max_delay TSC ticks at most.
+ * It applies to the graphs created after this call.
+ *
+ * @param id
+ *   Node id, not a source node.
+ * @param min_batch
+ *   Minimum number of objects to process, 0 or 1 to never defer.
+ * @param max_delay
+ *   Maximum deferral of a stream, in TSC ticks.
+ *
+ * @return
+ *   0 on success, -EINVAL on invalid parameters.
+ *
+ * @see rte_get_tsc_hz()
+ */
+__rte_experimental
+int rte_node_batch_coalesce_set(rte_node_t id, uint16_t min_batch,
+				uint64_t max_delay);
+
 /**
  * Test the validity of edge id.
  *
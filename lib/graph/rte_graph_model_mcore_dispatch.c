@@ -12,8 +12,10 @@ graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
 {
 	struct rte_graph *parent_graph = _parent_graph->graph;
 	struct rte_graph *graph = _graph->graph;
+	char name[RTE_RING_NAMESIZE];
 	unsigned int wq_size;
 	unsigned int flags = RING_F_SC_DEQ;
+	int ret;
 
 	wq_size = RTE_GRAPH_SCHED_WQ_SIZE(graph->nb_nodes);
 	wq_size = rte_align32pow2(wq_size + 1);
@@ -30,14 +32,28 @@ graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
 	if (graph->dispatch.wq == NULL)
 		SET_ERR_JMP(EIO, fail, "Failed to allocate graph WQ");
 
+	/*
+	 * The streams of stealable nodes are queued apart, in a multi-consumer
+	 * ring, so that idle graphs can dequeue them.
+	 * Without room for its name, the graph gets no stealable streams.
+	 */
+	ret = snprintf(name, sizeof(name), "%s_s", graph->name);
+	if (ret > 0 && ret < (int)sizeof(name)) {
+		graph->dispatch.sq = rte_ring_create(name, wq_size,
+				graph->socket, flags & ~RING_F_SC_DEQ);
+		if (graph->dispatch.sq == NULL)
+			SET_ERR_JMP(EIO, fail_sq, "Failed to allocate graph SQ");
+	}
+
 	if (prm->dispatch.mp_capacity > 0)
 		wq_size = (wq_size <= prm->dispatch.mp_capacity) ? wq_size :
 			prm->dispatch.mp_capacity;
 
+	/* Stolen streams are given back by the stealing graphs. */
 	graph->dispatch.mp = rte_mempool_create(graph->name, wq_size,
 						sizeof(struct graph_mcore_dispatch_wq_node),
-						0, 0, NULL, NULL, NULL, NULL,
-						graph->socket, MEMPOOL_F_SP_PUT);
+						0, 0, NULL, NULL, NULL, NULL, graph->socket,
+						graph->dispatch.sq != NULL ? 0 : MEMPOOL_F_SP_PUT);
 	if (graph->dispatch.mp == NULL)
 		SET_ERR_JMP(EIO, fail_mp,
 			    "Failed to allocate graph WQ schedule entry");
@@ -55,6 +71,9 @@ graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
 	return 0;
 
 fail_mp:
+	rte_ring_free(graph->dispatch.sq);
+	graph->dispatch.sq = NULL;
+fail_sq:
 	rte_ring_free(graph->dispatch.wq);
 	graph->dispatch.wq = NULL;
 fail:
@@ -72,6 +91,9 @@ graph_sched_wq_destroy(struct graph *_graph)
 	rte_ring_free(graph->dispatch.wq);
 	graph->dispatch.wq = NULL;
 
+	rte_ring_free(graph->dispatch.sq);
+	graph->dispatch.sq = NULL;
+
 	rte_mempool_free(graph->dispatch.mp);
 	graph->dispatch.mp = NULL;
 }
@@ -80,9 +102,13 @@ static __rte_always_inline bool
 __graph_sched_node_enqueue(struct rte_node *node, struct rte_graph *graph)
 {
 	struct graph_mcore_dispatch_wq_node *wq_node;
+	struct rte_ring *wq = graph->dispatch.wq;
 	uint16_t off = 0;
 	uint16_t size;
 
+	if (node->dispatch.stealable && graph->dispatch.sq != NULL)
+		wq = graph->dispatch.sq;
+
 submit_again:
 	if (rte_mempool_get(graph->dispatch.mp, (void **)&wq_node) < 0)
 		goto fallback;
@@ -92,7 +118,7 @@ __graph_sched_node_enqueue(struct rte_node *node, struct rte_graph *graph)
 	wq_node->nb_objs = size;
 	rte_memcpy(wq_node->objs, &node->objs[off], size * sizeof(void *));
 
-	while (rte_ring_mp_enqueue_bulk_elem(graph->dispatch.wq, (void *)&wq_node,
+	while (rte_ring_mp_enqueue_bulk_elem(wq, (void *)&wq_node,
 					     sizeof(wq_node), 1, NULL) == 0)
 		rte_pause();
 
@@ -134,23 +160,17 @@ __rte_graph_mcore_dispatch_sched_node_enqueue(struct rte_node *node,
 	return graph != NULL ? __graph_sched_node_enqueue(node, graph) : false;
 }
 
-RTE_EXPORT_SYMBOL(__rte_graph_mcore_dispatch_sched_wq_process)
-void
-__rte_graph_mcore_dispatch_sched_wq_process(struct rte_graph *graph)
-{
 #define WQ_SZ 32
+
+static __rte_always_inline void
+__graph_sched_wq_nodes_process(struct rte_graph *graph,
+			       struct graph_mcore_dispatch_wq_node **wq_nodes,
+			       unsigned int n, bool stolen)
+{
 	struct graph_mcore_dispatch_wq_node *wq_node;
-	struct rte_mempool *mp = graph->dispatch.mp;
-	struct rte_ring *wq = graph->dispatch.wq;
 	uint16_t idx, free_space;
 	struct rte_node *node;
-	unsigned int i, n;
-	struct graph_mcore_dispatch_wq_node *wq_nodes[WQ_SZ];
-
-	n = rte_ring_sc_dequeue_burst_elem(wq, wq_nodes, sizeof(wq_nodes[0]),
-					   RTE_DIM(wq_nodes), NULL);
-	if (n == 0)
-		return;
+	unsigned int i;
 
 	for (i = 0; i < n; i++) {
 		wq_node = wq_nodes[i];
@@ -164,14 +184,76 @@ __rte_graph_mcore_dispatch_sched_wq_process(struct rte_graph *graph)
 
 		memmove(&node->objs[idx], wq_node->objs, wq_node->nb_objs * sizeof(void *));
 		node->idx = idx + wq_node->nb_objs;
+		if (stolen)
+			node->dispatch.total_stolen_objs += wq_node->nb_objs;
 
 		__rte_node_process(graph, node);
 
 		wq_node->nb_objs = 0;
 		node->idx = 0;
 	}
+}
+
+/*
+ * Steal the pending streams of stealable nodes from the first graph with
+ * some. The graphs drain these streams at the beginning of each walk,
+ * streams still pending belong to a graph busy with its walk.
+ */
+static __rte_always_inline void
+__graph_sched_steal(struct rte_graph *graph)
+{
+	struct graph_mcore_dispatch_wq_node *wq_nodes[WQ_SZ];
+	struct rte_graph *peer;
+	unsigned int n;
+
+	SLIST_FOREACH(peer, graph->dispatch.rq, next) {
+		if (peer == graph || peer->dispatch.sq == NULL)
+			continue;
+
+		n = rte_ring_mc_dequeue_burst_elem(peer->dispatch.sq, wq_nodes,
+						   sizeof(wq_nodes[0]),
+						   RTE_DIM(wq_nodes), NULL);
+		if (n == 0)
+			continue;
+
+		__graph_sched_wq_nodes_process(graph, wq_nodes, n, true);
+		rte_mempool_put_bulk(peer->dispatch.mp, (void **)wq_nodes, n);
+		break;
+	}
+}
+
+RTE_EXPORT_SYMBOL(__rte_graph_mcore_dispatch_sched_wq_process)
+void
+__rte_graph_mcore_dispatch_sched_wq_process(struct rte_graph *graph)
+{
+	struct rte_mempool *mp = graph->dispatch.mp;
+	struct rte_ring *wq = graph->dispatch.wq;
+	struct graph_mcore_dispatch_wq_node *wq_nodes[WQ_SZ];
+	unsigned int n, nb_stealable = 0;
+
+	n = rte_ring_sc_dequeue_burst_elem(wq, wq_nodes, sizeof(wq_nodes[0]),
+					   RTE_DIM(wq_nodes), NULL);
+	if (n != 0) {
+		__graph_sched_wq_nodes_process(graph, wq_nodes, n, false);
+		rte_mempool_put_bulk(mp, (void **)wq_nodes, n);
+	}
 
-	rte_mempool_put_bulk(mp, (void **)wq_nodes, n);
+	if (graph->dispatch.sq == NULL)
+		return;
+
+	/* Other graphs may be stealing, hence the multi-consumer dequeue. */
+	nb_stealable = rte_ring_mc_dequeue_burst_elem(graph->dispatch.sq,
+						      wq_nodes, sizeof(wq_nodes[0]),
+						      RTE_DIM(wq_nodes), NULL);
+	if (nb_stealable != 0) {
+		__graph_sched_wq_nodes_process(graph, wq_nodes, nb_stealable,
+					       false);
+		rte_mempool_put_bulk(mp, (void **)wq_nodes, nb_stealable);
+	}
+
+	/* Nothing scheduled on this graph, help the others. */
+	if (n == 0 && nb_stealable == 0)
+		__graph_sched_steal(graph);
 }
 
 RTE_EXPORT_SYMBOL(rte_graph_model_mcore_dispatch_node_lcore_affinity_set)
@@ -198,3 +280,28 @@ rte_graph_model_mcore_dispatch_node_lcore_affinity_set(const char *name, unsigne
 
 	return ret;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_model_mcore_dispatch_node_steal_set, 26.11)
+int
+rte_graph_model_mcore_dispatch_node_steal_set(const char *name, bool stealable)
+{
+	struct node *node;
+	int ret = -EINVAL;
+
+	graph_spinlock_lock();
+
+	STAILQ_FOREACH(node, node_list_head_get(), next) {
+		if (strncmp(node->name, name, RTE_NODE_NAMESIZE) == 0) {
+			if (stealable)
+				node->flags |= RTE_NODE_STEALABLE_F;
+			else
+				node->flags &= ~RTE_NODE_STEALABLE_F;
+			ret = 0;
+			break;
+		}
+	}
+
+	graph_spinlock_unlock();
+
+	return ret;
+}
@@ -76,6 +76,33 @@ void __rte_graph_mcore_dispatch_sched_wq_process(struct rte_graph *graph);
 int rte_graph_model_mcore_dispatch_node_lcore_affinity_set(const char *name,
 							   unsigned int lcore_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set whether the streams of a node may be stolen, used for mcore dispatch
+ * model.
+ *
+ * The streams scheduled to the lcore of a stealable node may be processed
+ * by the graph of another lcore, when this graph has no stream scheduled.
+ * It must be set only for nodes keeping no state in their context,
+ * and applies to the graphs cloned after this call.
+ *
+ * @param name
+ *   Valid node name. In the case of the cloned node, the name will be
+ * "parent node name" + "-" + name.
+ * @param stealable
+ *   True to let idle lcores steal the streams of the node.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ *
+ * @see RTE_NODE_STEALABLE_F
+ */
+__rte_experimental
+int rte_graph_model_mcore_dispatch_node_steal_set(const char *name,
+						  bool stealable);
+
 /**
  * Perform graph walk on the circular buffer and invoke the process function
  * of the nodes and collect the stats.
@@ -5,6 +5,58 @@
 
 #include "rte_graph_worker_common.h"
 
+/**
+ * @internal
+ *
+ * Graph walk of rte_graph_walk_rtc() when some nodes have a minimum batch
+ * size, see rte_node_batch_coalesce_set().
+ *
+ * A pending stream holding fewer objects than the minimum batch of its node
+ * is skipped, until the maximum delay elapsed since it was first skipped.
+ * The skipped nodes are put back, in order, at the head of the next walk.
+ *
+ * @param graph
+ *   Graph pointer returned from rte_graph_lookup function.
+ */
+static __rte_noinline void
+__rte_graph_walk_rtc_coalesce(struct rte_graph *graph)
+{
+	const rte_graph_off_t *cir_start = graph->cir_start;
+	const rte_node_t mask = graph->cir_mask;
+	uint32_t head = graph->head;
+	rte_graph_off_t deferred = 0;
+	rte_graph_off_t *last = &deferred;
+	struct rte_node *node;
+	uint64_t now = 0;
+
+	while (likely(head != graph->tail)) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
+		head = likely((int32_t)head > 0) ? head & mask : head;
+		if (unlikely(node->idx < node->batch_min)) {
+			if (now == 0)
+				now = rte_rdtsc();
+			if (node->batch_start == 0)
+				node->batch_start = now;
+			if (now - node->batch_start < node->batch_delay) {
+				/* Node offsets are never 0, it ends the list. */
+				*last = node->off;
+				last = &node->batch_next;
+				continue;
+			}
+		}
+		node->batch_start = 0;
+		__rte_node_process(graph, node);
+	}
+	graph->tail = 0;
+
+	*last = 0;
+	while (deferred != 0) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, deferred);
+		__rte_node_enqueue_tail_update(graph, node);
+		deferred = node->batch_next;
+	}
+}
+
 /**
  * Perform graph walk on the circular buffer and invoke the process function
  * of the nodes and collect the stats.
@@ -22,6 +74,11 @@ rte_graph_walk_rtc(struct rte_graph *graph)
 	uint32_t head = graph->head;
 	struct rte_node *node;
 
+	if (unlikely(graph->coalesce)) {
+		__rte_graph_walk_rtc_coalesce(graph);
+		return;
+	}
+
 	/*
 	 * Walk on the source node(s) ((cir_start - head) -> cir_start) and then
 	 * on the pending streams (cir_start -> (cir_start + mask) -> cir_start)
@@ -16,6 +16,7 @@
 #include <stdalign.h>
 #include <stddef.h>
 
+#include <rte_bitops.h>
 #include <rte_common.h>
 #include <rte_cycles.h>
 #include <rte_prefetch.h>
@@ -56,7 +57,7 @@ struct __rte_cache_aligned rte_graph {
 	rte_graph_off_t *cir_start;  /**< Pointer to circular buffer. */
 	rte_graph_off_t nodes_start; /**< Offset at which node memory starts. */
 	uint8_t model;		     /**< graph model */
-	uint8_t reserved1;	     /**< Reserved for future use. */
+	uint8_t coalesce;	     /**< Nodes may defer under-filled streams. */
 	uint16_t reserved2;	     /**< Reserved for future use. */
 	union {
 		/* Fast schedule area for mcore dispatch model */
@@ -67,6 +68,7 @@ struct __rte_cache_aligned rte_graph {
 
 			unsigned int lcore_id;  /**< The graph running Lcore. */
 			struct rte_ring *wq;    /**< The work-queue for pending streams. */
+			struct rte_ring *sq;    /**< The work-queue for stealable streams. */
 			struct rte_mempool *mp; /**< The mempool for scheduling streams. */
 			packets_enqueued_cb notify_cb; /**< Callback when packet crosses lcores. */
 			uint64_t cb_priv;       /**< Opaque parameter for notify_cb. */
@@ -110,15 +112,24 @@ struct __rte_cache_aligned rte_node {
 	union {
 		alignas(RTE_CACHE_LINE_MIN_SIZE) struct {
 			unsigned int lcore_id;  /**< Node running lcore. */
+			bool stealable;         /**< Streams may be stolen by idle lcores. */
 			uint64_t total_sched_objs; /**< Number of objects scheduled. */
 			uint64_t total_sched_fail; /**< Number of scheduled failure. */
 			struct rte_graph *graph;  /**< Graph corresponding to lcore_id. */
+			uint64_t total_stolen_objs; /**< Number of objects stolen. */
 		} dispatch;
 	};
 
+	/** Number of calls per number of objects, see RTE_NODE_BATCH_HIST_SZ. */
+	alignas(RTE_CACHE_LINE_MIN_SIZE) uint64_t batch_hist[RTE_NODE_BATCH_HIST_SZ];
+
 	/** Fast path area cache line 1. */
 	alignas(RTE_CACHE_LINE_MIN_SIZE)
 	rte_graph_off_t xstat_off; /**< Offset to xstat counters. */
+	rte_graph_off_t batch_next; /**< Offset of the next deferred node. */
+	uint16_t batch_min;	/**< Minimum number of objects to process. */
+	uint64_t batch_delay;	/**< Maximum deferral, in TSC ticks. */
+	uint64_t batch_start;	/**< TSC of the first deferral, 0 if none. */
 
 	/** Fast path area cache line 2. */
 	__extension__ struct __rte_cache_aligned {
@@ -211,6 +222,8 @@ __rte_node_process(struct rte_graph *graph, struct rte_node *node)
 		node->total_cycles += rte_rdtsc() - start;
 		node->total_calls++;
 		node->total_objs += rc;
+		node->batch_hist[rc == 0 ? 0 :
+			RTE_MIN(rte_fls_u32(rc), RTE_NODE_BATCH_HIST_SZ - 1U)]++;
 	} else {
 		node->process(graph, node, objs, node->idx);
 	}
@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_ethdev.h>
+
+#include "gro_flow_hash.h"
+
+struct gro_flow_hash *
+gro_flow_hash_create(uint16_t socket_id,
+		uint32_t max_flow_num,
+		uint32_t max_item_num)
+{
+	struct gro_flow_hash *hash;
+	uint32_t bucket_num, i;
+
+	hash = rte_zmalloc_socket(__func__,
+			sizeof(struct gro_flow_hash),
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (hash == NULL)
+		return NULL;
+
+	/* Keep the buckets at most half full. */
+	bucket_num = rte_align32pow2(RTE_MAX(max_flow_num * 2 /
+				GRO_FLOW_HASH_BUCKET_ENTRIES, 1U));
+	hash->buckets = rte_zmalloc_socket(__func__,
+			sizeof(struct gro_flow_hash_bucket) * bucket_num,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	hash->free_flows = rte_malloc_socket(__func__,
+			sizeof(uint32_t) * max_flow_num,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	hash->free_items = rte_malloc_socket(__func__,
+			sizeof(uint32_t) * max_item_num,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (hash->buckets == NULL || hash->free_flows == NULL ||
+			hash->free_items == NULL) {
+		gro_flow_hash_destroy(hash);
+		return NULL;
+	}
+	hash->bucket_mask = bucket_num - 1;
+
+	/* Give out the lowest indexes first. */
+	for (i = 0; i < max_flow_num; i++)
+		hash->free_flows[i] = max_flow_num - 1 - i;
+	hash->nb_free_flows = max_flow_num;
+	for (i = 0; i < max_item_num; i++)
+		hash->free_items[i] = max_item_num - 1 - i;
+	hash->nb_free_items = max_item_num;
+
+	return hash;
+}
+
+void
+gro_flow_hash_destroy(struct gro_flow_hash *hash)
+{
+	if (hash) {
+		rte_free(hash->buckets);
+		rte_free(hash->free_flows);
+		rte_free(hash->free_items);
+	}
+	rte_free(hash);
+}
@@ -0,0 +1,293 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _GRO_FLOW_HASH_H_
+#define _GRO_FLOW_HASH_H_
+
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_hash_crc.h>
+#include <rte_prefetch.h>
+#include <rte_vect.h>
+
+#include "gro_tcp.h"
+
+/*
+ * Hash index of the flows of a GRO table. It is used by the tables of the
+ * heavyweight mode, which may hold thousands of flows, instead of scanning
+ * the whole flow array for each packet.
+ *
+ * A flow is stored in its primary bucket or, if it is full, in its
+ * secondary bucket. Each bucket keeps a 16-bit signature of its flows,
+ * which are compared at once with SIMD instructions, so that only the
+ * keys of the flows with a matching signature are compared.
+ */
+
+#define GRO_FLOW_HASH_BUCKET_ENTRIES 8
+
+/* Signature of an empty bucket entry */
+#define GRO_FLOW_HASH_SIG_EMPTY 0
+
+struct gro_flow_hash_bucket {
+	/* Flow signatures, GRO_FLOW_HASH_SIG_EMPTY for empty entries */
+	uint16_t sig[GRO_FLOW_HASH_BUCKET_ENTRIES];
+	/* Index of the flows in the flow array */
+	uint32_t flow_idx[GRO_FLOW_HASH_BUCKET_ENTRIES];
+} __rte_aligned(16);
+
+struct gro_flow_hash {
+	/* bucket array */
+	struct gro_flow_hash_bucket *buckets;
+	/* bucket number - 1, the bucket number is a power of 2 */
+	uint32_t bucket_mask;
+	/* number of free flow indexes in free_flows */
+	uint32_t nb_free_flows;
+	/* number of free item indexes in free_items */
+	uint32_t nb_free_items;
+	/* stack of free flow indexes */
+	uint32_t *free_flows;
+	/* stack of free item indexes */
+	uint32_t *free_items;
+};
+
+/**
+ * This function creates the hash index of a GRO table.
+ *
+ * @param socket_id
+ *  Socket index for allocating the hash index
+ * @param max_flow_num
+ *  The size of the flow array of the table
+ * @param max_item_num
+ *  The size of the item array of the table
+ *
+ * @return
+ *  - Return the hash index pointer on success.
+ *  - Return NULL on failure.
+ */
+struct gro_flow_hash *gro_flow_hash_create(uint16_t socket_id,
+		uint32_t max_flow_num,
+		uint32_t max_item_num);
+
+/**
+ * This function destroys the hash index of a GRO table.
+ *
+ * @param hash
+ *  Pointer pointing to the hash index
+ */
+void gro_flow_hash_destroy(struct gro_flow_hash *hash);
+
+static inline uint32_t
+gro_flow_hash_key(const void *key, uint32_t key_len)
+{
+	return rte_hash_crc(key, key_len, 0);
+}
+
+static inline uint16_t
+gro_flow_hash_sig(uint32_t h)
+{
+	uint16_t sig = h >> 16;
+
+	return sig == GRO_FLOW_HASH_SIG_EMPTY ? 1 : sig;
+}
+
+static inline struct gro_flow_hash_bucket *
+gro_flow_hash_prim_bucket(const struct gro_flow_hash *hash, uint32_t h)
+{
+	return &hash->buckets[h & hash->bucket_mask];
+}
+
+static inline struct gro_flow_hash_bucket *
+gro_flow_hash_sec_bucket(const struct gro_flow_hash *hash, uint32_t h)
+{
+	return &hash->buckets[(h ^ gro_flow_hash_sig(h)) & hash->bucket_mask];
+}
+
+/*
+ * Compare all signatures of a bucket. Bit (i << GRO_FLOW_HASH_HIT_SHIFT) of
+ * the returned mask is set if the signature of entry i matches.
+ */
+#if defined(RTE_ARCH_X86) && defined(__SSE2__)
+#define GRO_FLOW_HASH_HIT_SHIFT 1
+static inline uint32_t
+gro_flow_hash_match(const struct gro_flow_hash_bucket *bkt, uint16_t sig)
+{
+	/* Keep the first bit of the two bits of each signature */
+	return _mm_movemask_epi8(_mm_cmpeq_epi16(
+			_mm_load_si128((const __m128i *)bkt->sig),
+			_mm_set1_epi16(sig))) & 0x5555;
+}
+#elif defined(RTE_ARCH_ARM64) && defined(__ARM_NEON)
+#define GRO_FLOW_HASH_HIT_SHIFT 0
+static inline uint32_t
+gro_flow_hash_match(const struct gro_flow_hash_bucket *bkt, uint16_t sig)
+{
+	const uint16x8_t mask = {0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80};
+	uint16x8_t vmat;
+
+	vmat = vceqq_u16(vdupq_n_u16(sig), vld1q_u16(bkt->sig));
+	return vaddvq_u16(vandq_u16(vmat, mask));
+}
+#else
+#define GRO_FLOW_HASH_HIT_SHIFT 0
+static inline uint32_t
+gro_flow_hash_match(const struct gro_flow_hash_bucket *bkt, uint16_t sig)
+{
+	uint32_t i, hits = 0;
+
+	for (i = 0; i < GRO_FLOW_HASH_BUCKET_ENTRIES; i++)
+		hits |= (uint32_t)(bkt->sig[i] == sig) << i;
+	return hits;
+}
+#endif
+
+static inline uint32_t
+gro_flow_hash_bucket_lookup(const struct gro_flow_hash_bucket *bkt,
+		uint16_t sig,
+		const void *flows,
+		size_t flow_size,
+		const void *key,
+		size_t key_len)
+{
+	uint32_t hits, i, flow_idx;
+
+	hits = gro_flow_hash_match(bkt, sig);
+	while (hits != 0) {
+		i = rte_ctz32(hits) >> GRO_FLOW_HASH_HIT_SHIFT;
+		flow_idx = bkt->flow_idx[i];
+		/* The key is the first field of the flow structures. */
+		if (memcmp((const char *)flows + flow_idx * flow_size, key,
+					key_len) == 0)
+			return flow_idx;
+		hits &= ~(1U << (i << GRO_FLOW_HASH_HIT_SHIFT));
+	}
+
+	return INVALID_ARRAY_INDEX;
+}
+
+/*
+ * Find the flow whose key is equal to 'key', and return its index in the
+ * flow array, or INVALID_ARRAY_INDEX if there is no such flow.
+ */
+static inline uint32_t
+gro_flow_hash_lookup(const struct gro_flow_hash *hash,
+		uint32_t h,
+		const void *flows,
+		size_t flow_size,
+		const void *key,
+		size_t key_len)
+{
+	const struct gro_flow_hash_bucket *prim_bkt, *sec_bkt;
+	uint16_t sig = gro_flow_hash_sig(h);
+	uint32_t flow_idx;
+
+	prim_bkt = gro_flow_hash_prim_bucket(hash, h);
+	sec_bkt = gro_flow_hash_sec_bucket(hash, h);
+	rte_prefetch0(sec_bkt);
+
+	flow_idx = gro_flow_hash_bucket_lookup(prim_bkt, sig, flows, flow_size,
+			key, key_len);
+	if (flow_idx != INVALID_ARRAY_INDEX || sec_bkt == prim_bkt)
+		return flow_idx;
+
+	return gro_flow_hash_bucket_lookup(sec_bkt, sig, flows, flow_size,
+			key, key_len);
+}
+
+static inline int
+gro_flow_hash_bucket_add(struct gro_flow_hash_bucket *bkt,
+		uint16_t sig,
+		uint32_t flow_idx)
+{
+	uint32_t hits, i;
+
+	hits = gro_flow_hash_match(bkt, GRO_FLOW_HASH_SIG_EMPTY);
+	if (hits == 0)
+		return -1;
+
+	i = rte_ctz32(hits) >> GRO_FLOW_HASH_HIT_SHIFT;
+	bkt->sig[i] = sig;
+	bkt->flow_idx[i] = flow_idx;
+
+	return 0;
+}
+
+/*
+ * Add a flow to the hash index. Return 0 on success, or a negative value
+ * if both buckets of the flow are full.
+ */
+static inline int
+gro_flow_hash_add(struct gro_flow_hash *hash, uint32_t h, uint32_t flow_idx)
+{
+	uint16_t sig = gro_flow_hash_sig(h);
+
+	if (gro_flow_hash_bucket_add(gro_flow_hash_prim_bucket(hash, h), sig,
+				flow_idx) == 0)
+		return 0;
+
+	return gro_flow_hash_bucket_add(gro_flow_hash_sec_bucket(hash, h), sig,
+			flow_idx);
+}
+
+static inline int
+gro_flow_hash_bucket_del(struct gro_flow_hash_bucket *bkt,
+		uint16_t sig,
+		uint32_t flow_idx)
+{
+	uint32_t hits, i;
+
+	hits = gro_flow_hash_match(bkt, sig);
+	while (hits != 0) {
+		i = rte_ctz32(hits) >> GRO_FLOW_HASH_HIT_SHIFT;
+		if (bkt->flow_idx[i] == flow_idx) {
+			bkt->sig[i] = GRO_FLOW_HASH_SIG_EMPTY;
+			return 0;
+		}
+		hits &= ~(1U << (i << GRO_FLOW_HASH_HIT_SHIFT));
+	}
+
+	return -1;
+}
+
+/* Remove a flow, which has been added with the hash 'h', from the index. */
+static inline void
+gro_flow_hash_del(struct gro_flow_hash *hash, uint32_t h, uint32_t flow_idx)
+{
+	uint16_t sig = gro_flow_hash_sig(h);
+
+	if (gro_flow_hash_bucket_del(gro_flow_hash_prim_bucket(hash, h), sig,
+				flow_idx) != 0)
+		gro_flow_hash_bucket_del(gro_flow_hash_sec_bucket(hash, h),
+				sig, flow_idx);
+}
+
+static inline uint32_t
+gro_flow_hash_get_flow(struct gro_flow_hash *hash)
+{
+	if (unlikely(hash->nb_free_flows == 0))
+		return INVALID_ARRAY_INDEX;
+	return hash->free_flows[--hash->nb_free_flows];
+}
+
+static inline void
+gro_flow_hash_put_flow(struct gro_flow_hash *hash, uint32_t flow_idx)
+{
+	hash->free_flows[hash->nb_free_flows++] = flow_idx;
+}
+
+static inline uint32_t
+gro_flow_hash_get_item(struct gro_flow_hash *hash)
+{
+	if (unlikely(hash->nb_free_items == 0))
+		return INVALID_ARRAY_INDEX;
+	return hash->free_items[--hash->nb_free_items];
+}
+
+static inline void
+gro_flow_hash_put_item(struct gro_flow_hash *hash, uint32_t item_idx)
+{
+	hash->free_items[hash->nb_free_items++] = item_idx;
+}
+
+#endif
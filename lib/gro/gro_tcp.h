@@ -38,6 +38,9 @@ struct cmn_tcp_key {
 		k2->dst_port = k1->dst_port; \
 	} while (0)
 
+/* Hash index of the flows of a table, defined in gro_flow_hash.h */
+struct gro_flow_hash;
+
 struct gro_tcp_item {
 	/*
 	 * The first MBUF segment of the packet. If the value
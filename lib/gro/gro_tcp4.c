@@ -57,6 +57,12 @@ gro_tcp4_tbl_create(uint16_t socket_id,
 		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
 	tbl->max_flow_num = entries_num;
 
+	tbl->hash = gro_flow_hash_create(socket_id, entries_num, entries_num);
+	if (tbl->hash == NULL) {
+		gro_tcp4_tbl_destroy(tbl);
+		return NULL;
+	}
+
 	return tbl;
 }
 
@@ -68,6 +74,7 @@ gro_tcp4_tbl_destroy(void *tbl)
 	if (tcp_tbl) {
 		rte_free(tcp_tbl->items);
 		rte_free(tcp_tbl->flows);
+		gro_flow_hash_destroy(tcp_tbl->hash);
 	}
 	rte_free(tcp_tbl);
 }
@@ -78,6 +85,9 @@ find_an_empty_flow(struct gro_tcp4_tbl *tbl)
 	uint32_t i;
 	uint32_t max_flow_num = tbl->max_flow_num;
 
+	if (tbl->hash != NULL)
+		return gro_flow_hash_get_flow(tbl->hash);
+
 	for (i = 0; i < max_flow_num; i++)
 		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
 			return i;
@@ -87,6 +97,7 @@ find_an_empty_flow(struct gro_tcp4_tbl *tbl)
 static inline uint32_t
 insert_new_flow(struct gro_tcp4_tbl *tbl,
 		struct tcp4_flow_key *src,
+		uint32_t hash_value,
 		uint32_t item_idx)
 {
 	struct tcp4_flow_key *dst;
@@ -96,6 +107,12 @@ insert_new_flow(struct gro_tcp4_tbl *tbl,
 	if (unlikely(flow_idx == INVALID_ARRAY_INDEX))
 		return INVALID_ARRAY_INDEX;
 
+	if (tbl->hash != NULL &&
+			gro_flow_hash_add(tbl->hash, hash_value, flow_idx) < 0) {
+		gro_flow_hash_put_flow(tbl->hash, flow_idx);
+		return INVALID_ARRAY_INDEX;
+	}
+
 	dst = &(tbl->flows[flow_idx].key);
 
 	ASSIGN_COMMON_TCP_KEY((&src->cmn_key), (&dst->cmn_key));
@@ -109,6 +126,19 @@ insert_new_flow(struct gro_tcp4_tbl *tbl,
 	return flow_idx;
 }
 
+static inline void
+delete_flow(struct gro_tcp4_tbl *tbl, uint32_t flow_idx)
+{
+	tbl->flow_num--;
+	if (tbl->hash != NULL) {
+		gro_flow_hash_del(tbl->hash,
+				gro_flow_hash_key(&tbl->flows[flow_idx].key,
+					sizeof(struct tcp4_flow_key)),
+				flow_idx);
+		gro_flow_hash_put_flow(tbl->hash, flow_idx);
+	}
+}
+
 int32_t
 gro_tcp4_reassemble(struct rte_mbuf *pkt,
 		struct gro_tcp4_tbl *tbl,
@@ -125,6 +155,7 @@ gro_tcp4_reassemble(struct rte_mbuf *pkt,
 	struct tcp4_flow_key key;
 	uint32_t item_idx;
 	uint32_t i, max_flow_num, remaining_flow_num;
+	uint32_t hash_value = 0;
 	uint8_t find;
 	uint32_t item_start_idx;
 
@@ -174,17 +205,27 @@ gro_tcp4_reassemble(struct rte_mbuf *pkt,
 	ip_id = is_atomic ? 0 : rte_be_to_cpu_16(ipv4_hdr->packet_id);
 
 	/* Search for a matched flow. */
-	max_flow_num = tbl->max_flow_num;
-	remaining_flow_num = tbl->flow_num;
 	find = 0;
-	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
-		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
-			if (is_same_tcp4_flow(tbl->flows[i].key, key)) {
-				find = 1;
-				item_start_idx = tbl->flows[i].start_index;
-				break;
+	if (tbl->hash != NULL) {
+		hash_value = gro_flow_hash_key(&key, sizeof(key));
+		i = gro_flow_hash_lookup(tbl->hash, hash_value, tbl->flows,
+				sizeof(struct gro_tcp4_flow), &key, sizeof(key));
+		if (i != INVALID_ARRAY_INDEX) {
+			find = 1;
+			item_start_idx = tbl->flows[i].start_index;
+		}
+	} else {
+		max_flow_num = tbl->max_flow_num;
+		remaining_flow_num = tbl->flow_num;
+		for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
+			if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
+				if (is_same_tcp4_flow(tbl->flows[i].key, key)) {
+					find = 1;
+					item_start_idx = tbl->flows[i].start_index;
+					break;
+				}
+				remaining_flow_num--;
 			}
-			remaining_flow_num--;
 		}
 	}
 
@@ -200,7 +241,8 @@ gro_tcp4_reassemble(struct rte_mbuf *pkt,
 				tbl->items[item_start_idx].start_time = 0;
 			return process_tcp_item(pkt, tcp_hdr, tcp_dl, tbl->items,
 						tbl->flows[i].start_index, &tbl->item_num,
-						tbl->max_item_num, ip_id, is_atomic, start_time);
+						tbl->max_item_num, tbl->hash, ip_id, is_atomic,
+						start_time);
 		} else {
 			return -1;
 		}
@@ -212,18 +254,19 @@ gro_tcp4_reassemble(struct rte_mbuf *pkt,
 	if (tcp_hdr->tcp_flags == RTE_TCP_ACK_FLAG) {
 		sent_seq = rte_be_to_cpu_32(tcp_hdr->sent_seq);
 		item_idx = insert_new_tcp_item(pkt, tbl->items, &tbl->item_num,
-						tbl->max_item_num, start_time,
+						tbl->max_item_num, tbl->hash, start_time,
 						INVALID_ARRAY_INDEX, sent_seq, ip_id,
 						is_atomic);
 		if (item_idx == INVALID_ARRAY_INDEX)
 			return -1;
-		if (insert_new_flow(tbl, &key, item_idx) ==
+		if (insert_new_flow(tbl, &key, hash_value, item_idx) ==
 			INVALID_ARRAY_INDEX) {
 			/*
 			 * Fail to insert a new flow, so delete the
 			 * stored packet.
 			*/
-			delete_tcp_item(tbl->items, item_idx, &tbl->item_num, INVALID_ARRAY_INDEX);
+			delete_tcp_item(tbl->items, item_idx, &tbl->item_num,
+					tbl->hash, INVALID_ARRAY_INDEX);
 			return -1;
 		}
 		return 0;
@@ -256,12 +299,14 @@ gro_tcp4_tbl_timeout_flush(struct gro_tcp4_tbl *tbl,
 	uint16_t k = 0;
 	uint32_t i, j;
 	uint32_t max_flow_num = tbl->max_flow_num;
+	uint32_t remaining_flow_num = tbl->flow_num;
 
-	for (i = 0; i < max_flow_num; i++) {
-		if (unlikely(tbl->flow_num == 0))
-			return k;
-
+	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
 		j = tbl->flows[i].start_index;
+		if (j == INVALID_ARRAY_INDEX)
+			continue;
+		remaining_flow_num--;
+
 		while (j != INVALID_ARRAY_INDEX) {
 			if (tbl->items[j].start_time <= flush_timestamp) {
 				out[k++] = tbl->items[j].firstseg;
@@ -272,10 +317,11 @@ gro_tcp4_tbl_timeout_flush(struct gro_tcp4_tbl *tbl,
 				 * packet in the flow.
 				 */
 				j = delete_tcp_item(tbl->items, j,
-							&tbl->item_num, INVALID_ARRAY_INDEX);
+							&tbl->item_num, tbl->hash,
+							INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
 				if (j == INVALID_ARRAY_INDEX)
-					tbl->flow_num--;
+					delete_flow(tbl, i);
 
 				if (unlikely(k == nb_out))
 					return k;
@@ -41,6 +41,8 @@ struct gro_tcp4_tbl {
 	uint32_t max_item_num;
 	/* flow array size */
 	uint32_t max_flow_num;
+	/* hash index of the flows, NULL to scan the flow array */
+	struct gro_flow_hash *hash;
 };
 
 /**
@@ -5,6 +5,8 @@
 #ifndef _GRO_TCP_INTERNAL_H_
 #define _GRO_TCP_INTERNAL_H_
 
+#include "gro_flow_hash.h"
+
 static inline uint32_t
 find_an_empty_item(struct gro_tcp_item *items,
 	uint32_t max_item_num)
@@ -22,6 +24,7 @@ insert_new_tcp_item(struct rte_mbuf *pkt,
 		struct gro_tcp_item *items,
 		uint32_t *item_num,
 		uint32_t max_item_num,
+		struct gro_flow_hash *hash,
 		uint64_t start_time,
 		uint32_t prev_idx,
 		uint32_t sent_seq,
@@ -30,7 +33,10 @@ insert_new_tcp_item(struct rte_mbuf *pkt,
 {
 	uint32_t item_idx;
 
-	item_idx = find_an_empty_item(items, max_item_num);
+	if (hash != NULL)
+		item_idx = gro_flow_hash_get_item(hash);
+	else
+		item_idx = find_an_empty_item(items, max_item_num);
 	if (item_idx == INVALID_ARRAY_INDEX)
 		return INVALID_ARRAY_INDEX;
 
@@ -57,6 +63,7 @@ insert_new_tcp_item(struct rte_mbuf *pkt,
 static inline uint32_t
 delete_tcp_item(struct gro_tcp_item *items, uint32_t item_idx,
 		uint32_t *item_num,
+		struct gro_flow_hash *hash,
 		uint32_t prev_item_idx)
 {
 	uint32_t next_idx = items[item_idx].next_pkt_idx;
@@ -64,6 +71,8 @@ delete_tcp_item(struct gro_tcp_item *items, uint32_t item_idx,
 	/* NULL indicates an empty item */
 	items[item_idx].firstseg = NULL;
 	(*item_num) -= 1;
+	if (hash != NULL)
+		gro_flow_hash_put_item(hash, item_idx);
 	if (prev_item_idx != INVALID_ARRAY_INDEX)
 		items[prev_item_idx].next_pkt_idx = next_idx;
 
@@ -78,6 +87,7 @@ process_tcp_item(struct rte_mbuf *pkt,
 	uint32_t item_idx,
 	uint32_t *item_num,
 	uint32_t max_item_num,
+	struct gro_flow_hash *hash,
 	uint16_t ip_id,
 	uint8_t is_atomic,
 	uint64_t start_time)
@@ -108,7 +118,8 @@ process_tcp_item(struct rte_mbuf *pkt,
 			 * the packet into the flow.
 			 */
 			if (insert_new_tcp_item(pkt, items, item_num, max_item_num,
-						start_time, cur_idx, sent_seq, ip_id, is_atomic) ==
+						hash, start_time, cur_idx, sent_seq, ip_id,
+						is_atomic) ==
 					INVALID_ARRAY_INDEX)
 				return -1;
 			return 0;
@@ -118,8 +129,8 @@ process_tcp_item(struct rte_mbuf *pkt,
 	} while (cur_idx != INVALID_ARRAY_INDEX);
 
 	/* Fail to find a neighbor, so store the packet into the flow. */
-	if (insert_new_tcp_item(pkt, items, item_num, max_item_num, start_time, prev_idx, sent_seq,
-				ip_id, is_atomic) == INVALID_ARRAY_INDEX)
+	if (insert_new_tcp_item(pkt, items, item_num, max_item_num, hash, start_time, prev_idx,
+				sent_seq, ip_id, is_atomic) == INVALID_ARRAY_INDEX)
 		return -1;
 
 	return 0;
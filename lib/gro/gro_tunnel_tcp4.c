@@ -0,0 +1,604 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_ethdev.h>
+#include <rte_geneve.h>
+#include <rte_gre.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "gro_tunnel_tcp4.h"
+
+void *
+gro_tunnel_tcp4_tbl_create(uint16_t socket_id,
+		uint16_t max_flow_num,
+		uint16_t max_item_per_flow)
+{
+	struct gro_tunnel_tcp4_tbl *tbl;
+	size_t size;
+	uint32_t entries_num, i;
+
+	entries_num = max_flow_num * max_item_per_flow;
+	entries_num = RTE_MIN(entries_num, GRO_TUNNEL_TCP4_TBL_MAX_ITEM_NUM);
+
+	if (entries_num == 0)
+		return NULL;
+
+	tbl = rte_zmalloc_socket(__func__,
+			sizeof(struct gro_tunnel_tcp4_tbl),
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (tbl == NULL)
+		return NULL;
+
+	size = sizeof(struct gro_tunnel_tcp4_item) * entries_num;
+	tbl->items = rte_zmalloc_socket(__func__,
+			size,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (tbl->items == NULL) {
+		rte_free(tbl);
+		return NULL;
+	}
+	tbl->max_item_num = entries_num;
+
+	size = sizeof(struct gro_tunnel_tcp4_flow) * entries_num;
+	tbl->flows = rte_zmalloc_socket(__func__,
+			size,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (tbl->flows == NULL) {
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+
+	for (i = 0; i < entries_num; i++)
+		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
+	tbl->max_flow_num = entries_num;
+
+	return tbl;
+}
+
+void
+gro_tunnel_tcp4_tbl_destroy(void *tbl)
+{
+	struct gro_tunnel_tcp4_tbl *tunnel_tbl = tbl;
+
+	if (tunnel_tbl) {
+		rte_free(tunnel_tbl->items);
+		rte_free(tunnel_tbl->flows);
+	}
+	rte_free(tunnel_tbl);
+}
+
+static inline uint32_t
+find_an_empty_item(struct gro_tunnel_tcp4_tbl *tbl)
+{
+	uint32_t max_item_num = tbl->max_item_num, i;
+
+	for (i = 0; i < max_item_num; i++)
+		if (tbl->items[i].inner_item.firstseg == NULL)
+			return i;
+	return INVALID_ARRAY_INDEX;
+}
+
+static inline uint32_t
+find_an_empty_flow(struct gro_tunnel_tcp4_tbl *tbl)
+{
+	uint32_t max_flow_num = tbl->max_flow_num, i;
+
+	for (i = 0; i < max_flow_num; i++)
+		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
+			return i;
+	return INVALID_ARRAY_INDEX;
+}
+
+static inline uint32_t
+insert_new_item(struct gro_tunnel_tcp4_tbl *tbl,
+		struct rte_mbuf *pkt,
+		uint64_t start_time,
+		uint32_t prev_idx,
+		uint32_t sent_seq,
+		uint16_t outer_ip_id,
+		uint16_t ip_id,
+		uint8_t outer_is_atomic,
+		uint8_t is_atomic)
+{
+	uint32_t item_idx;
+
+	item_idx = find_an_empty_item(tbl);
+	if (unlikely(item_idx == INVALID_ARRAY_INDEX))
+		return INVALID_ARRAY_INDEX;
+
+	tbl->items[item_idx].inner_item.firstseg = pkt;
+	tbl->items[item_idx].inner_item.lastseg = rte_pktmbuf_lastseg(pkt);
+	tbl->items[item_idx].inner_item.start_time = start_time;
+	tbl->items[item_idx].inner_item.next_pkt_idx = INVALID_ARRAY_INDEX;
+	tbl->items[item_idx].inner_item.sent_seq = sent_seq;
+	tbl->items[item_idx].inner_item.l3.ip_id = ip_id;
+	tbl->items[item_idx].inner_item.nb_merged = 1;
+	tbl->items[item_idx].inner_item.is_atomic = is_atomic;
+	tbl->items[item_idx].outer_ip_id = outer_ip_id;
+	tbl->items[item_idx].outer_is_atomic = outer_is_atomic;
+	tbl->item_num++;
+
+	/* If the previous packet exists, chain the new one with it. */
+	if (prev_idx != INVALID_ARRAY_INDEX) {
+		tbl->items[item_idx].inner_item.next_pkt_idx =
+			tbl->items[prev_idx].inner_item.next_pkt_idx;
+		tbl->items[prev_idx].inner_item.next_pkt_idx = item_idx;
+	}
+
+	return item_idx;
+}
+
+static inline uint32_t
+delete_item(struct gro_tunnel_tcp4_tbl *tbl,
+		uint32_t item_idx,
+		uint32_t prev_item_idx)
+{
+	uint32_t next_idx = tbl->items[item_idx].inner_item.next_pkt_idx;
+
+	/* NULL indicates an empty item. */
+	tbl->items[item_idx].inner_item.firstseg = NULL;
+	tbl->item_num--;
+	if (prev_item_idx != INVALID_ARRAY_INDEX)
+		tbl->items[prev_item_idx].inner_item.next_pkt_idx = next_idx;
+
+	return next_idx;
+}
+
+static inline uint32_t
+insert_new_flow(struct gro_tunnel_tcp4_tbl *tbl,
+		struct tunnel_tcp4_flow_key *src,
+		uint32_t item_idx)
+{
+	uint32_t flow_idx;
+
+	flow_idx = find_an_empty_flow(tbl);
+	if (unlikely(flow_idx == INVALID_ARRAY_INDEX))
+		return INVALID_ARRAY_INDEX;
+
+	memcpy(&tbl->flows[flow_idx].key, src, sizeof(*src));
+
+	tbl->flows[flow_idx].start_index = item_idx;
+	tbl->flow_num++;
+
+	return flow_idx;
+}
+
+static inline int
+is_same_tunnel_tcp4_flow(const struct tunnel_tcp4_flow_key *k1,
+		const struct tunnel_tcp4_flow_key *k2)
+{
+	return !memcmp(k1, k2, sizeof(struct tunnel_tcp4_flow_key));
+}
+
+/*
+ * Parse the tunnel header, which starts after the outer L3 header, into
+ * the flow key. Return the tunnel header length, including the outer UDP
+ * header, or a negative value if the packet can't be merged.
+ */
+static inline int
+parse_tunnel_header(struct rte_mbuf *pkt,
+		char *tunnel_hdr,
+		enum gro_tunnel_type tunnel_type,
+		struct tunnel_tcp4_flow_key *key)
+{
+	struct rte_udp_hdr *udp_hdr;
+	struct rte_vxlan_hdr *vxlan_hdr;
+	struct rte_geneve_hdr *geneve_hdr;
+	struct rte_gre_hdr *gre_hdr;
+	struct rte_ether_hdr *eth_hdr;
+	uint16_t hdr_len;
+
+	switch (tunnel_type) {
+	case GRO_TUNNEL_IPV4_GENEVE:
+		udp_hdr = (struct rte_udp_hdr *)tunnel_hdr;
+		geneve_hdr = (struct rte_geneve_hdr *)(udp_hdr + 1);
+		/* Control packets are delivered as is. */
+		if (geneve_hdr->ver != 0 || geneve_hdr->oam ||
+				rte_be_to_cpu_16(geneve_hdr->proto) !=
+				RTE_GENEVE_TYPE_ETH)
+			return -1;
+		hdr_len = sizeof(struct rte_udp_hdr) +
+			sizeof(struct rte_geneve_hdr) + geneve_hdr->opt_len * 4;
+		memcpy(&key->tunnel_flags, geneve_hdr, sizeof(uint32_t));
+		memcpy(&key->tunnel_id, geneve_hdr->vni,
+				sizeof(geneve_hdr->vni));
+		key->outer_src_port = udp_hdr->src_port;
+		key->outer_dst_port = udp_hdr->dst_port;
+		break;
+	case GRO_TUNNEL_IPV4_GRE:
+		gre_hdr = (struct rte_gre_hdr *)tunnel_hdr;
+		/*
+		 * The checksum and sequence number differ in each packet,
+		 * so such packets are delivered as is.
+		 */
+		if (gre_hdr->c || gre_hdr->s || gre_hdr->ver != 0)
+			return -1;
+		hdr_len = sizeof(struct rte_gre_hdr);
+		if (gre_hdr->k) {
+			memcpy(&key->tunnel_id, gre_hdr + 1, sizeof(uint32_t));
+			hdr_len += sizeof(struct rte_gre_hdr_opt_key);
+		}
+		memcpy(&key->tunnel_flags, gre_hdr, sizeof(uint32_t));
+		/* GRE may carry the inner IPv4 packet without L2 header. */
+		if (gre_hdr->proto == RTE_BE16(RTE_ETHER_TYPE_IPV4)) {
+			if (pkt->l2_len != hdr_len)
+				return -1;
+			return hdr_len;
+		} else if (gre_hdr->proto != RTE_BE16(RTE_ETHER_TYPE_TEB))
+			return -1;
+		break;
+	case GRO_TUNNEL_IPV6_VXLAN:
+		udp_hdr = (struct rte_udp_hdr *)tunnel_hdr;
+		vxlan_hdr = (struct rte_vxlan_hdr *)(udp_hdr + 1);
+		hdr_len = sizeof(struct rte_udp_hdr) +
+			sizeof(struct rte_vxlan_hdr);
+		key->tunnel_flags = vxlan_hdr->vx_flags;
+		key->tunnel_id = vxlan_hdr->vx_vni;
+		key->outer_src_port = udp_hdr->src_port;
+		key->outer_dst_port = udp_hdr->dst_port;
+		break;
+	default:
+		return -1;
+	}
+
+	if (unlikely(pkt->l2_len < hdr_len + sizeof(struct rte_ether_hdr)))
+		return -1;
+
+	eth_hdr = (struct rte_ether_hdr *)(tunnel_hdr + hdr_len);
+	rte_ether_addr_copy(&(eth_hdr->src_addr),
+			&(key->inner_key.cmn_key.eth_saddr));
+	rte_ether_addr_copy(&(eth_hdr->dst_addr),
+			&(key->inner_key.cmn_key.eth_daddr));
+
+	return hdr_len;
+}
+
+static inline int
+check_tunnel_seq_option(struct gro_tunnel_tcp4_item *item,
+		struct rte_tcp_hdr *tcp_hdr,
+		const char *geneve_opts,
+		uint16_t geneve_opts_len,
+		uint32_t sent_seq,
+		uint16_t outer_ip_id,
+		uint16_t ip_id,
+		uint16_t tcp_hl,
+		uint16_t tcp_dl,
+		uint8_t outer_is_atomic,
+		uint8_t is_atomic)
+{
+	struct rte_mbuf *pkt = item->inner_item.firstseg;
+	int cmp;
+	uint16_t l2_offset;
+
+	/* Don't merge packets whose outer DF bits are different. */
+	if (unlikely(item->outer_is_atomic ^ outer_is_atomic))
+		return 0;
+
+	l2_offset = pkt->outer_l2_len + pkt->outer_l3_len;
+
+	/* Don't merge packets whose GENEVE options are different. */
+	if (geneve_opts_len > 0 && memcmp(geneve_opts,
+				rte_pktmbuf_mtod_offset(pkt, char *, l2_offset +
+					sizeof(struct rte_udp_hdr) +
+					sizeof(struct rte_geneve_hdr)),
+				geneve_opts_len) != 0)
+		return 0;
+
+	cmp = check_seq_option(&item->inner_item, tcp_hdr, sent_seq, ip_id,
+			tcp_hl, tcp_dl, l2_offset, is_atomic);
+	if ((cmp > 0) && (outer_is_atomic ||
+				(outer_ip_id == item->outer_ip_id + 1)))
+		/* Append the new packet. */
+		return 1;
+	else if ((cmp < 0) && (outer_is_atomic ||
+				(outer_ip_id + item->inner_item.nb_merged ==
+				 item->outer_ip_id)))
+		/* Prepend the new packet. */
+		return -1;
+
+	return 0;
+}
+
+static inline int
+merge_two_tunnel_tcp4_packets(struct gro_tunnel_tcp4_item *item,
+		struct rte_mbuf *pkt,
+		int cmp,
+		uint32_t sent_seq,
+		uint8_t tcp_flags,
+		uint16_t outer_ip_id,
+		uint16_t ip_id)
+{
+	if (merge_two_tcp_packets(&item->inner_item, pkt, cmp, sent_seq, tcp_flags,
+				ip_id, pkt->outer_l2_len +
+				pkt->outer_l3_len)) {
+		/* Update the outer IPv4 ID to the large value. */
+		item->outer_ip_id = cmp > 0 ? outer_ip_id : item->outer_ip_id;
+		return 1;
+	}
+
+	return 0;
+}
+
+static inline void
+update_tunnel_header(struct gro_tunnel_tcp4_item *item,
+		enum gro_tunnel_type tunnel_type)
+{
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_ipv6_hdr *ipv6_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	struct rte_mbuf *pkt = item->inner_item.firstseg;
+	char *l3_hdr;
+	uint16_t len;
+
+	/* Update the outer IP header. */
+	len = pkt->pkt_len - pkt->outer_l2_len;
+	l3_hdr = rte_pktmbuf_mtod_offset(pkt, char *, pkt->outer_l2_len);
+	if (tunnel_type == GRO_TUNNEL_IPV6_VXLAN) {
+		ipv6_hdr = (struct rte_ipv6_hdr *)l3_hdr;
+		ipv6_hdr->payload_len = rte_cpu_to_be_16(len -
+				sizeof(struct rte_ipv6_hdr));
+	} else {
+		ipv4_hdr = (struct rte_ipv4_hdr *)l3_hdr;
+		ipv4_hdr->total_length = rte_cpu_to_be_16(len);
+	}
+
+	/* Update the outer UDP header. GRE has no length field. */
+	len -= pkt->outer_l3_len;
+	l3_hdr += pkt->outer_l3_len;
+	if (tunnel_type != GRO_TUNNEL_IPV4_GRE) {
+		udp_hdr = (struct rte_udp_hdr *)l3_hdr;
+		udp_hdr->dgram_len = rte_cpu_to_be_16(len);
+	}
+
+	/* Update the inner IPv4 header. */
+	len -= pkt->l2_len;
+	ipv4_hdr = (struct rte_ipv4_hdr *)(l3_hdr + pkt->l2_len);
+	ipv4_hdr->total_length = rte_cpu_to_be_16(len);
+}
+
+int32_t
+gro_tunnel_tcp4_reassemble(struct rte_mbuf *pkt,
+		struct gro_tunnel_tcp4_tbl *tbl,
+		enum gro_tunnel_type tunnel_type,
+		uint64_t start_time)
+{
+	struct rte_ether_hdr *outer_eth_hdr;
+	struct rte_ipv4_hdr *outer_ipv4_hdr, *ipv4_hdr;
+	struct rte_ipv6_hdr *outer_ipv6_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+	char *tunnel_hdr, *geneve_opts;
+	uint32_t sent_seq;
+	int32_t tcp_dl;
+	uint16_t frag_off, outer_ip_id, ip_id, geneve_opts_len;
+	uint8_t outer_is_atomic, is_atomic;
+
+	struct tunnel_tcp4_flow_key key;
+	uint32_t cur_idx, prev_idx, item_idx;
+	uint32_t i, max_flow_num, remaining_flow_num;
+	int cmp, tunnel_hlen;
+	uint16_t hdr_len;
+	uint8_t find;
+
+	/*
+	 * Don't process the packet whose TCP header length is greater
+	 * than 60 bytes or less than 20 bytes.
+	 */
+	if (unlikely(INVALID_TCP_HDRLEN(pkt->l4_len)))
+		return -1;
+
+	outer_eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
+	tunnel_hdr = (char *)outer_eth_hdr + pkt->outer_l2_len +
+		pkt->outer_l3_len;
+	ipv4_hdr = (struct rte_ipv4_hdr *)(tunnel_hdr + pkt->l2_len);
+	tcp_hdr = (struct rte_tcp_hdr *)((char *)ipv4_hdr + pkt->l3_len);
+
+	/*
+	 * Don't process the packet which has FIN, SYN, RST, PSH, URG,
+	 * ECE or CWR set.
+	 */
+	if (tcp_hdr->tcp_flags != RTE_TCP_ACK_FLAG)
+		return -1;
+
+	hdr_len = pkt->outer_l2_len + pkt->outer_l3_len + pkt->l2_len +
+		pkt->l3_len + pkt->l4_len;
+	/*
+	 * Don't process the packet whose payload length is less than or
+	 * equal to 0.
+	 */
+	tcp_dl = pkt->pkt_len - hdr_len;
+	if (tcp_dl <= 0)
+		return -1;
+
+	memset(&key, 0, sizeof(key));
+	key.tunnel_type = tunnel_type;
+	key.l2_len = pkt->l2_len;
+	tunnel_hlen = parse_tunnel_header(pkt, tunnel_hdr, tunnel_type, &key);
+	if (tunnel_hlen < 0)
+		return -1;
+
+	geneve_opts_len = 0;
+	geneve_opts = NULL;
+	if (tunnel_type == GRO_TUNNEL_IPV4_GENEVE) {
+		geneve_opts = tunnel_hdr + sizeof(struct rte_udp_hdr) +
+			sizeof(struct rte_geneve_hdr);
+		geneve_opts_len = tunnel_hdr + tunnel_hlen - geneve_opts;
+	}
+
+	/*
+	 * Save IPv4 ID for the packet whose DF bit is 0. For the packet
+	 * whose DF bit is 1, IPv4 ID is ignored. There is no ID in the
+	 * outer IPv6 header, which is always considered atomic.
+	 */
+	if (tunnel_type == GRO_TUNNEL_IPV6_VXLAN) {
+		outer_ipv6_hdr = (struct rte_ipv6_hdr *)((char *)outer_eth_hdr +
+				pkt->outer_l2_len);
+		key.outer_ip_src_addr = outer_ipv6_hdr->src_addr;
+		key.outer_ip_dst_addr = outer_ipv6_hdr->dst_addr;
+		key.outer_vtc_flow = outer_ipv6_hdr->vtc_flow;
+		outer_is_atomic = 1;
+		outer_ip_id = 0;
+	} else {
+		outer_ipv4_hdr = (struct rte_ipv4_hdr *)((char *)outer_eth_hdr +
+				pkt->outer_l2_len);
+		memcpy(&key.outer_ip_src_addr, &outer_ipv4_hdr->src_addr,
+				sizeof(outer_ipv4_hdr->src_addr));
+		memcpy(&key.outer_ip_dst_addr, &outer_ipv4_hdr->dst_addr,
+				sizeof(outer_ipv4_hdr->dst_addr));
+		frag_off = rte_be_to_cpu_16(outer_ipv4_hdr->fragment_offset);
+		outer_is_atomic =
+			(frag_off & RTE_IPV4_HDR_DF_FLAG) == RTE_IPV4_HDR_DF_FLAG;
+		outer_ip_id = outer_is_atomic ? 0 :
+			rte_be_to_cpu_16(outer_ipv4_hdr->packet_id);
+	}
+	frag_off = rte_be_to_cpu_16(ipv4_hdr->fragment_offset);
+	is_atomic = (frag_off & RTE_IPV4_HDR_DF_FLAG) == RTE_IPV4_HDR_DF_FLAG;
+	ip_id = is_atomic ? 0 : rte_be_to_cpu_16(ipv4_hdr->packet_id);
+
+	sent_seq = rte_be_to_cpu_32(tcp_hdr->sent_seq);
+
+	key.inner_key.ip_src_addr = ipv4_hdr->src_addr;
+	key.inner_key.ip_dst_addr = ipv4_hdr->dst_addr;
+	key.inner_key.cmn_key.recv_ack = tcp_hdr->recv_ack;
+	key.inner_key.cmn_key.src_port = tcp_hdr->src_port;
+	key.inner_key.cmn_key.dst_port = tcp_hdr->dst_port;
+
+	rte_ether_addr_copy(&(outer_eth_hdr->src_addr), &(key.outer_eth_saddr));
+	rte_ether_addr_copy(&(outer_eth_hdr->dst_addr), &(key.outer_eth_daddr));
+
+	/* Search for a matched flow. */
+	max_flow_num = tbl->max_flow_num;
+	remaining_flow_num = tbl->flow_num;
+	find = 0;
+	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
+		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
+			if (is_same_tunnel_tcp4_flow(&tbl->flows[i].key, &key)) {
+				find = 1;
+				break;
+			}
+			remaining_flow_num--;
+		}
+	}
+
+	/*
+	 * Can't find a matched flow. Insert a new flow and store the
+	 * packet into the flow.
+	 */
+	if (find == 0) {
+		item_idx = insert_new_item(tbl, pkt, start_time,
+				INVALID_ARRAY_INDEX, sent_seq, outer_ip_id,
+				ip_id, outer_is_atomic, is_atomic);
+		if (item_idx == INVALID_ARRAY_INDEX)
+			return -1;
+		if (insert_new_flow(tbl, &key, item_idx) ==
+				INVALID_ARRAY_INDEX) {
+			/*
+			 * Fail to insert a new flow, so
+			 * delete the inserted packet.
+			 */
+			delete_item(tbl, item_idx, INVALID_ARRAY_INDEX);
+			return -1;
+		}
+		return 0;
+	}
+
+	/* Check all packets in the flow and try to find a neighbor. */
+	cur_idx = tbl->flows[i].start_index;
+	prev_idx = cur_idx;
+	do {
+		cmp = check_tunnel_seq_option(&(tbl->items[cur_idx]), tcp_hdr,
+				geneve_opts, geneve_opts_len, sent_seq,
+				outer_ip_id, ip_id, pkt->l4_len, tcp_dl,
+				outer_is_atomic, is_atomic);
+		if (cmp) {
+			if (merge_two_tunnel_tcp4_packets(&(tbl->items[cur_idx]),
+						pkt, cmp, sent_seq, tcp_hdr->tcp_flags,
+						outer_ip_id, ip_id))
+				return 1;
+			/*
+			 * Can't merge two packets, as the packet
+			 * length will be greater than the max value.
+			 * Insert the packet into the flow.
+			 */
+			if (insert_new_item(tbl, pkt, start_time, prev_idx,
+						sent_seq, outer_ip_id,
+						ip_id, outer_is_atomic,
+						is_atomic) ==
+					INVALID_ARRAY_INDEX)
+				return -1;
+			return 0;
+		}
+		prev_idx = cur_idx;
+		cur_idx = tbl->items[cur_idx].inner_item.next_pkt_idx;
+	} while (cur_idx != INVALID_ARRAY_INDEX);
+
+	/* Can't find neighbor. Insert the packet into the flow. */
+	if (insert_new_item(tbl, pkt, start_time, prev_idx, sent_seq,
+				outer_ip_id, ip_id, outer_is_atomic,
+				is_atomic) == INVALID_ARRAY_INDEX)
+		return -1;
+
+	return 0;
+}
+
+uint16_t
+gro_tunnel_tcp4_tbl_timeout_flush(struct gro_tunnel_tcp4_tbl *tbl,
+		uint64_t flush_timestamp,
+		struct rte_mbuf **out,
+		uint16_t nb_out)
+{
+	uint16_t k = 0;
+	uint32_t i, j;
+	uint32_t max_flow_num = tbl->max_flow_num;
+
+	for (i = 0; i < max_flow_num; i++) {
+		if (unlikely(tbl->flow_num == 0))
+			return k;
+
+		j = tbl->flows[i].start_index;
+		while (j != INVALID_ARRAY_INDEX) {
+			if (tbl->items[j].inner_item.start_time <=
+					flush_timestamp) {
+				out[k++] = tbl->items[j].inner_item.firstseg;
+				if (tbl->items[j].inner_item.nb_merged > 1)
+					update_tunnel_header(&(tbl->items[j]),
+						tbl->flows[i].key.tunnel_type);
+				/*
+				 * Delete the item and get the next packet
+				 * index.
+				 */
+				j = delete_item(tbl, j, INVALID_ARRAY_INDEX);
+				tbl->flows[i].start_index = j;
+				if (j == INVALID_ARRAY_INDEX)
+					tbl->flow_num--;
+
+				if (unlikely(k == nb_out))
+					return k;
+			} else
+				/*
+				 * The left packets in the flow won't be
+				 * timeout. Go to check other flows.
+				 */
+				break;
+		}
+	}
+	return k;
+}
+
+uint32_t
+gro_tunnel_tcp4_tbl_pkt_count(void *tbl)
+{
+	struct gro_tunnel_tcp4_tbl *gro_tbl = tbl;
+
+	if (gro_tbl)
+		return gro_tbl->item_num;
+
+	return 0;
+}
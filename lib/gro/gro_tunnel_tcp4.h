@@ -0,0 +1,186 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _GRO_TUNNEL_TCP4_H_
+#define _GRO_TUNNEL_TCP4_H_
+
+#include <rte_ip6.h>
+
+#include "gro_tcp4.h"
+
+#define GRO_TUNNEL_TCP4_TBL_MAX_ITEM_NUM (1024UL * 1024UL)
+
+/* Tunnels whose inner TCP/IPv4 packets are merged by the tunnel table */
+enum gro_tunnel_type {
+	/* GENEVE with an outer IPv4 header */
+	GRO_TUNNEL_IPV4_GENEVE,
+	/* GRE and NVGRE with an outer IPv4 header */
+	GRO_TUNNEL_IPV4_GRE,
+	/* VxLAN with an outer IPv6 header */
+	GRO_TUNNEL_IPV6_VXLAN,
+};
+
+/*
+ * Header fields representing a tunnel flow. The structure has no
+ * padding, so that keys can be compared with memcmp().
+ */
+struct tunnel_tcp4_flow_key {
+	struct tcp4_flow_key inner_key;
+
+	struct rte_ether_addr outer_eth_saddr;
+	struct rte_ether_addr outer_eth_daddr;
+
+	/* Outer IP addresses, an IPv4 address uses the first 4 bytes */
+	struct rte_ipv6_addr outer_ip_src_addr;
+	struct rte_ipv6_addr outer_ip_dst_addr;
+	/* Outer IPv6 version, traffic class and flow label */
+	rte_be32_t outer_vtc_flow;
+
+	/* Tunnel header flags and protocol type */
+	uint32_t tunnel_flags;
+	/* VNI of VxLAN and GENEVE, key of GRE */
+	uint32_t tunnel_id;
+
+	/* Outer UDP ports, zero for GRE */
+	uint16_t outer_src_port;
+	uint16_t outer_dst_port;
+
+	/* Length of the tunnel header and the inner L2 header */
+	uint16_t l2_len;
+	/* Value of enum gro_tunnel_type */
+	uint16_t tunnel_type;
+};
+
+struct gro_tunnel_tcp4_flow {
+	struct tunnel_tcp4_flow_key key;
+	/*
+	 * The index of the first packet in the flow. INVALID_ARRAY_INDEX
+	 * indicates an empty flow.
+	 */
+	uint32_t start_index;
+};
+
+struct gro_tunnel_tcp4_item {
+	struct gro_tcp_item inner_item;
+	/* IPv4 ID in the outer IPv4 header */
+	uint16_t outer_ip_id;
+	/* Indicate if outer IPv4 ID can be ignored */
+	uint8_t outer_is_atomic;
+};
+
+/*
+ * Tunnel (with an inner TCP/IPv4 packet) reassembly table structure.
+ * Flows of different tunnel types can share the same table.
+ */
+struct gro_tunnel_tcp4_tbl {
+	/* item array */
+	struct gro_tunnel_tcp4_item *items;
+	/* flow array */
+	struct gro_tunnel_tcp4_flow *flows;
+	/* current item number */
+	uint32_t item_num;
+	/* current flow number */
+	uint32_t flow_num;
+	/* the maximum item number */
+	uint32_t max_item_num;
+	/* the maximum flow number */
+	uint32_t max_flow_num;
+};
+
+/**
+ * This function creates a reassembly table for tunnel packets
+ * which have an inner TCP/IPv4 packet.
+ *
+ * @param socket_id
+ *  Socket index for allocating the table
+ * @param max_flow_num
+ *  The maximum number of flows in the table
+ * @param max_item_per_flow
+ *  The maximum number of packets per flow
+ *
+ * @return
+ *  - Return the table pointer on success.
+ *  - Return NULL on failure.
+ */
+void *gro_tunnel_tcp4_tbl_create(uint16_t socket_id,
+		uint16_t max_flow_num,
+		uint16_t max_item_per_flow);
+
+/**
+ * This function destroys a tunnel reassembly table.
+ *
+ * @param tbl
+ *  Pointer pointing to the tunnel reassembly table
+ */
+void gro_tunnel_tcp4_tbl_destroy(void *tbl);
+
+/**
+ * This function merges a GENEVE, GRE or VxLAN packet which has an inner
+ * TCP/IPv4 packet. It doesn't process the packet, whose TCP header has
+ * SYN, FIN, RST, PSH, CWR, ECE or URG bit set, or which doesn't have
+ * payload. GRE packets with a checksum or a sequence number, and GENEVE
+ * control packets, are not processed either.
+ *
+ * This function doesn't check if the packet has correct checksums and
+ * doesn't re-calculate checksums for the merged packet. Additionally,
+ * it assumes the packets are complete (i.e., MF==0 && frag_off==0), when
+ * IP fragmentation is possible (i.e., DF==0). It returns the packet, if
+ * the packet has invalid parameters (e.g. SYN bit is set) or there is no
+ * available space in the table.
+ *
+ * @param pkt
+ *  Packet to reassemble
+ * @param tbl
+ *  Pointer pointing to the tunnel reassembly table
+ * @param tunnel_type
+ *  Tunnel type of the packet, one of enum gro_tunnel_type
+ * @start_time
+ *  The time when the packet is inserted into the table
+ *
+ * @return
+ *  - Return a positive value if the packet is merged.
+ *  - Return zero if the packet isn't merged but stored in the table.
+ *  - Return a negative value for invalid parameters or no available
+ *    space in the table.
+ */
+int32_t gro_tunnel_tcp4_reassemble(struct rte_mbuf *pkt,
+		struct gro_tunnel_tcp4_tbl *tbl,
+		enum gro_tunnel_type tunnel_type,
+		uint64_t start_time);
+
+/**
+ * This function flushes timeout packets in the tunnel reassembly table,
+ * and without updating checksums.
+ *
+ * @param tbl
+ *  Pointer pointing to a tunnel GRO table
+ * @param flush_timestamp
+ *  This function flushes packets which are inserted into the table
+ *  before or at the flush_timestamp.
+ * @param out
+ *  Pointer array used to keep flushed packets
+ * @param nb_out
+ *  The element number in 'out'. It also determines the maximum number of
+ *  packets that can be flushed finally.
+ *
+ * @return
+ *  The number of flushed packets
+ */
+uint16_t gro_tunnel_tcp4_tbl_timeout_flush(struct gro_tunnel_tcp4_tbl *tbl,
+		uint64_t flush_timestamp,
+		struct rte_mbuf **out,
+		uint16_t nb_out);
+
+/**
+ * This function returns the number of the packets in a tunnel
+ * reassembly table.
+ *
+ * @param tbl
+ *  Pointer pointing to the tunnel reassembly table
+ *
+ * @return
+ *  The number of packets in the table
+ */
+uint32_t gro_tunnel_tcp4_tbl_pkt_count(void *tbl);
+#endif
@@ -13,6 +13,7 @@
 #include "gro_udp4.h"
 #include "gro_vxlan_tcp4.h"
 #include "gro_vxlan_udp4.h"
+#include "gro_tunnel_tcp4.h"
 
 typedef void *(*gro_tbl_create_fn)(uint16_t socket_id,
 		uint16_t max_flow_num,
@@ -22,16 +23,20 @@ typedef uint32_t (*gro_tbl_pkt_count_fn)(void *tbl);
 
 static gro_tbl_create_fn tbl_create_fn[RTE_GRO_TYPE_MAX_NUM] = {
 		gro_tcp4_tbl_create, gro_vxlan_tcp4_tbl_create,
-		gro_udp4_tbl_create, gro_vxlan_udp4_tbl_create, gro_tcp6_tbl_create, NULL};
+		gro_udp4_tbl_create, gro_vxlan_udp4_tbl_create, gro_tcp6_tbl_create,
+		gro_tunnel_tcp4_tbl_create, gro_tunnel_tcp4_tbl_create,
+		gro_tunnel_tcp4_tbl_create, NULL};
 static gro_tbl_destroy_fn tbl_destroy_fn[RTE_GRO_TYPE_MAX_NUM] = {
 			gro_tcp4_tbl_destroy, gro_vxlan_tcp4_tbl_destroy,
 			gro_udp4_tbl_destroy, gro_vxlan_udp4_tbl_destroy,
-			gro_tcp6_tbl_destroy,
+			gro_tcp6_tbl_destroy, gro_tunnel_tcp4_tbl_destroy,
+			gro_tunnel_tcp4_tbl_destroy, gro_tunnel_tcp4_tbl_destroy,
 			NULL};
 static gro_tbl_pkt_count_fn tbl_pkt_count_fn[RTE_GRO_TYPE_MAX_NUM] = {
 			gro_tcp4_tbl_pkt_count, gro_vxlan_tcp4_tbl_pkt_count,
 			gro_udp4_tbl_pkt_count, gro_vxlan_udp4_tbl_pkt_count,
-			gro_tcp6_tbl_pkt_count,
+			gro_tcp6_tbl_pkt_count, gro_tunnel_tcp4_tbl_pkt_count,
+			gro_tunnel_tcp4_tbl_pkt_count, gro_tunnel_tcp4_tbl_pkt_count,
 			NULL};
 
 #define IS_IPV4_TCP_PKT(ptype) (RTE_ETH_IS_IPV4_HDR(ptype) && \
@@ -76,6 +81,37 @@ static gro_tbl_pkt_count_fn tbl_pkt_count_fn[RTE_GRO_TYPE_MAX_NUM] = {
 		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
 		  RTE_PTYPE_INNER_L3_IPV4_EXT_UNKNOWN)))
 
+#define IS_INNER_TCP4_PKT(ptype) \
+		(((ptype & RTE_PTYPE_INNER_L4_MASK) == RTE_PTYPE_INNER_L4_TCP) && \
+		(((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT) || \
+		 ((ptype & RTE_PTYPE_INNER_L3_MASK) == \
+		  RTE_PTYPE_INNER_L3_IPV4_EXT_UNKNOWN)))
+
+#define IS_IPV4_GENEVE_TCP4_PKT(ptype) (RTE_ETH_IS_IPV4_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_MASK) == RTE_PTYPE_L4_UDP) && \
+		((ptype & RTE_PTYPE_TUNNEL_MASK) == RTE_PTYPE_TUNNEL_GENEVE) && \
+		IS_INNER_TCP4_PKT(ptype))
+
+#define IS_IPV4_GRE_TCP4_PKT(ptype) (RTE_ETH_IS_IPV4_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_MASK) != RTE_PTYPE_L4_FRAG) && \
+		(((ptype & RTE_PTYPE_TUNNEL_MASK) == RTE_PTYPE_TUNNEL_GRE) || \
+		 ((ptype & RTE_PTYPE_TUNNEL_MASK) == RTE_PTYPE_TUNNEL_NVGRE)) && \
+		IS_INNER_TCP4_PKT(ptype))
+
+#define IS_IPV6_VXLAN_TCP4_PKT(ptype) (RTE_ETH_IS_IPV6_HDR(ptype) && \
+		((ptype & RTE_PTYPE_L4_MASK) == RTE_PTYPE_L4_UDP) && \
+		((ptype & RTE_PTYPE_TUNNEL_MASK) == RTE_PTYPE_TUNNEL_VXLAN) && \
+		IS_INNER_TCP4_PKT(ptype))
+
+#define GRO_TUNNEL_TCP4_TYPES (RTE_GRO_IPV4_GENEVE_TCP_IPV4 | \
+		RTE_GRO_IPV4_GRE_TCP_IPV4 | RTE_GRO_IPV6_VXLAN_TCP_IPV4)
+
+/* Number of packets whose headers are prefetched ahead of the processing */
+#define GRO_PREFETCH_OFFSET 4
+
 /*
  * GRO context structure. It keeps the table structures, which are
  * used to merge packets, for different GRO types. Before using
@@ -183,16 +219,24 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	struct gro_vxlan_udp4_item vxlan_udp_items[RTE_GRO_MAX_BURST_ITEM_NUM]
 			= {{{0}} };
 
+	/* Allocate a reassembly table for GENEVE, GRE and VxLAN/IPv6 TCP GRO */
+	struct gro_tunnel_tcp4_tbl tunnel_tcp_tbl;
+	struct gro_tunnel_tcp4_flow tunnel_tcp_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
+	struct gro_tunnel_tcp4_item tunnel_tcp_items[RTE_GRO_MAX_BURST_ITEM_NUM]
+			= {{{0}, 0, 0} };
+
 	uint32_t item_num;
 	int32_t ret;
 	uint16_t i, unprocess_num = 0, nb_after_gro = nb_pkts;
 	uint8_t do_tcp4_gro = 0, do_vxlan_tcp_gro = 0, do_udp4_gro = 0,
-		do_vxlan_udp_gro = 0, do_tcp6_gro = 0;
+		do_vxlan_udp_gro = 0, do_tcp6_gro = 0, do_geneve_tcp_gro = 0,
+		do_gre_tcp_gro = 0, do_vxlan6_tcp_gro = 0;
 
 	if (unlikely((param->gro_types & (RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
 					RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6 |
 					RTE_GRO_IPV4_VXLAN_UDP_IPV4 |
-					RTE_GRO_UDP_IPV4)) == 0))
+					RTE_GRO_UDP_IPV4 |
+					GRO_TUNNEL_TCP4_TYPES)) == 0))
 		return nb_pkts;
 
 	/* Get the maximum number of packets */
@@ -226,6 +270,25 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		do_vxlan_udp_gro = 1;
 	}
 
+	/* The tunnel types share one table, flows are keyed by tunnel type. */
+	if (param->gro_types & GRO_TUNNEL_TCP4_TYPES) {
+		for (i = 0; i < item_num; i++)
+			tunnel_tcp_flows[i].start_index = INVALID_ARRAY_INDEX;
+
+		tunnel_tcp_tbl.flows = tunnel_tcp_flows;
+		tunnel_tcp_tbl.items = tunnel_tcp_items;
+		tunnel_tcp_tbl.flow_num = 0;
+		tunnel_tcp_tbl.item_num = 0;
+		tunnel_tcp_tbl.max_flow_num = item_num;
+		tunnel_tcp_tbl.max_item_num = item_num;
+		do_geneve_tcp_gro = (param->gro_types &
+				RTE_GRO_IPV4_GENEVE_TCP_IPV4) != 0;
+		do_gre_tcp_gro = (param->gro_types &
+				RTE_GRO_IPV4_GRE_TCP_IPV4) != 0;
+		do_vxlan6_tcp_gro = (param->gro_types &
+				RTE_GRO_IPV6_VXLAN_TCP_IPV4) != 0;
+	}
+
 	if (param->gro_types & RTE_GRO_TCP_IPV4) {
 		for (i = 0; i < item_num; i++)
 			tcp_flows[i].start_index = INVALID_ARRAY_INDEX;
@@ -236,6 +299,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		tcp_tbl.item_num = 0;
 		tcp_tbl.max_flow_num = item_num;
 		tcp_tbl.max_item_num = item_num;
+		tcp_tbl.hash = NULL;
 		do_tcp4_gro = 1;
 	}
 
@@ -262,6 +326,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		tcp6_tbl.item_num = 0;
 		tcp6_tbl.max_flow_num = item_num;
 		tcp6_tbl.max_item_num = item_num;
+		tcp6_tbl.hash = NULL;
 		do_tcp6_gro = 1;
 	}
 
@@ -288,6 +353,33 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 				nb_after_gro--;
 			else if (ret < 0)
 				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV4_GENEVE_TCP4_PKT(pkts[i]->packet_type) &&
+				do_geneve_tcp_gro) {
+			ret = gro_tunnel_tcp4_reassemble(pkts[i], &tunnel_tcp_tbl,
+					GRO_TUNNEL_IPV4_GENEVE, 0);
+			if (ret > 0)
+				/* Merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV4_GRE_TCP4_PKT(pkts[i]->packet_type) &&
+				do_gre_tcp_gro) {
+			ret = gro_tunnel_tcp4_reassemble(pkts[i], &tunnel_tcp_tbl,
+					GRO_TUNNEL_IPV4_GRE, 0);
+			if (ret > 0)
+				/* Merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_TCP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_tcp_gro) {
+			ret = gro_tunnel_tcp4_reassemble(pkts[i], &tunnel_tcp_tbl,
+					GRO_TUNNEL_IPV6_VXLAN, 0);
+			if (ret > 0)
+				/* Merge successfully */
+				nb_after_gro--;
+			else if (ret < 0)
+				pkts[unprocess_num++] = pkts[i];
 		} else if (IS_IPV4_TCP_PKT(pkts[i]->packet_type) &&
 				do_tcp4_gro) {
 			ret = gro_tcp4_reassemble(pkts[i], &tcp_tbl, 0);
@@ -333,6 +425,11 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 
 		}
 
+		if (do_geneve_tcp_gro || do_gre_tcp_gro || do_vxlan6_tcp_gro) {
+			i += gro_tunnel_tcp4_tbl_timeout_flush(&tunnel_tcp_tbl,
+					0, &pkts[i], nb_pkts - i);
+		}
+
 		if (do_tcp4_gro) {
 			i += gro_tcp4_tbl_timeout_flush(&tcp_tbl, 0,
 					&pkts[i], nb_pkts - i);
@@ -360,14 +457,17 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 {
 	struct gro_ctx *gro_ctx = ctx;
 	void *tcp_tbl, *udp_tbl, *vxlan_tcp_tbl, *vxlan_udp_tbl, *tcp6_tbl;
+	void *geneve_tcp_tbl, *gre_tcp_tbl, *vxlan6_tcp_tbl;
 	uint64_t current_time;
 	uint16_t i, unprocess_num = 0;
 	uint8_t do_tcp4_gro, do_vxlan_tcp_gro, do_udp4_gro, do_vxlan_udp_gro, do_tcp6_gro;
+	uint8_t do_geneve_tcp_gro, do_gre_tcp_gro, do_vxlan6_tcp_gro;
 
 	if (unlikely((gro_ctx->gro_types & (RTE_GRO_IPV4_VXLAN_TCP_IPV4 |
 					RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6 |
 					RTE_GRO_IPV4_VXLAN_UDP_IPV4 |
-					RTE_GRO_UDP_IPV4)) == 0))
+					RTE_GRO_UDP_IPV4 |
+					GRO_TUNNEL_TCP4_TYPES)) == 0))
 		return nb_pkts;
 
 	tcp_tbl = gro_ctx->tbls[RTE_GRO_TCP_IPV4_INDEX];
@@ -375,6 +475,9 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 	udp_tbl = gro_ctx->tbls[RTE_GRO_UDP_IPV4_INDEX];
 	vxlan_udp_tbl = gro_ctx->tbls[RTE_GRO_IPV4_VXLAN_UDP_IPV4_INDEX];
 	tcp6_tbl = gro_ctx->tbls[RTE_GRO_TCP_IPV6_INDEX];
+	geneve_tcp_tbl = gro_ctx->tbls[RTE_GRO_IPV4_GENEVE_TCP_IPV4_INDEX];
+	gre_tcp_tbl = gro_ctx->tbls[RTE_GRO_IPV4_GRE_TCP_IPV4_INDEX];
+	vxlan6_tcp_tbl = gro_ctx->tbls[RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX];
 
 	do_tcp4_gro = (gro_ctx->gro_types & RTE_GRO_TCP_IPV4) ==
 		RTE_GRO_TCP_IPV4;
@@ -385,10 +488,24 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 	do_vxlan_udp_gro = (gro_ctx->gro_types & RTE_GRO_IPV4_VXLAN_UDP_IPV4) ==
 		RTE_GRO_IPV4_VXLAN_UDP_IPV4;
 	do_tcp6_gro = (gro_ctx->gro_types & RTE_GRO_TCP_IPV6) == RTE_GRO_TCP_IPV6;
+	do_geneve_tcp_gro = (gro_ctx->gro_types & RTE_GRO_IPV4_GENEVE_TCP_IPV4) ==
+		RTE_GRO_IPV4_GENEVE_TCP_IPV4;
+	do_gre_tcp_gro = (gro_ctx->gro_types & RTE_GRO_IPV4_GRE_TCP_IPV4) ==
+		RTE_GRO_IPV4_GRE_TCP_IPV4;
+	do_vxlan6_tcp_gro = (gro_ctx->gro_types & RTE_GRO_IPV6_VXLAN_TCP_IPV4) ==
+		RTE_GRO_IPV6_VXLAN_TCP_IPV4;
 
 	current_time = rte_rdtsc();
 
+	/* Prefetch the headers of the first packets of the burst */
+	for (i = 0; i < GRO_PREFETCH_OFFSET && i < nb_pkts; i++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+
 	for (i = 0; i < nb_pkts; i++) {
+		if (i + GRO_PREFETCH_OFFSET < nb_pkts)
+			rte_prefetch0(rte_pktmbuf_mtod(
+					pkts[i + GRO_PREFETCH_OFFSET], void *));
+
 		if (IS_IPV4_VXLAN_TCP4_PKT(pkts[i]->packet_type) &&
 				do_vxlan_tcp_gro) {
 			if (gro_vxlan_tcp4_reassemble(pkts[i], vxlan_tcp_tbl,
@@ -399,6 +516,24 @@ rte_gro_reassemble(struct rte_mbuf **pkts,
 			if (gro_vxlan_udp4_reassemble(pkts[i], vxlan_udp_tbl,
 						current_time) < 0)
 				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV4_GENEVE_TCP4_PKT(pkts[i]->packet_type) &&
+				do_geneve_tcp_gro) {
+			if (gro_tunnel_tcp4_reassemble(pkts[i], geneve_tcp_tbl,
+						GRO_TUNNEL_IPV4_GENEVE,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV4_GRE_TCP4_PKT(pkts[i]->packet_type) &&
+				do_gre_tcp_gro) {
+			if (gro_tunnel_tcp4_reassemble(pkts[i], gre_tcp_tbl,
+						GRO_TUNNEL_IPV4_GRE,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
+		} else if (IS_IPV6_VXLAN_TCP4_PKT(pkts[i]->packet_type) &&
+				do_vxlan6_tcp_gro) {
+			if (gro_tunnel_tcp4_reassemble(pkts[i], vxlan6_tcp_tbl,
+						GRO_TUNNEL_IPV6_VXLAN,
+						current_time) < 0)
+				pkts[unprocess_num++] = pkts[i];
 		} else if (IS_IPV4_TCP_PKT(pkts[i]->packet_type) &&
 				do_tcp4_gro) {
 			if (gro_tcp4_reassemble(pkts[i], tcp_tbl,
@@ -451,6 +586,27 @@ rte_gro_timeout_flush(void *ctx,
 		left_nb_out = max_nb_out - num;
 	}
 
+	if ((gro_types & RTE_GRO_IPV4_GENEVE_TCP_IPV4) && left_nb_out > 0) {
+		num += gro_tunnel_tcp4_tbl_timeout_flush(gro_ctx->tbls[
+				RTE_GRO_IPV4_GENEVE_TCP_IPV4_INDEX],
+				flush_timestamp, &out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
+
+	if ((gro_types & RTE_GRO_IPV4_GRE_TCP_IPV4) && left_nb_out > 0) {
+		num += gro_tunnel_tcp4_tbl_timeout_flush(gro_ctx->tbls[
+				RTE_GRO_IPV4_GRE_TCP_IPV4_INDEX],
+				flush_timestamp, &out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
+
+	if ((gro_types & RTE_GRO_IPV6_VXLAN_TCP_IPV4) && left_nb_out > 0) {
+		num += gro_tunnel_tcp4_tbl_timeout_flush(gro_ctx->tbls[
+				RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX],
+				flush_timestamp, &out[num], left_nb_out);
+		left_nb_out = max_nb_out - num;
+	}
+
 	/* If no available space in 'out', stop flushing. */
 	if ((gro_types & RTE_GRO_TCP_IPV4) && left_nb_out > 0) {
 		num += gro_tcp4_tbl_timeout_flush(
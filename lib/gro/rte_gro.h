@@ -41,6 +41,15 @@ extern "C" {
 #define RTE_GRO_TCP_IPV6_INDEX 4
 #define RTE_GRO_TCP_IPV6 (1ULL << RTE_GRO_TCP_IPV6_INDEX)
 /**< TCP/IPv6 GRO flag. */
+#define RTE_GRO_IPV4_GENEVE_TCP_IPV4_INDEX 5
+#define RTE_GRO_IPV4_GENEVE_TCP_IPV4 (1ULL << RTE_GRO_IPV4_GENEVE_TCP_IPV4_INDEX)
+/**< GENEVE TCP/IPv4 GRO flag. */
+#define RTE_GRO_IPV4_GRE_TCP_IPV4_INDEX 6
+#define RTE_GRO_IPV4_GRE_TCP_IPV4 (1ULL << RTE_GRO_IPV4_GRE_TCP_IPV4_INDEX)
+/**< GRE and NVGRE TCP/IPv4 GRO flag. */
+#define RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX 7
+#define RTE_GRO_IPV6_VXLAN_TCP_IPV4 (1ULL << RTE_GRO_IPV6_VXLAN_TCP_IPV4_INDEX)
+/**< VxLAN TCP/IPv4 with an outer IPv6 header GRO flag. */
 
 /**
  * Structure used to create GRO context objects or used to pass
@@ -38,6 +38,66 @@
 #define IS_IPV4_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV4)) == \
 		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV4))
 
+#define IS_IPV6_TCP(flag) (((flag) & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_IPV6 | \
+				RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_IPV6))
+
+#define IS_IPV6_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV6 | \
+				RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_IPV6))
+
+#define IS_IPV6_VXLAN_TCP(flag) (((flag) & (RTE_MBUF_F_TX_TCP_SEG | \
+				RTE_MBUF_F_TX_OUTER_IPV6 | RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_OUTER_IPV6 | \
+		 RTE_MBUF_F_TX_TUNNEL_VXLAN))
+
+#define IS_IPV6_VXLAN_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | \
+				RTE_MBUF_F_TX_OUTER_IPV6 | RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_OUTER_IPV6 | \
+		 RTE_MBUF_F_TX_TUNNEL_VXLAN))
+
+#define IS_IPV6_GENEVE_UDP(flag) (((flag) & (RTE_MBUF_F_TX_UDP_SEG | \
+				RTE_MBUF_F_TX_OUTER_IPV6 | RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_UDP_SEG | RTE_MBUF_F_TX_OUTER_IPV6 | \
+		 RTE_MBUF_F_TX_TUNNEL_GENEVE))
+
+#define IS_IPV6_GENEVE_TCP(flag) (((flag) & (RTE_MBUF_F_TX_TCP_SEG | \
+				RTE_MBUF_F_TX_OUTER_IPV6 | RTE_MBUF_F_TX_TUNNEL_MASK)) == \
+		(RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_OUTER_IPV6 | \
+		 RTE_MBUF_F_TX_TUNNEL_GENEVE))
+
+/**
+ * Internal function which checks if an IPv6 packet is a fragment, walking
+ * the extension headers up to the fragment header or the L4 header.
+ *
+ * @param ipv6_hdr
+ *  The IPv6 header, followed by its extension headers.
+ * @param l3_len
+ *  The length of the IPv6 header and of its extension headers.
+ *
+ * @return
+ *  1 if the packet has a fragment header, 0 otherwise.
+ */
+static inline int
+is_ipv6_fragmented(const struct rte_ipv6_hdr *ipv6_hdr, uint16_t l3_len)
+{
+	const uint8_t *ext = (const uint8_t *)(ipv6_hdr + 1);
+	size_t ext_len, off = sizeof(*ipv6_hdr);
+	int proto = ipv6_hdr->proto;
+
+	while (proto != IPPROTO_FRAGMENT) {
+		if (off >= l3_len)
+			return 0;
+		proto = rte_ipv6_get_next_ext(ext, proto, &ext_len);
+		if (proto < 0)
+			return 0;
+		ext += ext_len;
+		off += ext_len;
+	}
+
+	return 1;
+}
+
 /**
  * Internal function which updates the UDP header of a packet, following
  * segmentation. This is required to update the header's datagram length field.
@@ -110,6 +170,27 @@ update_ipv4_header(struct rte_mbuf *pkt, uint16_t l3_offset, uint16_t id)
 	ipv4_hdr->packet_id = rte_cpu_to_be_16(id);
 }
 
+/**
+ * Internal function which updates the IPv6 header of a packet, following
+ * segmentation. This is required to update the header's 'payload_len'
+ * field, to reflect the reduced length of the now-segmented packet.
+ *
+ * @param pkt
+ *  The packet containing the IPv6 header.
+ * @param l3_offset
+ *  The offset of the IPv6 header from the start of the packet.
+ */
+static inline void
+update_ipv6_header(struct rte_mbuf *pkt, uint16_t l3_offset)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+
+	ipv6_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv6_hdr *,
+					   l3_offset);
+	ipv6_hdr->payload_len = rte_cpu_to_be_16(pkt->pkt_len - l3_offset -
+						 sizeof(struct rte_ipv6_hdr));
+}
+
 /**
  * Internal function which divides the input packet into small segments.
  * Each of the newly-created segments is organized as a two-segment MBUF,
@@ -0,0 +1,101 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+
+#include "gso_common.h"
+#include "gso_tunnel_tcp6.h"
+
+static void
+update_tunnel_ipv6_tcp_headers(struct rte_mbuf *pkt, uint8_t ipid_delta,
+		struct rte_mbuf **segs, uint16_t nb_segs)
+{
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+	uint32_t sent_seq;
+	uint16_t inner_id = 0, tail_idx, i;
+	uint16_t outer_ipv6_offset, inner_ip_offset;
+	uint16_t udp_offset, tcp_offset;
+	uint8_t inner_ipv4;
+
+	outer_ipv6_offset = pkt->outer_l2_len;
+	udp_offset = outer_ipv6_offset + pkt->outer_l3_len;
+	inner_ip_offset = udp_offset + pkt->l2_len;
+	tcp_offset = inner_ip_offset + pkt->l3_len;
+
+	/* Inner IPv4 header, IPv6 having no ID to update. */
+	inner_ipv4 = (pkt->ol_flags & RTE_MBUF_F_TX_IPV4) ? 1 : 0;
+	if (inner_ipv4) {
+		ipv4_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr *,
+						   inner_ip_offset);
+		inner_id = rte_be_to_cpu_16(ipv4_hdr->packet_id);
+	}
+
+	tcp_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_tcp_hdr *,
+					  tcp_offset);
+	sent_seq = rte_be_to_cpu_32(tcp_hdr->sent_seq);
+	tail_idx = nb_segs - 1;
+
+	for (i = 0; i < nb_segs; i++) {
+		update_ipv6_header(segs[i], outer_ipv6_offset);
+		update_udp_header(segs[i], udp_offset);
+		if (inner_ipv4)
+			update_ipv4_header(segs[i], inner_ip_offset, inner_id);
+		else
+			update_ipv6_header(segs[i], inner_ip_offset);
+		update_tcp_header(segs[i], tcp_offset, sent_seq, i < tail_idx);
+		inner_id += ipid_delta;
+		sent_seq += (segs[i]->pkt_len - segs[i]->data_len);
+	}
+}
+
+int
+gso_tunnel_tcp6_segment(struct rte_mbuf *pkt,
+		uint16_t gso_size,
+		uint8_t ipid_delta,
+		struct rte_mempool *direct_pool,
+		struct rte_mempool *indirect_pool,
+		struct rte_mbuf **pkts_out,
+		uint16_t nb_pkts_out)
+{
+	struct rte_ipv4_hdr *inner_ipv4_hdr;
+	struct rte_ipv6_hdr *inner_ipv6_hdr;
+	uint16_t pyld_unit_size, hdr_offset, frag_off;
+	int ret;
+
+	hdr_offset = pkt->outer_l2_len + pkt->outer_l3_len + pkt->l2_len;
+	/* Don't process the packet whose inner IP header is fragmented */
+	if (pkt->ol_flags & RTE_MBUF_F_TX_IPV4) {
+		inner_ipv4_hdr = rte_pktmbuf_mtod_offset(pkt,
+				struct rte_ipv4_hdr *, hdr_offset);
+		frag_off = rte_be_to_cpu_16(inner_ipv4_hdr->fragment_offset);
+		if (unlikely(IS_FRAGMENTED(frag_off)))
+			return 0;
+	} else {
+		inner_ipv6_hdr = rte_pktmbuf_mtod_offset(pkt,
+				struct rte_ipv6_hdr *, hdr_offset);
+		if (unlikely(is_ipv6_fragmented(inner_ipv6_hdr,
+				pkt->l3_len)))
+			return 0;
+	}
+
+	hdr_offset += pkt->l3_len + pkt->l4_len;
+	/* Don't process the packet without data */
+	if (hdr_offset >= pkt->pkt_len)
+		return 0;
+
+	/* The headers must leave room for payload in each segment */
+	if (unlikely(hdr_offset >= gso_size))
+		return -EINVAL;
+
+	pyld_unit_size = gso_size - hdr_offset;
+
+	/* Segment the payload */
+	ret = gso_do_segment(pkt, hdr_offset, pyld_unit_size, direct_pool,
+			indirect_pool, pkts_out, nb_pkts_out);
+	if (ret > 1)
+		update_tunnel_ipv6_tcp_headers(pkt, ipid_delta, pkts_out, ret);
+
+	return ret;
+}
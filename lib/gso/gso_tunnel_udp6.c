@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+
+#include "gso_common.h"
+#include "gso_tunnel_udp6.h"
+
+#define IPV4_HDR_MF_BIT (1U << 13)
+
+static void
+update_tunnel_ipv6_udp_headers(struct rte_mbuf *pkt, struct rte_mbuf **segs,
+		uint16_t nb_segs)
+{
+	struct rte_ipv4_hdr *ipv4_hdr;
+	uint16_t inner_id = 0, frag_offset = 0, is_mf, tail_idx, i;
+	uint16_t outer_ipv6_offset, inner_ip_offset;
+	uint16_t udp_offset, inner_udp_offset;
+	uint8_t inner_ipv4;
+
+	outer_ipv6_offset = pkt->outer_l2_len;
+	udp_offset = outer_ipv6_offset + pkt->outer_l3_len;
+	inner_ip_offset = udp_offset + pkt->l2_len;
+	inner_udp_offset = inner_ip_offset + pkt->l3_len;
+
+	inner_ipv4 = (pkt->ol_flags & RTE_MBUF_F_TX_IPV4) ? 1 : 0;
+	if (inner_ipv4) {
+		ipv4_hdr = rte_pktmbuf_mtod_offset(pkt, struct rte_ipv4_hdr *,
+						   inner_ip_offset);
+		inner_id = rte_be_to_cpu_16(ipv4_hdr->packet_id);
+	}
+
+	tail_idx = nb_segs - 1;
+
+	for (i = 0; i < nb_segs; i++) {
+		update_ipv6_header(segs[i], outer_ipv6_offset);
+		update_udp_header(segs[i], udp_offset);
+		if (!inner_ipv4) {
+			update_ipv6_header(segs[i], inner_ip_offset);
+			update_udp_header(segs[i], inner_udp_offset);
+			continue;
+		}
+
+		/*
+		 * Keep the inner UDP datagram boundary with inner IPv4
+		 * fragments, all with the same ID.
+		 */
+		update_ipv4_header(segs[i], inner_ip_offset, inner_id);
+		ipv4_hdr = rte_pktmbuf_mtod_offset(segs[i],
+						   struct rte_ipv4_hdr *,
+						   inner_ip_offset);
+		is_mf = i < tail_idx ? IPV4_HDR_MF_BIT : 0;
+		ipv4_hdr->fragment_offset =
+			rte_cpu_to_be_16(frag_offset | is_mf);
+		frag_offset += (segs[i]->pkt_len - inner_udp_offset) >> 3;
+	}
+}
+
+int
+gso_tunnel_udp6_segment(struct rte_mbuf *pkt,
+		uint16_t gso_size,
+		struct rte_mempool *direct_pool,
+		struct rte_mempool *indirect_pool,
+		struct rte_mbuf **pkts_out,
+		uint16_t nb_pkts_out)
+{
+	struct rte_ipv4_hdr *inner_ipv4_hdr;
+	struct rte_ipv6_hdr *inner_ipv6_hdr;
+	uint16_t pyld_unit_size, hdr_offset, frag_off;
+	uint8_t inner_ipv4;
+	int ret;
+
+	hdr_offset = pkt->outer_l2_len + pkt->outer_l3_len + pkt->l2_len;
+	/* Don't process the packet whose inner IP header is fragmented */
+	inner_ipv4 = (pkt->ol_flags & RTE_MBUF_F_TX_IPV4) ? 1 : 0;
+	if (inner_ipv4) {
+		inner_ipv4_hdr = rte_pktmbuf_mtod_offset(pkt,
+				struct rte_ipv4_hdr *, hdr_offset);
+		frag_off = rte_be_to_cpu_16(inner_ipv4_hdr->fragment_offset);
+		if (unlikely(IS_FRAGMENTED(frag_off)))
+			return 0;
+	} else {
+		inner_ipv6_hdr = rte_pktmbuf_mtod_offset(pkt,
+				struct rte_ipv6_hdr *, hdr_offset);
+		if (unlikely(is_ipv6_fragmented(inner_ipv6_hdr,
+				pkt->l3_len)))
+			return 0;
+	}
+
+	hdr_offset += pkt->l3_len;
+	/* Don't process the packet without data */
+	if ((hdr_offset + pkt->l4_len) >= pkt->pkt_len)
+		return 0;
+
+	/*
+	 * Inner IPv6 packets are split into UDP datagrams, which all
+	 * carry the inner UDP header.
+	 */
+	if (!inner_ipv4)
+		hdr_offset += pkt->l4_len;
+
+	/* The headers must leave room for payload in each segment */
+	if (unlikely(hdr_offset >= gso_size))
+		return -EINVAL;
+
+	pyld_unit_size = gso_size - hdr_offset;
+
+	/* IPv4 fragment offsets use 8 bytes as unit */
+	if (inner_ipv4) {
+		pyld_unit_size &= ~7U;
+		if (unlikely(pyld_unit_size == 0))
+			return -EINVAL;
+	}
+
+	/* Segment the payload */
+	ret = gso_do_segment(pkt, hdr_offset, pyld_unit_size, direct_pool,
+			indirect_pool, pkts_out, nb_pkts_out);
+	if (ret > 1)
+		update_tunnel_ipv6_udp_headers(pkt, pkts_out, ret);
+
+	return ret;
+}
@@ -56,7 +56,7 @@ struct rte_gso_ctx {
 	 * gso_types.
 	 *
 	 * For example, if applications want to segment TCP/IPv4
-	 * packets, set RTE_ETH_TX_OFFLOAD_TCP_TSO in gso_types.
+	 * or TCP/IPv6 packets, set RTE_ETH_TX_OFFLOAD_TCP_TSO in gso_types.
 	 */
 	uint16_t gso_size;
 	/**< maximum size of an output GSO segment, including packet
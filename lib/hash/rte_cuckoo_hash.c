@@ -334,6 +334,19 @@ rte_hash_get_last_bkt(struct rte_hash_bucket *lst_bkt)
 	return lst_bkt;
 }
 
+/*
+ * The free slots ring is reallocated outside of a memzone
+ * when the table is resized.
+ */
+static void
+free_slots_ring_free(struct rte_ring *r)
+{
+	if (r != NULL && r->memzone == NULL)
+		rte_free(r);
+	else
+		rte_ring_free(r);
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_set_cmp_func)
 void rte_hash_set_cmp_func(struct rte_hash *h, rte_hash_cmp_eq_t func)
 {
@@ -704,6 +717,8 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	h->ext_bkt_to_free = ext_bkt_to_free;
 	h->tbl_chng_cnt = tbl_chng_cnt;
 	*h->tbl_chng_cnt = 0;
+	h->num_key_slots = num_key_slots;
+	h->socket_id = params->socket_id;
 	h->hw_trans_mem_support = hw_trans_mem_support;
 	h->use_local_cache = use_local_cache;
 	h->local_free_slots = local_free_slots;
@@ -799,11 +814,15 @@ rte_hash_free(struct rte_hash *h)
 	if (h->dq)
 		rte_rcu_qsbr_dq_delete(h->dq);
 
+	if (h->resize != NULL) {
+		rte_free(h->resize->buckets);
+		rte_free(h->resize);
+	}
 	if (h->use_local_cache)
 		rte_free(h->local_free_slots);
 	if (h->writer_takes_lock)
 		rte_free(h->readwrite_lock);
-	rte_ring_free(h->free_slots);
+	free_slots_ring_free(h->free_slots);
 	rte_ring_free(h->free_ext_bkts);
 	rte_free(h->key_store);
 	rte_free(h->buckets);
@@ -860,6 +879,9 @@ rte_hash_count(const struct rte_hash *h)
 	} else {
 		tot_ring_cnt = h->entries;
 		ret = tot_ring_cnt - rte_ring_count(h->free_slots);
+		/* Key slots above the capacity of a shrinking table */
+		if (h->resize != NULL)
+			ret += h->resize->retired_slots;
 	}
 	return ret;
 }
@@ -909,10 +931,24 @@ __hash_rw_reader_unlock(const struct rte_hash *h)
 		rte_rwlock_read_unlock(h->readwrite_lock);
 }
 
+/*
+ * Wait for the lock free readers to stop referencing the tables
+ * replaced by a resize. Readers using the lock cannot run while
+ * the writer holds it, so there is nothing to wait for.
+ */
+static inline void
+__hash_resize_sync(const struct rte_hash *h)
+{
+	if (h->readwrite_concur_lf_support)
+		rte_rcu_qsbr_synchronize(h->hash_rcu_cfg->v,
+					 RTE_QSBR_THRID_INVALID);
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_reset)
 void
 rte_hash_reset(struct rte_hash *h)
 {
+	struct rte_hash_resize_ctx *ctx;
 	uint32_t tot_ring_cnt, i;
 	unsigned int pending;
 
@@ -928,6 +964,16 @@ rte_hash_reset(struct rte_hash *h)
 			HASH_LOG(ERR, "RCU reclaim all resources failed");
 	}
 
+	/* Drop the buckets of an in-progress resize */
+	ctx = h->resize;
+	if (ctx != NULL) {
+		rte_atomic_store_explicit(&h->resize, NULL,
+				rte_memory_order_release);
+		__hash_resize_sync(h);
+		rte_free(ctx->buckets);
+		rte_free(ctx);
+	}
+
 	memset(h->buckets, 0, h->num_buckets * sizeof(struct rte_hash_bucket));
 	memset(h->key_store, 0, (size_t)h->key_entry_size * (h->entries + 1));
 	*h->tbl_chng_cnt = 0;
@@ -1326,6 +1372,139 @@ alloc_slot(const struct rte_hash *h, struct lcore_cache *cached_free_slots)
 	return slot_id;
 }
 
+/*
+ * Insert an entry of the buckets drained by a resize into the current
+ * bucket table. The hash is recomputed from the key as the entry may
+ * be in its secondary bucket. There is a single writer and the key is
+ * only ever added to the current table after its previous buckets
+ * were drained, so it cannot be found there yet.
+ */
+static int
+__hash_resize_insert(const struct rte_hash *h, const struct rte_hash_key *k,
+		uint32_t key_idx)
+{
+	const void *key = k->key;
+	void *data = k->pdata;
+	hash_sig_t sig = rte_hash_hash(h, key);
+	uint16_t short_sig = get_short_sig(sig);
+	uint32_t prim_bucket_idx = get_prim_bucket_index(h, sig);
+	uint32_t sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx,
+							short_sig);
+	struct rte_hash_bucket *prim_bkt = &h->buckets[prim_bucket_idx];
+	struct rte_hash_bucket *sec_bkt = &h->buckets[sec_bucket_idx];
+	int32_t ret_val;
+	int ret;
+
+	ret = rte_hash_cuckoo_insert_mw(h, prim_bkt, sec_bkt, key, data,
+					short_sig, key_idx, &ret_val);
+	if (ret == 0)
+		return 0;
+
+	ret = rte_hash_cuckoo_make_space_mw(h, prim_bkt, sec_bkt, key, data,
+				short_sig, prim_bucket_idx, key_idx, &ret_val);
+	if (ret == 0)
+		return 0;
+
+	ret = rte_hash_cuckoo_make_space_mw(h, sec_bkt, prim_bkt, key, data,
+				short_sig, sec_bucket_idx, key_idx, &ret_val);
+	if (ret == 0)
+		return 0;
+
+	return -ENOSPC;
+}
+
+/*
+ * Migrate all the entries of a bucket drained by a resize into the
+ * current bucket table. Entries stored in key slots above the capacity
+ * of a shrunk table are copied to a free slot on the way.
+ */
+static int
+__hash_resize_migrate_bkt(const struct rte_hash *h,
+		struct rte_hash_resize_ctx *ctx, uint32_t bkt_idx)
+{
+	struct rte_hash_bucket *bkt = &ctx->buckets[bkt_idx];
+	struct rte_hash_key *k, *new_k;
+	uint32_t key_idx, new_idx;
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+		key_idx = bkt->key_idx[i];
+		if (key_idx == EMPTY_SLOT)
+			continue;
+
+		k = RTE_PTR_ADD(h->key_store, key_idx * (size_t)h->key_entry_size);
+		new_idx = key_idx;
+		if (key_idx > h->entries) {
+			new_idx = alloc_slot(h, NULL);
+			if (new_idx == EMPTY_SLOT && h->dq) {
+				__hash_rw_writer_lock(h);
+				ret = rte_rcu_qsbr_dq_reclaim(h->dq,
+						h->hash_rcu_cfg->max_reclaim_size,
+						NULL, NULL, NULL);
+				__hash_rw_writer_unlock(h);
+				if (ret == 0)
+					new_idx = alloc_slot(h, NULL);
+			}
+			if (new_idx == EMPTY_SLOT)
+				return -ENOSPC;
+
+			new_k = RTE_PTR_ADD(h->key_store,
+					new_idx * (size_t)h->key_entry_size);
+			memcpy(new_k, k, h->key_entry_size);
+			k = new_k;
+		}
+
+		if (__hash_resize_insert(h, k, new_idx) != 0) {
+			if (new_idx != key_idx)
+				enqueue_slot_back(h, NULL, new_idx);
+			return -ENOSPC;
+		}
+
+		if (h->readwrite_concur_lf_support) {
+			/* Inform the readers that the entry is now in the
+			 * current table, before it disappears from the
+			 * previous one. Since there is one writer, load
+			 * acquire on tbl_chng_cnt is not required.
+			 */
+			rte_atomic_store_explicit(h->tbl_chng_cnt,
+					 *h->tbl_chng_cnt + 1,
+					 rte_memory_order_release);
+			/* The store to sig_current should not
+			 * move above the store to tbl_chng_cnt.
+			 */
+			rte_atomic_thread_fence(rte_memory_order_release);
+		}
+
+		__hash_rw_writer_lock(h);
+		bkt->sig_current[i] = NULL_SIGNATURE;
+		rte_atomic_store_explicit(&bkt->key_idx[i], EMPTY_SLOT,
+				rte_memory_order_release);
+		__hash_rw_writer_unlock(h);
+
+		if (new_idx != key_idx)
+			ctx->retired_slots--;
+	}
+
+	return 0;
+}
+
+/* Migrate the buckets drained by a resize where a key may be stored. */
+static int
+__hash_resize_migrate_key(const struct rte_hash *h, hash_sig_t sig)
+{
+	struct rte_hash_resize_ctx *ctx = h->resize;
+	uint32_t prim_bucket_idx = sig & ctx->bucket_bitmask;
+	uint32_t sec_bucket_idx = (prim_bucket_idx ^ get_short_sig(sig)) &
+					ctx->bucket_bitmask;
+	int ret;
+
+	ret = __hash_resize_migrate_bkt(h, ctx, prim_bucket_idx);
+	if (ret == 0)
+		ret = __hash_resize_migrate_bkt(h, ctx, sec_bucket_idx);
+	return ret;
+}
+
 static inline int32_t
 __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 						hash_sig_t sig, void *data)
@@ -1351,6 +1530,25 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	rte_prefetch0(prim_bkt);
 	rte_prefetch0(sec_bkt);
 
+	/* Move the key to the current table if it is being resized */
+	if (unlikely(h->resize != NULL) &&
+			__hash_resize_migrate_key(h, sig) != 0) {
+		struct rte_hash_resize_ctx *ctx = h->resize;
+
+		/* No room to move the key, it can only be updated in place */
+		prim_bucket_idx = sig & ctx->bucket_bitmask;
+		sec_bucket_idx = (prim_bucket_idx ^ short_sig) &
+					ctx->bucket_bitmask;
+		__hash_rw_writer_lock(h);
+		ret = search_and_update(h, data, key,
+				&ctx->buckets[prim_bucket_idx], short_sig);
+		if (ret == -1)
+			ret = search_and_update(h, data, key,
+				&ctx->buckets[sec_bucket_idx], short_sig);
+		__hash_rw_writer_unlock(h);
+		return ret != -1 ? ret : -ENOSPC;
+	}
+
 	/* Check if key is already inserted in primary location */
 	__hash_rw_writer_lock(h);
 	ret = search_and_update(h, data, key, prim_bkt, short_sig);
@@ -1602,7 +1800,7 @@ search_one_bucket_lf(const struct rte_hash *h, const void *key, uint16_t sig,
 {
 	int i;
 	uint32_t key_idx;
-	struct rte_hash_key *k, *keys = h->key_store;
+	struct rte_hash_key *k;
 
 	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
 		/* Signature comparison is done before the acquire-load
@@ -1616,7 +1814,10 @@ search_one_bucket_lf(const struct rte_hash *h, const void *key, uint16_t sig,
 			key_idx = rte_atomic_load_explicit(&bkt->key_idx[i],
 					  rte_memory_order_acquire);
 			if (key_idx != EMPTY_SLOT) {
-				k = (struct rte_hash_key *) ((char *)keys +
+				/* The key store is loaded after the key index,
+				 * a resize may have grown it to fit the index.
+				 */
+				k = (struct rte_hash_key *) ((char *)h->key_store +
 						key_idx * (size_t)h->key_entry_size);
 
 				if (rte_hash_cmp_eq(key, k->key, h) == 0) {
@@ -1637,6 +1838,34 @@ search_one_bucket_lf(const struct rte_hash *h, const void *key, uint16_t sig,
 	return -1;
 }
 
+/* Search a key in the buckets drained by a resize */
+static inline int32_t
+search_resize_bkts(const struct rte_hash *h,
+		const struct rte_hash_resize_ctx *ctx, const void *key,
+		hash_sig_t sig, void **data)
+{
+	uint16_t short_sig = get_short_sig(sig);
+	uint32_t prim_bucket_idx = sig & ctx->bucket_bitmask;
+	uint32_t sec_bucket_idx = (prim_bucket_idx ^ short_sig) &
+					ctx->bucket_bitmask;
+	int32_t ret;
+
+	if (h->readwrite_concur_lf_support) {
+		ret = search_one_bucket_lf(h, key, short_sig, data,
+					   &ctx->buckets[prim_bucket_idx]);
+		if (ret == -1)
+			ret = search_one_bucket_lf(h, key, short_sig, data,
+						   &ctx->buckets[sec_bucket_idx]);
+	} else {
+		ret = search_one_bucket_l(h, key, short_sig, data,
+					  &ctx->buckets[prim_bucket_idx]);
+		if (ret == -1)
+			ret = search_one_bucket_l(h, key, short_sig, data,
+						  &ctx->buckets[sec_bucket_idx]);
+	}
+	return ret;
+}
+
 static inline int32_t
 __rte_hash_lookup_with_hash_l(const struct rte_hash *h, const void *key,
 				hash_sig_t sig, void **data)
@@ -1646,14 +1875,15 @@ __rte_hash_lookup_with_hash_l(const struct rte_hash *h, const void *key,
 	int ret;
 	uint16_t short_sig;
 
+	/* The bucket table can only be resized by the writer */
+	__hash_rw_reader_lock(h);
+
 	short_sig = get_short_sig(sig);
 	prim_bucket_idx = get_prim_bucket_index(h, sig);
 	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
 
 	bkt = &h->buckets[prim_bucket_idx];
 
-	__hash_rw_reader_lock(h);
-
 	/* Check if key is in primary location */
 	ret = search_one_bucket_l(h, key, short_sig, data, bkt);
 	if (ret != -1) {
@@ -1673,6 +1903,15 @@ __rte_hash_lookup_with_hash_l(const struct rte_hash *h, const void *key,
 		}
 	}
 
+	/* Check if key is not migrated yet by a resize */
+	if (unlikely(h->resize != NULL)) {
+		ret = search_resize_bkts(h, h->resize, key, sig, data);
+		if (ret != -1) {
+			__hash_rw_reader_unlock(h);
+			return ret;
+		}
+	}
+
 	__hash_rw_reader_unlock(h);
 
 	return -ENOENT;
@@ -1684,6 +1923,7 @@ __rte_hash_lookup_with_hash_lf(const struct rte_hash *h, const void *key,
 {
 	uint32_t prim_bucket_idx, sec_bucket_idx;
 	struct rte_hash_bucket *bkt, *cur_bkt;
+	struct rte_hash_resize_ctx *ctx;
 	uint32_t cnt_b, cnt_a;
 	int ret;
 	uint16_t short_sig;
@@ -1716,6 +1956,15 @@ __rte_hash_lookup_with_hash_lf(const struct rte_hash *h, const void *key,
 				return ret;
 		}
 
+		/* Check if key is not migrated yet by a resize */
+		ctx = rte_atomic_load_explicit(&h->resize,
+				rte_memory_order_acquire);
+		if (unlikely(ctx != NULL)) {
+			ret = search_resize_bkts(h, ctx, key, sig, data);
+			if (ret != -1)
+				return ret;
+		}
+
 		/* The loads of sig_current in search_one_bucket
 		 * should not move below the load from tbl_chng_cnt.
 		 */
@@ -1785,6 +2034,13 @@ free_slot(const struct rte_hash *h, uint32_t slot_id)
 	unsigned lcore_id, n_slots;
 	struct lcore_cache *cached_free_slots = NULL;
 
+	/* Key slots above the capacity of a shrunk table are not reused */
+	if (unlikely(slot_id > h->entries) && !h->use_local_cache) {
+		if (h->resize != NULL)
+			h->resize->retired_slots--;
+		return 0;
+	}
+
 	/* Return key indexes to free slot ring */
 	if (h->use_local_cache) {
 		lcore_id = rte_lcore_id();
@@ -2048,6 +2304,7 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 	uint32_t prim_bucket_idx, sec_bucket_idx;
 	struct rte_hash_bucket *prim_bkt, *sec_bkt, *prev_bkt, *last_bkt;
 	struct rte_hash_bucket *cur_bkt;
+	struct rte_hash_resize_ctx *ctx = NULL;
 	int pos;
 	int32_t ret, i;
 	uint16_t short_sig;
@@ -2059,7 +2316,28 @@ __rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key,
 	sec_bucket_idx = get_alt_bucket_index(h, prim_bucket_idx, short_sig);
 	prim_bkt = &h->buckets[prim_bucket_idx];
 
+	/* Move the key to the current table if it is being resized */
+	if (unlikely(h->resize != NULL) &&
+			__hash_resize_migrate_key(h, sig) != 0)
+		ctx = h->resize;
+
 	__hash_rw_writer_lock(h);
+	/* No room to move the key, look for it in the drained buckets */
+	if (unlikely(ctx != NULL)) {
+		ret = search_and_remove(h, key,
+				&ctx->buckets[sig & ctx->bucket_bitmask],
+				short_sig, &pos);
+		if (ret == -1)
+			ret = search_and_remove(h, key,
+				&ctx->buckets[((sig & ctx->bucket_bitmask) ^
+					short_sig) & ctx->bucket_bitmask],
+				short_sig, &pos);
+		if (ret != -1) {
+			last_bkt = NULL;
+			goto return_bkt;
+		}
+	}
+
 	/* look for key in primary bucket */
 	ret = search_and_remove(h, key, prim_bkt, short_sig, &pos);
 	if (ret != -1) {
@@ -2190,12 +2468,8 @@ rte_hash_free_key_with_position(const struct rte_hash *h,
 
 	RETURN_IF_TRUE(((h == NULL) || (key_idx == EMPTY_SLOT)), -EINVAL);
 
-	const uint32_t total_entries = h->use_local_cache ?
-		h->entries + (RTE_MAX_LCORE - 1) * (LCORE_CACHE_SIZE - 1) + 1
-							: h->entries + 1;
-
 	/* Out of bounds */
-	if (key_idx >= total_entries)
+	if (key_idx >= h->num_key_slots)
 		return -EINVAL;
 	if (h->ext_table_support && h->readwrite_concur_lf_support) {
 		uint32_t index = h->ext_bkt_to_free[position];
@@ -2233,8 +2507,6 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 	uint32_t sec_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
 #endif
 
-	__hash_rw_reader_lock(h);
-
 	/* Compare signatures and prefetch key slot of first hit */
 	for (i = 0; i < num_keys; i++) {
 #if DENSE_HASH_BULK_LOOKUP
@@ -2353,15 +2625,15 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 	}
 
 	/* all found, do not need to go through ext bkt */
-	if ((hits == ((1ULL << num_keys) - 1)) || !h->ext_table_support) {
+	if ((hits == RTE_LEN2MASK(num_keys, uint64_t)) ||
+			(!h->ext_table_support && h->resize == NULL)) {
 		if (hit_mask != NULL)
 			*hit_mask = hits;
-		__hash_rw_reader_unlock(h);
 		return;
 	}
 
 	/* need to check ext buckets for match */
-	for (i = 0; i < num_keys; i++) {
+	for (i = 0; i < num_keys && h->ext_table_support; i++) {
 		if ((hits & (1ULL << i)) != 0)
 			continue;
 		next_bkt = secondary_bkt[i]->next;
@@ -2380,7 +2652,18 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 		}
 	}
 
-	__hash_rw_reader_unlock(h);
+	/* need to check the buckets not yet migrated by a resize */
+	for (i = 0; i < num_keys && h->resize != NULL; i++) {
+		if ((hits & (1ULL << i)) != 0)
+			continue;
+		ret = search_resize_bkts(h, h->resize, keys[i],
+				rte_hash_hash(h, keys[i]),
+				data != NULL ? &data[i] : NULL);
+		if (ret != -1) {
+			positions[i] = ret;
+			hits |= 1ULL << i;
+		}
+	}
 
 	if (hit_mask != NULL)
 		*hit_mask = hits;
@@ -2397,6 +2680,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 	int32_t i;
 	int32_t ret;
 	struct rte_hash_bucket *cur_bkt, *next_bkt;
+	struct rte_hash_resize_ctx *ctx;
 	uint32_t cnt_b, cnt_a;
 
 #if DENSE_HASH_BULK_LOOKUP
@@ -2546,7 +2830,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		}
 
 		/* all found, do not need to go through ext bkt */
-		if (hits == ((1ULL << num_keys) - 1)) {
+		if (hits == RTE_LEN2MASK(num_keys, uint64_t)) {
 			if (hit_mask != NULL)
 				*hit_mask = hits;
 			return;
@@ -2574,6 +2858,22 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 				}
 			}
 		}
+		/* need to check the buckets not yet migrated by a resize */
+		ctx = rte_atomic_load_explicit(&h->resize,
+				rte_memory_order_acquire);
+		if (unlikely(ctx != NULL)) {
+			for (i = 0; i < num_keys; i++) {
+				if ((hits & (1ULL << i)) != 0)
+					continue;
+				ret = search_resize_bkts(h, ctx, keys[i],
+						rte_hash_hash(h, keys[i]),
+						data != NULL ? &data[i] : NULL);
+				if (ret != -1) {
+					positions[i] = ret;
+					hits |= 1ULL << i;
+				}
+			}
+		}
 		/* The loads of sig_current in compare_signatures
 		 * should not move below the load from tbl_chng_cnt.
 		 */
@@ -2657,11 +2957,16 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *secondary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 
+	/* The bucket table can only be resized by the writer */
+	__hash_rw_reader_lock(h);
+
 	__bulk_lookup_prefetching_loop(h, keys, num_keys, sig,
 		primary_bkt, secondary_bkt);
 
 	__bulk_lookup_l(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
 		positions, hit_mask, data);
+
+	__hash_rw_reader_unlock(h);
 }
 
 static inline void
@@ -2737,6 +3042,9 @@ __rte_hash_lookup_with_hash_bulk_l(const struct rte_hash *h,
 	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 	const struct rte_hash_bucket *secondary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
 
+	/* The bucket table can only be resized by the writer */
+	__hash_rw_reader_lock(h);
+
 	/*
 	 * Prefetch keys, calculate primary and
 	 * secondary bucket and prefetch them
@@ -2757,6 +3065,8 @@ __rte_hash_lookup_with_hash_bulk_l(const struct rte_hash *h,
 
 	__bulk_lookup_l(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
 		positions, hit_mask, data);
+
+	__hash_rw_reader_unlock(h);
 }
 
 static inline void
@@ -2842,12 +3152,315 @@ rte_hash_lookup_with_hash_bulk_data(const struct rte_hash *h,
 	return rte_popcount64(*hit_mask);
 }
 
+#if DENSE_HASH_BULK_LOOKUP
+#define HITMASK_PADDING 0
+#else
+#define HITMASK_PADDING 1
+#endif
+
+/* Compute the buckets of a group of keys and prefetch them */
+static __rte_always_inline void
+__bulk_lookup_pipeline_bkts(const struct rte_hash *h, const void **keys,
+		int32_t first, int32_t last, uint16_t *sig,
+		const struct rte_hash_bucket **primary_bkt,
+		const struct rte_hash_bucket **secondary_bkt)
+{
+	uint32_t prim_hash, prim_index, sec_index;
+	int32_t i;
+
+	for (i = first; i < last; i++) {
+		prim_hash = rte_hash_hash(h, keys[i]);
+
+		sig[i] = get_short_sig(prim_hash);
+		prim_index = get_prim_bucket_index(h, prim_hash);
+		sec_index = get_alt_bucket_index(h, prim_index, sig[i]);
+
+		primary_bkt[i] = &h->buckets[prim_index];
+		secondary_bkt[i] = &h->buckets[sec_index];
+
+		rte_prefetch0(primary_bkt[i]);
+		rte_prefetch0(secondary_bkt[i]);
+	}
+}
+
+/* Compare the signatures of a group of keys and prefetch key slot of first hit */
+static __rte_always_inline void
+__bulk_lookup_pipeline_sigs(const struct rte_hash *h, int32_t first,
+		int32_t last, const uint16_t *sig,
+		const struct rte_hash_bucket **primary_bkt,
+		const struct rte_hash_bucket **secondary_bkt,
+		uint32_t *prim_hitmask, uint32_t *sec_hitmask)
+{
+	const struct rte_hash_bucket *bkt;
+	uint32_t hitmask, key_idx;
+	int32_t i;
+
+	for (i = first; i < last; i++) {
+#if DENSE_HASH_BULK_LOOKUP
+		uint16_t dense_hitmask = 0;
+
+		compare_signatures_dense(&dense_hitmask,
+			primary_bkt[i]->sig_current,
+			secondary_bkt[i]->sig_current,
+			sig[i], h->sig_cmp_fn);
+		prim_hitmask[i] = dense_hitmask &
+			RTE_LEN2MASK(RTE_HASH_BUCKET_ENTRIES, uint16_t);
+		sec_hitmask[i] = dense_hitmask >> RTE_HASH_BUCKET_ENTRIES;
+#else
+		prim_hitmask[i] = 0;
+		sec_hitmask[i] = 0;
+		compare_signatures_sparse(&prim_hitmask[i], &sec_hitmask[i],
+			primary_bkt[i], secondary_bkt[i],
+			sig[i], h->sig_cmp_fn);
+#endif
+
+		if (prim_hitmask[i]) {
+			bkt = primary_bkt[i];
+			hitmask = prim_hitmask[i];
+		} else if (sec_hitmask[i]) {
+			bkt = secondary_bkt[i];
+			hitmask = sec_hitmask[i];
+		} else
+			continue;
+
+		key_idx = bkt->key_idx[rte_ctz32(hitmask) >> HITMASK_PADDING];
+		rte_prefetch0((const char *)h->key_store +
+				key_idx * (size_t)h->key_entry_size);
+	}
+}
+
+/* Compare a key with the entries of a bucket matching its signature */
+static __rte_always_inline int32_t
+__bulk_lookup_pipeline_key(const struct rte_hash *h, const void *key,
+		const struct rte_hash_bucket *bkt, uint32_t hitmask,
+		void **data, const int lf)
+{
+	const struct rte_hash_key *key_slot;
+	uint32_t hit_index, key_idx;
+
+	while (hitmask) {
+		hit_index = rte_ctz32(hitmask) >> HITMASK_PADDING;
+		if (lf)
+			key_idx = rte_atomic_load_explicit(
+					&bkt->key_idx[hit_index],
+					rte_memory_order_acquire);
+		else
+			key_idx = bkt->key_idx[hit_index];
+		key_slot = (const struct rte_hash_key *)(
+				(const char *)h->key_store +
+				key_idx * (size_t)h->key_entry_size);
+
+		/*
+		 * If key index is 0, do not compare key,
+		 * as it is checking the dummy slot
+		 */
+		if (!!key_idx & !rte_hash_cmp_eq(key_slot->key, key, h)) {
+			if (data != NULL) {
+				if (lf)
+					*data = rte_atomic_load_explicit(
+						&key_slot->pdata,
+						rte_memory_order_acquire);
+				else
+					*data = key_slot->pdata;
+			}
+			return key_idx - 1;
+		}
+		hitmask &= ~(1 << (hit_index << HITMASK_PADDING));
+	}
+
+	return -ENOENT;
+}
+
+/*
+ * Bulk lookup software pipelined over groups of keys.
+ * Each round computes and prefetches the buckets of a group, compares the
+ * signatures and prefetches the key slots of the previous group, and
+ * compares the keys of the group before. Each memory access has two
+ * groups of work to complete before it is used, which hides the latency
+ * of the key store better than the stages of __rte_hash_lookup_bulk()
+ * when the table is much larger than the cache.
+ */
+static __rte_always_inline void
+__bulk_lookup_pipeline(const struct rte_hash *h, const void **keys,
+		int32_t num_keys, int32_t group_size, int32_t *positions,
+		uint64_t *hit_mask, void *data[], const int lf)
+{
+	uint16_t sig[RTE_HASH_LOOKUP_BULK_MAX];
+	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	const struct rte_hash_bucket *secondary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t prim_hitmask[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t sec_hitmask[RTE_HASH_LOOKUP_BULK_MAX];
+	const int32_t num_groups = (num_keys + group_size - 1) / group_size;
+	struct rte_hash_bucket *cur_bkt, *next_bkt;
+	struct rte_hash_resize_ctx *ctx;
+	uint32_t cnt_b = 0, cnt_a = 0;
+	int32_t g, i, first, last;
+	uint64_t hits;
+	int32_t ret;
+
+	/* The bucket table can only be resized by the writer */
+	if (!lf)
+		__hash_rw_reader_lock(h);
+
+	do {
+		/* Load the table change counter before the lookup
+		 * starts. Acquire semantics will make sure that
+		 * loads in compare_signatures are not hoisted.
+		 */
+		if (lf)
+			cnt_b = rte_atomic_load_explicit(h->tbl_chng_cnt,
+					rte_memory_order_acquire);
+		hits = 0;
+
+		for (i = 0; i < RTE_MIN(group_size, num_keys); i++)
+			rte_prefetch0(keys[i]);
+
+		for (g = 0; g < num_groups + 2; g++) {
+			/* Stage 1: prefetch the buckets of group g,
+			 * and the keys of the next group
+			 */
+			if (g < num_groups) {
+				first = g * group_size;
+				last = RTE_MIN(first + group_size, num_keys);
+				for (i = last;
+				     i < RTE_MIN(last + group_size, num_keys);
+				     i++)
+					rte_prefetch0(keys[i]);
+				__bulk_lookup_pipeline_bkts(h, keys, first,
+					last, sig, primary_bkt, secondary_bkt);
+			}
+
+			/* Stage 2: compare the signatures of group g - 1 */
+			if (g >= 1 && g <= num_groups) {
+				first = (g - 1) * group_size;
+				last = RTE_MIN(first + group_size, num_keys);
+				__bulk_lookup_pipeline_sigs(h, first, last,
+					sig, primary_bkt, secondary_bkt,
+					prim_hitmask, sec_hitmask);
+			}
+
+			/* Stage 3: compare the keys of group g - 2,
+			 * first hits in primary first
+			 */
+			if (g >= 2) {
+				first = (g - 2) * group_size;
+				last = RTE_MIN(first + group_size, num_keys);
+				for (i = first; i < last; i++) {
+					ret = __bulk_lookup_pipeline_key(h,
+						keys[i], primary_bkt[i],
+						prim_hitmask[i],
+						data != NULL ? &data[i] : NULL,
+						lf);
+					if (ret == -ENOENT)
+						ret = __bulk_lookup_pipeline_key(h,
+							keys[i],
+							secondary_bkt[i],
+							sec_hitmask[i],
+							data != NULL ?
+							&data[i] : NULL, lf);
+					positions[i] = ret;
+					if (ret != -ENOENT)
+						hits |= 1ULL << i;
+				}
+			}
+		}
+
+		if (hits == RTE_LEN2MASK(num_keys, uint64_t))
+			break;
+
+		/* need to check ext buckets for match */
+		for (i = 0; i < num_keys && h->ext_table_support; i++) {
+			if ((hits & (1ULL << i)) != 0)
+				continue;
+			next_bkt = secondary_bkt[i]->next;
+			FOR_EACH_BUCKET(cur_bkt, next_bkt) {
+				if (lf)
+					ret = search_one_bucket_lf(h, keys[i],
+						sig[i], data != NULL ?
+						&data[i] : NULL, cur_bkt);
+				else
+					ret = search_one_bucket_l(h, keys[i],
+						sig[i], data != NULL ?
+						&data[i] : NULL, cur_bkt);
+				if (ret != -1) {
+					positions[i] = ret;
+					hits |= 1ULL << i;
+					break;
+				}
+			}
+		}
+
+		/* need to check the buckets not yet migrated by a resize */
+		ctx = rte_atomic_load_explicit(&h->resize,
+				rte_memory_order_acquire);
+		for (i = 0; i < num_keys && ctx != NULL; i++) {
+			if ((hits & (1ULL << i)) != 0)
+				continue;
+			ret = search_resize_bkts(h, ctx, keys[i],
+					rte_hash_hash(h, keys[i]),
+					data != NULL ? &data[i] : NULL);
+			if (ret != -1) {
+				positions[i] = ret;
+				hits |= 1ULL << i;
+			}
+		}
+
+		if (lf) {
+			/* The loads of sig_current in compare_signatures
+			 * should not move below the load from tbl_chng_cnt.
+			 */
+			rte_atomic_thread_fence(rte_memory_order_acquire);
+			/* Re-read the table change counter to check if the
+			 * table has changed during search. If yes, re-do
+			 * the search.
+			 */
+			cnt_a = rte_atomic_load_explicit(h->tbl_chng_cnt,
+					rte_memory_order_acquire);
+		}
+	} while (cnt_b != cnt_a);
+
+	if (!lf)
+		__hash_rw_reader_unlock(h);
+
+	if (hit_mask != NULL)
+		*hit_mask = hits;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_lookup_bulk_data_pipeline, 26.11)
+int
+rte_hash_lookup_bulk_data_pipeline(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, uint32_t group_size, uint64_t *hit_mask,
+		void *data[])
+{
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(hit_mask == NULL)), -EINVAL);
+
+	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
+
+	if (group_size == 0)
+		group_size = RTE_HASH_LOOKUP_PIPELINE_GROUP_SIZE;
+	if (group_size > num_keys)
+		group_size = num_keys;
+
+	if (h->readwrite_concur_lf_support)
+		__bulk_lookup_pipeline(h, keys, num_keys, group_size,
+				positions, hit_mask, data, 1);
+	else
+		__bulk_lookup_pipeline(h, keys, num_keys, group_size,
+				positions, hit_mask, data, 0);
+
+	/* Return number of hits */
+	return rte_popcount64(*hit_mask);
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_iterate)
 int32_t
 rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32_t *next)
 {
 	uint32_t bucket_idx, idx, position;
 	struct rte_hash_key *next_key;
+	struct rte_hash_resize_ctx *ctx;
 
 	RETURN_IF_TRUE(((h == NULL) || (next == NULL)), -EINVAL);
 
@@ -2890,6 +3503,35 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 
 /* Begin to iterate extendable buckets */
 extend_table:
+	/* A table being resized has no extendable buckets, the buckets
+	 * not yet migrated are iterated instead.
+	 */
+	ctx = rte_atomic_load_explicit(&h->resize, rte_memory_order_acquire);
+	if (ctx != NULL) {
+		const uint32_t total_entries_resize = total_entries_main +
+				ctx->num_buckets * RTE_HASH_BUCKET_ENTRIES;
+
+		if (*next >= total_entries_resize)
+			return -ENOENT;
+
+		bucket_idx = (*next - total_entries_main) /
+						RTE_HASH_BUCKET_ENTRIES;
+		idx = (*next - total_entries_main) % RTE_HASH_BUCKET_ENTRIES;
+
+		while ((position = rte_atomic_load_explicit(
+				&ctx->buckets[bucket_idx].key_idx[idx],
+				rte_memory_order_acquire)) == EMPTY_SLOT) {
+			(*next)++;
+			if (*next == total_entries_resize)
+				return -ENOENT;
+			bucket_idx = (*next - total_entries_main) /
+						RTE_HASH_BUCKET_ENTRIES;
+			idx = (*next - total_entries_main) %
+						RTE_HASH_BUCKET_ENTRIES;
+		}
+		goto return_key;
+	}
+
 	/* Out of total bound or if ext bucket feature is not enabled */
 	if (*next >= total_entries || !h->ext_table_support)
 		return -ENOENT;
@@ -2905,6 +3547,7 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 						RTE_HASH_BUCKET_ENTRIES;
 		idx = (*next - total_entries_main) % RTE_HASH_BUCKET_ENTRIES;
 	}
+return_key:
 	__hash_rw_reader_lock(h);
 	next_key = (struct rte_hash_key *) ((char *)h->key_store +
 				position * (size_t)h->key_entry_size);
@@ -2918,3 +3561,309 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 	(*next)++;
 	return position - 1;
 }
+
+/*
+ * Reallocate the key store with room for @num_key_slots key slots.
+ * The previous key store is returned in @old_k, to be freed once the
+ * readers are done with it.
+ */
+static int
+__hash_resize_key_store(struct rte_hash *h, uint32_t num_key_slots,
+		void **old_k)
+{
+	void *k;
+
+	k = rte_zmalloc_socket(NULL, (size_t)h->key_entry_size * num_key_slots,
+			RTE_CACHE_LINE_SIZE, h->socket_id);
+	if (k == NULL) {
+		HASH_LOG(ERR, "key store memory allocation failed");
+		return -ENOMEM;
+	}
+
+	*old_k = h->key_store;
+	memcpy(k, *old_k, (size_t)h->key_entry_size *
+			RTE_MIN(num_key_slots, h->num_key_slots));
+	/* The copy of the keys should not leak after the store
+	 * of the key store pointer.
+	 */
+	rte_atomic_thread_fence(rte_memory_order_release);
+	h->key_store = k;
+	h->num_key_slots = num_key_slots;
+
+	return 0;
+}
+
+/* Reallocate the ring of free key slots with room for @count slots. */
+static int
+__hash_resize_free_slots(struct rte_hash *h, uint32_t count)
+{
+	uint32_t slots[LCORE_CACHE_SIZE];
+	struct rte_ring *r;
+	unsigned int n;
+	ssize_t sz;
+
+	sz = rte_ring_get_memsize_elem(sizeof(uint32_t), count);
+	if (sz < 0)
+		return sz;
+
+	r = rte_zmalloc_socket(NULL, sz, RTE_CACHE_LINE_SIZE, h->socket_id);
+	if (r == NULL) {
+		HASH_LOG(ERR, "free slots ring memory allocation failed");
+		return -ENOMEM;
+	}
+
+	if (rte_ring_init(r, h->free_slots->name, count, 0) != 0) {
+		rte_free(r);
+		return -EINVAL;
+	}
+
+	while ((n = rte_ring_sc_dequeue_burst_elem(h->free_slots, slots,
+			sizeof(uint32_t), RTE_DIM(slots), NULL)) != 0)
+		rte_ring_sp_enqueue_bulk_elem(r, slots, sizeof(uint32_t), n,
+				NULL);
+
+	free_slots_ring_free(h->free_slots);
+	h->free_slots = r;
+
+	return 0;
+}
+
+/*
+ * Start draining the bucket table into @buckets.
+ * Lock free readers may load the bucket table and its bitmask in any
+ * order, so the table is switched in two steps separated by a grace
+ * period. That way, an index is never applied to a smaller table than
+ * the one it was computed for. Until the switch is complete, readers
+ * find the keys in the drained buckets.
+ */
+static void
+__hash_resize_publish(struct rte_hash *h, struct rte_hash_resize_ctx *ctx,
+		struct rte_hash_bucket *buckets, uint32_t num_buckets)
+{
+	ctx->buckets = h->buckets;
+	ctx->num_buckets = h->num_buckets;
+	ctx->bucket_bitmask = h->bucket_bitmask;
+	ctx->next_bkt = 0;
+	rte_atomic_store_explicit(&h->resize, ctx, rte_memory_order_release);
+	__hash_resize_sync(h);
+
+	if (num_buckets > h->num_buckets) {
+		h->buckets = buckets;
+		__hash_resize_sync(h);
+		h->bucket_bitmask = num_buckets - 1;
+	} else {
+		h->bucket_bitmask = num_buckets - 1;
+		__hash_resize_sync(h);
+		h->buckets = buckets;
+	}
+	h->num_buckets = num_buckets;
+
+	/* No entry can be migrated while readers use the previous table */
+	__hash_resize_sync(h);
+}
+
+/*
+ * Release the key slots retired by a shrink. Deleted keys waiting in the
+ * defer queue are read when they are reclaimed, so the key store is only
+ * shrunk once none of them is pending. Otherwise it is retried by the
+ * next call to rte_hash_resize_step().
+ */
+static void
+__hash_resize_trim_key_store(struct rte_hash *h)
+{
+	unsigned int pending = 0;
+	void *old_k = NULL;
+
+	if (h->num_key_slots <= h->entries + 1)
+		return;
+
+	/* Let the keys deleted so far reach the end of their grace period */
+	if (h->dq)
+		__hash_resize_sync(h);
+
+	__hash_rw_writer_lock(h);
+
+	if (h->dq)
+		rte_rcu_qsbr_dq_reclaim(h->dq, ~0, NULL, &pending, NULL);
+	if (pending == 0 &&
+			__hash_resize_key_store(h, h->entries + 1, &old_k) != 0)
+		HASH_LOG(NOTICE, "%s: key store of %s kept at %u slots",
+			__func__, h->name, h->num_key_slots);
+
+	__hash_rw_writer_unlock(h);
+
+	if (old_k != NULL) {
+		__hash_resize_sync(h);
+		rte_free(old_k);
+	}
+}
+
+/* Release the drained buckets and the retired key slots. */
+static void
+__hash_resize_finish(struct rte_hash *h)
+{
+	struct rte_hash_resize_ctx *ctx = h->resize;
+
+	__hash_rw_writer_lock(h);
+	rte_atomic_store_explicit(&h->resize, NULL, rte_memory_order_release);
+	__hash_rw_writer_unlock(h);
+
+	__hash_resize_sync(h);
+	rte_free(ctx->buckets);
+	rte_free(ctx);
+
+	__hash_resize_trim_key_store(h);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_resize, 26.11)
+int
+rte_hash_resize(struct rte_hash *h, uint32_t entries)
+{
+	struct rte_hash_resize_ctx *ctx = NULL;
+	struct rte_hash_bucket *buckets = NULL;
+	void *old_key_store = NULL;
+	uint32_t num_buckets, n, i, slot_id;
+	uint32_t retired_free = 0;
+	unsigned int pending;
+	int ret = 0;
+
+	if (h == NULL || entries < RTE_HASH_BUCKET_ENTRIES ||
+			entries > RTE_HASH_ENTRIES_MAX)
+		return -EINVAL;
+
+	/* Slots cached per lcore and extendable buckets are not migrated */
+	if (h->use_local_cache || h->ext_table_support)
+		return -ENOTSUP;
+
+	/* Lock free readers are waited for with the integrated RCU */
+	if (h->readwrite_concur_lf_support && h->hash_rcu_cfg == NULL)
+		return -EINVAL;
+
+	if (h->resize != NULL)
+		return -EBUSY;
+
+	if (entries == h->entries)
+		return 0;
+
+	if (entries < h->entries) {
+		/* Deleted keys pending reclamation still use their slot */
+		if (h->dq)
+			rte_rcu_qsbr_dq_reclaim(h->dq, ~0, NULL, &pending, NULL);
+		if ((uint32_t)rte_hash_count(h) > entries)
+			return -ENOSPC;
+	}
+
+	num_buckets = rte_align32pow2(entries) / RTE_HASH_BUCKET_ENTRIES;
+
+	/* Shrinking always migrates the buckets to free the key slots
+	 * above the new capacity.
+	 */
+	if (num_buckets != h->num_buckets || entries < h->entries) {
+		ctx = rte_zmalloc_socket(NULL, sizeof(*ctx),
+				RTE_CACHE_LINE_SIZE, h->socket_id);
+		buckets = rte_zmalloc_socket(NULL,
+				num_buckets * sizeof(struct rte_hash_bucket),
+				RTE_CACHE_LINE_SIZE, h->socket_id);
+		if (ctx == NULL || buckets == NULL) {
+			HASH_LOG(ERR, "buckets memory allocation failed");
+			rte_free(ctx);
+			rte_free(buckets);
+			return -ENOMEM;
+		}
+	}
+
+	__hash_rw_writer_lock(h);
+
+	if (entries > h->entries) {
+		if (entries + 1 > h->num_key_slots) {
+			ret = __hash_resize_key_store(h, entries + 1,
+					&old_key_store);
+			if (ret != 0)
+				goto err_unlock;
+		}
+		if (entries > rte_ring_get_capacity(h->free_slots)) {
+			ret = __hash_resize_free_slots(h,
+					rte_align32pow2(entries + 1));
+			if (ret != 0)
+				goto err_unlock;
+		}
+	}
+
+	if (ctx != NULL)
+		__hash_resize_publish(h, ctx, buckets, num_buckets);
+
+	if (entries > h->entries) {
+		/* Key slots are only handed out once readers see the
+		 * grown key store.
+		 */
+		for (i = h->entries + 1; i <= entries; i++)
+			rte_ring_sp_enqueue_elem(h->free_slots, &i,
+					sizeof(uint32_t));
+	} else {
+		/* Retire the free key slots above the new capacity */
+		n = rte_ring_count(h->free_slots);
+		for (i = 0; i < n; i++) {
+			if (rte_ring_sc_dequeue_elem(h->free_slots, &slot_id,
+					sizeof(uint32_t)) != 0)
+				break;
+			if (slot_id <= entries)
+				rte_ring_sp_enqueue_elem(h->free_slots,
+						&slot_id, sizeof(uint32_t));
+			else
+				retired_free++;
+		}
+		ctx->retired_slots = h->entries - entries - retired_free;
+	}
+	h->entries = entries;
+
+	__hash_rw_writer_unlock(h);
+
+	if (old_key_store != NULL) {
+		__hash_resize_sync(h);
+		rte_free(old_key_store);
+	}
+
+	return 0;
+
+err_unlock:
+	__hash_rw_writer_unlock(h);
+	if (old_key_store != NULL) {
+		__hash_resize_sync(h);
+		rte_free(old_key_store);
+	}
+	rte_free(ctx);
+	rte_free(buckets);
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_hash_resize_step, 26.11)
+int
+rte_hash_resize_step(struct rte_hash *h, uint32_t num_buckets)
+{
+	struct rte_hash_resize_ctx *ctx;
+	int ret;
+
+	if (h == NULL)
+		return -EINVAL;
+
+	ctx = h->resize;
+	if (ctx == NULL) {
+		/* The key store may still wait to be shrunk */
+		__hash_resize_trim_key_store(h);
+		return 0;
+	}
+
+	while (num_buckets-- > 0 && ctx->next_bkt < ctx->num_buckets) {
+		ret = __hash_resize_migrate_bkt(h, ctx, ctx->next_bkt);
+		if (ret != 0)
+			return ret;
+		ctx->next_bkt++;
+	}
+
+	if (ctx->next_bkt < ctx->num_buckets)
+		return ctx->num_buckets - ctx->next_bkt;
+
+	__hash_resize_finish(h);
+
+	return 0;
+}
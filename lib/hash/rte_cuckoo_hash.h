@@ -67,6 +67,17 @@ struct __rte_cache_aligned rte_hash_bucket {
 	void *next;
 };
 
+/** State of an in-progress resize of the bucket table. */
+struct rte_hash_resize_ctx {
+	struct rte_hash_bucket *buckets;
+	/**< Previous buckets, drained into the new table by the resize. */
+	uint32_t num_buckets;           /**< Number of previous buckets. */
+	uint32_t bucket_bitmask;        /**< Bitmask of previous buckets. */
+	uint32_t next_bkt;              /**< Next previous bucket to migrate. */
+	uint32_t retired_slots;
+	/**< Key slots still in use above the capacity of a shrunk table. */
+};
+
 /** A hash table structure. */
 struct __rte_cache_aligned rte_hash {
 	char name[RTE_HASH_NAMESIZE];   /**< Name of the hash. */
@@ -136,6 +147,10 @@ struct __rte_cache_aligned rte_hash {
 	uint32_t *ext_bkt_to_free;
 	RTE_ATOMIC(uint32_t) *tbl_chng_cnt;
 	/**< Indicates if the hash table changed from last read. */
+	uint32_t num_key_slots;         /**< Number of slots in the key store. */
+	int socket_id;                  /**< NUMA socket ID for memory. */
+	RTE_ATOMIC(struct rte_hash_resize_ctx *) resize;
+	/**< Resize in progress, NULL if none. */
 };
 
 struct queue_node {
@@ -31,6 +31,9 @@ extern "C" {
 #define RTE_HASH_LOOKUP_BULK_MAX		64
 #define RTE_HASH_LOOKUP_MULTI_MAX		RTE_HASH_LOOKUP_BULK_MAX
 
+/** Default number of keys per group for rte_hash_lookup_bulk_data_pipeline. */
+#define RTE_HASH_LOOKUP_PIPELINE_GROUP_SIZE	8
+
 /** Enable Hardware transactional memory support. */
 #define RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT	0x01
 
@@ -639,6 +642,47 @@ int
 rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
 		      uint32_t num_keys, int32_t *positions);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Find multiple keys in the hash table, pipelining the lookup stages
+ * across groups of keys.
+ *
+ * The keys are split into groups of @p group_size keys. While the buckets
+ * of a group are being fetched, the signatures of the previous group are
+ * compared and its key slots prefetched, and the keys of the group before
+ * are compared. This hides more memory latency than
+ * rte_hash_lookup_bulk_data() when the table does not fit in the cache,
+ * at the cost of some overhead for small tables.
+ *
+ * This operation is multi-thread safe with regarding to other lookup threads.
+ * Read-write concurrency can be enabled by setting flag during
+ * table creation.
+ *
+ * @param h
+ *   Hash table to look in.
+ * @param keys
+ *   A pointer to a list of keys to look for.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param group_size
+ *   Number of keys per group, 0 for RTE_HASH_LOOKUP_PIPELINE_GROUP_SIZE.
+ *   Larger groups issue more prefetches at once, smaller groups leave
+ *   more stages in flight for a given burst.
+ * @param hit_mask
+ *   Output containing a bitmask with all successful lookups.
+ * @param data
+ *   Output containing array of data returned from all the successful lookups.
+ * @return
+ *   -EINVAL if there's an error, otherwise number of successful lookups.
+ */
+__rte_experimental
+int
+rte_hash_lookup_bulk_data_pipeline(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, uint32_t group_size, uint64_t *hit_mask,
+		void *data[]);
+
 /**
  * Iterate through the hash table, returning key-value pairs.
  *
@@ -704,6 +748,72 @@ __rte_experimental
 int rte_hash_rcu_qsbr_dq_reclaim(struct rte_hash *h, unsigned int *freed,
 		unsigned int *pending, unsigned int *available);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Start resizing a hash table to a new number of entries.
+ *
+ * The key store is reallocated to the new capacity right away, then the
+ * buckets are migrated incrementally to a new bucket table. Until the
+ * migration is complete, lookups also search the buckets not yet
+ * migrated, and adding or deleting a key first migrates the buckets
+ * it may be stored in. The remaining buckets are migrated by calling
+ * rte_hash_resize_step().
+ *
+ * Resizing is a write operation, it must be serialized with the other
+ * writers of the table. With lock free read-write concurrency, the RCU
+ * QSBR variable attached with rte_hash_rcu_qsbr_add() is used to wait
+ * for the readers before releasing memory, so it must not be called
+ * from a reader thread.
+ *
+ * The buckets are migrated by recomputing the hash of the keys, so keys
+ * must have been added with the hash function of the table.
+ * Growing a table keeps the position of the keys. Shrinking a table may
+ * move keys stored above the new capacity to a new position.
+ *
+ * @param h
+ *   Hash table to resize.
+ * @param entries
+ *   New number of entries of the table.
+ * @return
+ *   - 0 if the resize started or completed.
+ *   - -EINVAL if the parameters are invalid, or if lock free read-write
+ *     concurrency is enabled without RCU QSBR attached.
+ *   - -ENOTSUP if the table uses extendable buckets or multiple writers.
+ *   - -EBUSY if a resize is already in progress.
+ *   - -ENOSPC if the table holds more keys than @p entries.
+ *   - -ENOMEM if memory allocation failed.
+ */
+__rte_experimental
+int
+rte_hash_resize(struct rte_hash *h, uint32_t entries);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Migrate some buckets of a hash table being resized.
+ * The resize is completed and the previous buckets are freed once
+ * all of them are migrated.
+ *
+ * It must be called from the writer context, like rte_hash_resize().
+ *
+ * @param h
+ *   Hash table being resized.
+ * @param num_buckets
+ *   Maximum number of buckets to migrate.
+ * @return
+ *   - 0 if no resize is in progress anymore.
+ *   - Number of buckets still to migrate.
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOSPC if the new bucket table has no room for an entry,
+ *     which is left in place until a later call.
+ */
+__rte_experimental
+int
+rte_hash_resize_step(struct rte_hash *h, uint32_t num_buckets);
+
 #ifdef __cplusplus
 }
 #endif
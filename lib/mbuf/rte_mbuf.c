@@ -555,6 +555,69 @@ __rte_pktmbuf_free_seg_via_array(struct rte_mbuf *m,
  */
 #define RTE_PKTMBUF_FREE_PENDING_SZ 64
 
+/**
+ * @internal Free the leading direct single segment mbufs of a bulk
+ * straight into the mempool cache of the first mbuf, without going
+ * through an intermediate array.
+ *
+ * Freeing a direct mbuf does not put anything else in a mempool,
+ * so the cache slots can be reserved before the mbufs are released.
+ *
+ * @param mbufs
+ *  Array of pointers to packet mbufs.
+ * @param count
+ *  Array size.
+ * @return
+ *  The number of leading array entries handled.
+ */
+static unsigned int
+__rte_pktmbuf_free_bulk_zc(struct rte_mbuf **mbufs, unsigned int count)
+{
+	struct rte_mempool_cache *cache;
+	struct rte_mempool *mp;
+	struct rte_mbuf *m;
+	unsigned int idx, nb_free = 0;
+	void **objs;
+
+	if (unlikely(mbufs[0] == NULL))
+		return 0;
+
+	mp = mbufs[0]->pool;
+	cache = rte_mempool_default_cache(mp, rte_lcore_id());
+	if (unlikely(cache == NULL))
+		return 0;
+
+	count = RTE_MIN(count, cache->size / 2);
+	if (unlikely(count == 0))
+		return 0;
+	objs = rte_mempool_cache_zc_put_bulk(cache, mp, count);
+	if (unlikely(objs == NULL))
+		return 0;
+
+	for (idx = 0; idx < count; idx++) {
+		m = mbufs[idx];
+		if (unlikely(m == NULL))
+			continue;
+		if (unlikely(m->pool != mp || m->next != NULL ||
+				!RTE_MBUF_DIRECT(m)))
+			break;
+
+		__rte_mbuf_sanity_check(m, 1);
+		m = rte_pktmbuf_prefree_seg(m);
+		if (unlikely(m == NULL))
+			continue;
+
+		__rte_mbuf_raw_sanity_check_mp(m, mp);
+		objs[nb_free++] = m;
+	}
+
+	rte_mbuf_history_mark_bulk((struct rte_mbuf **)objs, nb_free,
+			RTE_MBUF_HISTORY_OP_LIB_FREE);
+	rte_mempool_cache_zc_put_rewind(cache, count - nb_free);
+
+	return idx;
+}
+
 /* Free a bulk of packet mbufs back into their original mempools. */
 RTE_EXPORT_SYMBOL(rte_pktmbuf_free_bulk)
 void rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count)
@@ -562,7 +625,10 @@ void rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count)
 	struct rte_mbuf *m, *m_next, *pending[RTE_PKTMBUF_FREE_PENDING_SZ];
 	unsigned int idx, nb_pending = 0;
 
-	for (idx = 0; idx < count; idx++) {
+	if (unlikely(count == 0))
+		return;
+
+	for (idx = __rte_pktmbuf_free_bulk_zc(mbufs, count); idx < count; idx++) {
 		m = mbufs[idx];
 		if (unlikely(m == NULL))
 			continue;
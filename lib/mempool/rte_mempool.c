@@ -787,6 +787,73 @@ rte_mempool_cache_create(uint32_t size, int socket_id)
 	return cache;
 }
 
+/*
+ * Adapt the size of a cache of an adaptive mempool, every
+ * RTE_MEMPOOL_CACHE_ADAPT_PERIOD flushes and refills of this cache.
+ *
+ * An lcore both flushing and refilling its cache bounces objects through
+ * the common pool, so its cache grows until it absorbs the difference
+ * between its puts and gets. An lcore only putting or only getting
+ * objects cannot avoid the common pool, so its cache shrinks to limit the
+ * number of objects stranded there, as long as it can still hold two
+ * bulks of the size triggering the adaptation. Yet the cache of an lcore
+ * on another socket than the pool does not shrink: each access to the
+ * common pool crosses the interconnect there, so it is worth keeping
+ * large bulks.
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mempool_cache_adapt, 26.11)
+void
+rte_mempool_cache_adapt(struct rte_mempool *mp,
+	struct rte_mempool_cache *cache, unsigned int n)
+{
+	uint32_t flushes = cache->flushes;
+	uint32_t refills = cache->refills;
+	uint32_t size = cache->size;
+	uint32_t min_size, max_size, count;
+	int socket_id;
+
+	cache->flushes = 0;
+	cache->refills = 0;
+
+	/* Caches of a pool without default caches are not adapted. */
+	if (mp->cache_size == 0)
+		return;
+
+	min_size = RTE_MAX(mp->cache_size / 4, RTE_MIN(mp->cache_size, 2U));
+	min_size = RTE_MAX(min_size, RTE_MIN(n * 2, size));
+	max_size = RTE_MIN(mp->cache_size * 4,
+		(uint32_t)RTE_MEMPOOL_CACHE_MAX_SIZE);
+	max_size = RTE_MIN(max_size, mp->size);
+
+	socket_id = mp->socket_id;
+	if (socket_id == SOCKET_ID_ANY)
+		socket_id = mp->mz->socket_id;
+
+	if (RTE_MIN(flushes, refills) * 4 >= flushes + refills) {
+		/* Objects bounce through the common pool. */
+		if (size >= max_size)
+			return;
+		cache->size = RTE_MIN(size * 2, max_size);
+		cache->grows++;
+	} else {
+		/* One-way traffic, unless the lcore is remote. */
+		if (size <= min_size ||
+				(int)rte_socket_id() != socket_id)
+			return;
+		cache->size = RTE_MAX(size / 2, min_size);
+		cache->shrinks++;
+
+		/* Flush the coldest objects not fitting anymore. */
+		if (cache->len > cache->size) {
+			count = cache->len - cache->size / 2;
+			rte_mempool_ops_enqueue_bulk(mp, &cache->objs[0], count);
+			memmove(&cache->objs[0], &cache->objs[count],
+				sizeof(void *) * (cache->len - count));
+			cache->len -= count;
+		}
+	}
+}
+
 /*
  * Free a cache. It's the responsibility of the user to make sure that any
  * remaining objects in the cache are flushed to the corresponding
@@ -1077,6 +1144,9 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 		return count;
 
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (mp->local_cache[lcore_id].size != mp->cache_size)
+			fprintf(f, "    cache_size[%u]=%"PRIu32"\n",
+				lcore_id, mp->local_cache[lcore_id].size);
 		cache_count = mp->local_cache[lcore_id].len;
 		if (cache_count == 0)
 			continue;
@@ -1664,10 +1734,72 @@ mempool_handle_info(const char *cmd __rte_unused, const char *params,
 	return 0;
 }
 
+static void
+mempool_cache_cb(struct rte_mempool *mp, void *arg)
+{
+	struct mempool_info_cb_arg *info = (struct mempool_info_cb_arg *)arg;
+	const struct rte_mempool_cache *cache;
+	struct rte_tel_data *c;
+	char lcore_str[16];
+	unsigned int lcore_id;
+
+	if (strncmp(mp->name, info->pool_name, RTE_MEMZONE_NAMESIZE))
+		return;
+
+	rte_tel_data_add_dict_string(info->d, "name", mp->name);
+	rte_tel_data_add_dict_uint(info->d, "cache_size", mp->cache_size);
+	rte_tel_data_add_dict_uint(info->d, "adaptive",
+		!!(mp->flags & RTE_MEMPOOL_F_CACHE_ADAPTIVE));
+
+	if (mp->cache_size == 0)
+		return;
+
+	/* Caches which are used or were adapted, indexed by lcore. */
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		cache = &mp->local_cache[lcore_id];
+		if (cache->len == 0 && cache->grows == 0 &&
+				cache->shrinks == 0)
+			continue;
+
+		c = rte_tel_data_alloc();
+		if (c == NULL)
+			return;
+		rte_tel_data_start_dict(c);
+		rte_tel_data_add_dict_uint(c, "size", cache->size);
+		rte_tel_data_add_dict_uint(c, "len", cache->len);
+		rte_tel_data_add_dict_uint(c, "grows", cache->grows);
+		rte_tel_data_add_dict_uint(c, "shrinks", cache->shrinks);
+		snprintf(lcore_str, sizeof(lcore_str), "%u", lcore_id);
+		rte_tel_data_add_dict_container(info->d, lcore_str, c, 0);
+	}
+}
+
+static int
+mempool_handle_cache(const char *cmd __rte_unused, const char *params,
+		     struct rte_tel_data *d)
+{
+	struct mempool_info_cb_arg mp_arg;
+	char name[RTE_MEMZONE_NAMESIZE];
+
+	if (!params || strlen(params) == 0)
+		return -EINVAL;
+
+	rte_strlcpy(name, params, RTE_MEMZONE_NAMESIZE);
+
+	rte_tel_data_start_dict(d);
+	mp_arg.pool_name = name;
+	mp_arg.d = d;
+	rte_mempool_walk(mempool_cache_cb, &mp_arg);
+
+	return 0;
+}
+
 RTE_INIT(mempool_init_telemetry)
 {
 	rte_telemetry_register_cmd("/mempool/list", mempool_handle_list,
 		"Returns list of available mempool. Takes no parameters");
 	rte_telemetry_register_cmd("/mempool/info", mempool_handle_info,
 		"Returns mempool info. Parameters: pool_name");
+	rte_telemetry_register_cmd("/mempool/cache", mempool_handle_cache,
+		"Returns the per-lcore caches of a mempool. Parameters: pool_name");
 }
@@ -35,6 +35,7 @@
  */
 
 #include <stdalign.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <inttypes.h>
@@ -91,8 +92,12 @@ struct __rte_cache_aligned rte_mempool_cache {
 	uint32_t size;	      /**< Size of the cache */
 	uint32_t flushthresh; /**< Obsolete; for API/ABI compatibility purposes only */
 	uint32_t len;	      /**< Current cache count */
+	/* Adaptive size, see RTE_MEMPOOL_F_CACHE_ADAPTIVE. */
+	uint16_t flushes;     /**< Flushes since the last adaptation */
+	uint16_t refills;     /**< Refills since the last adaptation */
+	uint32_t grows;       /**< Number of times the size was increased */
+	uint32_t shrinks;     /**< Number of times the size was decreased */
 #ifdef RTE_LIBRTE_MEMPOOL_STATS
-	uint32_t unused;
 	/*
 	 * Alternative location for the most frequently updated mempool statistics (per-lcore),
 	 * providing faster update access when using a mempool cache.
@@ -312,6 +317,8 @@ struct __rte_cache_aligned rte_mempool {
 #define MEMPOOL_F_NO_IOVA_CONTIG	RTE_MEMPOOL_F_NO_IOVA_CONTIG
 /** Internal: no object from the pool can be used for device IO (DMA). */
 #define RTE_MEMPOOL_F_NON_IO		0x0040
+/** Adapt the size of the default caches to the lcores traffic. */
+#define RTE_MEMPOOL_F_CACHE_ADAPTIVE	0x0080
 
 /**
  * This macro lists all the mempool flags an application may request.
@@ -321,6 +328,7 @@ struct __rte_cache_aligned rte_mempool {
 	| RTE_MEMPOOL_F_SP_PUT \
 	| RTE_MEMPOOL_F_SC_GET \
 	| RTE_MEMPOOL_F_NO_IOVA_CONTIG \
+	| RTE_MEMPOOL_F_CACHE_ADAPTIVE \
 	)
 
 /**
@@ -718,7 +726,7 @@ struct __rte_cache_aligned rte_mempool_ops {
 	rte_mempool_dequeue_contig_blocks_t dequeue_contig_blocks;
 };
 
-#define RTE_MEMPOOL_MAX_OPS_IDX 16  /**< Max registered ops structs */
+#define RTE_MEMPOOL_MAX_OPS_IDX 32  /**< Max registered ops structs */
 
 /**
  * Structure storing the table of registered ops structs, each of which contain
@@ -1103,6 +1111,11 @@ rte_mempool_free(struct rte_mempool *mp);
  *     "single-consumer". Otherwise, it is "multi-consumers".
  *   - RTE_MEMPOOL_F_NO_IOVA_CONTIG: If set, allocated objects won't
  *     necessarily be contiguous in IO memory.
+ *   - RTE_MEMPOOL_F_CACHE_ADAPTIVE: If set, the size of the cache of each
+ *     lcore changes between a quarter and four times *cache_size*,
+ *     depending on the flushes to and refills from the common pool
+ *     done by this lcore. The caches are adapted only by the code built
+ *     with ALLOW_EXPERIMENTAL_API, see rte_mempool_cache_adapt().
  * @return
  *   The pointer to the new allocated mempool, on success. NULL on error
  *   with rte_errno set appropriately. Possible rte_errno values include:
@@ -1400,6 +1413,64 @@ rte_mempool_cache_flush(struct rte_mempool_cache *cache,
 	cache->len = 0;
 }
 
+/** @internal Number of flushes and refills between two cache adaptations. */
+#define RTE_MEMPOOL_CACHE_ADAPT_PERIOD 64
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Adapt the size of a cache to its recent flushes and refills.
+ * Called by the lcore owning the cache, when the cache is consistent.
+ * The put and get functions call it for the pools created with
+ * RTE_MEMPOOL_F_CACHE_ADAPTIVE, when built with ALLOW_EXPERIMENTAL_API.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to the mempool cache.
+ * @param n
+ *   The number of objects of the put or get triggering the adaptation.
+ */
+__rte_experimental
+void rte_mempool_cache_adapt(struct rte_mempool *mp,
+	struct rte_mempool_cache *cache, unsigned int n);
+
+/**
+ * @internal Account a flush or a refill of the cache of an adaptive mempool.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param cache
+ *   A pointer to the mempool cache.
+ * @param n
+ *   The number of objects put or got.
+ * @param flush
+ *   True for a flush to the common pool, false for a refill from it.
+ */
+static __rte_always_inline void
+rte_mempool_cache_adapt_account(struct rte_mempool *mp,
+		struct rte_mempool_cache *cache, unsigned int n, bool flush)
+{
+#ifdef ALLOW_EXPERIMENTAL_API
+	if (likely((mp->flags & RTE_MEMPOOL_F_CACHE_ADAPTIVE) == 0))
+		return;
+
+	if (flush)
+		cache->flushes++;
+	else
+		cache->refills++;
+	if (unlikely(cache->flushes + cache->refills >=
+			RTE_MEMPOOL_CACHE_ADAPT_PERIOD))
+		rte_mempool_cache_adapt(mp, cache, n);
+#else
+	RTE_SET_USED(mp);
+	RTE_SET_USED(cache);
+	RTE_SET_USED(n);
+	RTE_SET_USED(flush);
+#endif
+}
+
 /**
  * @internal Put several objects back in the mempool; used internally.
  * @param mp
@@ -1417,6 +1488,7 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 			   unsigned int n, struct rte_mempool_cache *cache)
 {
 	void **cache_objs;
+	bool flushed = false;
 
 	/* No cache provided? */
 	if (unlikely(cache == NULL))
@@ -1450,6 +1522,7 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 				sizeof(void *) * (cache->len - cache->size / 2));
 		cache_objs = &cache->objs[cache->len - cache->size / 2];
 		cache->len = cache->len - cache->size / 2 + n;
+		flushed = true;
 	} else {
 		/* The request itself is too big for the cache. */
 		goto driver_enqueue_stats_incremented;
@@ -1458,6 +1531,9 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 	/* Add the objects to the cache. */
 	rte_memcpy(cache_objs, obj_table, sizeof(void *) * n);
 
+	if (unlikely(flushed))
+		rte_mempool_cache_adapt_account(mp, cache, n, true);
+
 	return;
 
 driver_enqueue:
@@ -1536,6 +1612,112 @@ rte_mempool_put(struct rte_mempool *mp, void *obj)
 	rte_mempool_put_bulk(mp, &obj, 1);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Zero-copy put objects in a mempool cache backed by the specified mempool.
+ *
+ * Reserve room for n objects at the top of the cache, flushing the cache
+ * to the mempool if needed. The caller writes the objects directly into
+ * the returned array instead of passing them through an intermediate
+ * table. Unused slots can be given back with
+ * rte_mempool_cache_zc_put_rewind().
+ *
+ * No other put or get operation must be done on the cache before the
+ * objects are written into the reserved slots or rewound.
+ *
+ * @param cache
+ *   A pointer to the mempool cache.
+ * @param mp
+ *   A pointer to the mempool.
+ * @param n
+ *   The number of objects to be put in the mempool cache, must be strictly
+ *   positive.
+ * @return
+ *   The pointer to where to put the objects in the mempool cache.
+ *   NULL if the objects do not fit in the cache and n exceeds half
+ *   the cache size, or if the mempool debug is enabled,
+ *   as the objects cookies cannot be checked.
+ */
+__rte_experimental
+static __rte_always_inline void **
+rte_mempool_cache_zc_put_bulk(struct rte_mempool_cache *cache,
+		struct rte_mempool *mp, unsigned int n)
+{
+	void **cache_objs;
+
+	RTE_ASSERT(cache != NULL);
+	RTE_ASSERT(mp != NULL);
+
+#ifdef RTE_LIBRTE_MEMPOOL_DEBUG
+	/* The objects are only known after return. */
+	return NULL;
+#endif
+
+	/*
+	 * Account the flush while the cache is still consistent, i.e.
+	 * before slots are reserved, as the adaptation may resize it.
+	 */
+	if (unlikely(cache->len + n > cache->size) && n <= cache->size / 2)
+		rte_mempool_cache_adapt_account(mp, cache, n, true);
+
+	__rte_assume(cache->size <= RTE_MEMPOOL_CACHE_MAX_SIZE);
+	__rte_assume(cache->size / 2 <= RTE_MEMPOOL_CACHE_MAX_SIZE / 2);
+	__rte_assume(cache->len <= RTE_MEMPOOL_CACHE_MAX_SIZE);
+	__rte_assume(cache->len <= cache->size);
+	if (likely(cache->len + n <= cache->size)) {
+		/* Sufficient room in the cache for the objects. */
+		cache_objs = &cache->objs[cache->len];
+		cache->len += n;
+	} else if (n <= cache->size / 2) {
+		/*
+		 * Flush (size / 2) objects from the bottom of the cache,
+		 * as done by rte_mempool_generic_put().
+		 */
+		__rte_assume(cache->len > cache->size / 2);
+		rte_mempool_ops_enqueue_bulk(mp, &cache->objs[0], cache->size / 2);
+		rte_memcpy(&cache->objs[0], &cache->objs[cache->size / 2],
+				sizeof(void *) * (cache->len - cache->size / 2));
+		cache_objs = &cache->objs[cache->len - cache->size / 2];
+		cache->len = cache->len - cache->size / 2 + n;
+	} else {
+		/* The request itself is too big for the cache. */
+		return NULL;
+	}
+
+	RTE_MEMPOOL_CACHE_STAT_ADD(cache, put_bulk, 1);
+	RTE_MEMPOOL_CACHE_STAT_ADD(cache, put_objs, n);
+
+	return cache_objs;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Give back the last slots reserved by rte_mempool_cache_zc_put_bulk()
+ * which were not written.
+ *
+ * @param cache
+ *   A pointer to the mempool cache.
+ * @param n
+ *   The number of slots to give back, at most the number of slots
+ *   reserved by the last call to rte_mempool_cache_zc_put_bulk().
+ */
+__rte_experimental
+static __rte_always_inline void
+rte_mempool_cache_zc_put_rewind(struct rte_mempool_cache *cache,
+		unsigned int n)
+{
+	RTE_ASSERT(cache != NULL);
+	RTE_ASSERT(n <= cache->len);
+
+	cache->len -= n;
+
+	RTE_MEMPOOL_CACHE_STAT_ADD(cache, put_objs, -(int64_t)n);
+}
+
 /**
  * @internal Get several objects from the mempool; used internally.
  * @param mp
@@ -1620,6 +1802,8 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 	for (index = 0; index < remaining; index++)
 		*obj_table++ = *--cache_objs;
 
+	rte_mempool_cache_adapt_account(mp, cache, n, false);
+
 	return 0;
 
 driver_dequeue:
@@ -1742,6 +1926,86 @@ rte_mempool_get(struct rte_mempool *mp, void **obj_p)
 	return rte_mempool_get_bulk(mp, obj_p, 1);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Zero-copy get objects from a mempool cache backed by the specified mempool.
+ *
+ * Take n objects from the top of the cache, refilling the cache from
+ * the mempool if needed. The caller reads the objects directly from
+ * the returned array instead of getting them copied into its own table.
+ * The hottest object is the last one of the array.
+ *
+ * No other put or get operation must be done on the cache before the
+ * objects are read from the returned array.
+ *
+ * @param cache
+ *   A pointer to the mempool cache.
+ * @param mp
+ *   A pointer to the mempool.
+ * @param n
+ *   The number of objects to get from the mempool cache, must be strictly
+ *   positive.
+ * @return
+ *   The pointer to the objects in the mempool cache.
+ *   NULL if the cache holds less than n objects and n exceeds half
+ *   the cache size, or if not enough objects are available
+ *   in the mempool; no object is retrieved then.
+ */
+__rte_experimental
+static __rte_always_inline void **
+rte_mempool_cache_zc_get_bulk(struct rte_mempool_cache *cache,
+		struct rte_mempool *mp, unsigned int n)
+{
+	void **cache_objs;
+	int ret;
+
+	RTE_ASSERT(cache != NULL);
+	RTE_ASSERT(mp != NULL);
+
+	__rte_assume(cache->size / 2 <= RTE_MEMPOOL_CACHE_MAX_SIZE / 2);
+	__rte_assume(cache->len <= RTE_MEMPOOL_CACHE_MAX_SIZE);
+	if (unlikely(n > cache->len)) {
+		/* The request itself is too big for the cache? */
+		if (unlikely(n > cache->size / 2))
+			return NULL;
+
+		/*
+		 * Fill the cache from the backend; fetch (size / 2) objects
+		 * below the current ones, which are more hot.
+		 */
+		rte_memcpy(&cache->objs[cache->size / 2], &cache->objs[0],
+				sizeof(void *) * cache->len);
+		ret = rte_mempool_ops_dequeue_bulk(mp, &cache->objs[0],
+				cache->size / 2);
+		if (unlikely(ret < 0)) {
+			rte_memcpy(&cache->objs[0], &cache->objs[cache->size / 2],
+					sizeof(void *) * cache->len);
+			RTE_MEMPOOL_STAT_ADD(mp, get_fail_bulk, 1);
+			RTE_MEMPOOL_STAT_ADD(mp, get_fail_objs, n);
+			return NULL;
+		}
+		cache->len += cache->size / 2;
+
+		/*
+		 * A shrunk cache keeps at least half of its size,
+		 * which is no less than n.
+		 */
+		rte_mempool_cache_adapt_account(mp, cache, n, false);
+	}
+
+	RTE_MEMPOOL_CACHE_STAT_ADD(cache, get_success_bulk, 1);
+	RTE_MEMPOOL_CACHE_STAT_ADD(cache, get_success_objs, n);
+
+	cache->len -= n;
+	cache_objs = &cache->objs[cache->len];
+
+	RTE_MEMPOOL_CHECK_COOKIES(mp, cache_objs, n, 1);
+
+	return cache_objs;
+}
+
 /**
  * Get a contiguous blocks of objects from the mempool.
  *
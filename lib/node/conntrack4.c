@@ -0,0 +1,924 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <netinet/in.h>
+
+#include <eal_export.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_hash.h>
+#include <rte_hash_crc.h>
+#include <rte_icmp.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_random.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_ring.h>
+#include <rte_tcp.h>
+#include <rte_telemetry.h>
+#include <rte_udp.h>
+
+#include "rte_node_conntrack4_api.h"
+
+#include "conntrack4_priv.h"
+#include "node_private.h"
+
+#define CT4_DEFAULT_MAX_FLOWS (1 << 16)
+/* Maximum number of connections checked for expiry per burst */
+#define CT4_EXPIRE_BUDGET 64
+/* Number of source ports tried when a translated source port is in use */
+#define CT4_SNAT_PORT_TRIES 16
+
+struct conntrack4_node_ctx {
+	/* Timer wheel of the node */
+	struct ct4_wheel *wheel;
+	/* Dynamic offset to mbuf priv1 */
+	int mbuf_priv1_off;
+};
+
+#define CT4_NODE_WHEEL(ctx) \
+	(((struct conntrack4_node_ctx *)ctx)->wheel)
+
+#define CT4_NODE_PRIV1_OFF(ctx) \
+	(((struct conntrack4_node_ctx *)ctx)->mbuf_priv1_off)
+
+static struct conntrack4_main conntrack4_nm = {
+	.lock = RTE_SPINLOCK_INITIALIZER,
+	.timeout = {
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN] = 120,
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_ESTABLISHED] = 7440,
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSING] = 120,
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSED] = 10,
+		[RTE_NODE_CONNTRACK4_TIMEOUT_UDP] = 30,
+		[RTE_NODE_CONNTRACK4_TIMEOUT_UDP_STREAM] = 120,
+		[RTE_NODE_CONNTRACK4_TIMEOUT_ICMP] = 30,
+	},
+};
+
+static const uint8_t ct4_state_timeout[CT4_STATE_MAX] = {
+	[CT4_TCP_SYN_SENT] = RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN,
+	[CT4_TCP_SYN_RECV] = RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN,
+	[CT4_TCP_ESTABLISHED] = RTE_NODE_CONNTRACK4_TIMEOUT_TCP_ESTABLISHED,
+	[CT4_TCP_FIN_WAIT] = RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSING,
+	[CT4_TCP_CLOSED] = RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSED,
+	[CT4_UDP_UNREPLIED] = RTE_NODE_CONNTRACK4_TIMEOUT_UDP,
+	[CT4_UDP_REPLIED] = RTE_NODE_CONNTRACK4_TIMEOUT_UDP_STREAM,
+	[CT4_ICMP] = RTE_NODE_CONNTRACK4_TIMEOUT_ICMP,
+};
+
+struct conntrack4_main *
+conntrack4_main_get(void)
+{
+	return &conntrack4_nm;
+}
+
+static __rte_always_inline uint32_t
+ct4_flow_timeout(const struct conntrack4_main *cm,
+		    const struct ct4_flow *flow)
+{
+	uint8_t state = rte_atomic_load_explicit(&flow->state, rte_memory_order_relaxed);
+
+	return cm->timeout[ct4_state_timeout[state]];
+}
+
+static __rte_always_inline uint64_t
+ct4_now(const struct conntrack4_main *cm)
+{
+	return rte_get_tsc_cycles() / cm->tick_hz;
+}
+
+/*
+ * Build the key of a packet. Returns false for the packets
+ * which are not tracked: fragments, other protocols and ICMP errors.
+ */
+static __rte_always_inline bool
+ct4_key_get(struct rte_mbuf *mbuf, struct ct4_key *key,
+	       uint8_t *tcp_flags)
+{
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_icmp_hdr *icmp_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	void *l4;
+
+	ipv4_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
+					   sizeof(struct rte_ether_hdr));
+	if (unlikely(ipv4_hdr->fragment_offset &
+		     rte_cpu_to_be_16(RTE_IPV4_HDR_MF_FLAG | RTE_IPV4_HDR_OFFSET_MASK)))
+		return false;
+
+	l4 = RTE_PTR_ADD(ipv4_hdr, rte_ipv4_hdr_len(ipv4_hdr));
+	key->src_ip = ipv4_hdr->src_addr;
+	key->dst_ip = ipv4_hdr->dst_addr;
+	key->proto = ipv4_hdr->next_proto_id;
+	memset(key->rsvd, 0, sizeof(key->rsvd));
+
+	switch (ipv4_hdr->next_proto_id) {
+	case IPPROTO_TCP:
+		tcp_hdr = l4;
+		key->src_port = tcp_hdr->src_port;
+		key->dst_port = tcp_hdr->dst_port;
+		*tcp_flags = tcp_hdr->tcp_flags;
+		return true;
+	case IPPROTO_UDP:
+		udp_hdr = l4;
+		key->src_port = udp_hdr->src_port;
+		key->dst_port = udp_hdr->dst_port;
+		return true;
+	case IPPROTO_ICMP:
+		icmp_hdr = l4;
+		if (icmp_hdr->icmp_type != RTE_ICMP_TYPE_ECHO_REQUEST &&
+		    icmp_hdr->icmp_type != RTE_ICMP_TYPE_ECHO_REPLY)
+			return false;
+		key->src_port = icmp_hdr->icmp_ident;
+		key->dst_port = icmp_hdr->icmp_ident;
+		return true;
+	default:
+		return false;
+	}
+}
+
+static __rte_always_inline void
+ct4_key_reverse(struct ct4_key *rev, const struct ct4_key *key)
+{
+	rev->src_ip = key->dst_ip;
+	rev->dst_ip = key->src_ip;
+	rev->src_port = key->dst_port;
+	rev->dst_port = key->src_port;
+	rev->proto = key->proto;
+	memset(rev->rsvd, 0, sizeof(rev->rsvd));
+}
+
+/* Next connection state after a packet of the given direction. */
+static __rte_always_inline uint8_t
+ct4_state_next(struct ct4_flow *flow, uint8_t state, uint8_t dir,
+		  uint8_t tcp_flags)
+{
+	uint8_t fin;
+
+	switch (state) {
+	case CT4_UDP_UNREPLIED:
+		if (dir)
+			state = CT4_UDP_REPLIED;
+		break;
+	case CT4_UDP_REPLIED:
+	case CT4_ICMP:
+		break;
+	default:
+		if (tcp_flags & RTE_TCP_RST_FLAG) {
+			state = CT4_TCP_CLOSED;
+			break;
+		}
+		switch (state) {
+		case CT4_TCP_SYN_SENT:
+			if (dir && (tcp_flags & RTE_TCP_SYN_FLAG) &&
+			    (tcp_flags & RTE_TCP_ACK_FLAG))
+				state = CT4_TCP_SYN_RECV;
+			break;
+		case CT4_TCP_SYN_RECV:
+			if (!dir && !(tcp_flags & RTE_TCP_SYN_FLAG) &&
+			    (tcp_flags & RTE_TCP_ACK_FLAG))
+				state = CT4_TCP_ESTABLISHED;
+			break;
+		case CT4_TCP_ESTABLISHED:
+		case CT4_TCP_FIN_WAIT:
+			if (tcp_flags & RTE_TCP_FIN_FLAG) {
+				fin = rte_atomic_fetch_or_explicit(&flow->fin, RTE_BIT32(dir),
+						rte_memory_order_relaxed) | RTE_BIT32(dir);
+				state = fin == 3 ? CT4_TCP_CLOSED : CT4_TCP_FIN_WAIT;
+			}
+			break;
+		case CT4_TCP_CLOSED:
+			/* Connection reopened with the same ports */
+			if (!dir && (tcp_flags & RTE_TCP_SYN_FLAG) &&
+			    !(tcp_flags & RTE_TCP_ACK_FLAG)) {
+				rte_atomic_store_explicit(&flow->fin, 0,
+						rte_memory_order_relaxed);
+				state = CT4_TCP_SYN_SENT;
+			}
+			break;
+		}
+		break;
+	}
+
+	return state;
+}
+
+/*
+ * Update the connection state with a packet of the given direction.
+ * The packets of the other direction may be processed by another graph
+ * at the same time, so the transition is retried from the state it set.
+ */
+static __rte_always_inline void
+ct4_state_update(struct ct4_flow *flow, uint8_t dir, uint8_t tcp_flags)
+{
+	uint8_t old, state;
+
+	old = rte_atomic_load_explicit(&flow->state, rte_memory_order_relaxed);
+	do {
+		state = ct4_state_next(flow, old, dir, tcp_flags);
+	} while (unlikely(state != old) &&
+		 !rte_atomic_compare_exchange_strong_explicit(&flow->state, &old, state,
+				rte_memory_order_relaxed, rte_memory_order_relaxed));
+}
+
+/* Add a connection to a wheel, the caller holds the wheel lock. */
+static __rte_always_inline void
+ct4_wheel_add(struct conntrack4_main *cm, struct ct4_wheel *w, uint64_t tick,
+		 uint32_t flow_id, uint64_t deadline)
+{
+	uint64_t slot;
+
+	/* Far deadlines are re-armed when their slot expires */
+	slot = RTE_MIN(deadline, tick + CT4_WHEEL_SLOTS - 1);
+	slot = RTE_MAX(slot, tick) % CT4_WHEEL_SLOTS;
+	cm->flows[flow_id].wheel_next = w->slot[slot];
+	w->slot[slot] = flow_id;
+}
+
+static void
+ct4_free_flow(void *p, void *key_data)
+{
+	struct conntrack4_main *cm = p;
+	uint32_t data = (uint32_t)(uintptr_t)key_data;
+
+	/* The entry is freed along with its original direction key */
+	if ((data & 1) == 0)
+		rte_ring_enqueue_elem(cm->free_flows, &(uint32_t){data >> 1},
+				      sizeof(uint32_t));
+}
+
+/* Delete both keys of a connection, the caller holds the lock. */
+static void
+ct4_flow_delete(struct conntrack4_main *cm, uint32_t flow_id)
+{
+	struct ct4_flow *flow = &cm->flows[flow_id];
+
+	/* Reply key first, so it is reclaimed before the entry is reused */
+	rte_hash_del_key(cm->hash, &flow->key[1]);
+	rte_hash_del_key(cm->hash, &flow->key[0]);
+	if (cm->v == NULL)
+		ct4_free_flow(cm, (void *)(uintptr_t)(flow_id << 1));
+}
+
+/*
+ * Remove the expired connections from a wheel, the caller holds the wheel
+ * lock. Returns the number of connections to delete, at most
+ * CT4_EXPIRE_BUDGET.
+ */
+static unsigned int
+ct4_expire(struct conntrack4_main *cm, struct ct4_wheel *w, uint64_t now,
+	      uint32_t *expired)
+{
+	unsigned int budget = CT4_EXPIRE_BUDGET;
+	unsigned int n = 0;
+	struct ct4_flow *flow;
+	uint32_t flow_id, slot;
+	uint64_t deadline, tick;
+
+	tick = rte_atomic_load_explicit(&w->tick, rte_memory_order_relaxed);
+
+	/* Each slot is visited once after a long idle period */
+	if (now - tick > CT4_WHEEL_SLOTS)
+		tick = now - CT4_WHEEL_SLOTS;
+
+	while (tick < now) {
+		slot = tick % CT4_WHEEL_SLOTS;
+		while (w->slot[slot] != CT4_FLOW_INVALID) {
+			if (budget-- == 0)
+				goto out;
+			flow_id = w->slot[slot];
+			flow = &cm->flows[flow_id];
+			w->slot[slot] = flow->wheel_next;
+
+			deadline = rte_atomic_load_explicit(&flow->last_seen,
+					rte_memory_order_relaxed) + ct4_flow_timeout(cm, flow);
+			if (deadline > tick) {
+				ct4_wheel_add(cm, w, tick, flow_id, deadline);
+				continue;
+			}
+
+			expired[n++] = flow_id;
+		}
+		tick++;
+	}
+out:
+	rte_atomic_store_explicit(&w->tick, tick, rte_memory_order_relaxed);
+	w->expired += n;
+
+	return n;
+}
+
+/* Expire the connections of the wheel of a node. */
+static __rte_noinline void
+ct4_node_expire(struct conntrack4_main *cm, struct ct4_wheel *w, uint64_t now)
+{
+	uint32_t expired[CT4_EXPIRE_BUDGET];
+	unsigned int i, n;
+
+	/* The control thread is expiring the wheel */
+	if (!rte_spinlock_trylock(&w->lock))
+		return;
+	n = ct4_expire(cm, w, now, expired);
+	rte_spinlock_unlock(&w->lock);
+
+	if (n == 0)
+		return;
+
+	rte_spinlock_lock(&cm->lock);
+	for (i = 0; i < n; i++)
+		ct4_flow_delete(cm, expired[i]);
+	rte_spinlock_unlock(&cm->lock);
+}
+
+/* Apply the NAT rules to the original key of a new connection. */
+static void
+ct4_nat_apply(const struct conntrack4_main *cm, struct ct4_key *xlat)
+{
+	const struct rte_node_nat4_rule *rule;
+	bool snat = false, dnat = false;
+	uint32_t mask;
+	uint16_t i;
+
+	for (i = 0; i < cm->nb_rules; i++) {
+		rule = &cm->rules[i];
+		mask = rule->depth ? RTE_GENMASK32(31, 32 - rule->depth) : 0;
+		if (rule->type == RTE_NODE_NAT4_DNAT && !dnat) {
+			if ((rte_be_to_cpu_32(xlat->dst_ip) & mask) != rule->ip ||
+			    (rule->proto && rule->proto != xlat->proto) ||
+			    (rule->port && xlat->proto != IPPROTO_ICMP &&
+			     rte_be_to_cpu_16(xlat->dst_port) != rule->port))
+				continue;
+			xlat->dst_ip = rte_cpu_to_be_32(rule->nat_ip);
+			if (rule->nat_port && xlat->proto != IPPROTO_ICMP)
+				xlat->dst_port = rte_cpu_to_be_16(rule->nat_port);
+			dnat = true;
+		} else if (rule->type == RTE_NODE_NAT4_SNAT && !snat) {
+			if ((rte_be_to_cpu_32(xlat->src_ip) & mask) != rule->ip)
+				continue;
+			xlat->src_ip = rte_cpu_to_be_32(rule->nat_ip);
+			snat = true;
+		}
+	}
+}
+
+/*
+ * Create the connection of a packet which key was not found,
+ * unless another node created it in the meantime.
+ * Returns the flow index and direction, or CT4_FLOW_INVALID.
+ */
+static __rte_noinline uint32_t
+ct4_flow_create(struct conntrack4_main *cm, struct ct4_wheel *w,
+		   const struct ct4_key *key, uint8_t tcp_flags, uint64_t now)
+{
+	struct ct4_key xlat, reply;
+	struct ct4_flow *flow;
+	uint32_t flow_id, i;
+	uint16_t port;
+	uint8_t state;
+	void *data;
+	bool nat;
+
+	/* Do not create connections from their reset */
+	if (key->proto == IPPROTO_TCP && (tcp_flags & RTE_TCP_RST_FLAG))
+		return CT4_FLOW_INVALID;
+
+	rte_spinlock_lock(&cm->lock);
+
+	if (rte_hash_lookup_data(cm->hash, key, &data) >= 0) {
+		rte_spinlock_unlock(&cm->lock);
+		return (uint32_t)(uintptr_t)data;
+	}
+
+	if (rte_ring_dequeue_elem(cm->free_flows, &flow_id, sizeof(uint32_t)) != 0) {
+		/* Reclaim the entries of the expired connections */
+		if (cm->v != NULL)
+			rte_hash_rcu_qsbr_dq_reclaim(cm->hash, NULL, NULL, NULL);
+		if (rte_ring_dequeue_elem(cm->free_flows, &flow_id, sizeof(uint32_t)) != 0)
+			goto fail;
+	}
+
+	xlat = *key;
+	ct4_nat_apply(cm, &xlat);
+	nat = memcmp(&xlat, key, sizeof(xlat)) != 0;
+	ct4_key_reverse(&reply, &xlat);
+
+	/* Pick another source port when the reply key is used */
+	port = rte_be_to_cpu_16(xlat.src_port);
+	for (i = 0; rte_hash_lookup(cm->hash, &reply) >= 0; i++) {
+		if (!nat || xlat.src_ip == key->src_ip ||
+		    i == CT4_SNAT_PORT_TRIES) {
+			rte_ring_enqueue_elem(cm->free_flows, &flow_id, sizeof(uint32_t));
+			goto fail;
+		}
+		port += 1 + rte_rand_max(UINT16_MAX / 4);
+		if (port < 1024)
+			port += 1024;
+		reply.dst_port = rte_cpu_to_be_16(port);
+		if (key->proto == IPPROTO_ICMP)
+			reply.src_port = reply.dst_port;
+	}
+
+	flow = &cm->flows[flow_id];
+	flow->key[0] = *key;
+	flow->key[1] = reply;
+	flow->nat = nat;
+	rte_atomic_store_explicit(&flow->last_seen, now, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&flow->fin, 0, rte_memory_order_relaxed);
+	switch (key->proto) {
+	case IPPROTO_TCP:
+		state = (tcp_flags & RTE_TCP_SYN_FLAG) &&
+			!(tcp_flags & RTE_TCP_ACK_FLAG) ?
+			CT4_TCP_SYN_SENT : CT4_TCP_ESTABLISHED;
+		break;
+	case IPPROTO_UDP:
+		state = CT4_UDP_UNREPLIED;
+		break;
+	default:
+		state = CT4_ICMP;
+		break;
+	}
+	rte_atomic_store_explicit(&flow->state, state, rte_memory_order_relaxed);
+
+	if (rte_hash_add_key_data(cm->hash, &flow->key[1],
+				  (void *)(uintptr_t)((flow_id << 1) | 1)) < 0) {
+		rte_ring_enqueue_elem(cm->free_flows, &flow_id, sizeof(uint32_t));
+		goto fail;
+	}
+	if (rte_hash_add_key_data(cm->hash, &flow->key[0],
+				  (void *)(uintptr_t)(flow_id << 1)) < 0) {
+		/* Free the entry along with the reply key */
+		rte_hash_add_key_data(cm->hash, &flow->key[1],
+				      (void *)(uintptr_t)(flow_id << 1));
+		rte_hash_del_key(cm->hash, &flow->key[1]);
+		if (cm->v == NULL)
+			rte_ring_enqueue_elem(cm->free_flows, &flow_id, sizeof(uint32_t));
+		goto fail;
+	}
+
+	rte_spinlock_unlock(&cm->lock);
+
+	rte_spinlock_lock(&w->lock);
+	ct4_wheel_add(cm, w, rte_atomic_load_explicit(&w->tick, rte_memory_order_relaxed),
+		      flow_id, now + ct4_flow_timeout(cm, flow));
+	w->created++;
+	rte_spinlock_unlock(&w->lock);
+
+	return flow_id << 1;
+fail:
+	rte_spinlock_unlock(&cm->lock);
+	return CT4_FLOW_INVALID;
+}
+
+static uint16_t
+conntrack4_node_process(struct rte_graph *graph, struct rte_node *node,
+			   void **objs, uint16_t nb_objs)
+{
+	struct ct4_wheel *w = CT4_NODE_WHEEL(node->ctx);
+	const int dyn = CT4_NODE_PRIV1_OFF(node->ctx);
+	struct conntrack4_main *cm = &conntrack4_nm;
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	struct ct4_key keys[RTE_HASH_LOOKUP_BULK_MAX];
+	uint8_t tcp_flags[RTE_HASH_LOOKUP_BULK_MAX];
+	bool tracked[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t n, base, last_spec = 0;
+	rte_edge_t next_index, next;
+	struct ct4_flow *flow;
+	void **to_next, **from;
+	struct rte_mbuf *mbuf;
+	uint16_t held = 0;
+	uint64_t hit_mask;
+	uint32_t flow_id;
+	uint64_t now;
+	int i;
+
+	now = ct4_now(cm);
+	if (unlikely(rte_atomic_load_explicit(&w->tick, rte_memory_order_relaxed) < now))
+		ct4_node_expire(cm, w, now);
+
+	/* Speculative next */
+	next_index = RTE_NODE_CONNTRACK4_NEXT_NAT4;
+
+	from = objs;
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	for (base = 0; base < nb_objs; base += n) {
+		n = RTE_MIN(nb_objs - base, RTE_HASH_LOOKUP_BULK_MAX);
+
+		/* Gather the keys, then look them up at once */
+		for (i = 0; i < n; i++) {
+			mbuf = (struct rte_mbuf *)objs[base + i];
+			if (likely(i + 4 < n))
+				rte_prefetch0(rte_pktmbuf_mtod_offset(
+					(struct rte_mbuf *)objs[base + i + 4], void *,
+					sizeof(struct rte_ether_hdr)));
+			tcp_flags[i] = 0;
+			tracked[i] = ct4_key_get(mbuf, &keys[i], &tcp_flags[i]);
+			if (unlikely(!tracked[i]))
+				memset(&keys[i], 0, sizeof(keys[i]));
+			key_ptrs[i] = &keys[i];
+		}
+
+		hit_mask = 0;
+		rte_hash_lookup_bulk_data(cm->hash, key_ptrs, n, &hit_mask, data);
+
+		for (i = 0; i < n; i++) {
+			mbuf = (struct rte_mbuf *)objs[base + i];
+			next = RTE_NODE_CONNTRACK4_NEXT_NAT4;
+
+			if (unlikely(!tracked[i])) {
+				flow_id = CT4_FLOW_INVALID;
+			} else {
+				if (likely(hit_mask & RTE_BIT64(i)))
+					flow_id = (uint32_t)(uintptr_t)data[i];
+				else
+					flow_id = ct4_flow_create(cm, w, &keys[i],
+								     tcp_flags[i], now);
+
+				if (likely(flow_id != CT4_FLOW_INVALID)) {
+					flow = &cm->flows[flow_id >> 1];
+					ct4_state_update(flow, flow_id & 1, tcp_flags[i]);
+					if (rte_atomic_load_explicit(&flow->last_seen,
+							rte_memory_order_relaxed) != now)
+						rte_atomic_store_explicit(&flow->last_seen, now,
+								rte_memory_order_relaxed);
+				} else {
+					w->insert_failed++;
+					next = RTE_NODE_CONNTRACK4_NEXT_PKT_DROP;
+				}
+			}
+
+			if (flow_id == CT4_FLOW_INVALID) {
+				node_mbuf_priv1(mbuf, dyn)->flow_id = CT4_FLOW_INVALID;
+			} else {
+				node_mbuf_priv1(mbuf, dyn)->flow_id = flow_id >> 1;
+				node_mbuf_priv1(mbuf, dyn)->flow_dir = flow_id & 1;
+			}
+
+			if (unlikely(next_index != next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
+		}
+	}
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	return nb_objs;
+}
+
+static void
+conntrack4_fini(struct conntrack4_main *cm)
+{
+	rte_hash_free(cm->hash);
+	rte_ring_free(cm->free_flows);
+	rte_free(cm->flows);
+	cm->hash = NULL;
+	cm->free_flows = NULL;
+	cm->flows = NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_conntrack4_configure, 26.11)
+int
+rte_node_conntrack4_configure(const struct rte_node_conntrack4_config *cfg)
+{
+	struct conntrack4_main *cm = &conntrack4_nm;
+	struct rte_hash_parameters params = {0};
+	struct rte_hash_rcu_config rcu_cfg = {0};
+	uint32_t i;
+	int rc;
+
+	if (cfg == NULL || cfg->max_flows == 0 ||
+	    cfg->max_flows > (CT4_FLOW_INVALID >> 1))
+		return -EINVAL;
+
+	/* Connections are being tracked */
+	if (cm->nb_wheels != 0)
+		return -EBUSY;
+
+	/* Entries of the destroyed graphs are still in their grace period */
+	if (cm->hash != NULL && cm->v != NULL) {
+		unsigned int pending;
+
+		rte_hash_rcu_qsbr_dq_reclaim(cm->hash, NULL, &pending, NULL);
+		if (pending != 0)
+			return -EBUSY;
+	}
+
+	conntrack4_fini(cm);
+
+	cm->flows = rte_zmalloc_socket("conntrack4_flows",
+				       sizeof(struct ct4_flow) * cfg->max_flows,
+				       RTE_CACHE_LINE_SIZE, cfg->socket_id);
+	if (cm->flows == NULL)
+		return -ENOMEM;
+
+	cm->free_flows = rte_ring_create_elem("conntrack4_free", sizeof(uint32_t),
+					      rte_align32pow2(cfg->max_flows + 1),
+					      cfg->socket_id, RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (cm->free_flows == NULL) {
+		rc = -rte_errno;
+		goto fail;
+	}
+	for (i = 0; i < cfg->max_flows; i++)
+		rte_ring_enqueue_elem(cm->free_flows, &i, sizeof(uint32_t));
+
+	params.name = "conntrack4";
+	params.entries = 2 * cfg->max_flows;
+	params.key_len = sizeof(struct ct4_key);
+	params.hash_func = rte_hash_crc;
+	params.socket_id = cfg->socket_id;
+	params.extra_flag = RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+	/* Writers are serialized by the conntrack lock */
+	if (cfg->v != NULL)
+		params.extra_flag |= RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF;
+	else
+		params.extra_flag |= RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY;
+	cm->hash = rte_hash_create(&params);
+	if (cm->hash == NULL) {
+		rc = -rte_errno;
+		goto fail;
+	}
+
+	if (cfg->v != NULL) {
+		rcu_cfg.v = cfg->v;
+		rcu_cfg.mode = RTE_HASH_QSBR_MODE_DQ;
+		rcu_cfg.key_data_ptr = cm;
+		rcu_cfg.free_key_data_func = ct4_free_flow;
+		if (rte_hash_rcu_qsbr_add(cm->hash, &rcu_cfg) != 0) {
+			rc = -rte_errno;
+			goto fail;
+		}
+	}
+
+	cm->v = cfg->v;
+	cm->max_flows = cfg->max_flows;
+	cm->tick_hz = rte_get_tsc_hz();
+
+	return 0;
+fail:
+	conntrack4_fini(cm);
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_conntrack4_timeout_set, 26.11)
+int
+rte_node_conntrack4_timeout_set(enum rte_node_conntrack4_timeout timeout,
+				   uint32_t seconds)
+{
+	if (timeout >= RTE_NODE_CONNTRACK4_TIMEOUT_MAX || seconds == 0)
+		return -EINVAL;
+
+	conntrack4_nm.timeout[timeout] = seconds;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_conntrack4_timeout_get, 26.11)
+uint32_t
+rte_node_conntrack4_timeout_get(enum rte_node_conntrack4_timeout timeout)
+{
+	if (timeout >= RTE_NODE_CONNTRACK4_TIMEOUT_MAX)
+		return 0;
+
+	return conntrack4_nm.timeout[timeout];
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_conntrack4_stats_get, 26.11)
+int
+rte_node_conntrack4_stats_get(struct rte_node_conntrack4_stats *stats)
+{
+	struct conntrack4_main *cm = &conntrack4_nm;
+	struct ct4_wheel *w;
+	uint16_t i;
+
+	if (stats == NULL)
+		return -EINVAL;
+
+	memset(stats, 0, sizeof(*stats));
+	rte_spinlock_lock(&cm->lock);
+	for (i = 0; i < cm->nb_wheels; i++) {
+		w = cm->wheels[i];
+		stats->created += w->created;
+		stats->expired += w->expired;
+		stats->insert_failed += w->insert_failed;
+	}
+	rte_spinlock_unlock(&cm->lock);
+	stats->active = stats->created - stats->expired;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_conntrack4_expire, 26.11)
+int
+rte_node_conntrack4_expire(void)
+{
+	struct conntrack4_main *cm = &conntrack4_nm;
+	uint32_t expired[CT4_EXPIRE_BUDGET];
+	unsigned int i, n;
+	struct ct4_wheel *w;
+	uint64_t now;
+	uint16_t j;
+	int rc = 0;
+
+	/* Entries reused at once may still be held by the graph */
+	if (cm->v == NULL)
+		return -ENOTSUP;
+
+	now = ct4_now(cm);
+	rte_spinlock_lock(&cm->lock);
+	for (j = 0; j < cm->nb_wheels; j++) {
+		w = cm->wheels[j];
+		if (rte_atomic_load_explicit(&w->tick, rte_memory_order_relaxed) >= now)
+			continue;
+		/* The node is expiring its wheel */
+		if (!rte_spinlock_trylock(&w->lock))
+			continue;
+		n = ct4_expire(cm, w, now, expired);
+		rte_spinlock_unlock(&w->lock);
+
+		for (i = 0; i < n; i++)
+			ct4_flow_delete(cm, expired[i]);
+		rc += n;
+	}
+	rte_spinlock_unlock(&cm->lock);
+
+	return rc;
+}
+
+static int
+conntrack4_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct conntrack4_main *cm = &conntrack4_nm;
+	struct rte_node_conntrack4_config cfg;
+	struct ct4_wheel *w;
+	int dyn, rc;
+
+	RTE_BUILD_BUG_ON(sizeof(struct conntrack4_node_ctx) > RTE_NODE_CTX_SZ);
+	RTE_BUILD_BUG_ON(sizeof(struct ct4_key) != 16);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0)
+		return -rte_errno;
+
+	if (cm->hash == NULL) {
+		cfg.max_flows = CT4_DEFAULT_MAX_FLOWS;
+		cfg.socket_id = graph->socket;
+		cfg.v = NULL;
+		rc = rte_node_conntrack4_configure(&cfg);
+		if (rc < 0) {
+			node_err("conntrack4", "Failed to create conntrack table, rc=%d", rc);
+			return rc;
+		}
+	}
+
+	w = rte_zmalloc_socket("conntrack4_wheel", sizeof(*w),
+			       RTE_CACHE_LINE_SIZE, graph->socket);
+	if (w == NULL)
+		return -ENOMEM;
+	memset(w->slot, 0xff, sizeof(w->slot));
+	rte_spinlock_init(&w->lock);
+	rte_atomic_store_explicit(&w->tick, ct4_now(cm), rte_memory_order_relaxed);
+
+	rte_spinlock_lock(&cm->lock);
+	if (cm->nb_wheels == CT4_MAX_WHEELS) {
+		rc = -ENOSPC;
+		goto unlock;
+	}
+	/* Without RCU, the entries expired by a graph are reused at once */
+	if (cm->v == NULL && cm->nb_wheels != 0) {
+		node_err("conntrack4", "RCU QSBR variable needed to track connections of several graphs");
+		rc = -ENOTSUP;
+		goto unlock;
+	}
+	cm->wheels[cm->nb_wheels++] = w;
+	rte_spinlock_unlock(&cm->lock);
+
+	CT4_NODE_WHEEL(node->ctx) = w;
+	CT4_NODE_PRIV1_OFF(node->ctx) = dyn;
+
+	node_dbg("conntrack4", "Initialized conntrack4 node");
+	return 0;
+unlock:
+	rte_spinlock_unlock(&cm->lock);
+	rte_free(w);
+	return rc;
+}
+
+static void
+conntrack4_node_fini(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct ct4_wheel *w = CT4_NODE_WHEEL(node->ctx);
+	struct conntrack4_main *cm = &conntrack4_nm;
+	uint32_t flow_id, slot;
+	uint16_t i;
+
+	RTE_SET_USED(graph);
+
+	if (w == NULL)
+		return;
+
+	/* Nobody else would expire the connections of this node */
+	rte_spinlock_lock(&cm->lock);
+	for (slot = 0; slot < CT4_WHEEL_SLOTS; slot++) {
+		for (flow_id = w->slot[slot]; flow_id != CT4_FLOW_INVALID;
+		     flow_id = cm->flows[flow_id].wheel_next) {
+			ct4_flow_delete(cm, flow_id);
+			w->expired++;
+		}
+	}
+	for (i = 0; i < cm->nb_wheels; i++) {
+		if (cm->wheels[i] == w) {
+			cm->wheels[i] = cm->wheels[--cm->nb_wheels];
+			break;
+		}
+	}
+	rte_spinlock_unlock(&cm->lock);
+
+	rte_free(w);
+	CT4_NODE_WHEEL(node->ctx) = NULL;
+}
+
+static int
+conntrack4_handle_stats(const char *cmd __rte_unused,
+			   const char *params __rte_unused,
+			   struct rte_tel_data *d)
+{
+	struct rte_node_conntrack4_stats stats;
+
+	rte_node_conntrack4_stats_get(&stats);
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "max_flows", conntrack4_nm.max_flows);
+	rte_tel_data_add_dict_uint(d, "active", stats.active);
+	rte_tel_data_add_dict_uint(d, "created", stats.created);
+	rte_tel_data_add_dict_uint(d, "expired", stats.expired);
+	rte_tel_data_add_dict_uint(d, "insert_failed", stats.insert_failed);
+
+	return 0;
+}
+
+static int
+conntrack4_handle_timeouts(const char *cmd __rte_unused,
+			      const char *params __rte_unused,
+			      struct rte_tel_data *d)
+{
+	static const char * const names[RTE_NODE_CONNTRACK4_TIMEOUT_MAX] = {
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN] = "tcp_syn",
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_ESTABLISHED] = "tcp_established",
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSING] = "tcp_closing",
+		[RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSED] = "tcp_closed",
+		[RTE_NODE_CONNTRACK4_TIMEOUT_UDP] = "udp",
+		[RTE_NODE_CONNTRACK4_TIMEOUT_UDP_STREAM] = "udp_stream",
+		[RTE_NODE_CONNTRACK4_TIMEOUT_ICMP] = "icmp",
+	};
+	unsigned int i;
+
+	rte_tel_data_start_dict(d);
+	for (i = 0; i < RTE_NODE_CONNTRACK4_TIMEOUT_MAX; i++)
+		rte_tel_data_add_dict_uint(d, names[i], conntrack4_nm.timeout[i]);
+
+	return 0;
+}
+
+RTE_INIT(conntrack4_init_telemetry)
+{
+	rte_telemetry_register_cmd("/node/conntrack4/stats", conntrack4_handle_stats,
+		"Returns the IPv4 connection tracking statistics. Takes no parameters");
+	rte_telemetry_register_cmd("/node/conntrack4/timeouts", conntrack4_handle_timeouts,
+		"Returns the IPv4 connection tracking timeouts in seconds. Takes no parameters");
+}
+
+static struct rte_node_register conntrack4_node = {
+	.process = conntrack4_node_process,
+	.name = "conntrack4",
+
+	.init = conntrack4_node_init,
+	.fini = conntrack4_node_fini,
+
+	.nb_edges = RTE_NODE_CONNTRACK4_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_CONNTRACK4_NEXT_NAT4] = "nat4",
+		[RTE_NODE_CONNTRACK4_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(conntrack4_node);
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+#ifndef __INCLUDE_CONNTRACK4_PRIV_H__
+#define __INCLUDE_CONNTRACK4_PRIV_H__
+
+#include <rte_common.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
+
+#include "rte_node_conntrack4_api.h"
+
+#define CT4_FLOW_INVALID UINT32_MAX
+#define CT4_WHEEL_SLOTS 1024
+#define CT4_NAT_MAX_RULES 64
+#define CT4_MAX_WHEELS RTE_MAX_LCORE
+
+/**
+ * @internal
+ *
+ * Connection key, one per direction, in network byte order.
+ * ICMP echo connections use the identifier as both ports.
+ */
+struct ct4_key {
+	uint32_t src_ip;
+	uint32_t dst_ip;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t proto;
+	uint8_t rsvd[3];
+};
+
+/**
+ * @internal
+ *
+ * Connection states.
+ */
+enum ct4_state {
+	CT4_TCP_SYN_SENT,
+	CT4_TCP_SYN_RECV,
+	CT4_TCP_ESTABLISHED,
+	CT4_TCP_FIN_WAIT,
+	CT4_TCP_CLOSED,
+	CT4_UDP_UNREPLIED,
+	CT4_UDP_REPLIED,
+	CT4_ICMP,
+	CT4_STATE_MAX,
+};
+
+/**
+ * @internal
+ *
+ * Connection entry.
+ * The packets of both directions may be processed by different graphs,
+ * so the fields updated by the packets are accessed atomically.
+ */
+struct __rte_cache_aligned ct4_flow {
+	struct ct4_key key[2];
+	/**< Original and reply direction keys. */
+	RTE_ATOMIC(uint64_t) last_seen;
+	/**< Tick of the last packet. */
+	uint32_t wheel_next;
+	/**< Next connection in the timer wheel slot. */
+	RTE_ATOMIC(uint8_t) state;
+	/**< Connection state. */
+	RTE_ATOMIC(uint8_t) fin;
+	/**< FIN seen in each direction. */
+	uint8_t nat;
+	/**< Connection is translated. */
+};
+
+/**
+ * @internal
+ *
+ * Timer wheel of the connections created by a node.
+ * The node owning the wheel expires its connections, which are re-armed
+ * lazily when they were refreshed. The control thread expires them
+ * when the node is idle.
+ */
+struct __rte_cache_aligned ct4_wheel {
+	RTE_ATOMIC(uint64_t) tick;
+	/**< Next tick to expire. */
+	rte_spinlock_t lock;
+	/**< Serialize the node and the control thread. */
+	uint64_t created;
+	/**< Number of connections created. */
+	uint64_t expired;
+	/**< Number of connections expired. */
+	uint64_t insert_failed;
+	/**< Number of packets without connection. */
+	uint32_t slot[CT4_WHEEL_SLOTS];
+	/**< First connection of each slot. */
+};
+
+/**
+ * @internal
+ *
+ * IP4 conntrack main data structure, shared by the conntrack and NAT nodes.
+ */
+struct conntrack4_main {
+	struct rte_hash *hash;
+	/**< Connection keys to flow index and direction. */
+	struct ct4_flow *flows;
+	/**< Connection entries. */
+	struct rte_ring *free_flows;
+	/**< Free connection entries. */
+	struct rte_rcu_qsbr *v;
+	/**< RCU QSBR variable, may be NULL. */
+	uint32_t max_flows;
+	/**< Number of connection entries. */
+	uint64_t tick_hz;
+	/**< TSC cycles per tick. */
+	uint32_t timeout[RTE_NODE_CONNTRACK4_TIMEOUT_MAX];
+	/**< Timeouts in ticks. */
+	rte_spinlock_t lock;
+	/**< Serialize connection creation and deletion. */
+	uint16_t nb_wheels;
+	/**< Number of timer wheels. */
+	struct ct4_wheel *wheels[CT4_MAX_WHEELS];
+	/**< Timer wheel of each node. */
+	uint16_t nb_rules;
+	/**< Number of NAT rules. */
+	struct rte_node_nat4_rule rules[CT4_NAT_MAX_RULES];
+	/**< NAT rules. */
+};
+
+/**
+ * @internal
+ *
+ * Get the IP4 conntrack main data.
+ *
+ * @return
+ *   Pointer to the IP4 conntrack main data.
+ */
+struct conntrack4_main *conntrack4_main_get(void);
+
+#endif /* __INCLUDE_CONNTRACK4_PRIV_H__ */
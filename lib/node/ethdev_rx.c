@@ -216,6 +216,7 @@ static struct rte_node_register ethdev_rx_node_base = {
 		[ETHDEV_RX_NEXT_PKT_CLS] = "pkt_cls",
 		[ETHDEV_RX_NEXT_IP4_LOOKUP] = "ip4_lookup",
 		[ETHDEV_RX_NEXT_IP4_REASSEMBLY] = "ip4_reassembly",
+		[ETHDEV_RX_NEXT_IP6_REASSEMBLY] = "ip6_reassembly",
 	},
 };
 
@@ -40,6 +40,7 @@ enum ethdev_rx_next_nodes {
 	ETHDEV_RX_NEXT_IP4_LOOKUP,
 	ETHDEV_RX_NEXT_PKT_CLS,
 	ETHDEV_RX_NEXT_IP4_REASSEMBLY,
+	ETHDEV_RX_NEXT_IP6_REASSEMBLY,
 	ETHDEV_RX_NEXT_MAX,
 };
 
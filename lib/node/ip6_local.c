@@ -0,0 +1,159 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <netinet/in.h>
+
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip6.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ip6_api.h"
+
+#include "node_private.h"
+
+static __rte_always_inline uint16_t
+ip6_local_next(struct rte_mbuf *mbuf)
+{
+	struct rte_ipv6_hdr *ipv6_hdr;
+
+	ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv6_hdr *,
+					   sizeof(struct rte_ether_hdr));
+	/* Extension headers other than fragments are not supported */
+	switch (ipv6_hdr->proto) {
+	case IPPROTO_UDP:
+		return RTE_NODE_IP6_LOCAL_NEXT_UDP6_INPUT;
+	case IPPROTO_ICMPV6:
+		return RTE_NODE_IP6_LOCAL_NEXT_IP6_NDP;
+	default:
+		return RTE_NODE_IP6_LOCAL_NEXT_PKT_DROP;
+	}
+}
+
+static uint16_t
+ip6_local_node_process(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	struct rte_mbuf **pkts;
+	void **to_next, **from;
+	uint16_t last_spec = 0;
+	rte_edge_t next_index;
+	uint16_t n_left_from;
+	uint16_t held = 0;
+	int i;
+
+	/* Speculative next */
+	next_index = RTE_NODE_IP6_LOCAL_NEXT_UDP6_INPUT;
+
+	pkts = (struct rte_mbuf **)objs;
+	from = objs;
+	n_left_from = nb_objs;
+
+	for (i = 0; i < 4 && i < n_left_from; i++)
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[i], void *,
+						sizeof(struct rte_ether_hdr)));
+
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	while (n_left_from >= 4) {
+		uint16_t next[4];
+
+		/* Prefetch next mbuf data */
+		if (likely(n_left_from > 7)) {
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[4], void *,
+						sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[5], void *,
+						sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[6], void *,
+						sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[7], void *,
+						sizeof(struct rte_ether_hdr)));
+		}
+
+		next[0] = ip6_local_next(pkts[0]);
+		next[1] = ip6_local_next(pkts[1]);
+		next[2] = ip6_local_next(pkts[2]);
+		next[3] = ip6_local_next(pkts[3]);
+
+		pkts += 4;
+		n_left_from -= 4;
+
+		rte_edge_t fix_spec = ((next_index == next[0]) &&
+					(next_index == next[1]) &&
+					(next_index == next[2]) &&
+					(next_index == next[3]));
+
+		if (unlikely(fix_spec == 0)) {
+			/* Copy things successfully speculated till now */
+			rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+			from += last_spec;
+			to_next += last_spec;
+			held += last_spec;
+			last_spec = 0;
+
+			for (i = 0; i < 4; i++) {
+				if (next_index == next[i]) {
+					to_next[0] = from[i];
+					to_next++;
+					held++;
+				} else {
+					rte_node_enqueue_x1(graph, node, next[i],
+							    from[i]);
+				}
+			}
+
+			from += 4;
+		} else {
+			last_spec += 4;
+		}
+	}
+
+	while (n_left_from > 0) {
+		uint16_t next0;
+
+		next0 = ip6_local_next(pkts[0]);
+
+		pkts += 1;
+		n_left_from -= 1;
+
+		if (unlikely(next_index != next0)) {
+			/* Copy things successfully speculated till now */
+			rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+			from += last_spec;
+			to_next += last_spec;
+			held += last_spec;
+			last_spec = 0;
+
+			rte_node_enqueue_x1(graph, node, next0, from[0]);
+			from += 1;
+		} else {
+			last_spec += 1;
+		}
+	}
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	return nb_objs;
+}
+
+static struct rte_node_register ip6_local_node = {
+	.process = ip6_local_node_process,
+	.name = "ip6_local",
+
+	.nb_edges = RTE_NODE_IP6_LOCAL_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_IP6_LOCAL_NEXT_UDP6_INPUT] = "udp6_input",
+		[RTE_NODE_IP6_LOCAL_NEXT_IP6_NDP] = "ip6_ndp",
+		[RTE_NODE_IP6_LOCAL_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(ip6_local_node);
@@ -312,6 +312,7 @@ static struct rte_node_register ip6_lookup_fib_node = {
 	.nb_edges = RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP + 1,
 	.next_nodes = {
 		[RTE_NODE_IP6_LOOKUP_NEXT_REWRITE] = "ip6_rewrite",
+		[RTE_NODE_IP6_LOOKUP_NEXT_IP6_LOCAL] = "ip6_local",
 		[RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP] = "pkt_drop",
 	},
 };
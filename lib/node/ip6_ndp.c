@@ -0,0 +1,341 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <netinet/in.h>
+
+#include <eal_export.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_icmp.h>
+#include <rte_ip6.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ip6_api.h"
+
+#include "ip6_ndp_priv.h"
+#include "node_private.h"
+
+#define IP6_NDP_TYPE_NS 135
+#define IP6_NDP_TYPE_NA 136
+#define IP6_NDP_OPT_SLLA 1
+#define IP6_NDP_OPT_TLLA 2
+
+#define IP6_NDP_NA_F_ROUTER RTE_BE32(0x80000000)
+#define IP6_NDP_NA_F_SOLICITED RTE_BE32(0x40000000)
+#define IP6_NDP_NA_F_OVERRIDE RTE_BE32(0x20000000)
+
+/* Neighbor solicitation and advertisement message, RFC 4861 */
+struct __rte_packed_begin ip6_ndp_msg {
+	struct rte_icmp_base_hdr base;
+	rte_be32_t flags;
+	struct rte_ipv6_addr target;
+} __rte_packed_end;
+
+/* Link-layer address option */
+struct ip6_ndp_lla_opt {
+	uint8_t type;
+	uint8_t len;
+	struct rte_ether_addr mac;
+};
+
+#define IP6_NDP_NS_MIN_LEN \
+	(sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv6_hdr) + \
+	 sizeof(struct ip6_ndp_msg))
+
+#define IP6_NDP_NA_LEN (IP6_NDP_NS_MIN_LEN + sizeof(struct ip6_ndp_lla_opt))
+
+static struct ip6_ndp_node_main *ip6_ndp_nm;
+
+struct ip6_ndp_node_ctx {
+	/* Cached next index */
+	uint16_t next_index;
+};
+
+#define IP6_NDP_NODE_NEXT_INDEX(ctx) \
+	(((struct ip6_ndp_node_ctx *)ctx)->next_index)
+
+static __rte_always_inline bool
+ip6_ndp_addr_is_local(const struct ip6_ndp_port *port,
+		      const struct rte_ipv6_addr *ip)
+{
+	uint16_t i;
+
+	for (i = 0; i < port->nb_addrs; i++)
+		if (rte_ipv6_addr_eq(&port->addrs[i], ip))
+			return true;
+
+	return false;
+}
+
+/*
+ * Check the options of a solicitation. Options of length zero are invalid,
+ * and duplicate address detection probes must not carry the source
+ * link-layer address option (RFC 4861, section 7.1.1).
+ */
+static __rte_always_inline bool
+ip6_ndp_opts_valid(const uint8_t *opt, uint16_t len, bool dad)
+{
+	uint16_t opt_len;
+
+	while (len > 0) {
+		if (len < 2)
+			return false;
+		opt_len = opt[1] * 8;
+		if (opt_len == 0 || opt_len > len)
+			return false;
+		if (dad && opt[0] == IP6_NDP_OPT_SLLA)
+			return false;
+		opt += opt_len;
+		len -= opt_len;
+	}
+
+	return true;
+}
+
+/*
+ * Turn a valid neighbor solicitation for one of the local addresses of the
+ * Rx port into the matching advertisement, in place.
+ */
+static __rte_always_inline uint16_t
+ip6_ndp_reply(struct rte_mbuf *mbuf)
+{
+	const struct rte_ipv6_addr allnodes = RTE_IPV6_ADDR_ALLNODES_LINK_LOCAL;
+	struct rte_ipv6_addr solnode;
+	struct rte_ipv6_hdr *ipv6_hdr;
+	struct ip6_ndp_lla_opt *opt;
+	struct rte_ether_hdr *eth;
+	struct ip6_ndp_port *port;
+	struct ip6_ndp_msg *msg;
+	bool solicited;
+
+	if (unlikely(mbuf->port >= RTE_MAX_ETHPORTS ||
+		     !rte_pktmbuf_is_contiguous(mbuf) ||
+		     mbuf->data_len < IP6_NDP_NS_MIN_LEN))
+		return RTE_NODE_IP6_NDP_NEXT_PKT_DROP;
+
+	port = &ip6_ndp_nm->port[mbuf->port];
+	eth = rte_pktmbuf_mtod(mbuf, struct rte_ether_hdr *);
+	ipv6_hdr = (struct rte_ipv6_hdr *)(eth + 1);
+	msg = (struct ip6_ndp_msg *)(ipv6_hdr + 1);
+
+	if (msg->base.type != IP6_NDP_TYPE_NS || msg->base.code != 0 ||
+	    ipv6_hdr->hop_limits != 255 ||
+	    rte_be_to_cpu_16(ipv6_hdr->payload_len) < sizeof(*msg) ||
+	    rte_be_to_cpu_16(ipv6_hdr->payload_len) >
+		    mbuf->data_len - (IP6_NDP_NS_MIN_LEN - sizeof(*msg)) ||
+	    port->next_index == 0 ||
+	    !ip6_ndp_addr_is_local(port, &msg->target) ||
+	    rte_ipv6_udptcp_cksum_verify(ipv6_hdr, msg) != 0)
+		return RTE_NODE_IP6_NDP_NEXT_PKT_DROP;
+
+	/*
+	 * Duplicate address detection probes are sent to the solicited-node
+	 * multicast address of the target, and are answered to all nodes.
+	 */
+	solicited = !rte_ipv6_addr_is_unspec(&ipv6_hdr->src_addr);
+	if (!solicited) {
+		rte_ipv6_solnode_from_addr(&solnode, &msg->target);
+		if (!rte_ipv6_addr_eq(&ipv6_hdr->dst_addr, &solnode))
+			return RTE_NODE_IP6_NDP_NEXT_PKT_DROP;
+	}
+	if (!ip6_ndp_opts_valid((const uint8_t *)(msg + 1),
+				rte_be_to_cpu_16(ipv6_hdr->payload_len) - sizeof(*msg),
+				!solicited))
+		return RTE_NODE_IP6_NDP_NEXT_PKT_DROP;
+
+	if (mbuf->data_len < IP6_NDP_NA_LEN) {
+		if (rte_pktmbuf_append(mbuf, IP6_NDP_NA_LEN - mbuf->data_len) == NULL)
+			return RTE_NODE_IP6_NDP_NEXT_PKT_DROP;
+	} else {
+		rte_pktmbuf_trim(mbuf, mbuf->data_len - IP6_NDP_NA_LEN);
+	}
+
+	if (solicited) {
+		rte_ether_addr_copy(&eth->src_addr, &eth->dst_addr);
+		ipv6_hdr->dst_addr = ipv6_hdr->src_addr;
+	} else {
+		rte_ether_mcast_from_ipv6(&eth->dst_addr, &allnodes);
+		ipv6_hdr->dst_addr = allnodes;
+	}
+	rte_ether_addr_copy(&port->mac, &eth->src_addr);
+
+	ipv6_hdr->vtc_flow = RTE_BE32(6 << 28);
+	ipv6_hdr->payload_len = rte_cpu_to_be_16(sizeof(*msg) + sizeof(*opt));
+	ipv6_hdr->proto = IPPROTO_ICMPV6;
+	ipv6_hdr->hop_limits = 255;
+	ipv6_hdr->src_addr = msg->target;
+
+	msg->base.type = IP6_NDP_TYPE_NA;
+	msg->base.checksum = 0;
+	msg->flags = IP6_NDP_NA_F_OVERRIDE |
+		     (port->router ? IP6_NDP_NA_F_ROUTER : 0) |
+		     (solicited ? IP6_NDP_NA_F_SOLICITED : 0);
+
+	opt = (struct ip6_ndp_lla_opt *)(msg + 1);
+	opt->type = IP6_NDP_OPT_TLLA;
+	opt->len = 1;
+	rte_ether_addr_copy(&port->mac, &opt->mac);
+
+	msg->base.checksum = rte_ipv6_udptcp_cksum(ipv6_hdr, msg);
+
+	return port->next_index;
+}
+
+static uint16_t
+ip6_ndp_node_process(struct rte_graph *graph, struct rte_node *node,
+		     void **objs, uint16_t nb_objs)
+{
+	struct rte_mbuf **pkts = (struct rte_mbuf **)objs;
+	void **to_next, **from;
+	uint16_t last_spec = 0;
+	rte_edge_t next_index;
+	uint16_t held = 0;
+	uint16_t next = 0;
+	int i;
+
+	/* Speculative next as last next */
+	next_index = IP6_NDP_NODE_NEXT_INDEX(node->ctx);
+
+	for (i = 0; i < 4 && i < nb_objs; i++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+
+	from = objs;
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	for (i = 0; i < nb_objs; i++) {
+		if (likely(i + 4 < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 4], void *));
+
+		next = ip6_ndp_reply(pkts[i]);
+
+		if (unlikely(next_index != next)) {
+			/* Copy things successfully speculated till now */
+			rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+			from += last_spec;
+			to_next += last_spec;
+			held += last_spec;
+			last_spec = 0;
+
+			rte_node_enqueue_x1(graph, node, next, from[0]);
+			from += 1;
+		} else {
+			last_spec += 1;
+		}
+	}
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+	/* Save the last next used */
+	IP6_NDP_NODE_NEXT_INDEX(node->ctx) = next;
+
+	return nb_objs;
+}
+
+static int
+ip6_ndp_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(struct ip6_ndp_node_ctx) > RTE_NODE_CTX_SZ);
+
+	if (ip6_ndp_nm == NULL) {
+		ip6_ndp_nm = rte_zmalloc("ip6_ndp", sizeof(struct ip6_ndp_node_main),
+					 RTE_CACHE_LINE_SIZE);
+		if (ip6_ndp_nm == NULL)
+			return -ENOMEM;
+	}
+	IP6_NDP_NODE_NEXT_INDEX(node->ctx) = RTE_NODE_IP6_NDP_NEXT_PKT_DROP;
+
+	node_dbg("ip6_ndp", "Initialized ip6_ndp node");
+	return 0;
+}
+
+int
+ip6_ndp_set_next(uint16_t port_id, uint16_t next_index)
+{
+	if (ip6_ndp_nm == NULL) {
+		ip6_ndp_nm = rte_zmalloc("ip6_ndp", sizeof(struct ip6_ndp_node_main),
+					 RTE_CACHE_LINE_SIZE);
+		if (ip6_ndp_nm == NULL)
+			return -ENOMEM;
+	}
+	ip6_ndp_nm->port[port_id].next_index = next_index;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_ndp_addr_add, 26.11)
+int
+rte_node_ip6_ndp_addr_add(uint16_t port_id, const struct rte_ipv6_addr *ip)
+{
+	struct ip6_ndp_port *port;
+	int rc;
+
+	if (ip == NULL || port_id >= RTE_MAX_ETHPORTS ||
+	    rte_ipv6_addr_is_mcast(ip) || rte_ipv6_addr_is_unspec(ip))
+		return -EINVAL;
+
+	/* Check if port doesn't exist as edge */
+	if (ip6_ndp_nm == NULL || !ip6_ndp_nm->port[port_id].next_index)
+		return -EINVAL;
+
+	port = &ip6_ndp_nm->port[port_id];
+	if (ip6_ndp_addr_is_local(port, ip))
+		return 0;
+	if (port->nb_addrs == RTE_GRAPH_IP6_NDP_MAX_ADDR)
+		return -ENOSPC;
+
+	rc = rte_eth_macaddr_get(port_id, &port->mac);
+	if (rc < 0)
+		return rc;
+
+	port->addrs[port->nb_addrs++] = *ip;
+	node_dbg("ip6_ndp", "Added local address to port %u", port_id);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_ndp_router_set, 26.11)
+int
+rte_node_ip6_ndp_router_set(uint16_t port_id, bool router)
+{
+	if (port_id >= RTE_MAX_ETHPORTS)
+		return -EINVAL;
+
+	/* Check if port doesn't exist as edge */
+	if (ip6_ndp_nm == NULL || !ip6_ndp_nm->port[port_id].next_index)
+		return -EINVAL;
+
+	ip6_ndp_nm->port[port_id].router = router;
+	node_dbg("ip6_ndp", "Port %u %s a router", port_id,
+		 router ? "is" : "is not");
+
+	return 0;
+}
+
+static struct rte_node_register ip6_ndp_node = {
+	.process = ip6_ndp_node_process,
+	.name = "ip6_ndp",
+
+	.init = ip6_ndp_node_init,
+
+	.nb_edges = RTE_NODE_IP6_NDP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_IP6_NDP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+struct rte_node_register *
+ip6_ndp_node_get(void)
+{
+	return &ip6_ndp_node;
+}
+
+RTE_NODE_REGISTER(ip6_ndp_node);
@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+#ifndef __INCLUDE_IP6_NDP_PRIV_H__
+#define __INCLUDE_IP6_NDP_PRIV_H__
+
+#include <rte_common.h>
+#include <rte_ether.h>
+#include <rte_ip6.h>
+
+#define RTE_GRAPH_IP6_NDP_MAX_ADDR 8
+
+/**
+ * @internal
+ *
+ * IPv6 neighbor discovery port data structure.
+ * Used to store the addresses a port answers solicitations for.
+ */
+struct ip6_ndp_port {
+	struct rte_ether_addr mac;
+	/**< Source mac address of the advertisements. */
+	uint16_t next_index;
+	/**< Tx node next index identifier. */
+	uint16_t nb_addrs;
+	/**< Number of local addresses. */
+	bool router;
+	/**< Advertise the port as a router. */
+	struct rte_ipv6_addr addrs[RTE_GRAPH_IP6_NDP_MAX_ADDR];
+	/**< Local addresses. */
+};
+
+/**
+ * @internal
+ *
+ * IPv6 neighbor discovery node main data structure.
+ */
+struct ip6_ndp_node_main {
+	struct ip6_ndp_port port[RTE_MAX_ETHPORTS];
+	/**< Array of port data. */
+};
+
+/**
+ * @internal
+ *
+ * Get the IPv6 neighbor discovery node.
+ *
+ * @return
+ *   Pointer to the IPv6 neighbor discovery node.
+ */
+struct rte_node_register *ip6_ndp_node_get(void);
+
+/**
+ * @internal
+ *
+ * Set the Edge index of a given port_id.
+ *
+ * @param port_id
+ *   Ethernet port identifier.
+ * @param next_index
+ *   Edge index of the Given Tx node.
+ */
+int ip6_ndp_set_next(uint16_t port_id, uint16_t next_index);
+
+#endif /* __INCLUDE_IP6_NDP_PRIV_H__ */
@@ -0,0 +1,228 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <netinet/in.h>
+#include <stdlib.h>
+
+#include <eal_export.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip6.h>
+#include <rte_ip_frag.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ip6_api.h"
+
+#include "ip6_reassembly_priv.h"
+#include "node_private.h"
+
+struct ip6_reassembly_elem {
+	struct ip6_reassembly_elem *next;
+	struct ip6_reassembly_ctx ctx;
+	rte_node_t node_id;
+};
+
+/* IP6 reassembly global data struct */
+struct ip6_reassembly_node_main {
+	struct ip6_reassembly_elem *head;
+};
+
+typedef struct ip6_reassembly_ctx ip6_reassembly_ctx_t;
+typedef struct ip6_reassembly_elem ip6_reassembly_elem_t;
+
+static struct ip6_reassembly_node_main ip6_reassembly_main;
+
+static __rte_always_inline struct rte_ipv6_hdr *
+ip6_reassembly_hdr(struct rte_mbuf *mbuf)
+{
+	return rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv6_hdr *,
+				       sizeof(struct rte_ether_hdr));
+}
+
+static __rte_always_inline struct rte_mbuf *
+ip6_reassembly_one(struct ip6_reassembly_ctx *ctx, struct rte_mbuf *mbuf,
+		   struct rte_ipv6_hdr *ipv6_hdr, uint64_t tms)
+{
+	struct rte_ipv6_fragment_ext *frag_hdr;
+
+	frag_hdr = rte_ipv6_frag_get_ipv6_fragment_header(ipv6_hdr);
+	if (frag_hdr == NULL)
+		return mbuf;
+
+	/* prepare mbuf: setup l2_len/l3_len. */
+	mbuf->l2_len = sizeof(struct rte_ether_hdr);
+	mbuf->l3_len = sizeof(struct rte_ipv6_hdr) + sizeof(*frag_hdr);
+
+	return rte_ipv6_frag_reassemble_packet(ctx->tbl, ctx->dr, mbuf, tms,
+					       ipv6_hdr, frag_hdr);
+}
+
+static uint16_t
+ip6_reassembly_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			    uint16_t nb_objs)
+{
+	struct rte_ipv6_hdr *ip0, *ip1, *ip2, *ip3;
+	struct rte_mbuf *mbuf, *mbuf_out, **pkts;
+	struct rte_ip_frag_death_row *dr;
+	struct ip6_reassembly_ctx *ctx;
+	void **to_next, **to_free;
+	uint16_t n_left_from;
+	uint16_t idx = 0;
+	uint64_t tms;
+	int i;
+
+	ctx = (struct ip6_reassembly_ctx *)node->ctx;
+	dr = ctx->dr;
+	tms = rte_rdtsc();
+
+	pkts = (struct rte_mbuf **)objs;
+	n_left_from = nb_objs;
+
+	for (i = 0; i < 4 && i < n_left_from; i++)
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[i], void *,
+						      sizeof(struct rte_ether_hdr)));
+
+	to_next = node->objs;
+	while (n_left_from >= 4) {
+		/* Prefetch next mbuf data */
+		if (likely(n_left_from > 7)) {
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[4], void *,
+						sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[5], void *,
+						sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[6], void *,
+						sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[7], void *,
+						sizeof(struct rte_ether_hdr)));
+		}
+
+		ip0 = ip6_reassembly_hdr(pkts[0]);
+		ip1 = ip6_reassembly_hdr(pkts[1]);
+		ip2 = ip6_reassembly_hdr(pkts[2]);
+		ip3 = ip6_reassembly_hdr(pkts[3]);
+
+		/* Pass the whole batch when none of them is a fragment */
+		if (likely(ip0->proto != IPPROTO_FRAGMENT &&
+			   ip1->proto != IPPROTO_FRAGMENT &&
+			   ip2->proto != IPPROTO_FRAGMENT &&
+			   ip3->proto != IPPROTO_FRAGMENT)) {
+			to_next[idx] = pkts[0];
+			to_next[idx + 1] = pkts[1];
+			to_next[idx + 2] = pkts[2];
+			to_next[idx + 3] = pkts[3];
+			idx += 4;
+		} else {
+			mbuf_out = ip6_reassembly_one(ctx, pkts[0], ip0, tms);
+			if (mbuf_out)
+				to_next[idx++] = (void *)mbuf_out;
+			mbuf_out = ip6_reassembly_one(ctx, pkts[1], ip1, tms);
+			if (mbuf_out)
+				to_next[idx++] = (void *)mbuf_out;
+			mbuf_out = ip6_reassembly_one(ctx, pkts[2], ip2, tms);
+			if (mbuf_out)
+				to_next[idx++] = (void *)mbuf_out;
+			mbuf_out = ip6_reassembly_one(ctx, pkts[3], ip3, tms);
+			if (mbuf_out)
+				to_next[idx++] = (void *)mbuf_out;
+		}
+
+		pkts += 4;
+		n_left_from -= 4;
+	}
+
+	while (n_left_from > 0) {
+		mbuf = pkts[0];
+
+		pkts += 1;
+		n_left_from -= 1;
+
+		mbuf_out = ip6_reassembly_one(ctx, mbuf, ip6_reassembly_hdr(mbuf), tms);
+		if (mbuf_out)
+			to_next[idx++] = (void *)mbuf_out;
+	}
+	node->idx = idx;
+	rte_node_next_stream_move(graph, node, 1);
+	if (dr->cnt) {
+		to_free = rte_node_next_stream_get(graph, node,
+						   RTE_NODE_IP6_REASSEMBLY_NEXT_PKT_DROP, dr->cnt);
+		rte_memcpy(to_free, dr->row, dr->cnt * sizeof(to_free[0]));
+		rte_node_next_stream_put(graph, node, RTE_NODE_IP6_REASSEMBLY_NEXT_PKT_DROP,
+					 dr->cnt);
+		idx += dr->cnt;
+		NODE_INCREMENT_XSTAT_ID(node, 0, dr->cnt, dr->cnt);
+		dr->cnt = 0;
+	}
+
+	return idx;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_reassembly_configure, 26.11)
+int
+rte_node_ip6_reassembly_configure(struct rte_node_ip6_reassembly_cfg *cfg, uint16_t cnt)
+{
+	ip6_reassembly_elem_t *elem;
+	int i;
+
+	for (i = 0; i < cnt; i++) {
+		elem = malloc(sizeof(ip6_reassembly_elem_t));
+		if (elem == NULL)
+			return -ENOMEM;
+		elem->ctx.dr = cfg[i].dr;
+		elem->ctx.tbl = cfg[i].tbl;
+		elem->node_id = cfg[i].node_id;
+		elem->next = ip6_reassembly_main.head;
+		ip6_reassembly_main.head = elem;
+	}
+
+	return 0;
+}
+
+static int
+ip6_reassembly_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	ip6_reassembly_ctx_t *ctx = (ip6_reassembly_ctx_t *)node->ctx;
+	ip6_reassembly_elem_t *elem = ip6_reassembly_main.head;
+
+	RTE_SET_USED(graph);
+	while (elem) {
+		if (elem->node_id == node->id) {
+			/* Update node specific context */
+			*ctx = elem->ctx;
+			break;
+		}
+		elem = elem->next;
+	}
+
+	return 0;
+}
+
+static struct rte_node_xstats ip6_reassembly_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "ip6_reassembly_error",
+	},
+};
+
+static struct rte_node_register ip6_reassembly_node = {
+	.process = ip6_reassembly_node_process,
+	.name = "ip6_reassembly",
+
+	.init = ip6_reassembly_node_init,
+	.xstats = &ip6_reassembly_xstats,
+
+	.nb_edges = RTE_NODE_IP6_REASSEMBLY_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_IP6_REASSEMBLY_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+struct rte_node_register *
+ip6_reassembly_node_get(void)
+{
+	return &ip6_reassembly_node;
+}
+
+RTE_NODE_REGISTER(ip6_reassembly_node);
@@ -0,0 +1,251 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <netinet/in.h>
+
+#include <eal_export.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_icmp.h>
+#include <rte_ip.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#include "rte_node_conntrack4_api.h"
+
+#include "conntrack4_priv.h"
+#include "node_private.h"
+
+struct nat4_node_ctx {
+	/* Dynamic offset to mbuf priv1 */
+	int mbuf_priv1_off;
+};
+
+#define NAT4_NODE_PRIV1_OFF(ctx) \
+	(((struct nat4_node_ctx *)ctx)->mbuf_priv1_off)
+
+/* Incremental update of a checksum with a 16-bit word, RFC 1624 */
+static __rte_always_inline uint32_t
+nat4_cksum_adjust(uint32_t sum, uint16_t old, uint16_t new)
+{
+	return sum + (uint16_t)~old + new;
+}
+
+static __rte_always_inline uint32_t
+nat4_cksum_adjust32(uint32_t sum, uint32_t old, uint32_t new)
+{
+	sum = nat4_cksum_adjust(sum, old >> 16, new >> 16);
+	return nat4_cksum_adjust(sum, old & 0xffff, new & 0xffff);
+}
+
+static __rte_always_inline uint16_t
+nat4_cksum_fold(uint16_t cksum, uint32_t sum)
+{
+	sum += (uint16_t)~cksum;
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+	return ~sum;
+}
+
+/* Translate a packet of a tracked connection to the key of the other direction. */
+static __rte_always_inline void
+nat4_translate(struct rte_mbuf *mbuf, const int dyn)
+{
+	struct conntrack4_main *cm = conntrack4_main_get();
+	rte_node_mbuf_overload_fields_t *priv1;
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_icmp_hdr *icmp_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	const struct ct4_key *t;
+	struct ct4_flow *flow;
+	uint32_t sum;
+	void *l4;
+
+	priv1 = node_mbuf_priv1(mbuf, dyn);
+	if (priv1->flow_id == CT4_FLOW_INVALID)
+		return;
+
+	flow = &cm->flows[priv1->flow_id];
+	if (likely(!flow->nat))
+		return;
+
+	/* Reverse of the key of the other direction */
+	t = &flow->key[!priv1->flow_dir];
+
+	ipv4_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
+					   sizeof(struct rte_ether_hdr));
+	l4 = RTE_PTR_ADD(ipv4_hdr, rte_ipv4_hdr_len(ipv4_hdr));
+
+	sum = nat4_cksum_adjust32(0, ipv4_hdr->src_addr, t->dst_ip);
+	sum = nat4_cksum_adjust32(sum, ipv4_hdr->dst_addr, t->src_ip);
+	ipv4_hdr->hdr_checksum = nat4_cksum_fold(ipv4_hdr->hdr_checksum, sum);
+	ipv4_hdr->src_addr = t->dst_ip;
+	ipv4_hdr->dst_addr = t->src_ip;
+
+	switch (ipv4_hdr->next_proto_id) {
+	case IPPROTO_TCP:
+		tcp_hdr = l4;
+		sum = nat4_cksum_adjust(sum, tcp_hdr->src_port, t->dst_port);
+		sum = nat4_cksum_adjust(sum, tcp_hdr->dst_port, t->src_port);
+		tcp_hdr->cksum = nat4_cksum_fold(tcp_hdr->cksum, sum);
+		tcp_hdr->src_port = t->dst_port;
+		tcp_hdr->dst_port = t->src_port;
+		break;
+	case IPPROTO_UDP:
+		udp_hdr = l4;
+		sum = nat4_cksum_adjust(sum, udp_hdr->src_port, t->dst_port);
+		sum = nat4_cksum_adjust(sum, udp_hdr->dst_port, t->src_port);
+		/* Zero UDP checksum means no checksum */
+		if (udp_hdr->dgram_cksum != 0) {
+			udp_hdr->dgram_cksum = nat4_cksum_fold(udp_hdr->dgram_cksum, sum);
+			if (udp_hdr->dgram_cksum == 0)
+				udp_hdr->dgram_cksum = 0xffff;
+		}
+		udp_hdr->src_port = t->dst_port;
+		udp_hdr->dst_port = t->src_port;
+		break;
+	case IPPROTO_ICMP:
+		/* ICMP checksum does not cover the IP addresses */
+		icmp_hdr = l4;
+		sum = nat4_cksum_adjust(0, icmp_hdr->icmp_ident, t->dst_port);
+		icmp_hdr->icmp_cksum = nat4_cksum_fold(icmp_hdr->icmp_cksum, sum);
+		icmp_hdr->icmp_ident = t->dst_port;
+		break;
+	}
+}
+
+static uint16_t
+nat4_node_process(struct rte_graph *graph, struct rte_node *node,
+		     void **objs, uint16_t nb_objs)
+{
+	const int dyn = NAT4_NODE_PRIV1_OFF(node->ctx);
+	struct rte_mbuf *mbuf0, *mbuf1, *mbuf2, *mbuf3;
+	struct rte_mbuf **pkts;
+	uint16_t n_left_from;
+
+	pkts = (struct rte_mbuf **)objs;
+	n_left_from = nb_objs;
+
+	if (n_left_from >= 4) {
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[0], void *,
+						      sizeof(struct rte_ether_hdr)));
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[1], void *,
+						      sizeof(struct rte_ether_hdr)));
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[2], void *,
+						      sizeof(struct rte_ether_hdr)));
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[3], void *,
+						      sizeof(struct rte_ether_hdr)));
+	}
+
+	while (n_left_from >= 4) {
+		/* Prefetch next-next mbufs */
+		if (likely(n_left_from > 11)) {
+			rte_prefetch0(pkts[8]);
+			rte_prefetch0(pkts[9]);
+			rte_prefetch0(pkts[10]);
+			rte_prefetch0(pkts[11]);
+		}
+
+		/* Prefetch next mbuf data */
+		if (likely(n_left_from > 7)) {
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[4], void *,
+							      sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[5], void *,
+							      sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[6], void *,
+							      sizeof(struct rte_ether_hdr)));
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[7], void *,
+							      sizeof(struct rte_ether_hdr)));
+		}
+
+		mbuf0 = pkts[0];
+		mbuf1 = pkts[1];
+		mbuf2 = pkts[2];
+		mbuf3 = pkts[3];
+		pkts += 4;
+		n_left_from -= 4;
+
+		nat4_translate(mbuf0, dyn);
+		nat4_translate(mbuf1, dyn);
+		nat4_translate(mbuf2, dyn);
+		nat4_translate(mbuf3, dyn);
+	}
+
+	while (n_left_from > 0) {
+		mbuf0 = pkts[0];
+		pkts += 1;
+		n_left_from -= 1;
+
+		nat4_translate(mbuf0, dyn);
+	}
+
+	/* All packets go to the lookup node */
+	rte_node_next_stream_move(graph, node, RTE_NODE_NAT4_NEXT_IP4_LOOKUP);
+
+	return nb_objs;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_nat4_rule_add, 26.11)
+int
+rte_node_nat4_rule_add(const struct rte_node_nat4_rule *rule)
+{
+	struct conntrack4_main *cm = conntrack4_main_get();
+	uint32_t mask;
+
+	if (rule == NULL || rule->depth > 32 ||
+	    (rule->type != RTE_NODE_NAT4_SNAT &&
+	     rule->type != RTE_NODE_NAT4_DNAT))
+		return -EINVAL;
+
+	mask = rule->depth ? RTE_GENMASK32(31, 32 - rule->depth) : 0;
+	if (rule->ip & ~mask)
+		return -EINVAL;
+
+	rte_spinlock_lock(&cm->lock);
+	if (cm->nb_rules == CT4_NAT_MAX_RULES) {
+		rte_spinlock_unlock(&cm->lock);
+		return -ENOSPC;
+	}
+	cm->rules[cm->nb_rules] = *rule;
+	cm->nb_rules++;
+	rte_spinlock_unlock(&cm->lock);
+
+	node_dbg("nat4", "Added NAT rule %u", cm->nb_rules);
+	return 0;
+}
+
+static int
+nat4_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	int dyn;
+
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(struct nat4_node_ctx) > RTE_NODE_CTX_SZ);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0)
+		return -rte_errno;
+
+	NAT4_NODE_PRIV1_OFF(node->ctx) = dyn;
+
+	node_dbg("nat4", "Initialized nat4 node");
+	return 0;
+}
+
+static struct rte_node_register nat4_node = {
+	.process = nat4_node_process,
+	.name = "nat4",
+
+	.init = nat4_node_init,
+
+	.nb_edges = RTE_NODE_NAT4_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_NAT4_NEXT_IP4_LOOKUP] = "ip4_lookup",
+		[RTE_NODE_NAT4_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(nat4_node);
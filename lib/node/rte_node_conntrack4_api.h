@@ -0,0 +1,241 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef __INCLUDE_RTE_NODE_CONNTRACK4_API_H__
+#define __INCLUDE_RTE_NODE_CONNTRACK4_API_H__
+
+/**
+ * @file rte_node_conntrack4_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows performing control path functions of the stateful
+ * conntrack4 and nat4 nodes.
+ *
+ * The conntrack4 node tracks the TCP, UDP and ICMP echo connections
+ * of the IPv4 packets it receives, in both directions, and drops the packets
+ * of the connections it fails to track. The nat4 node translates
+ * the addresses and ports of the tracked connections matching a NAT rule.
+ * Connections are expired when they are idle for the timeout of their state,
+ * by the graph which created them, or by rte_node_conntrack4_expire()
+ * when that graph does not receive packets.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+
+#include <rte_graph.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rte_rcu_qsbr;
+
+/**
+ * IP4 conntrack next nodes.
+ */
+enum rte_node_conntrack4_next {
+	RTE_NODE_CONNTRACK4_NEXT_NAT4,
+	/**< IP4 NAT node. */
+	RTE_NODE_CONNTRACK4_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * IP4 NAT next nodes.
+ */
+enum rte_node_nat4_next {
+	RTE_NODE_NAT4_NEXT_IP4_LOOKUP,
+	/**< IP4 lookup node. */
+	RTE_NODE_NAT4_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * IP4 conntrack timeouts.
+ * @see rte_node_conntrack4_timeout_set
+ */
+enum rte_node_conntrack4_timeout {
+	RTE_NODE_CONNTRACK4_TIMEOUT_TCP_SYN,
+	/**< TCP connection being opened, 120 s by default. */
+	RTE_NODE_CONNTRACK4_TIMEOUT_TCP_ESTABLISHED,
+	/**< TCP connection established, 7440 s by default. */
+	RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSING,
+	/**< TCP connection closed in one direction, 120 s by default. */
+	RTE_NODE_CONNTRACK4_TIMEOUT_TCP_CLOSED,
+	/**< TCP connection closed or reset, 10 s by default. */
+	RTE_NODE_CONNTRACK4_TIMEOUT_UDP,
+	/**< UDP flow without reply, 30 s by default. */
+	RTE_NODE_CONNTRACK4_TIMEOUT_UDP_STREAM,
+	/**< UDP flow with replies, 120 s by default. */
+	RTE_NODE_CONNTRACK4_TIMEOUT_ICMP,
+	/**< ICMP echo, 30 s by default. */
+	RTE_NODE_CONNTRACK4_TIMEOUT_MAX,
+	/**< Number of timeouts. */
+};
+
+/**
+ * IP4 conntrack configuration.
+ * @see rte_node_conntrack4_configure
+ */
+struct rte_node_conntrack4_config {
+	uint32_t max_flows;
+	/**< Maximum number of tracked connections. */
+	int socket_id;
+	/**< NUMA socket of the connection table. */
+	struct rte_rcu_qsbr *v;
+	/**< RCU QSBR variable of the lcores walking the graphs.
+	 * The connection entries are freed once the lcores went through
+	 * a quiescent state. If NULL, the entries are reused immediately,
+	 * so the conntrack4 node may be used by a single graph only.
+	 */
+};
+
+/**
+ * IP4 conntrack statistics.
+ * @see rte_node_conntrack4_stats_get
+ */
+struct rte_node_conntrack4_stats {
+	uint64_t active;
+	/**< Number of tracked connections. */
+	uint64_t created;
+	/**< Number of connections created. */
+	uint64_t expired;
+	/**< Number of connections expired. */
+	uint64_t insert_failed;
+	/**< Number of packets dropped because their connection was not created. */
+};
+
+/**
+ * IP4 NAT types.
+ */
+enum rte_node_nat4_type {
+	RTE_NODE_NAT4_SNAT,
+	/**< Source address translation. */
+	RTE_NODE_NAT4_DNAT,
+	/**< Destination address and port translation. */
+};
+
+/**
+ * IP4 NAT rule, with addresses and ports in host byte order.
+ * @see rte_node_nat4_rule_add
+ */
+struct rte_node_nat4_rule {
+	enum rte_node_nat4_type type;
+	/**< Type of translation. */
+	uint32_t ip;
+	/**< Source prefix for SNAT, destination prefix for DNAT. */
+	uint8_t depth;
+	/**< Depth of the prefix. */
+	uint8_t proto;
+	/**< DNAT only: IP protocol to match, 0 for any. */
+	uint16_t port;
+	/**< DNAT only: destination port to match, 0 for any. */
+	uint32_t nat_ip;
+	/**< Translated address. */
+	uint16_t nat_port;
+	/**< DNAT only: translated destination port, 0 to keep it.
+	 * SNAT keeps the source port, unless it is already used
+	 * by another connection to the same destination.
+	 */
+};
+
+/**
+ * Configure the connection tracking table.
+ *
+ * Must be called before creating the graphs using the conntrack4 node,
+ * otherwise a table of 65536 connections is created
+ * on the socket of the first graph, without RCU QSBR variable.
+ * Creating a second graph using the conntrack4 node fails
+ * when no RCU QSBR variable is configured.
+ * The table is replaced only after the graphs using the conntrack4 node
+ * were destroyed, and the lcores went through a quiescent state.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ *
+ * @return
+ *   0 on success, -EBUSY if the table is still in use, negative otherwise.
+ */
+__rte_experimental
+int rte_node_conntrack4_configure(const struct rte_node_conntrack4_config *cfg);
+
+/**
+ * Set the idle timeout of the connections in a given state.
+ *
+ * @param timeout
+ *   Timeout to set.
+ * @param seconds
+ *   Timeout in seconds.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_conntrack4_timeout_set(enum rte_node_conntrack4_timeout timeout,
+				       uint32_t seconds);
+
+/**
+ * Get the idle timeout of the connections in a given state.
+ *
+ * @param timeout
+ *   Timeout to get.
+ *
+ * @return
+ *   Timeout in seconds, 0 if invalid.
+ */
+__rte_experimental
+uint32_t rte_node_conntrack4_timeout_get(enum rte_node_conntrack4_timeout timeout);
+
+/**
+ * Get the connection tracking statistics, summed over all the graphs.
+ *
+ * @param stats
+ *   Pointer to the statistics to fill.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_conntrack4_stats_get(struct rte_node_conntrack4_stats *stats);
+
+/**
+ * Expire the idle connections of the graphs.
+ *
+ * The conntrack4 node of a graph expires its connections
+ * when it processes packets only. This function should be called
+ * periodically, e.g. every second by the main lcore, so that
+ * the connections of the graphs without traffic are expired too.
+ * At most 64 connections are expired per graph and per call.
+ *
+ * @return
+ *   Number of connections expired,
+ *   -ENOTSUP if no RCU QSBR variable is configured.
+ */
+__rte_experimental
+int rte_node_conntrack4_expire(void);
+
+/**
+ * Add a NAT rule.
+ *
+ * The rules are matched in the order they were added, on the first packet
+ * of a connection. At most one DNAT rule, then one SNAT rule are applied.
+ * The rules do not apply to the connections already tracked.
+ *
+ * @param rule
+ *   Pointer to the rule.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_nat4_rule_add(const struct rte_node_nat4_rule *rule);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_CONNTRACK4_API_H__ */
@@ -13,11 +13,12 @@
  * All functions in this file may be changed or removed without prior notice.
  *
  * This API allows performing control path functions of ip6_* nodes
- * like ip6_lookup, ip6_rewrite.
+ * like ip6_lookup, ip6_rewrite, ip6_reassembly and ip6_ndp.
  */
 #include <rte_common.h>
 #include <rte_compat.h>
 #include <rte_fib6.h>
+#include <rte_graph.h>
 #include <rte_ip6.h>
 
 #ifdef __cplusplus
@@ -30,10 +31,53 @@ extern "C" {
 enum rte_node_ip6_lookup_next {
 	RTE_NODE_IP6_LOOKUP_NEXT_REWRITE,
 	/**< Rewrite node. */
+	RTE_NODE_IP6_LOOKUP_NEXT_IP6_LOCAL,
+	/**< IP6 local node. */
 	RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP,
 	/**< Packet drop node. */
 };
 
+/**
+ * IP6 local next nodes.
+ */
+enum rte_node_ip6_local_next {
+	RTE_NODE_IP6_LOCAL_NEXT_UDP6_INPUT,
+	/**< UDP6 input node. */
+	RTE_NODE_IP6_LOCAL_NEXT_IP6_NDP,
+	/**< IP6 neighbor discovery node. */
+	RTE_NODE_IP6_LOCAL_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * IP6 reassembly next nodes.
+ */
+enum rte_node_ip6_reassembly_next {
+	RTE_NODE_IP6_REASSEMBLY_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * IP6 neighbor discovery next nodes.
+ */
+enum rte_node_ip6_ndp_next {
+	RTE_NODE_IP6_NDP_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * Reassembly configure structure.
+ * @see rte_node_ip6_reassembly_configure
+ */
+struct rte_node_ip6_reassembly_cfg {
+	struct rte_ip_frag_tbl *tbl;
+	/**< Reassembly fragmentation table. */
+	struct rte_ip_frag_death_row *dr;
+	/**< Reassembly deathrow table. */
+	rte_node_t node_id;
+	/**< Node identifier to configure. */
+};
+
 /**
  * Add IPv6 route to lookup table.
  *
@@ -72,6 +116,57 @@ __rte_experimental
 int rte_node_ip6_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 			     uint8_t rewrite_len, uint16_t dst_port);
 
+/**
+ * Add reassembly node configuration data.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ * @param cnt
+ *   Number of configuration structures passed.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_reassembly_configure(struct rte_node_ip6_reassembly_cfg *cfg, uint16_t cnt);
+
+/**
+ * Add a local IPv6 address the ip6_ndp node answers neighbor solicitations for.
+ *
+ * The neighbor advertisements are sent from the MAC address of the port,
+ * so the port must have been configured with rte_node_eth_config() first.
+ * Packets to the address and to its solicited-node multicast address
+ * must be routed to RTE_NODE_IP6_LOOKUP_NEXT_IP6_LOCAL.
+ *
+ * @param port_id
+ *   Ethernet port identifier owning the address.
+ * @param ip
+ *   IPv6 address.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_ndp_addr_add(uint16_t port_id, const struct rte_ipv6_addr *ip);
+
+/**
+ * Set whether the ip6_ndp node advertises a port as a router.
+ *
+ * The router flag of the neighbor advertisements sent on a port
+ * is set only if the port is configured as a router, which it is not by default.
+ * The port must have been configured with rte_node_eth_config() first.
+ *
+ * @param port_id
+ *   Ethernet port identifier.
+ * @param router
+ *   True if the port is a router interface.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_ndp_router_set(uint16_t port_id, bool router);
+
 /**
  * Create ipv6 FIB.
  *
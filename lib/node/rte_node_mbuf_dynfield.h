@@ -56,6 +56,11 @@ typedef struct rte_node_mbuf_overload_fields {
 			};
 			uint64_t u;
 		};
+		/* Following fields used by conntrack4 -> nat4 nodes */
+		struct {
+			uint32_t flow_id;
+			uint8_t flow_dir;
+		};
 		uint8_t data[RTE_NODE_MBUF_OVERLOADABLE_FIELDS_SIZE];
 	};
 } rte_node_mbuf_overload_fields_t;
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef __INCLUDE_RTE_NODE_UDP6_INPUT_API_H__
+#define __INCLUDE_RTE_NODE_UDP6_INPUT_API_H__
+
+/**
+ * @file rte_node_udp6_input_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows performing control path functions of udp6_* nodes
+ * like udp6_input.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+
+#include "rte_graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * UDP6 lookup next nodes.
+ */
+enum rte_node_udp6_input_next {
+	RTE_NODE_UDP6_INPUT_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * Add usr node to receive udp6 frames.
+ *
+ * @param usr_node
+ *   Node registered by user to receive data.
+ * @return
+ *   Edge identifier of the user node in udp6_input.
+ */
+__rte_experimental
+int rte_node_udp6_usr_node_add(const char *usr_node);
+
+/**
+ * Add udpv6 dst_port to lookup table.
+ *
+ * @param dst_port
+ *   Dst Port of packet to be added for consumption.
+ * @param next_node
+ *   Next node packet to be added for consumption.
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_udp6_dst_port_add(uint32_t dst_port, rte_edge_t next_node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_UDP6_INPUT_API_H__ */
@@ -0,0 +1,228 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <eal_export.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_hash.h>
+#include <rte_ip6.h>
+#include <rte_jhash.h>
+#include <rte_lcore.h>
+#include <rte_udp.h>
+
+#include "rte_node_udp6_input_api.h"
+
+#include "node_private.h"
+
+#define UDP6_INPUT_HASH_TBL_SIZE 1024
+
+#define UDP6_INPUT_NODE_HASH(ctx) \
+	(((struct udp6_input_node_ctx *)ctx)->hash)
+
+#define UDP6_INPUT_NODE_NEXT_INDEX(ctx) \
+	(((struct udp6_input_node_ctx *)ctx)->next_index)
+
+/* UDP6 input global data struct */
+struct udp6_input_node_main {
+	struct rte_hash *hash_tbl[RTE_MAX_NUMA_NODES];
+};
+
+static struct udp6_input_node_main udp6_input_nm;
+
+struct udp6_input_node_ctx {
+	/* Socket's Hash table */
+	struct rte_hash *hash;
+	/* Cached next index */
+	uint16_t next_index;
+};
+
+static struct rte_hash_parameters udp6_params = {
+	.entries = UDP6_INPUT_HASH_TBL_SIZE,
+	.key_len = sizeof(uint32_t),
+	.hash_func = rte_jhash,
+	.hash_func_init_val = 0,
+	.socket_id = 0,
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_udp6_dst_port_add, 26.11)
+int
+rte_node_udp6_dst_port_add(uint32_t dst_port, rte_edge_t next_node)
+{
+	uint8_t socket;
+	int rc;
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		if (!udp6_input_nm.hash_tbl[socket])
+			continue;
+
+		rc = rte_hash_add_key_data(udp6_input_nm.hash_tbl[socket],
+					   &dst_port, (void *)(uintptr_t)next_node);
+		if (rc < 0) {
+			node_err("udp6_input", "Failed to add key for sock %u, rc=%d",
+				 socket, rc);
+			return rc;
+		}
+	}
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_udp6_usr_node_add, 26.11)
+int
+rte_node_udp6_usr_node_add(const char *usr_node)
+{
+	const char *next_nodes = usr_node;
+	rte_node_t udp6_input_node_id, count;
+
+	udp6_input_node_id = rte_node_from_name("udp6_input");
+	count = rte_node_edge_update(udp6_input_node_id, RTE_EDGE_ID_INVALID,
+				     &next_nodes, 1);
+	if (count == 0) {
+		node_dbg("udp6_input", "Adding usr node as edge to udp6_input failed");
+		return count;
+	}
+	count = rte_node_edge_count(udp6_input_node_id) - 1;
+	return count;
+}
+
+static int
+setup_udp6_dstprt_hash(struct udp6_input_node_main *nm, int socket)
+{
+	struct rte_hash_parameters *hash_udp6 = &udp6_params;
+	char s[RTE_HASH_NAMESIZE];
+
+	/* One Hash table per socket */
+	if (nm->hash_tbl[socket])
+		return 0;
+
+	/* create Hash table */
+	snprintf(s, sizeof(s), "UDP6_INPUT_HASH_%d", socket);
+	hash_udp6->name = s;
+	hash_udp6->socket_id = socket;
+	nm->hash_tbl[socket] = rte_hash_create(hash_udp6);
+	if (nm->hash_tbl[socket] == NULL)
+		return -rte_errno;
+
+	return 0;
+}
+
+static int
+udp6_input_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	uint16_t socket, lcore_id;
+	static uint8_t init_once;
+	int rc;
+
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(struct udp6_input_node_ctx) > RTE_NODE_CTX_SZ);
+
+	if (!init_once) {
+		/* Setup HASH tables for all sockets */
+		RTE_LCORE_FOREACH(lcore_id)
+		{
+			socket = rte_lcore_to_socket_id(lcore_id);
+			rc = setup_udp6_dstprt_hash(&udp6_input_nm, socket);
+			if (rc) {
+				node_err("udp6_input",
+					 "Failed to setup hash tbl for sock %u, rc=%d",
+					 socket, rc);
+				return rc;
+			}
+		}
+		init_once = 1;
+	}
+
+	UDP6_INPUT_NODE_HASH(node->ctx) = udp6_input_nm.hash_tbl[graph->socket];
+
+	node_dbg("udp6_input", "Initialized udp6_input node");
+	return 0;
+}
+
+static uint16_t
+udp6_input_node_process(struct rte_graph *graph, struct rte_node *node,
+			void **objs, uint16_t nb_objs)
+{
+	struct rte_hash *hash_tbl_handle = UDP6_INPUT_NODE_HASH(node->ctx);
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t keys[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_udp_hdr *pkt_udp_hdr;
+	uint16_t n, base, last_spec = 0;
+	rte_edge_t next_index, next = 0;
+	void **to_next, **from;
+	struct rte_mbuf *mbuf;
+	uint16_t held = 0;
+	uint64_t hit_mask;
+	int i;
+
+	/* Speculative next */
+	next_index = UDP6_INPUT_NODE_NEXT_INDEX(node->ctx);
+
+	from = objs;
+
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	for (base = 0; base < nb_objs; base += n) {
+		n = RTE_MIN(nb_objs - base, RTE_HASH_LOOKUP_BULK_MAX);
+
+		/* Gather the destination ports, then look them up at once */
+		for (i = 0; i < n; i++) {
+			mbuf = (struct rte_mbuf *)objs[base + i];
+			pkt_udp_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_udp_hdr *,
+							sizeof(struct rte_ether_hdr) +
+							sizeof(struct rte_ipv6_hdr));
+			keys[i] = rte_be_to_cpu_16(pkt_udp_hdr->dst_port);
+			key_ptrs[i] = &keys[i];
+		}
+
+		hit_mask = 0;
+		rte_hash_lookup_bulk_data(hash_tbl_handle, key_ptrs, n, &hit_mask,
+					  data);
+
+		for (i = 0; i < n; i++) {
+			next = (hit_mask & RTE_BIT64(i)) ?
+				(rte_edge_t)(uintptr_t)data[i] :
+				RTE_NODE_UDP6_INPUT_NEXT_PKT_DROP;
+
+			if (unlikely(next_index != next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
+		}
+	}
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+	/* Save the last next used */
+	UDP6_INPUT_NODE_NEXT_INDEX(node->ctx) = next;
+
+	return nb_objs;
+}
+
+static struct rte_node_register udp6_input_node = {
+	.process = udp6_input_node_process,
+	.name = "udp6_input",
+
+	.init = udp6_input_node_init,
+
+	.nb_edges = RTE_NODE_UDP6_INPUT_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_UDP6_INPUT_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(udp6_input_node);
@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _PQUEUE_PVT_H_
+#define _PQUEUE_PVT_H_
+
+#include <rte_log.h>
+
+extern int pqueue_logtype;
+#define RTE_LOGTYPE_PQUEUE pqueue_logtype
+
+#define PQUEUE_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, PQUEUE, "%s(): ", __func__, __VA_ARGS__)
+
+#define PQUEUE_LOG_ERR(...) \
+	PQUEUE_LOG(ERR, __VA_ARGS__)
+
+#endif /* _PQUEUE_PVT_H_ */
@@ -0,0 +1,239 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/queue.h>
+
+#include <eal_export.h>
+#include <rte_string_fns.h>
+#include <rte_eal_memconfig.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_memzone.h>
+#include <rte_tailq.h>
+
+#include "rte_pqueue.h"
+#include "pqueue_pvt.h"
+
+TAILQ_HEAD(rte_pqueue_list, rte_tailq_entry);
+
+static struct rte_tailq_elem rte_pqueue_tailq = {
+	.name = RTE_TAILQ_PQUEUE_NAME,
+};
+EAL_REGISTER_TAILQ(rte_pqueue_tailq)
+
+#define PQUEUE_SYNC_FLAGS (RING_F_SP_ENQ | RING_F_SC_DEQ | \
+			   RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ | \
+			   RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ | \
+			   RING_F_EXACT_SZ)
+
+/* Size of the ring of one priority level */
+static ssize_t
+pqueue_ring_memsize(unsigned int esize, unsigned int count, unsigned int flags)
+{
+	if (flags & RING_F_EXACT_SZ)
+		count = rte_align32pow2(count + 1);
+
+	return rte_ring_get_memsize_elem(esize, count);
+}
+
+static int
+pqueue_init(struct rte_pqueue *pq, unsigned int esize, unsigned int count,
+	    unsigned int nb_prio, size_t ring_sz, unsigned int flags)
+{
+	char ring_name[RTE_RING_NAMESIZE];
+	unsigned int i;
+	int ret;
+
+	memset(pq, 0, sizeof(*pq));
+
+	for (i = 0; i != nb_prio; i++) {
+		pq->levels[i] = RTE_PTR_ADD(pq, sizeof(*pq) + i * ring_sz);
+		snprintf(ring_name, sizeof(ring_name), "pq_prio%u", i);
+		ret = rte_ring_init(pq->levels[i], ring_name, count, flags);
+		if (ret != 0)
+			return ret;
+	}
+
+	pq->capacity = rte_ring_get_capacity(pq->levels[0]);
+	pq->esize = esize;
+	pq->nb_prio = nb_prio;
+	pq->flags = flags;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pqueue_create, 26.11)
+struct rte_pqueue *
+rte_pqueue_create(const char *name, unsigned int esize, unsigned int count,
+		  unsigned int nb_prio, int socket_id, unsigned int flags)
+{
+	char mz_name[RTE_MEMZONE_NAMESIZE];
+	struct rte_pqueue_list *pqueue_list;
+	const struct rte_memzone *mz;
+	struct rte_tailq_entry *te;
+	struct rte_pqueue *pq;
+	ssize_t ring_sz;
+	int ret;
+
+	if (name == NULL || nb_prio == 0 || nb_prio > RTE_PQUEUE_PRIO_MAX) {
+		PQUEUE_LOG_ERR("Invalid name or number of priority levels");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	if (flags & ~PQUEUE_SYNC_FLAGS) {
+		PQUEUE_LOG_ERR("Unsupported priority queue flags %#x", flags);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	ring_sz = pqueue_ring_memsize(esize, count, flags);
+	if (ring_sz < 0) {
+		PQUEUE_LOG_ERR("Invalid object size or count");
+		rte_errno = -ring_sz;
+		return NULL;
+	}
+
+	ret = snprintf(mz_name, sizeof(mz_name), "%s%s",
+		       RTE_PQUEUE_MZ_PREFIX, name);
+	if (ret < 0 || ret >= (int)sizeof(mz_name)) {
+		rte_errno = ENAMETOOLONG;
+		return NULL;
+	}
+
+	te = rte_zmalloc("PQUEUE_TAILQ_ENTRY", sizeof(*te), 0);
+	if (te == NULL) {
+		PQUEUE_LOG_ERR("Cannot reserve memory for tailq");
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	rte_mcfg_tailq_write_lock();
+
+	mz = rte_memzone_reserve_aligned(mz_name,
+					 sizeof(*pq) + nb_prio * ring_sz,
+					 socket_id, 0, RTE_CACHE_LINE_SIZE);
+	if (mz == NULL) {
+		PQUEUE_LOG_ERR("Cannot reserve priority queue memzone!");
+		rte_mcfg_tailq_write_unlock();
+		rte_free(te);
+		return NULL;
+	}
+
+	pq = mz->addr;
+
+	ret = pqueue_init(pq, esize, count, nb_prio, ring_sz, flags);
+	if (ret != 0) {
+		rte_mcfg_tailq_write_unlock();
+
+		rte_errno = -ret;
+		rte_free(te);
+		rte_memzone_free(mz);
+		return NULL;
+	}
+
+	/* Store the name for later lookups */
+	strlcpy(pq->name, name, sizeof(pq->name));
+	pq->memzone = mz;
+
+	te->data = pq;
+
+	pqueue_list = RTE_TAILQ_CAST(rte_pqueue_tailq.head, rte_pqueue_list);
+
+	TAILQ_INSERT_TAIL(pqueue_list, te, next);
+
+	rte_mcfg_tailq_write_unlock();
+
+	return pq;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pqueue_free, 26.11)
+void
+rte_pqueue_free(struct rte_pqueue *pq)
+{
+	struct rte_pqueue_list *pqueue_list;
+	struct rte_tailq_entry *te;
+
+	if (pq == NULL)
+		return;
+
+	pqueue_list = RTE_TAILQ_CAST(rte_pqueue_tailq.head, rte_pqueue_list);
+	rte_mcfg_tailq_write_lock();
+
+	/* find out tailq entry */
+	TAILQ_FOREACH(te, pqueue_list, next) {
+		if (te->data == pq)
+			break;
+	}
+
+	if (te == NULL) {
+		rte_mcfg_tailq_write_unlock();
+		return;
+	}
+
+	TAILQ_REMOVE(pqueue_list, te, next);
+
+	rte_mcfg_tailq_write_unlock();
+
+	rte_free(te);
+
+	rte_memzone_free(pq->memzone);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pqueue_lookup, 26.11)
+struct rte_pqueue *
+rte_pqueue_lookup(const char *name)
+{
+	struct rte_pqueue_list *pqueue_list;
+	struct rte_tailq_entry *te;
+	struct rte_pqueue *pq = NULL;
+
+	if (name == NULL) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	pqueue_list = RTE_TAILQ_CAST(rte_pqueue_tailq.head, rte_pqueue_list);
+
+	rte_mcfg_tailq_read_lock();
+
+	TAILQ_FOREACH(te, pqueue_list, next) {
+		pq = (struct rte_pqueue *) te->data;
+		if (strncmp(name, pq->name, RTE_PQUEUE_NAMESIZE) == 0)
+			break;
+	}
+
+	rte_mcfg_tailq_read_unlock();
+
+	if (te == NULL) {
+		rte_errno = ENOENT;
+		return NULL;
+	}
+
+	return pq;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pqueue_dump, 26.11)
+void
+rte_pqueue_dump(FILE *f, const struct rte_pqueue *pq)
+{
+	unsigned int i;
+
+	if (f == NULL || pq == NULL)
+		return;
+
+	fprintf(f, "priority queue <%s>@%p\n", pq->name, pq);
+	fprintf(f, "  flags=%x\n", pq->flags);
+	fprintf(f, "  esize=%u\n", pq->esize);
+	fprintf(f, "  capacity=%u\n", pq->capacity);
+	fprintf(f, "  nb_prio=%u\n", pq->nb_prio);
+	for (i = 0; i != pq->nb_prio; i++)
+		fprintf(f, "  prio%u: used=%u avail=%u\n", i,
+			rte_ring_count(pq->levels[i]),
+			rte_ring_free_count(pq->levels[i]));
+}
+
+RTE_LOG_REGISTER_DEFAULT(pqueue_logtype, NOTICE);
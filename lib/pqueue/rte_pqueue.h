@@ -0,0 +1,495 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_PQUEUE_H_
+#define _RTE_PQUEUE_H_
+
+/**
+ * @file rte_pqueue.h
+ *
+ * RTE Priority Queue.
+ *
+ * librte_pqueue provides a bounded multi-producer/multi-consumer priority
+ * queue of fixed size objects. Objects are enqueued at one of a fixed
+ * number of priority levels, 0 being the highest, and dequeued in strict
+ * priority order, FIFO within a level.
+ *
+ * Each priority level is an rte_ring, so that enqueue and dequeue are
+ * lock-free and support the same producer/consumer synchronization modes
+ * as rte_ring: multi-thread (MP/MC), single thread (SP/SC), relaxed tail
+ * sync (RTS) and head/tail sync (HTS), selected with the RING_F_* flags at
+ * creation time.
+ *
+ * As the levels are independent rings, the priority order is exact with
+ * a single consumer. With several consumers, or with producers running
+ * concurrently to a dequeue, an object enqueued at a higher priority
+ * while a dequeue is scanning lower levels is only seen by the next
+ * dequeue.
+ */
+
+#include <stdio.h>
+
+#include <rte_common.h>
+#include <rte_debug.h>
+#include <rte_memzone.h>
+#include <rte_ring_elem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTE_TAILQ_PQUEUE_NAME "RTE_PQUEUE"
+#define RTE_PQUEUE_MZ_PREFIX "PQ_"
+/** The maximum length of a priority queue name. */
+#define RTE_PQUEUE_NAMESIZE (RTE_MEMZONE_NAMESIZE - \
+			     sizeof(RTE_PQUEUE_MZ_PREFIX) + 1)
+
+/** The maximum number of priority levels of a priority queue. */
+#define RTE_PQUEUE_PRIO_MAX 64
+
+/** Highest priority level. */
+#define RTE_PQUEUE_PRIO_HIGHEST 0
+
+/* The RTE priority queue structure contains one ring per priority level,
+ * plus metadata such as its name and memzone pointer.
+ */
+struct __rte_cache_aligned rte_pqueue {
+	/** Name of the priority queue. */
+	char name[RTE_PQUEUE_NAMESIZE];
+	/** Memzone containing the rte_pqueue structure and its rings. */
+	const struct rte_memzone *memzone;
+	uint32_t capacity; /**< Usable size of each priority level. */
+	uint32_t esize; /**< Size of the objects, in bytes. */
+	uint32_t nb_prio; /**< Number of priority levels. */
+	uint32_t flags; /**< Flags supplied at creation. */
+	/** Ring of each priority level, highest priority first. */
+	struct rte_ring *levels[RTE_PQUEUE_PRIO_MAX];
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Create a new priority queue in memory.
+ *
+ * @param name
+ *   The name to be assigned to the priority queue.
+ * @param esize
+ *   The size of the objects, in bytes. It must be a multiple of 4.
+ * @param count
+ *   The size of each priority level. As for rte_ring, it must be a power
+ *   of 2 and the level holds count - 1 objects, unless RING_F_EXACT_SZ is
+ *   set in which case the level holds exactly count objects.
+ * @param nb_prio
+ *   The number of priority levels, at most RTE_PQUEUE_PRIO_MAX.
+ * @param socket_id
+ *   The *socket_id* argument is the socket identifier in case of NUMA.
+ *   The value can be *SOCKET_ID_ANY* if there is no NUMA constraint for the
+ *   reserved zone.
+ * @param flags
+ *   An OR of the rte_ring flags selecting the synchronization mode of the
+ *   producers (RING_F_SP_ENQ, RING_F_MP_RTS_ENQ or RING_F_MP_HTS_ENQ,
+ *   multi-producer otherwise) and of the consumers (RING_F_SC_DEQ,
+ *   RING_F_MC_RTS_DEQ or RING_F_MC_HTS_DEQ, multi-consumer otherwise),
+ *   and RING_F_EXACT_SZ.
+ * @return
+ *   On success, the pointer to the new allocated priority queue. NULL on
+ *   error with rte_errno set appropriately. Possible errno values include:
+ *    - EINVAL - invalid parameter passed to function
+ *    - ENOSPC - the maximum number of memzones has already been allocated
+ *    - EEXIST - a memzone with the same name already exists
+ *    - ENOMEM - insufficient memory to create the priority queue
+ *    - ENAMETOOLONG - name size exceeds RTE_PQUEUE_NAMESIZE
+ */
+__rte_experimental
+struct rte_pqueue *
+rte_pqueue_create(const char *name, unsigned int esize, unsigned int count,
+		  unsigned int nb_prio, int socket_id, unsigned int flags);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Free all memory used by the priority queue.
+ *
+ * @param pq
+ *   Priority queue to free. If NULL then, the function does nothing.
+ */
+__rte_experimental
+void
+rte_pqueue_free(struct rte_pqueue *pq);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Lookup a priority queue by its name.
+ *
+ * @param name
+ *   The name of the priority queue.
+ * @return
+ *   The pointer to the priority queue matching the name, or NULL if not
+ *   found, with rte_errno set appropriately. Possible rte_errno values
+ *   include:
+ *    - ENOENT - Priority queue with name *name* not found.
+ *    - EINVAL - *name* pointer is NULL.
+ */
+__rte_experimental
+struct rte_pqueue *
+rte_pqueue_lookup(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dump the status of the priority queue to a file.
+ *
+ * @param f
+ *   A pointer to a file for output.
+ * @param pq
+ *   A pointer to the priority queue structure.
+ */
+__rte_experimental
+void
+rte_pqueue_dump(FILE *f, const struct rte_pqueue *pq);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Return the number of objects queued at a priority level.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @param prio
+ *   The priority level.
+ * @return
+ *   The number of objects at the priority level.
+ */
+__rte_experimental
+static inline unsigned int
+rte_pqueue_prio_count(const struct rte_pqueue *pq, unsigned int prio)
+{
+	RTE_ASSERT(prio < pq->nb_prio);
+
+	return rte_ring_count(pq->levels[prio]);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Return the number of free entries of a priority level.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @param prio
+ *   The priority level.
+ * @return
+ *   The number of objects which can still be enqueued at the level.
+ */
+__rte_experimental
+static inline unsigned int
+rte_pqueue_prio_free_count(const struct rte_pqueue *pq, unsigned int prio)
+{
+	RTE_ASSERT(prio < pq->nb_prio);
+
+	return rte_ring_free_count(pq->levels[prio]);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Return the number of objects in the priority queue, all levels included.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @return
+ *   The number of objects in the priority queue.
+ */
+__rte_experimental
+static inline unsigned int
+rte_pqueue_count(const struct rte_pqueue *pq)
+{
+	unsigned int i, count = 0;
+
+	for (i = 0; i != pq->nb_prio; i++)
+		count += rte_ring_count(pq->levels[i]);
+
+	return count;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Test if the priority queue is empty.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @return
+ *   - 1: The priority queue is empty.
+ *   - 0: The priority queue is not empty.
+ */
+__rte_experimental
+static inline int
+rte_pqueue_empty(const struct rte_pqueue *pq)
+{
+	unsigned int i;
+
+	for (i = 0; i != pq->nb_prio; i++)
+		if (!rte_ring_empty(pq->levels[i]))
+			return 0;
+
+	return 1;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enqueue several objects at a priority level.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @param obj_table
+ *   A pointer to a table of objects.
+ * @param esize
+ *   The size of the objects, in bytes. It must be the size given to
+ *   rte_pqueue_create().
+ * @param n
+ *   The number of objects to enqueue from obj_table.
+ * @param prio
+ *   The priority level of the objects, 0 being the highest.
+ * @param free_space
+ *   If non-NULL, returns the amount of space left at the priority level
+ *   after the enqueue operation has finished.
+ * @return
+ *   The number of objects enqueued, either 0 or n.
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_enqueue_bulk_elem(struct rte_pqueue *pq, const void *obj_table,
+			     unsigned int esize, unsigned int n,
+			     unsigned int prio, unsigned int *free_space)
+{
+	RTE_ASSERT(esize == pq->esize);
+	RTE_ASSERT(prio < pq->nb_prio);
+
+	return rte_ring_enqueue_bulk_elem(pq->levels[prio], obj_table, esize,
+					  n, free_space);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enqueue up to n objects at a priority level.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @param obj_table
+ *   A pointer to a table of objects.
+ * @param esize
+ *   The size of the objects, in bytes. It must be the size given to
+ *   rte_pqueue_create().
+ * @param n
+ *   The number of objects to enqueue from obj_table.
+ * @param prio
+ *   The priority level of the objects, 0 being the highest.
+ * @param free_space
+ *   If non-NULL, returns the amount of space left at the priority level
+ *   after the enqueue operation has finished.
+ * @return
+ *   The number of objects enqueued, between 0 and n.
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_enqueue_burst_elem(struct rte_pqueue *pq, const void *obj_table,
+			      unsigned int esize, unsigned int n,
+			      unsigned int prio, unsigned int *free_space)
+{
+	RTE_ASSERT(esize == pq->esize);
+	RTE_ASSERT(prio < pq->nb_prio);
+
+	return rte_ring_enqueue_burst_elem(pq->levels[prio], obj_table, esize,
+					   n, free_space);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dequeue n objects of the highest priority level holding objects.
+ *
+ * The objects are not mixed with objects of lower priority levels: if the
+ * highest non-empty level holds less than n objects, nothing is dequeued.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @param obj_table
+ *   A pointer to a table of objects that will be filled.
+ * @param esize
+ *   The size of the objects, in bytes. It must be the size given to
+ *   rte_pqueue_create().
+ * @param n
+ *   The number of objects to dequeue.
+ * @param prio
+ *   If non-NULL, returns the priority level of the dequeued objects.
+ * @return
+ *   The number of objects dequeued, either 0 or n.
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_dequeue_bulk_elem(struct rte_pqueue *pq, void *obj_table,
+			     unsigned int esize, unsigned int n,
+			     unsigned int *prio)
+{
+	struct rte_ring *r;
+	unsigned int i, nb;
+
+	RTE_ASSERT(esize == pq->esize);
+
+	for (i = 0; i != pq->nb_prio; i++) {
+		r = pq->levels[i];
+		if (rte_ring_empty(r))
+			continue;
+		nb = rte_ring_dequeue_bulk_elem(r, obj_table, esize, n, NULL);
+		/* Move on only if the level was drained concurrently */
+		if (nb != 0 || !rte_ring_empty(r)) {
+			if (nb != 0 && prio != NULL)
+				*prio = i;
+			return nb;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dequeue up to n objects, highest priority first.
+ *
+ * The priority levels are drained in order until n objects are dequeued
+ * or all levels were visited. obj_table is filled in priority order.
+ *
+ * @param pq
+ *   A pointer to the priority queue structure.
+ * @param obj_table
+ *   A pointer to a table of objects that will be filled.
+ * @param esize
+ *   The size of the objects, in bytes. It must be the size given to
+ *   rte_pqueue_create().
+ * @param n
+ *   The maximum number of objects to dequeue.
+ * @param available
+ *   If non-NULL, returns the number of remaining objects, all levels
+ *   included, after the dequeue has finished.
+ * @return
+ *   The number of objects dequeued, between 0 and n.
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_dequeue_burst_elem(struct rte_pqueue *pq, void *obj_table,
+			      unsigned int esize, unsigned int n,
+			      unsigned int *available)
+{
+	struct rte_ring *r;
+	unsigned int i, nb = 0;
+
+	RTE_ASSERT(esize == pq->esize);
+
+	for (i = 0; i != pq->nb_prio && nb != n; i++) {
+		r = pq->levels[i];
+		if (rte_ring_empty(r))
+			continue;
+		nb += rte_ring_dequeue_burst_elem(r,
+				RTE_PTR_ADD(obj_table, (size_t)nb * esize),
+				esize, n - nb, NULL);
+	}
+
+	if (available != NULL)
+		*available = rte_pqueue_count(pq);
+
+	return nb;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enqueue several pointers at a priority level.
+ *
+ * @see rte_pqueue_enqueue_bulk_elem()
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_enqueue_bulk(struct rte_pqueue *pq, void * const *obj_table,
+			unsigned int n, unsigned int prio,
+			unsigned int *free_space)
+{
+	return rte_pqueue_enqueue_bulk_elem(pq, obj_table, sizeof(void *), n,
+					    prio, free_space);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Enqueue up to n pointers at a priority level.
+ *
+ * @see rte_pqueue_enqueue_burst_elem()
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_enqueue_burst(struct rte_pqueue *pq, void * const *obj_table,
+			 unsigned int n, unsigned int prio,
+			 unsigned int *free_space)
+{
+	return rte_pqueue_enqueue_burst_elem(pq, obj_table, sizeof(void *), n,
+					     prio, free_space);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dequeue n pointers of the highest priority level holding objects.
+ *
+ * @see rte_pqueue_dequeue_bulk_elem()
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_dequeue_bulk(struct rte_pqueue *pq, void **obj_table,
+			unsigned int n, unsigned int *prio)
+{
+	return rte_pqueue_dequeue_bulk_elem(pq, obj_table, sizeof(void *), n,
+					    prio);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Dequeue up to n pointers, highest priority first.
+ *
+ * @see rte_pqueue_dequeue_burst_elem()
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pqueue_dequeue_burst(struct rte_pqueue *pq, void **obj_table,
+			 unsigned int n, unsigned int *available)
+{
+	return rte_pqueue_dequeue_burst_elem(pq, obj_table, sizeof(void *), n,
+					     available);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_PQUEUE_H_ */
@@ -6,9 +6,12 @@
 #define RIB6_INTERNAL_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <rte_compat.h>
 
+struct rte_ipv6_addr;
+struct rte_rib6;
 struct rte_rib6_node;
 
 __rte_internal
@@ -19,4 +22,18 @@ __rte_internal
 struct rte_rib6_node *
 rte_rib6_get_parent(const struct rte_rib6_node *node);
 
+__rte_internal
+bool
+rte_rib6_node_is_valid(const struct rte_rib6_node *node);
+
+__rte_internal
+struct rte_rib6_node *
+rte_rib6_get_child(const struct rte_rib6_node *node, bool right);
+
+/* Topmost node, valid or not, of the subtree covered by ip/depth. */
+__rte_internal
+struct rte_rib6_node *
+rte_rib6_get_subtree(struct rte_rib6 *rib, const struct rte_ipv6_addr *ip,
+	uint8_t depth);
+
 #endif /* RIB6_INTERNAL_H */
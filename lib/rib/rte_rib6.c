@@ -439,6 +439,34 @@ rte_rib6_get_parent(const struct rte_rib6_node *node)
 	return node->parent;
 }
 
+RTE_EXPORT_INTERNAL_SYMBOL(rte_rib6_node_is_valid)
+bool
+rte_rib6_node_is_valid(const struct rte_rib6_node *node)
+{
+	return is_valid_node(node);
+}
+
+RTE_EXPORT_INTERNAL_SYMBOL(rte_rib6_get_child)
+struct rte_rib6_node *
+rte_rib6_get_child(const struct rte_rib6_node *node, bool right)
+{
+	return right ? node->right : node->left;
+}
+
+RTE_EXPORT_INTERNAL_SYMBOL(rte_rib6_get_subtree)
+struct rte_rib6_node *
+rte_rib6_get_subtree(struct rte_rib6 *rib, const struct rte_ipv6_addr *ip,
+	uint8_t depth)
+{
+	struct rte_rib6_node *tmp = rib->tree;
+
+	while ((tmp != NULL) && (tmp->depth < depth))
+		tmp = get_nxt_node(tmp, ip);
+	if ((tmp == NULL) || !rte_ipv6_addr_eq_prefix(&tmp->ip, ip, depth))
+		return NULL;
+	return tmp;
+}
+
 RTE_EXPORT_SYMBOL(rte_rib6_get_ext)
 void *
 rte_rib6_get_ext(struct rte_rib6_node *node)
@@ -0,0 +1,297 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_RING_PTR_COMPRESS_H_
+#define _RTE_RING_PTR_COMPRESS_H_
+
+/**
+ * @file
+ * RTE Ring of compressed pointers
+ *
+ * These functions enqueue and dequeue pointers to objects on a ring
+ * storing them as 32-bit offsets from a base address,
+ * see rte_ptr_compress_32_shift().
+ * Passing objects of a mempool between lcores this way halves the ring
+ * memory touched per object, compared to a ring of pointers.
+ *
+ * The ring must be created with rte_ring_create_elem() and an element size
+ * of sizeof(uint32_t). Any sync type can be used.
+ * The producers and the consumers of the ring must use the same base
+ * and shift, which can be computed for a mempool
+ * with rte_mempool_get_mem_range() and rte_mempool_get_obj_alignment().
+ * The offsets are computed while copying the objects in the ring storage,
+ * so there is no extra copy compared to a regular enqueue or dequeue.
+ */
+
+#include <rte_ptr_compress.h>
+#include <rte_ring.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @internal Compress objects in the ring storage, starting at head.
+ */
+static __rte_always_inline void
+__rte_ring_ptr_compress_elems(struct rte_ring *r, uint32_t head,
+	void * const *obj_table, uint32_t n, void *base, uint8_t shift)
+{
+	void *ptr1, *ptr2;
+	uint32_t n1;
+
+	__rte_ring_get_elem_addr(r, head, sizeof(uint32_t), n, &ptr1, &n1,
+		&ptr2);
+	rte_ptr_compress_32_shift(base, obj_table, (uint32_t *)ptr1, n1,
+		shift);
+	if (unlikely(ptr2 != NULL))
+		rte_ptr_compress_32_shift(base, obj_table + n1,
+			(uint32_t *)ptr2, n - n1, shift);
+}
+
+/**
+ * @internal Decompress objects from the ring storage, starting at head.
+ */
+static __rte_always_inline void
+__rte_ring_ptr_decompress_elems(struct rte_ring *r, uint32_t head,
+	void **obj_table, uint32_t n, void *base, uint8_t shift)
+{
+	void *ptr1, *ptr2;
+	uint32_t n1;
+
+	__rte_ring_get_elem_addr(r, head, sizeof(uint32_t), n, &ptr1, &n1,
+		&ptr2);
+	rte_ptr_decompress_32_shift(base, (const uint32_t *)ptr1, obj_table,
+		n1, shift);
+	if (unlikely(ptr2 != NULL))
+		rte_ptr_decompress_32_shift(base, (const uint32_t *)ptr2,
+			obj_table + n1, n - n1, shift);
+}
+
+/**
+ * @internal Enqueue compressed pointers, for any producer sync type.
+ */
+static __rte_always_inline unsigned int
+__rte_ring_do_enqueue_ptr_compress(struct rte_ring *r, void * const *obj_table,
+	unsigned int n, void *base, uint8_t shift,
+	enum rte_ring_queue_behavior behavior, unsigned int *free_space)
+{
+	uint32_t head, next, free;
+	unsigned int is_sp;
+
+	switch (r->prod.sync_type) {
+	case RTE_RING_SYNC_MT:
+	case RTE_RING_SYNC_ST:
+		is_sp = r->prod.sync_type == RTE_RING_SYNC_ST;
+		n = __rte_ring_move_prod_head(r, is_sp, n, behavior, &head,
+			&next, &free);
+		if (n != 0) {
+			__rte_ring_ptr_compress_elems(r, head, obj_table, n,
+				base, shift);
+			__rte_ring_update_tail(&r->prod, head, next, is_sp);
+		}
+		break;
+	case RTE_RING_SYNC_MT_RTS:
+		n = __rte_ring_rts_move_prod_head(r, n, behavior, &head, &free);
+		if (n != 0) {
+			__rte_ring_ptr_compress_elems(r, head, obj_table, n,
+				base, shift);
+			__rte_ring_rts_update_tail(&r->rts_prod);
+		}
+		break;
+	case RTE_RING_SYNC_MT_HTS:
+		n = __rte_ring_hts_move_prod_head(r, n, behavior, &head, &free);
+		if (n != 0) {
+			__rte_ring_ptr_compress_elems(r, head, obj_table, n,
+				base, shift);
+			__rte_ring_hts_update_tail(&r->hts_prod, head, n);
+		}
+		break;
+	default:
+		/* valid ring should never reach this point */
+		RTE_ASSERT(0);
+		n = 0;
+		free = 0;
+		break;
+	}
+
+	if (free_space != NULL)
+		*free_space = free - n;
+	return n;
+}
+
+/**
+ * @internal Dequeue compressed pointers, for any consumer sync type.
+ */
+static __rte_always_inline unsigned int
+__rte_ring_do_dequeue_ptr_compress(struct rte_ring *r, void **obj_table,
+	unsigned int n, void *base, uint8_t shift,
+	enum rte_ring_queue_behavior behavior, unsigned int *available)
+{
+	uint32_t head, next, entries;
+	unsigned int is_sc;
+
+	switch (r->cons.sync_type) {
+	case RTE_RING_SYNC_MT:
+	case RTE_RING_SYNC_ST:
+		is_sc = r->cons.sync_type == RTE_RING_SYNC_ST;
+		n = __rte_ring_move_cons_head(r, is_sc, n, behavior, &head,
+			&next, &entries);
+		if (n != 0) {
+			__rte_ring_ptr_decompress_elems(r, head, obj_table, n,
+				base, shift);
+			__rte_ring_update_tail(&r->cons, head, next, is_sc);
+		}
+		break;
+	case RTE_RING_SYNC_MT_RTS:
+		n = __rte_ring_rts_move_cons_head(r, n, behavior, &head,
+			&entries);
+		if (n != 0) {
+			__rte_ring_ptr_decompress_elems(r, head, obj_table, n,
+				base, shift);
+			__rte_ring_rts_update_tail(&r->rts_cons);
+		}
+		break;
+	case RTE_RING_SYNC_MT_HTS:
+		n = __rte_ring_hts_move_cons_head(r, n, behavior, &head,
+			&entries);
+		if (n != 0) {
+			__rte_ring_ptr_decompress_elems(r, head, obj_table, n,
+				base, shift);
+			__rte_ring_hts_update_tail(&r->hts_cons, head, n);
+		}
+		break;
+	default:
+		/* valid ring should never reach this point */
+		RTE_ASSERT(0);
+		n = 0;
+		entries = 0;
+		break;
+	}
+
+	if (available != NULL)
+		*available = entries - n;
+	return n;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue several pointers on a ring of compressed pointers.
+ *
+ * This function calls the multi-producer or the single-producer
+ * version depending on the default behavior that was specified at
+ * ring creation time (see flags).
+ *
+ * @param r
+ *   A pointer to a ring created with an element size of sizeof(uint32_t).
+ * @param obj_table
+ *   A pointer to a table of pointers to objects.
+ *   Each object must be located at most (UINT32_MAX << shift) bytes after
+ *   base, and aligned on (1 << shift) bytes.
+ * @param n
+ *   The number of objects to add in the ring from the obj_table.
+ * @param base
+ *   The base address the pointers are compressed against.
+ * @param shift
+ *   The number of least significant bits dropped from the offsets.
+ * @param free_space
+ *   If non-NULL, returns the amount of space in the ring after the
+ *   enqueue operation has finished.
+ * @return
+ *   The number of objects enqueued, either 0 or n
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_ring_enqueue_bulk_ptr_compress(struct rte_ring *r, void * const *obj_table,
+	unsigned int n, void *base, uint8_t shift, unsigned int *free_space)
+{
+	return __rte_ring_do_enqueue_ptr_compress(r, obj_table, n, base, shift,
+		RTE_RING_QUEUE_FIXED, free_space);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue several pointers on a ring of compressed pointers,
+ * as many as possible.
+ *
+ * @see rte_ring_enqueue_bulk_ptr_compress()
+ *
+ * @return
+ *   - n: Actual number of objects enqueued.
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_ring_enqueue_burst_ptr_compress(struct rte_ring *r,
+	void * const *obj_table, unsigned int n, void *base, uint8_t shift,
+	unsigned int *free_space)
+{
+	return __rte_ring_do_enqueue_ptr_compress(r, obj_table, n, base, shift,
+		RTE_RING_QUEUE_VARIABLE, free_space);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dequeue several pointers from a ring of compressed pointers.
+ *
+ * This function calls the multi-consumer or the single-consumer
+ * version depending on the default behavior that was specified at
+ * ring creation time (see flags).
+ *
+ * @param r
+ *   A pointer to a ring created with an element size of sizeof(uint32_t).
+ * @param obj_table
+ *   A pointer to a table of pointers that will be filled.
+ * @param n
+ *   The number of objects to dequeue from the ring to the obj_table.
+ * @param base
+ *   The base address used by the producer to compress the pointers.
+ * @param shift
+ *   The shift used by the producer to compress the pointers.
+ * @param available
+ *   If non-NULL, returns the number of remaining ring entries after the
+ *   dequeue has finished.
+ * @return
+ *   The number of objects dequeued, either 0 or n
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_ring_dequeue_bulk_ptr_compress(struct rte_ring *r, void **obj_table,
+	unsigned int n, void *base, uint8_t shift, unsigned int *available)
+{
+	return __rte_ring_do_dequeue_ptr_compress(r, obj_table, n, base, shift,
+		RTE_RING_QUEUE_FIXED, available);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dequeue several pointers from a ring of compressed pointers,
+ * as many as available.
+ *
+ * @see rte_ring_dequeue_bulk_ptr_compress()
+ *
+ * @return
+ *   - n: Actual number of objects dequeued, 0 if ring is empty
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_ring_dequeue_burst_ptr_compress(struct rte_ring *r, void **obj_table,
+	unsigned int n, void *base, uint8_t shift, unsigned int *available)
+{
+	return __rte_ring_do_dequeue_ptr_compress(r, obj_table, n, base, shift,
+		RTE_RING_QUEUE_VARIABLE, available);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_RING_PTR_COMPRESS_H_ */
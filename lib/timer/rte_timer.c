@@ -19,9 +19,34 @@
 #include <rte_random.h>
 #include <rte_pause.h>
 #include <rte_memzone.h>
+#include <rte_malloc.h>
 
 #include "rte_timer.h"
 
+#define TIMER_WHEEL_BITS	8
+#define TIMER_WHEEL_SLOTS	(1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK	(TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS	5
+/** wheel tick rate, rounded down to a power of two of the timer cycles */
+#define TIMER_WHEEL_TICK_HZ	1000000
+
+/**
+ * Hierarchical timing wheel of an lcore.
+ *
+ * Level l holds the timers expiring between 2^(8 * l) and 2^(8 * (l + 1))
+ * ticks from now, and is cascaded to the lower levels each time the lower
+ * levels wrap. The timers are linked in their slot with the skiplist links
+ * of struct rte_timer: sl_next[0] is the next timer, sl_next[1] the
+ * address of the pointer to the timer and sl_next[2] the slot position.
+ */
+struct timer_wheel {
+	uint64_t now;        /**< next tick to process */
+	uint64_t nb_pending; /**< number of timers in the wheel */
+	unsigned int shift;  /**< log2 of the timer cycles per tick */
+	uint64_t bitmap[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS / 64];
+	struct rte_timer *slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+};
+
 /**
  * Per-lcore info for timers.
  */
@@ -41,6 +66,9 @@ struct __rte_cache_aligned priv_timer {
 	/** running timer on this lcore now */
 	struct rte_timer *running_tim;
 
+	/** timing wheel replacing the skiplist, NULL if not used */
+	struct timer_wheel *wheel;
+
 #ifdef RTE_LIBRTE_TIMER_DEBUG
 	/** per-lcore statistics */
 	struct rte_timer_debug_stats stats;
@@ -110,6 +138,72 @@ rte_timer_data_alloc(uint32_t *id_ptr)
 	return -ENOSPC;
 }
 
+static void
+timer_data_wheels_free(struct rte_timer_data *data)
+{
+	unsigned int lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		rte_free(data->priv_timer[lcore_id].wheel);
+		data->priv_timer[lcore_id].wheel = NULL;
+	}
+}
+
+static int
+timer_data_wheels_alloc(struct rte_timer_data *data)
+{
+	struct timer_wheel *wheel;
+	unsigned int lcore_id;
+	unsigned int shift;
+	uint64_t hz;
+
+	hz = rte_get_timer_hz() / TIMER_WHEEL_TICK_HZ;
+	shift = hz > 1 ? rte_fls_u64(hz) - 1 : 0;
+
+	/* timers can only expire on the lcores calling the manage function */
+	RTE_LCORE_FOREACH(lcore_id) {
+		wheel = rte_zmalloc_socket("timer_wheel", sizeof(*wheel),
+				RTE_CACHE_LINE_SIZE, rte_lcore_to_socket_id(lcore_id));
+		if (wheel == NULL) {
+			timer_data_wheels_free(data);
+			return -ENOMEM;
+		}
+		wheel->shift = shift;
+		wheel->now = rte_get_timer_cycles() >> shift;
+		data->priv_timer[lcore_id].wheel = wheel;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_data_alloc_type, 26.11)
+int
+rte_timer_data_alloc_type(uint32_t *id_ptr, enum rte_timer_data_type type)
+{
+	uint32_t id;
+	int ret;
+
+	if (type != RTE_TIMER_DATA_SKIPLIST && type != RTE_TIMER_DATA_WHEEL)
+		return -EINVAL;
+
+	ret = rte_timer_data_alloc(&id);
+	if (ret < 0)
+		return ret;
+
+	if (type == RTE_TIMER_DATA_WHEEL) {
+		ret = timer_data_wheels_alloc(&rte_timer_data_arr[id]);
+		if (ret < 0) {
+			rte_timer_data_arr[id].internal_flags &= ~(FL_ALLOCATED);
+			return ret;
+		}
+	}
+
+	if (id_ptr)
+		*id_ptr = id;
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_timer_data_dealloc)
 int
 rte_timer_data_dealloc(uint32_t id)
@@ -117,6 +211,7 @@ rte_timer_data_dealloc(uint32_t id)
 	struct rte_timer_data *timer_data;
 	TIMER_DATA_VALID_GET_OR_ERR_RET(id, timer_data, -EINVAL);
 
+	timer_data_wheels_free(timer_data);
 	timer_data->internal_flags &= ~(FL_ALLOCATED);
 
 	return 0;
@@ -192,6 +287,8 @@ RTE_EXPORT_SYMBOL(rte_timer_subsystem_finalize)
 void
 rte_timer_subsystem_finalize(void)
 {
+	int i;
+
 	rte_mcfg_timer_lock();
 
 	if (!rte_timer_subsystem_initialized) {
@@ -199,8 +296,11 @@ rte_timer_subsystem_finalize(void)
 		return;
 	}
 
-	if (--(*rte_timer_mz_refcnt) == 0)
+	if (--(*rte_timer_mz_refcnt) == 0) {
+		for (i = 0; i < RTE_MAX_DATA_ELS; i++)
+			timer_data_wheels_free(&rte_timer_data_arr[i]);
 		rte_memzone_free(rte_timer_data_mz);
+	}
 
 	rte_timer_subsystem_initialized = 0;
 
@@ -388,6 +488,178 @@ timer_get_prev_entries_for_node(struct rte_timer *tim, unsigned tim_lcore,
 	}
 }
 
+static inline struct rte_timer **
+timer_wheel_pprev(const struct rte_timer *tim)
+{
+	return (struct rte_timer **)(uintptr_t)tim->sl_next[1];
+}
+
+static inline void
+timer_wheel_pprev_set(struct rte_timer *tim, struct rte_timer **pprev)
+{
+	tim->sl_next[1] = (struct rte_timer *)(uintptr_t)pprev;
+}
+
+/* add a timer in the wheel slot of its expiry tick, in O(1) */
+static void
+timer_wheel_add(struct timer_wheel *wheel, struct rte_timer *tim)
+{
+	const uint64_t max_delta = (UINT64_C(1) << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+	struct rte_timer **head;
+	unsigned int lvl, idx;
+	uint64_t tick, delta;
+
+	/* never expire before the expiry time */
+	tick = (tim->expire >> wheel->shift) +
+		((tim->expire & ((UINT64_C(1) << wheel->shift) - 1)) != 0);
+	if (tick < wheel->now)
+		tick = wheel->now;
+
+	/* timers beyond the wheel range are placed again when cascaded */
+	delta = tick - wheel->now;
+	if (delta > max_delta) {
+		delta = max_delta;
+		tick = wheel->now + max_delta;
+	}
+
+	for (lvl = 0; lvl < TIMER_WHEEL_LEVELS - 1; lvl++)
+		if (delta < (UINT64_C(1) << (TIMER_WHEEL_BITS * (lvl + 1))))
+			break;
+	idx = (tick >> (TIMER_WHEEL_BITS * lvl)) & TIMER_WHEEL_MASK;
+
+	head = &wheel->slot[lvl][idx];
+	tim->sl_next[0] = *head;
+	if (*head != NULL)
+		timer_wheel_pprev_set(*head, &tim->sl_next[0]);
+	*head = tim;
+	timer_wheel_pprev_set(tim, head);
+	tim->sl_next[2] = (struct rte_timer *)(uintptr_t)(lvl * TIMER_WHEEL_SLOTS + idx);
+
+	wheel->bitmap[lvl][idx / 64] |= UINT64_C(1) << (idx % 64);
+	wheel->nb_pending++;
+}
+
+/* remove a timer from its wheel slot, in O(1) */
+static void
+timer_wheel_del(struct timer_wheel *wheel, struct rte_timer *tim)
+{
+	struct rte_timer **pprev = timer_wheel_pprev(tim);
+	struct rte_timer *next = tim->sl_next[0];
+	unsigned int lvl, idx;
+	uintptr_t pos;
+
+	/* already detached by the manage function */
+	if (pprev == NULL)
+		return;
+
+	*pprev = next;
+	if (next != NULL)
+		timer_wheel_pprev_set(next, pprev);
+	timer_wheel_pprev_set(tim, NULL);
+
+	pos = (uintptr_t)tim->sl_next[2];
+	lvl = pos / TIMER_WHEEL_SLOTS;
+	idx = pos % TIMER_WHEEL_SLOTS;
+	if (wheel->slot[lvl][idx] == NULL)
+		wheel->bitmap[lvl][idx / 64] &= ~(UINT64_C(1) << (idx % 64));
+	wheel->nb_pending--;
+}
+
+/* detach the timers of a slot */
+static struct rte_timer *
+timer_wheel_slot_take(struct timer_wheel *wheel, unsigned int lvl,
+		      unsigned int idx)
+{
+	struct rte_timer *first = wheel->slot[lvl][idx];
+
+	wheel->slot[lvl][idx] = NULL;
+	wheel->bitmap[lvl][idx / 64] &= ~(UINT64_C(1) << (idx % 64));
+
+	return first;
+}
+
+/* move the timers of the upper levels reached by the current tick */
+static void
+timer_wheel_cascade(struct timer_wheel *wheel)
+{
+	struct rte_timer *tim, *next_tim;
+	unsigned int lvl, idx;
+
+	for (lvl = 1; lvl < TIMER_WHEEL_LEVELS; lvl++) {
+		idx = (wheel->now >> (TIMER_WHEEL_BITS * lvl)) & TIMER_WHEEL_MASK;
+		for (tim = timer_wheel_slot_take(wheel, lvl, idx); tim != NULL;
+		     tim = next_tim) {
+			next_tim = tim->sl_next[0];
+			wheel->nb_pending--;
+			timer_wheel_add(wheel, tim);
+		}
+		/* upper level is reached only when this one wraps */
+		if (idx != 0)
+			break;
+	}
+}
+
+/* index of the first non-empty slot of level 0 from idx, or the slot count */
+static unsigned int
+timer_wheel_next_slot(const struct timer_wheel *wheel, unsigned int idx)
+{
+	unsigned int i = idx / 64;
+	uint64_t bits;
+
+	bits = wheel->bitmap[0][i] & (UINT64_MAX << (idx % 64));
+	while (bits == 0) {
+		if (++i == TIMER_WHEEL_SLOTS / 64)
+			return TIMER_WHEEL_SLOTS;
+		bits = wheel->bitmap[0][i];
+	}
+
+	return i * 64 + rte_ctz64(bits);
+}
+
+/*
+ * Detach all the timers expired at the given time, in a list linked
+ * with sl_next[0], in expiry tick order. Empty slots are skipped up to
+ * the next cascade, using the occupancy bitmap.
+ */
+static struct rte_timer *
+timer_wheel_expire(struct timer_wheel *wheel, uint64_t cur_time)
+{
+	const uint64_t cur_tick = cur_time >> wheel->shift;
+	struct rte_timer *run_first_tim = NULL;
+	struct rte_timer **pprev = &run_first_tim;
+	struct rte_timer *tim;
+	unsigned int idx, next;
+
+	while (wheel->now <= cur_tick) {
+		if (wheel->nb_pending == 0) {
+			wheel->now = cur_tick + 1;
+			break;
+		}
+
+		idx = wheel->now & TIMER_WHEEL_MASK;
+		if (idx == 0)
+			timer_wheel_cascade(wheel);
+
+		next = timer_wheel_next_slot(wheel, idx);
+		if (next != idx) {
+			wheel->now = RTE_MIN((wheel->now & ~(uint64_t)TIMER_WHEEL_MASK) + next,
+					     cur_tick + 1);
+			continue;
+		}
+
+		/* append the whole slot to the run list */
+		*pprev = timer_wheel_slot_take(wheel, 0, idx);
+		for (tim = *pprev; tim != NULL; tim = tim->sl_next[0]) {
+			timer_wheel_pprev_set(tim, NULL);
+			wheel->nb_pending--;
+			pprev = &tim->sl_next[0];
+		}
+		wheel->now++;
+	}
+
+	return run_first_tim;
+}
+
 /* call with lock held as necessary
  * add in list
  * timer must be in config state
@@ -400,6 +672,11 @@ timer_add(struct rte_timer *tim, unsigned int tim_lcore,
 	unsigned lvl;
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
 
+	if (priv_timer[tim_lcore].wheel != NULL) {
+		timer_wheel_add(priv_timer[tim_lcore].wheel, tim);
+		return;
+	}
+
 	/* find where exactly this element goes in the list of elements
 	 * for each depth. */
 	timer_get_prev_entries(tim->expire, tim_lcore, prev, priv_timer);
@@ -426,24 +703,22 @@ timer_add(struct rte_timer *tim, unsigned int tim_lcore,
 }
 
 /*
- * del from list, lock if needed
+ * del from the list of prev_owner
+ * list of prev_owner must be locked
  * timer must be in config state
  * timer must be in a list
  */
 static void
-timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
-	  int local_is_locked, struct priv_timer *priv_timer)
+timer_list_del(struct rte_timer *tim, unsigned int prev_owner,
+	       struct priv_timer *priv_timer)
 {
-	unsigned lcore_id = rte_lcore_id();
-	unsigned prev_owner = prev_status.owner;
 	int i;
 	struct rte_timer *prev[MAX_SKIPLIST_DEPTH+1];
 
-	/* if timer needs is pending another core, we need to lock the
-	 * list; if it is on local core, we need to lock if we are not
-	 * called from rte_timer_manage() */
-	if (prev_owner != lcore_id || !local_is_locked)
-		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
+	if (priv_timer[prev_owner].wheel != NULL) {
+		timer_wheel_del(priv_timer[prev_owner].wheel, tim);
+		return;
+	}
 
 	/* save the lowest list entry into the expire field of the dummy hdr.
 	 * NOTE: this is not atomic on 32-bit */
@@ -464,11 +739,55 @@ timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
 			priv_timer[prev_owner].curr_skiplist_depth --;
 		else
 			break;
+}
+
+/*
+ * del from list, lock if needed
+ * timer must be in config state
+ * timer must be in a list
+ */
+static void
+timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
+	  int local_is_locked, struct priv_timer *priv_timer)
+{
+	unsigned lcore_id = rte_lcore_id();
+	unsigned prev_owner = prev_status.owner;
+
+	/* if timer needs is pending another core, we need to lock the
+	 * list; if it is on local core, we need to lock if we are not
+	 * called from rte_timer_manage() */
+	if (prev_owner != lcore_id || !local_is_locked)
+		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
+
+	timer_list_del(tim, prev_owner, priv_timer);
 
 	if (prev_owner != lcore_id || !local_is_locked)
 		rte_spinlock_unlock(&priv_timer[prev_owner].list_lock);
 }
 
+/* round robin for tim_lcore */
+static unsigned int
+timer_lcore_select(unsigned int tim_lcore, struct priv_timer *priv_timer)
+{
+	unsigned int lcore_id = rte_lcore_id();
+
+	if (tim_lcore != (unsigned int)LCORE_ID_ANY)
+		return tim_lcore;
+
+	if (lcore_id < RTE_MAX_LCORE) {
+		/* EAL thread with valid lcore_id */
+		tim_lcore = rte_get_next_lcore(
+			priv_timer[lcore_id].prev_lcore,
+			0, 1);
+		priv_timer[lcore_id].prev_lcore = tim_lcore;
+	} else
+		/* non-EAL thread do not run rte_timer_manage(),
+		 * so schedule the timer on the first enabled lcore. */
+		tim_lcore = rte_get_next_lcore(LCORE_ID_ANY, 0, 1);
+
+	return tim_lcore;
+}
+
 /* Reset and start the timer associated with the timer handle (private func) */
 static int
 __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
@@ -482,19 +801,7 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 	unsigned lcore_id = rte_lcore_id();
 	struct priv_timer *priv_timer = timer_data->priv_timer;
 
-	/* round robin for tim_lcore */
-	if (tim_lcore == (unsigned)LCORE_ID_ANY) {
-		if (lcore_id < RTE_MAX_LCORE) {
-			/* EAL thread with valid lcore_id */
-			tim_lcore = rte_get_next_lcore(
-				priv_timer[lcore_id].prev_lcore,
-				0, 1);
-			priv_timer[lcore_id].prev_lcore = tim_lcore;
-		} else
-			/* non-EAL thread do not run rte_timer_manage(),
-			 * so schedule the timer on the first enabled lcore. */
-			tim_lcore = rte_get_next_lcore(LCORE_ID_ANY, 0, 1);
-	}
+	tim_lcore = timer_lcore_select(tim_lcore, priv_timer);
 
 	/* wait that the timer is in correct status before update,
 	 * and mark it as being configured */
@@ -576,6 +883,67 @@ rte_timer_alt_reset(uint32_t timer_data_id, struct rte_timer *tim,
 				 fct, arg, 0, timer_data);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_alt_reset_burst, 26.11)
+int
+rte_timer_alt_reset_burst(uint32_t timer_data_id, struct rte_timer **tims,
+			  const uint64_t *ticks, unsigned int nb_tims,
+			  enum rte_timer_type type, unsigned int tim_lcore,
+			  rte_timer_cb_t fct, void **args)
+{
+	uint64_t cur_time = rte_get_timer_cycles();
+	union rte_timer_status prev_status, status;
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_timer_data *timer_data;
+	struct priv_timer *priv_timer;
+	struct rte_timer *tim;
+	unsigned int i, n;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+	priv_timer = timer_data->priv_timer;
+
+	tim_lcore = timer_lcore_select(tim_lcore, priv_timer);
+
+	/* remove the timers from their lists before locking the destination */
+	for (n = 0; n < nb_tims; n++) {
+		tim = tims[n];
+		if (timer_set_config_state(tim, &prev_status, priv_timer) < 0)
+			break;
+
+		__TIMER_STAT_ADD(priv_timer, reset, 1);
+		if (prev_status.state == RTE_TIMER_RUNNING &&
+		    lcore_id < RTE_MAX_LCORE)
+			priv_timer[lcore_id].updated = 1;
+
+		if (prev_status.state == RTE_TIMER_PENDING) {
+			timer_del(tim, prev_status, 0, priv_timer);
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+		}
+
+		tim->period = type == PERIODICAL ? ticks[n] : 0;
+		tim->expire = cur_time + ticks[n];
+		tim->f = fct;
+		tim->arg = args != NULL ? args[n] : NULL;
+	}
+
+	status.state = RTE_TIMER_PENDING;
+	status.owner = (int16_t)tim_lcore;
+
+	/* insert the whole burst with a single lock of the destination list */
+	rte_spinlock_lock(&priv_timer[tim_lcore].list_lock);
+	for (i = 0; i < n; i++) {
+		__TIMER_STAT_ADD(priv_timer, pending, 1);
+		timer_add(tims[i], tim_lcore, priv_timer);
+		/* The "RELEASE" ordering guarantees the memory operations above
+		 * the status update are observed before the update by all threads
+		 */
+		rte_atomic_store_explicit(&tims[i]->status.u32, status.u32,
+					  rte_memory_order_release);
+	}
+	rte_spinlock_unlock(&priv_timer[tim_lcore].list_lock);
+
+	return n;
+}
+
 /* loop until rte_timer_reset() succeed */
 RTE_EXPORT_SYMBOL(rte_timer_reset_sync)
 void
@@ -645,6 +1013,60 @@ rte_timer_alt_stop(uint32_t timer_data_id, struct rte_timer *tim)
 	return __rte_timer_stop(tim, timer_data);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_alt_stop_burst, 26.11)
+int
+rte_timer_alt_stop_burst(uint32_t timer_data_id, struct rte_timer **tims,
+			 unsigned int nb_tims)
+{
+	union rte_timer_status prev_status, status;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int locked = RTE_MAX_LCORE;
+	struct rte_timer_data *timer_data;
+	struct priv_timer *priv_timer;
+	struct rte_timer *tim;
+	unsigned int n;
+
+	TIMER_DATA_VALID_GET_OR_ERR_RET(timer_data_id, timer_data, -EINVAL);
+	priv_timer = timer_data->priv_timer;
+
+	status.state = RTE_TIMER_STOP;
+	status.owner = RTE_TIMER_NO_OWNER;
+
+	for (n = 0; n < nb_tims; n++) {
+		tim = tims[n];
+		if (timer_set_config_state(tim, &prev_status, priv_timer) < 0)
+			break;
+
+		__TIMER_STAT_ADD(priv_timer, stop, 1);
+		if (prev_status.state == RTE_TIMER_RUNNING &&
+		    lcore_id < RTE_MAX_LCORE)
+			priv_timer[lcore_id].updated = 1;
+
+		/* keep the list locked while the next timers are on it */
+		if (prev_status.state == RTE_TIMER_PENDING) {
+			if ((unsigned int)prev_status.owner != locked) {
+				if (locked != RTE_MAX_LCORE)
+					rte_spinlock_unlock(&priv_timer[locked].list_lock);
+				locked = prev_status.owner;
+				rte_spinlock_lock(&priv_timer[locked].list_lock);
+			}
+			timer_list_del(tim, locked, priv_timer);
+			__TIMER_STAT_ADD(priv_timer, pending, -1);
+		}
+
+		/* The "RELEASE" ordering guarantees the memory operations above
+		 * the status update are observed before the update by all threads
+		 */
+		rte_atomic_store_explicit(&tim->status.u32, status.u32,
+					  rte_memory_order_release);
+	}
+
+	if (locked != RTE_MAX_LCORE)
+		rte_spinlock_unlock(&priv_timer[locked].list_lock);
+
+	return n;
+}
+
 /* loop until rte_timer_stop() succeed */
 RTE_EXPORT_SYMBOL(rte_timer_stop_sync)
 void
@@ -839,6 +1261,21 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 		poll_lcore = poll_lcores[i];
 		privp = &data->priv_timer[poll_lcore];
 
+		if (privp->wheel != NULL) {
+			/* the wheel hands over the expired slots in a batch */
+			if (privp->wheel->nb_pending == 0)
+				continue;
+			cur_time = rte_get_timer_cycles();
+
+			rte_spinlock_lock(&privp->list_lock);
+			tim = timer_wheel_expire(privp->wheel, cur_time);
+			if (tim == NULL) {
+				rte_spinlock_unlock(&privp->list_lock);
+				continue;
+			}
+			goto run_list;
+		}
+
 		/* optimize for the case where per-cpu list is empty */
 		if (privp->pending_head.sl_next[0] == NULL)
 			continue;
@@ -880,6 +1317,7 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 			prev[j]->sl_next[j] = NULL;
 		}
 
+run_list:
 		/* transition run-list from PENDING to RUNNING */
 		run_first_tims[nb_runlists] = tim;
 		pprev = &run_first_tims[nb_runlists];
@@ -900,9 +1338,10 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 		}
 
 		/* update the next to expire timer value */
-		privp->pending_head.expire =
-		    (privp->pending_head.sl_next[0] == NULL) ? 0 :
-			privp->pending_head.sl_next[0]->expire;
+		if (privp->wheel == NULL)
+			privp->pending_head.expire =
+			    (privp->pending_head.sl_next[0] == NULL) ? 0 :
+				privp->pending_head.sl_next[0]->expire;
 
 		rte_spinlock_unlock(&privp->list_lock);
 	}
@@ -984,6 +1423,29 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 	return 0;
 }
 
+static void
+timer_wheel_stop_all(struct timer_wheel *wheel,
+		     struct rte_timer_data *timer_data,
+		     rte_timer_stop_all_cb_t f, void *f_arg)
+{
+	struct rte_timer *tim, *next_tim;
+	unsigned int lvl, idx;
+
+	for (lvl = 0; lvl < TIMER_WHEEL_LEVELS; lvl++) {
+		for (idx = 0; idx < TIMER_WHEEL_SLOTS; idx++) {
+			for (tim = wheel->slot[lvl][idx]; tim != NULL;
+			     tim = next_tim) {
+				next_tim = tim->sl_next[0];
+
+				__rte_timer_stop(tim, timer_data);
+
+				if (f)
+					f(tim, f_arg);
+			}
+		}
+	}
+}
+
 /* Walk pending lists, stopping timers and calling user-specified function */
 RTE_EXPORT_SYMBOL(rte_timer_stop_all)
 int
@@ -1003,6 +1465,12 @@ rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
 		walk_lcore = walk_lcores[i];
 		priv_timer = &timer_data->priv_timer[walk_lcore];
 
+		if (priv_timer->wheel != NULL) {
+			timer_wheel_stop_all(priv_timer->wheel, timer_data,
+					     f, f_arg);
+			continue;
+		}
+
 		for (tim = priv_timer->pending_head.sl_next[0];
 		     tim != NULL;
 		     tim = next_tim) {
@@ -38,6 +38,7 @@
 #include <stdint.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_spinlock.h>
 
 #ifdef __cplusplus
@@ -144,6 +145,46 @@ struct rte_timer
  */
 int rte_timer_data_alloc(uint32_t *id_ptr);
 
+/**
+ * Backends of the pending timer lists of a timer data instance.
+ */
+enum rte_timer_data_type {
+	/** Ordered skiplist per lcore, O(log n) arm and cancel. */
+	RTE_TIMER_DATA_SKIPLIST,
+	/**
+	 * Hierarchical timing wheel per lcore, O(1) arm and cancel.
+	 * Expiry is rounded up to a tick of about a microsecond and the timers
+	 * expiring in the same tick run in no particular order.
+	 */
+	RTE_TIMER_DATA_WHEEL,
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate a timer data instance using the given backend for its pending
+ * timer lists.
+ *
+ * The timing wheel is allocated for the enabled lcores, the other lcores
+ * of the instance keep using the skiplist. Instances using the timing wheel
+ * are managed with rte_timer_alt_manage().
+ *
+ * @param id_ptr
+ *   Pointer to variable into which to write the identifier of the allocated
+ *   timer data instance.
+ * @param type
+ *   Backend of the pending timer lists.
+ *
+ * @return
+ *   - 0: Success
+ *   - -EINVAL: invalid backend type
+ *   - -ENOSPC: maximum number of timer data instances already allocated
+ *   - -ENOMEM: unable to allocate the timing wheels
+ */
+__rte_experimental
+int rte_timer_data_alloc_type(uint32_t *id_ptr, enum rte_timer_data_type type);
+
 /**
  * Deallocate a timer data instance.
  *
@@ -410,6 +451,47 @@ rte_timer_alt_reset(uint32_t timer_data_id, struct rte_timer *tim,
 		    uint64_t ticks, enum rte_timer_type type,
 		    unsigned int tim_lcore, rte_timer_cb_t fct, void *arg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset and start a burst of timers, of the same type and callback, on the
+ * same lcore. The list of the lcore is locked once for the whole burst.
+ *
+ * @see rte_timer_alt_reset()
+ *
+ * @param timer_data_id
+ *   An identifier indicating which instance of timer data should be used for
+ *   this operation.
+ * @param tims
+ *   Array of timer handles.
+ * @param ticks
+ *   Array of the number of cycles before each timer expires.
+ * @param nb_tims
+ *   Number of timers in the arrays.
+ * @param type
+ *   The type of the timers, PERIODICAL or SINGLE.
+ * @param tim_lcore
+ *   The ID of the lcore where the timer callback functions have to be
+ *   executed. If tim_lcore is LCORE_ID_ANY, the timer library selects
+ *   the lcore round-robin, once for the burst.
+ * @param fct
+ *   The callback function of the timers. This parameter can be NULL if (and
+ *   only if) rte_timer_alt_manage() will be used to manage these timers.
+ * @param args
+ *   Array of the user arguments of the callback function, or NULL.
+ * @return
+ *   - >=0: Number of timers scheduled. The timers after it were not
+ *     modified, the first one being in the RUNNING or CONFIG state.
+ *   - -EINVAL: invalid timer_data_id
+ */
+__rte_experimental
+int
+rte_timer_alt_reset_burst(uint32_t timer_data_id, struct rte_timer **tims,
+			  const uint64_t *ticks, unsigned int nb_tims,
+			  enum rte_timer_type type, unsigned int tim_lcore,
+			  rte_timer_cb_t fct, void **args);
+
 /**
  * This function is the same as rte_timer_stop(), except that it allows a
  * caller to specify the rte_timer_data instance containing the list from which
@@ -430,6 +512,32 @@ rte_timer_alt_reset(uint32_t timer_data_id, struct rte_timer *tim,
 int
 rte_timer_alt_stop(uint32_t timer_data_id, struct rte_timer *tim);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Stop a burst of timers. The list of an lcore is locked once
+ * for the consecutive timers pending on it.
+ *
+ * @see rte_timer_alt_stop()
+ *
+ * @param timer_data_id
+ *   An identifier indicating which instance of timer data should be used for
+ *   this operation.
+ * @param tims
+ *   Array of timer handles.
+ * @param nb_tims
+ *   Number of timers in the array.
+ * @return
+ *   - >=0: Number of timers stopped. The timers after it were not
+ *     modified, the first one being in the RUNNING or CONFIG state.
+ *   - -EINVAL: invalid timer_data_id
+ */
+__rte_experimental
+int
+rte_timer_alt_stop_burst(uint32_t timer_data_id, struct rte_timer **tims,
+			 unsigned int nb_tims);
+
 /**
  * Callback function type for rte_timer_alt_manage().
  */